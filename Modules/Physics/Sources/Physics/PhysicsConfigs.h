@@ -8,6 +8,6 @@ struct PhysicsSceneConfig
 {
     Vector3 gravity = { 0, 0, -9.81f }; //physics gravity
     //uint32 simulationBlockSize = 16 * 1024 * 512; //must be 16K multiplier
-    uint32 threadCount = 2; //number of threads created for physics task dispatcher
+    uint32 threadCount = 2; //max number of JobManager workers used by physics task dispatcher
 };
 }
\ No newline at end of file
@@ -20,6 +20,9 @@ public:
     physx::PxBase* GetTriangleMeshEntry(const Vector<PolygonGroup*>& key) const;
     void AddEntry(const Vector<PolygonGroup*>& key, physx::PxBase* value);
 
+    /** Sort polygon groups and remove duplicates, so that the same set of groups is always the same key. */
+    static void MakeKey(Vector<PolygonGroup*>& polygons);
+
 private:
     Map<Vector<PolygonGroup*>, physx::PxBase*> convexHullCache;
     Map<Vector<PolygonGroup*>, physx::PxBase*> triangleMeshCache;
@@ -8,6 +8,7 @@
 #include <Math/Vector.h>
 #include <Base/BaseTypes.h>
 #include <Base/Type.h>
+#include <FileSystem/FilePath.h>
 
 #include <physx/PxFiltering.h>
 
@@ -20,8 +21,8 @@ class PxScene;
 class PxActor;
 class PxShape;
 class PxMaterial;
+class PxBase;
 class PxSimulationEventCallback;
-class PxDefaultCpuDispatcher;
 class PxAllocatorCallback;
 }
 
@@ -31,11 +32,24 @@ class PolygonGroup;
 class Landscape;
 class PhysicsGeometryCache;
 class PhysicsVehiclesSubsystem;
+class PhysicsCpuDispatcher;
 struct Matrix4;
 
 class PhysicsModule : public IModule
 {
 public:
+    enum eMeshType : uint8
+    {
+        MESH_CONVEX_HULL,
+        MESH_TRIANGLE_MESH
+    };
+
+    struct MeshGeometry
+    {
+        eMeshType type = MESH_TRIANGLE_MESH;
+        Vector<PolygonGroup*> polygons; // sorted and without duplicates, as a key of PhysicsGeometryCache
+    };
+
     PhysicsModule(Engine* engine);
 
     void Init() override;
@@ -58,6 +72,22 @@ public:
     physx::PxShape* CreateConvexHullShape(Vector<PolygonGroup*>&& polygons, const Vector3& scale, const FastName& materialName, PhysicsGeometryCache* cache) const;
     physx::PxShape* CreateHeightField(Landscape* landscape, const FastName& materialName, Matrix4& localPose) const;
 
+    /**
+        Cook meshes missing in `cache` in worker jobs and add them to `cache`,
+        so that following CreateMeshShape and CreateConvexHullShape calls don't cook.
+    */
+    void PrepareMeshes(Vector<MeshGeometry>&& meshes, PhysicsGeometryCache* cache) const;
+
+    /**
+        Cook mesh to PhysX stream. Thread-safe.
+        Cooked streams are stored in folder set by engine option "physics.cookedMeshesFolder" (~doc:/PhysicsMeshes/ by default)
+        and are loaded from it instead of cooking next time. Empty folder disables persistent storage.
+    */
+    bool CookMesh(eMeshType type, const Vector<PolygonGroup*>& polygons, Vector<uint8>& outCookedData) const;
+
+    /** Folder with cooked meshes, empty if persistent storage is disabled */
+    const FilePath& GetCookedMeshesFolder() const;
+
     physx::PxMaterial* GetMaterial(const FastName& materialName) const;
     Vector<FastName> GetMaterialNames() const;
     void ReleaseMaterials();
@@ -73,12 +103,15 @@ private:
     void LazyLoadMaterials() const;
     void LoadMaterials();
 
+    physx::PxBase* CreateMesh(eMeshType type, const Vector<uint8>& cookedData) const;
+
 private:
     physx::PxFoundation* foundation = nullptr;
     physx::PxPhysics* physics = nullptr;
     physx::PxCooking* cooking = nullptr;
+    FilePath cookedMeshesFolder;
 
-    mutable physx::PxDefaultCpuDispatcher* cpuDispatcher = nullptr;
+    mutable PhysicsCpuDispatcher* cpuDispatcher = nullptr;
     physx::PxMaterial* defaultMaterial = nullptr;
     UnorderedMap<FastName, physx::PxMaterial*> materials;
 
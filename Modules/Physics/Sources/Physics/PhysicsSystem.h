@@ -65,6 +65,7 @@ private:
     void DrawDebugInfo();
 
     void InitNewObjects();
+    void PrepareMeshes(PhysicsModule* physics);
     void AttachShapesRecursively(Entity* entity, PhysicsComponent* bodyComponent, const Vector3& scale);
     void AttachShape(PhysicsComponent* bodyComponent, CollisionShapeComponent* shapeComponent, const Vector3& scale);
 
@@ -102,6 +103,7 @@ private:
 
     bool isSimulationEnabled = true;
     bool isSimulationRunning = false;
+    float32 skippedSimulationTime = 0.f;
     physx::PxScene* physicsScene = nullptr;
     physx::PxControllerManager* controllerManager = nullptr;
     PhysicsGeometryCache* geometryCache = nullptr;
@@ -0,0 +1,89 @@
+#include "Physics/Private/PhysicsCpuDispatcher.h"
+
+#include <Concurrency/LockGuard.h>
+#include <Concurrency/UniqueLock.h>
+#include <Job/JobManager.h>
+
+#include <PxShared/task/PxTask.h>
+
+namespace DAVA
+{
+PhysicsCpuDispatcher::PhysicsCpuDispatcher(JobManager* jobManager_, uint32 maxWorkersCount)
+    : jobManager(jobManager_)
+{
+    if (jobManager != nullptr)
+    {
+        workersCount = Min(jobManager->GetWorkersCount(), maxWorkersCount);
+    }
+}
+
+PhysicsCpuDispatcher::~PhysicsCpuDispatcher()
+{
+    WaitTasks();
+}
+
+void PhysicsCpuDispatcher::submitTask(physx::PxBaseTask& task)
+{
+    if (workersCount == 0)
+    {
+        task.run();
+        task.release();
+        return;
+    }
+
+    bool startJob = false;
+    {
+        LockGuard<Mutex> lock(mutex);
+        tasks.push_back(&task);
+        pendingTasksCount++;
+        if (runningJobsCount < workersCount)
+        {
+            runningJobsCount++;
+            startJob = true;
+        }
+    }
+
+    if (startJob)
+    {
+        jobManager->CreateDetachedWorkerJob([this]() { RunTasks(); });
+    }
+}
+
+void PhysicsCpuDispatcher::RunTasks()
+{
+    UniqueLock<Mutex> lock(mutex);
+    while (tasks.empty() == false)
+    {
+        physx::PxBaseTask* task = tasks.front();
+        tasks.pop_front();
+
+        lock.Unlock();
+        task->run();
+        task->release();
+        lock.Lock();
+
+        pendingTasksCount--;
+    }
+
+    // Job is finished under lock, so task submitted after queue became empty always starts new job
+    runningJobsCount--;
+    if (pendingTasksCount == 0)
+    {
+        tasksDone.NotifyAll();
+    }
+}
+
+void PhysicsCpuDispatcher::WaitTasks()
+{
+    UniqueLock<Mutex> lock(mutex);
+    while (pendingTasksCount > 0 || runningJobsCount > 0)
+    {
+        tasksDone.Wait(lock);
+    }
+}
+
+uint32_t PhysicsCpuDispatcher::getWorkerCount() const
+{
+    return workersCount;
+}
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <Base/BaseTypes.h>
+#include <Concurrency/ConditionVariable.h>
+#include <Concurrency/Mutex.h>
+
+#include <PxShared/task/PxCpuDispatcher.h>
+
+namespace DAVA
+{
+class JobManager;
+
+/**
+    PhysX task dispatcher that runs simulation tasks in engine worker threads,
+    so PhysX shares worker threads with other engine systems instead of creating its own thread pool.
+
+    Submitted tasks are queued and executed by at most `maxWorkersCount` detached worker jobs at once,
+    so PhysX never occupies more workers than configured and `JobManager::WaitWorkerJobs` doesn't wait for simulation.
+    Use `WaitTasks` to wait for submitted tasks. Tasks are executed immediately in the submitting thread if there are no worker threads.
+*/
+class PhysicsCpuDispatcher final : public physx::PxCpuDispatcher
+{
+public:
+    PhysicsCpuDispatcher(JobManager* jobManager, uint32 maxWorkersCount);
+    ~PhysicsCpuDispatcher();
+
+    void submitTask(physx::PxBaseTask& task) override;
+    uint32_t getWorkerCount() const override;
+
+    /** Wait until all submitted tasks are executed. */
+    void WaitTasks();
+
+private:
+    void RunTasks();
+
+    JobManager* jobManager = nullptr;
+    uint32 workersCount = 0;
+
+    Mutex mutex;
+    ConditionVariable tasksDone;
+    Deque<physx::PxBaseTask*> tasks;
+    uint32 runningJobsCount = 0;
+    uint32 pendingTasksCount = 0; // queued and running tasks
+};
+}
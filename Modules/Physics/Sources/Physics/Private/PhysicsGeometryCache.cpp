@@ -3,6 +3,8 @@
 #include <Debug/DVAssert.h>
 #include <Base/BaseTypes.h>
 
+#include <algorithm>
+
 #include <physx/geometry/PxConvexMesh.h>
 #include <physx/geometry/PxTriangleMesh.h>
 
@@ -13,8 +15,7 @@ using namespace DAVA;
 bool ValidateKey(const Vector<PolygonGroup*>& key)
 {
     Vector<PolygonGroup*> copy = key;
-    std::sort(copy.begin(), copy.end());
-    copy.erase(std::unique(copy.begin(), copy.end()), copy.end());
+    DAVA::PhysicsGeometryCache::MakeKey(copy);
 
     return copy == key;
 }
@@ -72,6 +73,12 @@ physx::PxBase* PhysicsGeometryCache::GetTriangleMeshEntry(const Vector<PolygonGr
     return GetEntry(triangleMeshCache, key);
 }
 
+void PhysicsGeometryCache::MakeKey(Vector<PolygonGroup*>& polygons)
+{
+    std::sort(polygons.begin(), polygons.end());
+    polygons.erase(std::unique(polygons.begin(), polygons.end()), polygons.end());
+}
+
 void PhysicsGeometryCache::AddEntry(const Vector<PolygonGroup*>& key, physx::PxBase* value)
 {
     using namespace PhysicsGeometryCache;
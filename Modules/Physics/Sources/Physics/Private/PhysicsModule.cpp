@@ -16,14 +16,19 @@
 #include "Physics/CapsuleCharacterControllerComponent.h"
 #include "Physics/WASDPhysicsControllerComponent.h"
 #include "Physics/PhysicsGeometryCache.h"
+#include "Physics/Private/PhysicsCpuDispatcher.h"
 #include "Physics/Private/PhysicsMath.h"
 
+#include <Concurrency/Thread.h>
 #include <Engine/Engine.h>
 #include <Engine/EngineContext.h>
 #include <Entity/ComponentManager.h>
 #include <FileSystem/YamlParser.h>
 #include <FileSystem/YamlNode.h>
 #include <FileSystem/FileSystem.h>
+#include <FileSystem/File.h>
+#include <FileSystem/KeyedArchive.h>
+#include <Job/JobManager.h>
 #include <Logger/Logger.h>
 #include <Render/3D/PolygonGroup.h>
 #include <Render/Highlevel/Landscape.h>
@@ -31,6 +36,8 @@
 #include <MemoryManager/MemoryManager.h>
 #include <Reflection/ReflectionRegistrator.h>
 #include <Math/MathConstants.h>
+#include <Utils/MD5.h>
+#include <Utils/StringFormat.h>
 
 #include <physx/PxPhysicsAPI.h>
 #include <PxShared/pvd/PxPvd.h>
@@ -39,6 +46,8 @@ namespace DAVA
 {
 namespace PhysicsModuleDetail
 {
+const char* DEFAULT_COOKED_MESHES_FOLDER = "~doc:/PhysicsMeshes/";
+
 physx::PxPvd* CreatePvd(physx::PxFoundation* foundation)
 {
     IModule* physicsDebugModule = GetEngineContext()->moduleManager->GetModule("PhysicsDebugModule");
@@ -114,6 +123,68 @@ void BuildPhysxMeshInfo(const Vector<PolygonGroup*>& polygons, Vector<physx::PxV
         indexOffset = static_cast<uint32>(vertices.size());
     }
 }
+
+// Cooked mesh is stored by hash of its content and cooking parameters,
+// so meshes are shared between levels and are recooked after changes of geometry or PhysX version
+String GetCookedMeshName(PhysicsModule::eMeshType type, const Vector<physx::PxVec3>& vertices, const Vector<physx::PxU32>& indices, const physx::PxCookingParams& params)
+{
+    const uint32 header[] = {
+        static_cast<uint32>(type),
+        static_cast<uint32>(PX_PHYSICS_VERSION),
+        static_cast<uint32>(params.targetPlatform),
+        static_cast<uint32>(params.convexMeshCookingType),
+        static_cast<uint32>(params.meshPreprocessParams),
+        static_cast<uint32>(params.suppressTriangleMeshRemapTable),
+        static_cast<uint32>(params.buildTriangleAdjacencies),
+        static_cast<uint32>(params.buildGPUData)
+    };
+
+    const float32 tolerances[] = {
+        params.areaTestEpsilon,
+        params.planeTolerance,
+        params.scale.length,
+        params.scale.speed
+    };
+
+    MD5 md5;
+    md5.Init();
+    md5.Update(reinterpret_cast<const uint8*>(header), sizeof(header));
+    md5.Update(reinterpret_cast<const uint8*>(tolerances), sizeof(tolerances));
+    md5.Update(reinterpret_cast<const uint8*>(vertices.data()), static_cast<uint32>(vertices.size() * sizeof(physx::PxVec3)));
+    md5.Update(reinterpret_cast<const uint8*>(indices.data()), static_cast<uint32>(indices.size() * sizeof(physx::PxU32)));
+    md5.Final();
+
+    return MD5::HashToString(md5.GetDigest()) + ".pxmesh";
+}
+
+bool ReadCookedMesh(const FilePath& path, Vector<uint8>& cookedData)
+{
+    ScopedPtr<File> file(File::Create(path, File::OPEN | File::READ));
+    if (!file)
+    {
+        return false;
+    }
+
+    uint32 size = static_cast<uint32>(file->GetSize());
+    cookedData.resize(size);
+    return size > 0 && file->Read(cookedData.data(), size) == size;
+}
+
+void WriteCookedMesh(const FilePath& path, const Vector<uint8>& cookedData)
+{
+    // Mesh is written to temporary file first, so that concurrent readers never see partially written data
+    FilePath tempPath(path.GetAbsolutePathname() + Format(".%llu.tmp", Thread::GetCurrentIdAsUInt64()));
+    {
+        ScopedPtr<File> file(File::Create(tempPath, File::CREATE | File::WRITE));
+        if (!file || file->Write(cookedData.data(), static_cast<uint32>(cookedData.size())) != cookedData.size())
+        {
+            Logger::Warning("[Physics::CookMesh] Can't write cooked mesh %s", tempPath.GetAbsolutePathname().c_str());
+            return;
+        }
+    }
+
+    FileSystem::Instance()->MoveFile(tempPath, path, true);
+}
 }
 
 class PhysicsModule::PhysicsAllocator : public physx::PxAllocatorCallback
@@ -218,6 +289,19 @@ void PhysicsModule::Init()
     cooking = PxCreateCooking(PX_PHYSICS_VERSION, *foundation, cookingParams);
     DVASSERT(cooking);
 
+    cookedMeshesFolder = PhysicsModuleDetail::DEFAULT_COOKED_MESHES_FOLDER;
+    if (Engine::Instance() != nullptr)
+    {
+        const KeyedArchive* options = Engine::Instance()->GetOptions();
+        cookedMeshesFolder = options->GetString("physics.cookedMeshesFolder", PhysicsModuleDetail::DEFAULT_COOKED_MESHES_FOLDER);
+    }
+
+    if (cookedMeshesFolder.IsEmpty() == false)
+    {
+        cookedMeshesFolder.MakeDirectoryPathname();
+        FileSystem::Instance()->CreateDirectory(cookedMeshesFolder, true);
+    }
+
     PxInitVehicleSDK(*physics);
     PxVehicleSetBasisVectors(PxVec3(0.0f, 0.0f, 1.0f), PxVec3(1.0f, 0.0f, 0.0f));
     PxVehicleSetUpdateMode(PxVehicleUpdateMode::eVELOCITY_CHANGE);
@@ -252,10 +336,7 @@ void PhysicsModule::Shutdown()
     physx::PxCloseVehicleSDK();
 
     ReleaseMaterials();
-    if (cpuDispatcher != nullptr)
-    {
-        cpuDispatcher->release();
-    }
+    SafeDelete(cpuDispatcher);
 
     cooking->release();
     physics->release();
@@ -295,7 +376,7 @@ physx::PxScene* PhysicsModule::CreateScene(const PhysicsSceneConfig& config, phy
 
     if (cpuDispatcher == nullptr)
     {
-        cpuDispatcher = PxDefaultCpuDispatcherCreate(config.threadCount);
+        cpuDispatcher = new PhysicsCpuDispatcher(GetEngineContext()->jobManager, config.threadCount);
     }
     DVASSERT(cpuDispatcher);
     sceneDesc.cpuDispatcher = cpuDispatcher;
@@ -340,36 +421,19 @@ physx::PxShape* PhysicsModule::CreateMeshShape(Vector<PolygonGroup*>&& polygons,
 {
     using namespace physx;
 
-    std::sort(polygons.begin(), polygons.end());
-    polygons.erase(std::unique(polygons.begin(), polygons.end()), polygons.end());
+    PhysicsGeometryCache::MakeKey(polygons);
 
     DVASSERT(cache != nullptr);
     PxBase* mesh = cache->GetTriangleMeshEntry(polygons);
     if (mesh == nullptr)
     {
-        Vector<PxVec3> vertices;
-        Vector<PxU32> indices;
-        PhysicsModuleDetail::BuildPhysxMeshInfo(polygons, vertices, indices);
-
-        PxTriangleMeshDesc desc;
-        desc.points.count = static_cast<PxU32>(vertices.size());
-        desc.points.stride = sizeof(PxVec3);
-        desc.points.data = vertices.data();
-        desc.triangles.count = static_cast<PxU32>(indices.size() / 3);
-        desc.triangles.stride = 3 * sizeof(PxU32);
-        desc.triangles.data = indices.data();
-        desc.flags = PxMeshFlags(0);
-
-        physx::PxTriangleMeshCookingResult::Enum condition;
-        PxDefaultMemoryOutputStream outStream;
-        if (cooking->cookTriangleMesh(desc, outStream, &condition) == false)
+        Vector<uint8> cookedData;
+        if (CookMesh(MESH_TRIANGLE_MESH, polygons, cookedData) == false)
         {
-            Logger::Error("[Physics::CreateMeshShape] Mesh creation failure for polygon group with code: %u", static_cast<uint32>(condition));
             return nullptr;
         }
 
-        physx::PxDefaultMemoryInputData inputStream(outStream.getData(), outStream.getSize());
-        mesh = physics->createTriangleMesh(inputStream);
+        mesh = CreateMesh(MESH_TRIANGLE_MESH, cookedData);
         DVASSERT(mesh != nullptr);
         cache->AddEntry(polygons, mesh);
     }
@@ -387,17 +451,111 @@ physx::PxShape* PhysicsModule::CreateConvexHullShape(Vector<PolygonGroup*>&& pol
 {
     using namespace physx;
 
-    std::sort(polygons.begin(), polygons.end());
-    polygons.erase(std::unique(polygons.begin(), polygons.end()), polygons.end());
+    PhysicsGeometryCache::MakeKey(polygons);
 
     DVASSERT(cache != nullptr);
     PxBase* mesh = cache->GetConvexHullEntry(polygons);
     if (mesh == nullptr)
     {
-        Vector<PxVec3> vertices;
-        Vector<PxU32> indices;
-        PhysicsModuleDetail::BuildPhysxMeshInfo(polygons, vertices, indices);
+        Vector<uint8> cookedData;
+        if (CookMesh(MESH_CONVEX_HULL, polygons, cookedData) == false)
+        {
+            return nullptr;
+        }
+
+        mesh = CreateMesh(MESH_CONVEX_HULL, cookedData);
+        DVASSERT(mesh != nullptr);
+        cache->AddEntry(polygons, mesh);
+    }
+
+    PxConvexMesh* convexMesh = mesh->is<PxConvexMesh>();
+    DVASSERT(convexMesh != nullptr);
+    PxMeshScale pxScale(PxVec3(scale.x, scale.y, scale.z), PxQuat(PxIdentity));
+    PxConvexMeshGeometry geometry(convexMesh, pxScale);
+    PxShape* shape = physics->createShape(geometry, *GetMaterial(materialName), true);
+
+    return shape;
+}
+
+void PhysicsModule::PrepareMeshes(Vector<MeshGeometry>&& meshes, PhysicsGeometryCache* cache) const
+{
+    DVASSERT(cache != nullptr);
+
+    auto isCached = [cache](const MeshGeometry& mesh) {
+        return (mesh.type == MESH_CONVEX_HULL ? cache->GetConvexHullEntry(mesh.polygons) : cache->GetTriangleMeshEntry(mesh.polygons)) != nullptr;
+    };
+
+    auto less = [](const MeshGeometry& left, const MeshGeometry& right) {
+        return std::tie(left.type, left.polygons) < std::tie(right.type, right.polygons);
+    };
+
+    auto equal = [](const MeshGeometry& left, const MeshGeometry& right) {
+        return left.type == right.type && left.polygons == right.polygons;
+    };
+
+    meshes.erase(std::remove_if(meshes.begin(), meshes.end(), isCached), meshes.end());
+    std::sort(meshes.begin(), meshes.end(), less);
+    meshes.erase(std::unique(meshes.begin(), meshes.end(), equal), meshes.end());
 
+    uint32 meshesCount = static_cast<uint32>(meshes.size());
+    if (meshesCount == 0)
+    {
+        return;
+    }
+
+    // Cooking is the most expensive part of meshes creation, it is thread-safe and is done in worker jobs.
+    // PhysX objects are created from cooked data in calling thread
+    Vector<Vector<uint8>> cookedData(meshesCount);
+    Vector<uint8> cooked(meshesCount, 0);
+    auto cookMeshes = [&](uint32 begin, uint32 end) {
+        for (uint32 i = begin; i < end; ++i)
+        {
+            cooked[i] = CookMesh(meshes[i].type, meshes[i].polygons, cookedData[i]) ? 1 : 0;
+        }
+    };
+
+    JobManager* jobManager = GetEngineContext()->jobManager;
+    if (meshesCount > 1 && jobManager != nullptr && jobManager->GetWorkersCount() > 0)
+    {
+        jobManager->ParallelFor(0, meshesCount, 1, cookMeshes);
+    }
+    else
+    {
+        cookMeshes(0, meshesCount);
+    }
+
+    for (uint32 i = 0; i < meshesCount; ++i)
+    {
+        if (cooked[i] != 0)
+        {
+            physx::PxBase* mesh = CreateMesh(meshes[i].type, cookedData[i]);
+            DVASSERT(mesh != nullptr);
+            cache->AddEntry(meshes[i].polygons, mesh);
+        }
+    }
+}
+
+bool PhysicsModule::CookMesh(eMeshType type, const Vector<PolygonGroup*>& polygons, Vector<uint8>& outCookedData) const
+{
+    using namespace physx;
+
+    Vector<PxVec3> vertices;
+    Vector<PxU32> indices;
+    PhysicsModuleDetail::BuildPhysxMeshInfo(polygons, vertices, indices);
+
+    FilePath cookedMeshPath;
+    if (cookedMeshesFolder.IsEmpty() == false)
+    {
+        cookedMeshPath = cookedMeshesFolder + PhysicsModuleDetail::GetCookedMeshName(type, vertices, indices, cooking->getParams());
+        if (PhysicsModuleDetail::ReadCookedMesh(cookedMeshPath, outCookedData) == true)
+        {
+            return true;
+        }
+    }
+
+    PxDefaultMemoryOutputStream outStream;
+    if (type == MESH_CONVEX_HULL)
+    {
         PxConvexMeshDesc desc;
         desc.points.count = static_cast<PxU32>(vertices.size());
         desc.points.stride = sizeof(PxVec3);
@@ -408,26 +566,55 @@ physx::PxShape* PhysicsModule::CreateConvexHullShape(Vector<PolygonGroup*>&& pol
         desc.flags = PxConvexFlag::eCOMPUTE_CONVEX;
 
         PxConvexMeshCookingResult::Enum condition;
-        PxDefaultMemoryOutputStream outStream;
         if (cooking->cookConvexMesh(desc, outStream, &condition) == false)
         {
-            Logger::Error("[Physics::CreateMeshShape] Mesh creation failure for polygon group with code: %u", static_cast<uint32>(condition));
-            return nullptr;
+            Logger::Error("[Physics::CookMesh] Convex hull creation failure for polygon group with code: %u", static_cast<uint32>(condition));
+            return false;
+        }
+    }
+    else
+    {
+        PxTriangleMeshDesc desc;
+        desc.points.count = static_cast<PxU32>(vertices.size());
+        desc.points.stride = sizeof(PxVec3);
+        desc.points.data = vertices.data();
+        desc.triangles.count = static_cast<PxU32>(indices.size() / 3);
+        desc.triangles.stride = 3 * sizeof(PxU32);
+        desc.triangles.data = indices.data();
+        desc.flags = PxMeshFlags(0);
+
+        PxTriangleMeshCookingResult::Enum condition;
+        if (cooking->cookTriangleMesh(desc, outStream, &condition) == false)
+        {
+            Logger::Error("[Physics::CookMesh] Mesh creation failure for polygon group with code: %u", static_cast<uint32>(condition));
+            return false;
         }
+    }
 
-        physx::PxDefaultMemoryInputData inputStream(outStream.getData(), outStream.getSize());
-        mesh = physics->createConvexMesh(inputStream);
-        DVASSERT(mesh != nullptr);
-        cache->AddEntry(polygons, mesh);
+    outCookedData.assign(outStream.getData(), outStream.getData() + outStream.getSize());
+
+    if (cookedMeshPath.IsEmpty() == false)
+    {
+        PhysicsModuleDetail::WriteCookedMesh(cookedMeshPath, outCookedData);
     }
 
-    PxConvexMesh* convexMesh = mesh->is<PxConvexMesh>();
-    DVASSERT(convexMesh != nullptr);
-    PxMeshScale pxScale(PxVec3(scale.x, scale.y, scale.z), PxQuat(PxIdentity));
-    PxConvexMeshGeometry geometry(convexMesh, pxScale);
-    PxShape* shape = physics->createShape(geometry, *GetMaterial(materialName), true);
+    return true;
+}
 
-    return shape;
+const FilePath& PhysicsModule::GetCookedMeshesFolder() const
+{
+    return cookedMeshesFolder;
+}
+
+physx::PxBase* PhysicsModule::CreateMesh(eMeshType type, const Vector<uint8>& cookedData) const
+{
+    physx::PxDefaultMemoryInputData inputStream(const_cast<uint8*>(cookedData.data()), static_cast<physx::PxU32>(cookedData.size()));
+    if (type == MESH_CONVEX_HULL)
+    {
+        return physics->createConvexMesh(inputStream);
+    }
+
+    return physics->createTriangleMesh(inputStream);
 }
 
 physx::PxShape* PhysicsModule::CreateHeightField(Landscape* landscape, const FastName& materialName, Matrix4& localPose) const
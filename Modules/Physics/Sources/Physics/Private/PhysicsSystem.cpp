@@ -107,6 +107,8 @@ bool IsCharacterControllerType(const Type* componentType)
     return componentType->Is<BoxCharacterControllerComponent>() || componentType->Is<CapsuleCharacterControllerComponent>();
 }
 
+// Collect polygon groups of entity's max LOD as a key of PhysicsGeometryCache, so that meshes prepared for new shapes
+// and meshes looked up by created shapes use the same key
 Vector3 AccumulateMeshInfo(Entity* e, Vector<PolygonGroup*>& groups)
 {
     RenderObject* ro = GetRenderObject(e);
@@ -129,6 +131,7 @@ Vector3 AccumulateMeshInfo(Entity* e, Vector<PolygonGroup*>& groups)
             }
         }
     }
+    PhysicsGeometryCache::MakeKey(groups);
 
     return GetTransformComponent(e)->GetWorldTransform().GetScale();
 }
@@ -161,6 +164,7 @@ PhysicsComponent* GetParentPhysicsComponent(Entity* entity)
 }
 
 const uint32 DEFAULT_SIMULATION_BLOCK_SIZE = 16 * 1024 * 512;
+const float32 MAX_SKIPPED_SIMULATION_TIME = 0.1f; // limits step length after long stalls
 } // namespace
 
 physx::PxFilterFlags FilterShader(physx::PxFilterObjectAttributes attributes0,
@@ -595,11 +599,20 @@ void PhysicsSystem::Process(float32 timeElapsed)
 {
     if (isSimulationRunning == true)
     {
-        FetchResults(false);
+        // Simulation step runs in worker jobs in parallel with other systems and frames,
+        // frame doesn't wait for it. Time of frames skipped while step is running is simulated by the next step
+        if (FetchResults(false) == false)
+        {
+            skippedSimulationTime = Min(skippedSimulationTime + timeElapsed, PhysicsSystemDetail::MAX_SKIPPED_SIMULATION_TIME);
+            return;
+        }
     }
 
     if (isSimulationRunning == false)
     {
+        timeElapsed += skippedSimulationTime;
+        skippedSimulationTime = 0.f;
+
         InitNewObjects();
         UpdateComponents();
 
@@ -633,6 +646,7 @@ void PhysicsSystem::SetSimulationEnabled(bool isEnabled)
         }
 
         isSimulationEnabled = isEnabled;
+        skippedSimulationTime = 0.f;
 
         vehiclesSubsystem->OnSimulationEnabled(isSimulationEnabled);
     }
@@ -782,6 +796,7 @@ void PhysicsSystem::InitNewObjects()
     }
     pendingAddPhysicsComponents.clear();
 
+    PrepareMeshes(physics);
     for (CollisionShapeComponent* component : pendingAddCollisionComponents)
     {
         physx::PxShape* shape = CreateShape(component, physics);
@@ -864,6 +879,32 @@ void PhysicsSystem::InitNewObjects()
     pendingAddCharacterControllerComponents.clear();
 }
 
+void PhysicsSystem::PrepareMeshes(PhysicsModule* physics)
+{
+    // Cook all new meshes at once, so that cooking of scene with many mesh shapes is distributed over worker threads
+    Vector<PhysicsModule::MeshGeometry> meshes;
+    for (CollisionShapeComponent* component : pendingAddCollisionComponents)
+    {
+        const Type* componentType = component->GetType();
+        bool isConvexHull = componentType->Is<ConvexHullShapeComponent>();
+        if (isConvexHull || componentType->Is<MeshShapeComponent>())
+        {
+            PhysicsModule::MeshGeometry mesh;
+            mesh.type = isConvexHull ? PhysicsModule::MESH_CONVEX_HULL : PhysicsModule::MESH_TRIANGLE_MESH;
+            PhysicsSystemDetail::AccumulateMeshInfo(component->GetEntity(), mesh.polygons);
+            if (mesh.polygons.empty() == false)
+            {
+                meshes.push_back(std::move(mesh));
+            }
+        }
+    }
+
+    if (meshes.size() > 1)
+    {
+        physics->PrepareMeshes(std::move(meshes), geometryCache);
+    }
+}
+
 void PhysicsSystem::AttachShape(PhysicsComponent* bodyComponent, CollisionShapeComponent* shapeComponent, const Vector3& scale)
 {
     physx::PxActor* actor = bodyComponent->GetPxActor();
@@ -14,6 +14,7 @@ class PhysicsSystemPrivate
 public:
     static physx::PxScene* GetPxScene(PhysicsSystem* system);
     static bool HasPendingComponents(PhysicsSystem* system);
+    static PhysicsGeometryCache* GetGeometryCache(PhysicsSystem* system);
 };
 
 inline physx::PxScene* PhysicsSystemPrivate::GetPxScene(PhysicsSystem* system)
@@ -25,4 +26,9 @@ inline bool PhysicsSystemPrivate::HasPendingComponents(PhysicsSystem* system)
 {
     return system->pendingAddCollisionComponents.empty() == false || system->pendingAddPhysicsComponents.empty() == false;
 }
+
+inline PhysicsGeometryCache* PhysicsSystemPrivate::GetGeometryCache(PhysicsSystem* system)
+{
+    return system->geometryCache;
+}
 } // namespace DAVA
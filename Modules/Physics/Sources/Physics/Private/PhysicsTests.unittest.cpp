@@ -1,22 +1,34 @@
 #include "UnitTests/UnitTests.h"
 #include "Physics/PhysicsModule.h"
+#include "Physics/PhysicsGeometryCache.h"
 #include "Physics/StaticBodyComponent.h"
 #include "Physics/DynamicBodyComponent.h"
 #include "Physics/CollisionShapeComponent.h"
 #include "Physics/BoxShapeComponent.h"
+#include "Physics/MeshShapeComponent.h"
 #include "Physics/Private/PhysicsSystemPrivate.h"
+#include "Physics/Private/PhysicsCpuDispatcher.h"
 
 #include <Engine/Engine.h>
 #include <Scene3D/Scene.h>
 #include <Scene3D/Components/TransformComponent.h>
 #include <Entity/Component.h>
 #include <Concurrency/Thread.h>
+#include <Job/JobManager.h>
+#include <Render/3D/PolygonGroup.h>
+#include <Render/Highlevel/RenderBatch.h>
+#include <Render/Highlevel/RenderObject.h>
+#include <Scene3D/Components/RenderComponent.h>
+#include <FileSystem/File.h>
+#include <FileSystem/FileSystem.h>
 
 #include <physx/PxScene.h>
 #include <physx/PxActor.h>
 #include <physx/PxRigidStatic.h>
 #include <physx/PxRigidDynamic.h>
+#include <physx/PxShape.h>
 #include <PxShared/foundation/PxFlags.h>
+#include <PxShared/task/PxTask.h>
 
 using namespace DAVA;
 
@@ -75,6 +87,91 @@ physx::PxShape* ExtractPxShape(const SceneInfo& info)
     return component->GetPxShape();
 }
 
+PolygonGroup* CreateBoxPolygonGroup(float32 halfSize)
+{
+    const int16 indices[] = { 0, 1, 2, 0, 2, 3, 4, 6, 5, 4, 7, 6, 0, 4, 5, 0, 5, 1, 1, 5, 6, 1, 6, 2, 2, 6, 7, 2, 7, 3, 3, 7, 4, 3, 4, 0 };
+    const int32 indicesCount = static_cast<int32>(sizeof(indices) / sizeof(indices[0]));
+
+    PolygonGroup* polygonGroup = new PolygonGroup();
+    polygonGroup->AllocateData(EVF_VERTEX, 8, indicesCount);
+    for (int32 i = 0; i < 8; ++i)
+    {
+        float32 x = (i == 1 || i == 2 || i == 5 || i == 6) ? halfSize : -halfSize;
+        float32 y = (i == 2 || i == 3 || i == 6 || i == 7) ? halfSize : -halfSize;
+        float32 z = (i < 4) ? -halfSize : halfSize;
+        polygonGroup->SetCoord(i, Vector3(x, y, z));
+    }
+
+    for (int32 i = 0; i < indicesCount; ++i)
+    {
+        polygonGroup->SetIndex(i, indices[i]);
+    }
+
+    return polygonGroup;
+}
+
+// Entity with render batches of `groups` in given order and with mesh shape
+Entity* CreateMeshEntity(const Vector<PolygonGroup*>& groups)
+{
+    ScopedPtr<RenderObject> renderObject(new RenderObject());
+    for (PolygonGroup* group : groups)
+    {
+        ScopedPtr<RenderBatch> batch(new RenderBatch());
+        batch->SetPolygonGroup(group);
+        renderObject->AddRenderBatch(batch, 0, -1);
+    }
+
+    Entity* entity = new Entity();
+    entity->AddComponent(new RenderComponent(renderObject));
+    entity->AddComponent(new MeshShapeComponent());
+    return entity;
+}
+
+std::atomic<uint32> runningTasksCount{ 0 };
+std::atomic<uint32> maxRunningTasksCount{ 0 };
+
+class CountingTask : public physx::PxBaseTask
+{
+public:
+    void run() override
+    {
+        uint32 running = ++runningTasksCount;
+        uint32 maxRunning = maxRunningTasksCount;
+        while (running > maxRunning && !maxRunningTasksCount.compare_exchange_weak(maxRunning, running))
+        {
+        }
+        Thread::Sleep(1);
+        runCount++;
+        runningTasksCount--;
+    }
+
+    void release() override
+    {
+        releaseCount++;
+    }
+
+    const char* getName() const override
+    {
+        return "CountingTask";
+    }
+
+    void addReference() override
+    {
+    }
+
+    void removeReference() override
+    {
+    }
+
+    int32_t getReference() const override
+    {
+        return 1;
+    }
+
+    std::atomic<uint32> runCount{ 0 };
+    std::atomic<uint32> releaseCount{ 0 };
+};
+
 } // namespace PhysicsTestDetils
 
 DAVA_TESTCLASS (PhysicsTest)
@@ -86,6 +183,167 @@ DAVA_TESTCLASS (PhysicsTest)
         TEST_VERIFY(physicsModule->IsInitialized());
     }
 
+    DAVA_TEST (CpuDispatcherTest)
+    {
+        using namespace PhysicsTestDetils;
+
+        JobManager* jobManager = GetEngineContext()->jobManager;
+        const uint32 tasksCount = 64;
+
+        // tasks are run and released exactly once both in worker jobs and without workers
+        PhysicsCpuDispatcher jobsDispatcher(jobManager, 2);
+        PhysicsCpuDispatcher inlineDispatcher(nullptr, 2);
+        TEST_VERIFY(jobsDispatcher.getWorkerCount() == Min(jobManager->GetWorkersCount(), 2u));
+        TEST_VERIFY(inlineDispatcher.getWorkerCount() == 0);
+
+        for (PhysicsCpuDispatcher* dispatcher : { &jobsDispatcher, &inlineDispatcher })
+        {
+            maxRunningTasksCount = 0;
+            Vector<CountingTask> tasks(tasksCount);
+            for (CountingTask& task : tasks)
+            {
+                dispatcher->submitTask(task);
+            }
+            dispatcher->WaitTasks();
+
+            for (const CountingTask& task : tasks)
+            {
+                TEST_VERIFY(task.runCount == 1);
+                TEST_VERIFY(task.releaseCount == 1);
+            }
+
+            // tasks never occupy more workers than dispatcher is limited to
+            TEST_VERIFY(maxRunningTasksCount <= Max(dispatcher->getWorkerCount(), 1u));
+        }
+    }
+
+    DAVA_TEST (CookedMeshCacheTest)
+    {
+        using namespace PhysicsTestDetils;
+
+        PhysicsModule* physicsModule = GetEngineContext()->moduleManager->GetModule<PhysicsModule>();
+        FileSystem* fileSystem = FileSystem::Instance();
+
+        const FilePath& cookedMeshesFolder = physicsModule->GetCookedMeshesFolder();
+        TEST_VERIFY(cookedMeshesFolder.IsEmpty() == false);
+        fileSystem->DeleteDirectoryFiles(cookedMeshesFolder);
+
+        ScopedPtr<PolygonGroup> box(CreateBoxPolygonGroup(1.0f));
+        ScopedPtr<PolygonGroup> otherBox(CreateBoxPolygonGroup(2.0f));
+
+        for (PhysicsModule::eMeshType type : { PhysicsModule::MESH_CONVEX_HULL, PhysicsModule::MESH_TRIANGLE_MESH })
+        {
+            // first cooking stores stream in persistent cache
+            Vector<FilePath> filesBefore = fileSystem->EnumerateFilesInDirectory(cookedMeshesFolder, false);
+            Vector<uint8> cooked;
+            TEST_VERIFY(physicsModule->CookMesh(type, { box.get() }, cooked));
+            TEST_VERIFY(cooked.empty() == false);
+
+            Vector<FilePath> filesAfter = fileSystem->EnumerateFilesInDirectory(cookedMeshesFolder, false);
+            TEST_VERIFY(filesAfter.size() == filesBefore.size() + 1);
+
+            FilePath cookedPath;
+            for (const FilePath& path : filesAfter)
+            {
+                if (std::find(filesBefore.begin(), filesBefore.end(), path) == filesBefore.end())
+                {
+                    cookedPath = path;
+                }
+            }
+            TEST_VERIFY(cookedPath.GetExtension() == ".pxmesh");
+
+            Vector<uint8> stored;
+            TEST_VERIFY(fileSystem->ReadFileContents(cookedPath, stored));
+            TEST_VERIFY(stored == cooked);
+
+            // second cooking reads cache without cooking: replaced file content is returned as is
+            const Vector<uint8> marker = { 1, 2, 3, 4 };
+            {
+                ScopedPtr<File> file(File::Create(cookedPath, File::CREATE | File::WRITE));
+                TEST_VERIFY(file && file->Write(marker.data(), static_cast<uint32>(marker.size())) == marker.size());
+            }
+            Vector<uint8> cookedAgain;
+            TEST_VERIFY(physicsModule->CookMesh(type, { box.get() }, cookedAgain));
+            TEST_VERIFY(cookedAgain == marker);
+            TEST_VERIFY(fileSystem->EnumerateFilesInDirectory(cookedMeshesFolder, false).size() == filesAfter.size());
+
+            // other geometry is cooked to other stream
+            fileSystem->DeleteFile(cookedPath);
+            Vector<uint8> cookedOther;
+            TEST_VERIFY(physicsModule->CookMesh(type, { otherBox.get() }, cookedOther));
+            TEST_VERIFY(cooked != cookedOther);
+        }
+
+        // prepared meshes are created once and are reused by shapes
+        PhysicsGeometryCache cache;
+        Vector<PhysicsModule::MeshGeometry> meshes(3);
+        meshes[0].type = PhysicsModule::MESH_CONVEX_HULL;
+        meshes[0].polygons = { box.get() };
+        meshes[1].type = PhysicsModule::MESH_CONVEX_HULL;
+        meshes[1].polygons = { box.get() };
+        meshes[2].type = PhysicsModule::MESH_TRIANGLE_MESH;
+        meshes[2].polygons = { otherBox.get() };
+        physicsModule->PrepareMeshes(std::move(meshes), &cache);
+
+        physx::PxBase* convexHull = cache.GetConvexHullEntry({ box.get() });
+        TEST_VERIFY(convexHull != nullptr);
+        TEST_VERIFY(cache.GetTriangleMeshEntry({ otherBox.get() }) != nullptr);
+        TEST_VERIFY(cache.GetTriangleMeshEntry({ box.get() }) == nullptr);
+
+        physx::PxShape* shape = physicsModule->CreateConvexHullShape({ box.get() }, Vector3(1.0f, 1.0f, 1.0f), FastName(), &cache);
+        TEST_VERIFY(shape != nullptr);
+        TEST_VERIFY(cache.GetConvexHullEntry({ box.get() }) == convexHull);
+        shape->release();
+
+        fileSystem->DeleteDirectoryFiles(cookedMeshesFolder);
+    }
+
+    DAVA_TEST (MultiGroupMeshShapeTest)
+    {
+        using namespace PhysicsTestDetils;
+
+        PhysicsModule* physicsModule = GetEngineContext()->moduleManager->GetModule<PhysicsModule>();
+        SceneInfo info = CreateScene();
+
+        ScopedPtr<PolygonGroup> box(CreateBoxPolygonGroup(1.0f));
+        ScopedPtr<PolygonGroup> otherBox(CreateBoxPolygonGroup(2.0f));
+        // groups of render batches are not sorted and repeat
+        Vector<PolygonGroup*> groups = { otherBox.get(), box.get(), otherBox.get() };
+        if (groups[0] < groups[1])
+        {
+            std::swap(groups[0], groups[1]);
+        }
+
+        // several new mesh shapes are prepared in one batch before shapes are created
+        ScopedPtr<Entity> multiGroupEntity(CreateMeshEntity(groups));
+        ScopedPtr<Entity> singleGroupEntity(CreateMeshEntity({ box.get() }));
+        info.entity->AddNode(multiGroupEntity);
+        info.entity->AddNode(singleGroupEntity);
+        Frame(info);
+
+        PhysicsGeometryCache* cache = PhysicsSystemPrivate::GetGeometryCache(info.scene->physicsSystem);
+        Vector<PolygonGroup*> key = groups;
+        PhysicsGeometryCache::MakeKey(key);
+        TEST_VERIFY(key.size() == 2);
+
+        physx::PxBase* preparedMesh = cache->GetTriangleMeshEntry(key);
+        TEST_VERIFY(preparedMesh != nullptr);
+        TEST_VERIFY(cache->GetTriangleMeshEntry({ box.get() }) != nullptr);
+
+        MeshShapeComponent* component = multiGroupEntity->GetComponent<MeshShapeComponent>();
+        physx::PxShape* shape = component->GetPxShape();
+        TEST_VERIFY(shape != nullptr);
+        if (shape != nullptr)
+        {
+            // shape uses prepared mesh instead of mesh cooked again by key in other order
+            physx::PxTriangleMeshGeometry geometry;
+            TEST_VERIFY(shape->getTriangleMeshGeometry(geometry));
+            TEST_VERIFY(geometry.triangleMesh == preparedMesh);
+        }
+
+        FileSystem::Instance()->DeleteDirectoryFiles(physicsModule->GetCookedMeshesFolder());
+    }
+
     DAVA_TEST (AddStaticBodyTest)
     {
         using namespace PhysicsTestDetils;
@@ -69,6 +69,8 @@ public:
     static const String Tag;
     static const String TagList;
 
+    static const String Software;
+
     static const String MakeNameForGPU(eGPUFamily gpuFamily);
 };
 
@@ -63,6 +63,8 @@ const String OptionName::Count("-count");
 const String OptionName::Tag("-tag");
 const String OptionName::TagList("-taglist");
 
+const String OptionName::Software("-software");
+
 const String OptionName::MakeNameForGPU(eGPUFamily gpuFamily)
 {
     return ("-" + GPUFamilyDescriptor::GetGPUName(gpuFamily));
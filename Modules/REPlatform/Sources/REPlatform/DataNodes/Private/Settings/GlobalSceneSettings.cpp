@@ -22,6 +22,7 @@ DAVA_VIRTUAL_REFLECTION_IMPL(GlobalSceneSettings)
     .Field("saveEmitters", &GlobalSceneSettings::saveEmitters)[M::DisplayName("Save Emitters")]
     .Field("saveEntityPositionOnHierarchyChange", &GlobalSceneSettings::saveEntityPositionOnHierarchyChange)[DAVA::M::DisplayName("Save entity position on hierarchy change")]
     .Field("saveStaticOcclusion", &GlobalSceneSettings::saveStaticOcclusion)[M::DisplayName("Save static occlusion")]
+    .Field("softwareStaticOcclusion", &GlobalSceneSettings::softwareStaticOcclusion)[M::DisplayName("Build static occlusion on CPU")]
     .Field("defaultCustomColorIndex", &GlobalSceneSettings::defaultCustomColorIndex)[M::DisplayName("Default custom color index")]
     .Field("selectionDrawMode", &GlobalSceneSettings::selectionDrawMode)[M::DisplayName("Selection draw mode"), M::FlagsT<SelectionSystemDrawMode>()]
     .Field("gridStep", &GlobalSceneSettings::gridStep)[M::DisplayName("Step"), M::Group("Grid")]
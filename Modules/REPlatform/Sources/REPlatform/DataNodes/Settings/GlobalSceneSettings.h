@@ -48,6 +48,7 @@ public:
     bool saveEmitters = false;
     bool saveEntityPositionOnHierarchyChange = true;
     bool saveStaticOcclusion = true;
+    bool softwareStaticOcclusion = false;
     uint32 defaultCustomColorIndex = 0;
     bool openLastScene = false;
 
@@ -0,0 +1,116 @@
+#include "SceneLoadingTest.h"
+
+#include <Base/ScopedPtr.h>
+#include <Logger/Logger.h>
+#include <Scene3D/Scene.h>
+#include <Scene3D/SceneFile/AsyncSceneLoader.h>
+#include <Time/SystemTimer.h>
+
+SceneLoadingTest::SceneLoadingTest(DAVA::Engine& engine)
+    : engine(engine)
+{
+    engine.update.Connect(this, &SceneLoadingTest::Update);
+}
+
+SceneLoadingTest::~SceneLoadingTest()
+{
+    engine.update.Disconnect(this);
+    Stop();
+}
+
+bool SceneLoadingTest::Start(const DAVA::FilePath& scenePath_)
+{
+    using namespace DAVA;
+
+    if (state != StateFinished)
+    {
+        DVASSERT(false, "can't start already started test");
+        return false;
+    }
+
+    Stop();
+
+    scenePath = scenePath_;
+    result = SceneLoadingTestResult();
+
+    {
+        ScopedPtr<Scene> syncScene(new Scene());
+        int64 startTime = SystemTimer::GetMs();
+        SceneFileV2::eError error = syncScene->LoadScene(scenePath);
+        result.syncLoadTimeMs = SystemTimer::GetMs() - startTime;
+
+        if (error != SceneFileV2::ERROR_NO_ERROR)
+        {
+            Logger::Error("SceneLoadingTest: can't load scene %s, error %d", scenePath.GetStringValue().c_str(), error);
+            return false;
+        }
+    }
+
+    loader = new AsyncSceneLoader(scenePath);
+    loader->Start();
+    state = StateLoading;
+
+    return true;
+}
+
+void SceneLoadingTest::Stop()
+{
+    DAVA::SafeRelease(loader);
+    DAVA::SafeRelease(scene);
+    state = StateFinished;
+}
+
+SceneLoadingTest::State SceneLoadingTest::GetState() const
+{
+    return state;
+}
+
+DAVA::float32 SceneLoadingTest::GetProgress() const
+{
+    return (loader != nullptr) ? loader->GetProgress() : 1.f;
+}
+
+const SceneLoadingTestResult& SceneLoadingTest::GetResult() const
+{
+    return result;
+}
+
+void SceneLoadingTest::Update(DAVA::float32 timeElapsed)
+{
+    using namespace DAVA;
+
+    if (state != StateLoading)
+    {
+        return;
+    }
+
+    result.maxFrameTimeMs = Max(result.maxFrameTimeMs, timeElapsed * 1000.f);
+    ++result.framesDuringLoading;
+
+    if (loader->IsFinished())
+    {
+        // attach is spread over frames to keep each of them short
+        const int64 attachTimeBudgetUs = 2000;
+
+        if (scene == nullptr)
+        {
+            scene = new Scene();
+        }
+        ++result.attachFrames;
+        if (!loader->AttachPartTo(scene, attachTimeBudgetUs))
+        {
+            return;
+        }
+
+        result.asyncLoadTimeMs = loader->GetLoadingTime();
+        result.asyncAttachTimeUs = loader->GetAttachTime();
+        SafeRelease(loader);
+
+        Logger::Info("SceneLoadingTest %s: sync load %lld ms, async load %lld ms, attach %lld us in %u frames, max frame %.2f ms during %u frames",
+                     scenePath.GetFilename().c_str(),
+                     result.syncLoadTimeMs, result.asyncLoadTimeMs, result.asyncAttachTimeUs, result.attachFrames,
+                     result.maxFrameTimeMs, result.framesDuringLoading);
+
+        state = StateFinished;
+    }
+}
@@ -0,0 +1,131 @@
+#include "SkeletonAnimationTest.h"
+
+#include <Base/ScopedPtr.h>
+#include <Logger/Logger.h>
+#include <Scene3D/Scene.h>
+#include <Scene3D/Components/ComponentHelpers.h>
+#include <Scene3D/Components/TransformComponent.h>
+#include <Scene3D/Systems/MotionSystem.h>
+#include <Scene3D/Systems/SkeletonSystem.h>
+#include <Time/SystemTimer.h>
+
+namespace SkeletonAnimationTestDetails
+{
+const DAVA::float32 FRAME_TIME = 1.f / 60.f;
+const DAVA::float32 CHARACTERS_SPACING = 2.f;
+}
+
+SkeletonAnimationTest::SkeletonAnimationTest(DAVA::Engine& engine)
+    : engine(engine)
+{
+    engine.update.Connect(this, &SkeletonAnimationTest::Update);
+}
+
+SkeletonAnimationTest::~SkeletonAnimationTest()
+{
+    engine.update.Disconnect(this);
+    Stop();
+}
+
+bool SkeletonAnimationTest::Start(const DAVA::FilePath& characterScenePath, DAVA::uint32 charactersCount, DAVA::uint32 framesCount)
+{
+    using namespace DAVA;
+    using namespace SkeletonAnimationTestDetails;
+
+    if (state != StateFinished)
+    {
+        DVASSERT(false, "can't start already started test");
+        return false;
+    }
+
+    Stop();
+
+    ScopedPtr<Scene> characterScene(new Scene());
+    SceneFileV2::eError error = characterScene->LoadScene(characterScenePath);
+    if (error != SceneFileV2::ERROR_NO_ERROR)
+    {
+        Logger::Error("SkeletonAnimationTest: can't load scene %s, error %d", characterScenePath.GetStringValue().c_str(), error);
+        return false;
+    }
+
+    Vector<Entity*> characters;
+    characterScene->GetChildEntitiesWithCondition(characters, [](Entity* entity) {
+        return GetSkeletonComponent(entity) != nullptr && GetMotionComponent(entity) != nullptr;
+    });
+
+    if (characters.empty())
+    {
+        Logger::Error("SkeletonAnimationTest: scene %s has no entity with skeleton and motion", characterScenePath.GetStringValue().c_str());
+        return false;
+    }
+
+    scene = new Scene();
+    uint32 rowSize = static_cast<uint32>(std::ceil(std::sqrt(static_cast<float32>(charactersCount))));
+    for (uint32 i = 0; i < charactersCount; ++i)
+    {
+        ScopedPtr<Entity> character(characters.front()->Clone());
+        Vector3 position(CHARACTERS_SPACING * (i % rowSize), CHARACTERS_SPACING * (i / rowSize), 0.f);
+        GetTransformComponent(character)->SetLocalTranslation(position);
+        scene->AddNode(character);
+    }
+
+    result = SkeletonAnimationTestResult();
+    result.charactersCount = charactersCount;
+    result.framesCount = framesCount;
+    frameIndex = 0;
+    totalTimeUs = 0;
+    state = StateRunning;
+
+    return true;
+}
+
+void SkeletonAnimationTest::Stop()
+{
+    DAVA::SafeRelease(scene);
+    state = StateFinished;
+}
+
+SkeletonAnimationTest::State SkeletonAnimationTest::GetState() const
+{
+    return state;
+}
+
+const SkeletonAnimationTestResult& SkeletonAnimationTest::GetResult() const
+{
+    return result;
+}
+
+void SkeletonAnimationTest::Update(DAVA::float32 timeElapsed)
+{
+    using namespace DAVA;
+    using namespace SkeletonAnimationTestDetails;
+
+    if (state != StateRunning)
+    {
+        return;
+    }
+
+    int64 startTime = SystemTimer::GetUs();
+    scene->motionSystem->Process(FRAME_TIME);
+    scene->skeletonSystem->Process(FRAME_TIME);
+    int64 frameTime = SystemTimer::GetUs() - startTime;
+
+    // first frame binds motions and builds skeletons, it is not counted
+    if (frameIndex > 0)
+    {
+        totalTimeUs += frameTime;
+        result.maxFrameTimeMs = Max(result.maxFrameTimeMs, static_cast<float32>(frameTime) / 1000.f);
+    }
+
+    if (++frameIndex > result.framesCount)
+    {
+        float32 totalTimeMs = static_cast<float32>(totalTimeUs) / 1000.f;
+        result.avgFrameTimeMs = (result.framesCount > 0) ? totalTimeMs / result.framesCount : 0.f;
+        result.charactersPerMs = (totalTimeMs > 0.f) ? (result.charactersCount * result.framesCount) / totalTimeMs : 0.f;
+
+        Logger::Info("SkeletonAnimationTest: %u characters, %u frames, avg frame %.3f ms, max frame %.3f ms, %.1f characters per ms",
+                     result.charactersCount, result.framesCount, result.avgFrameTimeMs, result.maxFrameTimeMs, result.charactersPerMs);
+
+        Stop();
+    }
+}
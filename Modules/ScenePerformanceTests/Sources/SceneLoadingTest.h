@@ -0,0 +1,56 @@
+#pragma once
+
+#include <Base/BaseTypes.h>
+#include <Engine/Engine.h>
+#include <FileSystem/FilePath.h>
+
+namespace DAVA
+{
+class AsyncSceneLoader;
+class Scene;
+}
+
+struct SceneLoadingTestResult
+{
+    DAVA::int64 syncLoadTimeMs = 0; // blocking load on main thread, main thread stalls for whole time
+    DAVA::int64 asyncLoadTimeMs = 0; // load time on loading thread
+    DAVA::int64 asyncAttachTimeUs = 0; // time spent on main thread to attach loaded scene
+    DAVA::uint32 attachFrames = 0; // frames over which attach was spread
+    DAVA::float32 maxFrameTimeMs = 0.f; // longest frame while async loading was in progress
+    DAVA::uint32 framesDuringLoading = 0;
+};
+
+/**
+    Measures scene loading: blocking SceneFileV2 load on main thread versus AsyncSceneLoader.
+    Async part of test runs while engine keeps updating frames, so it also measures main thread stall.
+*/
+class SceneLoadingTest final
+{
+public:
+    enum State : DAVA::uint8
+    {
+        StateLoading,
+        StateFinished
+    };
+
+    explicit SceneLoadingTest(DAVA::Engine& engine);
+    ~SceneLoadingTest();
+
+    bool Start(const DAVA::FilePath& scenePath);
+    void Stop();
+
+    State GetState() const;
+    DAVA::float32 GetProgress() const;
+    const SceneLoadingTestResult& GetResult() const;
+
+private:
+    void Update(DAVA::float32 timeElapsed);
+
+    DAVA::Engine& engine;
+    DAVA::FilePath scenePath;
+    DAVA::AsyncSceneLoader* loader = nullptr;
+    DAVA::Scene* scene = nullptr;
+
+    State state = StateFinished;
+    SceneLoadingTestResult result;
+};
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <Base/BaseTypes.h>
+#include <Engine/Engine.h>
+#include <FileSystem/FilePath.h>
+
+namespace DAVA
+{
+class Scene;
+}
+
+struct SkeletonAnimationTestResult
+{
+    DAVA::uint32 charactersCount = 0;
+    DAVA::uint32 framesCount = 0;
+    DAVA::float32 avgFrameTimeMs = 0.f; // motion and skeleton systems time per frame
+    DAVA::float32 maxFrameTimeMs = 0.f;
+    DAVA::float32 charactersPerMs = 0.f; // animated characters processed per millisecond
+};
+
+/**
+    Measures skeletal animation throughput: character from scene is cloned into a crowd,
+    and MotionSystem and SkeletonSystem of the crowd scene are processed with fixed time step every frame.
+*/
+class SkeletonAnimationTest final
+{
+public:
+    enum State : DAVA::uint8
+    {
+        StateRunning,
+        StateFinished
+    };
+
+    explicit SkeletonAnimationTest(DAVA::Engine& engine);
+    ~SkeletonAnimationTest();
+
+    bool Start(const DAVA::FilePath& characterScenePath, DAVA::uint32 charactersCount, DAVA::uint32 framesCount = 300);
+    void Stop();
+
+    State GetState() const;
+    const SkeletonAnimationTestResult& GetResult() const;
+
+private:
+    void Update(DAVA::float32 timeElapsed);
+
+    DAVA::Engine& engine;
+    DAVA::Scene* scene = nullptr;
+
+    DAVA::uint32 frameIndex = 0;
+    DAVA::int64 totalTimeUs = 0;
+
+    State state = StateFinished;
+    SkeletonAnimationTestResult result;
+};
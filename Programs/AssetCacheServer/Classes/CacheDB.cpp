@@ -4,20 +4,39 @@
 
 #include <AssetCache/CachedItemValue.h>
 
+#include <FileSystem/DynamicMemoryFile.h>
 #include <FileSystem/File.h>
+#include <FileSystem/FileList.h>
 #include <FileSystem/FileSystem.h>
 #include <FileSystem/KeyedArchive.h>
+#include <FileSystem/Private/FileMapping.h>
 #include <Debug/DVAssert.h>
 #include <Time/SystemTimer.h>
 #include <Utils/StringFormat.h>
 #include <Logger/Logger.h>
 
+#include <algorithm>
+#include <cctype>
+
 const DAVA::String CacheDB::DB_FILE_NAME = "cache.dat";
-const DAVA::uint32 CacheDB::VERSION = 1;
+const DAVA::String CacheDB::JOURNAL_FILE_NAME = "cache.journal";
+const DAVA::uint32 CacheDB::VERSION = 2;
+const DAVA::uint32 CacheDB::INDEX_SIGNATURE = DAVA_MAKEFOURCC('A', 'C', 'D', 'I');
+const DAVA::uint32 CacheDB::JOURNAL_SIGNATURE = DAVA_MAKEFOURCC('A', 'C', 'D', 'J');
+const DAVA::uint64 CacheDB::MIN_RECORDS_TO_COMPACT = 4096;
+
+namespace CacheDBDetails
+{
+bool IsHexString(const DAVA::String& string)
+{
+    return std::all_of(string.begin(), string.end(), [](DAVA::char8 c) { return std::isxdigit(static_cast<unsigned char>(c)) != 0; });
+}
+}
 
 CacheDB::CacheDB(CacheDBOwner& _owner)
     : owner(_owner)
     , dbStateChanged(false)
+    , pendingRecords(DAVA::DynamicMemoryFile::Create(DAVA::File::CREATE | DAVA::File::READ | DAVA::File::WRITE))
 {
 }
 
@@ -48,6 +67,7 @@ void CacheDB::UpdateSettings(const DAVA::FilePath& folderPath, const DAVA::uint6
 
         cacheRootFolder = newCacheRootFolder;
         cacheSettings = cacheRootFolder + DB_FILE_NAME;
+        cacheJournal = cacheRootFolder + JOURNAL_FILE_NAME;
 
         Load();
         fullCacheChanged = true;
@@ -87,25 +107,136 @@ void CacheDB::Load()
     DVASSERT(fastCache.empty());
     DVASSERT(fullCache.empty());
 
-    DAVA::ScopedPtr<DAVA::File> file(DAVA::File::Create(cacheSettings, DAVA::File::OPEN | DAVA::File::READ));
-    if (!file)
+    occupiedSize = 0;
+    journalRecordsCount = 0;
+    indexID = 0;
+    pendingRecords->Truncate(0);
+
+    bool needCompact = true;
+    bool indexLoaded = false;
     {
-        return;
+        // file is closed before compaction, mapped index can't be replaced on some platforms
+        DAVA::ScopedPtr<DAVA::File> file(OpenIndex());
+        if (file)
+        {
+            DAVA::uint32 signature = 0;
+            file->Read(&signature);
+            if (signature == INDEX_SIGNATURE)
+            {
+                indexLoaded = LoadIndex(file);
+                if (indexLoaded)
+                {
+                    needCompact = !LoadJournal();
+                }
+            }
+            else
+            {
+                // database saved by previous version, it will be converted into index
+                file->Seek(0, DAVA::File::SEEK_FROM_START);
+                indexLoaded = LoadLegacyArchive(file);
+            }
+        }
+    }
+
+    if (!indexLoaded)
+    {
+        // journal is applied only if header of damaged index was read, otherwise indexID doesn't match any journal
+        LoadJournal();
+        LoadDataFolders();
+    }
+
+    NotifySizeChanged();
+
+    if (needCompact)
+    {
+        Compact();
     }
 
+    dbStateChanged = false;
+}
+
+DAVA::File* CacheDB::OpenIndex() const
+{
+    DAVA::FileSystem* fileSystem = DAVA::FileSystem::Instance();
+    if (!fileSystem->IsFile(cacheSettings))
+    {
+        return nullptr;
+    }
+
+    // index is parsed directly from mapped pages, without reading of whole file into memory
+    std::shared_ptr<DAVA::FileMapping> mapping = std::make_shared<DAVA::FileMapping>();
+    if (mapping->Map(cacheSettings))
+    {
+        return new DAVA::MappedFile(mapping, mapping->GetData(), mapping->GetSize(), cacheSettings);
+    }
+
+    DAVA::Vector<DAVA::uint8> indexData;
+    if (fileSystem->ReadFileContents(cacheSettings, indexData))
+    {
+        return DAVA::DynamicMemoryFile::Create(std::move(indexData), DAVA::File::OPEN | DAVA::File::READ, cacheSettings);
+    }
+
+    DAVA::Logger::Error("[CacheDB::%s] Can't read %s", __FUNCTION__, cacheSettings.GetStringValue().c_str());
+    return nullptr;
+}
+
+bool CacheDB::LoadIndex(DAVA::File* file)
+{
+    DAVA::uint32 version = 0;
+    DAVA::uint64 id = 0;
+    DAVA::uint64 itemsCount = 0;
+    if (file->Read(&version) != sizeof(version) || file->Read(&id) != sizeof(id) || file->Read(&itemsCount) != sizeof(itemsCount))
+    {
+        DAVA::Logger::Error("[CacheDB::%s] Can't read header of %s", __FUNCTION__, cacheSettings.GetStringValue().c_str());
+        return false;
+    }
+
+    if (version != VERSION)
+    {
+        DAVA::Logger::Error("[CacheDB::%s] Wrong version %u of %s", __FUNCTION__, version, cacheSettings.GetStringValue().c_str());
+        return false;
+    }
+
+    indexID = id;
+
+    // items count is limited by file size, so damaged header can't cause huge allocation
+    const DAVA::uint64 minItemSize = DAVA::AssetCache::HASH_SIZE + sizeof(DAVA::uint64);
+    fullCache.reserve(static_cast<size_t>(std::min(itemsCount, file->GetSize() / minItemSize)));
+    for (DAVA::uint64 index = 0; index < itemsCount; ++index)
+    {
+        DAVA::AssetCache::CacheItemKey key;
+        ServerCacheEntry entry;
+        if (file->Read(key.data(), static_cast<DAVA::uint32>(key.size())) != key.size() || !entry.Deserialize(file))
+        {
+            // already read items are kept, the rest are restored from journal and data folders
+            DAVA::Logger::Error("[CacheDB::%s] Can't read item %llu of %s", __FUNCTION__, index, cacheSettings.GetStringValue().c_str());
+            return false;
+        }
+
+        occupiedSize += entry.GetValue().GetSize();
+        fullCache[key] = std::move(entry);
+    }
+
+    return true;
+}
+
+bool CacheDB::LoadLegacyArchive(DAVA::File* file)
+{
+    static const DAVA::uint32 LEGACY_VERSION = 1;
+
     DAVA::ScopedPtr<DAVA::KeyedArchive> header(new DAVA::KeyedArchive());
     header->Load(file);
 
     if (header->GetString("signature") != "cache")
     {
         DAVA::Logger::Error("[CacheDB::%s] Wrong signature %s", __FUNCTION__, header->GetString("signature").c_str());
-        return;
+        return false;
     }
 
-    if (header->GetUInt32("version") != VERSION)
+    if (header->GetUInt32("version") != LEGACY_VERSION)
     {
-        DVASSERT(false, "cachedb file version is changed. Versions load functions should be implemented");
-        return;
+        DAVA::Logger::Error("[CacheDB::%s] Wrong version %u", __FUNCTION__, header->GetUInt32("version"));
+        return false;
     }
 
     DAVA::uint64 cacheSize = header->GetUInt64("itemsCount");
@@ -115,10 +246,9 @@ void CacheDB::Load()
     if (!cache->Load(file))
     {
         DAVA::Logger::Error("[%s] Can't load cache file", __FUNCTION__);
-        return;
+        return false;
     }
 
-    occupiedSize = 0;
     for (DAVA::uint64 index = 0; index < cacheSize; ++index)
     {
         DAVA::KeyedArchive* itemArchieve = cache->GetArchive(DAVA::Format("item_%d", index));
@@ -134,8 +264,201 @@ void CacheDB::Load()
         fullCache[key] = std::move(entry);
     }
 
-    NotifySizeChanged();
-    dbStateChanged = false;
+    return true;
+}
+
+bool CacheDB::LoadJournal()
+{
+    DAVA::Vector<DAVA::uint8> journalData;
+    DAVA::FileSystem* fileSystem = DAVA::FileSystem::Instance();
+    if (!fileSystem->IsFile(cacheJournal) || !fileSystem->ReadFileContents(cacheJournal, journalData))
+    {
+        return false;
+    }
+
+    DAVA::ScopedPtr<DAVA::File> file(DAVA::DynamicMemoryFile::Create(std::move(journalData), DAVA::File::OPEN | DAVA::File::READ, cacheJournal));
+
+    DAVA::uint32 signature = 0;
+    DAVA::uint32 version = 0;
+    DAVA::uint64 id = 0;
+    if (file->Read(&signature) != sizeof(signature) || file->Read(&version) != sizeof(version) || file->Read(&id) != sizeof(id))
+    {
+        DAVA::Logger::Error("[CacheDB::%s] Can't read header of %s", __FUNCTION__, cacheJournal.GetStringValue().c_str());
+        return false;
+    }
+
+    if (signature != JOURNAL_SIGNATURE || version != VERSION || id != indexID)
+    {
+        // journal was not reset after last compaction, all its records are already in index
+        DAVA::Logger::Warning("[CacheDB::%s] Journal %s doesn't match index and is ignored", __FUNCTION__, cacheJournal.GetStringValue().c_str());
+        return false;
+    }
+
+    DAVA::uint64 journalSize = file->GetSize();
+    while (file->GetPos() < journalSize)
+    {
+        if (!ReadJournalRecord(file))
+        {
+            // server was stopped while record was being written
+            DAVA::Logger::Warning("[CacheDB::%s] Journal %s is damaged, records after %llu are ignored", __FUNCTION__, cacheJournal.GetStringValue().c_str(), journalRecordsCount);
+            return false;
+        }
+        ++journalRecordsCount;
+    }
+
+    return true;
+}
+
+bool CacheDB::ReadJournalRecord(DAVA::File* file)
+{
+    DAVA::uint8 type = 0;
+    DAVA::AssetCache::CacheItemKey key;
+    if (file->Read(&type) != sizeof(type) || file->Read(key.data(), static_cast<DAVA::uint32>(key.size())) != key.size())
+    {
+        return false;
+    }
+
+    auto found = fullCache.find(key);
+    switch (type)
+    {
+    case RECORD_INSERT:
+    {
+        ServerCacheEntry entry;
+        if (!entry.Deserialize(file))
+        {
+            return false;
+        }
+
+        if (found != fullCache.end())
+        {
+            occupiedSize -= found->second.GetValue().GetSize();
+            fullCache.erase(found);
+        }
+
+        occupiedSize += entry.GetValue().GetSize();
+        fullCache[key] = std::move(entry);
+        return true;
+    }
+    case RECORD_REMOVE:
+    {
+        if (found != fullCache.end())
+        {
+            occupiedSize -= found->second.GetValue().GetSize();
+            fullCache.erase(found);
+        }
+        return true;
+    }
+    case RECORD_TOUCH:
+    {
+        DAVA::uint64 timestamp = 0;
+        if (file->Read(&timestamp) != sizeof(timestamp))
+        {
+            return false;
+        }
+
+        if (found != fullCache.end())
+        {
+            found->second.SetTimestamp(timestamp);
+        }
+        return true;
+    }
+    default:
+        return false;
+    }
+}
+
+void CacheDB::LoadDataFolders()
+{
+    // item folders are named by key string: cacheRootFolder/XX/YYYY.../ where XXYYYY... is key
+    const DAVA::String::size_type keyStringLength = DAVA::AssetCache::HASH_SIZE * 2;
+
+    DAVA::uint32 restoredCount = 0;
+    DAVA::ScopedPtr<DAVA::FileList> rootList(new DAVA::FileList(cacheRootFolder, false));
+    for (DAVA::uint32 i = 0; i < rootList->GetCount(); ++i)
+    {
+        const DAVA::String& prefix = rootList->GetFilename(i);
+        if (!rootList->IsDirectory(i) || rootList->IsNavigationDirectory(i) || prefix.length() != 2 || !CacheDBDetails::IsHexString(prefix))
+        {
+            continue;
+        }
+
+        DAVA::ScopedPtr<DAVA::FileList> itemsList(new DAVA::FileList(rootList->GetPathname(i), false));
+        for (DAVA::uint32 j = 0; j < itemsList->GetCount(); ++j)
+        {
+            DAVA::String keyString = prefix + itemsList->GetFilename(j);
+            if (!itemsList->IsDirectory(j) || itemsList->IsNavigationDirectory(j) || keyString.length() != keyStringLength || !CacheDBDetails::IsHexString(keyString))
+            {
+                continue;
+            }
+
+            DAVA::AssetCache::CacheItemKey key;
+            key.FromString(keyString);
+            if (fullCache.count(key) != 0)
+            {
+                continue;
+            }
+
+            ServerCacheEntry entry;
+            if (LoadDataFolder(itemsList->GetPathname(j), entry))
+            {
+                occupiedSize += entry.GetValue().GetSize();
+                fullCache[key] = std::move(entry);
+                ++restoredCount;
+            }
+        }
+    }
+
+    if (restoredCount > 0)
+    {
+        DAVA::Logger::Warning("[CacheDB::%s] %u items are restored from data folders of %s", __FUNCTION__, restoredCount, cacheRootFolder.GetStringValue().c_str());
+    }
+}
+
+bool CacheDB::LoadDataFolder(const DAVA::FilePath& folder, ServerCacheEntry& entry) const
+{
+    DAVA::AssetCache::CachedItemValue& value = entry.GetValue();
+
+    DAVA::ScopedPtr<DAVA::FileList> filesList(new DAVA::FileList(folder, false));
+    for (DAVA::uint32 i = 0; i < filesList->GetCount(); ++i)
+    {
+        if (!filesList->IsDirectory(i))
+        {
+            value.Add(filesList->GetPathname(i));
+        }
+    }
+
+    if (value.IsEmpty())
+    {
+        return false;
+    }
+
+    // description of item is lost, access timestamp is zero to remove restored items first
+    value.UpdateValidationData();
+    value.Free();
+    return true;
+}
+
+void CacheDB::WriteJournalRecord(eJournalRecord type, const DAVA::AssetCache::CacheItemKey& key, const ServerCacheEntry* entry)
+{
+    DAVA::File* file = pendingRecords;
+
+    DAVA::uint8 recordType = type;
+    file->Write(&recordType);
+    file->Write(key.data(), static_cast<DAVA::uint32>(key.size()));
+
+    if (type == RECORD_INSERT)
+    {
+        DVASSERT(nullptr != entry);
+        entry->Serialize(file);
+    }
+    else if (type == RECORD_TOUCH)
+    {
+        DVASSERT(nullptr != entry);
+        DAVA::uint64 timestamp = entry->GetTimestamp();
+        file->Write(&timestamp);
+    }
+
+    ++journalRecordsCount;
 }
 
 void CacheDB::Unload()
@@ -154,33 +477,83 @@ void CacheDB::Unload()
 }
 
 void CacheDB::Save()
+{
+    DAVA::uint32 pendingSize = static_cast<DAVA::uint32>(pendingRecords->GetSize());
+    if (pendingSize > 0)
+    {
+        if (journalRecordsCount >= MIN_RECORDS_TO_COMPACT && journalRecordsCount > fullCache.size())
+        {
+            Compact();
+            return;
+        }
+
+        DAVA::ScopedPtr<DAVA::File> file(DAVA::File::Create(cacheJournal, DAVA::File::APPEND | DAVA::File::WRITE));
+        if (!file || file->Write(pendingRecords->GetData(), pendingSize) != pendingSize)
+        {
+            DAVA::Logger::Error("[CacheDB::%s] Cannot write journal %s", __FUNCTION__, cacheJournal.GetStringValue().c_str());
+            Compact();
+            return;
+        }
+
+        pendingRecords->Truncate(0);
+    }
+
+    dbStateChanged = false;
+    lastSaveTime = DAVA::SystemTimer::GetMs();
+}
+
+void CacheDB::Compact()
 {
     DAVA::FileSystem::Instance()->CreateDirectory(cacheRootFolder, true);
 
-    DAVA::ScopedPtr<DAVA::File> file(DAVA::File::Create(cacheSettings, DAVA::File::CREATE | DAVA::File::WRITE));
-    if (!file)
+    // new index is written into temporary file, so previous index and journal stay valid until new index is complete
+    DAVA::FilePath tempIndexPath = cacheRootFolder + (DB_FILE_NAME + ".tmp");
+    DAVA::uint64 newIndexID = indexID + 1;
     {
-        DAVA::Logger::Error("[CacheDB::%s] Cannot create file %s", __FUNCTION__, cacheSettings.GetStringValue().c_str());
-        return;
-    }
+        DAVA::ScopedPtr<DAVA::File> file(DAVA::File::Create(tempIndexPath, DAVA::File::CREATE | DAVA::File::WRITE));
+        if (!file)
+        {
+            DAVA::Logger::Error("[CacheDB::%s] Cannot create file %s", __FUNCTION__, tempIndexPath.GetStringValue().c_str());
+            return;
+        }
 
-    DAVA::ScopedPtr<DAVA::KeyedArchive> header(new DAVA::KeyedArchive());
-    header->SetString("signature", "cache");
-    header->SetUInt32("version", VERSION);
-    header->SetUInt64("itemsCount", fullCache.size());
-    header->Save(file);
+        DAVA::uint64 itemsCount = fullCache.size();
+        bool written = file->Write(&INDEX_SIGNATURE) == sizeof(INDEX_SIGNATURE) && file->Write(&VERSION) == sizeof(VERSION) &&
+        file->Write(&newIndexID) == sizeof(newIndexID) && file->Write(&itemsCount) == sizeof(itemsCount);
 
-    DAVA::ScopedPtr<DAVA::KeyedArchive> cache(new DAVA::KeyedArchive());
-    DAVA::uint64 index = 0;
-    for (auto& item : fullCache)
+        for (auto it = fullCache.begin(); written && it != fullCache.end(); ++it)
+        {
+            written = file->Write(it->first.data(), static_cast<DAVA::uint32>(it->first.size())) == it->first.size() && it->second.Serialize(file);
+        }
+
+        if (!written)
+        {
+            DAVA::Logger::Error("[CacheDB::%s] Cannot write file %s", __FUNCTION__, tempIndexPath.GetStringValue().c_str());
+            return;
+        }
+    }
+
+    if (!DAVA::FileSystem::Instance()->MoveFile(tempIndexPath, cacheSettings, true))
     {
-        DAVA::ScopedPtr<DAVA::KeyedArchive> itemArchieve(new DAVA::KeyedArchive());
-        item.first.Serialize(itemArchieve);
-        item.second.Serialize(itemArchieve);
+        DAVA::Logger::Error("[CacheDB::%s] Cannot replace file %s", __FUNCTION__, cacheSettings.GetStringValue().c_str());
+        return;
+    }
+    indexID = newIndexID;
 
-        cache->SetArchive(DAVA::Format("item_%d", index++), itemArchieve);
+    DAVA::ScopedPtr<DAVA::File> journal(DAVA::File::Create(cacheJournal, DAVA::File::CREATE | DAVA::File::WRITE));
+    if (journal)
+    {
+        journal->Write(&JOURNAL_SIGNATURE);
+        journal->Write(&VERSION);
+        journal->Write(&indexID);
     }
-    cache->Save(file);
+    else
+    {
+        DAVA::Logger::Error("[CacheDB::%s] Cannot create file %s", __FUNCTION__, cacheJournal.GetStringValue().c_str());
+    }
+
+    pendingRecords->Truncate(0);
+    journalRecordsCount = 0;
 
     dbStateChanged = false;
     lastSaveTime = DAVA::SystemTimer::GetMs();
@@ -258,7 +631,7 @@ ServerCacheEntry* CacheDB::Get(const DAVA::AssetCache::CacheItemKey& key)
         }
     }
 
-    UpdateAccessTimestamp(entry);
+    UpdateAccessTimestamp(key, entry);
 
     return entry;
 }
@@ -330,6 +703,7 @@ void CacheDB::Insert(const DAVA::AssetCache::CacheItemKey& key, ServerCacheEntry
     DAVA::FilePath savedPath = CreateFolderPath(key);
     insertedEntry->GetValue().ExportToFolder(savedPath);
     insertedEntry->UpdateAccessTimestamp();
+    WriteJournalRecord(RECORD_INSERT, key, insertedEntry);
     occupiedSize += insertedEntry->GetValue().GetSize();
     NotifySizeChanged();
 
@@ -369,14 +743,15 @@ void CacheDB::UpdateAccessTimestamp(const DAVA::AssetCache::CacheItemKey& key)
         entry = FindInFullCache(key);
     }
 
-    UpdateAccessTimestamp(entry);
+    UpdateAccessTimestamp(key, entry);
 }
 
-void CacheDB::UpdateAccessTimestamp(ServerCacheEntry* entry)
+void CacheDB::UpdateAccessTimestamp(const DAVA::AssetCache::CacheItemKey& key, ServerCacheEntry* entry)
 {
     if (nullptr != entry)
     {
         entry->UpdateAccessTimestamp();
+        WriteJournalRecord(RECORD_TOUCH, key, entry);
         dbStateChanged = true;
     }
 }
@@ -416,6 +791,7 @@ void CacheDB::RemoveFromFullCache(const CacheMap::iterator& it)
     DVASSERT(itemSize <= occupiedSize);
     occupiedSize -= itemSize;
     DAVA::Logger::Debug("Removing from full cache: key %s", Brief(it->first).c_str());
+    WriteJournalRecord(RECORD_REMOVE, it->first, nullptr);
     fullCache.erase(it);
     NotifySizeChanged();
 }
@@ -3,12 +3,15 @@
 #include <AssetCache/CacheItemKey.h>
 
 #include <Base/BaseTypes.h>
+#include <Base/ScopedPtr.h>
+#include <FileSystem/DynamicMemoryFile.h>
 #include <FileSystem/FilePath.h>
 
 #include <atomic>
 
 namespace DAVA
 {
+class File;
 namespace AssetCache
 {
 class CachedItemValue;
@@ -22,10 +25,33 @@ struct CacheDBOwner
     virtual void OnStorageSizeChanged(DAVA::uint64 occupied, DAVA::uint64 overall) = 0;
 };
 
+/*
+    Items description is stored in two files:
+    - index (cache.dat) with all items written at the moment of last compaction
+    - journal (cache.journal) with insert/remove/touch records of changes made after that compaction
+
+    Save appends records of changes made since previous save to journal, so its cost depends on count of changes only.
+    When journal grows bigger than index, both files are rewritten (compacted).
+    Index and journal are marked with the same ID, so journal left from previous index is ignored on load.
+
+    Index is mapped into memory on load. If it is missing or damaged, items from its undamaged part are completed
+    by journal and by items found in data folders, so compaction after load never drops items stored on disk.
+*/
 class CacheDB final
 {
     static const DAVA::String DB_FILE_NAME;
+    static const DAVA::String JOURNAL_FILE_NAME;
     static const DAVA::uint32 VERSION;
+    static const DAVA::uint32 INDEX_SIGNATURE;
+    static const DAVA::uint32 JOURNAL_SIGNATURE;
+    static const DAVA::uint64 MIN_RECORDS_TO_COMPACT;
+
+    enum eJournalRecord : DAVA::uint8
+    {
+        RECORD_INSERT = 1,
+        RECORD_REMOVE,
+        RECORD_TOUCH
+    };
 
     using CacheMap = DAVA::UnorderedMap<DAVA::AssetCache::CacheItemKey, ServerCacheEntry>;
     using FastCacheMap = DAVA::UnorderedMap<DAVA::AssetCache::CacheItemKey, ServerCacheEntry*>;
@@ -38,6 +64,7 @@ public:
 
     void Save();
     void Load();
+    void Compact();
 
     ServerCacheEntry* Get(const DAVA::AssetCache::CacheItemKey& key);
 
@@ -60,13 +87,22 @@ private:
 
     void Unload();
 
+    DAVA::File* OpenIndex() const;
+    bool LoadIndex(DAVA::File* file);
+    bool LoadLegacyArchive(DAVA::File* file);
+    bool LoadJournal();
+    bool ReadJournalRecord(DAVA::File* file);
+    void LoadDataFolders();
+    bool LoadDataFolder(const DAVA::FilePath& folder, ServerCacheEntry& entry) const;
+    void WriteJournalRecord(eJournalRecord type, const DAVA::AssetCache::CacheItemKey& key, const ServerCacheEntry* entry);
+
     ServerCacheEntry* FindInFastCache(const DAVA::AssetCache::CacheItemKey& key) const;
     ServerCacheEntry* FindInFullCache(const DAVA::AssetCache::CacheItemKey& key);
     const ServerCacheEntry* FindInFullCache(const DAVA::AssetCache::CacheItemKey& key) const;
 
     void InsertInFastCache(const DAVA::AssetCache::CacheItemKey& key, ServerCacheEntry* entry);
 
-    void UpdateAccessTimestamp(ServerCacheEntry* entry);
+    void UpdateAccessTimestamp(const DAVA::AssetCache::CacheItemKey& key, ServerCacheEntry* entry);
 
     void ReduceFullCacheToSize(DAVA::uint64 toSize);
     void ReduceFastCacheByCount(DAVA::uint32 countToRemove);
@@ -83,6 +119,7 @@ private:
 
     DAVA::FilePath cacheRootFolder; //path to folder with settings and cache of files
     DAVA::FilePath cacheSettings; //path to settings
+    DAVA::FilePath cacheJournal; //path to journal of changes made after last compaction
 
     DAVA::uint64 maxStorageSize = 0; //maximum cache size
     DAVA::uint32 maxItemsInMemory = 0; //count of items in memory, to use for fast access
@@ -97,6 +134,10 @@ private:
     CacheMap fullCache; //stored on disk, strong storage
 
     std::atomic<bool> dbStateChanged; //flag about changes in db
+
+    DAVA::ScopedPtr<DAVA::DynamicMemoryFile> pendingRecords; //journal records not written to disk yet
+    DAVA::uint64 journalRecordsCount = 0; //count of records in journal including pending ones
+    DAVA::uint64 indexID = 0; //ID of index, journal with other ID is ignored
 };
 
 inline const DAVA::FilePath& CacheDB::GetPath() const
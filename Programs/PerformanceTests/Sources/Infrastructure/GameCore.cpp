@@ -10,6 +10,7 @@
 #include "Tests/UniversalTest.h"
 #include "Tests/MaterialsTest.h"
 #include "Tests/LoadingTest.h"
+#include "Tests/JobSystemTest.h"
 
 #include <Version/Version.h>
 
@@ -133,6 +134,14 @@ void GameCore::RegisterTests()
 
         testChain.push_back(new LoadingTest(params));
     }
+
+    // job system test, doesn't require any map
+    {
+        BaseTest::TestParams params = defaultTestParams;
+        params.sceneName = "Workers";
+
+        testChain.push_back(new JobSystemTest(params));
+    }
 }
 
 void GameCore::LoadMaps(const String& testName, Vector<std::pair<String, String>>& mapsVector)
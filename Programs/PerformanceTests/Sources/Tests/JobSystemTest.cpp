@@ -0,0 +1,178 @@
+#include "JobSystemTest.h"
+
+#include <Job/JobManager.h>
+#include <Job/JobQueue.h>
+#include <Job/JobThread.h>
+#include <Concurrency/Semaphore.h>
+#include <Platform/DeviceInfo.h>
+#include <Time/SystemTimer.h>
+
+#include <atomic>
+
+namespace JobSystemTestDetails
+{
+static const uint32 DELAY_FRAMES = 20;
+static const uint32 JOBS_COUNTS[] = { 1000, 10000, 100000, 1000000 };
+
+// Capacity of legacy JobQueueWorker, queue can't hold more jobs at once
+static const uint32 LEGACY_QUEUE_SIZE = 1024;
+}
+
+const String JobSystemTest::TEST_NAME = "JobSystemTest";
+
+JobSystemTest::JobSystemTest(const TestParams& testParams)
+    : BaseTest(TEST_NAME, testParams)
+{
+}
+
+void JobSystemTest::LoadResources()
+{
+    ScopedPtr<Font> font(FTFont::Create("~res:/Fonts/korinna.ttf"));
+
+    infoText = new UIStaticText();
+    infoText->SetFont(font);
+    infoText->SetFontSize(18.f);
+    infoText->SetTextColor(Color(0.f, 1.f, 0.f, 1.f));
+    infoText->SetTextAlign(ALIGN_HCENTER | ALIGN_VCENTER);
+    infoText->SetRect(DAVA::GetEngineContext()->uiControlSystem->vcs->GetFullScreenVirtualRect());
+    infoText->SetText(UTF8Utils::EncodeToWideString("Running job system benchmark..."));
+    AddControl(infoText);
+
+    delayFrames = JobSystemTestDetails::DELAY_FRAMES;
+}
+
+void JobSystemTest::UnloadResources()
+{
+    SafeRelease(infoText);
+}
+
+void JobSystemTest::Update(float32 timeElapsed)
+{
+    BaseScreen::Update(timeElapsed);
+
+    if (executed)
+    {
+        return;
+    }
+
+    if (delayFrames > 0)
+    {
+        --delayFrames;
+        return;
+    }
+
+    for (uint32 jobsCount : JobSystemTestDetails::JOBS_COUNTS)
+    {
+        results.push_back({ "LegacyQueue", jobsCount, RunLegacyQueue(jobsCount) });
+        results.push_back({ "JobHandles", jobsCount, RunJobHandles(jobsCount) });
+        results.push_back({ "ParallelFor", jobsCount, RunParallelFor(jobsCount) });
+    }
+
+    executed = true;
+}
+
+uint64 JobSystemTest::RunLegacyQueue(uint32 jobsCount)
+{
+    // Reproduce previous JobManager worker setup: single shared queue and one thread per core
+    JobQueueWorker queue(JobSystemTestDetails::LEGACY_QUEUE_SIZE);
+    Semaphore doneSem;
+    Vector<JobThread*> threads;
+    for (uint32 i = 0; i < DeviceInfo::GetCpuCount(); ++i)
+    {
+        threads.push_back(new JobThread(&queue, &doneSem));
+    }
+
+    std::atomic<uint32> counter(0);
+    Function<void()> fn = [&counter]() { counter++; };
+
+    uint64 startTime = SystemTimer::GetUs();
+    for (uint32 pushed = 0; pushed < jobsCount;)
+    {
+        uint32 batchSize = std::min(jobsCount - pushed, JobSystemTestDetails::LEGACY_QUEUE_SIZE);
+        for (uint32 i = 0; i < batchSize; ++i)
+        {
+            queue.Push(fn);
+            queue.Signal();
+        }
+        pushed += batchSize;
+
+        while (!queue.IsEmpty())
+        {
+            queue.Broadcast();
+            Thread::Yield();
+        }
+    }
+    uint64 time = SystemTimer::GetUs() - startTime;
+
+    DVASSERT(counter == jobsCount);
+
+    for (JobThread* thread : threads)
+    {
+        SafeDelete(thread);
+    }
+
+    return time;
+}
+
+uint64 JobSystemTest::RunJobHandles(uint32 jobsCount)
+{
+    JobManager* jobManager = GetEngineContext()->jobManager;
+
+    std::atomic<uint32> counter(0);
+    Function<void()> fn = [&counter]() { counter++; };
+
+    Vector<JobHandle> jobs;
+    jobs.reserve(jobsCount);
+
+    uint64 startTime = SystemTimer::GetUs();
+    for (uint32 i = 0; i < jobsCount; ++i)
+    {
+        jobs.push_back(jobManager->CreateWorkerJob(fn));
+    }
+    for (const JobHandle& job : jobs)
+    {
+        jobManager->WaitWorkerJob(job);
+    }
+    uint64 time = SystemTimer::GetUs() - startTime;
+
+    DVASSERT(counter == jobsCount);
+    return time;
+}
+
+uint64 JobSystemTest::RunParallelFor(uint32 jobsCount)
+{
+    JobManager* jobManager = GetEngineContext()->jobManager;
+
+    std::atomic<uint32> counter(0);
+
+    uint64 startTime = SystemTimer::GetUs();
+    jobManager->ParallelFor(0, jobsCount, 1, [&counter](uint32 begin, uint32 end) { counter++; });
+    uint64 time = SystemTimer::GetUs() - startTime;
+
+    DVASSERT(counter == jobsCount);
+    return time;
+}
+
+void JobSystemTest::OnStart()
+{
+    Logger::Info(TeamcityPerformanceTestsOutput::FormatTestStarted(GetSceneName()).c_str());
+}
+
+void JobSystemTest::OnFinish()
+{
+    for (const Result& result : results)
+    {
+        float64 jobsPerMs = result.timeUs > 0 ? (result.jobsCount * 1000.0) / result.timeUs : 0.0;
+        String key = Format("%s_%u", result.name.c_str(), result.jobsCount);
+
+        Logger::Info(TeamcityPerformanceTestsOutput::FormatBuildStatistic(key + "_time_us", Format("%llu", result.timeUs)).c_str());
+        Logger::Info(TeamcityPerformanceTestsOutput::FormatBuildStatistic(key + "_jobs_per_ms", Format("%.1f", jobsPerMs)).c_str());
+    }
+
+    Logger::Info(TeamcityPerformanceTestsOutput::FormatTestFinished(GetSceneName()).c_str());
+}
+
+bool JobSystemTest::IsFinished() const
+{
+    return executed;
+}
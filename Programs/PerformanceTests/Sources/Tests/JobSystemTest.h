@@ -0,0 +1,48 @@
+#ifndef __JOB_SYSTEM_TEST_H__
+#define __JOB_SYSTEM_TEST_H__
+
+#include "BaseTest.h"
+
+class JobSystemTest : public BaseTest
+{
+public:
+    static const String TEST_NAME;
+
+    JobSystemTest(const TestParams& testParams);
+
+    void OnStart() override;
+    void OnFinish() override;
+
+    void Update(float32 timeElapsed) override;
+
+    bool IsFinished() const override;
+
+protected:
+    void LoadResources() override;
+    void UnloadResources() override;
+
+    void CreateUI() override{};
+    void UpdateUI() override{};
+
+    void PerformTestLogic(float32 timeElapsed) override{};
+
+private:
+    struct Result
+    {
+        String name;
+        uint32 jobsCount = 0;
+        uint64 timeUs = 0;
+    };
+
+    uint64 RunLegacyQueue(uint32 jobsCount);
+    uint64 RunJobHandles(uint32 jobsCount);
+    uint64 RunParallelFor(uint32 jobsCount);
+
+    Vector<Result> results;
+    uint32 delayFrames = 0;
+    bool executed = false;
+
+    UIStaticText* infoText = nullptr;
+};
+
+#endif
@@ -26,6 +26,7 @@
 #include <UI/Text/UITextComponent.h>
 #include <UI/Render/UIDebugRenderComponent.h>
 #include <UI/Render/UIClipContentComponent.h>
+#include <UI/Render/UIRenderCacheComponent.h>
 #include <UI/RichContent/UIRichContentComponent.h>
 #include <UI/RichContent/UIRichContentAliasesComponent.h>
 #include <UI/Spine/UISpineComponent.h>
@@ -102,6 +103,7 @@ void ModernPropertiesModule::PostInit()
     AddToGroup(Type::Instance<UITextComponent>());
     AddToGroup(Type::Instance<UIClipContentComponent>());
     AddToGroup(Type::Instance<UIDebugRenderComponent>());
+    AddToGroup(Type::Instance<UIRenderCacheComponent>());
     AddToGroup(Type::Instance<UIRichContentComponent>());
     AddToGroup(Type::Instance<UIRichContentAliasesComponent>());
     AddToGroup(Type::Instance<UISpineComponent>());
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <REPlatform/Global/CommandLineModule.h>
+
+#include <Animation/AnimationClipCompressor.h>
+#include <Base/BaseTypes.h>
+#include <FileSystem/FilePath.h>
+#include <Reflection/ReflectionRegistrator.h>
+
+class AnimationCompressorTool : public DAVA::CommandLineModule
+{
+public:
+    AnimationCompressorTool(const DAVA::Vector<DAVA::String>& commandLine);
+
+private:
+    bool PostInitInternal() override;
+    eFrameResult OnFrameInternal() override;
+    void ShowHelpInternal() override;
+
+    DAVA::FilePath sourceFile;
+    DAVA::FilePath compressedFile;
+    DAVA::AnimationClipCompressor::Settings settings;
+
+    DAVA_VIRTUAL_REFLECTION_IN_PLACE(AnimationCompressorTool, DAVA::CommandLineModule)
+    {
+        DAVA::ReflectionRegistrator<AnimationCompressorTool>::Begin()[DAVA::M::CommandName("-animationcompressor")]
+        .ConstructorByPointer<DAVA::Vector<DAVA::String>>()
+        .End();
+    }
+};
@@ -0,0 +1,116 @@
+#include "Classes/CommandLine/AnimationCompressorTool.h"
+
+#include <REPlatform/CommandLine/OptionName.h>
+
+#include <TArc/Utils/ModuleCollection.h>
+
+#include <Logger/Logger.h>
+
+#include <cstdlib>
+
+namespace AnimationCompressorToolDetails
+{
+const DAVA::String POSITION_TOLERANCE = "-positiontolerance";
+const DAVA::String ORIENTATION_TOLERANCE = "-orientationtolerance";
+const DAVA::String SCALE_TOLERANCE = "-scaletolerance";
+const DAVA::String KEYS_PER_BLOCK = "-keysperblock";
+
+bool ReadTolerance(const DAVA::ProgramOptions& options, const DAVA::String& optionName, DAVA::float32* tolerance)
+{
+    DAVA::String value = options.GetOption(optionName).AsString();
+    if (value.empty())
+        return true;
+
+    char* end = nullptr;
+    DAVA::float32 parsed = std::strtof(value.c_str(), &end);
+    if (end == value.c_str() || *end != '\0' || parsed < 0.f)
+    {
+        DAVA::Logger::Error("Wrong value '%s' of %s", value.c_str(), optionName.c_str());
+        return false;
+    }
+
+    *tolerance = parsed;
+    return true;
+}
+}
+
+AnimationCompressorTool::AnimationCompressorTool(const DAVA::Vector<DAVA::String>& commandLine)
+    : CommandLineModule(commandLine, "-animationcompressor")
+{
+    using namespace DAVA;
+    using namespace AnimationCompressorToolDetails;
+
+    options.AddOption(OptionName::File, VariantType(String("")), "Full pathname of source animation file");
+    options.AddOption(OptionName::OutFile, VariantType(String("")), "Full pathname of compressed animation file");
+    options.AddOption(POSITION_TOLERANCE, VariantType(String("")), "Max position error in units");
+    options.AddOption(ORIENTATION_TOLERANCE, VariantType(String("")), "Max orientation error in radians");
+    options.AddOption(SCALE_TOLERANCE, VariantType(String("")), "Max scale error");
+    options.AddOption(KEYS_PER_BLOCK, VariantType(settings.keysPerBlock), "Count of keys in seek block");
+}
+
+bool AnimationCompressorTool::PostInitInternal()
+{
+    using namespace DAVA;
+    using namespace AnimationCompressorToolDetails;
+
+    sourceFile = options.GetOption(OptionName::File).AsString();
+    if (sourceFile.IsEmpty())
+    {
+        Logger::Error("Source animation file was not selected");
+        return false;
+    }
+
+    compressedFile = options.GetOption(OptionName::OutFile).AsString();
+    if (compressedFile.IsEmpty())
+    {
+        compressedFile = sourceFile;
+    }
+
+    bool tolerancesRead = ReadTolerance(options, POSITION_TOLERANCE, &settings.positionTolerance);
+    tolerancesRead = ReadTolerance(options, ORIENTATION_TOLERANCE, &settings.orientationTolerance) && tolerancesRead;
+    tolerancesRead = ReadTolerance(options, SCALE_TOLERANCE, &settings.scaleTolerance) && tolerancesRead;
+    if (!tolerancesRead)
+    {
+        return false;
+    }
+
+    settings.keysPerBlock = options.GetOption(KEYS_PER_BLOCK).AsUInt32();
+    if (settings.keysPerBlock == 0)
+    {
+        Logger::Error("%s should be greater than zero", KEYS_PER_BLOCK.c_str());
+        return false;
+    }
+
+    return true;
+}
+
+DAVA::ConsoleModule::eFrameResult AnimationCompressorTool::OnFrameInternal()
+{
+    using namespace DAVA;
+
+    AnimationClipCompressor::Stats stats;
+    if (AnimationClipCompressor::Compress(sourceFile, compressedFile, settings, &stats))
+    {
+        Logger::Info("Animation %s compressed: data size %u -> %u bytes, keys %u -> %u",
+                     sourceFile.GetAbsolutePathname().c_str(), stats.sourceDataSize, stats.compressedDataSize,
+                     stats.sourceKeysCount, stats.compressedKeysCount);
+    }
+    else
+    {
+        Logger::Error("Failed to compress animation %s", sourceFile.GetAbsolutePathname().c_str());
+        result = Result::RESULT_ERROR;
+    }
+
+    return DAVA::ConsoleModule::eFrameResult::FINISHED;
+}
+
+void AnimationCompressorTool::ShowHelpInternal()
+{
+    CommandLineModule::ShowHelpInternal();
+
+    DAVA::Logger::Info("Examples:");
+    DAVA::Logger::Info("\t-animationcompressor -file /Users/SmokeTest/animations/run.anim -outfile /Users/SmokeTest/animations/run_compressed.anim");
+    DAVA::Logger::Info("\t-animationcompressor -file /Users/SmokeTest/animations/run.anim -positiontolerance 0.005 -orientationtolerance 0.002");
+}
+
+DECL_TARC_MODULE(AnimationCompressorTool);
@@ -27,6 +27,7 @@ StaticOcclusionTool::StaticOcclusionTool(const DAVA::Vector<DAVA::String>& comma
     options.AddOption(OptionName::Build, VariantType(false), "Enables build of static occlusion");
     options.AddOption(OptionName::ProcessFile, VariantType(String("")), "Full pathname to scene file *.sc2");
     options.AddOption(OptionName::QualityConfig, VariantType(String("")), "Full path for quality.yaml file");
+    options.AddOption(OptionName::Software, VariantType(false), "Build with CPU rasterizer instead of GPU occlusion queries");
 }
 
 bool StaticOcclusionTool::PostInitInternal()
@@ -61,6 +62,7 @@ bool StaticOcclusionTool::PostInitInternal()
     {
         scene.reset(new Scene());
         staticOcclusionBuildSystem = new StaticOcclusionBuildSystem(scene);
+        staticOcclusionBuildSystem->SetSoftwareRasterization(options.GetOption(OptionName::Software).AsBool());
         scene->AddSystem(staticOcclusionBuildSystem, ComponentUtils::MakeMask<StaticOcclusionComponent>() | ComponentUtils::MakeMask<TransformComponent>(), Scene::SCENE_SYSTEM_REQUIRE_PROCESS, scene->renderUpdateSystem);
 
         if (scene->LoadScene(scenePathname) != SceneFileV2::eError::ERROR_NO_ERROR)
@@ -140,6 +142,7 @@ void StaticOcclusionTool::ShowHelpInternal()
 
     DAVA::Logger::Info("Examples:");
     DAVA::Logger::Info("\t-staticocclusion -build -processfile /Users/Test/DataSource/3d/Maps/scene.sc2");
+    DAVA::Logger::Info("\t-staticocclusion -build -software -processfile /Users/Test/DataSource/3d/Maps/scene.sc2");
 }
 
 DECL_TARC_MODULE(StaticOcclusionTool);
@@ -1117,6 +1117,7 @@ void QtMainWindow::OnBuildStaticOcclusion()
 
     bool sceneWasChanged = true;
     DAVA::StaticOcclusionBuildSystem* soBuildSystem = scene->GetSystem<DAVA::StaticOcclusionBuildSystem>();
+    soBuildSystem->SetSoftwareRasterization(DAVA::Deprecated::GetDataNode<DAVA::GlobalSceneSettings>()->softwareStaticOcclusion);
     soBuildSystem->Build();
     while (soBuildSystem->IsInBuild())
     {
@@ -10,6 +10,7 @@
 #include <Logger/TeamcityOutput.h>
 #include <Debug/DVAssertDefaultHandlers.h>
 #include <Time/SystemTimer.h>
+#include <UI/UIPackageCompiler.h>
 #include <Utils/Utils.h>
 
 using namespace DAVA;
@@ -32,6 +33,7 @@ void PrintUsage()
     printf("\t-t - asset cache timeout\n");
     printf("\t-postifx - trailing part of texture name\n");
     printf("\t-output - output folder for .../Project/Data/Gfx/\n");
+    printf("\t-ui - folder with UI packages (*.yaml) to compile into binary *.uib next to them\n");
 
     printf("\n");
     printf("ResourcePacker [src_dir] - will pack resources from src_dir\n");
@@ -157,6 +159,21 @@ void ProcessRecourcePacker(Engine& e)
     Logger::FrameworkDebug("[Resource Packer Compile Time: %0.3lf seconds]", static_cast<float64>(elapsedTime) / 1000.0);
 }
 
+void ProcessUIPackages(const FilePath& uiDir)
+{
+    uint64 elapsedTime = SystemTimer::GetMs();
+
+    UIPackageCompiler compiler;
+    uint32 failedCount = compiler.CompileFolder(uiDir);
+    if (failedCount > 0)
+    {
+        Logger::Warning("[UI packages] %u packages weren't compiled, yaml will be loaded for them", failedCount);
+    }
+
+    elapsedTime = SystemTimer::GetMs() - elapsedTime;
+    Logger::FrameworkDebug("[UI Packages Compile Time: %0.3lf seconds]", static_cast<float64>(elapsedTime) / 1000.0);
+}
+
 void Process(Engine& e)
 {
     DVASSERT(e.IsConsoleMode() == true);
@@ -205,6 +222,13 @@ void Process(Engine& e)
     }
 
     ProcessRecourcePacker(e);
+
+    if (CommandLineParser::CommandIsFound(String("-ui")))
+    {
+        FilePath uiDir(CommandLineParser::GetCommandParam("-ui"));
+        uiDir.MakeDirectoryPathname();
+        ProcessUIPackages(uiDir);
+    }
 }
 
 int DAVAMain(Vector<String> cmdLine)
@@ -0,0 +1,244 @@
+#include <DocDirSetup/DocDirSetup.h>
+
+#include <Engine/Engine.h>
+#include <CommandLine/CommandLineParser.h>
+#include <Render/Renderer.h>
+#include <Render/RHI/rhi_ShaderSource.h>
+#include <Render/Material/FXCache.h>
+#include <Render/Material/NMaterial.h>
+#include <Render/Material/ShaderWarmup.h>
+#include <Render/Highlevel/RenderBatch.h>
+#include <Render/Highlevel/RenderObject.h>
+#include <Render/Highlevel/RenderPassNames.h>
+#include <Scene3D/Scene.h>
+#include <Scene3D/Components/ComponentHelpers.h>
+#include <Scene3D/Systems/QualitySettingsSystem.h>
+#include <UI/DefaultUIPackageBuilder.h>
+#include <UI/UIPackage.h>
+#include <UI/UIPackageLoader.h>
+#include <UI/UIControl.h>
+
+#include <Debug/DVAssertDefaultHandlers.h>
+#include <FileSystem/FileList.h>
+#include <Logger/Logger.h>
+#include <FileSystem/KeyedArchive.h>
+#include <Time/SystemTimer.h>
+#include <Base/BaseTypes.h>
+
+using namespace DAVA;
+
+void PrintUsage()
+{
+    printf("Usage:\n");
+
+    printf("\t-usage or --help to display this help\n");
+    printf("\t-folder - folder with *.sc2 scenes and *.yaml UI packages to collect materials from\n");
+    printf("\t-quality - path to quality.yaml, variants are built for every material quality\n");
+    printf("\t-api - gles2, metal, dx11 or dx9, api to generate shader code for\n");
+    printf("\t-out - folder for ShaderSource.bin and FXCache.bin, ~doc:/ by default\n");
+    printf("\t-measure - load caches from -out folder and measure startup and first frame costs for scenes from -folder\n");
+
+    printf("\nExample:\n");
+    printf("\t-folder /Users/TestData/Maps/ -quality /Users/TestData/quality.yaml -api metal -out /Users/TestData/Cache/\n");
+    printf("\t-folder /Users/TestData/Maps/ -measure -out /Users/TestData/Cache/\n");
+}
+
+void CollectFiles(const FilePath& folderPath, Vector<FilePath>& scenes, Vector<FilePath>& packages)
+{
+    ScopedPtr<FileList> fileList(new FileList(folderPath));
+    for (uint32 fi = 0; fi < fileList->GetCount(); ++fi)
+    {
+        const FilePath& pathname = fileList->GetPathname(fi);
+        if (fileList->IsDirectory(fi) && !fileList->IsNavigationDirectory(fi))
+        {
+            CollectFiles(pathname, scenes, packages);
+        }
+        else if (pathname.IsEqualToExtension(".sc2"))
+        {
+            scenes.push_back(pathname);
+        }
+        else if (pathname.IsEqualToExtension(".yaml"))
+        {
+            packages.push_back(pathname);
+        }
+    }
+}
+
+bool ParseApi(const String& apiName, rhi::Api& api)
+{
+    const std::pair<const char*, rhi::Api> apis[] =
+    {
+      { "gles2", rhi::RHI_GLES2 },
+      { "metal", rhi::RHI_METAL },
+      { "dx11", rhi::RHI_DX11 },
+      { "dx9", rhi::RHI_DX9 }
+    };
+
+    for (const auto& it : apis)
+    {
+        if (apiName == it.first)
+        {
+            api = it.second;
+            return true;
+        }
+    }
+    return false;
+}
+
+void WarmUp(const Vector<FilePath>& scenes, const Vector<FilePath>& packages, const FilePath& outFolder)
+{
+    ShaderWarmup warmup;
+    int64 startTime = SystemTimer::GetMs();
+
+    for (const FilePath& scenePath : scenes)
+    {
+        ScopedPtr<Scene> scene(new Scene());
+        if (scene->LoadScene(scenePath) == SceneFileV2::eError::ERROR_NO_ERROR)
+        {
+            warmup.AddEntity(scene);
+        }
+        else
+        {
+            Logger::Error("Cannot load scene %s", scenePath.GetAbsolutePathname().c_str());
+        }
+    }
+
+    for (const FilePath& packagePath : packages)
+    {
+        DefaultUIPackageBuilder builder;
+        if (UIPackageLoader().LoadPackage(packagePath, &builder) && builder.GetPackage() != nullptr)
+        {
+            for (const RefPtr<UIControl>& control : builder.GetPackage()->GetControls())
+                warmup.AddControl(control.Get());
+            for (const RefPtr<UIControl>& prototype : builder.GetPackage()->GetPrototypes())
+                warmup.AddControl(prototype.Get());
+        }
+    }
+
+    int64 collectTime = SystemTimer::GetMs();
+    ShaderWarmup::Stats stats = warmup.Build();
+    int64 buildTime = SystemTimer::GetMs();
+
+    rhi::ShaderSourceCache::Save((outFolder + "ShaderSource.bin").GetAbsolutePathname().c_str());
+    FXCache::Save(outFolder + "FXCache.bin");
+
+    Logger::Info("Collected %u fx variants from %u scenes and %u packages in %lld ms", stats.fxCount, static_cast<uint32>(scenes.size()), static_cast<uint32>(packages.size()), collectTime - startTime);
+    Logger::Info("Built %u shaders (%u failed) in %lld ms", stats.shaderCount, stats.failedShaderCount, buildTime - collectTime);
+}
+
+void Measure(const Vector<FilePath>& scenes, const FilePath& outFolder)
+{
+    int64 startTime = SystemTimer::GetMs();
+    rhi::ShaderSourceCache::Load((outFolder + "ShaderSource.bin").GetAbsolutePathname().c_str());
+    FXCache::Load(outFolder + "FXCache.bin");
+    Logger::Info("Startup: caches loaded in %lld ms", SystemTimer::GetMs() - startTime);
+
+    for (const FilePath& scenePath : scenes)
+    {
+        ScopedPtr<Scene> scene(new Scene());
+        if (scene->LoadScene(scenePath) != SceneFileV2::eError::ERROR_NO_ERROR)
+            continue;
+
+        //first frame builds render variants of every visible material
+        Vector<Entity*> entities;
+        scene->GetChildEntitiesWithCondition(entities, [](Entity* entity) { return GetRenderObject(entity) != nullptr; });
+
+        int64 frameStartTime = SystemTimer::GetMs();
+        for (Entity* entity : entities)
+        {
+            RenderObject* renderObject = GetRenderObject(entity);
+            for (uint32 i = 0; i < renderObject->GetRenderBatchCount(); ++i)
+            {
+                NMaterial* material = renderObject->GetRenderBatch(i)->GetMaterial();
+                if (material != nullptr)
+                    material->PreBuildMaterial(PASS_FORWARD);
+            }
+        }
+        Logger::Info("First frame: materials of %s built in %lld ms", scenePath.GetAbsolutePathname().c_str(), SystemTimer::GetMs() - frameStartTime);
+    }
+}
+
+void Process(Engine& e)
+{
+    const EngineContext* context = e.GetContext();
+
+    DocumentsDirectorySetup::SetApplicationDocDirectory(context->fileSystem, "ShaderWarmup");
+
+    context->logger->SetLogLevel(Logger::LEVEL_INFO);
+    DVASSERT(e.IsConsoleMode() == true);
+
+    FilePath folder = CommandLineParser::GetCommandParam(String("-folder"));
+    if (CommandLineParser::GetCommandsCount() < 2
+        || (CommandLineParser::CommandIsFound(String("-usage")))
+        || (CommandLineParser::CommandIsFound(String("-help")))
+        || folder.IsEmpty()
+        || !Renderer::IsInitialized()
+        )
+    {
+        PrintUsage();
+        return;
+    }
+
+    folder.MakeDirectoryPathname();
+    FilePath outFolder = CommandLineParser::GetCommandParam(String("-out"));
+    if (outFolder.IsEmpty())
+    {
+        outFolder = "~doc:/";
+    }
+    outFolder.MakeDirectoryPathname();
+    context->fileSystem->CreateDirectory(outFolder, true);
+
+    FilePath qualityPath = CommandLineParser::GetCommandParam(String("-quality"));
+    if (!qualityPath.IsEmpty())
+    {
+        QualitySettingsSystem::Instance()->Load(qualityPath);
+    }
+
+    String apiName = CommandLineParser::GetCommandParam(String("-api"));
+    if (!apiName.empty())
+    {
+        rhi::Api api = rhi::RHI_GLES2;
+        if (!ParseApi(apiName, api))
+        {
+            PrintUsage();
+            return;
+        }
+        rhi::ShaderSourceCache::SetTargetApi(api);
+    }
+
+    Vector<FilePath> scenes;
+    Vector<FilePath> packages;
+    CollectFiles(folder, scenes, packages);
+
+    if (CommandLineParser::CommandIsFound(String("-measure")))
+    {
+        Measure(scenes, outFolder);
+    }
+    else
+    {
+        WarmUp(scenes, packages, outFolder);
+    }
+}
+
+int DAVAMain(Vector<String> cmdline)
+{
+    Assert::AddHandler(Assert::DefaultLoggerHandler);
+    Assert::AddHandler(Assert::DefaultDebuggerBreakHandler);
+
+    //shaders are only parsed and generated, null renderer is enough for that
+    KeyedArchive* options = new KeyedArchive();
+    options->SetInt32("renderer", rhi::RHI_NULL_RENDERER);
+
+    Vector<String> modules = { "JobManager" };
+
+    Engine e;
+    e.Init(eEngineRunMode::CONSOLE_MODE, modules, options);
+
+    e.update.Connect([&e](float32)
+                     {
+                         Process(e);
+                         e.QuitAsync(0);
+                     });
+
+    return e.Run();
+}
@@ -6,16 +6,19 @@
 #include <Engine/Engine.h>
 #include <FileSystem/FileSystem.h>
 #include <FileSystem/LocalizationSystem.h>
+#include <Logger/Logger.h>
 #include <Render/2D/Systems/VirtualCoordinatesSystem.h>
 #include <Render/2D/TextBlock.h>
 #include <Scene3D/Systems/QualitySettingsSystem.h>
 #include <Sound/SoundSystem.h>
+#include <Time/SystemTimer.h>
 #include <UI/DefaultUIPackageBuilder.h>
 #include <UI/Flow/UIFlowStateSystem.h>
 #include <UI/Layouts/UILayoutSystem.h>
 #include <UI/Styles/UIStyleSheetSystem.h>
 #include <UI/UIControlBackground.h>
 #include <UI/UIControlSystem.h>
+#include <UI/UIPackageCompiler.h>
 #include <UI/UIPackageLoader.h>
 #include <UI/UIStaticText.h>
 #include <UI/UIYamlLoader.h>
@@ -63,6 +66,39 @@ DAVA::RefPtr<DAVA::UIControl> LoadControl(const DAVA::FilePath& yamlPath, const
 
     return RefPtr<UIControl>();
 }
+
+DAVA::int64 MeasurePackageLoading(const DAVA::FilePath& yamlPath, bool compiled)
+{
+    using namespace DAVA;
+
+    const uint32 iterationsCount = 10;
+
+    UIPackageLoader::SetCompiledPackagesEnabled(compiled);
+    int64 startTime = SystemTimer::GetUs();
+    for (uint32 i = 0; i < iterationsCount; ++i)
+    {
+        PreviewPackageBuilder packageBuilder;
+        UIPackageLoader().LoadPackage(yamlPath, &packageBuilder);
+    }
+    return (SystemTimer::GetUs() - startTime) / iterationsCount;
+}
+
+void CompareCompiledPackageLoading(const DAVA::FilePath& yamlPath)
+{
+    using namespace DAVA;
+
+    UIPackageCompiler compiler;
+    if (!compiler.CompilePackage(yamlPath))
+    {
+        Logger::Error("[UIViewer] %s can't be compiled", yamlPath.GetStringValue().c_str());
+        return;
+    }
+
+    int64 yamlTime = MeasurePackageLoading(yamlPath, false);
+    int64 compiledTime = MeasurePackageLoading(yamlPath, true);
+    Logger::Info("[UIViewer] %s loading time: yaml %lld us, compiled %lld us",
+                 yamlPath.GetStringValue().c_str(), yamlTime, compiledTime);
+}
 }
 
 UIViewScreen::UIViewScreen(DAVA::Window* window_, DAVA::ProgramOptions* options_)
@@ -185,6 +221,12 @@ void UIViewScreen::SetupUI()
     String testedControlName = options->GetOption("-testedCtrl").AsString();
     String testedControlPath = options->GetOption("-testedPath").AsString();
 
+    if (options->GetOption("-compiledPackages").AsBool())
+    {
+        UIViewScreenDetails::CompareCompiledPackageLoading(placeHolderYaml);
+        UIViewScreenDetails::CompareCompiledPackageLoading(testedYaml);
+    }
+
     RefPtr<UIControl> placeHolderRoot = UIViewScreenDetails::LoadControl(placeHolderYaml, placeHolderRootControl);
     if (placeHolderRoot)
     {
@@ -67,6 +67,7 @@ UIViewerApp::UIViewerApp(DAVA::Engine& engine_, const DAVA::Vector<DAVA::String>
     options.AddOption("-locale", VariantType(String("en")), "Language");
     options.AddOption("-isRtl", VariantType(true), "Use rtl or no");
     options.AddOption("-isFlow", VariantType(false), "Load target yaml as UI Flow config");
+    options.AddOption("-compiledPackages", VariantType(false), "Compile tested yamls, log yaml and compiled loading time and show compiled packages");
 
     optionsAreParsed = options.Parse(cmdLine);
 
@@ -0,0 +1,223 @@
+#include "DAVAEngine.h"
+#include "Animation/AnimationClip.h"
+#include "Animation/AnimationClipCompressor.h"
+#include "Utils/CRC32.h"
+#include "UnitTests/UnitTests.h"
+
+using namespace DAVA;
+
+namespace AnimationCompressionTestDetails
+{
+const FilePath RAW_CLIP_PATH = "~doc:/AnimationCompressionTest/raw.anim";
+const FilePath COMPRESSED_CLIP_PATH = "~doc:/AnimationCompressionTest/compressed.anim";
+
+const uint32 TRACKS_COUNT = 32;
+const uint32 KEYS_COUNT = 300;
+const float32 KEYS_FREQUENCY = 30.f;
+
+template <class T>
+void WriteToBuffer(Vector<uint8>& buffer, const T& value)
+{
+    const uint8* bytes = reinterpret_cast<const uint8*>(&value);
+    buffer.insert(buffer.end(), bytes, bytes + sizeof(T));
+}
+
+void WriteString(Vector<uint8>& buffer, const String& string)
+{
+    //null-terminated and aligned by 4
+    buffer.insert(buffer.end(), string.c_str(), string.c_str() + string.length() + 1);
+    buffer.resize((buffer.size() + 3) & ~size_t(3), 0);
+}
+
+void WriteChannelHeader(Vector<uint8>& buffer, AnimationTrack::eChannelTarget target, uint8 dimension, AnimationChannel::eInterpolation interpolation)
+{
+    WriteToBuffer(buffer, uint8(target));
+    WriteToBuffer(buffer, uint8(0));
+    WriteToBuffer(buffer, uint16(0)); //pad
+
+    WriteToBuffer(buffer, uint32(AnimationChannel::ANIMATION_CHANNEL_DATA_SIGNATURE));
+    WriteToBuffer(buffer, dimension);
+    WriteToBuffer(buffer, uint8(interpolation));
+    WriteToBuffer(buffer, uint16(AnimationChannel::COMPRESSION_NONE));
+    WriteToBuffer(buffer, KEYS_COUNT);
+}
+
+// Raw clip with densely sampled smooth motion, as exported from DCC tools
+void WriteRawClip(const FilePath& path)
+{
+    Vector<uint8> data;
+    WriteToBuffer(data, float32(KEYS_COUNT - 1) / KEYS_FREQUENCY);
+    WriteToBuffer(data, TRACKS_COUNT);
+
+    for (uint32 t = 0; t < TRACKS_COUNT; ++t)
+    {
+        String name = Format("joint%u", t);
+        WriteString(data, name); //uid
+        WriteString(data, name);
+
+        WriteToBuffer(data, uint32(AnimationTrack::ANIMATION_TRACK_DATA_SIGNATURE));
+        WriteToBuffer(data, uint32(3));
+
+        float32 phase = float32(t);
+
+        WriteChannelHeader(data, AnimationTrack::CHANNEL_TARGET_POSITION, 3, AnimationChannel::INTERPOLATION_LINEAR);
+        for (uint32 k = 0; k < KEYS_COUNT; ++k)
+        {
+            float32 time = float32(k) / KEYS_FREQUENCY;
+            WriteToBuffer(data, time);
+            WriteToBuffer(data, Vector3(std::sin(time + phase), 0.5f * time, (k < KEYS_COUNT / 2) ? 1.f : 2.f));
+        }
+
+        WriteChannelHeader(data, AnimationTrack::CHANNEL_TARGET_ORIENTATION, 4, AnimationChannel::INTERPOLATION_SPHERICAL_LINEAR);
+        for (uint32 k = 0; k < KEYS_COUNT; ++k)
+        {
+            float32 time = float32(k) / KEYS_FREQUENCY;
+            WriteToBuffer(data, time);
+            WriteToBuffer(data, Quaternion::MakeRotation(Vector3(0.f, 1.f, 0.f), 2.f * time + phase));
+        }
+
+        WriteChannelHeader(data, AnimationTrack::CHANNEL_TARGET_SCALE, 1, AnimationChannel::INTERPOLATION_LINEAR);
+        for (uint32 k = 0; k < KEYS_COUNT; ++k)
+        {
+            WriteToBuffer(data, float32(k) / KEYS_FREQUENCY);
+            WriteToBuffer(data, 1.f);
+        }
+    }
+
+    WriteToBuffer(data, uint32(0)); //markers
+
+    AnimationClip::FileHeader header;
+    header.signature = AnimationClip::ANIMATION_CLIP_FILE_SIGNATURE;
+    header.version = 1;
+    header.crc32 = CRC32::ForBuffer(data.data(), uint32(data.size()));
+    header.dataSize = uint32(data.size());
+
+    ScopedPtr<File> file(File::Create(path, File::CREATE | File::WRITE));
+    file->Write(&header);
+    file->Write(data.data(), uint32(data.size()));
+}
+
+float32 GetRotationAngle(const float32* value0, const float32* value1)
+{
+    Quaternion q0(value0);
+    Quaternion q1(value1);
+    q0.Normalize();
+    q1.Normalize();
+    if (q0.DotProduct(q1) < 0.f)
+        q1 = Quaternion(-q1.x, -q1.y, -q1.z, -q1.w);
+
+    //chord between unit quaternions is 2*sin(angle/4)
+    float32 chord = std::sqrt((q0.x - q1.x) * (q0.x - q1.x) + (q0.y - q1.y) * (q0.y - q1.y) + (q0.z - q1.z) * (q0.z - q1.z) + (q0.w - q1.w) * (q0.w - q1.w));
+    return 4.f * std::asin(Min(0.5f * chord, 1.f));
+}
+
+float32 EvaluateClip(const AnimationClip* clip, uint32 samplesCount)
+{
+    //sum of evaluated values keeps evaluation from being optimized out
+    float32 sum = 0.f;
+    float32 value[4];
+    for (uint32 s = 0; s < samplesCount; ++s)
+    {
+        float32 time = clip->GetDuration() * float32(s) / float32(samplesCount);
+        for (uint32 t = 0; t < clip->GetTrackCount(); ++t)
+        {
+            const AnimationTrack* track = clip->GetTrack(t);
+            for (uint32 c = 0; c < track->GetChannelsCount(); ++c)
+            {
+                track->Evaluate(time, c, value, 4);
+                sum += value[0];
+            }
+        }
+    }
+
+    return sum;
+}
+}
+
+DAVA_TESTCLASS (AnimationCompressionTest)
+{
+    AnimationCompressionTest()
+    {
+        FileSystem::Instance()->CreateDirectory(AnimationCompressionTestDetails::RAW_CLIP_PATH.GetDirectory(), true);
+    }
+
+    ~AnimationCompressionTest()
+    {
+        FileSystem::Instance()->DeleteDirectory(AnimationCompressionTestDetails::RAW_CLIP_PATH.GetDirectory(), true);
+    }
+
+    DAVA_TEST (CompressedClipMatchesRawClip)
+    {
+        using namespace AnimationCompressionTestDetails;
+
+        WriteRawClip(RAW_CLIP_PATH);
+
+        AnimationClipCompressor::Settings settings;
+        AnimationClipCompressor::Stats stats;
+        TEST_VERIFY(AnimationClipCompressor::Compress(RAW_CLIP_PATH, COMPRESSED_CLIP_PATH, settings, &stats));
+
+        ScopedPtr<AnimationClip> rawClip(AnimationClip::Load(RAW_CLIP_PATH));
+        ScopedPtr<AnimationClip> compressedClip(AnimationClip::Load(COMPRESSED_CLIP_PATH));
+        TEST_VERIFY(rawClip && compressedClip);
+        if (!rawClip || !compressedClip)
+            return;
+
+        TEST_VERIFY(compressedClip->GetTrackCount() == rawClip->GetTrackCount());
+        TEST_VERIFY(compressedClip->GetDataSize() == stats.compressedDataSize);
+        TEST_VERIFY(compressedClip->GetDataSize() < rawClip->GetDataSize() / 4);
+        TEST_VERIFY(stats.compressedKeysCount < stats.sourceKeysCount);
+
+        // between source keys compressed curve error doesn't exceed its error in keys
+        // for linear channels, small margin covers float arithmetics and slerp
+        const uint32 samplesCount = 1000;
+        for (uint32 t = 0; t < rawClip->GetTrackCount(); ++t)
+        {
+            const AnimationTrack* rawTrack = rawClip->GetTrack(t);
+            const AnimationTrack* compressedTrack = compressedClip->GetTrack(t);
+            TEST_VERIFY(strcmp(rawClip->GetTrackUID(t), compressedClip->GetTrackUID(t)) == 0);
+            TEST_VERIFY(compressedTrack->GetChannelsCount() == rawTrack->GetChannelsCount());
+
+            for (uint32 c = 0; c < rawTrack->GetChannelsCount(); ++c)
+            {
+                TEST_VERIFY(compressedTrack->GetChannel(c).GetCompression() == AnimationChannel::COMPRESSION_QUANTIZED);
+
+                for (uint32 s = 0; s <= samplesCount; ++s)
+                {
+                    float32 time = rawClip->GetDuration() * float32(s) / float32(samplesCount);
+
+                    float32 rawValue[4] = {};
+                    float32 compressedValue[4] = {};
+                    rawTrack->Evaluate(time, c, rawValue, 4);
+                    compressedTrack->Evaluate(time, c, compressedValue, 4);
+
+                    if (rawTrack->GetChannelTarget(c) == AnimationTrack::CHANNEL_TARGET_ORIENTATION)
+                    {
+                        TEST_VERIFY(GetRotationAngle(rawValue, compressedValue) < 2.f * settings.orientationTolerance);
+                    }
+                    else
+                    {
+                        float32 tolerance = (rawTrack->GetChannelTarget(c) == AnimationTrack::CHANNEL_TARGET_POSITION) ? settings.positionTolerance : settings.scaleTolerance;
+                        for (uint32 d = 0; d < rawTrack->GetChannelValueSize(c); ++d)
+                            TEST_VERIFY(std::abs(rawValue[d] - compressedValue[d]) < 2.f * tolerance);
+                    }
+                }
+            }
+        }
+
+        const uint32 benchmarkSamplesCount = 200;
+
+        int64 startTime = SystemTimer::GetUs();
+        float32 rawSum = EvaluateClip(rawClip, benchmarkSamplesCount);
+        int64 rawTime = SystemTimer::GetUs() - startTime;
+
+        startTime = SystemTimer::GetUs();
+        float32 compressedSum = EvaluateClip(compressedClip, benchmarkSamplesCount);
+        int64 compressedTime = SystemTimer::GetUs() - startTime;
+
+        Logger::Info("AnimationCompressionTest: data size %u -> %u bytes (%.1f%%), keys %u -> %u",
+                     stats.sourceDataSize, stats.compressedDataSize, 100.f * stats.compressedDataSize / stats.sourceDataSize,
+                     stats.sourceKeysCount, stats.compressedKeysCount);
+        Logger::Info("AnimationCompressionTest: %u evaluations, raw %lld us, compressed %lld us (checksum %f / %f)",
+                     benchmarkSamplesCount * rawClip->GetTrackCount() * 3, rawTime, compressedTime, rawSum, compressedSum);
+    }
+};
@@ -58,6 +58,51 @@ DAVA_TESTCLASS (ArchiveTest)
 #endif // __DAVAENGINE_IPHONE__
     }
 
+    DAVA_TEST (TestMemoryMappedDavaArchive)
+    {
+#if !defined(__DAVAENGINE_IPHONE__) && !defined(__DAVAENGINE_ANDROID__)
+        try
+        {
+            const FilePath archivePath("~res:/TestData/ArchiveTest/archive.dvpk");
+
+            RefPtr<File> fileDvpk(File::Create(archivePath, File::OPEN | File::READ));
+            PackArchive archive(fileDvpk, archivePath);
+
+            RefPtr<File> fileDvpkMapped(File::Create(archivePath, File::OPEN | File::READ));
+            PackArchive mappedArchive(fileDvpkMapped, archivePath, true);
+
+            for (const ResourceArchive::FileInfo& info : archive.GetFilesInfo())
+            {
+                Vector<uint8> fileFromArchive;
+                TEST_VERIFY(archive.LoadFile(info.relativeFilePath, fileFromArchive));
+
+                Vector<uint8> fileFromMappedArchive;
+                TEST_VERIFY(mappedArchive.LoadFile(info.relativeFilePath, fileFromMappedArchive));
+                TEST_VERIFY(fileFromArchive == fileFromMappedArchive);
+
+                ScopedPtr<File> file(mappedArchive.OpenFile(info.relativeFilePath, "~res:/" + info.relativeFilePath));
+                TEST_VERIFY(file);
+                if (file)
+                {
+                    TEST_VERIFY(file->GetSize() == fileFromArchive.size());
+
+                    Vector<uint8> fileFromView(fileFromArchive.size(), 0);
+                    TEST_VERIFY(file->Read(fileFromView.data(), static_cast<uint32>(fileFromView.size())) == fileFromView.size());
+                    TEST_VERIFY(fileFromView == fileFromArchive);
+
+                    uint8 byte = 0;
+                    TEST_VERIFY(file->Read(&byte, 1) == 0);
+                    TEST_VERIFY(file->IsEof());
+                }
+            }
+        }
+        catch (std::exception& ex)
+        {
+            Logger::Info(ex.what());
+        }
+#endif
+    }
+
     DAVA_TEST (TestZipArchive)
     {
         try
@@ -0,0 +1,308 @@
+#include <DAVAEngine.h>
+#include <UnitTests/UnitTests.h>
+
+#if defined(__DAVAENGINE_WIN32__) || defined(__DAVAENGINE_MACOS__)
+
+#include "CacheDB.h"
+#include "ServerCacheEntry.h"
+
+#include <AssetCache/CachedItemValue.h>
+#include <FileSystem/FileSystem.h>
+
+using namespace DAVA;
+
+namespace CacheDBTestDetails
+{
+const FilePath cacheFolder = "~doc:/TestData/CacheDBTest/";
+const uint64 STORAGE_SIZE = 1024 * 1024;
+const uint32 ITEMS_IN_MEMORY = 10;
+const uint32 ITEM_DATA_SIZE = 100;
+const uint64 JOURNAL_HEADER_SIZE = sizeof(uint32) + sizeof(uint32) + sizeof(uint64); // signature, version, index ID
+const uint64 INDEX_HEADER_SIZE = JOURNAL_HEADER_SIZE + sizeof(uint64); // signature, version, index ID, items count
+
+struct Owner : public CacheDBOwner
+{
+    void OnStorageSizeChanged(uint64 occupied, uint64 overall) override
+    {
+    }
+};
+
+AssetCache::CacheItemKey MakeKey(uint8 index)
+{
+    AssetCache::CacheItemKey key;
+    key.fill(index);
+    return key;
+}
+
+AssetCache::CachedItemValue MakeValue(uint8 index)
+{
+    AssetCache::CachedItemValue value;
+    value.Add("data.bin", std::make_shared<Vector<uint8>>(ITEM_DATA_SIZE, index));
+
+    AssetCache::CachedItemValue::Description description;
+    description.comment = Format("item %u", index);
+    value.SetDescription(description);
+    return value;
+}
+
+uint64 GetFileSize(const FilePath& path)
+{
+    uint64 size = 0;
+    FileSystem::Instance()->GetFileSize(path, size);
+    return size;
+}
+
+bool TruncateFile(const FilePath& path, uint64 size)
+{
+    Vector<uint8> content;
+    if (!FileSystem::Instance()->ReadFileContents(path, content) || content.size() < size)
+    {
+        return false;
+    }
+
+    content.resize(static_cast<size_t>(size));
+    ScopedPtr<File> file(File::Create(path, File::CREATE | File::WRITE));
+    return file && file->Write(content.data(), static_cast<uint32>(content.size())) == content.size();
+}
+}
+
+DAVA_TESTCLASS (CacheDBTest)
+{
+    CacheDBTestDetails::Owner owner;
+
+    CacheDBTest()
+    {
+        FileSystem::Instance()->DeleteDirectory(CacheDBTestDetails::cacheFolder, true);
+    }
+
+    ~CacheDBTest()
+    {
+        FileSystem::Instance()->DeleteDirectory(CacheDBTestDetails::cacheFolder, true);
+    }
+
+    void TearDown(const String& testName) override
+    {
+        FileSystem::Instance()->DeleteDirectory(CacheDBTestDetails::cacheFolder, true);
+    }
+
+    void OpenDB(CacheDB & db, uint64 storageSize = CacheDBTestDetails::STORAGE_SIZE)
+    {
+        db.UpdateSettings(CacheDBTestDetails::cacheFolder, storageSize, CacheDBTestDetails::ITEMS_IN_MEMORY, 0);
+    }
+
+    // CacheDB::Save, CacheDB::Load
+    DAVA_TEST (IndexAndJournalRoundTrip)
+    {
+        using namespace CacheDBTestDetails;
+
+        const FilePath journalPath = cacheFolder + "cache.journal";
+        {
+            CacheDB db(owner);
+            OpenDB(db);
+            TEST_VERIFY(GetFileSize(journalPath) == JOURNAL_HEADER_SIZE);
+
+            for (uint8 i = 1; i <= 4; ++i)
+            {
+                db.Insert(MakeKey(i), MakeValue(i));
+            }
+            TEST_VERIFY(db.Remove(MakeKey(4)));
+
+            // item 1 becomes the most recently used one
+            db.UpdateAccessTimestamp(MakeKey(1));
+            db.Save();
+            TEST_VERIFY(GetFileSize(journalPath) > JOURNAL_HEADER_SIZE);
+        }
+
+        CacheDB db(owner);
+        OpenDB(db);
+        TEST_VERIFY(db.GetOccupiedSize() == 3 * ITEM_DATA_SIZE);
+        TEST_VERIFY(db.Get(MakeKey(4)) == nullptr);
+        for (uint8 i = 1; i <= 3; ++i)
+        {
+            ServerCacheEntry* entry = db.Get(MakeKey(i));
+            TEST_VERIFY(entry != nullptr);
+            if (entry != nullptr)
+            {
+                TEST_VERIFY(entry->GetValue().IsFetched());
+                TEST_VERIFY(entry->GetValue().GetSize() == ITEM_DATA_SIZE);
+                TEST_VERIFY(entry->GetValue().GetDescription().comment == MakeValue(i).GetDescription().comment);
+            }
+        }
+    }
+
+    // CacheDB::Load
+    DAVA_TEST (JournalTimestampsAreRestored)
+    {
+        using namespace CacheDBTestDetails;
+        {
+            CacheDB db(owner);
+            OpenDB(db);
+            for (uint8 i = 1; i <= 3; ++i)
+            {
+                db.Insert(MakeKey(i), MakeValue(i));
+            }
+            db.UpdateAccessTimestamp(MakeKey(1));
+        }
+
+        // storage is reduced by removing of least recently used item, it is item 2 after touch of item 1
+        CacheDB db(owner);
+        OpenDB(db, 2 * ITEM_DATA_SIZE);
+        TEST_VERIFY(db.GetOccupiedSize() == 2 * ITEM_DATA_SIZE);
+        TEST_VERIFY(db.Get(MakeKey(1)) != nullptr);
+        TEST_VERIFY(db.Get(MakeKey(2)) == nullptr);
+        TEST_VERIFY(db.Get(MakeKey(3)) != nullptr);
+    }
+
+    // CacheDB::Compact
+    DAVA_TEST (CompactionMovesJournalIntoIndex)
+    {
+        using namespace CacheDBTestDetails;
+
+        const FilePath indexPath = cacheFolder + "cache.dat";
+        const FilePath journalPath = cacheFolder + "cache.journal";
+        {
+            CacheDB db(owner);
+            OpenDB(db);
+            uint64 emptyIndexSize = GetFileSize(indexPath);
+
+            for (uint8 i = 1; i <= 5; ++i)
+            {
+                db.Insert(MakeKey(i), MakeValue(i));
+            }
+            TEST_VERIFY(db.Remove(MakeKey(5)));
+            db.Save();
+            TEST_VERIFY(GetFileSize(indexPath) == emptyIndexSize);
+            TEST_VERIFY(GetFileSize(journalPath) > JOURNAL_HEADER_SIZE);
+
+            db.Compact();
+            TEST_VERIFY(GetFileSize(indexPath) > emptyIndexSize);
+            TEST_VERIFY(GetFileSize(journalPath) == JOURNAL_HEADER_SIZE);
+            TEST_VERIFY(!FileSystem::Instance()->IsFile(cacheFolder + "cache.dat.tmp"));
+        }
+
+        CacheDB db(owner);
+        OpenDB(db);
+        TEST_VERIFY(db.GetOccupiedSize() == 4 * ITEM_DATA_SIZE);
+        for (uint8 i = 1; i <= 4; ++i)
+        {
+            TEST_VERIFY(db.Get(MakeKey(i)) != nullptr);
+        }
+        TEST_VERIFY(db.Get(MakeKey(5)) == nullptr);
+    }
+
+    // CacheDB::Load
+    DAVA_TEST (TruncatedJournalRecordIsDropped)
+    {
+        using namespace CacheDBTestDetails;
+
+        const FilePath journalPath = cacheFolder + "cache.journal";
+        {
+            CacheDB db(owner);
+            OpenDB(db);
+            db.Insert(MakeKey(1), MakeValue(1));
+            db.Insert(MakeKey(2), MakeValue(2));
+            db.Save();
+
+            db.Insert(MakeKey(3), MakeValue(3));
+        }
+
+        // server was stopped while last record was being written
+        Vector<uint8> journal;
+        TEST_VERIFY(FileSystem::Instance()->ReadFileContents(journalPath, journal));
+        TEST_VERIFY(journal.size() > JOURNAL_HEADER_SIZE + 3);
+        journal.resize(journal.size() - 3);
+        {
+            ScopedPtr<File> file(File::Create(journalPath, File::CREATE | File::WRITE));
+            TEST_VERIFY(file && file->Write(journal.data(), static_cast<uint32>(journal.size())) == journal.size());
+        }
+
+        CacheDB db(owner);
+        OpenDB(db);
+        TEST_VERIFY(db.GetOccupiedSize() == 2 * ITEM_DATA_SIZE);
+        TEST_VERIFY(db.Get(MakeKey(1)) != nullptr);
+        TEST_VERIFY(db.Get(MakeKey(2)) != nullptr);
+        TEST_VERIFY(db.Get(MakeKey(3)) == nullptr);
+
+        // damaged journal is compacted into index on load
+        TEST_VERIFY(GetFileSize(journalPath) == JOURNAL_HEADER_SIZE);
+    }
+
+    // CacheDB::Load
+    DAVA_TEST (TruncatedIndexIsRestored)
+    {
+        using namespace CacheDBTestDetails;
+
+        const FilePath indexPath = cacheFolder + "cache.dat";
+        {
+            CacheDB db(owner);
+            OpenDB(db);
+            for (uint8 i = 1; i <= 3; ++i)
+            {
+                db.Insert(MakeKey(i), MakeValue(i));
+            }
+            db.Compact();
+
+            db.Insert(MakeKey(4), MakeValue(4));
+        }
+
+        // description of last item in index is damaged
+        TEST_VERIFY(TruncateFile(indexPath, GetFileSize(indexPath) - 3));
+
+        // items are taken from undamaged part of index, from journal and from data folders
+        {
+            CacheDB db(owner);
+            OpenDB(db);
+            TEST_VERIFY(db.GetOccupiedSize() == 4 * ITEM_DATA_SIZE);
+            for (uint8 i = 1; i <= 4; ++i)
+            {
+                ServerCacheEntry* entry = db.Get(MakeKey(i));
+                TEST_VERIFY(entry != nullptr);
+                if (entry != nullptr)
+                {
+                    TEST_VERIFY(entry->GetValue().GetSize() == ITEM_DATA_SIZE);
+                }
+            }
+        }
+
+        // index is compacted from restored items
+        CacheDB db(owner);
+        OpenDB(db);
+        TEST_VERIFY(db.GetOccupiedSize() == 4 * ITEM_DATA_SIZE);
+    }
+
+    // CacheDB::Load
+    DAVA_TEST (DamagedIndexHeaderIsRestoredFromDataFolders)
+    {
+        using namespace CacheDBTestDetails;
+
+        const FilePath indexPath = cacheFolder + "cache.dat";
+        {
+            CacheDB db(owner);
+            OpenDB(db);
+            for (uint8 i = 1; i <= 3; ++i)
+            {
+                db.Insert(MakeKey(i), MakeValue(i));
+            }
+            db.Compact();
+        }
+
+        // only signature is left, so neither items nor ID of index can be read
+        TEST_VERIFY(TruncateFile(indexPath, INDEX_HEADER_SIZE - sizeof(uint64) - 1));
+
+        CacheDB db(owner);
+        OpenDB(db);
+        TEST_VERIFY(db.GetOccupiedSize() == 3 * ITEM_DATA_SIZE);
+        for (uint8 i = 1; i <= 3; ++i)
+        {
+            ServerCacheEntry* entry = db.Get(MakeKey(i));
+            TEST_VERIFY(entry != nullptr);
+            if (entry != nullptr)
+            {
+                TEST_VERIFY(entry->GetValue().IsFetched());
+                TEST_VERIFY(entry->GetValue().GetSize() == ITEM_DATA_SIZE);
+            }
+        }
+    }
+};
+
+#endif
@@ -26,6 +26,14 @@ DAVA_TESTCLASS (CompressorTest)
             TEST_VERIFY(lz4.Decompress(compressedLz4, uncompressedLz4));
 
             TEST_VERIFY(uncompressedLz4 == in);
+
+            Vector<uint8> uncompressedFromBuffer(inSize, '\0');
+            TEST_VERIFY(lz4.Decompress(compressedLz4.data(), static_cast<uint32>(compressedLz4.size()), uncompressedFromBuffer));
+            TEST_VERIFY(uncompressedFromBuffer == in);
+
+            // data decoded into less bytes than expected is an error
+            Vector<uint8> biggerOut(inSize + 100, '\0');
+            TEST_VERIFY(!lz4.Decompress(compressedLz4.data(), static_cast<uint32>(compressedLz4.size()), biggerOut));
         }
 
         {
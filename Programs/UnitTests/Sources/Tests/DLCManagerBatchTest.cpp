@@ -0,0 +1,171 @@
+#include <DLCManager/DLCManager.h>
+#include <FileSystem/FileSystem.h>
+#include <Logger/Logger.h>
+#include <Engine/Engine.h>
+#include <EmbeddedWebServer/EmbeddedWebServer.h>
+#include <Time/SystemTimer.h>
+#include <Utils/CRC32.h>
+
+#include "UnitTests/UnitTests.h"
+
+#ifndef __DAVAENGINE_WIN_UAP__
+
+namespace DLCManagerBatchTestDetails
+{
+const DAVA::String superPackUrl("http://127.0.0.1:8484/superpack_for_unittests.dvpk");
+const DAVA::String wwwDirStr("~doc:/UnitTests/DLCManagerBatchTest/local_www/");
+const DAVA::String dlcDirTemplate("~doc:/UnitTests/DLCManagerBatchTest/dlc_dir_");
+const DAVA::String packName("8"); // depends on all other packs in superpack_for_unittests.dvpk
+const DAVA::uint32 batchMaxSize[] = { 0, 4 * 1024 * 1024 }; // per file requests, then range batches
+const DAVA::uint32 runsCount = static_cast<DAVA::uint32>(sizeof(batchMaxSize) / sizeof(batchMaxSize[0]));
+}
+
+DAVA_TESTCLASS (DLCManagerBatchTest)
+{
+    DAVA::DLCManager* dlcManager = nullptr;
+    DAVA::uint32 runIndex = 0;
+    DAVA::int64 runStartTime = 0;
+    DAVA::int64 runTimeMs[DLCManagerBatchTestDetails::runsCount] = {};
+    DAVA::Map<DAVA::String, DAVA::uint32> runFilesHashes[DLCManagerBatchTestDetails::runsCount]; // .dvpl path relative to dlc dir -> file crc32
+    DAVA::float32 timeLeftToDownloadPack = 60.f; // seconds
+    bool finished = false;
+
+    bool TestComplete(const DAVA::String& testName) const override
+    {
+        if (testName == "TestBatchedDownloadMatchesPerFileDownload")
+        {
+            return finished;
+        }
+        return true;
+    }
+
+    void StartRun()
+    {
+        using namespace DAVA;
+        using namespace DLCManagerBatchTestDetails;
+
+        FilePath dlcDir(dlcDirTemplate + std::to_string(runIndex) + "/");
+        GetEngineContext()->fileSystem->DeleteDirectory(dlcDir);
+
+        DLCManager::Hints hints;
+        hints.downloadBatchMaxSize = batchMaxSize[runIndex];
+
+        dlcManager = DLCManager::Create();
+        dlcManager->Initialize(dlcDir, superPackUrl, hints);
+        dlcManager->SetRequestingEnabled(true);
+        TEST_VERIFY(dlcManager->RequestPack(packName) != nullptr);
+
+        runStartTime = SystemTimer::GetMs();
+    }
+
+    void FinishRun()
+    {
+        using namespace DAVA;
+        using namespace DLCManagerBatchTestDetails;
+
+        runTimeMs[runIndex] = SystemTimer::GetMs() - runStartTime;
+
+        DLCManager::Destroy(dlcManager);
+        dlcManager = nullptr;
+
+        FilePath dlcDir(dlcDirTemplate + std::to_string(runIndex) + "/");
+        Vector<FilePath> files = GetEngineContext()->fileSystem->EnumerateFilesInDirectory(dlcDir);
+        Map<String, uint32>& filesHashes = runFilesHashes[runIndex];
+        filesHashes.clear();
+        for (const FilePath& path : files)
+        {
+            if (path.GetExtension() == ".dvpl")
+            {
+                filesHashes[path.GetRelativePathname(dlcDir)] = CRC32::ForFile(path);
+            }
+        }
+
+        ++runIndex;
+    }
+
+    void Update(DAVA::float32 timeElapsed, const DAVA::String& testName) override
+    {
+        using namespace DAVA;
+        using namespace DLCManagerBatchTestDetails;
+
+        if (testName != "TestBatchedDownloadMatchesPerFileDownload" || finished)
+        {
+            return;
+        }
+
+        if (dlcManager == nullptr)
+        {
+            StartRun();
+            return;
+        }
+
+        const DLCManager::IRequest* request = dlcManager->IsInitialized() ? dlcManager->RequestPack(packName) : nullptr;
+        if (request != nullptr && request->IsDownloaded())
+        {
+            FinishRun();
+            if (runIndex == runsCount)
+            {
+                Logger::Info("DLCManagerBatchTest: per file requests %lld ms, batched requests %lld ms", runTimeMs[0], runTimeMs[1]);
+                // batched download should produce the same files with the same content
+                TEST_VERIFY(!runFilesHashes[0].empty());
+                TEST_VERIFY(runFilesHashes[0] == runFilesHashes[1]);
+                finished = true;
+            }
+            return;
+        }
+
+        timeLeftToDownloadPack -= SystemTimer::GetRealFrameDelta();
+        if (timeLeftToDownloadPack < 0.f)
+        {
+            Logger::Error("DLCManagerBatchTest: can't download pack %s with batch size %u", packName.c_str(), batchMaxSize[runIndex]);
+            TEST_VERIFY(false);
+            DLCManager::Destroy(dlcManager);
+            dlcManager = nullptr;
+            finished = true;
+        }
+    }
+
+    DAVA_TEST (TestBatchedDownloadMatchesPerFileDownload)
+    {
+        using namespace DAVA;
+        using namespace DLCManagerBatchTestDetails;
+
+        FileSystem* fs = GetEngineContext()->fileSystem;
+        FilePath wwwDir(wwwDirStr);
+        fs->DeleteDirectory(wwwDir);
+        fs->CreateDirectory(wwwDir, true);
+
+        const FilePath srcPath = "~res:/TestData/DLCManagerFullTest/superpack_for_unittests.dvpk";
+        if (!fs->CopyFile(srcPath, wwwDir + "superpack_for_unittests.dvpk", true))
+        {
+            Logger::Error("can't copy super pack for unittest from res:/");
+            TEST_VERIFY(false);
+            finished = true;
+            return;
+        }
+
+        if (!StartEmbeddedWebServer(wwwDir.GetAbsolutePathname().c_str(), "8484"))
+        {
+            Logger::Error("can't start embedded web server");
+            TEST_VERIFY(false);
+            finished = true;
+        }
+    }
+
+    DAVA_TEST (TestBatchedDownload_StopServer)
+    {
+        using namespace DAVA;
+        using namespace DLCManagerBatchTestDetails;
+
+        StopEmbeddedWebServer();
+
+        FileSystem* fs = GetEngineContext()->fileSystem;
+        fs->DeleteDirectory(FilePath(wwwDirStr));
+        for (uint32 i = 0; i < runsCount; ++i)
+        {
+            fs->DeleteDirectory(FilePath(dlcDirTemplate + std::to_string(i) + "/"));
+        }
+    }
+};
+
+#endif // !__DAVAENGINE_WIN_UAP__
@@ -0,0 +1,157 @@
+#include "DAVAEngine.h"
+#include "UnitTests/UnitTests.h"
+#include "Math/RectPacker.h"
+#include "Render/2D/FTGlyphAtlas.h"
+
+using namespace DAVA;
+
+DAVA_TESTCLASS (FTGlyphAtlasTest)
+{
+    FTFont* font = nullptr;
+
+    FTGlyphAtlasTest()
+    {
+        font = FTFont::Create("~res:/Fonts/DejaVuSans.ttf");
+        DVASSERT(font);
+    }
+
+    ~FTGlyphAtlasTest()
+    {
+        SafeRelease(font);
+    }
+
+    DAVA_TEST (TestGlyphsAreRasterizedOnce)
+    {
+        FTGlyphAtlas* atlas = GetEngineContext()->fontManager->GetGlyphAtlas();
+        const WideString text = L"Hello, glyph atlas";
+
+        Vector<FTGlyphAtlas::GlyphQuad> quads;
+        font->DrawStringToGlyphs(20.f, quads, 1024, 128, 0, 0, 0, 0, text, true);
+        uint32 glyphsCount = atlas->GetGlyphsCount();
+        TEST_VERIFY(!quads.empty());
+        TEST_VERIFY(glyphsCount > 0);
+
+        // same string again reuses glyphs, quads are appended
+        size_t quadsCount = quads.size();
+        font->DrawStringToGlyphs(20.f, quads, 1024, 128, 0, 0, 0, 0, text, true);
+        TEST_VERIFY(quads.size() == quadsCount * 2);
+        TEST_VERIFY(atlas->GetGlyphsCount() == glyphsCount);
+        for (size_t i = 0; i < quadsCount; ++i)
+        {
+            TEST_VERIFY(quads[i].page == quads[i + quadsCount].page);
+            TEST_VERIFY(quads[i].pageRect == quads[i + quadsCount].pageRect);
+            TEST_VERIFY(quads[i].rect == quads[i + quadsCount].rect);
+        }
+
+        // 'l' is rasterized once for all its occurrences
+        Vector<FTGlyphAtlas::GlyphQuad> lQuads;
+        font->DrawStringToGlyphs(20.f, lQuads, 1024, 128, 0, 0, 0, 0, L"lll", true);
+        TEST_VERIFY(lQuads.size() == 3);
+        if (lQuads.size() == 3)
+        {
+            TEST_VERIFY(lQuads[0].pageRect == lQuads[1].pageRect);
+            TEST_VERIFY(lQuads[1].pageRect == lQuads[2].pageRect);
+            TEST_VERIFY(lQuads[0].rect.x < lQuads[1].rect.x);
+        }
+
+        // other size is other glyphs
+        glyphsCount = atlas->GetGlyphsCount();
+        quads.clear();
+        font->DrawStringToGlyphs(30.f, quads, 1024, 128, 0, 0, 0, 0, L"l", true);
+        TEST_VERIFY(atlas->GetGlyphsCount() == glyphsCount + 1);
+    }
+
+    DAVA_TEST (TestAtlasIsClearedWhenFull)
+    {
+        FTGlyphAtlas atlas;
+
+        const int32 glyphSize = 255;
+        Vector<uint8> pixels(glyphSize * glyphSize, 255);
+
+        FTGlyphAtlas::GlyphKey firstKey;
+        firstKey.fontId = 1;
+        firstKey.size = 64;
+        firstKey.glyphIndex = 1;
+
+        FTGlyphAtlas::Glyph glyph;
+        TEST_VERIFY(atlas.AddGlyph(firstKey, 0, glyphSize, glyphSize, glyphSize, pixels.data(), glyphSize, glyph));
+        TEST_VERIFY(atlas.FindGlyph(firstKey, glyph));
+
+        uint32 generation = atlas.GetGeneration();
+        uint32 added = 1;
+        FTGlyphAtlas::GlyphKey key = firstKey;
+        while (atlas.GetGeneration() == generation && added < 1000)
+        {
+            ++key.glyphIndex;
+            TEST_VERIFY(atlas.AddGlyph(key, 0, glyphSize, glyphSize, glyphSize, pixels.data(), glyphSize, glyph));
+            ++added;
+        }
+
+        // glyphs with padding fill 4 pages of 4x4 glyphs
+        const uint32 glyphsPerPage = (FTGlyphAtlas::PAGE_SIZE / (glyphSize + FTGlyphAtlas::GLYPH_PADDING)) * (FTGlyphAtlas::PAGE_SIZE / (glyphSize + FTGlyphAtlas::GLYPH_PADDING));
+        TEST_VERIFY(added == glyphsPerPage * FTGlyphAtlas::MAX_PAGES + 1);
+        TEST_VERIFY(atlas.GetPagesCount() == 1);
+        TEST_VERIFY(atlas.GetGlyphsCount() == 1);
+        TEST_VERIFY(!atlas.FindGlyph(firstKey, glyph));
+        TEST_VERIFY(atlas.FindGlyph(key, glyph));
+
+        // atlas is cleared once per frame, glyphs are skipped when it is full again in the same frame
+        generation = atlas.GetGeneration();
+        for (uint32 i = 1; i < glyphsPerPage * FTGlyphAtlas::MAX_PAGES; ++i)
+        {
+            ++key.glyphIndex;
+            TEST_VERIFY(atlas.AddGlyph(key, 0, glyphSize, glyphSize, glyphSize, pixels.data(), glyphSize, glyph));
+        }
+        ++key.glyphIndex;
+        TEST_VERIFY(!atlas.AddGlyph(key, 0, glyphSize, glyphSize, glyphSize, pixels.data(), glyphSize, glyph));
+        TEST_VERIFY(atlas.GetGeneration() == generation);
+        TEST_VERIFY(atlas.GetGlyphsCount() == glyphsPerPage * FTGlyphAtlas::MAX_PAGES);
+
+        // next frame can clear atlas again
+        atlas.Upload();
+        TEST_VERIFY(atlas.AddGlyph(key, 0, glyphSize, glyphSize, glyphSize, pixels.data(), glyphSize, glyph));
+        TEST_VERIFY(atlas.GetGeneration() != generation);
+        TEST_VERIFY(atlas.GetGlyphsCount() == 1);
+        generation = atlas.GetGeneration();
+
+        // glyph bigger than page can't be added
+        Vector<uint8> hugePixels((FTGlyphAtlas::PAGE_SIZE + 1) * 2, 255);
+        ++key.glyphIndex;
+        TEST_VERIFY(!atlas.AddGlyph(key, 0, 2, FTGlyphAtlas::PAGE_SIZE + 1, 2, hugePixels.data(), FTGlyphAtlas::PAGE_SIZE + 1, glyph));
+
+        atlas.Clear();
+        TEST_VERIFY(atlas.GetGlyphsCount() == 0);
+        TEST_VERIFY(atlas.GetPagesCount() == 0);
+        TEST_VERIFY(atlas.GetGeneration() != generation);
+    }
+
+    DAVA_TEST (TestPackedRectsDontOverlap)
+    {
+        RectPacker packer(Rect2i(0, 0, 256, 256));
+
+        Vector<Rect2i> rects;
+        Rect2i packedRect;
+        for (int32 i = 0; i < 64; ++i)
+        {
+            Size2i size(8 + (i * 7) % 24, 8 + (i * 13) % 24);
+            if (packer.AddRect(size, packedRect))
+            {
+                TEST_VERIFY(packedRect.dx == size.dx && packedRect.dy == size.dy);
+                TEST_VERIFY(packedRect.x >= 0 && packedRect.y >= 0 && packedRect.x + packedRect.dx <= 256 && packedRect.y + packedRect.dy <= 256);
+                rects.push_back(packedRect);
+            }
+        }
+
+        TEST_VERIFY(!rects.empty());
+        for (size_t i = 0; i < rects.size(); ++i)
+        {
+            for (size_t j = i + 1; j < rects.size(); ++j)
+            {
+                const Rect2i& a = rects[i];
+                const Rect2i& b = rects[j];
+                bool overlap = a.x < b.x + b.dx && b.x < a.x + a.dx && a.y < b.y + b.dy && b.y < a.y + a.dy;
+                TEST_VERIFY(!overlap);
+            }
+        }
+    }
+};
@@ -0,0 +1,237 @@
+#include "DAVAEngine.h"
+#include "FileSystem/DynamicMemoryFile.h"
+#include "FileSystem/FlatKeyedArchive.h"
+#include "Scene3D/Components/CustomPropertiesComponent.h"
+#include "Scene3D/Components/TransformComponent.h"
+#include "UnitTests/UnitTests.h"
+
+using namespace DAVA;
+
+DAVA_TESTCLASS (FlatKeyedArchiveTest)
+{
+    RefPtr<KeyedArchive> CreateTestArchive()
+    {
+        RefPtr<KeyedArchive> nested(new KeyedArchive());
+        nested->SetInt32("nestedInt", 42);
+        nested->SetString("nestedString", "nested");
+
+        RefPtr<KeyedArchive> archive(new KeyedArchive());
+        archive->SetBool("bool", true);
+        archive->SetInt32("int32", -17);
+        archive->SetUInt32("uint32", 17);
+        archive->SetInt64("int64", -(int64(1) << 40));
+        archive->SetUInt64("uint64", uint64(1) << 40);
+        archive->SetFloat("float", 3.5f);
+        archive->SetFloat64("float64", 2.25);
+        archive->SetString("string", "value");
+        archive->SetWideString("wideString", L"wide value");
+        archive->SetFastName("fastName", FastName("name"));
+        archive->SetVector3("vector3", Vector3(1.0f, 2.0f, 3.0f));
+        archive->SetMatrix4("matrix4", Matrix4::MakeScale(Vector3(2.0f, 2.0f, 2.0f)));
+        archive->SetColor("color", Color(0.1f, 0.2f, 0.3f, 0.4f));
+
+        const uint8 bytes[] = { 1, 2, 3, 4, 5 };
+        archive->SetByteArray("byteArray", bytes, 5);
+        archive->SetArchive("archive", nested.Get());
+        return archive;
+    }
+
+    void VerifyArchive(const FlatKeyedArchive* archive)
+    {
+        TEST_VERIFY(archive->Count() == 15);
+        TEST_VERIFY(archive->GetBool(FastName("bool")) == true);
+        TEST_VERIFY(archive->GetInt32(FastName("int32")) == -17);
+        TEST_VERIFY(archive->GetUInt32(FastName("uint32")) == 17);
+        TEST_VERIFY(archive->GetInt64(FastName("int64")) == -(int64(1) << 40));
+        TEST_VERIFY(archive->GetUInt64(FastName("uint64")) == uint64(1) << 40);
+        TEST_VERIFY(archive->GetFloat(FastName("float")) == 3.5f);
+        TEST_VERIFY(archive->GetFloat64(FastName("float64")) == 2.25);
+        TEST_VERIFY(archive->GetString(FastName("string")) == "value");
+        TEST_VERIFY(archive->GetWideString(FastName("wideString")) == L"wide value");
+        TEST_VERIFY(archive->GetFastName(FastName("fastName")) == FastName("name"));
+        TEST_VERIFY(archive->GetVector3(FastName("vector3")) == Vector3(1.0f, 2.0f, 3.0f));
+        TEST_VERIFY(archive->GetMatrix4(FastName("matrix4")) == Matrix4::MakeScale(Vector3(2.0f, 2.0f, 2.0f)));
+        TEST_VERIFY(archive->GetColor(FastName("color")) == Color(0.1f, 0.2f, 0.3f, 0.4f));
+
+        TEST_VERIFY(archive->GetByteArraySize(FastName("byteArray")) == 5);
+        const uint8* bytes = archive->GetByteArray(FastName("byteArray"));
+        TEST_VERIFY(bytes != nullptr && bytes[0] == 1 && bytes[4] == 5);
+
+        RefPtr<FlatKeyedArchive> nested = archive->GetArchive(FastName("archive"));
+        TEST_VERIFY(nested.Valid());
+        if (nested.Valid())
+        {
+            TEST_VERIFY(nested->IsView());
+            TEST_VERIFY(nested->GetInt32(FastName("nestedInt")) == 42);
+            TEST_VERIFY(nested->GetString(FastName("nestedString")) == "nested");
+        }
+
+        TEST_VERIFY(archive->IsKeyExists(FastName("string")));
+        TEST_VERIFY(!archive->IsKeyExists(FastName("missing")));
+        TEST_VERIFY(archive->GetInt32(FastName("missing"), 5) == 5);
+        TEST_VERIFY(archive->GetVariant(FastName("int32")).AsInt32() == -17);
+    }
+
+    DAVA_TEST (ConvertFromKeyedArchive)
+    {
+        RefPtr<KeyedArchive> archive = CreateTestArchive();
+        RefPtr<FlatKeyedArchive> flatArchive(new FlatKeyedArchive(*archive));
+        VerifyArchive(flatArchive.Get());
+    }
+
+    DAVA_TEST (SaveLoadCompatibility)
+    {
+        RefPtr<KeyedArchive> archive = CreateTestArchive();
+        RefPtr<FlatKeyedArchive> flatArchive(new FlatKeyedArchive(*archive));
+
+        ScopedPtr<DynamicMemoryFile> buffer(DynamicMemoryFile::Create(File::CREATE | File::WRITE | File::READ));
+        TEST_VERIFY(flatArchive->Save(buffer));
+
+        RefPtr<KeyedArchive> loadedArchive(new KeyedArchive());
+        buffer->Seek(0, File::SEEK_FROM_START);
+        TEST_VERIFY(loadedArchive->Load(buffer));
+        TEST_VERIFY(loadedArchive->Count() == archive->Count());
+        TEST_VERIFY(loadedArchive->GetInt64("int64") == archive->GetInt64("int64"));
+        TEST_VERIFY(loadedArchive->GetString("string") == archive->GetString("string"));
+        TEST_VERIFY(loadedArchive->GetArchive("archive")->GetInt32("nestedInt") == 42);
+
+        RefPtr<KeyedArchive> convertedArchive = flatArchive->CreateKeyedArchive();
+        TEST_VERIFY(convertedArchive->Count() == archive->Count());
+        TEST_VERIFY(convertedArchive->GetMatrix4("matrix4") == archive->GetMatrix4("matrix4"));
+    }
+
+    DAVA_TEST (LoadView)
+    {
+        RefPtr<KeyedArchive> archive = CreateTestArchive();
+        ScopedPtr<DynamicMemoryFile> buffer(DynamicMemoryFile::Create(File::CREATE | File::WRITE));
+        archive->Save(buffer);
+
+        Vector<uint8> data = buffer->GetDataVector();
+        RefPtr<FlatKeyedArchive> view(new FlatKeyedArchive());
+        TEST_VERIFY(view->LoadView(data.data(), static_cast<uint32>(data.size())));
+        TEST_VERIFY(view->IsView());
+        VerifyArchive(view.Get());
+
+        // first modification copies values from the viewed buffer
+        view->SetInt32(FastName("int32"), 100);
+        TEST_VERIFY(!view->IsView());
+        std::fill(data.begin(), data.end(), 0);
+        TEST_VERIFY(view->GetInt32(FastName("int32")) == 100);
+        TEST_VERIFY(view->GetString(FastName("string")) == "value");
+
+        TEST_VERIFY(!view->LoadView(data.data(), static_cast<uint32>(data.size())));
+    }
+
+    DAVA_TEST (ViewToKeyedArchive)
+    {
+        RefPtr<KeyedArchive> archive = CreateTestArchive();
+        ScopedPtr<DynamicMemoryFile> buffer(DynamicMemoryFile::Create(File::CREATE | File::WRITE));
+        archive->Save(buffer);
+
+        const Vector<uint8>& data = buffer->GetDataVector();
+        RefPtr<FlatKeyedArchive> view(new FlatKeyedArchive());
+        TEST_VERIFY(view->LoadView(data.data(), static_cast<uint32>(data.size())));
+
+        RefPtr<KeyedArchive> convertedArchive = view->CreateKeyedArchive();
+        TEST_VERIFY(convertedArchive->Count() == archive->Count());
+        TEST_VERIFY(convertedArchive->GetString("string") == "value");
+
+        // deleted key should not be restored from viewed buffer
+        view->DeleteKey(FastName("string"));
+        TEST_VERIFY(!view->IsView());
+        convertedArchive = view->CreateKeyedArchive();
+        TEST_VERIFY(convertedArchive->Count() == archive->Count() - 1);
+        TEST_VERIFY(!convertedArchive->IsKeyExists("string"));
+    }
+
+    DAVA_TEST (LoadEntity)
+    {
+        ScopedPtr<Entity> entity(new Entity());
+        entity->SetName(FastName("entity"));
+        entity->GetComponent<TransformComponent>()->SetLocalTranslation(Vector3(1.0f, 2.0f, 3.0f));
+        CustomPropertiesComponent* properties = new CustomPropertiesComponent();
+        properties->GetArchive()->SetInt32("property", 7);
+        entity->AddComponent(properties);
+
+        SerializationContext serializationContext;
+        RefPtr<KeyedArchive> archive(new KeyedArchive());
+        entity->Save(archive.Get(), &serializationContext);
+
+        // components are stored as nested archives, TransformComponent reads them directly and others through KeyedArchive
+        RefPtr<FlatKeyedArchive> flatArchive(new FlatKeyedArchive(*archive));
+        ScopedPtr<Entity> loadedEntity(new Entity());
+        loadedEntity->LoadFlat(flatArchive.Get(), &serializationContext);
+
+        TEST_VERIFY(loadedEntity->GetName() == FastName("entity"));
+        TEST_VERIFY(loadedEntity->GetComponentCount() == entity->GetComponentCount());
+        TEST_VERIFY(loadedEntity->GetComponent<TransformComponent>()->GetLocalTransform().GetTranslation() == Vector3(1.0f, 2.0f, 3.0f));
+        CustomPropertiesComponent* loadedProperties = loadedEntity->GetComponent<CustomPropertiesComponent>();
+        TEST_VERIFY(loadedProperties != nullptr && loadedProperties->GetArchive()->GetInt32("property") == 7);
+    }
+
+    DAVA_TEST (LoadLongKeys)
+    {
+        const String longKey(300, 'k');
+        RefPtr<KeyedArchive> archive(new KeyedArchive());
+        archive->SetInt32("short", 1);
+        archive->SetInt32(longKey, 2);
+        archive->SetInt32(longKey + "2", 3);
+
+        ScopedPtr<DynamicMemoryFile> buffer(DynamicMemoryFile::Create(File::CREATE | File::WRITE | File::READ));
+        archive->Save(buffer);
+
+        RefPtr<FlatKeyedArchive> loadedArchive(new FlatKeyedArchive());
+        buffer->Seek(0, File::SEEK_FROM_START);
+        TEST_VERIFY(loadedArchive->Load(buffer));
+
+        const Vector<uint8>& data = buffer->GetDataVector();
+        RefPtr<FlatKeyedArchive> view(new FlatKeyedArchive());
+        TEST_VERIFY(view->LoadView(data.data(), static_cast<uint32>(data.size())));
+
+        for (const FlatKeyedArchive* flatArchive : { loadedArchive.Get(), view.Get() })
+        {
+            TEST_VERIFY(flatArchive->Count() == 3);
+            TEST_VERIFY(flatArchive->GetInt32(FastName("short")) == 1);
+            TEST_VERIFY(flatArchive->GetInt32(FastName(longKey)) == 2);
+            TEST_VERIFY(flatArchive->GetInt32(FastName(longKey + "2")) == 3);
+        }
+    }
+
+    DAVA_TEST (ModifyValues)
+    {
+        RefPtr<FlatKeyedArchive> archive(new FlatKeyedArchive());
+        archive->SetString(FastName("key"), "short");
+        archive->SetInt32(FastName("int"), 1);
+        archive->SetInt32(FastName("int"), 2);
+        archive->SetString(FastName("key"), "much longer value");
+        TEST_VERIFY(archive->Count() == 2);
+        TEST_VERIFY(archive->GetInt32(FastName("int")) == 2);
+        TEST_VERIFY(archive->GetString(FastName("key")) == "much longer value");
+
+        // replace value with value of other type
+        archive->SetFloat(FastName("int"), 1.5f);
+        TEST_VERIFY(archive->GetFloat(FastName("int")) == 1.5f);
+
+        for (int32 i = 0; i < 1000; ++i)
+        {
+            archive->SetString(FastName("key"), Format("value %d", i));
+        }
+        TEST_VERIFY(archive->GetString(FastName("key")) == "value 999");
+        TEST_VERIFY(archive->GetFloat(FastName("int")) == 1.5f);
+
+        RefPtr<FlatKeyedArchive> nested(new FlatKeyedArchive());
+        nested->SetVector2(FastName("vector"), Vector2(1.0f, 2.0f));
+        archive->SetArchive(FastName("nested"), nested.Get());
+        TEST_VERIFY(archive->GetArchive(FastName("nested"))->GetVector2(FastName("vector")) == Vector2(1.0f, 2.0f));
+
+        archive->SetVariant(FastName("variant"), VariantType(uint32(7)));
+        TEST_VERIFY(archive->GetUInt32(FastName("variant")) == 7);
+
+        archive->DeleteKey(FastName("key"));
+        TEST_VERIFY(!archive->IsKeyExists(FastName("key")));
+        TEST_VERIFY(archive->Count() == 3);
+
+        archive->DeleteAllKeys();
+        TEST_VERIFY(archive->Count() == 0);
+    }
+};
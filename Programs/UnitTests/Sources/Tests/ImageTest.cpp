@@ -6,9 +6,49 @@
 #include "Render/Image/ImageConvert.h"
 #include "Utils/StringFormat.h"
 #include "Utils/Random.h"
+#include "Time/SystemTimer.h"
 
 using namespace DAVA;
 
+namespace ImageTestDetails
+{
+const uint32 BENCHMARK_IMAGE_SIZE = 2048;
+
+ScopedPtr<Image> CreateRandomImage(uint32 width, uint32 height, PixelFormat format)
+{
+    ScopedPtr<Image> image(Image::Create(width, height, format));
+    for (uint32 i = 0; i < image->GetDataSize(); ++i)
+    {
+        image->GetData()[i] = static_cast<uint8>(Random::Instance()->Rand(256));
+    }
+    return image;
+}
+
+template <class SCALAR_CONVERTER>
+void BenchmarkConversion(PixelFormat inFormat, PixelFormat outFormat)
+{
+    ScopedPtr<Image> source(CreateRandomImage(BENCHMARK_IMAGE_SIZE, BENCHMARK_IMAGE_SIZE, inFormat));
+    ScopedPtr<Image> scalarResult(Image::Create(BENCHMARK_IMAGE_SIZE, BENCHMARK_IMAGE_SIZE, outFormat));
+    ScopedPtr<Image> result(Image::Create(BENCHMARK_IMAGE_SIZE, BENCHMARK_IMAGE_SIZE, outFormat));
+
+    const uint32 inPitch = ImageUtils::GetPitchInBytes(BENCHMARK_IMAGE_SIZE, inFormat);
+    const uint32 outPitch = ImageUtils::GetPitchInBytes(BENCHMARK_IMAGE_SIZE, outFormat);
+
+    int64 startTime = SystemTimer::GetUs();
+    SCALAR_CONVERTER convert;
+    convert(source->GetData(), BENCHMARK_IMAGE_SIZE, BENCHMARK_IMAGE_SIZE, inPitch, scalarResult->GetData(), BENCHMARK_IMAGE_SIZE, BENCHMARK_IMAGE_SIZE, outPitch);
+    int64 scalarTime = SystemTimer::GetUs() - startTime;
+
+    startTime = SystemTimer::GetUs();
+    TEST_VERIFY(ImageConvert::ConvertImageDirect(source, result));
+    int64 time = SystemTimer::GetUs() - startTime;
+
+    TEST_VERIFY(Memcmp(scalarResult->GetData(), result->GetData(), result->GetDataSize()) == 0);
+    Logger::Info("ImageTest: %s -> %s, scalar %lld us, ImageConvert %lld us",
+                 PixelFormatDescriptor::GetPixelFormatString(inFormat), PixelFormatDescriptor::GetPixelFormatString(outFormat), scalarTime, time);
+}
+}
+
 DAVA_TESTCLASS (ImageTest)
 {
     DAVA_TEST (DownscaleTest)
@@ -107,4 +147,43 @@ DAVA_TESTCLASS (ImageTest)
             }
         }
     }
+
+    DAVA_TEST (ConversionBenchmarkTest)
+    {
+        using namespace ImageTestDetails;
+
+        // ImageConvert results match scalar converters on any data, with vectorized and threaded paths
+        BenchmarkConversion<ConvertDirect<BGRA8888, RGBA8888, ConvertBGRA8888toRGBA8888>>(FORMAT_BGRA8888, FORMAT_RGBA8888);
+        BenchmarkConversion<ConvertDirect<uint16, uint32, ConvertRGBA4444toRGBA8888>>(FORMAT_RGBA4444, FORMAT_RGBA8888);
+        BenchmarkConversion<ConvertDirect<uint16, uint32, ConvertRGBA5551toRGBA8888>>(FORMAT_RGBA5551, FORMAT_RGBA8888);
+        BenchmarkConversion<ConvertDirect<uint16, uint32, ConvertRGB565toRGBA8888>>(FORMAT_RGB565, FORMAT_RGBA8888);
+        BenchmarkConversion<ConvertDirect<uint8, uint32, ConvertA8toRGBA8888>>(FORMAT_A8, FORMAT_RGBA8888);
+    }
+
+    DAVA_TEST (DownscaleBenchmarkTest)
+    {
+        using namespace ImageTestDetails;
+
+        // odd width covers scalar tail of vectorized rows
+        const uint32 width = BENCHMARK_IMAGE_SIZE + 6;
+        const uint32 height = BENCHMARK_IMAGE_SIZE;
+        ScopedPtr<Image> source(CreateRandomImage(width, height, FORMAT_RGBA8888));
+        ScopedPtr<Image> scalarResult(Image::Create(width / 2, height / 2, FORMAT_RGBA8888));
+
+        int64 startTime = SystemTimer::GetUs();
+        ConvertDownscaleTwiceBillinear<uint32, uint32, uint32, UnpackRGBA8888, PackRGBA8888> downscale;
+        downscale(source->GetData(), width, height, width * 4, scalarResult->GetData(), width / 2, height / 2, width / 2 * 4);
+        int64 scalarTime = SystemTimer::GetUs() - startTime;
+
+        startTime = SystemTimer::GetUs();
+        ScopedPtr<Image> result(ImageConvert::DownscaleTwiceBillinear(source));
+        int64 time = SystemTimer::GetUs() - startTime;
+
+        TEST_VERIFY(result);
+        if (result)
+        {
+            TEST_VERIFY(Memcmp(scalarResult->GetData(), result->GetData(), result->GetDataSize()) == 0);
+        }
+        Logger::Info("ImageTest: downscale RGBA8888 %ux%u, scalar %lld us, ImageConvert %lld us", width, height, scalarTime, time);
+    }
 };
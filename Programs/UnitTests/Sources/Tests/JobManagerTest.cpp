@@ -1,6 +1,8 @@
 #include "DAVAEngine.h"
 #include "UnitTests/UnitTests.h"
 
+#include <atomic>
+
 using namespace DAVA;
 
 #define JOBS_COUNT 500
@@ -83,8 +85,162 @@ DAVA_TESTCLASS (JobManagerTest)
 
     DAVA_TEST (TestWorkerJobs)
     {
-        // TODO:
-        // ...
+        JobManager* jobManager = GetEngineContext()->jobManager;
+
+        Atomic<uint32> counter(0);
+        Vector<JobHandle> jobs;
+        for (uint32 i = 0; i < JOBS_COUNT; ++i)
+        {
+            jobs.push_back(jobManager->CreateWorkerJob([&counter]() { counter++; }));
+        }
+
+        for (const JobHandle& job : jobs)
+        {
+            jobManager->WaitWorkerJob(job);
+            TEST_VERIFY(job.IsFinished());
+        }
+        TEST_VERIFY(counter == JOBS_COUNT);
+
+        jobManager->WaitWorkerJobs();
+        TEST_VERIFY(!jobManager->HasWorkerJobs());
+    }
+
+    DAVA_TEST (TestWorkerJobDependencies)
+    {
+        JobManager* jobManager = GetEngineContext()->jobManager;
+
+        for (uint32 n = 0; n < 100; ++n)
+        {
+            Atomic<uint32> stage(0);
+            bool orderIsValid = true;
+
+            JobHandle first = jobManager->CreateWorkerJob([&stage]() { stage = 1; });
+            JobHandle second = jobManager->CreateWorkerJob([&stage]() { stage++; });
+            JobHandle last = jobManager->CreateWorkerJob([&stage, &orderIsValid]() { orderIsValid = (stage == 2); }, { first, second });
+
+            jobManager->WaitWorkerJob(last);
+            TEST_VERIFY(orderIsValid);
+            TEST_VERIFY(first.IsFinished() && second.IsFinished());
+        }
+    }
+
+    DAVA_TEST (TestChildWorkerJobs)
+    {
+        JobManager* jobManager = GetEngineContext()->jobManager;
+
+        Atomic<uint32> childrenExecuted(0);
+        std::atomic<bool> parentAssigned(false);
+
+        // Parent job is started only after its handle is assigned, so it can attach children to itself
+        JobHandle gate = jobManager->CreateWorkerJob([&parentAssigned]() {
+            while (!parentAssigned)
+            {
+                Thread::Yield();
+            }
+        });
+
+        JobHandle parent;
+        auto parentFn = [jobManager, &parent, &childrenExecuted]() {
+            for (uint32 i = 0; i < JOBS_COUNT; ++i)
+            {
+                jobManager->CreateChildWorkerJob(parent, [&childrenExecuted]() {
+                    Thread::Yield();
+                    childrenExecuted++;
+                });
+            }
+        };
+        parent = jobManager->CreateWorkerJob(parentFn, { gate });
+        parentAssigned = true;
+
+        jobManager->WaitWorkerJob(parent);
+        TEST_VERIFY(childrenExecuted == JOBS_COUNT);
+    }
+
+    DAVA_TEST (TestWaitDoesNotRunUnrelatedJobs)
+    {
+        JobManager* jobManager = GetEngineContext()->jobManager;
+        uint64 waiterThreadId = Thread::GetCurrentIdAsUInt64();
+
+        std::atomic<bool> unrelatedRunOnWaiter(false);
+        for (uint32 i = 0; i < JOBS_COUNT; ++i)
+        {
+            jobManager->CreateWorkerJob([waiterThreadId, &unrelatedRunOnWaiter]() {
+                Thread::Yield();
+                if (Thread::GetCurrentIdAsUInt64() == waiterThreadId)
+                {
+                    unrelatedRunOnWaiter = true;
+                }
+            });
+        }
+
+        Atomic<uint32> childrenExecuted(0);
+        std::atomic<bool> parentAssigned(false);
+        JobHandle gate = jobManager->CreateWorkerJob([&parentAssigned]() {
+            while (!parentAssigned)
+            {
+                Thread::Yield();
+            }
+        });
+
+        JobHandle parent;
+        auto parentFn = [jobManager, &parent, &childrenExecuted]() {
+            for (uint32 i = 0; i < 100; ++i)
+            {
+                jobManager->CreateChildWorkerJob(parent, [&childrenExecuted]() { childrenExecuted++; });
+            }
+        };
+        parent = jobManager->CreateWorkerJob(parentFn, { gate });
+        parentAssigned = true;
+
+        jobManager->WaitWorkerJob(parent);
+        TEST_VERIFY(childrenExecuted == 100);
+
+        jobManager->WaitWorkerJobs();
+        TEST_VERIFY(!unrelatedRunOnWaiter);
+    }
+
+    DAVA_TEST (TestParallelFor)
+    {
+        JobManager* jobManager = GetEngineContext()->jobManager;
+
+        const uint32 count = 100000;
+        Vector<uint32> values(count, 0);
+        jobManager->ParallelFor(0, count, 1000, [&values](uint32 begin, uint32 end) {
+            for (uint32 i = begin; i < end; ++i)
+            {
+                values[i] += i;
+            }
+        });
+
+        bool allValuesSet = true;
+        for (uint32 i = 0; i < count; ++i)
+        {
+            allValuesSet &= (values[i] == i);
+        }
+        TEST_VERIFY(allValuesSet);
+
+        // Nested ParallelFor
+        std::atomic<uint32> sum(0);
+        jobManager->ParallelFor(0, 16, 1, [jobManager, &sum](uint32 begin, uint32 end) {
+            jobManager->ParallelFor(0, 100, 7, [&sum](uint32 b, uint32 e) {
+                sum += (e - b);
+            });
+        });
+        TEST_VERIFY(sum == 1600);
+
+        // Range at the end of uint32 values, last chunk is shorter than grain
+        std::atomic<uint32> itemsCount(0);
+        std::atomic<uint32> maxEnd(0);
+        const uint32 rangeEnd = std::numeric_limits<uint32>::max();
+        jobManager->ParallelFor(rangeEnd - 2500, rangeEnd, 1000, [&itemsCount, &maxEnd](uint32 begin, uint32 end) {
+            itemsCount += (end - begin);
+            uint32 currentMax = maxEnd;
+            while (currentMax < end && !maxEnd.compare_exchange_weak(currentMax, end))
+            {
+            }
+        });
+        TEST_VERIFY(itemsCount == 2500);
+        TEST_VERIFY(maxEnd == rangeEnd);
     }
 
     void ThreadFunc(JobManagerTestData * data)
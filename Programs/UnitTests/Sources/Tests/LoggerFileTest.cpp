@@ -23,6 +23,9 @@ DAVA_TESTCLASS (LoggerFileTest)
         {
             if (i > 0)
             {
+                // messages are written to file by background thread
+                logger->Flush();
+
                 ScopedPtr<File> log(File::Create(logFilePath, File::OPEN | File::READ));
                 TEST_VERIFY(log);
                 uint64 size = log->GetSize();
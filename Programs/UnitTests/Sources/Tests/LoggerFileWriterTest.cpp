@@ -0,0 +1,101 @@
+#include "UnitTests/UnitTests.h"
+#include "Concurrency/Thread.h"
+#include "FileSystem/File.h"
+#include "FileSystem/FileSystem.h"
+#include "Logger/Logger.h"
+#include "Logger/Private/LoggerFileWriter.h"
+#include "Time/SystemTimer.h"
+
+#include <algorithm>
+
+using namespace DAVA;
+
+namespace LoggerFileWriterTestDetails
+{
+const char8* message = "LoggerFileWriterTest message with some payload to look like real log line\n";
+
+uint32 CountLines(const FilePath& filepath)
+{
+    String contents = FileSystem::Instance()->ReadFileContents(filepath);
+    return static_cast<uint32>(std::count(contents.begin(), contents.end(), '\n'));
+}
+}
+
+DAVA_TESTCLASS (LoggerFileWriterTest)
+{
+    DAVA_TEST (TestMultithreadedThroughput)
+    {
+        using namespace LoggerFileWriterTestDetails;
+
+        const uint32 threadCount = 4;
+        const uint32 messageCount = 20000;
+        const FilePath logFilePath(Logger::GetLogPathForFilename("LoggerFileWriterTest.txt"));
+        FileSystem::Instance()->DeleteFile(logFilePath);
+
+        LoggerFileWriter writer([](const FilePath&) {});
+        Vector<Thread*> threads(threadCount);
+
+        int64 startTime = SystemTimer::GetUs();
+        for (uint32 t = 0; t < threadCount; ++t)
+        {
+            threads[t] = Thread::Create([&writer, &logFilePath, messageCount]() {
+                for (uint32 i = 0; i < messageCount; ++i)
+                {
+                    writer.Push(logFilePath, Logger::LEVEL_DEBUG, message, false);
+                }
+            });
+            threads[t]->Start();
+        }
+        for (Thread* thread : threads)
+        {
+            thread->Join();
+            thread->Release();
+        }
+        int64 pushTime = SystemTimer::GetUs() - startTime;
+        writer.Flush(true);
+        int64 totalTime = SystemTimer::GetUs() - startTime;
+
+        TEST_VERIFY(CountLines(logFilePath) == threadCount * messageCount);
+
+        // file is opened for each message as it was done before background writer
+        const uint32 syncMessageCount = 2000;
+        startTime = SystemTimer::GetUs();
+        for (uint32 i = 0; i < syncMessageCount; ++i)
+        {
+            ScopedPtr<File> file(File::Create(logFilePath, File::APPEND | File::WRITE));
+            file->Write(message, static_cast<uint32>(strlen(message)));
+        }
+        int64 syncTime = SystemTimer::GetUs() - startTime;
+
+        const uint32 totalMessages = threadCount * messageCount;
+        Logger::Info("LoggerFileWriterTest: %u messages from %u threads pushed in %lld us (%.0f msg/s), written in %lld us (%.0f msg/s)",
+                     totalMessages, threadCount,
+                     pushTime, totalMessages * 1000000.0 / std::max<int64>(pushTime, 1),
+                     totalTime, totalMessages * 1000000.0 / std::max<int64>(totalTime, 1));
+        Logger::Info("LoggerFileWriterTest: file opened for each message: %.0f msg/s", syncMessageCount * 1000000.0 / std::max<int64>(syncTime, 1));
+
+        FileSystem::Instance()->DeleteFile(logFilePath);
+    }
+
+    DAVA_TEST (TestLimitedFileIsCut)
+    {
+        using namespace LoggerFileWriterTestDetails;
+
+        const FilePath logFilePath(Logger::GetLogPathForFilename("LoggerFileWriterLimitTest.txt"));
+        FileSystem::Instance()->DeleteFile(logFilePath);
+
+        uint32 cutCount = 0;
+        LoggerFileWriter writer([&cutCount](const FilePath&) { ++cutCount; });
+
+        writer.Push(logFilePath, Logger::LEVEL_INFO, message, true);
+        writer.Flush(false);
+        writer.Push(logFilePath, Logger::LEVEL_INFO, message, true);
+        writer.Flush(false);
+
+        // limited file is closed after each batch and cut before reopening
+        TEST_VERIFY(cutCount == 2);
+        TEST_VERIFY(CountLines(logFilePath) == 2);
+
+        FileSystem::Instance()->DeleteFile(logFilePath);
+    }
+};
@@ -114,6 +114,66 @@ DAVA_TESTCLASS (MemoryManagerTest)
         ::operator delete(buffer);
     }
 
+    DAVA_TEST (TestCrossThreadDealloc)
+    {
+        const size_t statSize = MemoryManager::Instance()->CalcCurStatSize();
+        void* buffer = ::operator new(statSize);
+        AllocPoolStat* poolStat = OffsetPointer<AllocPoolStat>(buffer, sizeof(MMCurStat));
+
+        MemoryManager::Instance()->GetCurStat(0, buffer, static_cast<uint32>(statSize));
+        uint32 oldAllocByApp = poolStat[ALLOC_POOL_BULLET].allocByApp;
+        uint32 oldBlockCount = poolStat[ALLOC_POOL_BULLET].blockCount;
+
+        const uint32 threadCount = 4;
+        const uint32 allocCount = 10000;
+        const uint32 allocSize = 16;
+        Vector<Vector<void*>> allocated(threadCount, Vector<void*>(allocCount, nullptr));
+        Vector<Thread*> threads(threadCount);
+
+        // Blocks are allocated with sampled backtraces by worker threads and freed by this thread
+        DAVA_MEMORY_PROFILER_SET_BACKTRACE_SAMPLING(8);
+        int64 startTime = SystemTimer::GetUs();
+        for (uint32 t = 0; t < threadCount; ++t)
+        {
+            Vector<void*>& ptrs = allocated[t];
+            threads[t] = Thread::Create([&ptrs]() {
+                for (void*& ptr : ptrs)
+                {
+                    ptr = MemoryManager::Instance()->Allocate(allocSize, ALLOC_POOL_BULLET);
+                }
+            });
+            threads[t]->Start();
+        }
+        for (Thread* thread : threads)
+        {
+            thread->Join();
+            thread->Release();
+        }
+        int64 allocTime = SystemTimer::GetUs() - startTime;
+        DAVA_MEMORY_PROFILER_SET_BACKTRACE_SAMPLING(1);
+
+        MemoryManager::Instance()->GetCurStat(0, buffer, static_cast<uint32>(statSize));
+        TEST_VERIFY(oldAllocByApp + threadCount * allocCount * allocSize == poolStat[ALLOC_POOL_BULLET].allocByApp);
+        TEST_VERIFY(oldBlockCount + threadCount * allocCount == poolStat[ALLOC_POOL_BULLET].blockCount);
+        TEST_VERIFY(MemoryManager::Instance()->GetTrackedMemoryUsage(ALLOC_POOL_BULLET) == poolStat[ALLOC_POOL_BULLET].allocByApp);
+
+        for (const Vector<void*>& ptrs : allocated)
+        {
+            for (void* ptr : ptrs)
+            {
+                MemoryManager::Instance()->Deallocate(ptr);
+            }
+        }
+
+        MemoryManager::Instance()->GetCurStat(0, buffer, static_cast<uint32>(statSize));
+        TEST_VERIFY(oldAllocByApp == poolStat[ALLOC_POOL_BULLET].allocByApp);
+        TEST_VERIFY(oldBlockCount == poolStat[ALLOC_POOL_BULLET].blockCount);
+
+        Logger::Info("MemoryManagerTest: %u allocations in %u threads took %lld us", threadCount * allocCount, threadCount, allocTime);
+
+        ::operator delete(buffer);
+    }
+
     DAVA_TEST (TestCallback)
     {
         const uint32 TAG = 1;
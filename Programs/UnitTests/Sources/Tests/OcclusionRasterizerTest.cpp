@@ -0,0 +1,183 @@
+#include "UnitTests/UnitTests.h"
+#include "Base/ScopedPtr.h"
+#include "Render/Highlevel/Camera.h"
+#include "Render/Highlevel/GeometryGenerator.h"
+#include "Render/Highlevel/OcclusionRasterizer.h"
+#include "Render/3D/PolygonGroup.h"
+#include "Render/Highlevel/Mesh.h"
+#include "Render/Highlevel/StaticOcclusion.h"
+#include "Render/Material/NMaterial.h"
+#include "Render/Material/NMaterialNames.h"
+#include "Scene3D/Components/RenderComponent.h"
+#include "Scene3D/Entity.h"
+#include "Scene3D/Scene.h"
+#include "Time/SystemTimer.h"
+#include "Logger/Logger.h"
+
+using namespace DAVA;
+
+namespace OcclusionRasterizerTestDetails
+{
+const uint32 bufferSize = 64;
+
+// 10x10 quad facing camera at distance 10, covers quarter of screen with 90 degrees fov
+const Vector3 quadVertices[] = {
+    Vector3(-5.0f, 10.0f, -5.0f), Vector3(5.0f, 10.0f, -5.0f), Vector3(5.0f, 10.0f, 5.0f), Vector3(-5.0f, 10.0f, 5.0f)
+};
+const uint16 quadIndices[] = { 0, 1, 2, 0, 2, 3 };
+
+PolygonGroup* CreateBox(const AABBox3& box)
+{
+    Map<FastName, float32> options = {
+        { FastName("segments.x"), 1.0f },
+        { FastName("segments.y"), 1.0f },
+        { FastName("segments.z"), 1.0f }
+    };
+    return GeometryGenerator::GenerateBox(box, options);
+}
+
+void AddBoxEntity(Scene* scene, const AABBox3& box, uint16 staticOcclusionIndex)
+{
+    ScopedPtr<PolygonGroup> geometry(CreateBox(box));
+    ScopedPtr<NMaterial> material(new NMaterial());
+    material->SetMaterialName(FastName("OcclusionRasterizerTestBox"));
+    material->SetFXName(NMaterialName::TEXTURED_OPAQUE);
+
+    ScopedPtr<Mesh> mesh(new Mesh());
+    mesh->AddPolygonGroup(geometry, material);
+    mesh->SetStaticOcclusionIndex(staticOcclusionIndex);
+
+    ScopedPtr<Entity> entity(new Entity());
+    entity->AddComponent(new RenderComponent(mesh));
+    scene->AddNode(entity);
+}
+}
+
+DAVA_TESTCLASS (OcclusionRasterizerTest)
+{
+    void BeginFrame(OcclusionRasterizer & rasterizer)
+    {
+        using namespace OcclusionRasterizerTestDetails;
+
+        ScopedPtr<Camera> camera(new Camera());
+        camera->SetupPerspective(90.0f, 1.0f, 1.0f, 1000.0f);
+        camera->SetPosition(Vector3(0.0f, 0.0f, 0.0f));
+        camera->SetDirection(Vector3(0.0f, 1.0f, 0.0f));
+        camera->SetUp(Vector3(0.0f, 0.0f, 1.0f));
+        rasterizer.Begin(camera->GetViewProjMatrix(), rhi::DeviceCaps().isZeroBaseClipRange);
+
+        AABBox3 quadBox(Vector3(-5.0f, 10.0f, -5.0f), Vector3(5.0f, 10.0f, 5.0f));
+        rasterizer.DrawOccluder(quadVertices, sizeof(Vector3), 4, quadIndices, 6, Matrix4::IDENTITY, quadBox);
+    }
+
+    DAVA_TEST (TestBoxVisibility)
+    {
+        using namespace OcclusionRasterizerTestDetails;
+
+        OcclusionRasterizer rasterizer(bufferSize, bufferSize);
+        BeginFrame(rasterizer);
+
+        TEST_VERIFY(!rasterizer.IsBoxVisible(AABBox3(Vector3(0.0f, 20.0f, 0.0f), 2.0f))); // right behind quad
+        TEST_VERIFY(rasterizer.IsBoxVisible(AABBox3(Vector3(0.0f, 5.0f, 0.0f), 2.0f))); // in front of quad
+        TEST_VERIFY(rasterizer.IsBoxVisible(AABBox3(Vector3(15.0f, 20.0f, 0.0f), 2.0f))); // behind, but aside
+        TEST_VERIFY(rasterizer.IsBoxVisible(AABBox3(Vector3(0.0f, 20.0f, 0.0f), 30.0f))); // bigger than quad
+        TEST_VERIFY(rasterizer.IsBoxVisible(AABBox3(Vector3(0.0f, 0.0f, 0.0f), 4.0f))); // crosses near plane
+    }
+
+    DAVA_TEST (TestCountVisiblePixels)
+    {
+        using namespace OcclusionRasterizerTestDetails;
+
+        OcclusionRasterizer rasterizer(bufferSize, bufferSize);
+        BeginFrame(rasterizer);
+
+        // occluder passes depth test against itself
+        AABBox3 quadBox(Vector3(-5.0f, 10.0f, -5.0f), Vector3(5.0f, 10.0f, 5.0f));
+        uint32 quadPixels = rasterizer.CountVisiblePixels(quadVertices, sizeof(Vector3), 4, quadIndices, 6, Matrix4::IDENTITY, quadBox);
+        const uint32 expectedQuadPixels = bufferSize * bufferSize / 4;
+        TEST_VERIFY(quadPixels + bufferSize >= expectedQuadPixels && quadPixels <= expectedQuadPixels + bufferSize);
+
+        ScopedPtr<PolygonGroup> hiddenBox(CreateBox(AABBox3(Vector3(0.0f, 20.0f, 0.0f), 2.0f)));
+        ScopedPtr<PolygonGroup> frontBox(CreateBox(AABBox3(Vector3(0.0f, 5.0f, 0.0f), 2.0f)));
+        ScopedPtr<PolygonGroup> wideBox(CreateBox(AABBox3(Vector3(0.0f, 20.0f, 0.0f), 30.0f)));
+        TEST_VERIFY(OcclusionRasterizer::CanRasterize(hiddenBox));
+
+        TEST_VERIFY(rasterizer.CountVisiblePixels(hiddenBox, Matrix4::IDENTITY) == 0);
+        TEST_VERIFY(rasterizer.CountVisiblePixels(frontBox, Matrix4::IDENTITY) > 0);
+        TEST_VERIFY(rasterizer.CountVisiblePixels(wideBox, Matrix4::IDENTITY) > 0);
+
+        // moved aside by world transform
+        TEST_VERIFY(rasterizer.CountVisiblePixels(hiddenBox, Matrix4::MakeTranslation(Vector3(15.0f, 0.0f, 0.0f))) > 0);
+
+        // depth buffer is not changed by counting
+        TEST_VERIFY(rasterizer.CountVisiblePixels(hiddenBox, Matrix4::IDENTITY) == 0);
+    }
+
+    DAVA_TEST (TestNearPlaneClipping)
+    {
+        using namespace OcclusionRasterizerTestDetails;
+
+        OcclusionRasterizer rasterizer(bufferSize, bufferSize);
+        BeginFrame(rasterizer);
+
+        // floor under camera goes from behind camera to far away, it hides boxes under it
+        const Vector3 floorVertices[] = {
+            Vector3(-100.0f, -100.0f, -1.0f), Vector3(100.0f, -100.0f, -1.0f), Vector3(100.0f, 100.0f, -1.0f), Vector3(-100.0f, 100.0f, -1.0f)
+        };
+        AABBox3 floorBox(Vector3(-100.0f, -100.0f, -1.0f), Vector3(100.0f, 100.0f, -1.0f));
+        rasterizer.DrawOccluder(floorVertices, sizeof(Vector3), 4, quadIndices, 6, Matrix4::IDENTITY, floorBox);
+
+        TEST_VERIFY(!rasterizer.IsBoxVisible(AABBox3(Vector3(0.0f, 30.0f, -10.0f), 2.0f)));
+        TEST_VERIFY(rasterizer.IsBoxVisible(AABBox3(Vector3(20.0f, 30.0f, 0.0f), 2.0f)));
+    }
+
+    DAVA_TEST (TestStaticOcclusionSoftwareBake)
+    {
+        using namespace OcclusionRasterizerTestDetails;
+
+        const uint16 wallIndex = 0;
+        const uint16 hiddenIndex = 1;
+        const uint16 frontIndex = 2;
+
+        // single cell, wide wall on +y side hides box behind it, box on -y side is open
+        ScopedPtr<Scene> scene(new Scene());
+        AddBoxEntity(scene, AABBox3(Vector3(-200.0f, 20.0f, -200.0f), Vector3(200.0f, 22.0f, 200.0f)), wallIndex);
+        AddBoxEntity(scene, AABBox3(Vector3(0.0f, 50.0f, 5.0f), 2.0f), hiddenIndex);
+        AddBoxEntity(scene, AABBox3(Vector3(0.0f, -30.0f, 5.0f), 2.0f), frontIndex);
+        scene->Update(0.1f);
+
+        StaticOcclusionData data;
+        data.Init(1, 1, 1, 3, AABBox3(Vector3(-5.0f, -5.0f, 0.0f), Vector3(5.0f, 5.0f, 10.0f)), nullptr);
+
+        StaticOcclusion staticOcclusion;
+        staticOcclusion.StartBuildOcclusion(&data, scene->GetRenderSystem(), nullptr, 0, 0, true);
+        while (!staticOcclusion.ProcessBlock())
+        {
+        }
+
+        TEST_VERIFY(data.IsObjectVisibleFromBlock(0, frontIndex));
+        TEST_VERIFY(!data.IsObjectVisibleFromBlock(0, hiddenIndex));
+    }
+
+    DAVA_TEST (TestRasterizationSpeed)
+    {
+        using namespace OcclusionRasterizerTestDetails;
+
+        OcclusionRasterizer rasterizer(256, 128);
+        ScopedPtr<PolygonGroup> box(CreateBox(AABBox3(Vector3(0.0f, 0.0f, 0.0f), 2.0f)));
+
+        const uint32 framesCount = 100;
+        int64 startTime = SystemTimer::GetUs();
+        for (uint32 frame = 0; frame < framesCount; ++frame)
+        {
+            BeginFrame(rasterizer);
+            for (uint32 i = 0; i < 100; ++i)
+            {
+                rasterizer.DrawOccluder(box, Matrix4::MakeTranslation(Vector3(float32(i % 10) * 3.0f - 15.0f, 15.0f + float32(i / 10) * 3.0f, 0.0f)));
+            }
+        }
+        int64 frameTime = (SystemTimer::GetUs() - startTime) / framesCount;
+
+        Logger::Info("OcclusionRasterizerTest: 100 boxes rasterized into 256x128 in %lld us", frameTime);
+    }
+};
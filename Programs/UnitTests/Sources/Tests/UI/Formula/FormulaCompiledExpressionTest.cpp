@@ -0,0 +1,217 @@
+#include "DAVAEngine.h"
+
+#include "UI/Formula/Private/FormulaCompiledExpression.h"
+#include "UI/Formula/Private/FormulaException.h"
+#include "UI/Formula/Private/FormulaExecutor.h"
+#include "UI/Formula/Private/FormulaParser.h"
+
+#include "Reflection/ReflectionRegistrator.h"
+
+#include "UnitTests/UnitTests.h"
+
+using namespace DAVA;
+
+class FormulaCompiledExpressionTestData : public ReflectionBase
+{
+    DAVA_VIRTUAL_REFLECTION(FormulaCompiledExpressionTestData);
+
+public:
+    float flVal = 2.5f;
+    bool bVal = true;
+    String strVal = "Hello";
+    int intVal = 42;
+    Vector<int> array;
+    Map<String, int> map;
+    FormulaCompiledExpressionTestData* child = nullptr;
+
+    FormulaCompiledExpressionTestData()
+    {
+        array.push_back(10);
+        array.push_back(20);
+
+        map["a"] = 11;
+        map["b"] = 22;
+    }
+
+    int addToVal(const std::shared_ptr<FormulaContext>& context, int a)
+    {
+        return intVal + a;
+    }
+
+    String floatToStr(const std::shared_ptr<FormulaContext>& context, float a)
+    {
+        return Format("%.1f", static_cast<double>(a));
+    }
+};
+
+DAVA_VIRTUAL_REFLECTION_IMPL(FormulaCompiledExpressionTestData)
+{
+    ReflectionRegistrator<FormulaCompiledExpressionTestData>::Begin()
+    .Field("fl", &FormulaCompiledExpressionTestData::flVal)
+    .Field("b", &FormulaCompiledExpressionTestData::bVal)
+    .Field("str", &FormulaCompiledExpressionTestData::strVal)
+    .Field("intVal", &FormulaCompiledExpressionTestData::intVal)
+    .Field("array", &FormulaCompiledExpressionTestData::array)
+    .Field("map", &FormulaCompiledExpressionTestData::map)
+    .Field("child", &FormulaCompiledExpressionTestData::child)
+    .Method("addToVal", &FormulaCompiledExpressionTestData::addToVal)
+    .Method("floatToStr", &FormulaCompiledExpressionTestData::floatToStr)
+    .End();
+};
+
+DAVA_TESTCLASS (FormulaCompiledExpressionTest)
+{
+    // FormulaCompiledExpression::Calculate
+    DAVA_TEST (CalculateSameAsExecutor)
+    {
+        FormulaCompiledExpressionTestData data;
+        std::shared_ptr<FormulaContext> context = CreateContext(&data);
+
+        for (const String& str : { "5", "-intVal", "not b", "1---2", "map.a + map.b * 2", "intVal / 5 + fl",
+                                   "str + \" world\"", "array[1] - array[0]", "array[map.a - 10]",
+                                   "when intVal > 50 -> 1, b and intVal == 42 -> array[1], 3",
+                                   "addToVal(intVal)", "floatToStr(5)", "floatToStr(fl * 2.0)" })
+        {
+            std::shared_ptr<FormulaExpression> exp = FormulaParser(str).ParseExpression();
+            FormulaExecutor executor(context);
+            Any expected = executor.Calculate(exp.get());
+
+            FormulaCompiledExpression compiled(exp);
+            TEST_VERIFY(compiled.Calculate(context) == expected);
+            TEST_VERIFY(compiled.GetDependencies() == executor.GetDependencies());
+        }
+    }
+
+    // FormulaCompiledExpression::Calculate
+    DAVA_TEST (ErrorsSameAsExecutor)
+    {
+        FormulaCompiledExpressionTestData data;
+        std::shared_ptr<FormulaContext> context = CreateContext(&data);
+
+        for (const String& str : { "5 + 5L", "not 5", "-str", "map.d", "array[5.5]", "when 5 -> 1, 2",
+                                   "addToVal(1, 2)", "floatToStr(true)", "intVal / 0" })
+        {
+            std::shared_ptr<FormulaExpression> exp = FormulaParser(str).ParseExpression();
+
+            String expectedError;
+            try
+            {
+                FormulaExecutor(context).Calculate(exp.get());
+            }
+            catch (const FormulaException& error)
+            {
+                expectedError = error.GetFormattedMessage();
+            }
+
+            String error;
+            try
+            {
+                FormulaCompiledExpression(exp).Calculate(context);
+            }
+            catch (const FormulaException& e)
+            {
+                error = e.GetFormattedMessage();
+            }
+
+            TEST_VERIFY(!error.empty());
+            TEST_VERIFY(error == expectedError);
+        }
+    }
+
+    // FormulaCompiledExpression::Calculate
+    DAVA_TEST (RepeatedCalculation)
+    {
+        FormulaCompiledExpressionTestData data1;
+        FormulaCompiledExpressionTestData data2;
+        data2.intVal = 100;
+
+        std::shared_ptr<FormulaContext> context1 = CreateContext(&data1);
+        std::shared_ptr<FormulaContext> context2 = CreateContext(&data2);
+
+        FormulaCompiledExpression compiled(FormulaParser("addToVal(array[1])").ParseExpression());
+        TEST_VERIFY(compiled.Calculate(context1) == Any(62));
+
+        data1.array[1] = 30;
+        TEST_VERIFY(compiled.Calculate(context1) == Any(72));
+
+        // function is resolved again for other context
+        TEST_VERIFY(compiled.Calculate(context2) == Any(120));
+        TEST_VERIFY(compiled.GetDependencies() == Vector<void*>({ &(data2.array), &(data2.array[1]) }));
+    }
+
+    // FormulaCompiledExpression::Calculate
+    DAVA_TEST (CachedFieldsFollowData)
+    {
+        FormulaCompiledExpressionTestData data1;
+        FormulaCompiledExpressionTestData data2;
+        FormulaCompiledExpressionTestData child1;
+        FormulaCompiledExpressionTestData child2;
+        child1.intVal = 1;
+        child2.intVal = 2;
+        data1.child = &child1;
+        data2.child = &child1;
+
+        std::shared_ptr<FormulaContext> context1 = CreateContext(&data1);
+        std::shared_ptr<FormulaContext> context2 = CreateContext(&data2);
+
+        std::shared_ptr<FormulaExpression> exp = FormulaParser("child.intVal + map.a").ParseExpression();
+        FormulaCompiledExpression compiled(exp);
+        TEST_VERIFY(compiled.Calculate(context1) == Any(12));
+        TEST_VERIFY(compiled.Calculate(context1) == Any(12));
+
+        // field of other object is resolved again
+        data1.child = &child2;
+        TEST_VERIFY(compiled.Calculate(context1) == Any(13));
+        FormulaExecutor executor1(context1);
+        executor1.Calculate(exp.get());
+        TEST_VERIFY(compiled.GetDependencies() == executor1.GetDependencies());
+
+        // content of containers is not cached
+        data1.map["a"] = 20;
+        TEST_VERIFY(compiled.Calculate(context1) == Any(22));
+
+        TEST_VERIFY(compiled.Calculate(context2) == Any(12));
+        FormulaExecutor executor2(context2);
+        executor2.Calculate(exp.get());
+        TEST_VERIFY(compiled.GetDependencies() == executor2.GetDependencies());
+    }
+
+    // FormulaCompiledExpression::GetDataReference
+    DAVA_TEST (DataReference)
+    {
+        FormulaCompiledExpressionTestData data;
+        std::shared_ptr<FormulaContext> context = CreateContext(&data);
+
+        FormulaCompiledExpression compiled(FormulaParser("array[map.a - 10]").ParseExpression());
+        Reflection ref = compiled.GetDataReference(context);
+        TEST_VERIFY(ref.IsValid());
+        ref.SetValue(Any(55));
+        TEST_VERIFY(data.array[1] == 55);
+
+        std::shared_ptr<FormulaExpression> exp = FormulaParser("intVal + 1").ParseExpression();
+        String expectedError;
+        try
+        {
+            FormulaExecutor(context).GetDataReference(exp.get());
+        }
+        catch (const FormulaException& error)
+        {
+            expectedError = error.GetFormattedMessage();
+        }
+
+        try
+        {
+            FormulaCompiledExpression(exp).GetDataReference(context);
+            TEST_VERIFY(false);
+        }
+        catch (const FormulaException& error)
+        {
+            TEST_VERIFY(error.GetFormattedMessage() == expectedError);
+        }
+    }
+
+    std::shared_ptr<FormulaContext> CreateContext(FormulaCompiledExpressionTestData* data)
+    {
+        return std::make_shared<FormulaReflectionContext>(Reflection::Create(data), std::shared_ptr<FormulaContext>());
+    }
+};
@@ -0,0 +1,250 @@
+#include "DAVAEngine.h"
+
+#include "Reflection/ReflectedTypeDB.h"
+#include "UI/DefaultUIPackageBuilder.h"
+#include "UI/Styles/UIStyleSheet.h"
+#include "UI/Text/UITextComponent.h"
+#include "UI/UIBinaryPackageLoader.h"
+#include "UI/UIControlPackageContext.h"
+#include "UI/UIPackageCompiler.h"
+#include "UI/UIPackageLoader.h"
+#include "UnitTests/UnitTests.h"
+
+using namespace DAVA;
+
+namespace UIPackageCompilerTestDetails
+{
+const FilePath testFolder("~doc:/UIPackageCompilerTest/");
+
+FilePath CopyPackage(const String& name)
+{
+    FilePath path = testFolder + name;
+    FileSystem::Instance()->CopyFile("~res:/UI/" + name, path, true);
+    return path;
+}
+
+bool IsSameControls(UIControl* yamlControl, UIControl* compiledControl)
+{
+    if (yamlControl->GetName() != compiledControl->GetName() ||
+        ReflectedTypeDB::GetByPointer(yamlControl) != ReflectedTypeDB::GetByPointer(compiledControl) ||
+        yamlControl->GetPosition() != compiledControl->GetPosition() ||
+        yamlControl->GetSize() != compiledControl->GetSize() ||
+        yamlControl->GetComponentCount() != compiledControl->GetComponentCount() ||
+        yamlControl->GetChildren().size() != compiledControl->GetChildren().size())
+    {
+        return false;
+    }
+
+    const Vector<UIComponent*>& yamlComponents = yamlControl->GetComponents();
+    const Vector<UIComponent*>& compiledComponents = compiledControl->GetComponents();
+    for (size_t i = 0; i < yamlComponents.size(); ++i)
+    {
+        if (yamlComponents[i]->GetType() != compiledComponents[i]->GetType())
+        {
+            return false;
+        }
+    }
+
+    auto compiledIt = compiledControl->GetChildren().begin();
+    for (const RefPtr<UIControl>& child : yamlControl->GetChildren())
+    {
+        if (!IsSameControls(child.Get(), (compiledIt++)->Get()))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool IsSamePackages(UIPackage* yamlPackage, UIPackage* compiledPackage)
+{
+    const Vector<RefPtr<UIControl>>* yamlLists[] = { &yamlPackage->GetPrototypes(), &yamlPackage->GetControls() };
+    const Vector<RefPtr<UIControl>>* compiledLists[] = { &compiledPackage->GetPrototypes(), &compiledPackage->GetControls() };
+    for (size_t list = 0; list < 2; ++list)
+    {
+        if (yamlLists[list]->size() != compiledLists[list]->size())
+        {
+            return false;
+        }
+        for (size_t i = 0; i < yamlLists[list]->size(); ++i)
+        {
+            if (!IsSameControls((*yamlLists[list])[i].Get(), (*compiledLists[list])[i].Get()))
+            {
+                return false;
+            }
+        }
+    }
+
+    const Vector<UIPriorityStyleSheet>& yamlStyleSheets = yamlPackage->GetControlPackageContext()->GetSortedStyleSheets();
+    const Vector<UIPriorityStyleSheet>& compiledStyleSheets = compiledPackage->GetControlPackageContext()->GetSortedStyleSheets();
+    if (yamlStyleSheets.size() != compiledStyleSheets.size())
+    {
+        return false;
+    }
+    for (size_t i = 0; i < yamlStyleSheets.size(); ++i)
+    {
+        const UIStyleSheet* yamlStyleSheet = yamlStyleSheets[i].GetStyleSheet();
+        const UIStyleSheet* compiledStyleSheet = compiledStyleSheets[i].GetStyleSheet();
+        if (yamlStyleSheet->GetSelectorChain().ToString() != compiledStyleSheet->GetSelectorChain().ToString() ||
+            yamlStyleSheet->GetPropertyTable()->GetProperties().size() != compiledStyleSheet->GetPropertyTable()->GetProperties().size())
+        {
+            return false;
+        }
+    }
+    return true;
+}
+}
+
+DAVA_TESTCLASS (UIPackageCompilerTest)
+{
+    UIPackageCompilerTest()
+    {
+        FileSystem::Instance()->DeleteDirectory(UIPackageCompilerTestDetails::testFolder);
+        FileSystem::Instance()->CreateDirectory(UIPackageCompilerTestDetails::testFolder, true);
+    }
+
+    ~UIPackageCompilerTest()
+    {
+        UIPackageLoader::SetCompiledPackagesEnabled(false);
+        FileSystem::Instance()->DeleteDirectory(UIPackageCompilerTestDetails::testFolder);
+    }
+
+    DAVA_TEST (TestCompiledPackageIsSameAsYaml)
+    {
+        using namespace UIPackageCompilerTestDetails;
+
+        // prototypes, style sheets and legacy properties
+        for (const String& name : { "UIRichContentTest.yaml", "UIStaticTextLegacyTest.yaml", "UITextTest.yaml" })
+        {
+            FilePath packagePath = CopyPackage(name);
+
+            UIPackageCompiler compiler;
+            TEST_VERIFY(compiler.CompilePackage(packagePath));
+            TEST_VERIFY(FileSystem::Instance()->Exists(UIBinaryPackageLoader::GetCompiledPackagePath(packagePath)));
+
+            DefaultUIPackageBuilder yamlBuilder;
+            TEST_VERIFY(UIPackageLoader().LoadPackage(packagePath, &yamlBuilder));
+
+            DefaultUIPackageBuilder compiledBuilder;
+            TEST_VERIFY(UIBinaryPackageLoader().LoadCompiledPackage(packagePath, &compiledBuilder));
+
+            TEST_VERIFY(IsSamePackages(yamlBuilder.GetPackage(), compiledBuilder.GetPackage()));
+        }
+
+        // enum, flags and wide string properties remapped from legacy UIStaticText
+        DefaultUIPackageBuilder compiledBuilder;
+        TEST_VERIFY(UIBinaryPackageLoader().LoadCompiledPackage(testFolder + "UIStaticTextLegacyTest.yaml", &compiledBuilder));
+        UIControl* control = compiledBuilder.GetPackage()->GetControl("UIStaticTextSample");
+        TEST_VERIFY(control != nullptr);
+        UITextComponent* text = control != nullptr ? control->GetComponent<UITextComponent>() : nullptr;
+        TEST_VERIFY(text != nullptr);
+        if (text != nullptr)
+        {
+            TEST_VERIFY(text->GetText() == "Test text");
+            TEST_VERIFY(text->GetColor() == Color(1.f, 0.f, 0.f, 1.f));
+            TEST_VERIFY(text->GetFitting() == UITextComponent::eTextFitting::FITTING_FILL);
+            TEST_VERIFY(text->GetMultiline() == UITextComponent::eTextMultiline::MULTILINE_ENABLED);
+            TEST_VERIFY(text->GetAlign() == (ALIGN_HCENTER | ALIGN_BOTTOM));
+            TEST_VERIFY(text->GetUseRtlAlign() == TextBlock::RTL_USE_BY_CONTENT);
+        }
+    }
+
+    DAVA_TEST (TestCompiledPackageIsUsedByLoader)
+    {
+        using namespace UIPackageCompilerTestDetails;
+
+        FilePath packagePath = CopyPackage("UITextTest.yaml");
+        UIPackageCompiler compiler;
+        TEST_VERIFY(compiler.CompilePackage(packagePath));
+
+        // yaml is not needed if compiled package exists
+        FileSystem::Instance()->DeleteFile(packagePath);
+
+        DefaultUIPackageBuilder disabledBuilder;
+        UIPackageLoader::SetCompiledPackagesEnabled(false);
+        TEST_VERIFY(!UIPackageLoader().LoadPackage(packagePath, &disabledBuilder));
+
+        DefaultUIPackageBuilder enabledBuilder;
+        UIPackageLoader::SetCompiledPackagesEnabled(true);
+        TEST_VERIFY(UIPackageLoader().LoadPackage(packagePath, &enabledBuilder));
+        TEST_VERIFY(enabledBuilder.GetPackage()->GetControl("NewText") != nullptr);
+        UIPackageLoader::SetCompiledPackagesEnabled(false);
+    }
+
+    DAVA_TEST (TestInvalidCompiledPackageIsIgnored)
+    {
+        using namespace UIPackageCompilerTestDetails;
+
+        FilePath packagePath = CopyPackage("UITextTest.yaml");
+        FilePath compiledPath = UIBinaryPackageLoader::GetCompiledPackagePath(packagePath);
+        {
+            ScopedPtr<File> file(File::Create(compiledPath, File::CREATE | File::WRITE));
+            file->WriteString("not a compiled package");
+        }
+
+        DefaultUIPackageBuilder compiledBuilder;
+        TEST_VERIFY(!UIBinaryPackageLoader().LoadCompiledPackage(packagePath, &compiledBuilder));
+        TEST_VERIFY(compiledBuilder.GetPackage() == nullptr);
+
+        // yaml is loaded instead
+        DefaultUIPackageBuilder builder;
+        TEST_VERIFY(UIBinaryPackageLoader().LoadPackage(packagePath, &builder));
+        TEST_VERIFY(builder.GetPackage()->GetControl("NewText") != nullptr);
+    }
+
+    DAVA_TEST (TestTruncatedCompiledPackageIsIgnored)
+    {
+        using namespace UIPackageCompilerTestDetails;
+
+        FilePath packagePath = CopyPackage("UITextTest.yaml");
+        FilePath compiledPath = UIBinaryPackageLoader::GetCompiledPackagePath(packagePath);
+        UIPackageCompiler compiler;
+        TEST_VERIFY(compiler.CompilePackage(packagePath));
+
+        // stream of operations is broken after controls have been started
+        Vector<uint8> data;
+        TEST_VERIFY(FileSystem::Instance()->ReadFileContents(compiledPath, data));
+        {
+            ScopedPtr<File> file(File::Create(compiledPath, File::CREATE | File::WRITE));
+            file->Write(data.data(), static_cast<uint32>(data.size() - 2));
+        }
+
+        DefaultUIPackageBuilder compiledBuilder;
+        TEST_VERIFY(!UIBinaryPackageLoader().LoadCompiledPackage(packagePath, &compiledBuilder));
+        TEST_VERIFY(compiledBuilder.GetPackage() == nullptr);
+
+        // builder is untouched, so fallback to yaml gives complete package
+        DefaultUIPackageBuilder builder;
+        UIPackageLoader::SetCompiledPackagesEnabled(true);
+        TEST_VERIFY(UIPackageLoader().LoadPackage(packagePath, &builder));
+        UIPackageLoader::SetCompiledPackagesEnabled(false);
+        TEST_VERIFY(builder.GetPackage()->GetControl("NewText") != nullptr);
+    }
+
+    DAVA_TEST (TestOutdatedCompiledPackageIsIgnored)
+    {
+        using namespace UIPackageCompilerTestDetails;
+
+        FilePath packagePath = CopyPackage("UITextTest.yaml");
+        UIPackageCompiler compiler;
+        TEST_VERIFY(compiler.CompilePackage(packagePath));
+
+        DefaultUIPackageBuilder compiledBuilder;
+        TEST_VERIFY(UIBinaryPackageLoader().LoadCompiledPackage(packagePath, &compiledBuilder));
+
+        // yaml is edited after compilation
+        String yaml = FileSystem::Instance()->ReadFileContents(packagePath);
+        {
+            ScopedPtr<File> file(File::Create(packagePath, File::CREATE | File::WRITE));
+            file->WriteString(yaml + "\n# edited\n", false);
+        }
+
+        DefaultUIPackageBuilder outdatedBuilder;
+        TEST_VERIFY(!UIBinaryPackageLoader().LoadCompiledPackage(packagePath, &outdatedBuilder));
+        TEST_VERIFY(outdatedBuilder.GetPackage() == nullptr);
+
+        TEST_VERIFY(compiler.CompilePackage(packagePath));
+        DefaultUIPackageBuilder recompiledBuilder;
+        TEST_VERIFY(UIBinaryPackageLoader().LoadCompiledPackage(packagePath, &recompiledBuilder));
+    }
+};
@@ -0,0 +1,234 @@
+#include "DAVAEngine.h"
+#include "UnitTests/UnitTests.h"
+
+#include "Render/2D/Systems/BatchList2D.h"
+#include "UI/Render/UIRenderCacheComponent.h"
+#include "UI/Text/UITextComponent.h"
+#include "UI/UIScrollBar.h"
+
+using namespace DAVA;
+
+namespace UIRenderCacheTestDetails
+{
+// Records all batches drawn by its subtree in frame, including batches replayed from render caches
+class RecordingControl : public UIControl
+{
+public:
+    void Draw(const UIGeometricData& geometricData) override
+    {
+        RenderSystem2D::Instance()->BeginRecording(&batchList);
+        UIControl::Draw(geometricData);
+    }
+
+    void DrawAfterChilds(const UIGeometricData& geometricData) override
+    {
+        UIControl::DrawAfterChilds(geometricData);
+        RenderSystem2D::Instance()->EndRecording();
+        drawCount += 1;
+    }
+
+    BatchList2D batchList;
+    uint32 drawCount = 0;
+};
+
+// Counts live draws, replay of cached batches does not call Draw
+class CountingControl : public UIControl
+{
+public:
+    void Draw(const UIGeometricData& geometricData) override
+    {
+        UIControl::Draw(geometricData);
+        drawCount += 1;
+    }
+
+    uint32 drawCount = 0;
+};
+
+bool IsSameBatches(const BatchList2D& l, const BatchList2D& r)
+{
+    if (l.batches.size() != r.batches.size() || l.vertices != r.vertices || l.indices != r.indices)
+        return false;
+
+    for (size_t i = 0; i < l.batches.size(); ++i)
+    {
+        const BatchList2D::Batch& lb = l.batches[i];
+        const BatchList2D::Batch& rb = r.batches[i];
+        bool same = lb.material == rb.material &&
+        lb.textureSetHandle == rb.textureSetHandle &&
+        lb.primitiveType == rb.primitiveType &&
+        lb.texCoordCount == rb.texCoordCount &&
+        lb.clip == rb.clip &&
+        lb.vertexOffset == rb.vertexOffset &&
+        lb.vertexCount == rb.vertexCount &&
+        lb.indexOffset == rb.indexOffset &&
+        lb.indexCount == rb.indexCount;
+        if (!same)
+            return false;
+    }
+    return true;
+}
+
+template <typename T>
+T* MakeFilledControl(UIControl* parent, const Rect& rect, const Color& color)
+{
+    T* control = new T();
+    control->SetRect(rect);
+    UIControlBackground* bg = control->template GetOrCreateComponent<UIControlBackground>();
+    bg->SetDrawType(UIControlBackground::DRAW_FILL);
+    bg->SetColor(color);
+    parent->AddControl(control);
+    return control;
+}
+}
+
+DAVA_TESTCLASS (UIRenderCacheTest)
+{
+    // screen
+    // |-recorder
+    // | |-cached (UIRenderCacheComponent)
+    // | | |-child1
+    // | | |-child2 (UITextComponent)
+
+    enum eStep
+    {
+        STEP_FIRST_DRAW,
+        STEP_REPLAY,
+        STEP_CHILD_MOVED,
+        STEP_BACKGROUND_CHANGED,
+        STEP_TEXT_CHANGED,
+        STEP_CHILD_HIDDEN,
+        STEP_UNCACHEABLE_ADDED,
+        STEP_UNCACHEABLE_DRAWN_AGAIN,
+        STEP_COUNT
+    };
+
+    UIScreen* screen = nullptr;
+    UIRenderCacheTestDetails::RecordingControl* recorder = nullptr;
+    UIControl* cached = nullptr;
+    UIRenderCacheTestDetails::CountingControl* child1 = nullptr;
+    UIRenderCacheTestDetails::CountingControl* child2 = nullptr;
+    UIScrollBar* scrollBar = nullptr;
+    UIRenderCacheComponent* renderCache = nullptr;
+
+    int32 step = STEP_FIRST_DRAW;
+    uint32 recorderDrawCount = 0;
+    uint32 child1DrawCount = 0;
+    BatchList2D prevBatchList;
+
+    void SetUp(const String& testName) override
+    {
+        using namespace UIRenderCacheTestDetails;
+
+        screen = new UIScreen();
+        recorder = MakeFilledControl<RecordingControl>(screen, Rect(0.f, 0.f, 200.f, 200.f), Color(0.f, 0.f, 0.f, 1.f));
+        cached = MakeFilledControl<UIControl>(recorder, Rect(10.f, 10.f, 150.f, 150.f), Color(1.f, 0.f, 0.f, 1.f));
+        child1 = MakeFilledControl<CountingControl>(cached, Rect(10.f, 10.f, 50.f, 50.f), Color(0.f, 1.f, 0.f, 1.f));
+        child2 = MakeFilledControl<CountingControl>(cached, Rect(70.f, 10.f, 50.f, 50.f), Color(0.f, 0.f, 1.f, 1.f));
+        child2->GetOrCreateComponent<UITextComponent>()->SetText("text");
+        renderCache = cached->GetOrCreateComponent<UIRenderCacheComponent>();
+
+        step = STEP_FIRST_DRAW;
+        recorderDrawCount = 0;
+        child1DrawCount = 0;
+        prevBatchList.Clear();
+
+        GetEngineContext()->uiControlSystem->SetScreen(screen);
+        GetEngineContext()->uiControlSystem->Update();
+    }
+
+    void TearDown(const String& testName) override
+    {
+        GetEngineContext()->uiControlSystem->Reset();
+
+        SafeRelease(scrollBar);
+        SafeRelease(child2);
+        SafeRelease(child1);
+        SafeRelease(cached);
+        SafeRelease(recorder);
+        SafeRelease(screen);
+    }
+
+    bool TestComplete(const String& testName) const override
+    {
+        return step == STEP_COUNT;
+    }
+
+    DAVA_TEST (CachedSubtreeIsReplayedAndRecordedAgainOnChanges)
+    {
+        // All checks are made in Update after each drawn frame
+    }
+
+    void Update(float32 timeElapsed, const String& testName) override
+    {
+        if (step == STEP_COUNT || recorder->drawCount == recorderDrawCount)
+            return; // Wait for next frame to be drawn
+
+        recorderDrawCount = recorder->drawCount;
+        const BatchList2D& batchList = recorder->batchList;
+        const bool child1Drawn = child1->drawCount != child1DrawCount;
+        child1DrawCount = child1->drawCount;
+
+        switch (step)
+        {
+        case STEP_FIRST_DRAW:
+            TEST_VERIFY(child1Drawn);
+            TEST_VERIFY(!renderCache->IsDirty());
+            TEST_VERIFY(!batchList.batches.empty());
+            break;
+
+        case STEP_REPLAY:
+            // Cached subtree is not walked, but draws the same batches as live rendering
+            TEST_VERIFY(!child1Drawn);
+            TEST_VERIFY(UIRenderCacheTestDetails::IsSameBatches(batchList, prevBatchList));
+
+            child1->SetPosition(child1->GetPosition() + Vector2(20.f, 20.f));
+            TEST_VERIFY(renderCache->IsDirty());
+            break;
+
+        case STEP_CHILD_MOVED:
+            TEST_VERIFY(child1Drawn);
+            TEST_VERIFY(!UIRenderCacheTestDetails::IsSameBatches(batchList, prevBatchList));
+
+            child1->GetComponent<UIControlBackground>()->SetColor(Color(1.f, 1.f, 0.f, 1.f));
+            TEST_VERIFY(renderCache->IsDirty());
+            break;
+
+        case STEP_BACKGROUND_CHANGED:
+            TEST_VERIFY(child1Drawn);
+            TEST_VERIFY(!UIRenderCacheTestDetails::IsSameBatches(batchList, prevBatchList));
+
+            // Text changes are applied by UITextSystem during update before next frame
+            child2->GetComponent<UITextComponent>()->SetText("changed text");
+            break;
+
+        case STEP_TEXT_CHANGED:
+            TEST_VERIFY(child1Drawn);
+
+            child2->SetVisibilityFlag(false);
+            TEST_VERIFY(renderCache->IsDirty());
+            break;
+
+        case STEP_CHILD_HIDDEN:
+            TEST_VERIFY(child1Drawn);
+            TEST_VERIFY(batchList.vertices.size() < prevBatchList.vertices.size());
+
+            scrollBar = UIRenderCacheTestDetails::MakeFilledControl<UIScrollBar>(cached, Rect(130.f, 0.f, 10.f, 150.f), Color::White);
+            TEST_VERIFY(renderCache->IsDirty());
+            break;
+
+        case STEP_UNCACHEABLE_ADDED:
+            // Subtree with scroll bar is drawn live, recording is dropped
+            TEST_VERIFY(child1Drawn);
+            TEST_VERIFY(renderCache->IsDirty());
+            break;
+
+        case STEP_UNCACHEABLE_DRAWN_AGAIN:
+            TEST_VERIFY(child1Drawn);
+            TEST_VERIFY(renderCache->IsDirty());
+            break;
+        }
+
+        prevBatchList = batchList;
+        step += 1;
+    }
+};
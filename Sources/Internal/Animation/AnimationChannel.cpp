@@ -9,6 +9,10 @@ uint32 AnimationChannel::Bind(const uint8* _data)
     keysData = nullptr;
     dimension = 0;
     keyStride = keysCount = 0;
+    compression = COMPRESSION_NONE;
+    quantizedTimes = quantizedValues = nullptr;
+    valueOffset = valueScale = blockTimes = nullptr;
+    keysPerBlock = blocksCount = 0;
 
     const uint8* dataptr = _data;
     if (_data != nullptr && *reinterpret_cast<const uint32*>(_data) == ANIMATION_CHANNEL_DATA_SIGNATURE)
@@ -27,6 +31,45 @@ uint32 AnimationChannel::Bind(const uint8* _data)
         keysCount = *reinterpret_cast<const uint32*>(dataptr);
         dataptr += 4;
 
+        if (compression == COMPRESSION_QUANTIZED)
+        {
+            DVASSERT(dimension <= MAX_QUANTIZED_DIMENSION);
+
+            keysPerBlock = *reinterpret_cast<const uint32*>(dataptr);
+            dataptr += 4;
+
+            timeOffset = *reinterpret_cast<const float32*>(dataptr);
+            dataptr += 4;
+
+            timeScale = *reinterpret_cast<const float32*>(dataptr);
+            dataptr += 4;
+
+            valueOffset = reinterpret_cast<const float32*>(dataptr);
+            dataptr += dimension * sizeof(float32);
+
+            valueScale = reinterpret_cast<const float32*>(dataptr);
+            dataptr += dimension * sizeof(float32);
+
+            blocksCount = (keysPerBlock != 0) ? (keysCount + keysPerBlock - 1) / keysPerBlock : 0;
+            blockTimes = reinterpret_cast<const float32*>(dataptr);
+            dataptr += blocksCount * sizeof(float32);
+
+            quantizedTimes = reinterpret_cast<const uint16*>(dataptr);
+            dataptr += keysCount * sizeof(uint16);
+
+            quantizedValues = reinterpret_cast<const uint16*>(dataptr);
+            dataptr += keysCount * dimension * sizeof(uint16);
+
+            //keep next channel aligned by 4 bytes
+            uint32 dataSize = uint32(dataptr - _data);
+            return (dataSize + 3) & ~3u;
+        }
+        else if (compression != COMPRESSION_NONE)
+        {
+            DVASSERT(false, "Unknown animation channel compression");
+            return 0;
+        }
+
         keysData = dataptr;
 
         keyStride = uint32(sizeof(float32)) * (dimension + 1);
@@ -42,50 +85,113 @@ uint32 AnimationChannel::Bind(const uint8* _data)
 #define KEY_DATA(keyIndex) (reinterpret_cast<const float32*>(keysData + (keyIndex)*keyStride + sizeof(float32)))
 #define KEY_META(keyIndex) (KEY_DATA(keyIndex) + KEY_DATA_SIZE) //tangents for bezier interpolation
 
-void AnimationChannel::Evaluate(float32 time, float32* outData, uint32 dataSize) const
+float32 AnimationChannel::GetKeyTime(uint32 key) const
 {
+    DVASSERT(key < keysCount);
+
+    if (compression == COMPRESSION_QUANTIZED)
+        return timeOffset + timeScale * float32(quantizedTimes[key]);
+
+    return KEY_TIME(key);
+}
+
+void AnimationChannel::GetKeyValue(uint32 key, float32* outData, uint32 dataSize) const
+{
+    DVASSERT(key < keysCount);
     DVASSERT(dataSize >= GetDimension());
 
-    uint32 k = startKey;
+    float32 quantizedBuffer[MAX_QUANTIZED_DIMENSION];
+    Memcpy(outData, GetKeyData(key, quantizedBuffer), KEY_DATA_SIZE);
+}
 
-    if (KEY_TIME(k) > time)
+const float32* AnimationChannel::GetKeyData(uint32 key, float32* quantizedBuffer) const
+{
+    if (compression == COMPRESSION_QUANTIZED)
     {
-        k = 0;
+        const uint16* quantized = quantizedValues + key * dimension;
+        for (uint32 d = 0; d < uint32(dimension); ++d)
+            quantizedBuffer[d] = valueOffset[d] + valueScale[d] * float32(quantized[d]);
+
+        return quantizedBuffer;
     }
 
-    for (; k < keysCount; ++k)
+    return KEY_DATA(key);
+}
+
+uint32 AnimationChannel::FindKey(float32 time) const
+{
+    //find first key after `time`. Channel has no search state, since clips are shared
+    //between skeletons and are evaluated from several threads
+    if (compression == COMPRESSION_QUANTIZED)
     {
-        if (KEY_TIME(k) > time)
-            break;
+        //search block by its first key time, then scan keys of found block
+        const float32* block = std::upper_bound(blockTimes, blockTimes + blocksCount, time);
+        if (block == blockTimes)
+            return 0;
+
+        uint32 k = uint32(block - blockTimes - 1) * keysPerBlock;
+        while (k < keysCount && GetKeyTime(k) <= time)
+            ++k;
 
-        startKey = k;
+        return k;
+    }
+
+    uint32 k = 0;
+    uint32 count = keysCount;
+    while (count > 0)
+    {
+        uint32 step = count / 2;
+        if (KEY_TIME(k + step) > time)
+        {
+            count = step;
+        }
+        else
+        {
+            k += step + 1;
+            count -= step + 1;
+        }
     }
 
+    return k;
+}
+
+void AnimationChannel::Evaluate(float32 time, float32* outData, uint32 dataSize) const
+{
+    DVASSERT(dataSize >= GetDimension());
+
+    float32 quantizedBuffer0[MAX_QUANTIZED_DIMENSION];
+    float32 quantizedBuffer1[MAX_QUANTIZED_DIMENSION];
+
+    uint32 k = FindKey(time);
+
     if (k == 0)
     {
-        Memcpy(outData, KEY_DATA(0), KEY_DATA_SIZE);
+        Memcpy(outData, GetKeyData(0, quantizedBuffer0), KEY_DATA_SIZE);
         return;
     }
 
     if (k == keysCount)
     {
-        Memcpy(outData, KEY_DATA(keysCount - 1), KEY_DATA_SIZE);
+        Memcpy(outData, GetKeyData(keysCount - 1, quantizedBuffer0), KEY_DATA_SIZE);
         return;
     }
 
     uint32 k0 = k - 1;
-    float32 time0 = KEY_TIME(k0);
-    float32 time1 = KEY_TIME(k);
+    float32 time0 = GetKeyTime(k0);
+    float32 time1 = GetKeyTime(k);
     float32 t = (time - time0) / (time1 - time0);
 
+    const float32* data0 = GetKeyData(k0, quantizedBuffer0);
+    const float32* data1 = GetKeyData(k, quantizedBuffer1);
+
     switch (interpolation)
     {
     case INTERPOLATION_LINEAR:
     {
         for (uint32 d = 0; d < uint32(dimension); ++d)
         {
-            float32 v0 = *(KEY_DATA(k0) + d);
-            float32 v1 = *(KEY_DATA(k) + d);
+            float32 v0 = *(data0 + d);
+            float32 v1 = *(data1 + d);
             *(outData + d) = Lerp(v0, v1, t);
         }
     }
@@ -95,8 +201,8 @@ void AnimationChannel::Evaluate(float32 time, float32* outData, uint32 dataSize)
     {
         DVASSERT(dimension == 4); //should be quaternion
 
-        Quaternion q0(KEY_DATA(k0));
-        Quaternion q(KEY_DATA(k));
+        Quaternion q0(data0);
+        Quaternion q(data1);
         q.Slerp(q0, q, t);
         q.Normalize();
 
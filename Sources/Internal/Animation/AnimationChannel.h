@@ -8,6 +8,7 @@ class AnimationChannel
 {
 public:
     static const uint32 ANIMATION_CHANNEL_DATA_SIGNATURE = DAVA_MAKEFOURCC('D', 'V', 'A', 'C');
+    static const uint32 MAX_QUANTIZED_DIMENSION = 4;
 
     enum eInterpolation : uint8
     {
@@ -18,25 +19,67 @@ public:
         INTERPOLATION_COUNT
     };
 
+    enum eCompression : uint16
+    {
+        COMPRESSION_NONE = 0, //raw float32 keys
+        COMPRESSION_QUANTIZED, //16-bit quantized keys split into blocks, see 'AnimationBinaryFormat.md'
+
+        COMPRESSION_COUNT
+    };
+
     AnimationChannel() = default;
 
     uint32 Bind(const uint8* data);
     void Evaluate(float32 time, float32* outData, uint32 dataSize) const;
 
     uint32 GetDimension() const;
+    eInterpolation GetInterpolation() const;
+    eCompression GetCompression() const;
+
+    uint32 GetKeysCount() const;
+    float32 GetKeyTime(uint32 key) const;
+    void GetKeyValue(uint32 key, float32* outData, uint32 dataSize) const;
 
 private:
+    uint32 FindKey(float32 time) const;
+    const float32* GetKeyData(uint32 key, float32* quantizedBuffer) const;
+
     const DAVA::uint8* keysData = nullptr;
-    mutable uint32 startKey = 0;
     uint32 keysCount = 0;
     uint32 keyStride = 0;
     uint16 compression = 0;
     uint8 dimension = 0;
     eInterpolation interpolation = INTERPOLATION_COUNT;
+
+    //quantized keys: value = offset + scale * quantized
+    const uint16* quantizedTimes = nullptr;
+    const uint16* quantizedValues = nullptr;
+    const float32* valueOffset = nullptr;
+    const float32* valueScale = nullptr;
+    const float32* blockTimes = nullptr;
+    float32 timeOffset = 0.f;
+    float32 timeScale = 0.f;
+    uint32 keysPerBlock = 0;
+    uint32 blocksCount = 0;
 };
 
 inline uint32 AnimationChannel::GetDimension() const
 {
     return uint32(dimension);
 }
-}
\ No newline at end of file
+
+inline AnimationChannel::eInterpolation AnimationChannel::GetInterpolation() const
+{
+    return interpolation;
+}
+
+inline AnimationChannel::eCompression AnimationChannel::GetCompression() const
+{
+    return eCompression(compression);
+}
+
+inline uint32 AnimationChannel::GetKeysCount() const
+{
+    return keysCount;
+}
+}
@@ -57,7 +57,7 @@ AnimationClip* AnimationClip::Load(const FilePath& fileName)
         FileHeader header;
         file->Read(&header);
 
-        if (header.signature == ANIMATION_CLIP_FILE_SIGNATURE && header.version == 1)
+        if (header.signature == ANIMATION_CLIP_FILE_SIGNATURE && header.version >= 1 && header.version <= ANIMATION_CLIP_FILE_VERSION)
         {
             clip = new AnimationClip();
             clip->filepath = fileName;
@@ -68,6 +68,7 @@ AnimationClip* AnimationClip::Load(const FilePath& fileName)
             if (read != header.dataSize || CRC32::ForBuffer(dataBuff, header.dataSize) == header.crc32)
             {
                 clip->animationData = dataBuff;
+                clip->animationDataSize = header.dataSize;
 
                 clip->duration = *reinterpret_cast<float32*>(dataBuff);
                 dataBuff += 4;
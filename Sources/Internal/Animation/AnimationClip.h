@@ -14,6 +14,7 @@ class AnimationClip : public BaseObject
 {
 public:
     static const uint32 ANIMATION_CLIP_FILE_SIGNATURE = DAVA_MAKEFOURCC('D', 'V', 'A', 'F');
+    static const uint32 ANIMATION_CLIP_FILE_VERSION = 2; //version 2 allows compressed channels
 
     struct FileHeader
     {
@@ -28,6 +29,7 @@ public:
     static AnimationClip* Load(const FilePath& fileName);
 
     float32 GetDuration() const;
+    uint32 GetDataSize() const;
 
     uint32 GetTrackCount() const;
     const AnimationTrack* GetTrack(uint32 track) const;
@@ -66,6 +68,7 @@ private:
 
     float32 duration = 0.f;
     uint8* animationData = nullptr;
+    uint32 animationDataSize = 0;
 };
 
 inline float32 AnimationClip::GetDuration() const
@@ -73,6 +76,11 @@ inline float32 AnimationClip::GetDuration() const
     return duration;
 }
 
+inline uint32 AnimationClip::GetDataSize() const
+{
+    return animationDataSize;
+}
+
 inline unsigned AnimationClip::GetTrackCount() const
 {
     return uint32(nodes.size());
@@ -0,0 +1,456 @@
+#include "AnimationClipCompressor.h"
+#include "AnimationClip.h"
+#include "AnimationTrack.h"
+
+#include "Base/BaseMath.h"
+#include "Base/ScopedPtr.h"
+#include "FileSystem/File.h"
+#include "Logger/Logger.h"
+#include "Utils/CRC32.h"
+
+namespace DAVA
+{
+namespace AnimationClipCompressorDetails
+{
+const uint32 QUANTIZED_MAX = 0xffff;
+
+template <class T>
+void WriteToBuffer(Vector<uint8>* buffer, const T* value, uint32 count = 1)
+{
+    const uint8* bytes = reinterpret_cast<const uint8*>(value);
+    buffer->insert(buffer->end(), bytes, bytes + sizeof(T) * count);
+}
+
+void AlignBuffer(Vector<uint8>* buffer)
+{
+    //as animation data is loaded directly to memory and used without any processing we have to keep it aligned
+    buffer->resize((buffer->size() + 3) & ~size_t(3), 0);
+}
+
+void WriteToBuffer(Vector<uint8>* buffer, const char* string)
+{
+    WriteToBuffer(buffer, string, uint32(strlen(string) + 1));
+    AlignBuffer(buffer);
+}
+
+uint16 Quantize(float32 value, float32 offset, float32 scale)
+{
+    if (scale <= 0.f)
+        return 0;
+
+    float32 quantized = std::round((value - offset) / scale);
+    return uint16(Clamp(quantized, 0.f, float32(QUANTIZED_MAX)));
+}
+
+struct QuantizedKey
+{
+    uint32 sourceKey = 0;
+    uint16 time = 0;
+    uint16 value[AnimationChannel::MAX_QUANTIZED_DIMENSION] = {};
+};
+
+struct QuantizedChannel
+{
+    uint32 dimension = 0;
+    AnimationChannel::eInterpolation interpolation = AnimationChannel::INTERPOLATION_LINEAR;
+
+    float32 timeOffset = 0.f;
+    float32 timeScale = 0.f;
+    float32 valueOffset[AnimationChannel::MAX_QUANTIZED_DIMENSION] = {};
+    float32 valueScale[AnimationChannel::MAX_QUANTIZED_DIMENSION] = {};
+
+    //should match AnimationChannel::GetKeyTime and AnimationChannel::GetKeyData
+    float32 GetTime(const QuantizedKey& key) const
+    {
+        return timeOffset + timeScale * float32(key.time);
+    }
+
+    void GetValue(const QuantizedKey& key, float32* outValue) const
+    {
+        for (uint32 d = 0; d < dimension; ++d)
+            outValue[d] = valueOffset[d] + valueScale[d] * float32(key.value[d]);
+    }
+};
+
+//should match AnimationChannel::Evaluate
+void Interpolate(const QuantizedChannel& channel, const float32* value0, const float32* value1, float32 t, float32* outValue)
+{
+    if (channel.interpolation == AnimationChannel::INTERPOLATION_SPHERICAL_LINEAR)
+    {
+        Quaternion q0(value0);
+        Quaternion q(value1);
+        q.Slerp(q0, q, t);
+        q.Normalize();
+
+        Memcpy(outValue, q.data, 4 * sizeof(float32));
+    }
+    else
+    {
+        for (uint32 d = 0; d < channel.dimension; ++d)
+            outValue[d] = Lerp(value0[d], value1[d], t);
+    }
+}
+
+float32 GetError(const QuantizedChannel& channel, const float32* value, const float32* reference)
+{
+    if (channel.interpolation == AnimationChannel::INTERPOLATION_SPHERICAL_LINEAR)
+    {
+        //rotation angle between orientations. Chord between unit quaternions is 2*sin(angle/4),
+        //unlike acos of their dot product it is precise for small angles
+        Quaternion q0(value);
+        Quaternion q1(reference);
+        q0.Normalize();
+        q1.Normalize();
+
+        float32 sign = (q0.DotProduct(q1) < 0.f) ? -1.f : 1.f;
+        float32 chord = 0.f;
+        for (uint32 d = 0; d < 4; ++d)
+            chord += (q0.data[d] - sign * q1.data[d]) * (q0.data[d] - sign * q1.data[d]);
+
+        return 4.f * std::asin(Min(0.5f * std::sqrt(chord), 1.f));
+    }
+
+    float32 error = 0.f;
+    for (uint32 d = 0; d < channel.dimension; ++d)
+        error = Max(error, std::abs(value[d] - reference[d]));
+
+    return error;
+}
+
+class ChannelCompressor
+{
+public:
+    ChannelCompressor(const AnimationChannel& channel, float32 tolerance);
+
+    bool Compress(uint32 keysPerBlock, Vector<uint8>* outData);
+    uint32 GetCompressedKeysCount() const;
+
+private:
+    void ReadSourceKeys();
+    void QuantizeKeys();
+    void ReduceKeys();
+    bool IsWithinTolerance(const QuantizedKey& key0, const QuantizedKey& key1, uint32 sourceKeyBegin, uint32 sourceKeyEnd) const;
+
+    const AnimationChannel& source;
+    float32 tolerance = 0.f;
+
+    Vector<float32> sourceTimes;
+    Vector<float32> sourceValues;
+
+    QuantizedChannel quantized;
+    Vector<QuantizedKey> keys;
+};
+
+ChannelCompressor::ChannelCompressor(const AnimationChannel& channel, float32 tolerance_)
+    : source(channel)
+    , tolerance(tolerance_)
+{
+    quantized.dimension = channel.GetDimension();
+    quantized.interpolation = channel.GetInterpolation();
+}
+
+bool ChannelCompressor::Compress(uint32 keysPerBlock, Vector<uint8>* outData)
+{
+    if (quantized.interpolation != AnimationChannel::INTERPOLATION_LINEAR && quantized.interpolation != AnimationChannel::INTERPOLATION_SPHERICAL_LINEAR)
+    {
+        Logger::Error("[AnimationClipCompressor] Unsupported channel interpolation %u", uint32(quantized.interpolation));
+        return false;
+    }
+
+    if (quantized.dimension == 0 || quantized.dimension > AnimationChannel::MAX_QUANTIZED_DIMENSION)
+    {
+        Logger::Error("[AnimationClipCompressor] Unsupported channel dimension %u", quantized.dimension);
+        return false;
+    }
+
+    ReadSourceKeys();
+    QuantizeKeys();
+    ReduceKeys();
+
+    //binary layout described in 'AnimationBinaryFormat.md'
+    uint32 signature = AnimationChannel::ANIMATION_CHANNEL_DATA_SIGNATURE;
+    uint8 dimension = uint8(quantized.dimension);
+    uint8 interpolation = uint8(quantized.interpolation);
+    uint16 compression = uint16(AnimationChannel::COMPRESSION_QUANTIZED);
+    uint32 keysCount = uint32(keys.size());
+
+    WriteToBuffer(outData, &signature);
+    WriteToBuffer(outData, &dimension);
+    WriteToBuffer(outData, &interpolation);
+    WriteToBuffer(outData, &compression);
+    WriteToBuffer(outData, &keysCount);
+    WriteToBuffer(outData, &keysPerBlock);
+    WriteToBuffer(outData, &quantized.timeOffset);
+    WriteToBuffer(outData, &quantized.timeScale);
+    WriteToBuffer(outData, quantized.valueOffset, quantized.dimension);
+    WriteToBuffer(outData, quantized.valueScale, quantized.dimension);
+
+    for (uint32 k = 0; k < keysCount; k += keysPerBlock)
+    {
+        float32 blockTime = quantized.GetTime(keys[k]);
+        WriteToBuffer(outData, &blockTime);
+    }
+
+    for (const QuantizedKey& key : keys)
+        WriteToBuffer(outData, &key.time);
+
+    for (const QuantizedKey& key : keys)
+        WriteToBuffer(outData, key.value, quantized.dimension);
+
+    AlignBuffer(outData);
+
+    return true;
+}
+
+uint32 ChannelCompressor::GetCompressedKeysCount() const
+{
+    return uint32(keys.size());
+}
+
+void ChannelCompressor::ReadSourceKeys()
+{
+    uint32 dimension = quantized.dimension;
+    uint32 keysCount = source.GetKeysCount();
+
+    sourceTimes.resize(keysCount);
+    sourceValues.resize(keysCount * dimension);
+    for (uint32 k = 0; k < keysCount; ++k)
+    {
+        float32* value = sourceValues.data() + k * dimension;
+        sourceTimes[k] = source.GetKeyTime(k);
+        source.GetKeyValue(k, value, dimension);
+
+        //keep quaternions in one hemisphere: it narrows quantization range and doesn't change slerp result
+        if (quantized.interpolation == AnimationChannel::INTERPOLATION_SPHERICAL_LINEAR && k > 0)
+        {
+            Quaternion prev(value - dimension);
+            Quaternion current(value);
+            if (prev.DotProduct(current) < 0.f)
+            {
+                for (uint32 d = 0; d < dimension; ++d)
+                    value[d] = -value[d];
+            }
+        }
+    }
+}
+
+void ChannelCompressor::QuantizeKeys()
+{
+    uint32 dimension = quantized.dimension;
+    uint32 keysCount = uint32(sourceTimes.size());
+    if (keysCount == 0)
+        return;
+
+    quantized.timeOffset = sourceTimes.front();
+    quantized.timeScale = (sourceTimes.back() - sourceTimes.front()) / float32(QUANTIZED_MAX);
+
+    for (uint32 d = 0; d < dimension; ++d)
+    {
+        float32 minValue = sourceValues[d];
+        float32 maxValue = sourceValues[d];
+        for (uint32 k = 1; k < keysCount; ++k)
+        {
+            minValue = Min(minValue, sourceValues[k * dimension + d]);
+            maxValue = Max(maxValue, sourceValues[k * dimension + d]);
+        }
+
+        quantized.valueOffset[d] = minValue;
+        quantized.valueScale[d] = (maxValue - minValue) / float32(QUANTIZED_MAX);
+    }
+
+    keys.reserve(keysCount);
+    for (uint32 k = 0; k < keysCount; ++k)
+    {
+        QuantizedKey key;
+        key.sourceKey = k;
+        key.time = Quantize(sourceTimes[k], quantized.timeOffset, quantized.timeScale);
+        for (uint32 d = 0; d < dimension; ++d)
+            key.value[d] = Quantize(sourceValues[k * dimension + d], quantized.valueOffset[d], quantized.valueScale[d]);
+
+        //keys too close in time collapse into the latest one
+        if (!keys.empty() && keys.back().time == key.time)
+            keys.back() = key;
+        else
+            keys.push_back(key);
+    }
+}
+
+void ChannelCompressor::ReduceKeys()
+{
+    uint32 sourceKeysCount = uint32(sourceTimes.size());
+    if (keys.size() < 2)
+        return;
+
+    //constant channel: keep single key
+    if (IsWithinTolerance(keys.front(), keys.front(), 0, sourceKeysCount))
+    {
+        keys.resize(1);
+        return;
+    }
+
+    //greedy: extend segment from last kept key while interpolation reproduces all source keys inside it
+    Vector<QuantizedKey> reduced;
+    reduced.push_back(keys.front());
+
+    for (size_t k = 2; k < keys.size(); ++k)
+    {
+        const QuantizedKey& anchor = reduced.back();
+        if (!IsWithinTolerance(anchor, keys[k], anchor.sourceKey + 1, keys[k].sourceKey))
+            reduced.push_back(keys[k - 1]);
+    }
+
+    reduced.push_back(keys.back());
+    keys.swap(reduced);
+}
+
+bool ChannelCompressor::IsWithinTolerance(const QuantizedKey& key0, const QuantizedKey& key1, uint32 sourceKeyBegin, uint32 sourceKeyEnd) const
+{
+    uint32 dimension = quantized.dimension;
+
+    float32 value0[AnimationChannel::MAX_QUANTIZED_DIMENSION];
+    float32 value1[AnimationChannel::MAX_QUANTIZED_DIMENSION];
+    float32 value[AnimationChannel::MAX_QUANTIZED_DIMENSION];
+
+    quantized.GetValue(key0, value0);
+    quantized.GetValue(key1, value1);
+
+    float32 time0 = quantized.GetTime(key0);
+    float32 time1 = quantized.GetTime(key1);
+
+    for (uint32 s = sourceKeyBegin; s < sourceKeyEnd; ++s)
+    {
+        float32 t = (time1 > time0) ? Clamp((sourceTimes[s] - time0) / (time1 - time0), 0.f, 1.f) : 0.f;
+        Interpolate(quantized, value0, value1, t, value);
+
+        if (GetError(quantized, value, sourceValues.data() + s * dimension) > tolerance)
+            return false;
+    }
+
+    return true;
+}
+
+float32 GetTolerance(AnimationTrack::eChannelTarget target, const AnimationClipCompressor::Settings& settings)
+{
+    switch (target)
+    {
+    case AnimationTrack::CHANNEL_TARGET_POSITION:
+        return settings.positionTolerance;
+    case AnimationTrack::CHANNEL_TARGET_ORIENTATION:
+        return settings.orientationTolerance;
+    case AnimationTrack::CHANNEL_TARGET_SCALE:
+        return settings.scaleTolerance;
+    default:
+        return 0.f;
+    }
+}
+}
+
+bool AnimationClipCompressor::Compress(const AnimationClip* clip, const Settings& settings, Vector<uint8>* outData, Stats* outStats)
+{
+    using namespace AnimationClipCompressorDetails;
+
+    DVASSERT(clip != nullptr && outData != nullptr);
+
+    Stats stats;
+    stats.sourceDataSize = clip->GetDataSize();
+
+    uint32 keysPerBlock = Max(settings.keysPerBlock, 1u);
+
+    //binary file format described in 'AnimationBinaryFormat.md'
+    outData->clear();
+
+    float32 duration = clip->GetDuration();
+    WriteToBuffer(outData, &duration);
+
+    uint32 tracksCount = clip->GetTrackCount();
+    WriteToBuffer(outData, &tracksCount);
+
+    for (uint32 t = 0; t < tracksCount; ++t)
+    {
+        WriteToBuffer(outData, clip->GetTrackUID(t));
+        WriteToBuffer(outData, clip->GetTrackName(t));
+
+        const AnimationTrack* track = clip->GetTrack(t);
+
+        uint32 signature = AnimationTrack::ANIMATION_TRACK_DATA_SIGNATURE;
+        WriteToBuffer(outData, &signature);
+
+        uint32 channelsCount = track->GetChannelsCount();
+        WriteToBuffer(outData, &channelsCount);
+
+        for (uint32 c = 0; c < channelsCount; ++c)
+        {
+            AnimationTrack::eChannelTarget target = track->GetChannelTarget(c);
+            uint8 targetPad[4] = { uint8(target), 0, 0, 0 };
+            WriteToBuffer(outData, targetPad, 4);
+
+            const AnimationChannel& channel = track->GetChannel(c);
+            ChannelCompressor compressor(channel, GetTolerance(target, settings));
+            if (!compressor.Compress(keysPerBlock, outData))
+            {
+                Logger::Error("[AnimationClipCompressor] Failed to compress channel#%u of track '%s'", c, clip->GetTrackName(t));
+                outData->clear();
+                return false;
+            }
+
+            stats.sourceKeysCount += channel.GetKeysCount();
+            stats.compressedKeysCount += compressor.GetCompressedKeysCount();
+        }
+    }
+
+    uint32 markersCount = clip->GetMarkerCount();
+    WriteToBuffer(outData, &markersCount);
+
+    for (uint32 m = 0; m < markersCount; ++m)
+    {
+        WriteToBuffer(outData, clip->GetMarkerName(m));
+
+        float32 markerTime = clip->GetMarkerTime(m);
+        WriteToBuffer(outData, &markerTime);
+    }
+
+    stats.compressedDataSize = uint32(outData->size());
+    if (outStats != nullptr)
+        *outStats = stats;
+
+    return true;
+}
+
+bool AnimationClipCompressor::Compress(const FilePath& sourceFile, const FilePath& compressedFile, const Settings& settings, Stats* outStats)
+{
+    ScopedPtr<AnimationClip> clip(AnimationClip::Load(sourceFile));
+    if (!clip)
+        return false;
+
+    Vector<uint8> animationData;
+    if (!Compress(clip, settings, &animationData, outStats))
+        return false;
+
+    ScopedPtr<File> file(File::Create(compressedFile, File::CREATE | File::WRITE));
+    if (!file)
+    {
+        Logger::Error("[AnimationClipCompressor] Failed to open file for writing: %s", compressedFile.GetAbsolutePathname().c_str());
+        return false;
+    }
+
+    uint32 animationDataSize = uint32(animationData.size());
+
+    AnimationClip::FileHeader header;
+    header.signature = AnimationClip::ANIMATION_CLIP_FILE_SIGNATURE;
+    header.version = AnimationClip::ANIMATION_CLIP_FILE_VERSION;
+    header.crc32 = CRC32::ForBuffer(animationData.data(), animationDataSize);
+    header.dataSize = animationDataSize;
+
+    bool written = (file->Write(&header) == sizeof(header));
+    written = written && (file->Write(animationData.data(), animationDataSize) == animationDataSize);
+    file->Flush();
+
+    if (!written)
+    {
+        Logger::Error("[AnimationClipCompressor] Failed to write file: %s", compressedFile.GetAbsolutePathname().c_str());
+        return false;
+    }
+
+    return true;
+}
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+#include "Base/BaseTypes.h"
+
+namespace DAVA
+{
+class AnimationClip;
+class FilePath;
+
+/**
+    Offline converter of animation clips into compressed channels format (see 'AnimationBinaryFormat.md').
+    Keys of every channel are quantized to 16 bits relatively to channel range and redundant keys are removed
+    while interpolation of remaining keys stays within channel tolerance. Bezier channels are not supported.
+*/
+class AnimationClipCompressor
+{
+public:
+    struct Settings
+    {
+        float32 positionTolerance = 0.001f; //max distance in units
+        float32 orientationTolerance = 0.001f; //max angle in radians
+        float32 scaleTolerance = 0.0001f;
+        uint32 keysPerBlock = 16; //keys in seek block
+    };
+
+    struct Stats
+    {
+        uint32 sourceDataSize = 0;
+        uint32 compressedDataSize = 0;
+        uint32 sourceKeysCount = 0;
+        uint32 compressedKeysCount = 0;
+    };
+
+    /** Write compressed clip data (without file header) to `outData`. */
+    static bool Compress(const AnimationClip* clip, const Settings& settings, Vector<uint8>* outData, Stats* outStats = nullptr);
+
+    /** Load clip from `sourceFile` and save it compressed to `compressedFile`. */
+    static bool Compress(const FilePath& sourceFile, const FilePath& compressedFile, const Settings& settings, Stats* outStats = nullptr);
+};
+}
@@ -58,6 +58,12 @@ AnimationTrack::eChannelTarget AnimationTrack::GetChannelTarget(uint32 channel)
     return channels[channel].target;
 }
 
+const AnimationChannel& AnimationTrack::GetChannel(uint32 channel) const
+{
+    DVASSERT(channel < GetChannelsCount());
+    return channels[channel].channel;
+}
+
 uint32 AnimationTrack::GetChannelValueSize(uint32 channel) const
 {
     DVASSERT(channel < GetChannelsCount());
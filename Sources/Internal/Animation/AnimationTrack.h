@@ -23,6 +23,7 @@ public:
 
     uint32 GetChannelsCount() const;
     eChannelTarget GetChannelTarget(uint32 channel) const;
+    const AnimationChannel& GetChannel(uint32 channel) const;
 
     uint32 GetChannelValueSize(uint32 channel) const;
     uint32 GetMaxChannelValueSize() const;
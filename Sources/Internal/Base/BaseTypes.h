@@ -242,4 +242,4 @@ enum class eErrorCode
 #define DAVA_FORWARD_DECLARE_OBJC_CLASS(classname) typedef struct objc_object classname
 #endif
 
-#define DAVA_MAKEFOURCC(ch0, ch1, ch2, ch3) (static_cast<uint32>(static_cast<uint8>(ch0)) | (static_cast<uint32>(static_cast<uint8>(ch1)) << 8) | (static_cast<uint32>(static_cast<uint8>(ch2)) << 16) | (static_cast<uint32>(static_cast<uint8>(ch3)) << 24))
\ No newline at end of file
+#define DAVA_MAKEFOURCC(ch0, ch1, ch2, ch3) (static_cast<DAVA::uint32>(static_cast<DAVA::uint8>(ch0)) | (static_cast<DAVA::uint32>(static_cast<DAVA::uint8>(ch1)) << 8) | (static_cast<DAVA::uint32>(static_cast<DAVA::uint8>(ch2)) << 16) | (static_cast<DAVA::uint32>(static_cast<DAVA::uint8>(ch3)) << 24))
\ No newline at end of file
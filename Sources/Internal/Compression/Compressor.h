@@ -20,6 +20,8 @@ public:
     virtual bool Compress(const Vector<uint8>& in, Vector<uint8>& out) const = 0;
     // you should resize output to correct size before call this method
     virtual bool Decompress(const Vector<uint8>& in, Vector<uint8>& out) const = 0;
+    // same as above but takes input from raw memory (e.g. memory mapped file) without copying it into Vector
+    virtual bool Decompress(const uint8* in, uint32 inSize, Vector<uint8>& out) const;
 };
 
 } // end namespace DAVA
@@ -8,6 +8,11 @@ namespace DAVA
 {
 Compressor::~Compressor() = default; // only one virtual table(fix warning)
 
+bool Compressor::Decompress(const uint8* in, uint32 inSize, Vector<uint8>& out) const
+{
+    return Decompress(Vector<uint8>(in, in + inSize), out);
+}
+
 bool LZ4Compressor::Compress(const Vector<uint8>& in, Vector<uint8>& out) const
 {
     if (in.size() > LZ4_MAX_INPUT_SIZE)
@@ -40,6 +45,19 @@ bool LZ4Compressor::Decompress(const Vector<uint8>& in, Vector<uint8>& out) cons
     return true;
 }
 
+bool LZ4Compressor::Decompress(const uint8* in, uint32 inSize, Vector<uint8>& out) const
+{
+    // input is bounded by `inSize` so corrupted data can't make decoder read outside of (possibly mapped) buffer
+    int32 decompressResult = LZ4_decompress_safe(reinterpret_cast<const char*>(in), reinterpret_cast<char*>(out.data()), static_cast<int32>(inSize), static_cast<int32>(out.size()));
+    // short result of corrupted data would leave the tail of `out` uninitialized
+    if (decompressResult < 0 || static_cast<uint32>(decompressResult) != out.size())
+    {
+        Logger::Error("LZ4 decompress failed");
+        return false;
+    }
+    return true;
+}
+
 bool LZ4HCCompressor::Compress(const Vector<uint8>& in, Vector<uint8>& out) const
 {
     if (in.size() > LZ4_MAX_INPUT_SIZE)
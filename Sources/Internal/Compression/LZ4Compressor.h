@@ -10,6 +10,7 @@ public:
     bool Compress(const Vector<uint8>& in, Vector<uint8>& out) const override;
     // you should resize output to correct size before call this method
     bool Decompress(const Vector<uint8>& in, Vector<uint8>& out) const override;
+    bool Decompress(const uint8* in, uint32 inSize, Vector<uint8>& out) const override;
 };
 
 class LZ4HCCompressor final : public LZ4Compressor
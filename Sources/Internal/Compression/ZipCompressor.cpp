@@ -64,8 +64,13 @@ bool ZipCompressor::Decompress(const Vector<uint8>& in, Vector<uint8>& out) cons
         Logger::Error("too big input buffer for uncompress rfc1951");
         return false;
     }
+    return Decompress(in.data(), static_cast<uint32>(in.size()), out);
+}
+
+bool ZipCompressor::Decompress(const uint8* in, uint32 inSize, Vector<uint8>& out) const
+{
     uLong uncompressedSize = static_cast<uLong>(out.size());
-    int32 decompressResult = uncompress(out.data(), &uncompressedSize, in.data(), static_cast<uLong>(in.size()));
+    int32 decompressResult = uncompress(out.data(), &uncompressedSize, in, static_cast<uLong>(inSize));
     if (decompressResult != Z_OK)
     {
         Logger::Error("can't uncompress rfc1951 buffer");
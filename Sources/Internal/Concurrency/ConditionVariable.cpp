@@ -5,6 +5,11 @@
 #include "Concurrency/ConditionVariable.h"
 #include "Debug/DVAssert.h"
 
+#ifndef __DAVAENGINE_WINDOWS__
+#include <errno.h>
+#include <sys/time.h>
+#endif
+
 namespace DAVA
 {
 //-------------------------------------------------------------------------------------------------
@@ -39,6 +44,40 @@ void ConditionVariable::Wait(UniqueLock<Mutex>& guard)
     }
 }
 
+bool ConditionVariable::WaitFor(UniqueLock<Mutex>& guard, uint32 timeoutMs)
+{
+    pthread_mutex_t* mutex = &guard.GetMutex()->mutex;
+
+#ifdef __DAVAENGINE_WINDOWS__
+    BOOL res = SleepConditionVariableCS(&cv, &mutex->critical_section, timeoutMs);
+    int ret = res != 0 ? 0 : GetLastError();
+    if (ret == ERROR_TIMEOUT)
+    {
+        return false;
+    }
+#else
+    timeval now;
+    gettimeofday(&now, nullptr);
+
+    uint64 nsec = static_cast<uint64>(now.tv_usec) * 1000 + static_cast<uint64>(timeoutMs % 1000) * 1000000;
+    timespec deadline;
+    deadline.tv_sec = now.tv_sec + timeoutMs / 1000 + static_cast<time_t>(nsec / 1000000000);
+    deadline.tv_nsec = static_cast<long>(nsec % 1000000000);
+
+    int ret = pthread_cond_timedwait(&cv, mutex, &deadline);
+    if (ret == ETIMEDOUT)
+    {
+        return false;
+    }
+#endif
+
+    if (ret != 0)
+    {
+        Logger::Error("ConditionVariable::WaitFor() error: %d", ret);
+    }
+    return true;
+}
+
 void ConditionVariable::NotifyOne()
 {
     int ret = pthread_cond_signal(&cv);
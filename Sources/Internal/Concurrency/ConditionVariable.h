@@ -34,6 +34,9 @@ public:
     void Wait(Mutex& mutex, Predicate pred);
     void Wait(Mutex& mutex);
 
+    //returns false if timeout is expired before notification, spurious wakeups are possible as with Wait
+    bool WaitFor(UniqueLock<Mutex>& guard, uint32 timeoutMs);
+
     void NotifyOne();
     void NotifyAll();
 
@@ -91,6 +94,16 @@ inline void ConditionVariable::Wait(UniqueLock<Mutex>& guard)
     lock.release();
 }
 
+inline bool ConditionVariable::WaitFor(UniqueLock<Mutex>& guard, uint32 timeoutMs)
+{
+    DVASSERT(guard.OwnsLock(), "Mutex must be locked and UniqueLock must own it");
+
+    std::unique_lock<std::mutex> lock(guard.GetMutex()->mutex, std::adopt_lock_t());
+    std::cv_status status = cv.wait_for(lock, std::chrono::milliseconds(timeoutMs));
+    lock.release();
+    return status == std::cv_status::no_timeout;
+}
+
 inline void ConditionVariable::NotifyOne()
 {
     cv.notify_one();
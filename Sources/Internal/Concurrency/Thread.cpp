@@ -2,6 +2,7 @@
 #include "Concurrency/Thread.h"
 #include "Concurrency/LockGuard.h"
 #include "Logger/Logger.h"
+#include "MemoryManager/MemoryProfiler.h"
 
 #ifndef __DAVAENGINE_WINDOWS__
 #include <time.h>
@@ -148,6 +149,8 @@ void Thread::ThreadFunction(void* param)
     // as system can reuse thread ids.
     std::memset(&t->id, 0, sizeof(t->id));
     t->state = STATE_ENDED;
+
+    DAVA_MEMORY_PROFILER_THREAD_EXIT();
 }
 
 void Thread::Yield()
@@ -43,6 +43,19 @@ void PackRequest::CancelCurrentDownloadRequests()
 
     DLCDownloader& downloader = packManager->GetDownloader();
 
+    for (BatchRequest& batch : batches)
+    {
+        downloader.RemoveTask(batch.task);
+        for (size_t requestIndex : batch.fileRequests)
+        {
+            FileRequest& r = requests[requestIndex];
+            r.batched = false;
+            r.dvplWriter.reset();
+            r.status = CheckLocalFile;
+        }
+    }
+    batches.clear();
+
     for (FileRequest& r : requests)
     {
         if (r.task != nullptr)
@@ -209,6 +222,8 @@ void PackRequest::Finalize()
     totalDownloadedSize = GetDownloadedSize();
     requests.clear();
     requests.shrink_to_fit();
+    batches.clear();
+    batches.shrink_to_fit();
 }
 
 void PackRequest::SetFileIndexes(Vector<uint32> fileIndexes_)
@@ -389,29 +404,7 @@ bool PackRequest::CheckLoadingStatusOfFileRequest(FileRequest& fileRequest, DLCD
 
             if (status.error.errorHappened)
             {
-                // log same error only once, stop spam
-                if (prevTaskError != status.error)
-                {
-                    packManager->GetLog() << "file_request failed: can't download file: " << dstPath << " status: " << status << std::endl;
-                    prevTaskError = status.error;
-                }
-
-                if (status.error.curlErr != 0
-                    || status.error.curlMErr != 0
-                    || status.error.httpCode >= 400)
-                {
-                    packManager->FireNetworkReady(false);
-                }
-
-                if (status.error.fileErrno != 0 && status.error.httpCode < 400)
-                {
-                    bool fireSignal = packManager->CountError(status.error.fileErrno);
-                    if (fireSignal)
-                    {
-                        String pathname = fileRequest.localFile.GetAbsolutePathname();
-                        packManager->error.Emit(DLCManager::ErrorOrigin::FileIO, status.error.fileErrno, pathname);
-                    }
-                }
+                OnTaskError(status, fileRequest.localFile);
 
                 fileRequest.downloadedFileSize = 0;
                 fileRequest.status = LoadingPackFile;
@@ -431,6 +424,33 @@ bool PackRequest::CheckLoadingStatusOfFileRequest(FileRequest& fileRequest, DLCD
     return false;
 }
 
+void PackRequest::OnTaskError(const DLCDownloader::TaskStatus& status, const FilePath& localFile)
+{
+    // log same error only once, stop spam
+    if (prevTaskError != status.error)
+    {
+        packManager->GetLog() << "file_request failed: can't download file: " << localFile.GetAbsolutePathname() << " status: " << status << std::endl;
+        prevTaskError = status.error;
+    }
+
+    if (status.error.curlErr != 0
+        || status.error.curlMErr != 0
+        || status.error.httpCode >= 400)
+    {
+        packManager->FireNetworkReady(false);
+    }
+
+    if (status.error.fileErrno != 0 && status.error.httpCode < 400)
+    {
+        bool fireSignal = packManager->CountError(status.error.fileErrno);
+        if (fireSignal)
+        {
+            String pathname = localFile.GetAbsolutePathname();
+            packManager->error.Emit(DLCManager::ErrorOrigin::FileIO, status.error.fileErrno, pathname);
+        }
+    }
+}
+
 bool PackRequest::LoadingPackFileState(FileSystem* fs, FileRequest& fileRequest)
 {
     DLCDownloader& dm = packManager->GetDownloader();
@@ -457,13 +477,190 @@ bool PackRequest::LoadingPackFileState(FileSystem* fs, FileRequest& fileRequest)
     return CheckLoadingStatusOfFileRequest(fileRequest, dm, dstPath);
 }
 
+void PackRequest::StartBatchRequests()
+{
+    const DLCManager::Hints& hints = packManager->GetHints();
+    if (hints.downloadBatchMaxSize == 0)
+    {
+        return;
+    }
+
+    Vector<size_t> waitingRequests;
+    for (size_t i = 0; i < requests.size(); ++i)
+    {
+        const FileRequest& r = requests[i];
+        // empty files are left for LoadingPackFileState, they have no bytes in range
+        if (r.status == LoadingPackFile && r.task == nullptr && !r.batched && r.sizeOfCompressedFile > 0)
+        {
+            waitingRequests.push_back(i);
+        }
+    }
+
+    std::sort(begin(waitingRequests), end(waitingRequests), [this](size_t left, size_t right) {
+        return requests[left].startLoadingPos < requests[right].startLoadingPos;
+    });
+
+    // greedy join neighbour files while range fits in max batch size,
+    // single files are left for LoadingPackFileState
+    Vector<size_t> batch;
+    uint64 batchBegin = 0;
+    uint64 batchEnd = 0;
+    for (size_t requestIndex : waitingRequests)
+    {
+        const FileRequest& r = requests[requestIndex];
+        const uint64 fileEnd = r.startLoadingPos + r.sizeOfCompressedFile;
+
+        bool fitsBatch = !batch.empty() &&
+        r.startLoadingPos >= batchEnd &&
+        r.startLoadingPos - batchEnd <= hints.downloadBatchGapSize &&
+        fileEnd - batchBegin <= hints.downloadBatchMaxSize;
+
+        if (!fitsBatch)
+        {
+            if (batch.size() > 1)
+            {
+                StartBatchRequest(batch);
+            }
+            batch.clear();
+            batchBegin = r.startLoadingPos;
+        }
+
+        batch.push_back(requestIndex);
+        batchEnd = fileEnd;
+    }
+
+    if (batch.size() > 1)
+    {
+        StartBatchRequest(batch);
+    }
+}
+
+void PackRequest::StartBatchRequest(const Vector<size_t>& fileRequestIndexes)
+{
+    DLCDownloader& dm = packManager->GetDownloader();
+
+    const FileRequest& first = requests[fileRequestIndexes.front()];
+    const FileRequest& last = requests[fileRequestIndexes.back()];
+    const uint64 rangeBegin = first.startLoadingPos;
+    const uint64 rangeEnd = last.startLoadingPos + last.sizeOfCompressedFile;
+
+    BatchRequest batch;
+    batch.writer = std::make_shared<BatchWriter>();
+    batch.fileRequests = fileRequestIndexes;
+
+    for (size_t requestIndex : fileRequestIndexes)
+    {
+        FileRequest& r = requests[requestIndex];
+        r.dvplWriter.reset(new DVPLWriter(r.localFile,
+                                          static_cast<uint32>(r.sizeOfCompressedFile),
+                                          static_cast<uint32>(r.sizeOfUncompressedFile),
+                                          r.compressedCrc32,
+                                          r.compressionType));
+        batch.writer->AddPart(r.startLoadingPos - rangeBegin, r.sizeOfCompressedFile, r.dvplWriter);
+    }
+
+    DLCDownloader::Range range = DLCDownloader::Range(rangeBegin, rangeEnd - rangeBegin);
+    batch.task = dm.StartTask(first.url, batch.writer, range);
+
+    if (nullptr == batch.task)
+    {
+        Logger::Error("can't create batch task: url: %s, files: %u, range: %llu-%llu", first.url.c_str(), static_cast<uint32>(fileRequestIndexes.size()), rangeBegin, rangeEnd);
+        for (size_t requestIndex : fileRequestIndexes)
+        {
+            requests[requestIndex].dvplWriter.reset();
+        }
+        return; // files will be requested one by one
+    }
+
+    for (size_t requestIndex : fileRequestIndexes)
+    {
+        requests[requestIndex].batched = true;
+    }
+
+    batches.push_back(std::move(batch));
+}
+
+bool PackRequest::UpdateBatchRequests()
+{
+    DLCDownloader& dm = packManager->GetDownloader();
+
+    bool downloadedMore = false;
+    for (size_t i = 0; i < batches.size();)
+    {
+        BatchRequest& batch = batches[i];
+        DLCDownloader::TaskStatus status = dm.GetTaskStatus(batch.task);
+        if (status.state == DLCDownloader::TaskState::Finished)
+        {
+            FinishBatchRequest(batch, status);
+            batches.erase(batches.begin() + i);
+            downloadedMore = true;
+            continue;
+        }
+
+        if (status.state == DLCDownloader::TaskState::Downloading && batch.downloadedSize != status.sizeDownloaded)
+        {
+            batch.downloadedSize = status.sizeDownloaded;
+            downloadedMore = true;
+        }
+        ++i;
+    }
+
+    return downloadedMore;
+}
+
+void PackRequest::FinishBatchRequest(BatchRequest& batch, const DLCDownloader::TaskStatus& status)
+{
+    DLCDownloader& dm = packManager->GetDownloader();
+    dm.RemoveTask(batch.task);
+    batch.task = nullptr;
+
+    // files finished before an error are kept, the rest are requested again
+    bool allDownloaded = true;
+    for (size_t i = 0; i < batch.fileRequests.size(); ++i)
+    {
+        FileRequest& fileRequest = requests[batch.fileRequests[i]];
+        fileRequest.batched = false;
+        fileRequest.dvplWriter.reset();
+
+        if (batch.writer->IsPartDownloaded(i))
+        {
+            fileRequest.downloadedFileSize = fileRequest.sizeOfCompressedFile;
+            fileRequest.status = Ready;
+            packManager->SetFileIsReady(fileRequest.fileIndex, static_cast<uint32>(fileRequest.sizeOfCompressedFile));
+        }
+        else
+        {
+            if (allDownloaded && status.error.errorHappened)
+            {
+                OnTaskError(status, fileRequest.localFile);
+            }
+            allDownloaded = false;
+            fileRequest.downloadedFileSize = 0;
+            fileRequest.status = LoadingPackFile;
+        }
+    }
+
+    if (!status.error.errorHappened)
+    {
+        packManager->FireNetworkReady(true);
+    }
+}
+
 bool PackRequest::UpdateFileRequests()
 {
     DAVA_PROFILER_CPU_SCOPE_CUSTOM(__FUNCTION__, &packManager->profiler);
 
     DVASSERT(Thread::IsMainThread());
     // return true if at least one part file continue downloading
-    bool callUpdateSignal = false;
+    bool callUpdateSignal = UpdateBatchRequests();
+
+    if (requests.empty())
+    {
+        // in case of cancel current download or disable requesting
+        return callUpdateSignal;
+    }
+
+    StartBatchRequests();
 
     FileSystem* fs = GetEngineContext()->fileSystem;
 
@@ -479,7 +676,10 @@ bool PackRequest::UpdateFileRequests()
         }
         case LoadingPackFile:
         {
-            downloadedMore = LoadingPackFileState(fs, fileRequest);
+            if (!fileRequest.batched)
+            {
+                downloadedMore = LoadingPackFileState(fs, fileRequest);
+            }
             break;
         }
         case Ready:
@@ -668,4 +868,102 @@ bool PackRequest::DVPLWriter::IsClosed() const
     return !fout.is_open();
 }
 
+void PackRequest::BatchWriter::AddPart(uint64 offset, uint64 size, std::shared_ptr<DVPLWriter> writer)
+{
+    DVASSERT(parts.empty() || parts.back().offset + parts.back().size <= offset);
+
+    Part part;
+    part.offset = offset;
+    part.size = size;
+    part.writer = writer;
+    parts.push_back(part);
+}
+
+bool PackRequest::BatchWriter::IsPartDownloaded(size_t partIndex) const
+{
+    DVASSERT(partIndex < parts.size());
+    return parts[partIndex].downloaded;
+}
+
+uint64 PackRequest::BatchWriter::Save(const void* ptr, uint64 size)
+{
+    const uint8* data = static_cast<const uint8*>(ptr);
+    const uint64 end = position + size;
+
+    while (currentPart < parts.size())
+    {
+        Part& part = parts[currentPart];
+        const uint64 partEnd = part.offset + part.size;
+        if (end < part.offset || (end == part.offset && part.size > 0))
+        {
+            break; // still in gap before part
+        }
+
+        if (!part.started)
+        {
+            // continue previously interrupted file, its head is received again and dropped
+            uint64 seekPos = part.writer->GetSeekPos();
+            if (seekPos == std::numeric_limits<uint64>::max())
+            {
+                return 0;
+            }
+            part.skipSize = std::min(seekPos, part.size);
+            part.started = true;
+        }
+
+        const uint64 writeBegin = std::max(position, part.offset + part.skipSize);
+        const uint64 writeEnd = std::min(end, partEnd);
+        if (writeBegin < writeEnd)
+        {
+            const uint64 writeSize = writeEnd - writeBegin;
+            if (part.writer->Save(data + (writeBegin - position), writeSize) != writeSize)
+            {
+                return 0;
+            }
+        }
+
+        if (end < partEnd)
+        {
+            break;
+        }
+
+        part.downloaded = part.writer->Close();
+        ++currentPart;
+    }
+
+    position = end;
+    return size;
+}
+
+uint64 PackRequest::BatchWriter::GetSeekPos()
+{
+    return position;
+}
+
+bool PackRequest::BatchWriter::Truncate()
+{
+    // only fresh writer can be used, files are resumed by parts
+    return position == 0;
+}
+
+bool PackRequest::BatchWriter::Close()
+{
+    bool allDownloaded = true;
+    for (Part& part : parts)
+    {
+        if (part.started && !part.writer->IsClosed())
+        {
+            part.writer->Close();
+        }
+        allDownloaded = allDownloaded && part.downloaded;
+    }
+    closed = true;
+    return allDownloaded;
+}
+
+bool PackRequest::BatchWriter::IsClosed() const
+{
+    return closed;
+}
+
 } // end namespace DAVA
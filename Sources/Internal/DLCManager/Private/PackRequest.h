@@ -14,7 +14,9 @@ class DLCManagerImpl;
 class FileSystem;
 
 /**
-	Download several files with one request
+	Download several files with one request.
+	Neighbour files in superpack are joined into one http range request
+	(see `DLCManager::Hints::downloadBatchMaxSize`) to save on per request latency.
 */
 class PackRequest final : public DLCManager::IRequest
 {
@@ -111,6 +113,50 @@ private:
         const Compressor::Type compressionType;
     };
 
+    /**
+	   BatchWriter - splits one downloaded superpack range into several
+	   DVPLWriter's, bytes between files are dropped. Every file is closed
+	   (checked and moved) as soon as its last byte is received.
+	*/
+    class BatchWriter final : public DLCDownloader::IWriter
+    {
+    public:
+        /** `offset` is relative to the beginning of downloaded range, parts have to be added in ascending order */
+        void AddPart(uint64 offset, uint64 size, std::shared_ptr<DVPLWriter> writer);
+        /** return true if part is fully downloaded and its dvpl passed check */
+        bool IsPartDownloaded(size_t partIndex) const;
+
+        uint64 Save(const void* ptr, uint64 size) final;
+        uint64 GetSeekPos() final;
+        bool Truncate() final;
+        bool Close() final;
+        bool IsClosed() const final;
+
+    private:
+        struct Part
+        {
+            uint64 offset = 0;
+            uint64 size = 0;
+            uint64 skipSize = 0; // already downloaded bytes of previous attempt
+            std::shared_ptr<DVPLWriter> writer;
+            bool started = false;
+            bool downloaded = false;
+        };
+
+        Vector<Part> parts;
+        size_t currentPart = 0;
+        uint64 position = 0;
+        bool closed = false;
+    };
+
+    struct BatchRequest
+    {
+        DLCDownloader::ITask* task = nullptr;
+        std::shared_ptr<BatchWriter> writer;
+        Vector<size_t> fileRequests; // indexes in `requests`
+        uint64 downloadedSize = 0;
+    };
+
     struct FileRequest
     {
         FileRequest() = default;
@@ -137,17 +183,24 @@ private:
         DLCDownloader::ITask* task = nullptr;
         Compressor::Type compressionType = Compressor::Type::Lz4HC;
         Status status = CheckLocalFile;
+        bool batched = false; // downloading by one of `batches`
         std::shared_ptr<DVPLWriter> dvplWriter;
     };
 
     bool CheckLocalFileState(FileSystem* fs, FileRequest& fileRequest);
     bool CheckLoadingStatusOfFileRequest(FileRequest& fileRequest, DLCDownloader& dm, const String& dstPath);
     bool LoadingPackFileState(FileSystem* fs, FileRequest& fileRequest);
+    void OnTaskError(const DLCDownloader::TaskStatus& status, const FilePath& localFile);
+    void StartBatchRequests();
+    void StartBatchRequest(const Vector<size_t>& fileRequestIndexes);
+    bool UpdateBatchRequests();
+    void FinishBatchRequest(BatchRequest& batch, const DLCDownloader::TaskStatus& status);
     bool UpdateFileRequests();
 
     DLCManagerImpl* packManager = nullptr;
 
     Vector<FileRequest> requests;
+    Vector<BatchRequest> batches;
     Vector<uint32> fileIndexes;
     String requestedPackName;
 
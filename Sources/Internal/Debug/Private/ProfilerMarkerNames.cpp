@@ -51,11 +51,16 @@ const char* SCENE_WAVE_SYSTEM = "WaveSystem";
 const char* SCENE_SKELETON_SYSTEM = "SkeletonSystem";
 const char* SCENE_MOTION_SYSTEM = "MotionSystem";
 const char* SCENE_GEODECAL_SYSTEM = "GeoDecalSystem";
+const char* SCENE_SYSTEM_SCHEDULER_STAGE = "SceneSystemScheduler::Stage";
+const char* SCENE_ASYNC_LOAD = "AsyncSceneLoader::Load";
+const char* SCENE_ASYNC_LOAD_ATTACH = "AsyncSceneLoader::AttachTo";
 
 //Render
 const char* RENDER_PASS_PREPARE_ARRAYS = "RenderPass::PrepareArrays";
 const char* RENDER_PASS_DRAW_LAYERS = "RenderPass::DrawLayers";
+const char* RENDER_PASS_SORT_LAYERS = "RenderPass::SortLayers";
 const char* RENDER_PREPARE_LANDSCAPE = "Landscape::Prepare";
+const char* RENDER_SHADER_WARMUP = "ShaderWarmup::Build";
 
 //RHI
 const char* RHI_RENDER_LOOP = "rhi::RenderLoop";
@@ -51,11 +51,16 @@ extern const char* SCENE_WAVE_SYSTEM;
 extern const char* SCENE_SKELETON_SYSTEM;
 extern const char* SCENE_MOTION_SYSTEM;
 extern const char* SCENE_GEODECAL_SYSTEM;
+extern const char* SCENE_SYSTEM_SCHEDULER_STAGE;
+extern const char* SCENE_ASYNC_LOAD;
+extern const char* SCENE_ASYNC_LOAD_ATTACH;
 
 //Render
 extern const char* RENDER_PASS_PREPARE_ARRAYS;
 extern const char* RENDER_PASS_DRAW_LAYERS;
+extern const char* RENDER_PASS_SORT_LAYERS;
 extern const char* RENDER_PREPARE_LANDSCAPE;
+extern const char* RENDER_SHADER_WARMUP;
 
 //RHI
 extern const char* RHI_RENDER_LOOP;
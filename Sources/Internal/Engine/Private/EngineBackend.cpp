@@ -55,6 +55,7 @@
 #include "Render/Image/ImageConverter.h"
 #include "Render/Renderer.h"
 #include "Render/RHI/rhi_ShaderSource.h"
+#include "Render/Material/FXCache.h"
 #include "Scene3D/SceneFile/VersionInfo.h"
 #include "Sound/SoundEvent.h"
 #include "Sound/SoundSystem.h"
@@ -361,6 +362,8 @@ void EngineBackend::OnGameLoopStopped()
     if (!IsConsoleMode())
     {
         rhi::ShaderSourceCache::Save("~doc:/ShaderSource.bin");
+        if (Renderer::IsInitialized())
+            FXCache::Save("~doc:/FXCache.bin");
     }
 
     Logger::Info("EngineBackend::OnGameLoopStopped: leave");
@@ -687,6 +690,8 @@ void EngineBackend::HandleAppSuspended(const MainDispatcherEvent& e)
         if (Renderer::IsInitialized())
             rhi::SuspendRendering();
         rhi::ShaderSourceCache::Save("~doc:/ShaderSource.bin");
+        if (Renderer::IsInitialized())
+            FXCache::Save("~doc:/FXCache.bin");
         engine->suspended.Emit();
 
         Logger::Info("EngineBackend::HandleAppSuspended: leave");
@@ -811,6 +816,7 @@ void EngineBackend::InitRenderer(Window* w)
 
     rhi::ShaderSourceCache::Load("~doc:/ShaderSource.bin");
     Renderer::Initialize(renderer, rendererParams);
+    FXCache::Load("~doc:/FXCache.bin");
     context->renderSystem2D->Init();
 
     if (options->GetBool("init_imgui"))
@@ -1071,6 +1077,8 @@ void EngineBackend::DestroySubsystems()
     SafeRelease(context->assetsManager);
 #endif
 
+    // Logger writes files in background, write pending messages while FileSystem is alive
+    context->logger->Flush();
     SafeRelease(context->fileSystem);
     if (context->deviceManager != nullptr)
     {
@@ -15,6 +15,7 @@
 namespace DAVA
 {
 class Entity;
+class FlatKeyedArchive;
 
 class Component : public Serializable, public InspBase
 {
@@ -31,6 +32,13 @@ public:
     void Serialize(KeyedArchive* archive, SerializationContext* serializationContext) override;
     void Deserialize(KeyedArchive* archive, SerializationContext* serializationContext) override;
 
+    /**
+        Deserialize component from `archive` without creation of intermediate KeyedArchive.
+        Default implementation converts `archive` to KeyedArchive and calls `Deserialize`,
+        components which are loaded for most of entities override it to read values directly.
+    */
+    virtual void DeserializeFlat(const FlatKeyedArchive* archive, SerializationContext* serializationContext);
+
     inline Entity* GetEntity() const;
     virtual void SetEntity(Entity* entity);
 
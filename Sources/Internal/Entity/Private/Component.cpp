@@ -1,6 +1,8 @@
 #include "Entity/Component.h"
 
 #include "Base/ObjectFactory.h"
+#include "FileSystem/FlatKeyedArchive.h"
+#include "FileSystem/KeyedArchive.h"
 #include "Scene3D/Entity.h"
 #include "Scene3D/SceneFile/SerializationContext.h"
 #include "Scene3D/Systems/GlobalEventSystem.h"
@@ -56,4 +58,10 @@ void Component::Deserialize(KeyedArchive* archive, SerializationContext* seriali
 {
     // Do we need this?
 }
+
+void Component::DeserializeFlat(const FlatKeyedArchive* archive, SerializationContext* serializationContext)
+{
+    RefPtr<KeyedArchive> keyedArchive = (archive != nullptr) ? archive->CreateKeyedArchive() : RefPtr<KeyedArchive>();
+    Deserialize(keyedArchive.Get(), serializationContext);
+}
 }
@@ -98,6 +98,13 @@ void SceneSystem::Process(float32 timeElapsed)
 {
 }
 
+void SceneSystem::SetComponentsAccess(const ComponentMask& readComponents_, const ComponentMask& writeComponents_)
+{
+    readComponents = readComponents_;
+    writeComponents = writeComponents_;
+    hasComponentsAccess = true;
+}
+
 void SceneSystem::SetLocked(bool locked_)
 {
     locked = locked_;
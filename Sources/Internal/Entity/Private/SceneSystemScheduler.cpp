@@ -0,0 +1,106 @@
+#include "Entity/SceneSystemScheduler.h"
+#include "Entity/SceneSystem.h"
+
+#include "Debug/DVAssert.h"
+#include "Debug/ProfilerCPU.h"
+#include "Debug/ProfilerMarkerNames.h"
+#include "Job/JobManager.h"
+
+namespace DAVA
+{
+void SceneSystemScheduler::ProcessSerial(const Vector<SceneSystem*>& systems, const ProcessFunction& processFn)
+{
+    for (SceneSystem* system : systems)
+    {
+        processFn(system);
+    }
+}
+
+void SceneSystemScheduler::ProcessParallel(const Vector<SceneSystem*>& systems, const ProcessFunction& processFn, JobManager* jobManager)
+{
+    if (jobManager == nullptr || jobManager->GetWorkersCount() == 0)
+    {
+        ProcessSerial(systems, processFn);
+        return;
+    }
+
+    Vector<JobHandle> stageJobs;
+    for (const Vector<SceneSystem*>& stage : GetStages(systems))
+    {
+        DAVA_PROFILER_CPU_SCOPE(ProfilerCPUMarkerName::SCENE_SYSTEM_SCHEDULER_STAGE);
+
+        uint32 stageSize = static_cast<uint32>(stage.size());
+        for (uint32 i = 1; i < stageSize; ++i)
+        {
+            SceneSystem* system = stage[i];
+            stageJobs.push_back(jobManager->CreateWorkerJob([system, &processFn]() { processFn(system); }));
+        }
+
+        processFn(stage[0]);
+
+        for (const JobHandle& job : stageJobs)
+        {
+            jobManager->WaitWorkerJob(job);
+        }
+        stageJobs.clear();
+    }
+}
+
+void SceneSystemScheduler::Invalidate()
+{
+    stagesValid = false;
+}
+
+const Vector<Vector<SceneSystem*>>& SceneSystemScheduler::GetStages(const Vector<SceneSystem*>& systems)
+{
+    if (!stagesValid || scheduledSystems != systems)
+    {
+        BuildStages(systems);
+    }
+
+    return stages;
+}
+
+bool SceneSystemScheduler::IsConflicting(const SceneSystem* first, const SceneSystem* second)
+{
+    if (!first->HasComponentsAccess() || !second->HasComponentsAccess())
+    {
+        return true;
+    }
+
+    const ComponentMask firstAccess = first->GetReadComponents() | first->GetWriteComponents();
+    const ComponentMask secondAccess = second->GetReadComponents() | second->GetWriteComponents();
+
+    return (first->GetWriteComponents() & secondAccess).any() || (second->GetWriteComponents() & firstAccess).any();
+}
+
+void SceneSystemScheduler::BuildStages(const Vector<SceneSystem*>& systems)
+{
+    scheduledSystems = systems;
+    stages.clear();
+
+    // Stage index of system is the length of the longest chain of conflicting systems preceding it.
+    // So system is always processed after every earlier system it conflicts with.
+    uint32 systemsCount = static_cast<uint32>(systems.size());
+    Vector<uint32> stageIndices(systemsCount, 0);
+    for (uint32 i = 0; i < systemsCount; ++i)
+    {
+        for (uint32 j = 0; j < i; ++j)
+        {
+            if (stageIndices[j] + 1 > stageIndices[i] && IsConflicting(systems[j], systems[i]))
+            {
+                stageIndices[i] = stageIndices[j] + 1;
+            }
+        }
+
+        if (stageIndices[i] >= stages.size())
+        {
+            DVASSERT(stageIndices[i] == stages.size());
+            stages.resize(stageIndices[i] + 1);
+        }
+        stages[stageIndices[i]].push_back(systems[i]);
+    }
+
+    stagesValid = true;
+}
+}
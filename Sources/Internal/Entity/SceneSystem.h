@@ -25,6 +25,21 @@ public:
     inline void SetRequiredComponents(const ComponentMask& requiredComponents);
     inline const ComponentMask& GetRequiredComponents() const;
 
+    /**
+        \brief Declare components which are read and written by this system in `Process`.
+                Systems with declared access can be processed concurrently with other systems when
+                their access does not conflict (see Scene::SetParallelSystemsProcessing).
+                Systems without declaration are always processed on the main thread in their original order.
+                Declared systems should not touch any shared state except listed components, and should not
+                wait for main-thread jobs from `Process`.
+        \param[in] readComponents components read by system.
+        \param[in] writeComponents components modified by system.
+     */
+    void SetComponentsAccess(const ComponentMask& readComponents, const ComponentMask& writeComponents);
+    inline bool HasComponentsAccess() const;
+    inline const ComponentMask& GetReadComponents() const;
+    inline const ComponentMask& GetWriteComponents() const;
+
     /**
         \brief  This function is called when any entity registered to scene.
                 It sorts out is entity has all necessary components and we need to call AddEntity.
@@ -133,8 +148,12 @@ protected:
 
 private:
     ComponentMask requiredComponents;
+    ComponentMask readComponents;
+    ComponentMask writeComponents;
     Scene* scene = nullptr;
 
+    bool hasComponentsAccess = false;
+
     bool locked = false;
 };
 
@@ -153,4 +172,19 @@ inline const ComponentMask& SceneSystem::GetRequiredComponents() const
 {
     return requiredComponents;
 }
+
+inline bool SceneSystem::HasComponentsAccess() const
+{
+    return hasComponentsAccess;
+}
+
+inline const ComponentMask& SceneSystem::GetReadComponents() const
+{
+    return readComponents;
+}
+
+inline const ComponentMask& SceneSystem::GetWriteComponents() const
+{
+    return writeComponents;
+}
 }
@@ -0,0 +1,55 @@
+#pragma once
+
+#include "Base/BaseTypes.h"
+#include "Functional/Function.h"
+
+namespace DAVA
+{
+class SceneSystem;
+class JobManager;
+
+/**
+    \ingroup systems
+    \brief Schedules `Process` calls of scene systems.
+
+    Scheduler builds dependency graph from components access declared by systems (see SceneSystem::SetComponentsAccess)
+    and splits ordered list of systems into stages. Systems inside one stage have no conflicting access and can be
+    processed concurrently on JobManager workers. Stages are processed one after another.
+    Two systems conflict if one of them writes components that another one reads or writes.
+    System without declared access conflicts with any other system, so it always forms its own stage
+    and is processed on the main thread.
+
+    Order of systems with conflicting access is the same as in source list, so serial and parallel processing give the same result.
+*/
+class SceneSystemScheduler
+{
+public:
+    using ProcessFunction = Function<void(SceneSystem*)>;
+
+    /** Process `systems` one by one on the calling thread in original order. */
+    void ProcessSerial(const Vector<SceneSystem*>& systems, const ProcessFunction& processFn);
+
+    /**
+        Process `systems` stage by stage. First system of each stage is processed on the calling thread,
+        other systems of the stage are processed on `jobManager` workers.
+        Stages are rebuilt automatically when `systems` list differs from the one used last time.
+    */
+    void ProcessParallel(const Vector<SceneSystem*>& systems, const ProcessFunction& processFn, JobManager* jobManager);
+
+    /** Force rebuilding of stages on next `ProcessParallel` call. Should be called if system changed declared access. */
+    void Invalidate();
+
+    /** Return stages built for `systems`. */
+    const Vector<Vector<SceneSystem*>>& GetStages(const Vector<SceneSystem*>& systems);
+
+    /** Return true if `first` and `second` systems can't be processed concurrently. */
+    static bool IsConflicting(const SceneSystem* first, const SceneSystem* second);
+
+private:
+    void BuildStages(const Vector<SceneSystem*>& systems);
+
+    Vector<SceneSystem*> scheduledSystems;
+    Vector<Vector<SceneSystem*>> stages;
+    bool stagesValid = false;
+};
+}
@@ -207,11 +207,7 @@ File* File::LoadFileFromMountedArchive(const String& packName, const String& rel
         auto it = fs->resArchiveMap.find(packName);
         if (it != end(fs->resArchiveMap))
         {
-            Vector<uint8> fileContent;
-            if (it->second.archive->LoadFile(relative, fileContent))
-            {
-                return DynamicMemoryFile::Create(std::move(fileContent), READ, "~res:/" + relative);
-            }
+            return it->second.archive->OpenFile(relative, "~res:/" + relative);
         }
         return nullptr;
     }
@@ -956,7 +956,7 @@ bool FileSystem::ReadFileContents(const FilePath& pathname, Vector<uint8>& buffe
     return true;
 }
 
-void FileSystem::Mount(const FilePath& archiveName, const String& attachPath)
+void FileSystem::Mount(const FilePath& archiveName, const String& attachPath, bool useMemoryMapping)
 {
     DVASSERT(!attachPath.empty());
 
@@ -964,7 +964,7 @@ void FileSystem::Mount(const FilePath& archiveName, const String& attachPath)
     {
         ResourceArchiveItem item;
         item.attachPath = attachPath;
-        item.archive.reset(new ResourceArchive(archiveName));
+        item.archive.reset(new ResourceArchive(archiveName, useMemoryMapping));
         item.archiveFilePath = archiveName;
 
         {
@@ -223,11 +223,12 @@ public:
 
 		\param[in] archiveName pathname or local filename of archive we want to attach
 		\param[in] attachPath path we attach our archive
+		\param[in] useMemoryMapping map dvpk archive into memory and read files directly from mapping (see ResourceArchive)
 
         can throw std::runtime_exception in case of error
         thread safe
 	*/
-    virtual void Mount(const FilePath& archiveName, const String& attachPath);
+    virtual void Mount(const FilePath& archiveName, const String& attachPath, bool useMemoryMapping = false);
 
     /**
         \brief Function to detach ResourceArchive from filesystem
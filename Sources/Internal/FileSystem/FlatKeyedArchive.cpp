@@ -0,0 +1,885 @@
+#include "FileSystem/FlatKeyedArchive.h"
+#include "FileSystem/DynamicMemoryFile.h"
+#include "FileSystem/File.h"
+#include "FileSystem/KeyedArchive.h"
+#include "FileSystem/UnmanagedMemoryFile.h"
+#include "Base/ScopedPtr.h"
+#include "Debug/DVAssert.h"
+#include "Logger/Logger.h"
+#include "Math/AABBox3.h"
+#include "Utils/StringFormat.h"
+#include "Utils/UTF8Utils.h"
+
+#include <algorithm>
+
+namespace DAVA
+{
+namespace FlatKeyedArchiveDetails
+{
+const uint16 ARCHIVE_VERSION = 1;
+const uint32 ARCHIVE_HEADER_SIZE = 2 + sizeof(uint16) + sizeof(uint32);
+const uint32 MIN_GARBAGE_TO_COMPACT = 1024;
+
+const int32 VARIABLE_SIZE = 0;
+const int32 UNSUPPORTED_TYPE = -1;
+
+// Return size of value of fixed-size type, VARIABLE_SIZE for types with length prefix or UNSUPPORTED_TYPE
+int32 GetFixedValueSize(uint8 type)
+{
+    switch (type)
+    {
+    case VariantType::TYPE_BOOLEAN:
+    case VariantType::TYPE_INT8:
+    case VariantType::TYPE_UINT8:
+        return 1;
+    case VariantType::TYPE_INT16:
+    case VariantType::TYPE_UINT16:
+        return 2;
+    case VariantType::TYPE_INT32:
+    case VariantType::TYPE_UINT32:
+    case VariantType::TYPE_FLOAT:
+        return 4;
+    case VariantType::TYPE_INT64:
+    case VariantType::TYPE_UINT64:
+    case VariantType::TYPE_FLOAT64:
+        return 8;
+    case VariantType::TYPE_VECTOR2:
+        return sizeof(Vector2);
+    case VariantType::TYPE_VECTOR3:
+        return sizeof(Vector3);
+    case VariantType::TYPE_VECTOR4:
+        return sizeof(Vector4);
+    case VariantType::TYPE_MATRIX2:
+        return sizeof(Matrix2);
+    case VariantType::TYPE_MATRIX3:
+        return sizeof(Matrix3);
+    case VariantType::TYPE_MATRIX4:
+        return sizeof(Matrix4);
+    case VariantType::TYPE_COLOR:
+        return sizeof(Color);
+    case VariantType::TYPE_AABBOX3:
+        return sizeof(AABBox3);
+    case VariantType::TYPE_STRING:
+    case VariantType::TYPE_WIDE_STRING:
+    case VariantType::TYPE_BYTE_ARRAY:
+    case VariantType::TYPE_KEYED_ARCHIVE:
+    case VariantType::TYPE_FASTNAME:
+    case VariantType::TYPE_FILEPATH:
+        return VARIABLE_SIZE;
+    default:
+        return UNSUPPORTED_TYPE;
+    }
+}
+
+// Return size of single element of value with length prefix
+uint32 GetElementSize(uint8 type)
+{
+    return (type == VariantType::TYPE_WIDE_STRING) ? static_cast<uint32>(sizeof(wchar_t)) : 1;
+}
+
+uint32 ReadUInt32(const uint8* data)
+{
+    uint32 value = 0;
+    Memcpy(&value, data, sizeof(value));
+    return value;
+}
+
+// Calculate size of value record (type tag followed by value) located at `record`
+bool GetRecordSize(const uint8* record, uint32 available, uint32& recordSize)
+{
+    if (available < 1)
+    {
+        return false;
+    }
+
+    int32 fixedSize = GetFixedValueSize(record[0]);
+    if (fixedSize == UNSUPPORTED_TYPE)
+    {
+        return false;
+    }
+
+    if (fixedSize != VARIABLE_SIZE)
+    {
+        recordSize = 1 + static_cast<uint32>(fixedSize);
+    }
+    else
+    {
+        if (available < 1 + sizeof(uint32))
+        {
+            return false;
+        }
+
+        uint64 size = 1 + sizeof(uint32) + uint64(ReadUInt32(record + 1)) * GetElementSize(record[0]);
+        if (size > available)
+        {
+            return false;
+        }
+        recordSize = static_cast<uint32>(size);
+    }
+
+    return recordSize <= available;
+}
+
+// Read value record from `file` and append it to `output`
+bool ReadRecord(File* file, Vector<uint8>& output)
+{
+    uint8 type = 0;
+    if (file->Read(&type, 1) != 1)
+    {
+        return false;
+    }
+
+    int32 fixedSize = GetFixedValueSize(type);
+    if (fixedSize == UNSUPPORTED_TYPE)
+    {
+        return false;
+    }
+
+    size_t recordStart = output.size();
+    if (fixedSize != VARIABLE_SIZE)
+    {
+        output.resize(recordStart + 1 + fixedSize);
+        output[recordStart] = type;
+        return file->Read(&output[recordStart + 1], fixedSize) == static_cast<uint32>(fixedSize);
+    }
+
+    uint32 length = 0;
+    if (file->Read(&length, sizeof(length)) != sizeof(length))
+    {
+        return false;
+    }
+
+    uint32 valueSize = length * GetElementSize(type);
+    output.resize(recordStart + 1 + sizeof(length) + valueSize);
+    output[recordStart] = type;
+    Memcpy(&output[recordStart + 1], &length, sizeof(length));
+    return valueSize == 0 || file->Read(&output[recordStart + 1 + sizeof(length)], valueSize) == valueSize;
+}
+
+// Make String from characters with length prefix, trailing zeros are cut like in VariantType::Read
+String MakeString(const uint8* value)
+{
+    uint32 length = ReadUInt32(value);
+    const char* chars = reinterpret_cast<const char*>(value + sizeof(uint32));
+    return String(chars, std::find(chars, chars + length, '\0'));
+}
+
+// Intern key stored as string value without creation of temporary String, long keys are copied into `buffer`
+FastName MakeFastName(const uint8* value, Vector<char8>& buffer)
+{
+    const uint32 KEY_STACK_BUFFER_SIZE = 128;
+
+    uint32 length = ReadUInt32(value);
+    const char8* chars = reinterpret_cast<const char8*>(value + sizeof(uint32));
+    length = static_cast<uint32>(std::find(chars, chars + length, '\0') - chars);
+
+    char8 stackBuffer[KEY_STACK_BUFFER_SIZE];
+    char8* dst = stackBuffer;
+    if (length >= KEY_STACK_BUFFER_SIZE)
+    {
+        buffer.resize(length + 1);
+        dst = buffer.data();
+    }
+    Memcpy(dst, chars, length);
+    dst[length] = '\0';
+    return FastName(dst);
+}
+
+WideString MakeWideString(const uint8* value)
+{
+    uint32 length = ReadUInt32(value);
+    WideString result(length, L'\0');
+    Memcpy(&result[0], value + sizeof(uint32), length * sizeof(wchar_t));
+    return result;
+}
+
+bool CompareEntryKeys(const FastName& left, const FastName& right)
+{
+    return left < right;
+}
+}
+
+FlatKeyedArchive::FlatKeyedArchive() = default;
+
+FlatKeyedArchive::FlatKeyedArchive(const FlatKeyedArchive& archive)
+    : BaseObject()
+{
+    *this = archive;
+}
+
+FlatKeyedArchive::FlatKeyedArchive(const KeyedArchive& archive)
+{
+    ScopedPtr<DynamicMemoryFile> buffer(DynamicMemoryFile::Create(File::CREATE | File::WRITE | File::READ));
+    archive.Save(buffer);
+    buffer->Seek(0, File::SEEK_FROM_START);
+    Load(buffer);
+}
+
+FlatKeyedArchive::~FlatKeyedArchive() = default;
+
+FlatKeyedArchive& FlatKeyedArchive::operator=(const FlatKeyedArchive& archive)
+{
+    if (this != &archive)
+    {
+        entries = archive.entries;
+        storage = archive.storage;
+        garbageSize = archive.garbageSize;
+        viewData = archive.viewData;
+        viewSize = archive.viewSize;
+        viewOwner = archive.viewOwner;
+    }
+    return *this;
+}
+
+bool FlatKeyedArchive::Load(File* file)
+{
+    using namespace FlatKeyedArchiveDetails;
+
+    DeleteAllKeys();
+
+    uint64 startPosition = file->GetPos();
+
+    char header[2];
+    uint16 version = 0;
+    uint32 itemsCount = 0;
+    if (file->Read(header, 2) != 2)
+    {
+        return false;
+    }
+
+    if (header[0] != 'K' || header[1] != 'A')
+    {
+        // archive without header is written in legacy format, load it with KeyedArchive
+        if (!file->Seek(startPosition, File::SEEK_FROM_START))
+        {
+            return false;
+        }
+
+        ScopedPtr<KeyedArchive> archive(new KeyedArchive());
+        if (!archive->Load(file))
+        {
+            return false;
+        }
+        *this = FlatKeyedArchive(*archive);
+        return true;
+    }
+
+    if (file->Read(&version, sizeof(version)) != sizeof(version) || version != ARCHIVE_VERSION)
+    {
+        Logger::Error("[FlatKeyedArchive] error loading archive, because version is incorrect");
+        return false;
+    }
+
+    if (file->Read(&itemsCount, sizeof(itemsCount)) != sizeof(itemsCount))
+    {
+        return false;
+    }
+
+    entries.reserve(itemsCount);
+
+    Vector<uint8> keyRecord;
+    Vector<char8> keyBuffer;
+    for (uint32 i = 0; i < itemsCount; ++i)
+    {
+        keyRecord.clear();
+        if (!ReadRecord(file, keyRecord) || keyRecord[0] != VariantType::TYPE_STRING)
+        {
+            DeleteAllKeys();
+            return false;
+        }
+
+        Entry entry;
+        entry.key = MakeFastName(&keyRecord[1], keyBuffer);
+        entry.offset = static_cast<uint32>(storage.size());
+        if (!ReadRecord(file, storage))
+        {
+            DeleteAllKeys();
+            return false;
+        }
+        entry.size = static_cast<uint32>(storage.size()) - entry.offset;
+        entries.push_back(entry);
+    }
+
+    std::stable_sort(entries.begin(), entries.end(), [](const Entry& l, const Entry& r) { return CompareEntryKeys(l.key, r.key); });
+    return true;
+}
+
+bool FlatKeyedArchive::Load(const uint8* data, uint32 size)
+{
+    DeleteAllKeys();
+
+    storage.assign(data, data + size);
+    if (!Index(storage.data(), size))
+    {
+        DeleteAllKeys();
+        return false;
+    }
+    // records are indexed with archive header and keys, garbage is removed on first compaction
+    garbageSize = size;
+    for (const Entry& entry : entries)
+    {
+        garbageSize -= entry.size;
+    }
+    return true;
+}
+
+bool FlatKeyedArchive::LoadView(const uint8* data, uint32 size)
+{
+    DeleteAllKeys();
+
+    if (!Index(data, size))
+    {
+        DeleteAllKeys();
+        return false;
+    }
+    viewData = data;
+    viewSize = size;
+    return true;
+}
+
+bool FlatKeyedArchive::Index(const uint8* data, uint32 size)
+{
+    using namespace FlatKeyedArchiveDetails;
+
+    if (data == nullptr || size < ARCHIVE_HEADER_SIZE || data[0] != 'K' || data[1] != 'A')
+    {
+        return false;
+    }
+
+    uint16 version = 0;
+    Memcpy(&version, data + 2, sizeof(version));
+    if (version != ARCHIVE_VERSION)
+    {
+        Logger::Error("[FlatKeyedArchive] error loading archive, because version is incorrect");
+        return false;
+    }
+
+    uint32 itemsCount = ReadUInt32(data + 2 + sizeof(version));
+    uint32 offset = ARCHIVE_HEADER_SIZE;
+
+    entries.reserve(itemsCount);
+    Vector<char8> keyBuffer;
+    for (uint32 i = 0; i < itemsCount; ++i)
+    {
+        uint32 keySize = 0;
+        if (!GetRecordSize(data + offset, size - offset, keySize) || data[offset] != VariantType::TYPE_STRING)
+        {
+            return false;
+        }
+
+        Entry entry;
+        entry.key = MakeFastName(data + offset + 1, keyBuffer);
+        entry.offset = offset + keySize;
+        if (!GetRecordSize(data + entry.offset, size - entry.offset, entry.size))
+        {
+            return false;
+        }
+        entries.push_back(entry);
+
+        offset = entry.offset + entry.size;
+    }
+
+    std::stable_sort(entries.begin(), entries.end(), [](const Entry& l, const Entry& r) { return CompareEntryKeys(l.key, r.key); });
+    return true;
+}
+
+bool FlatKeyedArchive::Save(File* file) const
+{
+    // keys are written in the same order as KeyedArchive::Save does
+    Vector<const Entry*> orderedEntries;
+    orderedEntries.reserve(entries.size());
+    for (const Entry& entry : entries)
+    {
+        orderedEntries.push_back(&entry);
+    }
+    std::sort(orderedEntries.begin(), orderedEntries.end(), [](const Entry* l, const Entry* r) { return strcmp(l->key.c_str(), r->key.c_str()) < 0; });
+
+    char header[2] = { 'K', 'A' };
+    uint16 version = FlatKeyedArchiveDetails::ARCHIVE_VERSION;
+    uint32 itemsCount = static_cast<uint32>(orderedEntries.size());
+    if (file->Write(header, 2) != 2
+        || file->Write(&version, sizeof(version)) != sizeof(version)
+        || file->Write(&itemsCount, sizeof(itemsCount)) != sizeof(itemsCount))
+    {
+        return false;
+    }
+
+    const uint8* data = GetData();
+    for (const Entry* entry : orderedEntries)
+    {
+        uint8 keyType = VariantType::TYPE_STRING;
+        uint32 keyLength = static_cast<uint32>(strlen(entry->key.c_str()));
+        if (file->Write(&keyType, 1) != 1
+            || file->Write(&keyLength, sizeof(keyLength)) != sizeof(keyLength)
+            || file->Write(entry->key.c_str(), keyLength) != keyLength
+            || file->Write(data + entry->offset, entry->size) != entry->size)
+        {
+            return false;
+        }
+    }
+
+    return file->Flush();
+}
+
+RefPtr<KeyedArchive> FlatKeyedArchive::CreateKeyedArchive() const
+{
+    if (IsView())
+    {
+        // view is never modified, so its data contains exactly the same values
+        RefPtr<KeyedArchive> archive(new KeyedArchive());
+        archive->Load(viewData, viewSize);
+        return archive;
+    }
+
+    ScopedPtr<DynamicMemoryFile> buffer(DynamicMemoryFile::Create(File::CREATE | File::WRITE | File::READ));
+    Save(buffer);
+    buffer->Seek(0, File::SEEK_FROM_START);
+
+    RefPtr<KeyedArchive> archive(new KeyedArchive());
+    archive->Load(buffer);
+    return archive;
+}
+
+bool FlatKeyedArchive::IsKeyExists(const FastName& key) const
+{
+    return FindEntry(key) != nullptr;
+}
+
+void FlatKeyedArchive::DeleteKey(const FastName& key)
+{
+    auto it = std::lower_bound(entries.begin(), entries.end(), key, [](const Entry& e, const FastName& k) { return FlatKeyedArchiveDetails::CompareEntryKeys(e.key, k); });
+    if (it != entries.end() && it->key == key)
+    {
+        size_t index = std::distance(entries.begin(), it);
+        MakeOwned();
+        garbageSize += entries[index].size;
+        entries.erase(entries.begin() + index);
+    }
+}
+
+void FlatKeyedArchive::DeleteAllKeys()
+{
+    entries.clear();
+    storage.clear();
+    garbageSize = 0;
+    viewData = nullptr;
+    viewSize = 0;
+    viewOwner = nullptr;
+}
+
+Vector<FastName> FlatKeyedArchive::GetKeys() const
+{
+    Vector<FastName> keys;
+    keys.reserve(entries.size());
+    for (const Entry& entry : entries)
+    {
+        keys.push_back(entry.key);
+    }
+    return keys;
+}
+
+const FlatKeyedArchive::Entry* FlatKeyedArchive::FindEntry(const FastName& key) const
+{
+    auto it = std::lower_bound(entries.begin(), entries.end(), key, [](const Entry& e, const FastName& k) { return FlatKeyedArchiveDetails::CompareEntryKeys(e.key, k); });
+    return (it != entries.end() && it->key == key) ? &(*it) : nullptr;
+}
+
+const uint8* FlatKeyedArchive::FindValue(const FastName& key, VariantType::eVariantType type) const
+{
+    const Entry* entry = FindEntry(key);
+    if (entry == nullptr)
+    {
+        return nullptr;
+    }
+
+    const uint8* record = GetData() + entry->offset;
+    if (record[0] != type)
+    {
+        DVASSERT(false, Format("FlatKeyedArchive: value of key '%s' has type %u, but %u is requested", key.c_str(), record[0], type).c_str());
+        return nullptr;
+    }
+    return record + 1;
+}
+
+template <typename T>
+T FlatKeyedArchive::GetValue(const FastName& key, VariantType::eVariantType type, const T& defaultValue) const
+{
+    const uint8* value = FindValue(key, type);
+    if (value == nullptr)
+    {
+        return defaultValue;
+    }
+
+    // math types aren't trivially copyable, so value is copied through raw storage instead of being memcpy'ed into object
+    alignas(T) uint8 buffer[sizeof(T)];
+    Memcpy(buffer, value, sizeof(T));
+    return *reinterpret_cast<const T*>(buffer);
+}
+
+template <typename T>
+void FlatKeyedArchive::SetValue(const FastName& key, VariantType::eVariantType type, const T& value)
+{
+    const uint8* bytes = reinterpret_cast<const uint8*>(&value);
+    uint8* data = AllocateValue(key, type, sizeof(T));
+    std::copy(bytes, bytes + sizeof(T), data);
+}
+
+bool FlatKeyedArchive::GetBool(const FastName& key, bool defaultValue) const
+{
+    return GetValue<uint8>(key, VariantType::TYPE_BOOLEAN, defaultValue ? 1 : 0) != 0;
+}
+
+int32 FlatKeyedArchive::GetInt32(const FastName& key, int32 defaultValue) const
+{
+    return GetValue(key, VariantType::TYPE_INT32, defaultValue);
+}
+
+uint32 FlatKeyedArchive::GetUInt32(const FastName& key, uint32 defaultValue) const
+{
+    return GetValue(key, VariantType::TYPE_UINT32, defaultValue);
+}
+
+int64 FlatKeyedArchive::GetInt64(const FastName& key, int64 defaultValue) const
+{
+    return GetValue(key, VariantType::TYPE_INT64, defaultValue);
+}
+
+uint64 FlatKeyedArchive::GetUInt64(const FastName& key, uint64 defaultValue) const
+{
+    return GetValue(key, VariantType::TYPE_UINT64, defaultValue);
+}
+
+float32 FlatKeyedArchive::GetFloat(const FastName& key, float32 defaultValue) const
+{
+    return GetValue(key, VariantType::TYPE_FLOAT, defaultValue);
+}
+
+float64 FlatKeyedArchive::GetFloat64(const FastName& key, float64 defaultValue) const
+{
+    return GetValue(key, VariantType::TYPE_FLOAT64, defaultValue);
+}
+
+String FlatKeyedArchive::GetString(const FastName& key, const String& defaultValue) const
+{
+    const Entry* entry = FindEntry(key);
+    if (entry != nullptr && GetData()[entry->offset] == VariantType::TYPE_WIDE_STRING)
+    {
+        return UTF8Utils::EncodeToUTF8(FlatKeyedArchiveDetails::MakeWideString(GetData() + entry->offset + 1));
+    }
+
+    const uint8* value = FindValue(key, VariantType::TYPE_STRING);
+    return (value != nullptr) ? FlatKeyedArchiveDetails::MakeString(value) : defaultValue;
+}
+
+WideString FlatKeyedArchive::GetWideString(const FastName& key, const WideString& defaultValue) const
+{
+    // wide strings are converted to utf8 when KeyedArchive is loaded, so utf8 string value is also accepted
+    const Entry* entry = FindEntry(key);
+    if (entry != nullptr && GetData()[entry->offset] == VariantType::TYPE_STRING)
+    {
+        return UTF8Utils::EncodeToWideString(FlatKeyedArchiveDetails::MakeString(GetData() + entry->offset + 1));
+    }
+
+    const uint8* value = FindValue(key, VariantType::TYPE_WIDE_STRING);
+    return (value != nullptr) ? FlatKeyedArchiveDetails::MakeWideString(value) : defaultValue;
+}
+
+FastName FlatKeyedArchive::GetFastName(const FastName& key, const FastName& defaultValue) const
+{
+    const uint8* value = FindValue(key, VariantType::TYPE_FASTNAME);
+    return (value != nullptr) ? FastName(FlatKeyedArchiveDetails::MakeString(value)) : defaultValue;
+}
+
+Vector2 FlatKeyedArchive::GetVector2(const FastName& key, const Vector2& defaultValue) const
+{
+    return GetValue(key, VariantType::TYPE_VECTOR2, defaultValue);
+}
+
+Vector3 FlatKeyedArchive::GetVector3(const FastName& key, const Vector3& defaultValue) const
+{
+    return GetValue(key, VariantType::TYPE_VECTOR3, defaultValue);
+}
+
+Vector4 FlatKeyedArchive::GetVector4(const FastName& key, const Vector4& defaultValue) const
+{
+    return GetValue(key, VariantType::TYPE_VECTOR4, defaultValue);
+}
+
+Matrix2 FlatKeyedArchive::GetMatrix2(const FastName& key, const Matrix2& defaultValue) const
+{
+    return GetValue(key, VariantType::TYPE_MATRIX2, defaultValue);
+}
+
+Matrix3 FlatKeyedArchive::GetMatrix3(const FastName& key, const Matrix3& defaultValue) const
+{
+    return GetValue(key, VariantType::TYPE_MATRIX3, defaultValue);
+}
+
+Matrix4 FlatKeyedArchive::GetMatrix4(const FastName& key, const Matrix4& defaultValue) const
+{
+    return GetValue(key, VariantType::TYPE_MATRIX4, defaultValue);
+}
+
+Color FlatKeyedArchive::GetColor(const FastName& key, const Color& defaultValue) const
+{
+    return GetValue(key, VariantType::TYPE_COLOR, defaultValue);
+}
+
+const uint8* FlatKeyedArchive::GetByteArray(const FastName& key, const uint8* defaultValue) const
+{
+    const uint8* value = FindValue(key, VariantType::TYPE_BYTE_ARRAY);
+    return (value != nullptr) ? value + sizeof(uint32) : defaultValue;
+}
+
+int32 FlatKeyedArchive::GetByteArraySize(const FastName& key, int32 defaultValue) const
+{
+    const uint8* value = FindValue(key, VariantType::TYPE_BYTE_ARRAY);
+    return (value != nullptr) ? static_cast<int32>(FlatKeyedArchiveDetails::ReadUInt32(value)) : defaultValue;
+}
+
+RefPtr<FlatKeyedArchive> FlatKeyedArchive::GetArchive(const FastName& key) const
+{
+    const uint8* value = FindValue(key, VariantType::TYPE_KEYED_ARCHIVE);
+    if (value == nullptr)
+    {
+        return RefPtr<FlatKeyedArchive>();
+    }
+
+    RefPtr<FlatKeyedArchive> archive(new FlatKeyedArchive());
+    if (!archive->LoadView(value + sizeof(uint32), FlatKeyedArchiveDetails::ReadUInt32(value)))
+    {
+        return RefPtr<FlatKeyedArchive>();
+    }
+    archive->viewOwner = RefPtr<FlatKeyedArchive>::ConstructWithRetain(const_cast<FlatKeyedArchive*>(this));
+    return archive;
+}
+
+VariantType FlatKeyedArchive::GetVariant(const FastName& key) const
+{
+    VariantType result;
+
+    const Entry* entry = FindEntry(key);
+    if (entry != nullptr)
+    {
+        ScopedPtr<UnmanagedMemoryFile> file(new UnmanagedMemoryFile(GetData() + entry->offset, entry->size));
+        result.Read(file);
+    }
+    return result;
+}
+
+void FlatKeyedArchive::SetBool(const FastName& key, bool value)
+{
+    SetValue<uint8>(key, VariantType::TYPE_BOOLEAN, value ? 1 : 0);
+}
+
+void FlatKeyedArchive::SetInt32(const FastName& key, int32 value)
+{
+    SetValue(key, VariantType::TYPE_INT32, value);
+}
+
+void FlatKeyedArchive::SetUInt32(const FastName& key, uint32 value)
+{
+    SetValue(key, VariantType::TYPE_UINT32, value);
+}
+
+void FlatKeyedArchive::SetInt64(const FastName& key, int64 value)
+{
+    SetValue(key, VariantType::TYPE_INT64, value);
+}
+
+void FlatKeyedArchive::SetUInt64(const FastName& key, uint64 value)
+{
+    SetValue(key, VariantType::TYPE_UINT64, value);
+}
+
+void FlatKeyedArchive::SetFloat(const FastName& key, float32 value)
+{
+    SetValue(key, VariantType::TYPE_FLOAT, value);
+}
+
+void FlatKeyedArchive::SetFloat64(const FastName& key, float64 value)
+{
+    SetValue(key, VariantType::TYPE_FLOAT64, value);
+}
+
+void FlatKeyedArchive::SetString(const FastName& key, const String& value)
+{
+    SetStringValue(key, VariantType::TYPE_STRING, value.data(), static_cast<uint32>(value.size()), 1);
+}
+
+void FlatKeyedArchive::SetWideString(const FastName& key, const WideString& value)
+{
+    SetStringValue(key, VariantType::TYPE_WIDE_STRING, value.data(), static_cast<uint32>(value.size()), sizeof(wchar_t));
+}
+
+void FlatKeyedArchive::SetFastName(const FastName& key, const FastName& value)
+{
+    const char* chars = value.IsValid() ? value.c_str() : "";
+    SetStringValue(key, VariantType::TYPE_FASTNAME, chars, static_cast<uint32>(strlen(chars)), 1);
+}
+
+void FlatKeyedArchive::SetVector2(const FastName& key, const Vector2& value)
+{
+    SetValue(key, VariantType::TYPE_VECTOR2, value);
+}
+
+void FlatKeyedArchive::SetVector3(const FastName& key, const Vector3& value)
+{
+    SetValue(key, VariantType::TYPE_VECTOR3, value);
+}
+
+void FlatKeyedArchive::SetVector4(const FastName& key, const Vector4& value)
+{
+    SetValue(key, VariantType::TYPE_VECTOR4, value);
+}
+
+void FlatKeyedArchive::SetMatrix2(const FastName& key, const Matrix2& value)
+{
+    SetValue(key, VariantType::TYPE_MATRIX2, value);
+}
+
+void FlatKeyedArchive::SetMatrix3(const FastName& key, const Matrix3& value)
+{
+    SetValue(key, VariantType::TYPE_MATRIX3, value);
+}
+
+void FlatKeyedArchive::SetMatrix4(const FastName& key, const Matrix4& value)
+{
+    SetValue(key, VariantType::TYPE_MATRIX4, value);
+}
+
+void FlatKeyedArchive::SetColor(const FastName& key, const Color& value)
+{
+    SetValue(key, VariantType::TYPE_COLOR, value);
+}
+
+void FlatKeyedArchive::SetByteArray(const FastName& key, const uint8* value, int32 arraySize)
+{
+    SetStringValue(key, VariantType::TYPE_BYTE_ARRAY, value, static_cast<uint32>(arraySize), 1);
+}
+
+void FlatKeyedArchive::SetArchive(const FastName& key, const FlatKeyedArchive* archive)
+{
+    DVASSERT(archive != this);
+
+    ScopedPtr<DynamicMemoryFile> buffer(DynamicMemoryFile::Create(File::CREATE | File::WRITE));
+    archive->Save(buffer);
+    SetStringValue(key, VariantType::TYPE_KEYED_ARCHIVE, buffer->GetData(), static_cast<uint32>(buffer->GetSize()), 1);
+}
+
+void FlatKeyedArchive::SetVariant(const FastName& key, const VariantType& value)
+{
+    ScopedPtr<DynamicMemoryFile> buffer(DynamicMemoryFile::Create(File::CREATE | File::WRITE));
+    if (!value.Write(buffer) || FlatKeyedArchiveDetails::GetFixedValueSize(buffer->GetData()[0]) == FlatKeyedArchiveDetails::UNSUPPORTED_TYPE)
+    {
+        DVASSERT(false, Format("FlatKeyedArchive: can't store value of type %d", value.GetType()).c_str());
+        return;
+    }
+
+    const uint8* record = buffer->GetData();
+    uint32 valueSize = static_cast<uint32>(buffer->GetSize()) - 1;
+    uint8* data = AllocateValue(key, static_cast<VariantType::eVariantType>(record[0]), valueSize);
+    Memcpy(data, record + 1, valueSize);
+}
+
+void FlatKeyedArchive::SetStringValue(const FastName& key, VariantType::eVariantType type, const void* value, uint32 length, uint32 charSize)
+{
+    uint32 valueSize = length * charSize;
+    uint8* data = AllocateValue(key, type, sizeof(uint32) + valueSize);
+    Memcpy(data, &length, sizeof(uint32));
+    if (valueSize > 0)
+    {
+        Memcpy(data + sizeof(uint32), value, valueSize);
+    }
+}
+
+uint8* FlatKeyedArchive::AllocateValue(const FastName& key, VariantType::eVariantType type, uint32 valueSize)
+{
+    DVASSERT(key.IsValid());
+
+    MakeOwned();
+
+    uint32 recordSize = 1 + valueSize;
+    auto it = std::lower_bound(entries.begin(), entries.end(), key, [](const Entry& e, const FastName& k) { return FlatKeyedArchiveDetails::CompareEntryKeys(e.key, k); });
+    bool exists = (it != entries.end() && it->key == key);
+
+    if (exists && it->size == recordSize)
+    {
+        // value of the same size is overwritten in place
+        uint8* record = storage.data() + it->offset;
+        record[0] = static_cast<uint8>(type);
+        return record + 1;
+    }
+
+    if (exists)
+    {
+        garbageSize += it->size;
+        it->size = 0;
+        if (garbageSize >= FlatKeyedArchiveDetails::MIN_GARBAGE_TO_COMPACT && garbageSize * 2 > storage.size())
+        {
+            size_t index = std::distance(entries.begin(), it);
+            Compact();
+            it = entries.begin() + index;
+        }
+    }
+    else
+    {
+        Entry entry;
+        entry.key = key;
+        it = entries.insert(it, entry);
+    }
+
+    it->offset = static_cast<uint32>(storage.size());
+    it->size = recordSize;
+    storage.resize(storage.size() + recordSize);
+
+    uint8* record = storage.data() + it->offset;
+    record[0] = static_cast<uint8>(type);
+    return record + 1;
+}
+
+void FlatKeyedArchive::MakeOwned()
+{
+    if (IsView())
+    {
+        const uint8* data = viewData;
+
+        uint32 totalSize = 0;
+        for (const Entry& entry : entries)
+        {
+            totalSize += entry.size;
+        }
+
+        storage.clear();
+        storage.reserve(totalSize);
+        for (Entry& entry : entries)
+        {
+            uint32 offset = static_cast<uint32>(storage.size());
+            storage.insert(storage.end(), data + entry.offset, data + entry.offset + entry.size);
+            entry.offset = offset;
+        }
+
+        garbageSize = 0;
+        viewData = nullptr;
+        viewSize = 0;
+        viewOwner = nullptr;
+    }
+}
+
+void FlatKeyedArchive::Compact()
+{
+    DVASSERT(!IsView());
+
+    Vector<uint8> compacted;
+    compacted.reserve(storage.size() - garbageSize);
+    for (Entry& entry : entries)
+    {
+        uint32 offset = static_cast<uint32>(compacted.size());
+        compacted.insert(compacted.end(), storage.data() + entry.offset, storage.data() + entry.offset + entry.size);
+        entry.offset = offset;
+    }
+
+    storage.swap(compacted);
+    garbageSize = 0;
+}
+}
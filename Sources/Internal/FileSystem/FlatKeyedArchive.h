@@ -0,0 +1,165 @@
+#pragma once
+
+#include "Base/BaseTypes.h"
+#include "Base/BaseObject.h"
+#include "Base/FastName.h"
+#include "Base/RefPtr.h"
+#include "FileSystem/VariantType.h"
+#include "Math/Color.h"
+#include "Math/Matrix2.h"
+#include "Math/Matrix3.h"
+#include "Math/Matrix4.h"
+
+namespace DAVA
+{
+class File;
+class KeyedArchive;
+
+/**
+    \ingroup filesystem
+    Compact alternative to KeyedArchive.
+
+    Keys are interned as FastName and values are stored inline in single contiguous buffer
+    in the same binary layout as values in KeyedArchive file format, so setting or loading value doesn't allocate
+    memory for every field. Archive can be created as read-only view over already loaded buffer (see `LoadView`):
+    buffer is indexed but not copied. First modification of such archive copies values into its own storage.
+
+    `Save` writes data which can be loaded by KeyedArchive::Load and `Load` accepts data written by KeyedArchive::Save,
+    Get/Set functions follow KeyedArchive ones, but take keys as FastName, so frequently used keys should be
+    created once (e.g. as static constants) instead of being interned on every access.
+*/
+class FlatKeyedArchive : public BaseObject
+{
+public:
+    FlatKeyedArchive();
+    FlatKeyedArchive(const FlatKeyedArchive& archive);
+    explicit FlatKeyedArchive(const KeyedArchive& archive);
+
+    FlatKeyedArchive& operator=(const FlatKeyedArchive& archive);
+
+    /** Load archive in KeyedArchive binary format from current position of `file`, values are copied into archive storage. */
+    bool Load(File* file);
+    /** Load archive in KeyedArchive binary format from `data`, values are copied into archive storage. */
+    bool Load(const uint8* data, uint32 size);
+    /**
+        Make archive read-only view over `data` in KeyedArchive binary format without copying it.
+        `data` should stay valid while archive is in use or until archive is modified.
+    */
+    bool LoadView(const uint8* data, uint32 size);
+
+    /** Save archive in KeyedArchive binary format. */
+    bool Save(File* file) const;
+
+    /** Create regular KeyedArchive with the same content, view over archive data is loaded without copying it to temporary buffer. */
+    RefPtr<KeyedArchive> CreateKeyedArchive() const;
+
+    bool IsView() const;
+    bool IsKeyExists(const FastName& key) const;
+    uint32 Count() const;
+    void DeleteKey(const FastName& key);
+    void DeleteAllKeys();
+
+    /** Return keys of archive in no particular order. */
+    Vector<FastName> GetKeys() const;
+
+    bool GetBool(const FastName& key, bool defaultValue = false) const;
+    int32 GetInt32(const FastName& key, int32 defaultValue = 0) const;
+    uint32 GetUInt32(const FastName& key, uint32 defaultValue = 0) const;
+    int64 GetInt64(const FastName& key, int64 defaultValue = 0) const;
+    uint64 GetUInt64(const FastName& key, uint64 defaultValue = 0) const;
+    float32 GetFloat(const FastName& key, float32 defaultValue = 0.0f) const;
+    float64 GetFloat64(const FastName& key, float64 defaultValue = 0.0) const;
+    String GetString(const FastName& key, const String& defaultValue = "") const;
+    WideString GetWideString(const FastName& key, const WideString& defaultValue = L"") const;
+    FastName GetFastName(const FastName& key, const FastName& defaultValue = FastName()) const;
+    Vector2 GetVector2(const FastName& key, const Vector2& defaultValue = Vector2()) const;
+    Vector3 GetVector3(const FastName& key, const Vector3& defaultValue = Vector3()) const;
+    Vector4 GetVector4(const FastName& key, const Vector4& defaultValue = Vector4()) const;
+    Matrix2 GetMatrix2(const FastName& key, const Matrix2& defaultValue = Matrix2()) const;
+    Matrix3 GetMatrix3(const FastName& key, const Matrix3& defaultValue = Matrix3()) const;
+    Matrix4 GetMatrix4(const FastName& key, const Matrix4& defaultValue = Matrix4()) const;
+    Color GetColor(const FastName& key, const Color& defaultValue = Color()) const;
+
+    /** Return pointer to byte array stored inside archive, pointer is valid until archive is modified. */
+    const uint8* GetByteArray(const FastName& key, const uint8* defaultValue = nullptr) const;
+    int32 GetByteArraySize(const FastName& key, int32 defaultValue = 0) const;
+
+    /**
+        Return nested archive as view into this archive or nullptr if key doesn't exist.
+        Nested archive keeps this archive alive, but becomes invalid when this archive is modified.
+    */
+    RefPtr<FlatKeyedArchive> GetArchive(const FastName& key) const;
+
+    /** Return value of any type as VariantType, or empty VariantType if key doesn't exist. */
+    VariantType GetVariant(const FastName& key) const;
+
+    void SetBool(const FastName& key, bool value);
+    void SetInt32(const FastName& key, int32 value);
+    void SetUInt32(const FastName& key, uint32 value);
+    void SetInt64(const FastName& key, int64 value);
+    void SetUInt64(const FastName& key, uint64 value);
+    void SetFloat(const FastName& key, float32 value);
+    void SetFloat64(const FastName& key, float64 value);
+    void SetString(const FastName& key, const String& value);
+    void SetWideString(const FastName& key, const WideString& value);
+    void SetFastName(const FastName& key, const FastName& value);
+    void SetVector2(const FastName& key, const Vector2& value);
+    void SetVector3(const FastName& key, const Vector3& value);
+    void SetVector4(const FastName& key, const Vector4& value);
+    void SetMatrix2(const FastName& key, const Matrix2& value);
+    void SetMatrix3(const FastName& key, const Matrix3& value);
+    void SetMatrix4(const FastName& key, const Matrix4& value);
+    void SetColor(const FastName& key, const Color& value);
+    void SetByteArray(const FastName& key, const uint8* value, int32 arraySize);
+    void SetArchive(const FastName& key, const FlatKeyedArchive* archive);
+    void SetVariant(const FastName& key, const VariantType& value);
+
+protected:
+    ~FlatKeyedArchive() override;
+
+private:
+    struct Entry
+    {
+        FastName key;
+        uint32 offset = 0; // offset of value record (type tag followed by value) in archive data
+        uint32 size = 0; // size of value record
+    };
+
+    const uint8* GetData() const;
+    const Entry* FindEntry(const FastName& key) const;
+    const uint8* FindValue(const FastName& key, VariantType::eVariantType type) const;
+    uint8* AllocateValue(const FastName& key, VariantType::eVariantType type, uint32 valueSize);
+    void SetStringValue(const FastName& key, VariantType::eVariantType type, const void* value, uint32 length, uint32 charSize);
+    void MakeOwned();
+    void Compact();
+    bool Index(const uint8* data, uint32 size);
+
+    template <typename T>
+    T GetValue(const FastName& key, VariantType::eVariantType type, const T& defaultValue) const;
+    template <typename T>
+    void SetValue(const FastName& key, VariantType::eVariantType type, const T& value);
+
+    Vector<Entry> entries; // sorted by key
+    Vector<uint8> storage;
+    uint32 garbageSize = 0;
+
+    const uint8* viewData = nullptr;
+    uint32 viewSize = 0;
+    RefPtr<FlatKeyedArchive> viewOwner;
+};
+
+inline bool FlatKeyedArchive::IsView() const
+{
+    return viewData != nullptr;
+}
+
+inline uint32 FlatKeyedArchive::Count() const
+{
+    return static_cast<uint32>(entries.size());
+}
+
+inline const uint8* FlatKeyedArchive::GetData() const
+{
+    return (viewData != nullptr) ? viewData : storage.data();
+}
+}
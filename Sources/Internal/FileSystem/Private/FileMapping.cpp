@@ -0,0 +1,224 @@
+#include "FileSystem/Private/FileMapping.h"
+#include "FileSystem/FilePath.h"
+#include "Debug/DVAssert.h"
+#include "Logger/Logger.h"
+
+#if defined(__DAVAENGINE_WIN32__)
+#include "Utils/UTF8Utils.h"
+#elif defined(__DAVAENGINE_POSIX__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace DAVA
+{
+FileMapping::~FileMapping()
+{
+    Unmap();
+}
+
+#if defined(__DAVAENGINE_WIN32__)
+
+bool FileMapping::Map(const FilePath& path)
+{
+    Unmap();
+
+    WideString fileName = UTF8Utils::EncodeToWideString(path.GetAbsolutePathname());
+    HANDLE file = ::CreateFileW(fileName.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+    {
+        return false;
+    }
+
+    LARGE_INTEGER fileSize;
+    if (::GetFileSizeEx(file, &fileSize) == FALSE || fileSize.QuadPart == 0)
+    {
+        ::CloseHandle(file);
+        return false;
+    }
+
+    HANDLE mapping = ::CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (mapping == nullptr)
+    {
+        ::CloseHandle(file);
+        return false;
+    }
+
+    void* view = ::MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (view == nullptr)
+    {
+        ::CloseHandle(mapping);
+        ::CloseHandle(file);
+        return false;
+    }
+
+    fileHandle = file;
+    mappingHandle = mapping;
+    data = static_cast<const uint8*>(view);
+    size = static_cast<uint64>(fileSize.QuadPart);
+    return true;
+}
+
+void FileMapping::Unmap()
+{
+    if (data != nullptr)
+    {
+        ::UnmapViewOfFile(data);
+        ::CloseHandle(static_cast<HANDLE>(mappingHandle));
+        ::CloseHandle(static_cast<HANDLE>(fileHandle));
+
+        data = nullptr;
+        size = 0;
+        mappingHandle = nullptr;
+        fileHandle = nullptr;
+    }
+}
+
+#elif defined(__DAVAENGINE_POSIX__)
+
+bool FileMapping::Map(const FilePath& path)
+{
+    Unmap();
+
+    int fd = ::open(path.GetAbsolutePathname().c_str(), O_RDONLY);
+    if (fd < 0)
+    {
+        return false;
+    }
+
+    struct stat fileStat;
+    if (::fstat(fd, &fileStat) != 0 || fileStat.st_size <= 0)
+    {
+        ::close(fd);
+        return false;
+    }
+
+    void* view = ::mmap(nullptr, static_cast<size_t>(fileStat.st_size), PROT_READ, MAP_SHARED, fd, 0);
+    // mapping stays valid after descriptor is closed
+    ::close(fd);
+
+    if (view == MAP_FAILED)
+    {
+        Logger::Warning("Can't map file %s into memory", path.GetAbsolutePathname().c_str());
+        return false;
+    }
+
+    data = static_cast<const uint8*>(view);
+    size = static_cast<uint64>(fileStat.st_size);
+    return true;
+}
+
+void FileMapping::Unmap()
+{
+    if (data != nullptr)
+    {
+        ::munmap(const_cast<uint8*>(data), static_cast<size_t>(size));
+        data = nullptr;
+        size = 0;
+    }
+}
+
+#else
+
+bool FileMapping::Map(const FilePath& path)
+{
+    return false;
+}
+
+void FileMapping::Unmap()
+{
+}
+
+#endif
+
+MappedFile::MappedFile(const std::shared_ptr<FileMapping>& mapping_, const uint8* content_, uint64 contentSize_, const FilePath& fileName)
+    : mapping(mapping_)
+    , content(content_)
+    , contentSize(contentSize_)
+{
+    filename = fileName;
+}
+
+uint32 MappedFile::Read(void* destinationBuffer, uint32 dataSize)
+{
+    DVASSERT(destinationBuffer != nullptr);
+
+    if (position >= contentSize)
+    {
+        isEof = dataSize > 0;
+        return 0;
+    }
+
+    uint64 available = contentSize - position;
+    if (dataSize > available)
+    {
+        isEof = true;
+        dataSize = static_cast<uint32>(available);
+    }
+
+    Memcpy(destinationBuffer, content + position, dataSize);
+    position += dataSize;
+    return dataSize;
+}
+
+bool MappedFile::Seek(int64 offset, eFileSeek seekType)
+{
+    int64 newPosition = 0;
+    switch (seekType)
+    {
+    case SEEK_FROM_START:
+        newPosition = offset;
+        break;
+    case SEEK_FROM_CURRENT:
+        newPosition = static_cast<int64>(position) + offset;
+        break;
+    case SEEK_FROM_END:
+        newPosition = static_cast<int64>(contentSize) - 1 + offset;
+        break;
+    default:
+        return false;
+    }
+
+    if (newPosition < 0)
+    {
+        return false;
+    }
+
+    position = static_cast<uint64>(newPosition);
+    isEof = false;
+    return true;
+}
+
+uint64 MappedFile::GetPos() const
+{
+    return position;
+}
+
+uint64 MappedFile::GetSize() const
+{
+    return contentSize;
+}
+
+bool MappedFile::IsEof() const
+{
+    return isEof;
+}
+
+uint32 MappedFile::Write(const void* sourceBuffer, uint32 dataSize)
+{
+    DVASSERT(false, "Write is not supported for memory mapped files");
+    return 0;
+}
+
+bool MappedFile::Truncate(uint64 size)
+{
+    return false;
+}
+
+bool MappedFile::Flush()
+{
+    return true;
+}
+}
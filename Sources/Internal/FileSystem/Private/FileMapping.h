@@ -0,0 +1,84 @@
+#pragma once
+
+#include "Base/BaseTypes.h"
+#include "FileSystem/File.h"
+
+#include <memory>
+
+namespace DAVA
+{
+class FilePath;
+
+/**
+    Read-only memory mapping of whole file.
+    Mapping is supported only for regular files on Win32 and POSIX platforms,
+    on other platforms (and for files packed inside application bundle on Android) `Map` returns false.
+*/
+class FileMapping final
+{
+public:
+    FileMapping() = default;
+    ~FileMapping();
+
+    FileMapping(const FileMapping&) = delete;
+    FileMapping& operator=(const FileMapping&) = delete;
+
+    /** Map content of file `path` into memory. Previous mapping (if any) is released. */
+    bool Map(const FilePath& path);
+    void Unmap();
+
+    bool IsMapped() const;
+    const uint8* GetData() const;
+    uint64 GetSize() const;
+
+private:
+    const uint8* data = nullptr;
+    uint64 size = 0;
+#if defined(__DAVAENGINE_WIN32__)
+    void* fileHandle = nullptr;
+    void* mappingHandle = nullptr;
+#endif
+};
+
+inline bool FileMapping::IsMapped() const
+{
+    return data != nullptr;
+}
+
+inline const uint8* FileMapping::GetData() const
+{
+    return data;
+}
+
+inline uint64 FileMapping::GetSize() const
+{
+    return size;
+}
+
+/**
+    Read-only file over part of memory mapped file.
+    Behaves like read-only DynamicMemoryFile but doesn't own or copy content, mapping is kept alive while file exists.
+*/
+class MappedFile final : public File
+{
+public:
+    MappedFile(const std::shared_ptr<FileMapping>& mapping, const uint8* content, uint64 contentSize, const FilePath& fileName);
+
+    uint32 Read(void* destinationBuffer, uint32 dataSize) override;
+    bool Seek(int64 offset, eFileSeek seekType) override;
+    uint64 GetPos() const override;
+    uint64 GetSize() const override;
+    bool IsEof() const override;
+
+    uint32 Write(const void* sourceBuffer, uint32 dataSize) override;
+    bool Truncate(uint64 size) override;
+    bool Flush() override;
+
+private:
+    std::shared_ptr<FileMapping> mapping;
+    const uint8* content = nullptr;
+    uint64 contentSize = 0;
+    uint64 position = 0;
+    bool isEof = false;
+};
+}
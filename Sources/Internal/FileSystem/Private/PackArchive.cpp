@@ -1,4 +1,5 @@
 #include "FileSystem/Private/PackArchive.h"
+#include "FileSystem/Private/FileMapping.h"
 #include "Compression/ZipCompressor.h"
 #include "Compression/LZ4Compressor.h"
 #include "FileSystem/FileSystem.h"
@@ -86,7 +87,7 @@ void PackArchive::FillFilesInfo(const PackFormat::PackFile& packFile,
                   });
 }
 
-PackArchive::PackArchive(RefPtr<File>& file_, const FilePath& archiveName_)
+PackArchive::PackArchive(RefPtr<File>& file_, const FilePath& archiveName_, bool useMemoryMapping)
     : archiveName(archiveName_)
     , file(file_)
 {
@@ -174,6 +175,21 @@ PackArchive::PackArchive(RefPtr<File>& file_, const FilePath& archiveName_)
         }
         packMeta.reset(new PackMetaData(&metaBlock[0], metaBlock.size(), fileNames));
     }
+
+    if (useMemoryMapping)
+    {
+        mapping = std::make_shared<FileMapping>();
+        if (!mapping->Map(archiveName) || mapping->GetSize() != size)
+        {
+            Logger::Warning("can't map pack file into memory, fall back to regular reading: %s", fileName.c_str());
+            mapping.reset();
+        }
+    }
+}
+
+bool PackArchive::IsMemoryMapped() const
+{
+    return mapping != nullptr;
 }
 
 const Vector<ResourceArchive::FileInfo>& PackArchive::GetFilesInfo() const
@@ -206,14 +222,56 @@ bool PackArchive::LoadFile(const String& relativeFilePath, Vector<uint8>& output
 {
     using namespace PackFormat;
 
-    if (!HasFile(relativeFilePath))
+    auto it = mapFileData.find(relativeFilePath);
+    if (it == mapFileData.end())
     {
         return false;
     }
 
-    const FileTableEntry& fileEntry = *mapFileData.find(relativeFilePath)->second;
+    const FileTableEntry& fileEntry = *it->second;
     output.resize(fileEntry.originalSize);
 
+    bool isOk = (mapping != nullptr) ? ReadMappedContent(relativeFilePath, fileEntry, output) : ReadContent(relativeFilePath, fileEntry, output);
+    if (!isOk)
+    {
+        return false;
+    }
+
+    CheckCrc32(relativeFilePath, fileEntry, output.data(), static_cast<uint32>(output.size()));
+
+    return true;
+}
+
+File* PackArchive::OpenFile(const String& relativeFilePath, const FilePath& fileName) const
+{
+    using namespace PackFormat;
+
+    auto it = mapFileData.find(relativeFilePath);
+    if (it == mapFileData.end())
+    {
+        return nullptr;
+    }
+
+    const FileTableEntry& fileEntry = *it->second;
+    if (mapping != nullptr && fileEntry.type == Compressor::Type::None)
+    {
+        const uint8* content = GetMappedContent(fileEntry, fileEntry.originalSize);
+        if (content == nullptr)
+        {
+            Logger::Error("can't load file: %s course: file content is out of mapped pack file", relativeFilePath.c_str());
+            return nullptr;
+        }
+
+        CheckCrc32(relativeFilePath, fileEntry, content, fileEntry.originalSize);
+
+        return new MappedFile(mapping, content, fileEntry.originalSize, fileName);
+    }
+
+    return ResourceArchiveImpl::OpenFile(relativeFilePath, fileName);
+}
+
+bool PackArchive::ReadContent(const String& relativeFilePath, const PackFormat::FileTableEntry& fileEntry, Vector<uint8>& output) const
+{
     if (!file)
     {
         DAVA_THROW(DAVA::Exception, "can't open: " + relativeFilePath + " from pack: " + archiveName.GetStringValue());
@@ -277,14 +335,70 @@ bool PackArchive::LoadFile(const String& relativeFilePath, Vector<uint8>& output
     break;
     } // end switch
 
+    return true;
+}
+
+bool PackArchive::ReadMappedContent(const String& relativeFilePath, const PackFormat::FileTableEntry& fileEntry, Vector<uint8>& output) const
+{
+    uint32 contentSize = (fileEntry.type == Compressor::Type::None) ? fileEntry.originalSize : fileEntry.compressedSize;
+    const uint8* content = GetMappedContent(fileEntry, contentSize);
+    if (content == nullptr)
+    {
+        Logger::Error("can't load file: %s course: file content is out of mapped pack file", relativeFilePath.c_str());
+        return false;
+    }
+
+    switch (fileEntry.type)
+    {
+    case Compressor::Type::None:
+    {
+        Memcpy(output.data(), content, contentSize);
+    }
+    break;
+    case Compressor::Type::Lz4:
+    case Compressor::Type::Lz4HC:
+    {
+        if (!LZ4Compressor().Decompress(content, contentSize, output))
+        {
+            Logger::Error("can't load file: %s  course: decompress error", relativeFilePath.c_str());
+            return false;
+        }
+    }
+    break;
+    case Compressor::Type::RFC1951:
+    {
+        if (!ZipCompressor().Decompress(content, contentSize, output))
+        {
+            Logger::Error("can't load file: %s  course: decompress error", relativeFilePath.c_str());
+            return false;
+        }
+    }
+    break;
+    } // end switch
+
+    return true;
+}
+
+const uint8* PackArchive::GetMappedContent(const PackFormat::FileTableEntry& fileEntry, uint32 contentSize) const
+{
+    DVASSERT(mapping != nullptr);
+
+    uint64 contentEnd = fileEntry.startPosition + static_cast<uint64>(contentSize);
+    if (contentEnd > mapping->GetSize())
+    {
+        return nullptr;
+    }
+    return mapping->GetData() + fileEntry.startPosition;
+}
+
+void PackArchive::CheckCrc32(const String& relativeFilePath, const PackFormat::FileTableEntry& fileEntry, const uint8* content, uint32 contentSize) const
+{
     // check crc32 for file content
-    if (fileEntry.originalCrc32 != 0 && fileEntry.originalCrc32 != CRC32::ForBuffer(output.data(), output.size()))
+    if (fileEntry.originalCrc32 != 0 && fileEntry.originalCrc32 != CRC32::ForBuffer(content, contentSize))
     {
         String msg = "original crc32 not match for: " + relativeFilePath + " during decompress from pack: " + archiveName.GetStringValue();
         throw FileCrc32FromPackNotMatch(msg, __FILE__, __LINE__);
     }
-
-    return true;
 }
 
 uint32 PackArchive::GetFileIndex(const String& releativeFilePath) const
@@ -7,15 +7,25 @@
 
 namespace DAVA
 {
+class FileMapping;
+
 class PackArchive final : public ResourceArchiveImpl
 {
 public:
-    PackArchive(RefPtr<File>& file_, const FilePath& archiveName);
+    /**
+        If `useMemoryMapping` is true, archive is mapped into memory and files are read directly from mapping:
+        uncompressed files are opened as views into mapping, compressed ones are decompressed from it.
+        If mapping fails archive falls back to regular reads from `file_`.
+    */
+    PackArchive(RefPtr<File>& file_, const FilePath& archiveName, bool useMemoryMapping = false);
 
     const Vector<ResourceArchive::FileInfo>& GetFilesInfo() const override;
     const ResourceArchive::FileInfo* GetFileInfo(const String& relativeFilePath) const override;
     bool HasFile(const String& relativeFilePath) const override;
     bool LoadFile(const String& relativeFilePath, Vector<uint8>& output) const override;
+    File* OpenFile(const String& relativeFilePath, const FilePath& fileName) const override;
+
+    bool IsMemoryMapped() const;
 
     /**
 		return index of struct with file info, usefull for meta data
@@ -43,8 +53,15 @@ public:
                               Vector<ResourceArchive::FileInfo>& filesInfo);
 
 private:
+    bool ReadContent(const String& relativeFilePath, const PackFormat::FileTableEntry& fileEntry, Vector<uint8>& output) const;
+    bool ReadMappedContent(const String& relativeFilePath, const PackFormat::FileTableEntry& fileEntry, Vector<uint8>& output) const;
+    const uint8* GetMappedContent(const PackFormat::FileTableEntry& fileEntry, uint32 contentSize) const;
+    void CheckCrc32(const String& relativeFilePath, const PackFormat::FileTableEntry& fileEntry, const uint8* content, uint32 contentSize) const;
+
     const FilePath archiveName;
     mutable RefPtr<File> file;
+    // shared with files opened as views into mapping, so mapping outlives archive unmount
+    std::shared_ptr<FileMapping> mapping;
     PackFormat::PackFile packFile;
     std::unique_ptr<PackMetaData> packMeta;
     UnorderedMap<String, const PackFormat::FileTableEntry*> mapFileData;
@@ -4,6 +4,8 @@
 
 namespace DAVA
 {
+class File;
+
 class ResourceArchiveImpl
 {
 public:
@@ -13,6 +15,9 @@ public:
     virtual const ResourceArchive::FileInfo* GetFileInfo(const String& relativeFilePath) const = 0;
     virtual bool HasFile(const String& relativeFilePath) const = 0;
     virtual bool LoadFile(const String& relativeFilePath, Vector<uint8>& output) const = 0;
+
+    /** Open file for reading. Default implementation loads whole file content into memory file. */
+    virtual File* OpenFile(const String& relativeFilePath, const FilePath& fileName) const;
 };
 
 } // end namespace DAVA
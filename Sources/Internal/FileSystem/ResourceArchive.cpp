@@ -2,6 +2,7 @@
 #include "FileSystem/Private/ZipArchive.h"
 #include "FileSystem/Private/PackArchive.h"
 #include "FileSystem/File.h"
+#include "FileSystem/DynamicMemoryFile.h"
 #include "FileSystem/FileSystem.h"
 #include "Logger/Logger.h"
 #include "Base/Exception.h"
@@ -19,7 +20,7 @@
 
 namespace DAVA
 {
-ResourceArchive::ResourceArchive(const FilePath& archiveName)
+ResourceArchive::ResourceArchive(const FilePath& archiveName, bool useMemoryMapping)
 {
     const String& fileName = archiveName.GetAbsolutePathname();
 
@@ -51,7 +52,7 @@ ResourceArchive::ResourceArchive(const FilePath& archiveName)
 
     if (PackFormat::FILE_MARKER == lastFourBytes)
     {
-        impl.reset(new PackArchive(f, fileName));
+        impl.reset(new PackArchive(f, fileName, useMemoryMapping));
     }
     else
     {
@@ -97,6 +98,21 @@ bool ResourceArchive::LoadFile(const String& relativeFilePath,
     return impl->LoadFile(relativeFilePath, output);
 }
 
+File* ResourceArchive::OpenFile(const String& relativeFilePath, const FilePath& fileName) const
+{
+    return impl->OpenFile(relativeFilePath, fileName);
+}
+
+File* ResourceArchiveImpl::OpenFile(const String& relativeFilePath, const FilePath& fileName) const
+{
+    Vector<uint8> fileContent;
+    if (LoadFile(relativeFilePath, fileContent))
+    {
+        return DynamicMemoryFile::Create(std::move(fileContent), File::READ, fileName);
+    }
+    return nullptr;
+}
+
 bool ResourceArchive::UnpackToFolder(const FilePath& dir) const
 {
     Vector<uint8> content;
@@ -19,11 +19,17 @@ public:
 class ResourceArchiveImpl;
 
 class FilePath;
+class File;
 
 class ResourceArchive final
 {
 public:
-    explicit ResourceArchive(const FilePath& filePath);
+    /**
+        Open archive `filePath`.
+        If `useMemoryMapping` is true, dvpk archive is mapped into memory (if platform allows it),
+        so files are read from mapping without seeking and copying through intermediate buffers.
+    */
+    explicit ResourceArchive(const FilePath& filePath, bool useMemoryMapping = false);
     ~ResourceArchive();
 
     struct FileInfo
@@ -43,6 +49,12 @@ public:
     const FileInfo* GetFileInfo(const String& relativeFilePath) const;
     bool HasFile(const String& relativeFilePath) const;
     bool LoadFile(const String& relativeFilePath, Vector<uint8>& outputFileContent) const;
+    /**
+        Open file from archive for reading, `fileName` is assigned to returned file.
+        For memory mapped dvpk archives uncompressed files are returned as views into mapping without copying content.
+        Return nullptr if file not found or can't be loaded.
+    */
+    File* OpenFile(const String& relativeFilePath, const FilePath& fileName) const;
 
     bool UnpackToFolder(const FilePath& dir) const;
 
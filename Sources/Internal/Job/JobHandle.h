@@ -0,0 +1,57 @@
+#pragma once
+
+#include "Base/BaseTypes.h"
+
+#include <memory>
+
+namespace DAVA
+{
+namespace JobDetails
+{
+struct Job;
+}
+
+/**
+    Handle of worker job created by JobManager.
+    Handle can be used to wait for job completion (see JobManager::WaitWorkerJob), to create jobs
+    which start only after job is finished (continuations) or to attach child jobs to it.
+    Job is finished when its function and functions of all its child jobs are executed.
+    Empty handle is treated as already finished job.
+*/
+class JobHandle final
+{
+public:
+    JobHandle() = default;
+
+    /** Return true if handle refers to some job. */
+    bool IsValid() const;
+
+    /** Return true if referred job and all its child jobs are executed, or if handle is empty. */
+    bool IsFinished() const;
+
+    bool operator==(const JobHandle& other) const;
+    bool operator!=(const JobHandle& other) const;
+
+private:
+    JobHandle(const std::shared_ptr<JobDetails::Job>& job);
+
+    std::shared_ptr<JobDetails::Job> job;
+
+    friend class JobManager;
+};
+
+inline bool JobHandle::IsValid() const
+{
+    return job != nullptr;
+}
+
+inline bool JobHandle::operator==(const JobHandle& other) const
+{
+    return job == other.job;
+}
+
+inline bool JobHandle::operator!=(const JobHandle& other) const
+{
+    return job != other.job;
+}
+}
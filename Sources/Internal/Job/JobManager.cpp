@@ -6,7 +6,7 @@
 #include "Engine/Engine.h"
 #include "Concurrency/LockGuard.h"
 #include "Concurrency/UniqueLock.h"
-#include "Job/JobThread.h"
+#include "Job/Private/JobScheduler.h"
 #include "Platform/DeviceInfo.h"
 
 namespace DAVA
@@ -18,13 +18,7 @@ JobManager::JobManager(Engine* e)
     , workerDoneSem(0)
 {
     uint32 cpuCoresCount = DeviceInfo::GetCpuCount();
-    workerThreads.reserve(cpuCoresCount);
-
-    for (uint32 i = 0; i < cpuCoresCount; ++i)
-    {
-        JobThread* thread = new JobThread(&workerQueue, &workerDoneSem);
-        workerThreads.push_back(thread);
-    }
+    workerScheduler = new JobDetails::JobScheduler(cpuCoresCount);
 
     e->update.Connect(this, &JobManager::Update);
 }
@@ -41,12 +35,7 @@ JobManager::~JobManager()
     mainJobIDCounter = 0;
     mainCV.NotifyAll();
 
-    for (uint32 i = 0; i < workerThreads.size(); ++i)
-    {
-        SafeDelete(workerThreads[i]);
-    }
-
-    workerThreads.clear();
+    SafeDelete(workerScheduler);
 }
 
 void JobManager::Update(float32 /*frameDelta*/)
@@ -100,7 +89,7 @@ void JobManager::Update(float32 /*frameDelta*/)
 
 uint32 JobManager::GetWorkersCount() const
 {
-    return static_cast<uint32>(workerThreads.size());
+    return workerScheduler->GetWorkersCount();
 }
 
 uint32 JobManager::CreateMainJob(const Function<void()>& fn, eMainJobType mainJobType)
@@ -235,10 +224,108 @@ bool JobManager::HasMainJobID(uint32 mainJobID)
     return (mainJobID > mainJobLastExecutedID);
 }
 
-void JobManager::CreateWorkerJob(const Function<void()>& fn)
+JobHandle JobManager::CreateWorkerJob(const Function<void()>& fn)
+{
+    return CreateWorkerJob(fn, JobHandle(), Vector<JobHandle>());
+}
+
+JobHandle JobManager::CreateWorkerJob(const Function<void()>& fn, const Vector<JobHandle>& dependencies)
+{
+    return CreateWorkerJob(fn, JobHandle(), dependencies);
+}
+
+JobHandle JobManager::CreateChildWorkerJob(const JobHandle& parent, const Function<void()>& fn)
+{
+    DVASSERT(parent.IsValid());
+    return CreateWorkerJob(fn, parent, Vector<JobHandle>());
+}
+
+JobHandle JobManager::CreateDetachedWorkerJob(const Function<void()>& fn)
+{
+    return CreateWorkerJob(fn, JobHandle(), Vector<JobHandle>(), true);
+}
+
+JobHandle JobManager::CreateWorkerJob(const Function<void()>& fn, const JobHandle& parent, const Vector<JobHandle>& dependencies, bool detached)
 {
-    workerQueue.Push(fn);
-    workerQueue.Signal();
+    if (!detached)
+    {
+        workerJobsCount++;
+    }
+
+    Function<void()> jobFn = [this, fn, detached]() {
+        if (fn != nullptr)
+        {
+            fn();
+        }
+        if (!detached)
+        {
+            OnWorkerJobExecuted();
+        }
+    };
+
+    std::shared_ptr<JobDetails::Job> job = workerScheduler->CreateJob(jobFn, parent.job);
+
+    Vector<std::shared_ptr<JobDetails::Job>> dependencyJobs;
+    dependencyJobs.reserve(dependencies.size());
+    for (const JobHandle& dependency : dependencies)
+    {
+        dependencyJobs.push_back(dependency.job);
+    }
+
+    workerScheduler->Submit(job, dependencyJobs);
+    return JobHandle(job);
+}
+
+void JobManager::OnWorkerJobExecuted()
+{
+    if (--workerJobsCount == 0)
+    {
+        // Give a chance to WaitWorkerJobs to check if there are some jobs
+        workerDoneSem.Post();
+    }
+}
+
+void JobManager::WaitWorkerJob(const JobHandle& job)
+{
+    if (job.IsValid())
+    {
+        workerScheduler->Wait(job.job);
+    }
+}
+
+void JobManager::ParallelFor(uint32 begin, uint32 end, uint32 grain, const Function<void(uint32, uint32)>& fn)
+{
+    if (begin >= end)
+    {
+        return;
+    }
+
+    grain = std::max(grain, 1U);
+    // sizes are computed from remaining range, so chunk bounds never overflow near UINT32_MAX
+    uint32 count = end - begin;
+    uint32 chunksCount = count / grain + (count % grain != 0 ? 1 : 0);
+    if (chunksCount == 1 || GetWorkersCount() == 0)
+    {
+        fn(begin, end);
+        return;
+    }
+
+    // Root job is never submitted: its own part is finished manually after first chunk is executed
+    std::shared_ptr<JobDetails::Job> root = workerScheduler->CreateJob(Function<void()>(), nullptr);
+    JobHandle rootHandle(root);
+
+    uint32 firstChunkEnd = begin + grain;
+    for (uint32 chunkBegin = firstChunkEnd; chunkBegin < end;)
+    {
+        uint32 chunkEnd = chunkBegin + std::min(end - chunkBegin, grain);
+        CreateChildWorkerJob(rootHandle, [&fn, chunkBegin, chunkEnd]() { fn(chunkBegin, chunkEnd); });
+        chunkBegin = chunkEnd;
+    }
+
+    fn(begin, firstChunkEnd);
+    workerScheduler->FinishPart(root);
+
+    workerScheduler->Wait(root);
 }
 
 void JobManager::WaitWorkerJobs()
@@ -264,6 +351,6 @@ void JobManager::WaitWorkerJobs()
 
 bool JobManager::HasWorkerJobs()
 {
-    return !workerQueue.IsEmpty();
+    return workerJobsCount > 0;
 }
 }
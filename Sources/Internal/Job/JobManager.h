@@ -2,16 +2,31 @@
 
 #include "Base/BaseTypes.h"
 #include "Concurrency/Atomic.h"
+#include "Concurrency/ConditionVariable.h"
 #include "Concurrency/Mutex.h"
 #include "Concurrency/Semaphore.h"
 #include "Concurrency/Thread.h"
 #include "Functional/Function.h"
-#include "Job/JobQueue.h"
+#include "Job/JobHandle.h"
+
+#include <atomic>
 
 namespace DAVA
 {
 class Engine;
-class JobThread;
+namespace JobDetails
+{
+class JobScheduler;
+}
+
+/**
+    Manager of main-thread and worker-thread jobs.
+
+    Worker jobs are executed by work-stealing scheduler: every worker thread has its own queue of jobs
+    and steals jobs from other workers when its queue is empty. Each worker job has a JobHandle,
+    which can be used to wait for this particular job, to start other jobs after it (continuations)
+    or to attach child jobs to it.
+*/
 class JobManager
 {
 public:
@@ -59,10 +74,51 @@ public:
 
     /*! Add function to execute in the worker-thread.
 		\param [in] fn Function to execute.
+        \return Handle of created job.
+	*/
+    JobHandle CreateWorkerJob(const Function<void()>& fn);
+
+    /*! Add function to execute in the worker-thread after all specified jobs are finished.
+		\param [in] fn Function to execute.
+		\param [in] dependencies Jobs to be finished before `fn` is started. Empty handles are ignored.
+        \return Handle of created job.
+	*/
+    JobHandle CreateWorkerJob(const Function<void()>& fn, const Vector<JobHandle>& dependencies);
+
+    /*! Add function to execute in the worker-thread as a child of `parent` job.
+        Parent job is not finished until all its children are finished.
+        Should be called before parent job is finished, e.g. from parent job function.
+		\param [in] parent Parent job.
+		\param [in] fn Function to execute.
+        \return Handle of created job.
+	*/
+    JobHandle CreateChildWorkerJob(const JobHandle& parent, const Function<void()>& fn);
+
+    /*! Add function to execute in the worker-thread, which is not awaited by `WaitWorkerJobs` and not counted by `HasWorkerJobs`.
+        Should be used by subsystems which wait for their jobs themselves, so that unrelated `WaitWorkerJobs` callers aren't blocked by them.
+		\param [in] fn Function to execute.
+        eturn Handle of created job.
 	*/
-    void CreateWorkerJob(const Function<void()>& fn);
+    JobHandle CreateDetachedWorkerJob(const Function<void()>& fn);
 
-    /*! Wait until all worker-thread jobs are executed. */
+    /*! Wait until specified worker job and all its children are finished.
+        Worker thread executes other worker jobs while waiting, so this function can be called from worker job too.
+        Other threads execute only awaited job and its children while waiting and never pick unrelated jobs.
+        Main-thread jobs are not executed while waiting, so awaited jobs should not wait for main-thread jobs.
+		\param [in] job Handle of job to wait.
+	*/
+    void WaitWorkerJob(const JobHandle& job);
+
+    /*! Split range [begin, end) into chunks of `grain` elements and call `fn(chunkBegin, chunkEnd)` for every chunk in worker-threads.
+        Calling thread executes one of chunks itself and returns when all chunks are executed.
+		\param [in] begin First index of range.
+		\param [in] end Index after last index of range.
+		\param [in] grain Max count of indices in chunk.
+		\param [in] fn Function to execute for every chunk.
+	*/
+    void ParallelFor(uint32 begin, uint32 end, uint32 grain, const Function<void(uint32, uint32)>& fn);
+
+    /*! Wait until all worker-thread jobs are executed. Consider waiting for specific jobs by handle with `WaitWorkerJob`. */
     void WaitWorkerJobs();
 
     /*!  Check in there are some not executed worker-thread jobs.
@@ -97,8 +153,11 @@ protected:
     ConditionVariable mainCV;
     MainJob curMainJob;
 
+    JobHandle CreateWorkerJob(const Function<void()>& fn, const JobHandle& parent, const Vector<JobHandle>& dependencies, bool detached = false);
+    void OnWorkerJobExecuted();
+
     Semaphore workerDoneSem;
-    JobQueueWorker workerQueue;
-    Vector<JobThread*> workerThreads;
+    std::atomic<uint32> workerJobsCount{ 0 };
+    JobDetails::JobScheduler* workerScheduler = nullptr;
 };
 }
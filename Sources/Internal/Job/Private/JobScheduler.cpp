@@ -0,0 +1,327 @@
+#include "Job/Private/JobScheduler.h"
+#include "Job/JobHandle.h"
+
+#include "Concurrency/LockGuard.h"
+#include "Concurrency/Thread.h"
+#include "Concurrency/ThreadLocalPtr.h"
+#include "Concurrency/UniqueLock.h"
+#include "Debug/DVAssert.h"
+
+#include <algorithm>
+
+namespace DAVA
+{
+bool JobHandle::IsFinished() const
+{
+    return job == nullptr || job->finished;
+}
+
+JobHandle::JobHandle(const std::shared_ptr<JobDetails::Job>& job_)
+    : job(job_)
+{
+}
+
+namespace JobDetails
+{
+namespace JobSchedulerDetails
+{
+template <typename T>
+void NoDelete(T*)
+{
+}
+
+// Worker owned by current thread, nullptr for non-worker threads
+ThreadLocalPtr<JobScheduler::Worker> currentWorker(&NoDelete<JobScheduler::Worker>);
+}
+
+JobScheduler::JobScheduler(uint32 workersCount)
+{
+    workers.reserve(workersCount);
+    for (uint32 i = 0; i < workersCount; ++i)
+    {
+        Worker* worker = new Worker();
+        worker->scheduler = this;
+        workers.push_back(worker);
+    }
+
+    // Start threads only after all workers are created, as any worker can steal from others
+    for (Worker* worker : workers)
+    {
+        worker->thread = Thread::Create([this, worker]() { WorkerFunc(worker); });
+        worker->thread->SetName("DAVA::JobThread");
+        worker->thread->Start();
+    }
+}
+
+JobScheduler::~JobScheduler()
+{
+    cancelled = true;
+    Wake(true);
+
+    for (Worker* worker : workers)
+    {
+        worker->thread->Join();
+        SafeRelease(worker->thread);
+    }
+
+    for (Worker* worker : workers)
+    {
+        SafeDelete(worker);
+    }
+    workers.clear();
+}
+
+uint32 JobScheduler::GetWorkersCount() const
+{
+    return static_cast<uint32>(workers.size());
+}
+
+JobScheduler::Worker* JobScheduler::GetCurrentWorker() const
+{
+    Worker* worker = JobSchedulerDetails::currentWorker.Get();
+    return (worker != nullptr && worker->scheduler == this) ? worker : nullptr;
+}
+
+std::shared_ptr<Job> JobScheduler::CreateJob(const Function<void()>& fn, const std::shared_ptr<Job>& parent)
+{
+    std::shared_ptr<Job> job = std::make_shared<Job>();
+    job->fn = fn;
+
+    if (parent != nullptr)
+    {
+        DVASSERT(!parent->finished, "Child job can't be attached to already finished job");
+        parent->unfinishedCount++;
+        job->parent = parent;
+    }
+
+    return job;
+}
+
+void JobScheduler::Submit(const std::shared_ptr<Job>& job, const Vector<std::shared_ptr<Job>>& dependencies)
+{
+    for (const std::shared_ptr<Job>& dependency : dependencies)
+    {
+        if (dependency != nullptr)
+        {
+            job->pendingDependencies++;
+
+            LockGuard<Spinlock> guard(dependency->continuationsLock);
+            if (dependency->finished)
+            {
+                job->pendingDependencies--;
+            }
+            else
+            {
+                dependency->continuations.push_back(job);
+            }
+        }
+    }
+
+    ResolveDependency(job);
+}
+
+void JobScheduler::ResolveDependency(const std::shared_ptr<Job>& job)
+{
+    if (--job->pendingDependencies == 0)
+    {
+        Push(job);
+    }
+}
+
+void JobScheduler::FinishPart(const std::shared_ptr<Job>& job)
+{
+    if (--job->unfinishedCount > 0)
+    {
+        return;
+    }
+
+    Vector<std::shared_ptr<Job>> continuations;
+    {
+        LockGuard<Spinlock> guard(job->continuationsLock);
+        job->finished = true;
+        continuations.swap(job->continuations);
+    }
+
+    for (const std::shared_ptr<Job>& continuation : continuations)
+    {
+        ResolveDependency(continuation);
+    }
+
+    std::shared_ptr<Job> parent = std::move(job->parent);
+    if (parent != nullptr)
+    {
+        FinishPart(parent);
+    }
+
+    if (waitersCount > 0)
+    {
+        Wake(true);
+    }
+}
+
+void JobScheduler::Push(const std::shared_ptr<Job>& job)
+{
+    if (workers.empty())
+    {
+        job->fn();
+        job->fn = nullptr;
+        FinishPart(job);
+        return;
+    }
+
+    Worker* worker = GetCurrentWorker();
+    if (worker == nullptr)
+    {
+        worker = workers[nextWorkerIndex++ % workers.size()];
+    }
+
+    {
+        LockGuard<Spinlock> guard(worker->lock);
+        worker->jobs.push_back(job);
+    }
+
+    // Single notification can be consumed by waiter which is not allowed to run this job
+    Wake(waitersCount > 0);
+}
+
+bool JobScheduler::IsDescendant(const Job* job, const Job* root)
+{
+    // Parent chain of not finished job is stable: parent can't finish before its children
+    for (const Job* j = job; j != nullptr; j = j->parent.get())
+    {
+        if (j == root)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool JobScheduler::ExecuteOne(Worker* self, const Job* root)
+{
+    std::shared_ptr<Job> job;
+
+    if (self != nullptr)
+    {
+        LockGuard<Spinlock> guard(self->lock);
+        if (!self->jobs.empty())
+        {
+            job = std::move(self->jobs.back());
+            self->jobs.pop_back();
+        }
+    }
+
+    if (job == nullptr)
+    {
+        uint32 workersCount = static_cast<uint32>(workers.size());
+        uint32 startIndex = nextWorkerIndex.load(std::memory_order_relaxed);
+        for (uint32 i = 0; i < workersCount && job == nullptr; ++i)
+        {
+            Worker* victim = workers[(startIndex + i) % workersCount];
+            if (victim != self)
+            {
+                LockGuard<Spinlock> guard(victim->lock);
+                if (root == nullptr)
+                {
+                    if (!victim->jobs.empty())
+                    {
+                        job = std::move(victim->jobs.front());
+                        victim->jobs.pop_front();
+                    }
+                }
+                else
+                {
+                    auto it = std::find_if(victim->jobs.begin(), victim->jobs.end(), [root](const std::shared_ptr<Job>& j) {
+                        return IsDescendant(j.get(), root);
+                    });
+                    if (it != victim->jobs.end())
+                    {
+                        job = std::move(*it);
+                        victim->jobs.erase(it);
+                    }
+                }
+            }
+        }
+    }
+
+    if (job != nullptr)
+    {
+        job->fn();
+        job->fn = nullptr;
+        FinishPart(job);
+        return true;
+    }
+
+    return false;
+}
+
+void JobScheduler::Wait(const std::shared_ptr<Job>& job)
+{
+    Worker* self = GetCurrentWorker();
+    // Non-worker thread helps only with awaited job subtree and sleeps otherwise
+    const Job* root = (self != nullptr) ? nullptr : job.get();
+
+    waitersCount++;
+    while (!job->finished)
+    {
+        uint64 observedGeneration = generation;
+        if (job->finished)
+        {
+            break;
+        }
+
+        if (!ExecuteOne(self, root))
+        {
+            Sleep(observedGeneration);
+        }
+    }
+    waitersCount--;
+}
+
+void JobScheduler::WorkerFunc(Worker* worker)
+{
+    JobSchedulerDetails::currentWorker.Reset(worker);
+
+    while (!cancelled)
+    {
+        uint64 observedGeneration = generation;
+        if (!ExecuteOne(worker, nullptr))
+        {
+            Sleep(observedGeneration);
+        }
+    }
+
+    JobSchedulerDetails::currentWorker.Release();
+}
+
+void JobScheduler::Wake(bool all)
+{
+    generation++;
+    if (sleepersCount > 0)
+    {
+        LockGuard<Mutex> guard(sleepMutex);
+        if (all)
+        {
+            sleepCV.NotifyAll();
+        }
+        else
+        {
+            sleepCV.NotifyOne();
+        }
+    }
+}
+
+void JobScheduler::Sleep(uint64 observedGeneration)
+{
+    sleepersCount++;
+    {
+        UniqueLock<Mutex> lock(sleepMutex);
+        while (generation == observedGeneration && !cancelled)
+        {
+            sleepCV.Wait(lock);
+        }
+    }
+    sleepersCount--;
+}
+}
+}
@@ -0,0 +1,100 @@
+#pragma once
+
+#include "Base/BaseTypes.h"
+#include "Concurrency/ConditionVariable.h"
+#include "Concurrency/Mutex.h"
+#include "Concurrency/Spinlock.h"
+#include "Functional/Function.h"
+
+#include <atomic>
+#include <memory>
+
+namespace DAVA
+{
+class Thread;
+
+namespace JobDetails
+{
+struct Job
+{
+    Function<void()> fn;
+    std::shared_ptr<Job> parent;
+
+    // Job's own function and every attached child job are counted as unfinished parts
+    std::atomic<int32> unfinishedCount{ 1 };
+
+    // Unfinished dependencies plus one extra reference held while job is being submitted
+    std::atomic<int32> pendingDependencies{ 1 };
+
+    std::atomic<bool> finished{ false };
+
+    Spinlock continuationsLock;
+    Vector<std::shared_ptr<Job>> continuations;
+};
+
+/**
+    Work-stealing scheduler used by JobManager for worker jobs.
+
+    Every worker thread owns a deque of ready jobs. Worker pushes and pops jobs at the back of its own deque
+    and steals from the front of other workers' deques when its own deque is empty.
+    Jobs submitted from non-worker threads are distributed between workers' deques round-robin.
+    Idle workers sleep on condition variable and are woken up when new job is pushed.
+*/
+class JobScheduler final
+{
+public:
+    JobScheduler(uint32 workersCount);
+    ~JobScheduler();
+
+    uint32 GetWorkersCount() const;
+
+    /** Create job which becomes a child of `parent` (if any). Job is not executed until it is submitted. */
+    std::shared_ptr<Job> CreateJob(const Function<void()>& fn, const std::shared_ptr<Job>& parent);
+
+    /** Schedule `job` for execution after all `dependencies` are finished. */
+    void Submit(const std::shared_ptr<Job>& job, const Vector<std::shared_ptr<Job>>& dependencies);
+
+    /** Mark one unfinished part of `job` as finished. Used for jobs which own function is executed manually. */
+    void FinishPart(const std::shared_ptr<Job>& job);
+
+    /**
+        Block until `job` is finished.
+        Worker thread executes any ready jobs while waiting. Other threads (e.g. main) execute only `job`
+        and its child jobs, so unrelated long jobs (loading, conversion) are never run on them.
+    */
+    void Wait(const std::shared_ptr<Job>& job);
+
+    struct Worker
+    {
+        JobScheduler* scheduler = nullptr;
+        Thread* thread = nullptr;
+
+        Spinlock lock;
+        Deque<std::shared_ptr<Job>> jobs;
+    };
+
+private:
+    void WorkerFunc(Worker* worker);
+
+    Worker* GetCurrentWorker() const;
+    void Push(const std::shared_ptr<Job>& job);
+    bool ExecuteOne(Worker* self, const Job* root);
+    static bool IsDescendant(const Job* job, const Job* root);
+    void ResolveDependency(const std::shared_ptr<Job>& job);
+
+    void Wake(bool all);
+    void Sleep(uint64 observedGeneration);
+
+    Vector<Worker*> workers;
+    std::atomic<uint32> nextWorkerIndex{ 0 };
+
+    std::atomic<uint64> generation{ 0 };
+    std::atomic<uint32> sleepersCount{ 0 };
+    std::atomic<uint32> waitersCount{ 0 };
+    std::atomic<bool> cancelled{ false };
+
+    Mutex sleepMutex;
+    ConditionVariable sleepCV;
+};
+}
+}
@@ -1,4 +1,5 @@
 #include "Logger/Logger.h"
+#include "Logger/Private/LoggerFileWriter.h"
 #include "Engine/Engine.h"
 #include "FileSystem/FileSystem.h"
 #include "Debug/DVAssert.h"
@@ -100,11 +101,14 @@ Logger::Logger()
     : logLevel{ LEVEL_FRAMEWORK }
     , consoleModeEnabled{ false }
 {
+    fileWriter.reset(new LoggerFileWriter([this](const FilePath& filepath) { CutOldLogFileIfExist(filepath); }));
     SetLogFilename(String());
 }
 
 Logger::~Logger()
 {
+    fileWriter.reset();
+
     for (auto logOutput : customOutputs)
     {
         delete logOutput;
@@ -321,6 +325,9 @@ void Logger::SetLogFilename(const String& filename)
 
 void Logger::SetLogPathname(const FilePath& filepath)
 {
+    // pending messages of the file should be written and file should be closed before cutting
+    fileWriter->Flush(true);
+
     const bool canWorkWithFile = CutOldLogFileIfExist(filepath);
     DVASSERT(canWorkWithFile);
 
@@ -333,6 +340,11 @@ FilePath Logger::GetLogPathForFilename(const String& filename)
     return logFilePath;
 }
 
+void Logger::Flush()
+{
+    fileWriter->Flush(true);
+}
+
 void Logger::SetMaxFileSize(uint32 size)
 {
     cutLogSize = size;
@@ -411,19 +423,12 @@ void Logger::FileLog(const FilePath& customLogFileName, eLogLevel ll, const char
 {
     if (nullptr != FileSystem::Instance())
     {
-        ScopedPtr<File> file(File::Create(customLogFileName, File::APPEND | File::WRITE));
-        if (file)
+        // custom log files are cut by writer before opening
+        fileWriter->Push(customLogFileName, ll, text, customLogFileName != logFilename);
+        if (ll == LEVEL_ERROR)
         {
-            Array<char8, 128> prefix;
-
-            time_t timestamp = time(nullptr); //Time in UTC format
-            int32 seconds = timestamp % 60;
-            int32 minutes = (timestamp / 60) % 60;
-            int32 hours = (timestamp / (60 * 60)) % 24;
-
-            Snprintf(&prefix[0], prefix.size(), "%02d:%02d:%02d [%s] ", hours, minutes, seconds, GetLogLevelString(ll));
-            file->Write(prefix.data(), static_cast<uint32>(strlen(prefix.data())));
-            file->Write(text, static_cast<uint32>(strlen(text)));
+            // error may be followed by crash or abort, write it right now
+            fileWriter->Flush(false);
         }
     }
 }
@@ -473,10 +478,6 @@ void Logger::Output(const FilePath& customLogFilename, eLogLevel ll, const char8
 
         if (!customLogFilename.IsEmpty())
         {
-            if (customLogFilename != logFilename)
-            {
-                CutOldLogFileIfExist(customLogFilename);
-            }
             FileLog(customLogFilename, ll, formatedMsg);
         }
     }
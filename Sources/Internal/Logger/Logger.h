@@ -18,6 +18,7 @@
 namespace DAVA
 {
 class LoggerOutput;
+class LoggerFileWriter;
 
 class Logger
 {
@@ -107,6 +108,10 @@ public:
     static void SetTag(const char8* logTag);
 #endif
 
+    //! Writes all pending messages to log files and closes them. Messages are written to files by background
+    //! thread, call this method from crash handlers or before reading log files. Errors are flushed automatically.
+    void Flush();
+
     static FilePath GetLogPathForFilename(const String& filename);
     void SetMaxFileSize(uint32 size);
     void EnableConsoleMode();
@@ -130,6 +135,7 @@ private:
     Vector<LoggerOutput*> customOutputs;
     bool consoleModeEnabled;
     uint32 cutLogSize = 512 * 1024; //0.5 MB;
+    std::unique_ptr<LoggerFileWriter> fileWriter;
 };
 
 class LoggerOutput
@@ -0,0 +1,227 @@
+#include "Logger/Private/LoggerFileWriter.h"
+#include "Concurrency/LockGuard.h"
+#include "Concurrency/Thread.h"
+#include "FileSystem/File.h"
+#include "FileSystem/FileSystem.h"
+#include "Utils/Utils.h"
+
+namespace DAVA
+{
+LoggerFileWriter::LoggerFileWriter(const Function<void(const FilePath&)>& cutFile_)
+    : cutFile(cutFile_)
+    , ring(RING_SIZE)
+{
+    static_assert((RING_SIZE & (RING_SIZE - 1)) == 0, "RING_SIZE must be power of two");
+
+    for (size_t i = 0; i < ring.size(); ++i)
+    {
+        ring[i].sequence.store(i, std::memory_order_relaxed);
+    }
+}
+
+LoggerFileWriter::~LoggerFileWriter()
+{
+    Thread* writerThread = thread.load();
+    if (writerThread != nullptr)
+    {
+        {
+            LockGuard<Mutex> lock(wakeMutex);
+            stopRequested = true;
+        }
+        wakeCondition.NotifyOne();
+
+        writerThread->Join();
+        SafeRelease(writerThread);
+        thread = nullptr;
+    }
+
+    Flush(true);
+}
+
+void LoggerFileWriter::Push(const FilePath& filepath, Logger::eLogLevel ll, const char8* text, bool limitSize)
+{
+    if (thread.load(std::memory_order_acquire) == nullptr)
+    {
+        StartThread();
+    }
+
+    // Bounded MPMC queue by D. Vyukov: slot sequence equal to position means slot is free for producer,
+    // position + 1 means slot is filled and can be taken by consumer
+    Record* record = nullptr;
+    size_t pos = enqueuePos.load(std::memory_order_relaxed);
+    for (;;)
+    {
+        record = &ring[pos & (RING_SIZE - 1)];
+        size_t sequence = record->sequence.load(std::memory_order_acquire);
+        intptr_t diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos);
+        if (diff == 0)
+        {
+            if (enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+            {
+                break;
+            }
+        }
+        else if (diff < 0)
+        {
+            // ring is full, writer thread can't wait for itself
+            if (IsWriterThread())
+            {
+                return;
+            }
+            wakeCondition.NotifyOne();
+            Thread::Yield();
+            pos = enqueuePos.load(std::memory_order_relaxed);
+        }
+        else
+        {
+            pos = enqueuePos.load(std::memory_order_relaxed);
+        }
+    }
+
+    // assignments reuse memory of previous record in slot
+    record->level = ll;
+    record->timestamp = time(nullptr);
+    record->limitSize = limitSize;
+    record->filepath = filepath;
+    record->text = text;
+    record->sequence.store(pos + 1, std::memory_order_release);
+
+    if ((pos + 1) % BATCH_RECORDS == 0)
+    {
+        wakeCondition.NotifyOne();
+    }
+}
+
+void LoggerFileWriter::Flush(bool closeFiles)
+{
+    // records pushed from writer thread are written by its current batch
+    if (IsWriterThread())
+    {
+        return;
+    }
+
+    LockGuard<Mutex> lock(consumerMutex);
+    WriteRecords();
+    CloseFiles(!closeFiles);
+}
+
+void LoggerFileWriter::StartThread()
+{
+    LockGuard<Mutex> lock(startMutex);
+    if (thread.load() == nullptr)
+    {
+        Thread* writerThread = Thread::Create(MakeFunction(this, &LoggerFileWriter::ThreadFunction));
+        writerThread->SetName("LoggerFileWriter");
+        writerThread->Start();
+        thread.store(writerThread, std::memory_order_release);
+    }
+}
+
+void LoggerFileWriter::ThreadFunction()
+{
+    UniqueLock<Mutex> wakeLock(wakeMutex);
+    while (!stopRequested)
+    {
+        wakeCondition.WaitFor(wakeLock, FLUSH_INTERVAL_MS);
+        wakeLock.Unlock();
+
+        {
+            LockGuard<Mutex> lock(consumerMutex);
+            WriteRecords();
+            CloseFiles(true);
+        }
+
+        wakeLock.Lock();
+    }
+}
+
+bool LoggerFileWriter::IsWriterThread() const
+{
+    Thread* writerThread = thread.load(std::memory_order_acquire);
+    return writerThread != nullptr && Thread::Current() == writerThread;
+}
+
+void LoggerFileWriter::WriteRecords()
+{
+    const bool canWrite = FileSystem::Instance() != nullptr;
+
+    for (;;)
+    {
+        Record& record = ring[dequeuePos & (RING_SIZE - 1)];
+        if (record.sequence.load(std::memory_order_acquire) != dequeuePos + 1)
+        {
+            break; // ring is empty or next record is not completely pushed yet
+        }
+
+        if (canWrite)
+        {
+            OpenedFile& openedFile = files[record.filepath.GetAbsolutePathname()];
+            if (openedFile.file == nullptr)
+            {
+                if (record.limitSize)
+                {
+                    cutFile(record.filepath);
+                }
+                openedFile.file = File::Create(record.filepath, File::APPEND | File::WRITE);
+                openedFile.limitSize = record.limitSize;
+            }
+
+            Array<char8, 128> prefix;
+
+            time_t timestamp = record.timestamp; //Time in UTC format
+            int32 seconds = timestamp % 60;
+            int32 minutes = (timestamp / 60) % 60;
+            int32 hours = (timestamp / (60 * 60)) % 24;
+
+            Snprintf(&prefix[0], prefix.size(), "%02d:%02d:%02d [%s] ", hours, minutes, seconds, Logger::GetLogLevelString(record.level));
+            openedFile.buffer += prefix.data();
+            openedFile.buffer += record.text;
+
+            if (openedFile.buffer.size() >= WRITE_CHUNK_SIZE)
+            {
+                WriteBuffer(openedFile);
+            }
+        }
+
+        // don't keep memory of occasional huge messages
+        if (record.text.capacity() > WRITE_CHUNK_SIZE)
+        {
+            String().swap(record.text);
+        }
+
+        record.sequence.store(dequeuePos + RING_SIZE, std::memory_order_release);
+        ++dequeuePos;
+    }
+
+    for (auto& entry : files)
+    {
+        WriteBuffer(entry.second);
+    }
+}
+
+void LoggerFileWriter::WriteBuffer(OpenedFile& openedFile)
+{
+    if (openedFile.file != nullptr && !openedFile.buffer.empty())
+    {
+        openedFile.file->Write(openedFile.buffer.data(), static_cast<uint32>(openedFile.buffer.size()));
+        openedFile.file->Flush();
+    }
+    openedFile.buffer.clear();
+}
+
+void LoggerFileWriter::CloseFiles(bool limitedOnly)
+{
+    for (auto it = files.begin(); it != files.end();)
+    {
+        if (!limitedOnly || it->second.limitSize)
+        {
+            SafeRelease(it->second.file);
+            it = files.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+}
+}
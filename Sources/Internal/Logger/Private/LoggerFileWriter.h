@@ -0,0 +1,94 @@
+#pragma once
+
+#include "Base/BaseTypes.h"
+#include "Concurrency/ConditionVariable.h"
+#include "Concurrency/Mutex.h"
+#include "FileSystem/FilePath.h"
+#include "Functional/Function.h"
+#include "Logger/Logger.h"
+
+#include <atomic>
+#include <ctime>
+
+namespace DAVA
+{
+class File;
+class Thread;
+
+/**
+    Background sink for Logger file output.
+
+    Any thread pushes formatted messages into lock-free bounded ring, single writer thread keeps log files
+    open and writes accumulated records by large chunks. Writer wakes up when batch of records is pushed
+    or by timer, so short bursts of messages reach the disk with small delay.
+    `Flush` writes pending records on calling thread, use it before reading log files or before crash.
+*/
+class LoggerFileWriter final
+{
+public:
+    static const uint32 RING_SIZE = 2048; //<! Must be power of two
+    static const uint32 BATCH_RECORDS = 256; //<! Wake writer thread each time so many records are pushed
+    static const uint32 FLUSH_INTERVAL_MS = 200; //<! Max delay between push and write
+    static const uint32 WRITE_CHUNK_SIZE = 64 * 1024; //<! Max bytes accumulated in memory for one file
+
+    /** `cutFile` is called on writing thread each time file with size limit is going to be opened */
+    explicit LoggerFileWriter(const Function<void(const FilePath&)>& cutFile);
+    ~LoggerFileWriter();
+
+    LoggerFileWriter(const LoggerFileWriter&) = delete;
+    LoggerFileWriter& operator=(const LoggerFileWriter&) = delete;
+
+    /**
+        Enqueue message, `text` should already contain trailing newline.
+        Files pushed with `limitSize` are closed after each batch and cut before next open.
+        Blocks only when ring is full, message is dropped if ring is full and it is pushed by writer thread itself.
+    */
+    void Push(const FilePath& filepath, Logger::eLogLevel ll, const char8* text, bool limitSize);
+
+    /** Write records pushed by this moment, does nothing on writer thread */
+    void Flush(bool closeFiles);
+
+private:
+    struct Record
+    {
+        std::atomic<size_t> sequence;
+        Logger::eLogLevel level = Logger::LEVEL_FRAMEWORK;
+        time_t timestamp = 0;
+        bool limitSize = false;
+        FilePath filepath;
+        String text;
+    };
+
+    struct OpenedFile
+    {
+        File* file = nullptr;
+        bool limitSize = false;
+        String buffer;
+    };
+
+    void StartThread();
+    void ThreadFunction();
+    bool IsWriterThread() const;
+
+    // Must be called with consumerMutex locked
+    void WriteRecords();
+    void WriteBuffer(OpenedFile& openedFile);
+    void CloseFiles(bool limitedOnly);
+
+    Function<void(const FilePath&)> cutFile;
+
+    Vector<Record> ring;
+    std::atomic<size_t> enqueuePos{ 0 };
+
+    Mutex consumerMutex;
+    size_t dequeuePos = 0;
+    Map<String, OpenedFile> files;
+
+    Mutex wakeMutex;
+    ConditionVariable wakeCondition;
+    bool stopRequested = false;
+
+    Mutex startMutex;
+    std::atomic<Thread*> thread{ nullptr };
+};
+}
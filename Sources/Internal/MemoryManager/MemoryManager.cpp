@@ -49,8 +49,8 @@ struct MemoryManager::MemoryBlock
     MemoryBlock* prev; // Pointer to previous block
     MemoryBlock* next; // Pointer to next block
     void* realBlockStart; // Pointer to real block start
-    void* padding1; // Padding to make sure that
-    uint32 padding2; //          struct size is integral multiple of 16 bytes
+    ThreadContext* context; // Context of thread which has allocated block and owns it in its block list
+    uint32 padding; // Padding to make sure that struct size is integral multiple of 16 bytes
     uint32 orderNo; // Block order number
     uint32 allocByApp; // Size requested by application
     uint32 allocTotal; // Total allocated size
@@ -72,12 +72,31 @@ static_assert(sizeof(MemoryManager::InternalMemoryBlock) % 16 == 0, "sizeof(Memo
 
 struct MemoryManager::Backtrace
 {
-    size_t nref;
     uint32 hash;
-    bool symbolsCollected;
     Array<void*, BACKTRACE_DEPTH> frames;
 };
 
+struct MemoryManager::BacktraceSlot
+{
+    std::atomic<uint32> hash; // BACKTRACE_FREE_SLOT for never used slot, BACKTRACE_TOMBSTONE for reclaimed slot
+    std::atomic<uint32> nref; // Number of alive blocks with this backtrace, BACKTRACE_RECLAIM_BIT is set while slot is reclaimed
+    std::atomic<uint32> generation; // Incremented on each reclaim, lets readers detect that slot was reused while they copied frames
+    std::atomic<bool> ready; // Set by thread which has taken slot after frames are copied
+    std::atomic<bool> symbolsCollected;
+    std::atomic<Backtrace*> backtrace; // Allocated on first use of slot, reused after reclaim and never freed
+};
+
+struct MemoryManager::ThreadContext
+{
+    ThreadContext* nextContext = nullptr; // Next context in MemoryManager::contextList
+    std::atomic<bool> inUse{ true }; // Cleared when owner thread exits, free context is reused by next new thread
+    MutexType mutex; // Taken by owner thread on each allocation, by other threads to free owned blocks or to read statistics
+    MemoryBlock* head = nullptr; // Linked list of blocks allocated by thread
+    uint32 bktraceSampleCounter = 0; // Accessed only by owner thread
+    AllocPoolStat statAllocPool[MAX_ALLOC_POOL_COUNT] = {}; // Statistics of owned blocks by allocation pools
+    TagAllocStat statTag[MAX_TAG_COUNT] = {}; // Statistics of owned blocks by tags
+};
+
 struct MemoryManager::AllocScopeItem
 {
     AllocScopeItem* next;
@@ -162,6 +181,12 @@ void MemoryManager::EnableLightWeightMode()
     lightWeightMode = true;
 }
 
+void MemoryManager::SetBacktraceSampling(uint32 rate)
+{
+    DVASSERT(rate > 0);
+    bktraceSamplingRate.store(rate > 0 ? rate : 1, std::memory_order_relaxed);
+}
+
 void MemoryManager::SetCallbacks(Function<void()> updateCallback_, Function<void(uint32, bool)> tagCallback_)
 {
     updateCallback = updateCallback_;
@@ -227,26 +252,22 @@ DAVA_NOINLINE void* MemoryManager::Allocate(size_t size, uint32 poolIndex)
             }
         }
 
-        {
-            LockType lock(allocMutex);
-            block->tags = statGeneral.activeTags;
-            block->orderNo = statGeneral.nextBlockNo++;
-            InsertBlock(block);
-        }
-        {
-            uint32 systemMemoryUsage = GetSystemMemoryUsage();
-            LockType lock(statMutex);
-            UpdateStatAfterAlloc(block, systemMemoryUsage);
-        }
-        if (!lightWeightMode)
+        ThreadContext* context = GetThreadContext();
+        block->context = context;
+        block->tags = activeTags.load(std::memory_order_relaxed);
+        block->orderNo = nextBlockNo.fetch_add(1, std::memory_order_relaxed);
+        if (IsBacktraceSampled(context))
         {
             Backtrace backtrace;
             CollectBacktrace(&backtrace, 1);
             block->bktraceHash = backtrace.hash;
-
-            LockType lock(bktraceMutex);
             InsertBacktrace(backtrace);
         }
+        {
+            LockType lock(context->mutex);
+            InsertBlock(context, block);
+            UpdateStatAfterAlloc(context, block);
+        }
         return static_cast<void*>(block + 1);
     }
     return nullptr;
@@ -296,26 +317,22 @@ DAVA_NOINLINE void* MemoryManager::AlignedAllocate(size_t size, size_t align, ui
             }
         }
 
-        {
-            LockType lock(allocMutex);
-            block->tags = statGeneral.activeTags;
-            block->orderNo = statGeneral.nextBlockNo++;
-            InsertBlock(block);
-        }
-        {
-            uint32 systemMemoryUsage = GetSystemMemoryUsage();
-            LockType lock(statMutex);
-            UpdateStatAfterAlloc(block, systemMemoryUsage);
-        }
-        if (!lightWeightMode)
+        ThreadContext* context = GetThreadContext();
+        block->context = context;
+        block->tags = activeTags.load(std::memory_order_relaxed);
+        block->orderNo = nextBlockNo.fetch_add(1, std::memory_order_relaxed);
+        if (IsBacktraceSampled(context))
         {
             Backtrace backtrace;
             CollectBacktrace(&backtrace, 1);
             block->bktraceHash = backtrace.hash;
-
-            LockType lock(bktraceMutex);
             InsertBacktrace(backtrace);
         }
+        {
+            LockType lock(context->mutex);
+            InsertBlock(context, block);
+            UpdateStatAfterAlloc(context, block);
+        }
         return reinterpret_cast<void*>(aligned);
     }
     return nullptr;
@@ -426,17 +443,14 @@ void MemoryManager::Deallocate(void* ptr)
         if (isAccessible && BLOCK_MARK == block->mark)
         {
             {
-                LockType lock(allocMutex);
-                RemoveBlock(block);
+                // Block may be freed by any thread, it is removed from the list and statistics of its owner
+                ThreadContext* context = block->context;
+                LockType lock(context->mutex);
+                RemoveBlock(context, block);
+                UpdateStatAfterDealloc(context, block);
             }
+            if (block->bktraceHash != 0)
             {
-                uint32 systemMemoryUsage = GetSystemMemoryUsage();
-                LockType lock(statMutex);
-                UpdateStatAfterDealloc(block, systemMemoryUsage);
-            }
-            if (!lightWeightMode)
-            {
-                LockType lock(bktraceMutex);
                 RemoveBacktrace(block->bktraceHash);
             }
 
@@ -547,8 +561,22 @@ uint32 MemoryManager::GetTrackedMemoryUsage(uint32 poolIndex) const
 {
     assert(ALLOC_POOL_TOTAL <= poolIndex && poolIndex < MAX_ALLOC_POOL_COUNT);
 
-    LockType lock(statMutex);
-    return statAllocPool[poolIndex].allocByApp;
+    if (ALLOC_POOL_SYSTEM == poolIndex)
+    {
+        return GetSystemMemoryUsage();
+    }
+
+    uint32 result = 0;
+    {
+        LockType lock(gpuMutex);
+        result += statGpuAllocPool[poolIndex].allocByApp;
+    }
+    for (ThreadContext* context = contextList.load(std::memory_order_acquire); context != nullptr; context = context->nextContext)
+    {
+        LockType lock(context->mutex);
+        result += context->statAllocPool[poolIndex].allocByApp;
+    }
+    return result;
 }
 
 uint32 MemoryManager::GetTaggedMemoryUsage(uint32 tagIndex) const
@@ -559,18 +587,23 @@ uint32 MemoryManager::GetTaggedMemoryUsage(uint32 tagIndex) const
 
     DVASSERT(index < MAX_TAG_COUNT);
 
-    LockType lock(statMutex);
-    return statTag[index].allocByApp;
+    uint32 result = 0;
+    for (ThreadContext* context = contextList.load(std::memory_order_acquire); context != nullptr; context = context->nextContext)
+    {
+        LockType lock(context->mutex);
+        result += context->statTag[index].allocByApp;
+    }
+    return result;
 }
 
 void MemoryManager::EnterTagScope(uint32 tag)
 {
     DVASSERT(tag != 0 && IsPowerOf2(tag));
-    DVASSERT((statGeneral.activeTags & tag) == 0); // Tag shouldn't be set earlier
+    DVASSERT((activeTags.load() & tag) == 0); // Tag shouldn't be set earlier
 
+    activeTags.fetch_or(tag);
     {
-        LockType lock(allocMutex);
-        statGeneral.activeTags |= tag;
+        LockType lock(statMutex);
         statGeneral.activeTagCount += 1;
     }
     if (tagCallback != nullptr)
@@ -582,11 +615,11 @@ void MemoryManager::EnterTagScope(uint32 tag)
 void MemoryManager::LeaveTagScope(uint32 tag)
 {
     DVASSERT(tag != 0 && IsPowerOf2(tag));
-    DVASSERT((statGeneral.activeTags & tag) == tag); // Tag should be set earlier
+    DVASSERT((activeTags.load() & tag) == tag); // Tag should be set earlier
 
+    activeTags.fetch_and(~tag);
     {
-        LockType lock(allocMutex);
-        statGeneral.activeTags &= ~tag;
+        LockType lock(statMutex);
         statGeneral.activeTagCount -= 1;
     }
     if (tagCallback != nullptr)
@@ -639,10 +672,7 @@ void MemoryManager::TrackGpuAlloc(uint32 id, size_t size, uint32 gpuPoolIndex)
     gpuBlock.allocByApp += static_cast<uint32>(size);
     gpuBlock.allocTotal = gpuBlock.allocByApp;
     gpuBlock.mark += 1; // Make use field 'mark' as number of GPU allocations with given id and pool index
-    {
-        LockType lock(statMutex);
-        UpdateStatAfterGPUAlloc(&gpuBlock, size);
-    }
+    UpdateStatAfterGPUAlloc(&gpuBlock, size);
 }
 
 void MemoryManager::TrackGpuDealloc(uint32 id, uint32 gpuPoolIndex)
@@ -654,15 +684,91 @@ void MemoryManager::TrackGpuDealloc(uint32 id, uint32 gpuPoolIndex)
     DVASSERT(iter != gpuBlockMap->end());
 
     MemoryBlock& gpuBlock = iter->second;
+    UpdateStatAfterGPUDealloc(&gpuBlock);
+    gpuBlockMap->erase(iter);
+}
+
+MemoryManager::ThreadContext* MemoryManager::GetThreadContext()
+{
+    if (!tlsContext.IsCreated())
+    { // Without thread local storage all threads share one context, its lock still keeps block list and statistics consistent
+        ThreadContext* context = sharedContext.load(std::memory_order_acquire);
+        if (nullptr == context)
+        {
+            ThreadContext* newContext = AcquireThreadContext();
+            if (sharedContext.compare_exchange_strong(context, newContext, std::memory_order_acq_rel))
+            {
+                context = newContext;
+            }
+            else
+            { // Other thread has set shared context first
+                newContext->inUse.store(false, std::memory_order_release);
+            }
+        }
+        return context;
+    }
+
+    ThreadContext* context = tlsContext.Get();
+    if (nullptr == context)
     {
-        LockType lock(statMutex);
-        UpdateStatAfterGPUDealloc(&gpuBlock);
+        context = AcquireThreadContext();
+        tlsContext.Reset(context);
     }
-    gpuBlockMap->erase(iter);
+    return context;
 }
 
-void MemoryManager::InsertBlock(MemoryBlock* block)
+MemoryManager::ThreadContext* MemoryManager::AcquireThreadContext()
 {
+    // Contexts of exited threads are reused with blocks which are still alive, so short-lived threads do not grow context list
+    for (ThreadContext* context = contextList.load(std::memory_order_acquire); context != nullptr; context = context->nextContext)
+    {
+        bool inUse = false;
+        if (!context->inUse.load(std::memory_order_relaxed) && context->inUse.compare_exchange_strong(inUse, true, std::memory_order_acquire))
+        {
+            context->bktraceSampleCounter = 0;
+            return context;
+        }
+    }
+
+    ThreadContext* context = new (InternalAllocate(sizeof(ThreadContext))) ThreadContext();
+
+    // Context is never unlinked and freed: blocks allocated by thread may outlive it
+    ThreadContext* first = contextList.load(std::memory_order_relaxed);
+    do
+    {
+        context->nextContext = first;
+    } while (!contextList.compare_exchange_weak(first, context, std::memory_order_release, std::memory_order_relaxed));
+    return context;
+}
+
+void MemoryManager::ReleaseThreadContext()
+{
+    if (tlsContext.IsCreated())
+    {
+        ThreadContext* context = tlsContext.Release();
+        if (context != nullptr)
+        {
+            context->inUse.store(false, std::memory_order_release);
+        }
+    }
+}
+
+bool MemoryManager::IsBacktraceSampled(ThreadContext* context)
+{
+    if (lightWeightMode)
+        return false;
+
+    context->bktraceSampleCounter += 1;
+    if (context->bktraceSampleCounter < bktraceSamplingRate.load(std::memory_order_relaxed))
+        return false;
+
+    context->bktraceSampleCounter = 0;
+    return true;
+}
+
+void MemoryManager::InsertBlock(ThreadContext* context, MemoryBlock* block)
+{
+    MemoryBlock*& head = context->head;
     if (head != nullptr)
     {
         block->next = head;
@@ -678,22 +784,21 @@ void MemoryManager::InsertBlock(MemoryBlock* block)
     }
 }
 
-void MemoryManager::RemoveBlock(MemoryBlock* block)
+void MemoryManager::RemoveBlock(ThreadContext* context, MemoryBlock* block)
 {
     if (block->prev != nullptr)
         block->prev->next = block->next;
     if (block->next != nullptr)
         block->next->prev = block->prev;
-    if (block == head)
-        head = head->next;
+    if (block == context->head)
+        context->head = context->head->next;
 }
 
-void MemoryManager::UpdateStatAfterAlloc(MemoryBlock* block, uint32 systemMemoryUsage)
+void MemoryManager::UpdateStatAfterAlloc(ThreadContext* context, MemoryBlock* block)
 {
-    { // Update memory usage reported by system
-        statAllocPool[ALLOC_POOL_SYSTEM].allocByApp = systemMemoryUsage;
-        statAllocPool[ALLOC_POOL_SYSTEM].allocTotal = systemMemoryUsage;
-    }
+    AllocPoolStat* statAllocPool = context->statAllocPool;
+    TagAllocStat* statTag = context->statTag;
+
     { // Update total statistics
         statAllocPool[ALLOC_POOL_TOTAL].allocByApp += block->allocByApp;
         statAllocPool[ALLOC_POOL_TOTAL].allocTotal += block->allocTotal;
@@ -713,7 +818,7 @@ void MemoryManager::UpdateStatAfterAlloc(MemoryBlock* block, uint32 systemMemory
     }
 
     { // Update tag statistics
-        uint32 tags = statGeneral.activeTags;
+        uint32 tags = block->tags;
         if (tags != 0)
         {
             for (size_t index = 0; tags != 0; ++index, tags >>= 1)
@@ -733,12 +838,11 @@ void MemoryManager::UpdateStatAfterAlloc(MemoryBlock* block, uint32 systemMemory
     }
 }
 
-void MemoryManager::UpdateStatAfterDealloc(MemoryBlock* block, uint32 systemMemoryUsage)
+void MemoryManager::UpdateStatAfterDealloc(ThreadContext* context, MemoryBlock* block)
 {
-    { // Update memory usage reported by system
-        statAllocPool[ALLOC_POOL_SYSTEM].allocByApp = systemMemoryUsage;
-        statAllocPool[ALLOC_POOL_SYSTEM].allocTotal = systemMemoryUsage;
-    }
+    AllocPoolStat* statAllocPool = context->statAllocPool;
+    TagAllocStat* statTag = context->statTag;
+
     { // Update total statistics
         statAllocPool[ALLOC_POOL_TOTAL].allocByApp -= block->allocByApp;
         statAllocPool[ALLOC_POOL_TOTAL].allocTotal -= block->allocTotal;
@@ -774,69 +878,205 @@ void MemoryManager::UpdateStatAfterDealloc(MemoryBlock* block, uint32 systemMemo
 void MemoryManager::UpdateStatAfterGPUAlloc(MemoryBlock* block, size_t sizeIncr)
 {
     { // Update total statistics
-        statAllocPool[ALLOC_POOL_TOTAL].allocByApp += static_cast<uint32>(sizeIncr);
-        statAllocPool[ALLOC_POOL_TOTAL].allocTotal += static_cast<uint32>(sizeIncr);
+        statGpuAllocPool[ALLOC_POOL_TOTAL].allocByApp += static_cast<uint32>(sizeIncr);
+        statGpuAllocPool[ALLOC_POOL_TOTAL].allocTotal += static_cast<uint32>(sizeIncr);
     }
     { // Update pool statistics
-        statAllocPool[block->pool].allocByApp += static_cast<uint32>(sizeIncr);
-        statAllocPool[block->pool].allocTotal += static_cast<uint32>(sizeIncr);
-        statAllocPool[block->pool].blockCount += 1;
+        statGpuAllocPool[block->pool].allocByApp += static_cast<uint32>(sizeIncr);
+        statGpuAllocPool[block->pool].allocTotal += static_cast<uint32>(sizeIncr);
+        statGpuAllocPool[block->pool].blockCount += 1;
 
-        if (block->allocByApp > statAllocPool[block->pool].maxBlockSize)
-            statAllocPool[block->pool].maxBlockSize = block->allocByApp;
+        if (block->allocByApp > statGpuAllocPool[block->pool].maxBlockSize)
+            statGpuAllocPool[block->pool].maxBlockSize = block->allocByApp;
     }
 }
 
 void MemoryManager::UpdateStatAfterGPUDealloc(MemoryBlock* block)
 {
     { // Update total statistics
-        statAllocPool[ALLOC_POOL_TOTAL].allocByApp -= block->allocByApp;
-        statAllocPool[ALLOC_POOL_TOTAL].allocTotal -= block->allocTotal;
+        statGpuAllocPool[ALLOC_POOL_TOTAL].allocByApp -= block->allocByApp;
+        statGpuAllocPool[ALLOC_POOL_TOTAL].allocTotal -= block->allocTotal;
     }
     { // Update pool statistics
-        statAllocPool[block->pool].allocByApp -= block->allocByApp;
-        statAllocPool[block->pool].allocTotal -= block->allocTotal;
-        statAllocPool[block->pool].blockCount -= block->mark;
+        statGpuAllocPool[block->pool].allocByApp -= block->allocByApp;
+        statGpuAllocPool[block->pool].allocTotal -= block->allocTotal;
+        statGpuAllocPool[block->pool].blockCount -= block->mark;
     }
 }
 
-void MemoryManager::InsertBacktrace(Backtrace& backtrace)
+void MemoryManager::AggregateStat(AllocPoolStat* pools, TagAllocStat* tags) const
 {
-    if (nullptr == bktraceMap)
-    {
-        static uint8 bufferForMap[sizeof(BacktraceMap)];
+    auto accumulate = [pools, tags](const AllocPoolStat* srcPools, const TagAllocStat* srcTags) {
+        for (uint32 i = 0; i < MAX_ALLOC_POOL_COUNT; ++i)
+        {
+            pools[i].allocByApp += srcPools[i].allocByApp;
+            pools[i].allocTotal += srcPools[i].allocTotal;
+            pools[i].blockCount += srcPools[i].blockCount;
+            pools[i].maxBlockSize = std::max(pools[i].maxBlockSize, srcPools[i].maxBlockSize);
+        }
+        for (uint32 i = 0; srcTags != nullptr && i < MAX_TAG_COUNT; ++i)
+        {
+            tags[i].allocByApp += srcTags[i].allocByApp;
+            tags[i].blockCount += srcTags[i].blockCount;
+        }
+    };
 
-        bktraceMap = new (bufferForMap) BacktraceMap;
+    Memset(pools, 0, sizeof(AllocPoolStat) * MAX_ALLOC_POOL_COUNT);
+    Memset(tags, 0, sizeof(TagAllocStat) * MAX_TAG_COUNT);
+    {
+        LockType lock(gpuMutex);
+        accumulate(statGpuAllocPool, nullptr);
     }
+    for (ThreadContext* context = contextList.load(std::memory_order_acquire); context != nullptr; context = context->nextContext)
+    {
+        LockType lock(context->mutex);
+        accumulate(context->statAllocPool, context->statTag);
+    }
+
+    // Memory usage reported by system is queried only on request instead of each allocation
+    const uint32 systemMemoryUsage = GetSystemMemoryUsage();
+    pools[ALLOC_POOL_SYSTEM].allocByApp = systemMemoryUsage;
+    pools[ALLOC_POOL_SYSTEM].allocTotal = systemMemoryUsage;
+}
 
-    auto i = bktraceMap->find(backtrace.hash);
-    if (i == bktraceMap->end())
+MemoryManager::BacktraceSlot* MemoryManager::GetBacktraceTable()
+{
+    BacktraceSlot* table = bktraceTable.load(std::memory_order_acquire);
+    if (nullptr == table)
     {
-        backtrace.nref = 1;
-        backtrace.symbolsCollected = false;
+        const size_t tableSize = sizeof(BacktraceSlot) * BACKTRACE_TABLE_SIZE;
+        BacktraceSlot* newTable = static_cast<BacktraceSlot*>(InternalAllocate(tableSize));
+        Memset(newTable, 0, tableSize);
 
-        const size_t BKTRACE_THRESHOLD = 100;
-        bktraceGrowDelta += 1;
-        if (bktraceGrowDelta >= BKTRACE_THRESHOLD)
+        if (bktraceTable.compare_exchange_strong(table, newTable, std::memory_order_acq_rel))
         {
-            bktraceGrowDelta -= BKTRACE_THRESHOLD;
-            symbolCollectorCondVar.NotifyOne();
+            table = newTable;
+        }
+        else
+        { // Other thread has created table first
+            InternalDeallocate(newTable);
         }
-        bktraceMap->emplace(backtrace.hash, backtrace);
     }
-    else
+    return table;
+}
+
+bool MemoryManager::AcquireBacktraceSlot(BacktraceSlot& slot, uint32 hash)
+{
+    const uint32 nref = slot.nref.fetch_add(1, std::memory_order_acq_rel);
+    if ((nref & BACKTRACE_RECLAIM_BIT) == 0 && slot.hash.load(std::memory_order_acquire) == hash)
+        return true;
+
+    // Slot is being reclaimed or has been reused for other backtrace since hash was compared
+    slot.nref.fetch_sub(1, std::memory_order_relaxed);
+    return false;
+}
+
+bool MemoryManager::ReclaimBacktraceSlot(BacktraceSlot& slot)
+{
+    uint32 nref = 0;
+    if (!slot.nref.compare_exchange_strong(nref, BACKTRACE_RECLAIM_BIT, std::memory_order_acq_rel))
+        return false;
+
+    // Slot keeps its Backtrace object, next owner overwrites frames in place
+    slot.ready.store(false, std::memory_order_relaxed);
+    slot.generation.fetch_add(1, std::memory_order_release);
+    slot.hash.store(BACKTRACE_TOMBSTONE, std::memory_order_release);
+    slot.nref.fetch_sub(BACKTRACE_RECLAIM_BIT, std::memory_order_release);
+    bktraceSlotCount.fetch_sub(1, std::memory_order_relaxed);
+    return true;
+}
+
+void MemoryManager::InsertBacktrace(const Backtrace& backtrace)
+{
+    // Slots are taken by CAS on hash without locks, slots with no alive blocks are turned into tombstones by symbol collector
+    // thread and can be taken again. Tombstones do not break probe sequences, so lookup goes on until never used slot.
+    // Block keeps its hash even if table is full, snapshot will miss only its frames.
+    BacktraceSlot* table = GetBacktraceTable();
+    const uint32 mask = BACKTRACE_TABLE_SIZE - 1;
+    for (;;)
     {
-        i->second.nref += 1;
+        BacktraceSlot* reusable = nullptr;
+        uint32 reusableHash = BACKTRACE_FREE_SLOT;
+        for (uint32 i = backtrace.hash & mask, n = 0; n < BACKTRACE_TABLE_SIZE; i = (i + 1) & mask, ++n)
+        {
+            BacktraceSlot& slot = table[i];
+            const uint32 slotHash = slot.hash.load(std::memory_order_acquire);
+            if (slotHash == backtrace.hash)
+            {
+                if (AcquireBacktraceSlot(slot, backtrace.hash))
+                    return;
+            }
+            else if (BACKTRACE_TOMBSTONE == slotHash && nullptr == reusable)
+            {
+                reusable = &slot;
+                reusableHash = BACKTRACE_TOMBSTONE;
+            }
+            else if (BACKTRACE_FREE_SLOT == slotHash)
+            {
+                if (nullptr == reusable)
+                    reusable = &slot;
+                break;
+            }
+        }
+
+        if (nullptr == reusable)
+        {
+            symbolCollectorCondVar.NotifyOne(); // Table is full, ask symbol collector to reclaim dead backtraces
+            return;
+        }
+
+        uint32 expected = reusableHash;
+        if (reusable->hash.compare_exchange_strong(expected, backtrace.hash, std::memory_order_acq_rel))
+        {
+            Backtrace* o = reusable->backtrace.load(std::memory_order_relaxed);
+            if (nullptr == o)
+            {
+                reusable->backtrace.store(new (InternalAllocate(sizeof(Backtrace))) Backtrace(backtrace), std::memory_order_relaxed);
+            }
+            else
+            {
+                *o = backtrace;
+            }
+            reusable->symbolsCollected.store(false, std::memory_order_relaxed);
+            reusable->nref.fetch_add(1, std::memory_order_relaxed);
+            reusable->ready.store(true, std::memory_order_release);
+            bktraceSlotCount.fetch_add(1, std::memory_order_relaxed);
+
+            const uint32 BKTRACE_THRESHOLD = 100;
+            if ((bktraceCount.fetch_add(1, std::memory_order_relaxed) + 1) % BKTRACE_THRESHOLD == 0)
+            {
+                symbolCollectorCondVar.NotifyOne();
+            }
+            return;
+        }
+        // Other thread has taken slot first, maybe with the same backtrace - look up again
     }
 }
 
 void MemoryManager::RemoveBacktrace(uint32 hash)
 {
-    auto i = bktraceMap->find(hash);
-    i->second.nref -= 1;
-    if (i->second.nref == 0)
+    // Concurrent inserts into different tombstones may leave several slots with the same hash,
+    // so reference is released from any of them which still has alive blocks
+    BacktraceSlot* table = bktraceTable.load(std::memory_order_acquire);
+    if (nullptr == table)
+        return;
+
+    const uint32 mask = BACKTRACE_TABLE_SIZE - 1;
+    for (uint32 i = hash & mask, n = 0; n < BACKTRACE_TABLE_SIZE; i = (i + 1) & mask, ++n)
     {
-        bktraceMap->erase(i);
+        BacktraceSlot& slot = table[i];
+        const uint32 slotHash = slot.hash.load(std::memory_order_acquire);
+        if (BACKTRACE_FREE_SLOT == slotHash)
+            return;
+        if (slotHash != hash)
+            continue;
+
+        uint32 nref = slot.nref.load(std::memory_order_relaxed);
+        while ((nref & ~BACKTRACE_RECLAIM_BIT) != 0)
+        {
+            if (slot.nref.compare_exchange_weak(nref, nref - 1, std::memory_order_acq_rel))
+                return;
+        }
     }
 }
 
@@ -881,25 +1121,42 @@ DAVA_NOINLINE void MemoryManager::CollectBacktrace(Backtrace* backtrace, size_t
         bktraceStringLength += n;
     }
     backtrace->hash = HashValue_N(bktraceString, static_cast<uint32>(bktraceStringLength));
-    backtrace->nref = 1;
-    backtrace->symbolsCollected = false;
+    if (BACKTRACE_FREE_SLOT == backtrace->hash || BACKTRACE_TOMBSTONE == backtrace->hash)
+    { // Zero hash is reserved for blocks without backtrace and free backtrace slots, another one for reclaimed slots
+        backtrace->hash = 2;
+    }
 }
 
-void MemoryManager::ObtainBacktraceSymbols(const Backtrace* backtrace)
+MemoryManager::SymbolMap* MemoryManager::GetSymbolMap()
 {
     if (nullptr == symbolMap)
     {
         static uint8 bufferForMap[sizeof(SymbolMap)];
         symbolMap = new (bufferForMap) SymbolMap;
     }
+    return symbolMap;
+}
 
+void MemoryManager::ObtainBacktraceSymbols(const Backtrace* backtrace)
+{
     for (size_t i = 0; i < backtrace->frames.size(); ++i)
     {
-        if (backtrace->frames[i] != nullptr && symbolMap->find(backtrace->frames[i]) == symbolMap->cend())
+        void* frame = backtrace->frames[i];
+        if (nullptr == frame)
+            continue;
+
         {
-            String symbol = Debug::GetFrameSymbol(backtrace->frames[i], true);
-            if (!symbol.empty())
-                symbolMap->emplace(backtrace->frames[i], InternalString(symbol.c_str()));
+            LockType lock(symbolMutex);
+            if (GetSymbolMap()->count(frame) != 0)
+                continue;
+        }
+
+        // Symbol is obtained outside lock as it is slow and allocates memory
+        String symbol = Debug::GetFrameSymbol(frame, true);
+        if (!symbol.empty())
+        {
+            LockType lock(symbolMutex);
+            GetSymbolMap()->emplace(frame, InternalString(symbol.c_str()));
         }
     }
 }
@@ -942,13 +1199,19 @@ void MemoryManager::GetCurStat(uint64 timestamp, void* buffer, uint32 bufSize) c
     const uint32 requiredSize = CalcCurStatSize();
     DVASSERT(requiredSize <= bufSize);
 
-    LockType lockAlloc(allocMutex);
-    LockType lockStat(statMutex);
+    AllocPoolStat statAllocPool[MAX_ALLOC_POOL_COUNT];
+    TagAllocStat statTag[MAX_TAG_COUNT];
+    AggregateStat(statAllocPool, statTag);
 
     MMCurStat* curStat = static_cast<MMCurStat*>(buffer);
     curStat->timestamp = timestamp;
     curStat->size = static_cast<uint32>(requiredSize);
-    curStat->statGeneral = statGeneral;
+    {
+        LockType lock(statMutex);
+        curStat->statGeneral = statGeneral;
+    }
+    curStat->statGeneral.nextBlockNo = nextBlockNo.load(std::memory_order_relaxed);
+    curStat->statGeneral.activeTags = activeTags.load(std::memory_order_relaxed);
 
     AllocPoolStat* pools = OffsetPointer<AllocPoolStat>(curStat, sizeof(MMCurStat));
     for (uint32 i = 0; i < registeredAllocPoolCount; ++i)
@@ -989,17 +1252,18 @@ bool MemoryManager::GetMemorySnapshot(uint64 timestamp, File* file, uint32* snap
     snapshot.bktraceDepth = BACKTRACE_DEPTH;
 
     // Write empty header to force file internal buffer allocation to exclude
-    // memory allocations under allocMutex (primarily for Win32 release builds)
+    // memory allocations under thread context locks (primarily for Win32 release builds)
     if (file->Write(&snapshot) != sizeof(MMSnapshot))
         return false;
 
-    { // Store memory blocks into file
-        LockType lock(allocMutex);
+    for (ThreadContext* context = contextList.load(std::memory_order_acquire); context != nullptr; context = context->nextContext)
+    { // Store memory blocks of each thread into file
+        LockType lock(context->mutex);
 
         const uint32 BLOCKS_IN_BUF = BUF_SIZE / sizeof(MMBlock);
         MMBlock* destBegin = static_cast<MMBlock*>(buffer);
 
-        MemoryBlock* curBlock = head;
+        MemoryBlock* curBlock = context->head;
         while (curBlock != nullptr)
         {
             uint32 k = 0;
@@ -1021,13 +1285,14 @@ bool MemoryManager::GetMemorySnapshot(uint64 timestamp, File* file, uint32* snap
         }
     }
     { // Store function names into file
-        LockType lock(bktraceMutex);
+        LockType lock(symbolMutex);
 
         const size_t SYMBOLS_IN_BUF = BUF_SIZE / sizeof(MMSymbol);
         MMSymbol* symbols = static_cast<MMSymbol*>(buffer);
 
-        auto itBegin = symbolMap->cbegin();
-        auto itEnd = symbolMap->cend();
+        const SymbolMap* map = GetSymbolMap();
+        auto itBegin = map->cbegin();
+        auto itEnd = map->cend();
         while (itBegin != itEnd)
         {
             uint32 k = 0;
@@ -1048,36 +1313,47 @@ bool MemoryManager::GetMemorySnapshot(uint64 timestamp, File* file, uint32* snap
                 return false;
         }
     }
-    { // Store backtraces into file
-        LockType lock(bktraceMutex);
-
-        const size_t BKTRACE_IN_BUF = BUF_SIZE / bktraceSize;
+    if (BacktraceSlot* table = bktraceTable.load(std::memory_order_acquire))
+    { // Store backtraces of alive blocks into file
+        const uint32 BKTRACE_IN_BUF = BUF_SIZE / bktraceSize;
         MMBacktrace* bktrace = static_cast<MMBacktrace*>(buffer);
 
-        auto itBegin = bktraceMap->cbegin();
-        auto itEnd = bktraceMap->cend();
-        while (itBegin != itEnd)
+        uint32 k = 0;
+        for (uint32 islot = 0; islot < BACKTRACE_TABLE_SIZE; ++islot)
         {
-            uint32 k = 0;
-            for (; k < BKTRACE_IN_BUF && itBegin != itEnd; ++k)
+            const BacktraceSlot& slot = table[islot];
+            const Backtrace* o = slot.backtrace.load(std::memory_order_acquire);
+            const uint32 generation = slot.generation.load(std::memory_order_acquire);
+            if (nullptr == o || !slot.ready.load(std::memory_order_acquire) || 0 == slot.nref.load(std::memory_order_relaxed))
+                continue;
+
+            bktrace->hash = o->hash;
+            uint64* frames = OffsetPointer<uint64>(bktrace, sizeof(MMBacktrace));
+            for (size_t i = 0; i < BACKTRACE_DEPTH; ++i)
             {
-                auto& o = itBegin->second;
+                frames[i] = reinterpret_cast<uint64>(o->frames[i]);
+            }
 
-                bktrace->hash = o.hash;
-                uint64* frames = OffsetPointer<uint64>(bktrace, sizeof(MMBacktrace));
-                for (size_t i = 0; i < BACKTRACE_DEPTH; ++i)
-                {
-                    frames[i] = reinterpret_cast<uint64>(o.frames[i]);
-                }
+            // Slot has been reclaimed and maybe taken by other backtrace while frames were copied
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (slot.generation.load(std::memory_order_relaxed) != generation)
+                continue;
 
-                bktrace = OffsetPointer<MMBacktrace>(bktrace, bktraceSize);
-                ++itBegin;
+            bktrace = OffsetPointer<MMBacktrace>(bktrace, bktraceSize);
+
+            k += 1;
+            if (BKTRACE_IN_BUF == k)
+            {
+                snapshot.bktraceCount += k;
+                if (file->Write(buffer, bktraceSize * k) != bktraceSize * k)
+                    return false;
+                bktrace = static_cast<MMBacktrace*>(buffer);
+                k = 0;
             }
-            snapshot.bktraceCount += k;
-            if (file->Write(buffer, bktraceSize * k) != bktraceSize * k)
-                return false;
-            bktrace = static_cast<MMBacktrace*>(buffer);
         }
+        snapshot.bktraceCount += k;
+        if (file->Write(buffer, bktraceSize * k) != bktraceSize * k)
+            return false;
     }
 
     // Write down header
@@ -1101,10 +1377,6 @@ bool MemoryManager::GetMemorySnapshot(uint64 timestamp, File* file, uint32* snap
 
 void MemoryManager::SymbolCollectorThread()
 {
-    const size_t BUF_CAPACITY = 1000; // Select some reasonable buffer for backtraces
-    // to give some job to symbol collector
-    Backtrace* bktraceBuf = new Backtrace[BUF_CAPACITY];
-
     while (!symbolCollectorThread->IsCancelling())
     {
         {
@@ -1112,30 +1384,25 @@ void MemoryManager::SymbolCollectorThread()
             symbolCollectorCondVar.Wait(lock);
         }
 
-        size_t nplaced = 0;
-        {
-            LockType lock(bktraceMutex);
-
-            for (auto i = bktraceMap->begin(), e = bktraceMap->end(); i != e && nplaced < BUF_CAPACITY; ++i)
-            {
-                const Backtrace& bktrace = i->second;
-                if (!bktrace.symbolsCollected)
-                {
-                    bktraceBuf[nplaced] = bktrace;
-                    nplaced += 1;
-                }
-            }
-        }
+        // Dead backtraces are reclaimed only when table becomes crowded to avoid churn of short-lived allocation sites
+        const bool reclaim = bktraceSlotCount.load(std::memory_order_relaxed) > BACKTRACE_TABLE_SIZE / 2;
 
-        for (size_t i = 0; i < nplaced && !symbolCollectorThread->IsCancelling(); ++i)
+        BacktraceSlot* table = bktraceTable.load(std::memory_order_acquire);
+        for (uint32 i = 0; table != nullptr && i < BACKTRACE_TABLE_SIZE && !symbolCollectorThread->IsCancelling(); ++i)
         {
-            ObtainBacktraceSymbols(&bktraceBuf[i]);
+            // This thread is the only one which reclaims slots, so ready backtraces can be read without locks
+            BacktraceSlot& slot = table[i];
+            const Backtrace* bktrace = slot.backtrace.load(std::memory_order_acquire);
+            if (bktrace == nullptr || !slot.ready.load(std::memory_order_acquire))
+                continue;
+
+            if (reclaim && ReclaimBacktraceSlot(slot))
+                continue;
 
-            LockType lock(bktraceMutex);
-            auto ibktrace = bktraceMap->find(bktraceBuf[i].hash);
-            if (ibktrace != bktraceMap->end())
+            if (!slot.symbolsCollected.load(std::memory_order_relaxed) && slot.nref.load(std::memory_order_relaxed) > 0)
             {
-                ibktrace->second.symbolsCollected = true;
+                ObtainBacktraceSymbols(bktrace);
+                slot.symbolsCollected.store(true, std::memory_order_relaxed);
             }
         }
     }
@@ -5,6 +5,7 @@
 
 #if defined(DAVA_MEMORY_PROFILING_ENABLE)
 
+#include <atomic>
 #include <type_traits>
 
 #include "Functional/Function.h"
@@ -34,6 +35,10 @@ class MemoryManager final
     static const uint32 DEAD_BLOCK_MARK = 0xECECECEC;
     static const size_t BLOCK_ALIGN = 16;
     static const uint32 BACKTRACE_DEPTH = 32;
+    static const uint32 BACKTRACE_TABLE_SIZE = 64 * 1024; // Max number of unique alive backtraces, should be power of 2
+    static const uint32 BACKTRACE_FREE_SLOT = 0; // Hash of never used backtrace slot, also hash of blocks without backtrace
+    static const uint32 BACKTRACE_TOMBSTONE = 1; // Hash of reclaimed backtrace slot
+    static const uint32 BACKTRACE_RECLAIM_BIT = 0x80000000; // Set in slot reference count while slot is reclaimed
 
 public:
     static const uint32 MAX_ALLOC_POOL_COUNT = 32;
@@ -43,7 +48,9 @@ public:
     struct MemoryBlock;
     struct InternalMemoryBlock;
     struct Backtrace;
+    struct BacktraceSlot;
     struct AllocScopeItem;
+    struct ThreadContext;
 
 public:
     class AllocPoolScope final
@@ -70,9 +77,14 @@ public:
     static void RegisterTagName(uint32 tagMask, const char8* name);
 
     void EnableLightWeightMode();
+    // Collect backtraces only for every `rate`-th allocation made by each thread, other blocks have zero backtrace hash
+    // Statistics are still exact, 1 (default) collects backtrace for each allocation
+    void SetBacktraceSampling(uint32 rate);
     void SetCallbacks(Function<void()> updateCallback, Function<void(uint32, bool)> tagCallback);
     void Update();
     void Finish();
+    // Return context of current thread to pool of free contexts, should be called as the last thing before thread exits
+    void ReleaseThreadContext();
 
     DAVA_NOINLINE void* Allocate(size_t size, uint32 poolIndex);
     DAVA_NOINLINE void* AlignedAllocate(size_t size, size_t align, uint32 poolIndex);
@@ -121,56 +133,72 @@ private:
     friend void InternalDealloc(void* ptr);
 
 private:
-    void InsertBlock(MemoryBlock* block);
-    void RemoveBlock(MemoryBlock* block);
+    using InternalString = std::basic_string<char8, std::char_traits<char8>, InternalAllocator<char8>>;
+    using SymbolMap = std::unordered_map<void*, InternalString, std::hash<void*>, std::equal_to<void*>, InternalAllocator<std::pair<void* const, InternalString>>>;
+
+    ThreadContext* GetThreadContext();
+    ThreadContext* AcquireThreadContext();
+    bool IsBacktraceSampled(ThreadContext* context);
 
-    void UpdateStatAfterAlloc(MemoryBlock* block, uint32 systemMemoryUsage);
-    void UpdateStatAfterDealloc(MemoryBlock* block, uint32 systemMemoryUsage);
+    void InsertBlock(ThreadContext* context, MemoryBlock* block);
+    void RemoveBlock(ThreadContext* context, MemoryBlock* block);
+
+    void UpdateStatAfterAlloc(ThreadContext* context, MemoryBlock* block);
+    void UpdateStatAfterDealloc(ThreadContext* context, MemoryBlock* block);
 
     void UpdateStatAfterGPUAlloc(MemoryBlock* block, size_t sizeIncr);
     void UpdateStatAfterGPUDealloc(MemoryBlock* block);
 
+    // Sum statistics of all thread contexts and GPU allocations
+    void AggregateStat(AllocPoolStat* pools, TagAllocStat* tags) const;
+
     uint64 PackGPUKey(uint32 id, uint32 allocPool) const;
 
-    void InsertBacktrace(Backtrace& backtrace);
+    BacktraceSlot* GetBacktraceTable();
+    bool AcquireBacktraceSlot(BacktraceSlot& slot, uint32 hash);
+    bool ReclaimBacktraceSlot(BacktraceSlot& slot); // Should be called only by symbol collector thread
+    void InsertBacktrace(const Backtrace& backtrace);
     void RemoveBacktrace(uint32 hash);
 
     DAVA_NOINLINE void CollectBacktrace(Backtrace* backtrace, size_t nskip);
     void ObtainBacktraceSymbols(const Backtrace* backtrace);
+    SymbolMap* GetSymbolMap(); // Should be called under symbolMutex
 
     void SymbolCollectorThread();
 
 private:
-    MemoryBlock* head = nullptr; // Linked list of tracked memory blocks
+    // Every thread keeps its own list of allocated blocks and its own statistics under its own lock,
+    // so allocations from different threads do not contend. Statistics are aggregated on request.
+    std::atomic<ThreadContext*> contextList{ nullptr }; // List of all thread contexts, contexts are never freed but reused
+    std::atomic<ThreadContext*> sharedContext{ nullptr }; // Context used by all threads if thread local storage is not available
 
-    GeneralAllocStat statGeneral; // General statistics
-    AllocPoolStat statAllocPool[MAX_ALLOC_POOL_COUNT]; // Statistics by allocation pools
-    TagAllocStat statTag[MAX_TAG_COUNT]; // Statistics by tags
+    GeneralAllocStat statGeneral; // General statistics except nextBlockNo and activeTags
+    std::atomic<uint32> nextBlockNo{ 0 };
+    std::atomic<uint32> activeTags{ 0 };
+
+    AllocPoolStat statGpuAllocPool[MAX_ALLOC_POOL_COUNT]; // Statistics of GPU allocations, guarded by gpuMutex
 
     using MutexType = Spinlock;
     using LockType = LockGuard<MutexType>;
 
-    mutable MutexType allocMutex; // Mutex for managing list of allocated memory blocks
-    mutable MutexType statMutex; // Mutex for updating memory statistics
+    mutable MutexType statMutex; // Mutex for updating general memory statistics
     mutable MutexType gpuMutex; // Mutex for managing GPU allocations
 
     using GpuBlockMap = std::unordered_map<uint64, MemoryBlock, std::hash<uint64>, std::equal_to<uint64>, InternalAllocator<std::pair<const uint64, MemoryBlock>>>;
 
     GpuBlockMap* gpuBlockMap = nullptr;
 
-    using InternalString = std::basic_string<char8, std::char_traits<char8>, InternalAllocator<char8>>;
-    using BacktraceMap = std::unordered_map<uint32, Backtrace, std::hash<uint32>, std::equal_to<uint32>, InternalAllocator<std::pair<const uint32, Backtrace>>>;
-    using SymbolMap = std::unordered_map<void*, InternalString, std::hash<void*>, std::equal_to<void*>, InternalAllocator<std::pair<void* const, InternalString>>>;
-
-    mutable MutexType bktraceMutex; // Mutex for working with backtraces
+    mutable MutexType symbolMutex; // Mutex for working with symbol map
 
-    BacktraceMap* bktraceMap = nullptr;
+    std::atomic<BacktraceSlot*> bktraceTable{ nullptr }; // Open addressing table of unique backtraces, filled without locks
     SymbolMap* symbolMap = nullptr;
 
     Thread* symbolCollectorThread = nullptr;
     ConditionVariable symbolCollectorCondVar;
     Mutex symbolCollectorMutex;
-    size_t bktraceGrowDelta = 0;
+    std::atomic<uint32> bktraceCount{ 0 }; // Number of unique backtraces, symbol collector is woken up as it grows
+    std::atomic<uint32> bktraceSlotCount{ 0 }; // Number of taken backtrace slots, dead ones are reclaimed when table is half full
+    std::atomic<uint32> bktraceSamplingRate{ 1 };
     bool lightWeightMode = false; // Flag enabling lightweight mode: no backtrace and symbols, should increase performance
 
     Function<void()> updateCallback;
@@ -185,6 +213,7 @@ private:
     static MMItemName allocPoolNames[MAX_ALLOC_POOL_COUNT]; // Names of allocation pools
 
     ThreadLocalPtr<AllocScopeItem> tlsAllocScopeStack;
+    ThreadLocalPtr<ThreadContext> tlsContext;
 };
 
 //////////////////////////////////////////////////////////////////////////
@@ -8,8 +8,10 @@
 #include "MemoryManager.h"
 
 #define DAVA_MEMORY_PROFILER_ENABLE_LIGHTWEIGHT() DAVA::MemoryManager::Instance()->EnableLightWeightMode()
+#define DAVA_MEMORY_PROFILER_SET_BACKTRACE_SAMPLING(rate) DAVA::MemoryManager::Instance()->SetBacktraceSampling(rate)
 #define DAVA_MEMORY_PROFILER_UPDATE() DAVA::MemoryManager::Instance()->Update()
 #define DAVA_MEMORY_PROFILER_FINISH() DAVA::MemoryManager::Instance()->Finish()
+#define DAVA_MEMORY_PROFILER_THREAD_EXIT() DAVA::MemoryManager::Instance()->ReleaseThreadContext()
 
 #define DAVA_MEMORY_PROFILER_REGISTER_TAG(index, name) DAVA::MemoryManager::RegisterTagName(index, name)
 #define DAVA_MEMORY_PROFILER_REGISTER_ALLOC_POOL(index, name) DAVA::MemoryManager::RegisterAllocPoolName(index, name)
@@ -35,8 +37,10 @@ public:
 #else // defined(DAVA_MEMORY_PROFILING_ENABLE)
 
 #define DAVA_MEMORY_PROFILER_ENABLE_LIGHTWEIGHT()
+#define DAVA_MEMORY_PROFILER_SET_BACKTRACE_SAMPLING(rate)
 #define DAVA_MEMORY_PROFILER_UPDATE()
 #define DAVA_MEMORY_PROFILER_FINISH()
+#define DAVA_MEMORY_PROFILER_THREAD_EXIT()
 
 #define DAVA_MEMORY_PROFILER_REGISTER_TAG(index, name)
 #define DAVA_MEMORY_PROFILER_REGISTER_ALLOC_POOL(index, name)
@@ -0,0 +1,219 @@
+#include "Particles/ParticleBuffer.h"
+
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#define PARTICLE_BUFFER_SSE
+#include <xmmintrin.h>
+#elif defined(__ARM_NEON__) || defined(__ARM_NEON)
+#define PARTICLE_BUFFER_NEON
+#include <arm_neon.h>
+#endif
+
+namespace DAVA
+{
+namespace ParticleBufferDetails
+{
+const uint32 LANES_COUNT = 4;
+
+#if defined(PARTICLE_BUFFER_SSE)
+float32 HorizontalMin(__m128 v)
+{
+    v = _mm_min_ps(v, _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 3, 0, 1)));
+    v = _mm_min_ps(v, _mm_shuffle_ps(v, v, _MM_SHUFFLE(1, 0, 3, 2)));
+    return _mm_cvtss_f32(v);
+}
+
+float32 HorizontalMax(__m128 v)
+{
+    v = _mm_max_ps(v, _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 3, 0, 1)));
+    v = _mm_max_ps(v, _mm_shuffle_ps(v, v, _MM_SHUFFLE(1, 0, 3, 2)));
+    return _mm_cvtss_f32(v);
+}
+#elif defined(PARTICLE_BUFFER_NEON)
+float32 HorizontalMin(float32x4_t v)
+{
+    float32x2_t m = vpmin_f32(vget_low_f32(v), vget_high_f32(v));
+    m = vpmin_f32(m, m);
+    return vget_lane_f32(m, 0);
+}
+
+float32 HorizontalMax(float32x4_t v)
+{
+    float32x2_t m = vpmax_f32(vget_low_f32(v), vget_high_f32(v));
+    m = vpmax_f32(m, m);
+    return vget_lane_f32(m, 0);
+}
+#endif
+}
+
+void ParticleBuffer::Resize(uint32 count_)
+{
+    count = count_;
+
+    positionX.resize(count);
+    positionY.resize(count);
+    positionZ.resize(count);
+    speedX.resize(count);
+    speedY.resize(count);
+    speedZ.resize(count);
+    velocityScale.resize(count);
+    accelerationX.resize(count);
+    accelerationY.resize(count);
+    accelerationZ.resize(count);
+    radius.resize(count);
+}
+
+void ParticleBuffer::Integrate(float32 dt)
+{
+    using namespace ParticleBufferDetails;
+
+    float32* px = positionX.data();
+    float32* py = positionY.data();
+    float32* pz = positionZ.data();
+    float32* sx = speedX.data();
+    float32* sy = speedY.data();
+    float32* sz = speedZ.data();
+    const float32* vs = velocityScale.data();
+    const float32* ax = accelerationX.data();
+    const float32* ay = accelerationY.data();
+    const float32* az = accelerationZ.data();
+
+    uint32 i = 0;
+#if defined(PARTICLE_BUFFER_SSE)
+    const __m128 dt4 = _mm_set1_ps(dt);
+    for (uint32 simdCount = count - count % LANES_COUNT; i < simdCount; i += LANES_COUNT)
+    {
+        __m128 speedMult = _mm_mul_ps(_mm_loadu_ps(vs + i), dt4);
+        __m128 speedXi = _mm_loadu_ps(sx + i);
+        __m128 speedYi = _mm_loadu_ps(sy + i);
+        __m128 speedZi = _mm_loadu_ps(sz + i);
+
+        _mm_storeu_ps(px + i, _mm_add_ps(_mm_loadu_ps(px + i), _mm_mul_ps(speedXi, speedMult)));
+        _mm_storeu_ps(py + i, _mm_add_ps(_mm_loadu_ps(py + i), _mm_mul_ps(speedYi, speedMult)));
+        _mm_storeu_ps(pz + i, _mm_add_ps(_mm_loadu_ps(pz + i), _mm_mul_ps(speedZi, speedMult)));
+
+        _mm_storeu_ps(sx + i, _mm_add_ps(speedXi, _mm_mul_ps(_mm_loadu_ps(ax + i), dt4)));
+        _mm_storeu_ps(sy + i, _mm_add_ps(speedYi, _mm_mul_ps(_mm_loadu_ps(ay + i), dt4)));
+        _mm_storeu_ps(sz + i, _mm_add_ps(speedZi, _mm_mul_ps(_mm_loadu_ps(az + i), dt4)));
+    }
+#elif defined(PARTICLE_BUFFER_NEON)
+    const float32x4_t dt4 = vdupq_n_f32(dt);
+    for (uint32 simdCount = count - count % LANES_COUNT; i < simdCount; i += LANES_COUNT)
+    {
+        float32x4_t speedMult = vmulq_f32(vld1q_f32(vs + i), dt4);
+        float32x4_t speedXi = vld1q_f32(sx + i);
+        float32x4_t speedYi = vld1q_f32(sy + i);
+        float32x4_t speedZi = vld1q_f32(sz + i);
+
+        vst1q_f32(px + i, vmlaq_f32(vld1q_f32(px + i), speedXi, speedMult));
+        vst1q_f32(py + i, vmlaq_f32(vld1q_f32(py + i), speedYi, speedMult));
+        vst1q_f32(pz + i, vmlaq_f32(vld1q_f32(pz + i), speedZi, speedMult));
+
+        vst1q_f32(sx + i, vmlaq_f32(speedXi, vld1q_f32(ax + i), dt4));
+        vst1q_f32(sy + i, vmlaq_f32(speedYi, vld1q_f32(ay + i), dt4));
+        vst1q_f32(sz + i, vmlaq_f32(speedZi, vld1q_f32(az + i), dt4));
+    }
+#endif
+
+    for (; i < count; ++i)
+    {
+        float32 speedMult = vs[i] * dt;
+        px[i] += sx[i] * speedMult;
+        py[i] += sy[i] * speedMult;
+        pz[i] += sz[i] * speedMult;
+
+        sx[i] += ax[i] * dt;
+        sy[i] += ay[i] * dt;
+        sz[i] += az[i] * dt;
+    }
+}
+
+void ParticleBuffer::AccumulateBBox(const Vector3& offset, AABBox3& bbox) const
+{
+    using namespace ParticleBufferDetails;
+
+    const float32* px = positionX.data();
+    const float32* py = positionY.data();
+    const float32* pz = positionZ.data();
+    const float32* r = radius.data();
+
+    if (count == 0)
+    {
+        return;
+    }
+
+    Vector3 minPoint(AABBOX_INFINITY, AABBOX_INFINITY, AABBOX_INFINITY);
+    Vector3 maxPoint(-AABBOX_INFINITY, -AABBOX_INFINITY, -AABBOX_INFINITY);
+
+    uint32 i = 0;
+#if defined(PARTICLE_BUFFER_SSE)
+    if (count >= LANES_COUNT)
+    {
+        __m128 minX = _mm_set1_ps(minPoint.x);
+        __m128 minY = _mm_set1_ps(minPoint.y);
+        __m128 minZ = _mm_set1_ps(minPoint.z);
+        __m128 maxX = _mm_set1_ps(maxPoint.x);
+        __m128 maxY = _mm_set1_ps(maxPoint.y);
+        __m128 maxZ = _mm_set1_ps(maxPoint.z);
+
+        for (uint32 simdCount = count - count % LANES_COUNT; i < simdCount; i += LANES_COUNT)
+        {
+            __m128 ri = _mm_loadu_ps(r + i);
+            __m128 xi = _mm_loadu_ps(px + i);
+            __m128 yi = _mm_loadu_ps(py + i);
+            __m128 zi = _mm_loadu_ps(pz + i);
+
+            minX = _mm_min_ps(minX, _mm_sub_ps(xi, ri));
+            minY = _mm_min_ps(minY, _mm_sub_ps(yi, ri));
+            minZ = _mm_min_ps(minZ, _mm_sub_ps(zi, ri));
+            maxX = _mm_max_ps(maxX, _mm_add_ps(xi, ri));
+            maxY = _mm_max_ps(maxY, _mm_add_ps(yi, ri));
+            maxZ = _mm_max_ps(maxZ, _mm_add_ps(zi, ri));
+        }
+
+        minPoint = Vector3(HorizontalMin(minX), HorizontalMin(minY), HorizontalMin(minZ));
+        maxPoint = Vector3(HorizontalMax(maxX), HorizontalMax(maxY), HorizontalMax(maxZ));
+    }
+#elif defined(PARTICLE_BUFFER_NEON)
+    if (count >= LANES_COUNT)
+    {
+        float32x4_t minX = vdupq_n_f32(minPoint.x);
+        float32x4_t minY = vdupq_n_f32(minPoint.y);
+        float32x4_t minZ = vdupq_n_f32(minPoint.z);
+        float32x4_t maxX = vdupq_n_f32(maxPoint.x);
+        float32x4_t maxY = vdupq_n_f32(maxPoint.y);
+        float32x4_t maxZ = vdupq_n_f32(maxPoint.z);
+
+        for (uint32 simdCount = count - count % LANES_COUNT; i < simdCount; i += LANES_COUNT)
+        {
+            float32x4_t ri = vld1q_f32(r + i);
+            float32x4_t xi = vld1q_f32(px + i);
+            float32x4_t yi = vld1q_f32(py + i);
+            float32x4_t zi = vld1q_f32(pz + i);
+
+            minX = vminq_f32(minX, vsubq_f32(xi, ri));
+            minY = vminq_f32(minY, vsubq_f32(yi, ri));
+            minZ = vminq_f32(minZ, vsubq_f32(zi, ri));
+            maxX = vmaxq_f32(maxX, vaddq_f32(xi, ri));
+            maxY = vmaxq_f32(maxY, vaddq_f32(yi, ri));
+            maxZ = vmaxq_f32(maxZ, vaddq_f32(zi, ri));
+        }
+
+        minPoint = Vector3(HorizontalMin(minX), HorizontalMin(minY), HorizontalMin(minZ));
+        maxPoint = Vector3(HorizontalMax(maxX), HorizontalMax(maxY), HorizontalMax(maxZ));
+    }
+#endif
+
+    for (; i < count; ++i)
+    {
+        minPoint.x = Min(minPoint.x, px[i] - r[i]);
+        minPoint.y = Min(minPoint.y, py[i] - r[i]);
+        minPoint.z = Min(minPoint.z, pz[i] - r[i]);
+        maxPoint.x = Max(maxPoint.x, px[i] + r[i]);
+        maxPoint.y = Max(maxPoint.y, py[i] + r[i]);
+        maxPoint.z = Max(maxPoint.z, pz[i] + r[i]);
+    }
+
+    bbox.AddPoint(minPoint + offset);
+    bbox.AddPoint(maxPoint + offset);
+}
+}
@@ -0,0 +1,76 @@
+#pragma once
+
+#include "Base/BaseTypes.h"
+#include "Math/AABBox3.h"
+#include "Math/Vector.h"
+
+namespace DAVA
+{
+/**
+    Structure-of-arrays storage of kinematic state of particles from single ParticleGroup.
+    Every attribute is stored in separate contiguous array, so simulation kernels process
+    four particles at once with SSE or NEON instructions (scalar code is used on other platforms).
+    Buffer is filled from group's particles before simulation and results are read back after it.
+*/
+class ParticleBuffer
+{
+public:
+    void Resize(uint32 count);
+    uint32 GetCount() const;
+
+    void SetParticle(uint32 index, const Vector3& position, const Vector3& speed, float32 velocityScale, const Vector3& acceleration, float32 radius);
+    Vector3 GetPosition(uint32 index) const;
+    Vector3 GetSpeed(uint32 index) const;
+
+    /** Move particles: `position += speed * velocityScale * dt`, then `speed += acceleration * dt`. */
+    void Integrate(float32 dt);
+
+    /** Extend `bbox` with spheres of particles' radiuses placed at particles' positions shifted by `offset`. */
+    void AccumulateBBox(const Vector3& offset, AABBox3& bbox) const;
+
+private:
+    uint32 count = 0;
+
+    Vector<float32> positionX;
+    Vector<float32> positionY;
+    Vector<float32> positionZ;
+    Vector<float32> speedX;
+    Vector<float32> speedY;
+    Vector<float32> speedZ;
+    Vector<float32> velocityScale;
+    Vector<float32> accelerationX;
+    Vector<float32> accelerationY;
+    Vector<float32> accelerationZ;
+    Vector<float32> radius;
+};
+
+inline uint32 ParticleBuffer::GetCount() const
+{
+    return count;
+}
+
+inline void ParticleBuffer::SetParticle(uint32 index, const Vector3& position, const Vector3& speed, float32 velocityScale_, const Vector3& acceleration, float32 radius_)
+{
+    positionX[index] = position.x;
+    positionY[index] = position.y;
+    positionZ[index] = position.z;
+    speedX[index] = speed.x;
+    speedY[index] = speed.y;
+    speedZ[index] = speed.z;
+    velocityScale[index] = velocityScale_;
+    accelerationX[index] = acceleration.x;
+    accelerationY[index] = acceleration.y;
+    accelerationZ[index] = acceleration.z;
+    radius[index] = radius_;
+}
+
+inline Vector3 ParticleBuffer::GetPosition(uint32 index) const
+{
+    return Vector3(positionX[index], positionY[index], positionZ[index]);
+}
+
+inline Vector3 ParticleBuffer::GetSpeed(uint32 index) const
+{
+    return Vector3(speedX[index], speedY[index], speedZ[index]);
+}
+}
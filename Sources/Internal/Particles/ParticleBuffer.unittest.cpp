@@ -0,0 +1,71 @@
+#include "UnitTests/UnitTests.h"
+
+#include "Particles/ParticleBuffer.h"
+
+DAVA_TESTCLASS (ParticleBufferTest)
+{
+    DAVA_TEST (IntegrateAndBBox)
+    {
+        using namespace DAVA;
+
+        // Count is not multiple of SIMD width to cover both vector and scalar paths
+        const uint32 count = 11;
+        const float32 dt = 0.1f;
+        const Vector3 offset(10.0f, 0.0f, -5.0f);
+
+        Vector<Vector3> positions;
+        Vector<Vector3> speeds;
+        Vector<float32> velocityScales;
+        Vector<Vector3> accelerations;
+        Vector<float32> radiuses;
+
+        ParticleBuffer buffer;
+        buffer.Resize(count);
+        TEST_VERIFY(buffer.GetCount() == count);
+        for (uint32 i = 0; i < count; ++i)
+        {
+            float32 f = static_cast<float32>(i);
+            positions.emplace_back(f, -f, 2.0f * f);
+            speeds.emplace_back(1.0f, f, -f);
+            velocityScales.push_back(0.5f + 0.1f * f);
+            accelerations.emplace_back(0.0f, -9.8f, f);
+            radiuses.push_back(0.25f * f);
+
+            buffer.SetParticle(i, positions[i], speeds[i], velocityScales[i], accelerations[i], radiuses[i]);
+        }
+
+        buffer.Integrate(dt);
+
+        AABBox3 expectedBBox;
+        for (uint32 i = 0; i < count; ++i)
+        {
+            Vector3 expectedPosition = positions[i] + speeds[i] * (velocityScales[i] * dt);
+            Vector3 expectedSpeed = speeds[i] + accelerations[i] * dt;
+            TEST_VERIFY(FLOAT_EQUAL(buffer.GetPosition(i).x, expectedPosition.x));
+            TEST_VERIFY(FLOAT_EQUAL(buffer.GetPosition(i).y, expectedPosition.y));
+            TEST_VERIFY(FLOAT_EQUAL(buffer.GetPosition(i).z, expectedPosition.z));
+            TEST_VERIFY(FLOAT_EQUAL(buffer.GetSpeed(i).x, expectedSpeed.x));
+            TEST_VERIFY(FLOAT_EQUAL(buffer.GetSpeed(i).y, expectedSpeed.y));
+            TEST_VERIFY(FLOAT_EQUAL(buffer.GetSpeed(i).z, expectedSpeed.z));
+
+            Vector3 r(radiuses[i], radiuses[i], radiuses[i]);
+            expectedBBox.AddPoint(expectedPosition + offset - r);
+            expectedBBox.AddPoint(expectedPosition + offset + r);
+        }
+
+        AABBox3 bbox;
+        buffer.AccumulateBBox(offset, bbox);
+        TEST_VERIFY(FLOAT_EQUAL_EPS(bbox.min.x, expectedBBox.min.x, 0.0001f));
+        TEST_VERIFY(FLOAT_EQUAL_EPS(bbox.min.y, expectedBBox.min.y, 0.0001f));
+        TEST_VERIFY(FLOAT_EQUAL_EPS(bbox.min.z, expectedBBox.min.z, 0.0001f));
+        TEST_VERIFY(FLOAT_EQUAL_EPS(bbox.max.x, expectedBBox.max.x, 0.0001f));
+        TEST_VERIFY(FLOAT_EQUAL_EPS(bbox.max.y, expectedBBox.max.y, 0.0001f));
+        TEST_VERIFY(FLOAT_EQUAL_EPS(bbox.max.z, expectedBBox.max.z, 0.0001f));
+
+        // Empty buffer doesn't change bbox
+        ParticleBuffer emptyBuffer;
+        AABBox3 emptyBBox;
+        emptyBuffer.AccumulateBBox(offset, emptyBBox);
+        TEST_VERIFY(emptyBBox.IsEmpty());
+    }
+};
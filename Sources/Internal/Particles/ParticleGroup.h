@@ -3,6 +3,7 @@
 #include "ParticleEmitter.h"
 #include "ParticleLayer.h"
 #include "Particle.h"
+#include "ParticleBuffer.h"
 #include "Render/Material/NMaterial.h"
 
 namespace DAVA
@@ -55,12 +56,17 @@ struct ParticleGroup
     float32 loopDuration = 0.0f;
     float32 particlesToGenerate = 0.0f;
 
+    // Current frame update parameters, see ParticleEffectSystem::BeginEffectUpdate
+    float32 updateDeltaTime = 0.0f;
+    float32 updateLoopTimeNormalized = 0.0f;
+
     uint16 particlesGenerated = 0;
 
     bool finishingGroup = false;
     bool visibleLod = true;
 
     StripeData stripe;
+    ParticleBuffer buffer;
 };
 
 struct ParentInfo
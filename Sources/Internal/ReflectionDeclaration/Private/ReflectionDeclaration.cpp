@@ -104,6 +104,7 @@
 #include "UI/Layouts/UILayoutIsolationComponent.h"
 #include "UI/Render/UIDebugRenderComponent.h"
 #include "UI/Render/UIClipContentComponent.h"
+#include "UI/Render/UIRenderCacheComponent.h"
 #include "UI/Scene3D/UISceneComponent.h"
 #include "UI/Scene3D/UIEntityMarkerComponent.h"
 #include "UI/Scene3D/UIEntityMarkersContainerComponent.h"
@@ -409,6 +410,7 @@ void RegisterPermanentNames()
     DECL_UI_COMPONENT(UIControlSourceComponent, "UIControlSourceComponent");
     DECL_UI_COMPONENT(UIDebugRenderComponent, "DebugRender");
     DECL_UI_COMPONENT(UIClipContentComponent, "ClipContent");
+    DECL_UI_COMPONENT(UIRenderCacheComponent, "RenderCache");
     DECL_UI_COMPONENT(UISceneComponent, "SceneComponent");
     DECL_UI_COMPONENT(UIEntityMarkerComponent, "UIEntityMarkerComponent");
     DECL_UI_COMPONENT(UIEntityMarkersContainerComponent, "UIEntityMarkersContainerComponent");
@@ -39,7 +39,8 @@ public:
                                    int32 justifyWidth, int32 spaceAddon,
                                    float32 ascendScale, float32 descendScale,
                                    Vector<float32>* charSizes = NULL,
-                                   bool contentScaleIncluded = false);
+                                   bool contentScaleIncluded = false,
+                                   Vector<FTGlyphAtlas::GlyphQuad>* glyphQuads = nullptr);
     uint32 GetFontHeight(float32 size, float32 ascendScale, float32 descendScale);
     bool IsCharAvaliable(char16 ch);
 
@@ -49,6 +50,7 @@ public:
 private:
     FTManager* ftm = nullptr;
     FilePath fontPath;
+    uint32 fontId = 0; // Key of font glyphs in glyph atlas
     FT_StreamRec stream;
 
     struct Glyph
@@ -69,11 +71,15 @@ private:
     void ClearString();
     int32 LoadString(float32 size, const WideString& str);
     void Prepare(FT_Face face, FT_Vector* advances);
+    void AddGlyphQuad(const Glyph& glyph, float32 size, const FT_Vector& pen, int32 multilineOffsetY,
+                      int32 notdefWidth, int32 notdefHeight, int32 bufWidth, int32 bufHeight,
+                      Vector<FTGlyphAtlas::GlyphQuad>& glyphQuads);
 
     inline int32 FtRound(int32 val);
     inline int32 FtCeil(int32 val);
 
     static Mutex drawStringMutex;
+    static uint32 fontIdCounter; // Zero id is reserved for notdef glyphs, which don't depend on font
     static const int32 ftToPixelShift; // Int value for shift to convert FT point to pixel
     static const float32 ftToPixelScale; // Float value to convert FT point to pixel
 };
@@ -143,6 +149,12 @@ void FTFont::ClearCache()
         SafeRelease(fontMap.begin()->second);
         fontMap.erase(fontMap.begin());
     }
+
+    FontManager* fontManager = GetEngineContext()->fontManager;
+    if (fontManager != nullptr)
+    {
+        fontManager->GetGlyphAtlas()->Clear();
+    }
 }
 
 FTFont* FTFont::Clone() const
@@ -186,6 +198,11 @@ Font::StringMetrics FTFont::DrawStringToBuffer(float32 size, void* buffer, int32
     return internalFont->DrawString(str, buffer, bufWidth, bufHeight, 255, 255, 255, 255, size, true, offsetX, offsetY, justifyWidth, spaceAddon, ascendScale, descendScale, NULL, contentScaleIncluded);
 }
 
+Font::StringMetrics FTFont::DrawStringToGlyphs(float32 size, Vector<FTGlyphAtlas::GlyphQuad>& glyphQuads, int32 bufWidth, int32 bufHeight, int32 offsetX, int32 offsetY, int32 justifyWidth, int32 spaceAddon, const WideString& str, bool contentScaleIncluded)
+{
+    return internalFont->DrawString(str, nullptr, bufWidth, bufHeight, 255, 255, 255, 255, size, true, offsetX, offsetY, justifyWidth, spaceAddon, ascendScale, descendScale, NULL, contentScaleIncluded, &glyphQuads);
+}
+
 Font::StringMetrics FTFont::GetStringMetrics(float32 size, const WideString& str, Vector<float32>* charSizes) const
 {
     if (charSizes != nullptr)
@@ -245,6 +262,7 @@ DAVA::float32 FTFont::GetDescendScale() const
 ////////////////////////////////////////////////////////////////////////////////
 
 Mutex FTInternalFont::drawStringMutex;
+uint32 FTInternalFont::fontIdCounter = 0;
 
 /**
  /brief Wrap around FT_MulFix, because this function is written in assembler and
@@ -264,6 +282,7 @@ FT_Long FT_MulFix_Wrapper(FT_Long a, FT_Long b)
 
 FTInternalFont::FTInternalFont(const FilePath& path)
     : fontPath(path)
+    , fontId(++fontIdCounter)
 {
     ftm = GetEngineContext()->fontManager->GetFT();
     DVASSERT(ftm);
@@ -335,7 +354,8 @@ Font::StringMetrics FTInternalFont::DrawString(const WideString& str, void* buff
                                                int32 justifyWidth, int32 spaceAddon,
                                                float32 ascendScale, float32 descendScale,
                                                Vector<float32>* charSizes,
-                                               bool contentScaleIncluded)
+                                               bool contentScaleIncluded,
+                                               Vector<FTGlyphAtlas::GlyphQuad>* glyphQuads)
 {
     if (!initialized)
     {
@@ -430,7 +450,7 @@ Font::StringMetrics FTInternalFont::DrawString(const WideString& str, void* buff
                 if (error == 0)
                 {
                     FT_Glyph_Get_CBox(image, FT_GLYPH_BBOX_PIXELS, &bbox);
-                    if (realDraw)
+                    if (realDraw && glyphQuads == nullptr)
                     {
                         error = FT_Glyph_To_Bitmap(&image, FT_RENDER_MODE_NORMAL, 0, 1);
                     }
@@ -482,7 +502,14 @@ Font::StringMetrics FTInternalFont::DrawString(const WideString& str, void* buff
                 metrics.drawRect.dy = Max(metrics.drawRect.dy, top + height);
             }
 
-            if (realDraw && bbox.xMin < bufWidth && bbox.yMin < bufHeight)
+            if (glyphQuads != nullptr)
+            {
+                if (bbox.xMin < bufWidth && bbox.yMin < bufHeight)
+                {
+                    AddGlyphQuad(glyph, size, pen, multilineOffsetY, width, height, bufWidth, bufHeight, *glyphQuads);
+                }
+            }
+            else if (realDraw && bbox.xMin < bufWidth && bbox.yMin < bufHeight)
             {
                 FT_BitmapGlyph bit = FT_BitmapGlyph(image);
                 FT_Bitmap* bitmap = &bit->bitmap;
@@ -653,6 +680,82 @@ void FTInternalFont::Prepare(FT_Face face, FT_Vector* advances)
     }
 }
 
+void FTInternalFont::AddGlyphQuad(const Glyph& glyph, float32 size, const FT_Vector& pen, int32 multilineOffsetY,
+                                 int32 notdefWidth, int32 notdefHeight, int32 bufWidth, int32 bufHeight,
+                                 Vector<FTGlyphAtlas::GlyphQuad>& glyphQuads)
+{
+    FTGlyphAtlas* atlas = GetEngineContext()->fontManager->GetGlyphAtlas();
+
+    FTGlyphAtlas::GlyphKey key;
+    if (glyph.index > 0)
+    {
+        key.fontId = fontId;
+        key.size = uint32(size * 64.f + 0.5f);
+        key.glyphIndex = glyph.index;
+    }
+    else
+    {
+        // notdef glyph is a frame of guessed size, it is shared by all fonts
+        key.size = uint32(notdefWidth);
+        key.glyphIndex = uint32(notdefHeight);
+    }
+
+    FTGlyphAtlas::Glyph atlasGlyph;
+    if (!atlas->FindGlyph(key, atlasGlyph))
+    {
+        bool added = false;
+        if (glyph.index > 0)
+        {
+            // glyph is rasterized at origin, so it can be reused at any pen position
+            FT_Glyph image = nullptr;
+            if (FT_Glyph_Copy(glyph.image, &image) == 0)
+            {
+                if (FT_Glyph_To_Bitmap(&image, FT_RENDER_MODE_NORMAL, nullptr, 1) == 0)
+                {
+                    FT_BitmapGlyph bit = FT_BitmapGlyph(image);
+                    FT_Bitmap* bitmap = &bit->bitmap;
+                    added = atlas->AddGlyph(key, bit->left, bit->top, int32(bitmap->width), int32(bitmap->rows), bitmap->buffer, bitmap->pitch, atlasGlyph);
+                }
+                FT_Done_Glyph(image);
+            }
+        }
+        else if (notdefWidth > 0 && notdefHeight > 0)
+        {
+            Vector<uint8> frame(notdefWidth * notdefHeight, 0);
+            for (int32 h = 0; h < notdefHeight; ++h)
+            {
+                for (int32 w = 0; w < notdefWidth; ++w)
+                {
+                    if (w == 0 || w == notdefWidth - 1 || h == 0 || h == notdefHeight - 1)
+                        frame[h * notdefWidth + w] = 255;
+                }
+            }
+            added = atlas->AddGlyph(key, 0, notdefHeight, notdefWidth, notdefHeight, frame.data(), notdefWidth, atlasGlyph);
+        }
+
+        if (!added)
+        {
+            return;
+        }
+    }
+
+    int32 left = (int32(pen.x) >> ftToPixelShift) + atlasGlyph.left;
+    int32 top = multilineOffsetY - ((int32(pen.y) >> ftToPixelShift) + atlasGlyph.top);
+    if (top >= 0 && left >= 0)
+    {
+        int32 realW = Min(atlasGlyph.rect.dx, bufWidth - left);
+        int32 realH = Min(atlasGlyph.rect.dy, bufHeight - top);
+        if (realW > 0 && realH > 0)
+        {
+            FTGlyphAtlas::GlyphQuad quad;
+            quad.page = atlasGlyph.page;
+            quad.rect = Rect2i(left, top, realW, realH);
+            quad.pageRect = Rect2i(atlasGlyph.rect.x, atlasGlyph.rect.y, realW, realH);
+            glyphQuads.push_back(quad);
+        }
+    }
+}
+
 void FTInternalFont::ClearString()
 {
     glyphs.clear();
@@ -5,6 +5,7 @@
 #include "Base/BaseTypes.h"
 #include "Base/BaseMath.h"
 #include "Render/2D/Font.h"
+#include "Render/2D/FTGlyphAtlas.h"
 #include "Concurrency/Mutex.h"
 #include "FileSystem/FilePath.h"
 
@@ -82,6 +83,13 @@ public:
 	*/
     virtual StringMetrics DrawStringToBuffer(float32 size, void* buffer, int32 bufWidth, int32 bufHeight, int32 offsetX, int32 offsetY, int32 justifyWidth, int32 spaceAddon, const WideString& str, bool contentScaleIncluded = false);
 
+    /**
+		\brief Lay out string like DrawStringToBuffer, but place glyphs from shared glyph atlas instead of drawing them
+		\param[in, out] glyphQuads - placement of glyph images in buffer of specified size is appended to it, glyphs are clipped by buffer
+		\returns bounding rect for string in pixels
+	*/
+    StringMetrics DrawStringToGlyphs(float32 size, Vector<FTGlyphAtlas::GlyphQuad>& glyphQuads, int32 bufWidth, int32 bufHeight, int32 offsetX, int32 offsetY, int32 justifyWidth, int32 spaceAddon, const WideString& str, bool contentScaleIncluded = false);
+
     bool IsTextSupportsSoftwareRendering() const override;
 
     //We need to return font path
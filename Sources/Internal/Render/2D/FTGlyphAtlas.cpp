@@ -0,0 +1,240 @@
+#include "Render/2D/FTGlyphAtlas.h"
+#include "Concurrency/LockGuard.h"
+#include "Logger/Logger.h"
+#include "Math/RectPacker.h"
+#include "Render/Renderer.h"
+#include "Render/Texture.h"
+
+namespace DAVA
+{
+FTGlyphAtlas::FTGlyphAtlas()
+{
+    Renderer::GetSignals().needRestoreResources.Connect(this, &FTGlyphAtlas::Restore);
+}
+
+FTGlyphAtlas::~FTGlyphAtlas()
+{
+    Renderer::GetSignals().needRestoreResources.Disconnect(this);
+    ReleasePages(pages);
+    ReleasePages(retiredPages);
+    ReleasePages(releasedPages);
+}
+
+bool FTGlyphAtlas::FindGlyph(const GlyphKey& key, Glyph& glyph) const
+{
+    LockGuard<Mutex> lock(mutex);
+    auto it = glyphs.find(key);
+    if (it != glyphs.end())
+    {
+        glyph = it->second;
+        return true;
+    }
+    return false;
+}
+
+bool FTGlyphAtlas::AddGlyph(const GlyphKey& key, int32 left, int32 top, int32 width, int32 height, const uint8* pixels, int32 pitch, Glyph& glyph)
+{
+    LockGuard<Mutex> lock(mutex);
+
+    glyph = Glyph();
+    glyph.left = left;
+    glyph.top = top;
+
+    if (width > 0 && height > 0)
+    {
+        const Size2i paddedSize(width + GLYPH_PADDING, height + GLYPH_PADDING);
+        if (paddedSize.dx > int32(PAGE_SIZE) || paddedSize.dy > int32(PAGE_SIZE))
+        {
+            return false;
+        }
+
+        Rect2i paddedRect;
+        if (!PackGlyph(paddedSize, glyph.page, paddedRect))
+        {
+            if (clearedInFrame)
+            {
+                // text of current frame doesn't fit even into empty atlas, skip glyph instead of clearing atlas in loop
+                if (!overflowReported)
+                {
+                    Logger::Warning("[FTGlyphAtlas] %u pages are not enough for text of one frame, glyphs are skipped", MAX_PAGES);
+                    overflowReported = true;
+                }
+                return false;
+            }
+
+            // all pages are full, start from scratch. Text prepared before should be prepared again.
+            // Full pages may be already used by batches of current frame, so they are kept untouched until frame is executed
+            if (clearedInPrevFrame)
+            {
+                Logger::Warning("[FTGlyphAtlas] %u pages are full in consecutive frames, clear %u glyphs", uint32(pages.size()), uint32(glyphs.size()));
+            }
+            else
+            {
+                Logger::FrameworkDebug("[FTGlyphAtlas] %u pages are full, clear %u glyphs", uint32(pages.size()), uint32(glyphs.size()));
+            }
+            glyphs.clear();
+            std::move(pages.begin(), pages.end(), std::back_inserter(retiredPages));
+            pages.clear();
+            clearedInFrame = true;
+            ++generation;
+
+            bool packed = PackGlyph(paddedSize, glyph.page, paddedRect);
+            DVASSERT(packed);
+        }
+
+        glyph.rect = Rect2i(paddedRect.x, paddedRect.y, width, height);
+
+        Page& page = pages[glyph.page];
+        uint8* dst = page.pixels.data() + glyph.rect.y * PAGE_SIZE + glyph.rect.x;
+        for (int32 y = 0; y < height; ++y)
+        {
+            Memcpy(dst, pixels, width);
+            dst += PAGE_SIZE;
+            pixels += pitch;
+        }
+        page.changed = true;
+    }
+
+    glyphs[key] = glyph;
+    return true;
+}
+
+bool FTGlyphAtlas::PackGlyph(const Size2i& size, uint32& pageIndex, Rect2i& rect)
+{
+    for (uint32 i = 0; i < uint32(pages.size()); ++i)
+    {
+        if (pages[i].packer->AddRect(size, rect))
+        {
+            pageIndex = i;
+            return true;
+        }
+    }
+
+    if (pages.size() < MAX_PAGES)
+    {
+        pages.emplace_back();
+        Page& page = pages.back();
+        page.pixels.resize(PAGE_SIZE * PAGE_SIZE, 0);
+        page.packer.reset(new RectPacker(Rect2i(0, 0, PAGE_SIZE, PAGE_SIZE)));
+        page.changed = true;
+
+        pageIndex = uint32(pages.size()) - 1;
+        return page.packer->AddRect(size, rect);
+    }
+
+    return false;
+}
+
+Texture* FTGlyphAtlas::GetPageTexture(uint32 pageIndex)
+{
+    LockGuard<Mutex> lock(mutex);
+    DVASSERT(pageIndex < pages.size());
+
+    Page& page = pages[pageIndex];
+    if (page.texture == nullptr)
+    {
+        UploadPage(page);
+    }
+    return page.texture;
+}
+
+void FTGlyphAtlas::Upload()
+{
+    LockGuard<Mutex> lock(mutex);
+
+    // pages retired in this frame can still get glyphs drawn before clear
+    for (Page& page : retiredPages)
+    {
+        if (page.texture != nullptr && page.changed)
+        {
+            UploadPage(page);
+        }
+    }
+    for (Page& page : pages)
+    {
+        if (page.changed)
+        {
+            UploadPage(page);
+        }
+    }
+
+    // textures of pages retired in previous frame are not referenced by batches of this frame
+    ReleasePages(releasedPages);
+    releasedPages = std::move(retiredPages);
+    retiredPages.clear();
+
+    clearedInPrevFrame = clearedInFrame;
+    clearedInFrame = false;
+    overflowReported = false;
+}
+
+void FTGlyphAtlas::UploadPage(Page& page)
+{
+    if (page.texture == nullptr)
+    {
+        page.texture = Texture::CreateTextFromData(FORMAT_A8, page.pixels.data(), PAGE_SIZE, PAGE_SIZE, false, "FTGlyphAtlas");
+        page.texture->SetWrapMode(rhi::TEXADDR_CLAMP, rhi::TEXADDR_CLAMP);
+        page.texture->SetMinMagFilter(rhi::TEXFILTER_LINEAR, rhi::TEXFILTER_LINEAR, rhi::TEXMIPFILTER_NONE);
+    }
+    else
+    {
+        page.texture->TexImage(0, PAGE_SIZE, PAGE_SIZE, page.pixels.data(), uint32(page.pixels.size()), Texture::INVALID_CUBEMAP_FACE);
+    }
+    page.changed = false;
+}
+
+void FTGlyphAtlas::ReleasePages(Vector<Page>& pagesToRelease)
+{
+    for (Page& page : pagesToRelease)
+    {
+        SafeRelease(page.texture);
+    }
+    pagesToRelease.clear();
+}
+
+void FTGlyphAtlas::Restore()
+{
+    LockGuard<Mutex> lock(mutex);
+    for (Vector<Page>* pagesToRestore : { &pages, &retiredPages, &releasedPages })
+    {
+        for (Page& page : *pagesToRestore)
+        {
+            if (page.texture != nullptr && rhi::NeedRestoreTexture(page.texture->handle))
+            {
+                UploadPage(page);
+            }
+        }
+    }
+}
+
+void FTGlyphAtlas::Clear()
+{
+    LockGuard<Mutex> lock(mutex);
+    glyphs.clear();
+    ReleasePages(pages);
+    ReleasePages(retiredPages);
+    ReleasePages(releasedPages);
+    clearedInFrame = false;
+    clearedInPrevFrame = false;
+    overflowReported = false;
+    ++generation;
+}
+
+uint32 FTGlyphAtlas::GetGeneration() const
+{
+    LockGuard<Mutex> lock(mutex);
+    return generation;
+}
+
+uint32 FTGlyphAtlas::GetPagesCount() const
+{
+    LockGuard<Mutex> lock(mutex);
+    return uint32(pages.size());
+}
+
+uint32 FTGlyphAtlas::GetGlyphsCount() const
+{
+    LockGuard<Mutex> lock(mutex);
+    return uint32(glyphs.size());
+}
+}
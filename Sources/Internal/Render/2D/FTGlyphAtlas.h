@@ -0,0 +1,120 @@
+#pragma once
+
+#include "Base/BaseTypes.h"
+#include "Base/BaseMath.h"
+#include "Concurrency/Mutex.h"
+
+namespace DAVA
+{
+class RectPacker;
+class Texture;
+
+/**
+    Shared storage of rasterized FreeType glyphs.
+
+    Each glyph of each font size is rasterized once into A8 pages and reused by all text blocks.
+    Texture of page is created on first request, later changes of pages are uploaded by `Upload`
+    once per frame, before frame is executed.
+    When all pages are full, atlas is cleared and its generation is increased, so text laid out with
+    previous generation should be prepared again. Full pages are retired with their textures untouched
+    and released by `Upload` of next frame, because batches of current frame may still sample them.
+    Atlas is cleared at most once per frame, glyphs which don't fit after that are skipped.
+*/
+class FTGlyphAtlas final
+{
+public:
+    static const uint32 PAGE_SIZE = 1024;
+    static const uint32 MAX_PAGES = 4;
+    static const int32 GLYPH_PADDING = 1; //<! Empty pixels between glyphs to avoid filtering artifacts
+
+    struct GlyphKey
+    {
+        uint32 fontId = 0;
+        uint32 size = 0; //<! Physical font size in 1/64 of pixel
+        uint32 glyphIndex = 0;
+
+        bool operator<(const GlyphKey& other) const;
+    };
+
+    struct Glyph
+    {
+        uint32 page = 0;
+        Rect2i rect; //<! Glyph pixels in page, empty for glyphs without image
+        int32 left = 0; //<! Offset of bitmap from pen position, as FT_BitmapGlyph left
+        int32 top = 0; //<! Offset of bitmap from pen position, as FT_BitmapGlyph top
+    };
+
+    /** Placement of glyph image in laid out text */
+    struct GlyphQuad
+    {
+        uint32 page = 0;
+        Rect2i rect; //<! Destination rect in text pixels
+        Rect2i pageRect; //<! Source rect in page pixels
+    };
+
+    FTGlyphAtlas();
+    ~FTGlyphAtlas();
+
+    FTGlyphAtlas(const FTGlyphAtlas&) = delete;
+    FTGlyphAtlas& operator=(const FTGlyphAtlas&) = delete;
+
+    bool FindGlyph(const GlyphKey& key, Glyph& glyph) const;
+
+    /**
+        Copy glyph image with specified `pitch` into free place of atlas.
+        Atlas is cleared if there is no free place in all pages.
+        Returns false if image is bigger than page or atlas was already cleared in current frame.
+    */
+    bool AddGlyph(const GlyphKey& key, int32 left, int32 top, int32 width, int32 height, const uint8* pixels, int32 pitch, Glyph& glyph);
+
+    /** Get texture of page, texture is created with current page content on first request */
+    Texture* GetPageTexture(uint32 page);
+
+    /** Upload changed pages to textures and release pages retired in previous frame, called once per frame */
+    void Upload();
+
+    /** Remove all glyphs and release pages */
+    void Clear();
+
+    uint32 GetGeneration() const;
+    uint32 GetPagesCount() const;
+    uint32 GetGlyphsCount() const;
+
+private:
+    struct Page
+    {
+        Vector<uint8> pixels;
+        std::unique_ptr<RectPacker> packer;
+        Texture* texture = nullptr;
+        bool changed = false;
+    };
+
+    bool PackGlyph(const Size2i& size, uint32& page, Rect2i& rect);
+    void UploadPage(Page& page);
+    void ReleasePages(Vector<Page>& pagesToRelease);
+    void Restore();
+
+    mutable Mutex mutex;
+    Vector<Page> pages;
+    Vector<Page> retiredPages; //<! Pages cleared in current frame
+    Vector<Page> releasedPages; //<! Pages cleared in previous frame, released on next `Upload`
+    Map<GlyphKey, Glyph> glyphs;
+    uint32 generation = 0;
+    bool clearedInFrame = false;
+    bool clearedInPrevFrame = false;
+    bool overflowReported = false;
+};
+
+inline bool FTGlyphAtlas::GlyphKey::operator<(const GlyphKey& other) const
+{
+    if (fontId != other.fontId)
+    {
+        return fontId < other.fontId;
+    }
+    if (size != other.size)
+    {
+        return size < other.size;
+    }
+    return glyphIndex < other.glyphIndex;
+}
+}
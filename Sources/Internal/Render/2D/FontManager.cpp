@@ -2,6 +2,7 @@
 #include "FileSystem/KeyedArchive.h"
 #include "Render/2D/FontManager.h"
 #include "Render/2D/FTFont.h"
+#include "Render/2D/FTGlyphAtlas.h"
 #include "Render/2D/GraphicFont.h"
 #include "Render/2D/Private/FTManager.h"
 #include "Logger/Logger.h"
@@ -125,6 +126,7 @@ struct GraphicFontConfigDescriptor : public FontConfigDescriptor
 
 FontManager::FontManager()
     : ftmanager(std::make_unique<FTManager>())
+    , glyphAtlas(std::make_unique<FTGlyphAtlas>())
 {
 }
 
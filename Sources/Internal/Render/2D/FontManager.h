@@ -9,6 +9,7 @@ namespace DAVA
 {
 class Font;
 class FTManager;
+class FTGlyphAtlas;
 class FilePath;
 
 namespace FontManagerDetails
@@ -30,6 +31,12 @@ public:
         return ftmanager.get();
     }
 
+    /** Shared atlas of rasterized FreeType glyphs */
+    FTGlyphAtlas* GetGlyphAtlas()
+    {
+        return glyphAtlas.get();
+    }
+
     RefPtr<Font> LoadFont(const FilePath& fontPath);
 
     /**
@@ -83,5 +90,6 @@ private:
     UnorderedMap<String, FontPreset> fontPresetMap;
     UnorderedMap<String, std::unique_ptr<FontManagerDetails::FontConfigDescriptor>> fontConfigs;
     std::unique_ptr<FTManager> ftmanager;
+    std::unique_ptr<FTGlyphAtlas> glyphAtlas;
 };
 };
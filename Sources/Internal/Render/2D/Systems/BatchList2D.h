@@ -0,0 +1,51 @@
+#pragma once
+
+#include "Base/BaseTypes.h"
+#include "Math/Matrix4.h"
+#include "Math/Rect.h"
+#include "Render/RHI/rhi_Public.h"
+
+namespace DAVA
+{
+class NMaterial;
+
+/**
+    Batches recorded by RenderSystem2D between BeginRecording and EndRecording.
+    Vertices are stored in format of RenderSystem2D batching buffers, so PushBatchList draws them again
+    by plain copy without generating sprite geometry.
+    Materials and textures are not retained, owner of list should clear it when they are changed.
+*/
+struct BatchList2D
+{
+    struct Batch
+    {
+        NMaterial* material = nullptr;
+        rhi::HTextureSet textureSetHandle;
+        rhi::HSamplerState samplerStateHandle;
+        rhi::PrimitiveType primitiveType = rhi::PRIMITIVE_TRIANGLELIST;
+        uint32 texCoordCount = 1;
+        bool useWorldMatrix = false;
+        Matrix4 worldMatrix;
+        Rect clip;
+        uint32 vertexOffset = 0; //<! In bytes
+        uint32 vertexCount = 0;
+        uint32 indexOffset = 0;
+        uint32 indexCount = 0;
+    };
+
+    Vector<Batch> batches;
+    Vector<uint8> vertices;
+    Vector<uint16> indices; //<! Relative to first vertex of batch
+    bool complete = true; //<! False if something was drawn bypassing batching during recording
+
+    void Clear();
+};
+
+inline void BatchList2D::Clear()
+{
+    batches.clear();
+    vertices.clear();
+    indices.clear();
+    complete = true;
+}
+}
@@ -5,6 +5,8 @@
 #include "UI/UIControlBackground.h"
 #include "UI/UIControlSystem.h"
 
+#include "Render/2D/FontManager.h"
+#include "Render/2D/FTGlyphAtlas.h"
 #include "Render/2D/Systems/VirtualCoordinatesSystem.h"
 #include "Render/DynamicBufferAllocator.h"
 #include "Render/Material/NMaterial.h"
@@ -193,6 +195,13 @@ void RenderSystem2D::BeginFrame()
 
 void RenderSystem2D::EndFrame()
 {
+    // glyphs added to atlas during frame should be in textures before frame is executed
+    FontManager* fontManager = GetEngineContext()->fontManager;
+    if (fontManager != nullptr)
+    {
+        fontManager->GetGlyphAtlas()->Upload();
+    }
+
     if (pass2DHandle != rhi::InvalidHandle)
     {
         Flush();
@@ -538,6 +547,13 @@ void RenderSystem2D::DrawPacket(rhi::Packet& packet)
         return;
     }
     Flush();
+
+    // packet can't be recorded, so recorded lists would miss it
+    for (BatchList2D* list : recordingLists)
+    {
+        list->complete = false;
+    }
+
     if (currentClip.dx > 0.f && currentClip.dy > 0.f)
     {
         const Rect& transformedClipRect = TransformClipRect(currentClip, currentVirtualToPhysicalMatrix);
@@ -577,10 +593,96 @@ void RenderSystem2D::PushBatch(const BatchDescriptor2D& batchDesc)
         return;
     }
 
+    uint32 trimmedTexCoordCount = Max(batchDesc.texCoordCount, 1u); //for zero texCoordCount count we just use 1 empty texcoord stream for batching optimization
+    BeginBatchPacket(batchDesc, trimmedTexCoordCount);
+
+    // Begin define draw color
+    Color useColor = batchDesc.singleColor;
+    if (highlightControlsVerticesLimit > 0 && batchDesc.vertexCount > highlightControlsVerticesLimit && Renderer::GetOptions()->IsOptionEnabled(RenderOptions::HIGHLIGHT_HARD_CONTROLS))
+    {
+        // Highlight too big controls with magenta color
+        static Color magenta = Color(1.f, 0.f, 1.f, 1.f);
+        useColor = magenta;
+    }
+    uint32 useColorRGBA = rhi::NativeColorRGBA(useColor.r, useColor.g, useColor.b, useColor.a);
+    // End define draw color
+
+    // Prepare vertex color ptr (batchDesc.singleColor or batchDesc.colorPointer)
+    const uint32* colorPtr = batchDesc.colorPointer;
+    uint32 colorStride = batchDesc.colorStride;
+    if (colorPtr == nullptr)
+    {
+        colorPtr = &useColorRGBA;
+        colorStride = 0;
+    }
+
+    // Prepare texture coordinates ptr (batchDesc.texCoordPointer or zero vector)
+    const float32* texPtr = batchDesc.texCoordPointer[0];
+    uint32 texStride = batchDesc.texCoordStride;
+    if ((texPtr == nullptr) || (batchDesc.texCoordCount == 0)) //for zero texCoordCount count we just use 1 empty texcoord stream for batching optimization
+    {
+        static float32 TEX_ZERO[2] = { 0.f, 0.f };
+        texPtr = TEX_ZERO;
+        texStride = 0;
+    }
+
+    // Begin fill vertex and index buffers
+    struct BatchVertex
+    {
+        Vector3 pos;
+        Vector2 uv;
+        uint32 color;
+        //optional explicit params
+        Vector2 uv_ext[BatchDescriptor2D::MAX_TEXTURE_STREAMS_COUNT - 1];
+    };
+
+    uint32 vertexStride = GetVBOStride(currentTexcoordStreamCount);
+    currentVertexBuffer.resize(vertexStride * (vertexIndex + batchDesc.vertexCount));
+    currentIndexBuffer.resize(indexIndex + batchDesc.indexCount);
+
+    for (uint32 i = 0; i < batchDesc.vertexCount; ++i)
+    {
+        BatchVertex& v = *OffsetPointer<BatchVertex>(currentVertexBuffer.data(), vertexStride * (vertexIndex + i));
+        v.pos.x = batchDesc.vertexPointer[i * batchDesc.vertexStride];
+        v.pos.y = batchDesc.vertexPointer[i * batchDesc.vertexStride + 1];
+        //TODO: rethink do we still require z in rhi?
+        v.pos.z = 0.f; // axis Z, empty but need for EVF_VERTEX format
+        v.uv.x = texPtr[i * texStride];
+        v.uv.y = texPtr[i * texStride + 1];
+        v.color = colorPtr[i * colorStride];
+    }
+    //add optional texture streams
+    for (uint32 texStream = 1; texStream < batchDesc.texCoordCount; ++texStream)
+    {
+        for (uint32 i = 0; i < batchDesc.vertexCount; ++i)
+        {
+            DVASSERT(batchDesc.texCoordPointer[texStream] != nullptr);
+            BatchVertex& v = *OffsetPointer<BatchVertex>(currentVertexBuffer.data(), vertexStride * (vertexIndex + i));
+            v.uv_ext[texStream - 1].x = batchDesc.texCoordPointer[texStream][i * texStride];
+            v.uv_ext[texStream - 1].y = batchDesc.texCoordPointer[texStream][i * texStride + 1];
+        }
+    }
+
+    uint32 ii = indexIndex;
+    for (uint32 i = 0; i < batchDesc.indexCount; ++i)
+    {
+        currentIndexBuffer[ii++] = vertexIndex + batchDesc.indexPointer[i];
+    }
+    // End fill vertex and index buffers
+
+    if (!recordingLists.empty())
+    {
+        RecordBatch(batchDesc, batchDesc.indexPointer);
+    }
+
+    EndBatchPacket(batchDesc.vertexCount, batchDesc.indexCount);
+}
+
+void RenderSystem2D::BeginBatchPacket(const BatchDescriptor2D& batchDesc, uint32 trimmedTexCoordCount)
+{
 #if defined(__DAVAENGINE_RENDERSTATS__)
     ++Renderer::GetRenderStats().batches2d;
 #endif
-    uint32 trimmedTexCoordCount = Max(batchDesc.texCoordCount, 1u); //for zero texCoordCount count we just use 1 empty texcoord stream for batching optimization
     if ((vertexIndex + batchDesc.vertexCount > MAX_VERTICES) || (indexIndex + batchDesc.indexCount > MAX_INDECES) || (trimmedTexCoordCount != currentTexcoordStreamCount))
     {
         // Buffer overflow or format changed. Switch to next VBO.
@@ -665,96 +767,149 @@ void RenderSystem2D::PushBatch(const BatchDescriptor2D& batchDesc)
         currentPacket.samplerState = batchDesc.samplerStateHandle;
     }
     // End new packet
+}
 
-    // Begin define draw color
-    Color useColor = batchDesc.singleColor;
-    if (highlightControlsVerticesLimit > 0 && batchDesc.vertexCount > highlightControlsVerticesLimit && Renderer::GetOptions()->IsOptionEnabled(RenderOptions::HIGHLIGHT_HARD_CONTROLS))
+void RenderSystem2D::EndBatchPacket(uint32 vertexCount, uint32 indexCount)
+{
+    switch (currentPacket.primitiveType)
     {
-        // Highlight too big controls with magenta color
-        static Color magenta = Color(1.f, 0.f, 1.f, 1.f);
-        useColor = magenta;
+    case rhi::PRIMITIVE_LINELIST:
+        currentPacket.primitiveCount += indexCount / 2;
+        break;
+    case rhi::PRIMITIVE_TRIANGLELIST:
+        currentPacket.primitiveCount += indexCount / 3;
+        break;
+    case rhi::PRIMITIVE_TRIANGLESTRIP:
+        currentPacket.primitiveCount += indexCount - 2;
+        break;
     }
-    uint32 useColorRGBA = rhi::NativeColorRGBA(useColor.r, useColor.g, useColor.b, useColor.a);
-    // End define draw color
 
-    // Prepare vertex color ptr (batchDesc.singleColor or batchDesc.colorPointer)
-    const uint32* colorPtr = batchDesc.colorPointer;
-    uint32 colorStride = batchDesc.colorStride;
-    if (colorPtr == nullptr)
-    {
-        colorPtr = &useColorRGBA;
-        colorStride = 0;
-    }
+    indexIndex += indexCount;
+    vertexIndex += vertexCount;
+}
 
-    // Prepare texture coordinates ptr (batchDesc.texCoordPointer or zero vector)
-    const float32* texPtr = batchDesc.texCoordPointer[0];
-    uint32 texStride = batchDesc.texCoordStride;
-    if ((texPtr == nullptr) || (batchDesc.texCoordCount == 0)) //for zero texCoordCount count we just use 1 empty texcoord stream for batching optimization
-    {
-        static float32 TEX_ZERO[2] = { 0.f, 0.f };
-        texPtr = TEX_ZERO;
-        texStride = 0;
+void RenderSystem2D::RecordBatch(const BatchDescriptor2D& batchDesc, const uint16* indices)
+{
+    // Vertices of batch are already converted and placed to current buffer
+    const uint32 vertexStride = GetVBOStride(currentTexcoordStreamCount);
+    const uint8* vertices = currentVertexBuffer.data() + vertexStride * vertexIndex;
+    const uint32 verticesSize = vertexStride * batchDesc.vertexCount;
+    const bool useWorldMatrix = batchDesc.worldMatrix != nullptr;
+
+    for (BatchList2D* list : recordingLists)
+    {
+        BatchList2D::Batch* batch = list->batches.empty() ? nullptr : &list->batches.back();
+
+        // Append to previous batch with the same state, so recorded list is drawn by few copies
+        bool canMerge = batch != nullptr &&
+        batch->material == batchDesc.material &&
+        batch->textureSetHandle == batchDesc.textureSetHandle &&
+        batch->samplerStateHandle == batchDesc.samplerStateHandle &&
+        batch->primitiveType == batchDesc.primitiveType &&
+        batch->primitiveType != rhi::PRIMITIVE_TRIANGLESTRIP &&
+        batch->texCoordCount == currentTexcoordStreamCount &&
+        batch->clip == currentClip &&
+        batch->useWorldMatrix == useWorldMatrix &&
+        (!useWorldMatrix || batch->worldMatrix == *batchDesc.worldMatrix) &&
+        batch->vertexCount + batchDesc.vertexCount <= MAX_VERTICES &&
+        batch->indexCount + batchDesc.indexCount <= MAX_INDECES;
+
+        uint32 baseVertex = 0;
+        if (canMerge)
+        {
+            baseVertex = batch->vertexCount;
+        }
+        else
+        {
+            list->batches.emplace_back();
+            batch = &list->batches.back();
+            batch->material = batchDesc.material;
+            batch->textureSetHandle = batchDesc.textureSetHandle;
+            batch->samplerStateHandle = batchDesc.samplerStateHandle;
+            batch->primitiveType = batchDesc.primitiveType;
+            batch->texCoordCount = currentTexcoordStreamCount;
+            batch->useWorldMatrix = useWorldMatrix;
+            if (useWorldMatrix)
+            {
+                batch->worldMatrix = *batchDesc.worldMatrix;
+            }
+            batch->clip = currentClip;
+            batch->vertexOffset = static_cast<uint32>(list->vertices.size());
+            batch->indexOffset = static_cast<uint32>(list->indices.size());
+        }
+
+        list->vertices.insert(list->vertices.end(), vertices, vertices + verticesSize);
+        for (uint32 i = 0; i < batchDesc.indexCount; ++i)
+        {
+            list->indices.push_back(static_cast<uint16>(baseVertex + indices[i]));
+        }
+        batch->vertexCount += batchDesc.vertexCount;
+        batch->indexCount += batchDesc.indexCount;
     }
+}
 
-    // Begin fill vertex and index buffers
-    struct BatchVertex
-    {
-        Vector3 pos;
-        Vector2 uv;
-        uint32 color;
-        //optional explicit params
-        Vector2 uv_ext[BatchDescriptor2D::MAX_TEXTURE_STREAMS_COUNT - 1];
-    };
+void RenderSystem2D::BeginRecording(BatchList2D* list)
+{
+    DVASSERT(list != nullptr);
+    list->Clear();
+    recordingLists.push_back(list);
+}
 
-    uint32 vertexStride = GetVBOStride(currentTexcoordStreamCount);
-    currentVertexBuffer.resize(vertexStride * (vertexIndex + batchDesc.vertexCount));
-    currentIndexBuffer.resize(indexIndex + batchDesc.indexCount);
+void RenderSystem2D::EndRecording()
+{
+    DVASSERT(!recordingLists.empty());
+    recordingLists.pop_back();
+}
 
-    for (uint32 i = 0; i < batchDesc.vertexCount; ++i)
-    {
-        BatchVertex& v = *OffsetPointer<BatchVertex>(currentVertexBuffer.data(), vertexStride * (vertexIndex + i));
-        v.pos.x = batchDesc.vertexPointer[i * batchDesc.vertexStride];
-        v.pos.y = batchDesc.vertexPointer[i * batchDesc.vertexStride + 1];
-        //TODO: rethink do we still require z in rhi?
-        v.pos.z = 0.f; // axis Z, empty but need for EVF_VERTEX format
-        v.uv.x = texPtr[i * texStride];
-        v.uv.y = texPtr[i * texStride + 1];
-        v.color = colorPtr[i * colorStride];
-    }
-    //add optional texture streams
-    for (uint32 texStream = 1; texStream < batchDesc.texCoordCount; ++texStream)
+void RenderSystem2D::PushBatchList(const BatchList2D& list)
+{
+    const Rect clip = currentClip;
+
+    for (const BatchList2D::Batch& batch : list.batches)
     {
-        for (uint32 i = 0; i < batchDesc.vertexCount; ++i)
+        currentClip = batch.clip;
+
+        Matrix4 worldMatrix = batch.worldMatrix;
+        BatchDescriptor2D batchDesc;
+        batchDesc.vertexCount = batch.vertexCount;
+        batchDesc.indexCount = batch.indexCount;
+        batchDesc.texCoordCount = batch.texCoordCount;
+        batchDesc.textureSetHandle = batch.textureSetHandle;
+        batchDesc.samplerStateHandle = batch.samplerStateHandle;
+        batchDesc.primitiveType = batch.primitiveType;
+        batchDesc.material = batch.material;
+        batchDesc.worldMatrix = batch.useWorldMatrix ? &worldMatrix : nullptr;
+
+        BeginBatchPacket(batchDesc, batch.texCoordCount);
+
+        const uint32 vertexStride = GetVBOStride(currentTexcoordStreamCount);
+        currentVertexBuffer.resize(vertexStride * (vertexIndex + batch.vertexCount));
+        Memcpy(currentVertexBuffer.data() + vertexStride * vertexIndex, list.vertices.data() + batch.vertexOffset, vertexStride * batch.vertexCount);
+
+        const uint16* indices = list.indices.data() + batch.indexOffset;
+        currentIndexBuffer.resize(indexIndex + batch.indexCount);
+        for (uint32 i = 0; i < batch.indexCount; ++i)
         {
-            DVASSERT(batchDesc.texCoordPointer[texStream] != nullptr);
-            BatchVertex& v = *OffsetPointer<BatchVertex>(currentVertexBuffer.data(), vertexStride * (vertexIndex + i));
-            v.uv_ext[texStream - 1].x = batchDesc.texCoordPointer[texStream][i * texStride];
-            v.uv_ext[texStream - 1].y = batchDesc.texCoordPointer[texStream][i * texStride + 1];
+            currentIndexBuffer[indexIndex + i] = vertexIndex + indices[i];
         }
-    }
 
-    uint32 ii = indexIndex;
-    for (uint32 i = 0; i < batchDesc.indexCount; ++i)
-    {
-        currentIndexBuffer[ii++] = vertexIndex + batchDesc.indexPointer[i];
+        if (!recordingLists.empty())
+        {
+            RecordBatch(batchDesc, indices);
+        }
+
+        EndBatchPacket(batch.vertexCount, batch.indexCount);
     }
-    // End fill vertex and index buffers
 
-    switch (currentPacket.primitiveType)
+    currentClip = clip;
+
+    if (!list.complete)
     {
-    case rhi::PRIMITIVE_LINELIST:
-        currentPacket.primitiveCount += batchDesc.indexCount / 2;
-        break;
-    case rhi::PRIMITIVE_TRIANGLELIST:
-        currentPacket.primitiveCount += batchDesc.indexCount / 3;
-        break;
-    case rhi::PRIMITIVE_TRIANGLESTRIP:
-        currentPacket.primitiveCount += batchDesc.indexCount - 2;
-        break;
+        for (BatchList2D* recordingList : recordingLists)
+        {
+            recordingList->complete = false;
+        }
     }
-
-    indexIndex += batchDesc.indexCount;
-    vertexIndex += batchDesc.vertexCount;
 }
 
 void RenderSystem2D::Draw(Sprite* sprite, SpriteDrawState* drawState, const Color& color)
@@ -5,6 +5,7 @@
 #include "Functional/Function.h"
 #include "Render/2D/Sprite.h"
 #include "Render/2D/Systems/BatchDescriptor2D.h"
+#include "Render/2D/Systems/BatchList2D.h"
 #include "Render/RenderBase.h"
 
 namespace DAVA
@@ -176,6 +177,18 @@ public:
 
     void PushBatch(const BatchDescriptor2D& batchDesc);
 
+    /**
+     * Copy all batches pushed until EndRecording into `list` in addition to drawing them.
+     * Recordings can be nested, batches are copied into every active list.
+     */
+    void BeginRecording(BatchList2D* list);
+    void EndRecording();
+
+    /**
+     * Draw batches recorded earlier. Batches are drawn with clip rects which were current during recording.
+     */
+    void PushBatchList(const BatchList2D& list);
+
     /*
      *  note - it will flush currently batched!
      *  it will also modify packet to add current clip
@@ -193,6 +206,7 @@ public:
     void Flush();
 
     void SetClip(const Rect& rect);
+    const Rect& GetClip() const;
     void IntersectClipRect(const Rect& rect);
     void RemoveClip();
 
@@ -318,6 +332,11 @@ private:
 
     void AddPacket(rhi::Packet& packet);
 
+    // Split of PushBatch: switch packet if batch state differs, then append vertices and finish batch
+    void BeginBatchPacket(const BatchDescriptor2D& batchDesc, uint32 trimmedTexCoordCount);
+    void EndBatchPacket(uint32 vertexCount, uint32 indexCount);
+    void RecordBatch(const BatchDescriptor2D& batchDesc, const uint16* indices);
+
     Rect TransformClipRect(const Rect& rect, const Matrix4& transformMatrix);
 
     inline bool IsRenderTargetPass()
@@ -385,6 +404,8 @@ private:
     uint32 currFrameErrorsFlags = NO_ERRORS;
     uint32 highlightControlsVerticesLimit = 0;
 
+    Vector<BatchList2D*> recordingLists;
+
     rhi::HRenderPass pass2DHandle;
     rhi::HPacketList packetList2DHandle;
     rhi::HRenderPass passTargetHandle;
@@ -399,6 +420,11 @@ inline void RenderSystem2D::SetHightlightControlsVerticesLimit(uint32 verticesCo
     highlightControlsVerticesLimit = verticesCount;
 }
 
+inline const Rect& RenderSystem2D::GetClip() const
+{
+    return currentClip;
+}
+
 inline uint32 RenderSystem2D::GetVertexLayoutId(uint32 texCoordStreamCount)
 {
     return vertexLayouts2d[texCoordStreamCount];
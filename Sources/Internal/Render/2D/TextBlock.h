@@ -13,6 +13,7 @@ namespace DAVA
 class TextBlockRender;
 class TextBlockSoftwareRender;
 class TextBlockGraphicRender;
+class TextBlockAtlasRender;
 class TextBox;
 
 /**
@@ -51,6 +52,18 @@ public:
     */
     static bool IsBiDiSupportEnabled();
 
+    /**
+    * \brief Sets drawing of FreeType text by glyphs from shared glyph atlas instead of texture per text.
+    * Text drawn from atlas has no sprite.
+    * \param value true to draw FreeType text from glyph atlas.
+    */
+    static void SetGlyphAtlasEnabled(bool value);
+
+    /**
+    * \brief Is FreeType text drawn from shared glyph atlas.
+    */
+    static bool IsGlyphAtlasEnabled();
+
     static TextBlock* Create(const Vector2& size);
 
     virtual void SetFont(Font* font);
@@ -149,6 +162,7 @@ private:
     void CalculateCacheParamsIfNeed();
 
     void SetFontInternal(Font* _font);
+    void CreateRender();
 
     Vector2 scale;
     Vector2 rectSize;
@@ -198,12 +212,14 @@ private:
     bool needMeasureLines : 1;
 
     static bool isBiDiSupportEnabled; //!< true if BiDi transformation support enabled
+    static bool isGlyphAtlasEnabled; //!< true if FreeType text is drawn from glyph atlas
     static Set<TextBlock*> registredTextBlocks;
     static Mutex textblockListMutex;
 
     friend class TextBlockRender;
     friend class TextBlockSoftwareRender;
     friend class TextBlockGraphicRender;
+    friend class TextBlockAtlasRender;
 
     TextBlockRender* textBlockRender = nullptr;
     TextBox* textBox = nullptr;
@@ -274,4 +290,9 @@ inline bool TextBlock::IsBiDiSupportEnabled()
     return isBiDiSupportEnabled;
 }
 
+inline bool TextBlock::IsGlyphAtlasEnabled()
+{
+    return isGlyphAtlasEnabled;
+}
+
 }; //end of namespace
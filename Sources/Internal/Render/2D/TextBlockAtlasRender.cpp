@@ -0,0 +1,214 @@
+#include "Render/2D/TextBlockAtlasRender.h"
+#include "Engine/Engine.h"
+#include "Render/2D/FontManager.h"
+#include "Render/2D/TextBlockGraphicRender.h"
+#include "Render/2D/Systems/RenderSystem2D.h"
+#include "Render/2D/Systems/VirtualCoordinatesSystem.h"
+#include "UI/UIControlSystem.h"
+
+namespace DAVA
+{
+TextBlockAtlasRender::TextBlockAtlasRender(TextBlock* textBlock)
+    : TextBlockRender(textBlock)
+    , ftFont(static_cast<FTFont*>(textBlock->font))
+{
+}
+
+TextBlockAtlasRender::~TextBlockAtlasRender() = default;
+
+TextBlockRender* TextBlockAtlasRender::Clone()
+{
+    TextBlockAtlasRender* result = new TextBlockAtlasRender(textBlock);
+    result->quads = quads;
+    result->vertices = vertices;
+    result->pageBatches = pageBatches;
+    result->textSize = textSize;
+    result->atlasGeneration = atlasGeneration;
+    return result;
+}
+
+void TextBlockAtlasRender::Prepare()
+{
+    TextBlockRender::Prepare();
+
+    FTGlyphAtlas* atlas = GetEngineContext()->fontManager->GetGlyphAtlas();
+
+    // Atlas can be cleared while glyphs of this text are added, quads added before clearing are invalid then.
+    // One more attempt is enough, because text never needs whole atlas
+    for (uint32 attempt = 0; attempt < 2; ++attempt)
+    {
+        atlasGeneration = atlas->GetGeneration();
+        quads.clear();
+        if (!textBlock->visualText.empty())
+        {
+            DrawText();
+        }
+
+        if (atlasGeneration == atlas->GetGeneration())
+        {
+            break;
+        }
+    }
+
+    textSize = textBlock->cacheFinalSize;
+    BuildVertices();
+}
+
+void TextBlockAtlasRender::PreDraw()
+{
+    if (atlasGeneration != GetEngineContext()->fontManager->GetGlyphAtlas()->GetGeneration())
+    {
+        Prepare();
+    }
+}
+
+void TextBlockAtlasRender::BuildVertices()
+{
+    std::stable_sort(quads.begin(), quads.end(), [](const FTGlyphAtlas::GlyphQuad& l, const FTGlyphAtlas::GlyphQuad& r) {
+        return l.page < r.page;
+    });
+
+    vertices.clear();
+    vertices.reserve(quads.size() * 4);
+    pageBatches.clear();
+
+    const VirtualCoordinatesSystem* vcs = GetEngineContext()->uiControlSystem->vcs;
+    const float32 pageScale = 1.f / float32(FTGlyphAtlas::PAGE_SIZE);
+
+    for (uint32 i = 0; i < uint32(quads.size()); ++i)
+    {
+        const FTGlyphAtlas::GlyphQuad& quad = quads[i];
+        if (pageBatches.empty() || pageBatches.back().page != quad.page)
+        {
+            PageBatch pageBatch;
+            pageBatch.page = quad.page;
+            pageBatch.firstQuad = i;
+            pageBatches.push_back(pageBatch);
+        }
+        ++pageBatches.back().quadsCount;
+
+        // quads are in physical pixels of text, same as pixels of software rendered text texture
+        Vector2 lt = vcs->ConvertPhysicalToVirtual(Vector2(float32(quad.rect.x), float32(quad.rect.y)));
+        Vector2 rb = vcs->ConvertPhysicalToVirtual(Vector2(float32(quad.rect.x + quad.rect.dx), float32(quad.rect.y + quad.rect.dy)));
+        Vector2 uvlt(quad.pageRect.x * pageScale, quad.pageRect.y * pageScale);
+        Vector2 uvrb((quad.pageRect.x + quad.pageRect.dx) * pageScale, (quad.pageRect.y + quad.pageRect.dy) * pageScale);
+
+        vertices.push_back({ lt, uvlt });
+        vertices.push_back({ Vector2(rb.x, lt.y), Vector2(uvrb.x, uvlt.y) });
+        vertices.push_back({ rb, uvrb });
+        vertices.push_back({ Vector2(lt.x, rb.y), Vector2(uvlt.x, uvrb.y) });
+    }
+}
+
+Vector2 TextBlockAtlasRender::GetAlignedOffset(const Vector2& rectSize, int32 align) const
+{
+    Vector2 result;
+    if (align & ALIGN_LEFT)
+    {
+        result.x = 0.f;
+    }
+    else if (align & ALIGN_RIGHT)
+    {
+        result.x = rectSize.x - textSize.x;
+    }
+    else
+    {
+        result.x = (rectSize.x - textSize.x) * 0.5f;
+    }
+
+    if (align & ALIGN_TOP)
+    {
+        result.y = 0.f;
+    }
+    else if (align & ALIGN_BOTTOM)
+    {
+        result.y = rectSize.y - textSize.y;
+    }
+    else
+    {
+        result.y = (rectSize.y - textSize.y) * 0.5f;
+    }
+    return result;
+}
+
+void TextBlockAtlasRender::Draw(const Color& textColor, const Vector2* offset)
+{
+    Vector2 position = textBlock->position + textBlock->GetSpriteOffset() + GetAlignedOffset(textBlock->rectSize, textBlock->GetVisualAlign());
+    if (offset)
+    {
+        position += *offset;
+    }
+
+    Matrix4 worldMatrix;
+    worldMatrix.BuildTranslation(Vector3(position.x, position.y, 0.f));
+    Draw(textColor, worldMatrix);
+}
+
+void TextBlockAtlasRender::Draw(const Color& textColor, const Matrix4& worldMatrix_)
+{
+    if (vertices.empty())
+    {
+        return;
+    }
+
+    FTGlyphAtlas* atlas = GetEngineContext()->fontManager->GetGlyphAtlas();
+    Matrix4 worldMatrix(worldMatrix_);
+    const uint32 maxQuads = TextBlockGraphicRender::GetSharedIndexBufferCapacity() / 6;
+
+    for (const PageBatch& pageBatch : pageBatches)
+    {
+        Texture* texture = atlas->GetPageTexture(pageBatch.page);
+        for (uint32 quad = 0; quad < pageBatch.quadsCount; quad += maxQuads)
+        {
+            const uint32 quadsCount = Min(maxQuads, pageBatch.quadsCount - quad);
+            const GlyphVertex& firstVertex = vertices[(pageBatch.firstQuad + quad) * 4];
+
+            BatchDescriptor2D batch;
+            batch.material = RenderSystem2D::DEFAULT_2D_TEXTURE_ALPHA8_MATERIAL;
+            batch.singleColor = textColor;
+            batch.vertexStride = VERTEX_STRIDE;
+            batch.texCoordStride = VERTEX_STRIDE;
+            batch.vertexPointer = firstVertex.position.data;
+            batch.texCoordPointer[0] = firstVertex.texCoord.data;
+            batch.textureSetHandle = texture->singleTextureSet;
+            batch.samplerStateHandle = texture->samplerStateHandle;
+            batch.vertexCount = quadsCount * 4;
+            batch.indexPointer = TextBlockGraphicRender::GetSharedIndexBuffer();
+            batch.indexCount = quadsCount * 6;
+            batch.worldMatrix = &worldMatrix;
+            RenderSystem2D::Instance()->PushBatch(batch);
+        }
+    }
+}
+
+Font::StringMetrics TextBlockAtlasRender::DrawTextSL(const WideString& drawText, int32 x, int32 y, int32 w)
+{
+    return ftFont->DrawStringToGlyphs(textBlock->renderSize, quads, x, y,
+                                      -textBlock->cacheOx,
+                                      -textBlock->cacheOy,
+                                      0,
+                                      0,
+                                      drawText,
+                                      true);
+}
+
+Font::StringMetrics TextBlockAtlasRender::DrawTextML(const WideString& drawText, int32 x, int32 y, int32 w, int32 xOffset, uint32 yOffset, int32 lineSize)
+{
+    const VirtualCoordinatesSystem* vcs = GetEngineContext()->uiControlSystem->vcs;
+    int32 justifyWidth = 0;
+    int32 spaceAddon = 0;
+    if (textBlock->cacheUseJustify)
+    {
+        justifyWidth = int32(std::ceil(vcs->ConvertVirtualToPhysicalX(float32(w))));
+        spaceAddon = int32(std::ceil(vcs->ConvertVirtualToPhysicalY(float32(lineSize))));
+    }
+
+    return ftFont->DrawStringToGlyphs(textBlock->renderSize, quads, x, y,
+                                      -textBlock->cacheOx + int32(vcs->ConvertVirtualToPhysicalX(float32(xOffset))),
+                                      -textBlock->cacheOy + int32(vcs->ConvertVirtualToPhysicalY(float32(yOffset))),
+                                      justifyWidth,
+                                      spaceAddon,
+                                      drawText,
+                                      true);
+}
+}
@@ -0,0 +1,68 @@
+#pragma once
+
+#include "Render/2D/TextBlockRender.h"
+#include "Render/2D/FTFont.h"
+#include "Render/2D/FTGlyphAtlas.h"
+
+namespace DAVA
+{
+/**
+    Render of FreeType text by glyph quads from shared `FTGlyphAtlas`.
+    Unlike TextBlockSoftwareRender it doesn't create texture for each text, so it has no sprite,
+    text is drawn by `Draw` into rect of text block or by specified transform.
+*/
+class TextBlockAtlasRender : public TextBlockRender
+{
+public:
+    TextBlockAtlasRender(TextBlock*);
+    ~TextBlockAtlasRender();
+
+    void Prepare() override;
+    void PreDraw() override;
+    void Draw(const Color& textColor, const Vector2* offset) override;
+    TextBlockRender* Clone() override;
+
+    /** Draw text with top left corner in origin of `worldMatrix`, text vertices are in virtual coordinates */
+    void Draw(const Color& textColor, const Matrix4& worldMatrix);
+
+    /** Size of text in virtual coordinates, same as size of sprite in TextBlockSoftwareRender */
+    const Vector2& GetTextSize() const;
+
+    /** Top left corner of text aligned with `align` in rect of `rectSize` */
+    Vector2 GetAlignedOffset(const Vector2& rectSize, int32 align) const;
+
+private:
+    struct GlyphVertex
+    {
+        Vector2 position;
+        Vector2 texCoord;
+    };
+
+    struct PageBatch
+    {
+        uint32 page = 0;
+        uint32 firstQuad = 0;
+        uint32 quadsCount = 0;
+    };
+
+    static const uint32 VERTEX_STRIDE = sizeof(GlyphVertex) / sizeof(float32);
+
+    Font::StringMetrics DrawTextSL(const WideString& drawText, int32 x, int32 y, int32 w) override;
+    Font::StringMetrics DrawTextML(const WideString& drawText, int32 x, int32 y, int32 w,
+                                   int32 xOffset, uint32 yOffset, int32 lineSize) override;
+
+    void BuildVertices();
+
+    FTFont* ftFont = nullptr;
+    Vector<FTGlyphAtlas::GlyphQuad> quads;
+    Vector<GlyphVertex> vertices;
+    Vector<PageBatch> pageBatches;
+    Vector2 textSize;
+    uint32 atlasGeneration = 0;
+};
+
+inline const Vector2& TextBlockAtlasRender::GetTextSize() const
+{
+    return textSize;
+}
+}
@@ -1,6 +1,7 @@
 #include "DynamicBufferAllocator.h"
 #include "Render/Renderer.h"
 #include "Functional/Function.h"
+#include "Math/MathHelpers.h"
 #include <queue>
 
 namespace DAVA
@@ -209,8 +210,106 @@ private:
     List<BufferInfo*> freeBuffers;
 };
 
+struct InstanceBufferAllocator
+{
+    static const uint32 MIN_BUFFER_SIZE = 4096;
+
+    struct BufferInfo
+    {
+        rhi::HVertexBuffer buffer;
+        uint32 allocatedSize;
+        rhi::HSyncObject readySync;
+    };
+
+    AllocResultVB AllocateData(uint32 size, uint32 count)
+    {
+        DVASSERT(size && count);
+
+        //buffers are pooled by power of two sizes
+        uint32 requiredSize = static_cast<uint32>(NextPowerOf2(static_cast<int32>(Max(size * count, MIN_BUFFER_SIZE))));
+
+        BufferInfo* bufferInfo = nullptr;
+        auto it = std::find_if(freeBuffers.begin(), freeBuffers.end(), [requiredSize](const BufferInfo* b) { return b->allocatedSize == requiredSize; });
+        if (it != freeBuffers.end())
+        {
+            bufferInfo = *it;
+            freeBuffers.erase(it);
+        }
+        else
+        {
+            bufferInfo = new BufferInfo();
+            bufferInfo->allocatedSize = requiredSize;
+            bufferInfo->buffer = BufferProxy<rhi::HVertexBuffer>::CreateBuffer(requiredSize);
+        }
+
+        bufferInfo->readySync = rhi::GetCurrentFrameSyncObject();
+        mappedBuffers.push_back(bufferInfo);
+
+        uint8* data = BufferProxy<rhi::HVertexBuffer>::MapBuffer(bufferInfo->buffer, 0, requiredSize);
+        return AllocResultVB{ bufferInfo->buffer, data, 0, count };
+    }
+
+    void Clear()
+    {
+        for (auto b : mappedBuffers)
+        {
+            BufferProxy<rhi::HVertexBuffer>::UnmapBuffer(b->buffer);
+            BufferProxy<rhi::HVertexBuffer>::DeleteBuffer(b->buffer);
+            SafeDelete(b);
+        }
+        mappedBuffers.clear();
+
+        for (auto b : usedBuffers)
+        {
+            BufferProxy<rhi::HVertexBuffer>::DeleteBuffer(b->buffer);
+            SafeDelete(b);
+        }
+        usedBuffers.clear();
+
+        for (auto b : freeBuffers)
+        {
+            BufferProxy<rhi::HVertexBuffer>::DeleteBuffer(b->buffer);
+            SafeDelete(b);
+        }
+        freeBuffers.clear();
+    }
+
+    void BeginFrame()
+    {
+        auto it = usedBuffers.begin();
+        while (it != usedBuffers.end())
+        {
+            if (rhi::SyncObjectSignaled((*it)->readySync))
+            {
+                freeBuffers.push_back(*it);
+                it = usedBuffers.erase(it);
+            }
+            else
+            {
+                ++it;
+            }
+        }
+    }
+
+    void EndFrame()
+    {
+        for (auto b : mappedBuffers)
+        {
+            BufferProxy<rhi::HVertexBuffer>::UnmapBuffer(b->buffer);
+            usedBuffers.push_back(b);
+        }
+        mappedBuffers.clear();
+    }
+
+private:
+    Vector<BufferInfo*> mappedBuffers;
+    Vector<BufferInfo*> usedBuffers;
+    List<BufferInfo*> freeBuffers;
+};
+
 BufferAllocator<rhi::HVertexBuffer> vertexBufferAllocator;
 BufferAllocator<rhi::HIndexBuffer> indexBufferAllocator;
+InstanceBufferAllocator instanceBufferAllocator;
 
 rhi::HIndexBuffer currQuadList;
 uint32 currMaxQuadCount = 0;
@@ -229,6 +328,11 @@ AllocResultIB AllocateIndexBuffer(uint32 indexCount)
     return AllocResultIB{ result.buffer, reinterpret_cast<uint16*>(result.data), result.base, result.count };
 }
 
+AllocResultVB AllocateInstanceBuffer(uint32 instanceSize, uint32 instanceCount)
+{
+    return instanceBufferAllocator.AllocateData(instanceSize, instanceCount);
+}
+
 const uint32 VERTICES_PER_QUAD = 4;
 const uint32 INDICES_PER_QUAD = 6;
 
@@ -290,12 +394,14 @@ void BeginFrame()
 {
     vertexBufferAllocator.BeginFrame();
     indexBufferAllocator.BeginFrame();
+    instanceBufferAllocator.BeginFrame();
 }
 
 void EndFrame()
 {
     vertexBufferAllocator.EndFrame();
     indexBufferAllocator.EndFrame();
+    instanceBufferAllocator.EndFrame();
 }
 
 void Clear()
@@ -308,6 +414,7 @@ void Clear()
     }
     vertexBufferAllocator.Clear();
     indexBufferAllocator.Clear();
+    instanceBufferAllocator.Clear();
 }
 
 void SetPageSize(uint32 size)
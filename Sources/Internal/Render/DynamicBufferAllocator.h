@@ -29,6 +29,9 @@ struct AllocResultIB
 AllocResultVB AllocateVertexBuffer(uint32 vertexSize, uint32 vertexCount);
 AllocResultIB AllocateIndexBuffer(uint32 indexCount);
 
+//instance data is always placed at the beginning of its own buffer (baseVertex is zero), as base instance is not supported by every API
+AllocResultVB AllocateInstanceBuffer(uint32 instanceSize, uint32 instanceCount);
+
 //it has a bit different life cycle - it is put to eviction queue only once greater size buffer is requested (so client code should still request it every frame), still trying to share existing one
 rhi::HIndexBuffer AllocateQuadListIndexBuffer(uint32 quadCount);
 
@@ -0,0 +1,512 @@
+#include "Render/Highlevel/OcclusionRasterizer.h"
+#include "Render/3D/PolygonGroup.h"
+#include "Debug/DVAssert.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define OCCLUSION_RASTERIZER_SSE
+#include <emmintrin.h>
+#elif defined(__ARM_NEON__) || defined(__ARM_NEON)
+#define OCCLUSION_RASTERIZER_NEON
+#include <arm_neon.h>
+#endif
+
+namespace DAVA
+{
+namespace OcclusionRasterizerDetails
+{
+#if defined(OCCLUSION_RASTERIZER_SSE)
+
+using float4 = __m128;
+using mask4 = __m128;
+
+inline float4 Splat(float32 v)
+{
+    return _mm_set1_ps(v);
+}
+inline float4 SetFloat4(float32 x, float32 y, float32 z, float32 w)
+{
+    return _mm_setr_ps(x, y, z, w);
+}
+inline float4 Load(const float32* p)
+{
+    return _mm_loadu_ps(p);
+}
+inline void Store(float32* p, float4 v)
+{
+    _mm_storeu_ps(p, v);
+}
+inline float4 Add(float4 a, float4 b)
+{
+    return _mm_add_ps(a, b);
+}
+inline float4 Mul(float4 a, float4 b)
+{
+    return _mm_mul_ps(a, b);
+}
+inline mask4 CmpGe(float4 a, float4 b)
+{
+    return _mm_cmpge_ps(a, b);
+}
+inline mask4 CmpLt(float4 a, float4 b)
+{
+    return _mm_cmplt_ps(a, b);
+}
+inline mask4 CmpLe(float4 a, float4 b)
+{
+    return _mm_cmple_ps(a, b);
+}
+inline mask4 And(mask4 a, mask4 b)
+{
+    return _mm_and_ps(a, b);
+}
+inline float4 SelectFloat4(mask4 m, float4 a, float4 b)
+{
+    return _mm_or_ps(_mm_and_ps(m, a), _mm_andnot_ps(m, b));
+}
+inline uint32 MaskBits(mask4 m)
+{
+    return static_cast<uint32>(_mm_movemask_ps(m));
+}
+
+#elif defined(OCCLUSION_RASTERIZER_NEON)
+
+using float4 = float32x4_t;
+using mask4 = uint32x4_t;
+
+inline float4 Splat(float32 v)
+{
+    return vdupq_n_f32(v);
+}
+inline float4 SetFloat4(float32 x, float32 y, float32 z, float32 w)
+{
+    const float32 v[4] = { x, y, z, w };
+    return vld1q_f32(v);
+}
+inline float4 Load(const float32* p)
+{
+    return vld1q_f32(p);
+}
+inline void Store(float32* p, float4 v)
+{
+    vst1q_f32(p, v);
+}
+inline float4 Add(float4 a, float4 b)
+{
+    return vaddq_f32(a, b);
+}
+inline float4 Mul(float4 a, float4 b)
+{
+    return vmulq_f32(a, b);
+}
+inline mask4 CmpGe(float4 a, float4 b)
+{
+    return vcgeq_f32(a, b);
+}
+inline mask4 CmpLt(float4 a, float4 b)
+{
+    return vcltq_f32(a, b);
+}
+inline mask4 CmpLe(float4 a, float4 b)
+{
+    return vcleq_f32(a, b);
+}
+inline mask4 And(mask4 a, mask4 b)
+{
+    return vandq_u32(a, b);
+}
+inline float4 SelectFloat4(mask4 m, float4 a, float4 b)
+{
+    return vbslq_f32(m, a, b);
+}
+inline uint32 MaskBits(mask4 m)
+{
+    const uint32 bits[4] = { 1, 2, 4, 8 };
+    uint32x4_t v = vandq_u32(m, vld1q_u32(bits));
+    uint32x2_t sum = vadd_u32(vget_low_u32(v), vget_high_u32(v));
+    return vget_lane_u32(vpadd_u32(sum, sum), 0);
+}
+
+#else
+
+struct float4
+{
+    float32 v[4];
+};
+struct mask4
+{
+    bool m[4];
+};
+
+inline float4 Splat(float32 v)
+{
+    return float4{ { v, v, v, v } };
+}
+inline float4 SetFloat4(float32 x, float32 y, float32 z, float32 w)
+{
+    return float4{ { x, y, z, w } };
+}
+inline float4 Load(const float32* p)
+{
+    return float4{ { p[0], p[1], p[2], p[3] } };
+}
+inline void Store(float32* p, float4 v)
+{
+    p[0] = v.v[0];
+    p[1] = v.v[1];
+    p[2] = v.v[2];
+    p[3] = v.v[3];
+}
+inline float4 Add(float4 a, float4 b)
+{
+    return float4{ { a.v[0] + b.v[0], a.v[1] + b.v[1], a.v[2] + b.v[2], a.v[3] + b.v[3] } };
+}
+inline float4 Mul(float4 a, float4 b)
+{
+    return float4{ { a.v[0] * b.v[0], a.v[1] * b.v[1], a.v[2] * b.v[2], a.v[3] * b.v[3] } };
+}
+inline mask4 CmpGe(float4 a, float4 b)
+{
+    return mask4{ { a.v[0] >= b.v[0], a.v[1] >= b.v[1], a.v[2] >= b.v[2], a.v[3] >= b.v[3] } };
+}
+inline mask4 CmpLt(float4 a, float4 b)
+{
+    return mask4{ { a.v[0] < b.v[0], a.v[1] < b.v[1], a.v[2] < b.v[2], a.v[3] < b.v[3] } };
+}
+inline mask4 CmpLe(float4 a, float4 b)
+{
+    return mask4{ { a.v[0] <= b.v[0], a.v[1] <= b.v[1], a.v[2] <= b.v[2], a.v[3] <= b.v[3] } };
+}
+inline mask4 And(mask4 a, mask4 b)
+{
+    return mask4{ { a.m[0] && b.m[0], a.m[1] && b.m[1], a.m[2] && b.m[2], a.m[3] && b.m[3] } };
+}
+inline float4 SelectFloat4(mask4 m, float4 a, float4 b)
+{
+    return float4{ { m.m[0] ? a.v[0] : b.v[0], m.m[1] ? a.v[1] : b.v[1], m.m[2] ? a.v[2] : b.v[2], m.m[3] ? a.v[3] : b.v[3] } };
+}
+inline uint32 MaskBits(mask4 m)
+{
+    return (m.m[0] ? 1u : 0u) | (m.m[1] ? 2u : 0u) | (m.m[2] ? 4u : 0u) | (m.m[3] ? 8u : 0u);
+}
+
+#endif
+
+inline uint32 CountBits4(uint32 bits)
+{
+    // nibble lookup table of set bits count for values 0..15
+    return static_cast<uint32>((0x4332322132212110ull >> (bits * 4)) & 0xF);
+}
+
+struct EdgeFunction
+{
+    float32 a;
+    float32 b;
+    float32 c;
+};
+
+// Positive for points to the left of `p0` -> `p1` in screen space (y goes down)
+inline EdgeFunction MakeEdge(const Vector3& p0, const Vector3& p1)
+{
+    return EdgeFunction{ p0.y - p1.y, p1.x - p0.x, p0.x * p1.y - p0.y * p1.x };
+}
+
+inline Vector4 LerpClip(const Vector4& a, const Vector4& b, float32 t)
+{
+    return Vector4(a.x + (b.x - a.x) * t, a.y + (b.y - a.y) * t, a.z + (b.z - a.z) * t, a.w + (b.w - a.w) * t);
+}
+}
+
+OcclusionRasterizer::OcclusionRasterizer(uint32 width_, uint32 height_)
+    : width((width_ + 3) & ~3u)
+    , height(height_)
+{
+    DVASSERT(width > 0 && height > 0);
+    depthBuffer.resize(width * height, std::numeric_limits<float32>::max());
+}
+
+void OcclusionRasterizer::Begin(const Matrix4& viewProjection_, bool zeroBaseClipRange_)
+{
+    viewProjection = viewProjection_;
+    zeroBaseClipRange = zeroBaseClipRange_;
+    std::fill(depthBuffer.begin(), depthBuffer.end(), std::numeric_limits<float32>::max());
+}
+
+bool OcclusionRasterizer::CanRasterize(PolygonGroup* geometry)
+{
+    return geometry != nullptr && geometry->vertexArray != nullptr && geometry->indexArray != nullptr &&
+    geometry->indexFormat == EIF_16 && geometry->primitiveType == rhi::PRIMITIVE_TRIANGLELIST;
+}
+
+void OcclusionRasterizer::DrawOccluder(const Vector3* vertices, uint32 vertexStride, uint32 vertexCount, const uint16* indices, uint32 indexCount, const Matrix4& worldTransform, const AABBox3& localBox)
+{
+    ProcessTriangles<true>(vertices, vertexStride, vertexCount, indices, indexCount, worldTransform, localBox);
+}
+
+void OcclusionRasterizer::DrawOccluder(PolygonGroup* geometry, const Matrix4& worldTransform)
+{
+    DVASSERT(CanRasterize(geometry));
+    ProcessTriangles<true>(geometry->vertexArray, static_cast<uint32>(geometry->vertexStride), static_cast<uint32>(geometry->vertexCount),
+                           reinterpret_cast<const uint16*>(geometry->indexArray), static_cast<uint32>(geometry->indexCount),
+                           worldTransform, geometry->GetBoundingBox());
+}
+
+uint32 OcclusionRasterizer::CountVisiblePixels(const Vector3* vertices, uint32 vertexStride, uint32 vertexCount, const uint16* indices, uint32 indexCount, const Matrix4& worldTransform, const AABBox3& localBox)
+{
+    return ProcessTriangles<false>(vertices, vertexStride, vertexCount, indices, indexCount, worldTransform, localBox);
+}
+
+uint32 OcclusionRasterizer::CountVisiblePixels(PolygonGroup* geometry, const Matrix4& worldTransform)
+{
+    DVASSERT(CanRasterize(geometry));
+    return ProcessTriangles<false>(geometry->vertexArray, static_cast<uint32>(geometry->vertexStride), static_cast<uint32>(geometry->vertexCount),
+                                   reinterpret_cast<const uint16*>(geometry->indexArray), static_cast<uint32>(geometry->indexCount),
+                                   worldTransform, geometry->GetBoundingBox());
+}
+
+float32 OcclusionRasterizer::GetNearDistance(const Vector4& clipPosition) const
+{
+    return zeroBaseClipRange ? clipPosition.z : clipPosition.z + clipPosition.w;
+}
+
+template <bool WRITE_DEPTH>
+uint32 OcclusionRasterizer::ProcessTriangles(const Vector3* vertices, uint32 vertexStride, uint32 vertexCount, const uint16* indices, uint32 indexCount, const Matrix4& worldTransform, const AABBox3& localBox)
+{
+    using namespace OcclusionRasterizerDetails;
+
+    AABBox3 worldBox;
+    localBox.GetTransformedBox(worldTransform, worldBox);
+
+    ScreenRect rect;
+    float32 minDepth = 0.0f;
+    if (!ProjectBox(worldBox, rect, minDepth))
+        return 0;
+
+    if (!WRITE_DEPTH && !IsBoxVisible(worldBox))
+        return 0;
+
+    const Matrix4 worldViewProjection = worldTransform * viewProjection;
+    clipVertices.resize(vertexCount);
+    const uint8* vertexData = reinterpret_cast<const uint8*>(vertices);
+    for (uint32 i = 0; i < vertexCount; ++i)
+    {
+        const Vector3& position = *reinterpret_cast<const Vector3*>(vertexData + i * vertexStride);
+        clipVertices[i] = Vector4(position, 1.0f) * worldViewProjection;
+    }
+
+    uint32 visiblePixels = 0;
+    for (uint32 i = 0; i + 2 < indexCount; i += 3)
+    {
+        DVASSERT(indices[i] < vertexCount && indices[i + 1] < vertexCount && indices[i + 2] < vertexCount);
+        const Vector4* triangle[3] = { &clipVertices[indices[i]], &clipVertices[indices[i + 1]], &clipVertices[indices[i + 2]] };
+
+        // trivial reject by side planes
+        if ((triangle[0]->x > triangle[0]->w && triangle[1]->x > triangle[1]->w && triangle[2]->x > triangle[2]->w) ||
+            (triangle[0]->x < -triangle[0]->w && triangle[1]->x < -triangle[1]->w && triangle[2]->x < -triangle[2]->w) ||
+            (triangle[0]->y > triangle[0]->w && triangle[1]->y > triangle[1]->w && triangle[2]->y > triangle[2]->w) ||
+            (triangle[0]->y < -triangle[0]->w && triangle[1]->y < -triangle[1]->w && triangle[2]->y < -triangle[2]->w))
+        {
+            continue;
+        }
+
+        float32 distance[3];
+        uint32 insideCount = 0;
+        for (uint32 k = 0; k < 3; ++k)
+        {
+            distance[k] = GetNearDistance(*triangle[k]);
+            insideCount += (distance[k] >= 0.0f) ? 1 : 0;
+        }
+
+        if (insideCount == 3)
+        {
+            visiblePixels += RasterizeTriangle<WRITE_DEPTH>(*triangle[0], *triangle[1], *triangle[2]);
+        }
+        else if (insideCount > 0)
+        {
+            // Sutherland-Hodgman against near plane, triangle becomes triangle or quad
+            Vector4 polygon[4];
+            uint32 polygonSize = 0;
+            for (uint32 k = 0; k < 3; ++k)
+            {
+                uint32 next = (k + 1) % 3;
+                if (distance[k] >= 0.0f)
+                    polygon[polygonSize++] = *triangle[k];
+                if ((distance[k] >= 0.0f) != (distance[next] >= 0.0f))
+                    polygon[polygonSize++] = LerpClip(*triangle[k], *triangle[next], distance[k] / (distance[k] - distance[next]));
+            }
+
+            for (uint32 k = 2; k < polygonSize; ++k)
+            {
+                visiblePixels += RasterizeTriangle<WRITE_DEPTH>(polygon[0], polygon[k - 1], polygon[k]);
+            }
+        }
+    }
+
+    return visiblePixels;
+}
+
+template <bool WRITE_DEPTH>
+uint32 OcclusionRasterizer::RasterizeTriangle(const Vector4& v0, const Vector4& v1, const Vector4& v2)
+{
+    using namespace OcclusionRasterizerDetails;
+
+    const float32 fw = static_cast<float32>(width);
+    const float32 fh = static_cast<float32>(height);
+
+    Vector3 p[3];
+    const Vector4* clip[3] = { &v0, &v1, &v2 };
+    for (uint32 k = 0; k < 3; ++k)
+    {
+        float32 invW = 1.0f / clip[k]->w;
+        p[k].x = (clip[k]->x * invW * 0.5f + 0.5f) * fw;
+        p[k].y = (0.5f - clip[k]->y * invW * 0.5f) * fh;
+        p[k].z = clip[k]->z * invW;
+    }
+
+    float32 area = (p[1].x - p[0].x) * (p[2].y - p[0].y) - (p[1].y - p[0].y) * (p[2].x - p[0].x);
+    if (area == 0.0f)
+        return 0;
+
+    // occluders are double-sided, just fix winding
+    if (area < 0.0f)
+    {
+        std::swap(p[1], p[2]);
+        area = -area;
+    }
+
+    float32 minX = std::min(p[0].x, std::min(p[1].x, p[2].x));
+    float32 maxX = std::max(p[0].x, std::max(p[1].x, p[2].x));
+    float32 minY = std::min(p[0].y, std::min(p[1].y, p[2].y));
+    float32 maxY = std::max(p[0].y, std::max(p[1].y, p[2].y));
+    if (maxX < 0.0f || maxY < 0.0f || minX >= fw || minY >= fh)
+        return 0;
+
+    const int32 x0 = static_cast<int32>(std::max(minX, 0.0f)) & ~3;
+    const int32 x1 = static_cast<int32>(std::min(maxX, fw - 1.0f));
+    const int32 y0 = static_cast<int32>(std::max(minY, 0.0f));
+    const int32 y1 = static_cast<int32>(std::min(maxY, fh - 1.0f));
+
+    const EdgeFunction e0 = MakeEdge(p[1], p[2]);
+    const EdgeFunction e1 = MakeEdge(p[2], p[0]);
+    const EdgeFunction e2 = MakeEdge(p[0], p[1]);
+
+    // depth is linear in screen space after perspective division
+    const float32 invArea = 1.0f / area;
+    const float32 za = (e0.a * p[0].z + e1.a * p[1].z + e2.a * p[2].z) * invArea;
+    const float32 zb = (e0.b * p[0].z + e1.b * p[1].z + e2.b * p[2].z) * invArea;
+    const float32 zc = (e0.c * p[0].z + e1.c * p[1].z + e2.c * p[2].z) * invArea;
+
+    const float4 zero = Splat(0.0f);
+    const float4 offsets = SetFloat4(0.5f, 1.5f, 2.5f, 3.5f);
+    const float4 e0Step = Splat(e0.a * 4.0f);
+    const float4 e1Step = Splat(e1.a * 4.0f);
+    const float4 e2Step = Splat(e2.a * 4.0f);
+    const float4 zStep = Splat(za * 4.0f);
+    const float4 px = Add(Splat(static_cast<float32>(x0)), offsets);
+
+    uint32 visiblePixels = 0;
+    for (int32 y = y0; y <= y1; ++y)
+    {
+        const float32 py = static_cast<float32>(y) + 0.5f;
+        float4 w0 = Add(Mul(Splat(e0.a), px), Splat(e0.b * py + e0.c));
+        float4 w1 = Add(Mul(Splat(e1.a), px), Splat(e1.b * py + e1.c));
+        float4 w2 = Add(Mul(Splat(e2.a), px), Splat(e2.b * py + e2.c));
+        float4 z = Add(Mul(Splat(za), px), Splat(zb * py + zc));
+
+        float32* row = depthBuffer.data() + y * width;
+        for (int32 x = x0; x <= x1; x += 4)
+        {
+            mask4 inside = And(And(CmpGe(w0, zero), CmpGe(w1, zero)), CmpGe(w2, zero));
+            if (MaskBits(inside) != 0)
+            {
+                float4 depth = Load(row + x);
+                if (WRITE_DEPTH)
+                {
+                    Store(row + x, SelectFloat4(And(inside, CmpLt(z, depth)), z, depth));
+                }
+                else
+                {
+                    visiblePixels += CountBits4(MaskBits(And(inside, CmpLe(z, depth))));
+                }
+            }
+
+            w0 = Add(w0, e0Step);
+            w1 = Add(w1, e1Step);
+            w2 = Add(w2, e2Step);
+            z = Add(z, zStep);
+        }
+    }
+
+    return visiblePixels;
+}
+
+bool OcclusionRasterizer::ProjectBox(const AABBox3& worldBox, ScreenRect& rect, float32& minDepth) const
+{
+    Vector3 corners[8];
+    worldBox.GetCorners(corners);
+
+    float32 minX = std::numeric_limits<float32>::max();
+    float32 minY = std::numeric_limits<float32>::max();
+    float32 maxX = -std::numeric_limits<float32>::max();
+    float32 maxY = -std::numeric_limits<float32>::max();
+    minDepth = std::numeric_limits<float32>::max();
+
+    for (const Vector3& corner : corners)
+    {
+        Vector4 clipPosition = Vector4(corner, 1.0f) * viewProjection;
+        if (GetNearDistance(clipPosition) < 0.0f || clipPosition.w <= 0.0f)
+        {
+            rect = ScreenRect{ 0, 0, static_cast<int32>(width) - 1, static_cast<int32>(height) - 1 };
+            minDepth = -std::numeric_limits<float32>::max();
+            return true;
+        }
+
+        float32 invW = 1.0f / clipPosition.w;
+        float32 sx = (clipPosition.x * invW * 0.5f + 0.5f) * static_cast<float32>(width);
+        float32 sy = (0.5f - clipPosition.y * invW * 0.5f) * static_cast<float32>(height);
+        minX = std::min(minX, sx);
+        maxX = std::max(maxX, sx);
+        minY = std::min(minY, sy);
+        maxY = std::max(maxY, sy);
+        minDepth = std::min(minDepth, clipPosition.z * invW);
+    }
+
+    const float32 fw = static_cast<float32>(width);
+    const float32 fh = static_cast<float32>(height);
+    if (maxX < 0.0f || maxY < 0.0f || minX >= fw || minY >= fh)
+        return false;
+
+    rect.minX = static_cast<int32>(std::max(minX, 0.0f));
+    rect.minY = static_cast<int32>(std::max(minY, 0.0f));
+    rect.maxX = static_cast<int32>(std::min(maxX, fw - 1.0f));
+    rect.maxY = static_cast<int32>(std::min(maxY, fh - 1.0f));
+    return true;
+}
+
+bool OcclusionRasterizer::IsBoxVisible(const AABBox3& worldBox) const
+{
+    using namespace OcclusionRasterizerDetails;
+
+    ScreenRect rect;
+    float32 minDepth = 0.0f;
+    if (!ProjectBox(worldBox, rect, minDepth))
+        return true; // frustum culling is not our business
+
+    if (minDepth == -std::numeric_limits<float32>::max())
+        return true;
+
+    // pixels to the left of rect are tested too, it is still conservative
+    const float4 boxDepth = Splat(minDepth);
+    const int32 x0 = rect.minX & ~3;
+    for (int32 y = rect.minY; y <= rect.maxY; ++y)
+    {
+        const float32* row = depthBuffer.data() + y * width;
+        for (int32 x = x0; x <= rect.maxX; x += 4)
+        {
+            if (MaskBits(CmpLe(boxDepth, Load(row + x))) != 0)
+                return true;
+        }
+    }
+
+    return false;
+}
+}
@@ -0,0 +1,86 @@
+#pragma once
+
+#include "Base/BaseTypes.h"
+#include "Base/BaseMath.h"
+
+namespace DAVA
+{
+class PolygonGroup;
+
+/**
+    Software depth rasterizer for low-poly occluders.
+    Triangles are clipped by near plane and rasterized into float depth buffer four pixels at once (SSE2 or NEON
+    when available). Depth buffer is used to test bounding boxes at runtime or to count visible pixels of geometry
+    while baking static occlusion without GPU queries.
+    Instance is not thread-safe, but different instances can be used from different threads.
+*/
+class OcclusionRasterizer
+{
+public:
+    /** `width` is rounded up to multiple of 4 */
+    OcclusionRasterizer(uint32 width, uint32 height);
+
+    uint32 GetWidth() const;
+    uint32 GetHeight() const;
+
+    /** Clear depth buffer and set camera for following calls, `zeroBaseClipRange` should match projection matrix */
+    void Begin(const Matrix4& viewProjection, bool zeroBaseClipRange);
+
+    /** Write depth of triangles list, `vertexStride` is in bytes, `localBox` is used to skip off-screen geometry */
+    void DrawOccluder(const Vector3* vertices, uint32 vertexStride, uint32 vertexCount, const uint16* indices, uint32 indexCount, const Matrix4& worldTransform, const AABBox3& localBox);
+    void DrawOccluder(PolygonGroup* geometry, const Matrix4& worldTransform);
+
+    /** Count pixels of triangles list which pass depth test against occluders, depth buffer is not modified */
+    uint32 CountVisiblePixels(const Vector3* vertices, uint32 vertexStride, uint32 vertexCount, const uint16* indices, uint32 indexCount, const Matrix4& worldTransform, const AABBox3& localBox);
+    uint32 CountVisiblePixels(PolygonGroup* geometry, const Matrix4& worldTransform);
+
+    /** Returns true if `geometry` keeps indexed triangle list in memory, only such geometry can be passed to rasterizer */
+    static bool CanRasterize(PolygonGroup* geometry);
+
+    /** Conservative test: returns false only if whole box is behind occluders */
+    bool IsBoxVisible(const AABBox3& worldBox) const;
+
+    const Vector<float32>& GetDepthBuffer() const;
+
+private:
+    struct ScreenRect
+    {
+        int32 minX;
+        int32 minY;
+        int32 maxX;
+        int32 maxY;
+    };
+
+    template <bool WRITE_DEPTH>
+    uint32 ProcessTriangles(const Vector3* vertices, uint32 vertexStride, uint32 vertexCount, const uint16* indices, uint32 indexCount, const Matrix4& worldTransform, const AABBox3& localBox);
+
+    template <bool WRITE_DEPTH>
+    uint32 RasterizeTriangle(const Vector4& v0, const Vector4& v1, const Vector4& v2);
+
+    // Returns false if box is out of screen, box crossing near plane covers whole screen with infinitely close depth
+    bool ProjectBox(const AABBox3& worldBox, ScreenRect& rect, float32& minDepth) const;
+    float32 GetNearDistance(const Vector4& clipPosition) const;
+
+    uint32 width = 0;
+    uint32 height = 0;
+    Matrix4 viewProjection;
+    bool zeroBaseClipRange = false;
+    Vector<float32> depthBuffer;
+    Vector<Vector4> clipVertices;
+};
+
+inline uint32 OcclusionRasterizer::GetWidth() const
+{
+    return width;
+}
+
+inline uint32 OcclusionRasterizer::GetHeight() const
+{
+    return height;
+}
+
+inline const Vector<float32>& OcclusionRasterizer::GetDepthBuffer() const
+{
+    return depthBuffer;
+}
+}
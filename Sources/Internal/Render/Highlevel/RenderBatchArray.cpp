@@ -1,6 +1,7 @@
 #include "Render/Highlevel/RenderBatchArray.h"
 #include "Render/Highlevel/RenderSystem.h"
 #include "Render/Highlevel/RenderPass.h"
+#include "Base/Radix/Radix.h"
 
 namespace DAVA
 {
@@ -11,9 +12,35 @@ RenderBatchArray::RenderBatchArray()
     //renderBatchArray.reserve(4096);
 }
 
-bool RenderBatchArray::MaterialCompareFunction(const RenderBatch* a, const RenderBatch* b)
+void RenderBatchArray::SortBySortingKey()
 {
-    return a->layerSortingKey > b->layerSortingKey;
+    uint32 count = static_cast<uint32>(renderBatchArray.size());
+    if (count < 2)
+        return;
+
+    // value layout: (inverted key:32)(index:32), so ascending order of values gives descending order of keys
+    sortValues.resize(count);
+    for (uint32 i = 0; i < count; ++i)
+    {
+        uint32 key = static_cast<uint32>(renderBatchArray[i]->layerSortingKey);
+        sortValues[i] = (static_cast<uint64>(~key) << 32) | i;
+    }
+
+    if (sizeof(intptr_t) == sizeof(uint64))
+    {
+        RadixSort(sortValues.data(), 0, static_cast<int>(count), 56);
+    }
+    else
+    {
+        std::sort(sortValues.begin(), sortValues.end());
+    }
+
+    sortedBatches.resize(count);
+    for (uint32 i = 0; i < count; ++i)
+    {
+        sortedBatches[i] = renderBatchArray[static_cast<uint32>(sortValues[i])];
+    }
+    renderBatchArray.swap(sortedBatches);
 }
 
 void RenderBatchArray::Sort(Camera* camera)
@@ -41,7 +68,7 @@ void RenderBatchArray::Sort(Camera* camera)
                 //batch->layerSortingKey = (pointer_size)((batch->GetMaterial()->GetSortingKey() << 20) | (batch->GetSortingKey() << 28) | (renderObjectId & 0x000FFFFF));
             }
 
-            std::sort(renderBatchArray.begin(), renderBatchArray.end(), MaterialCompareFunction);
+            SortBySortingKey();
 
             sortFlags &= ~SORT_REQUIRED;
         }
@@ -58,7 +85,7 @@ void RenderBatchArray::Sort(Camera* camera)
                 batch->layerSortingKey = (distance & 0x0fffffff) | (batch->GetSortingKey() << 28);
             }
 
-            std::stable_sort(renderBatchArray.begin(), renderBatchArray.end(), MaterialCompareFunction);
+            SortBySortingKey();
 
             sortFlags |= SORT_REQUIRED;
         }
@@ -76,7 +103,7 @@ void RenderBatchArray::Sort(Camera* camera)
                 batch->layerSortingKey = distanceBits | (batch->GetSortingKey() << 28);
             }
 
-            std::sort(renderBatchArray.begin(), renderBatchArray.end(), MaterialCompareFunction);
+            SortBySortingKey();
 
             sortFlags |= SORT_REQUIRED;
         }
@@ -26,6 +26,7 @@ public:
 
     inline void Clear();
     inline void AddRenderBatch(RenderBatch* batch);
+    inline void AddRenderBatches(const Vector<RenderBatch*>& batches);
     inline uint32 GetRenderBatchCount() const;
     inline RenderBatch* Get(uint32 index) const;
 
@@ -33,9 +34,16 @@ public:
     inline void SetSortingFlags(uint32 flags);
 
 private:
+    /**
+        Sort batches by `layerSortingKey` in descending order, batches with equal keys keep their relative order.
+        Keys are packed together with batch indices into 64-bit values and sorted with radix sort.
+    */
+    void SortBySortingKey();
+
     Vector<RenderBatch*> renderBatchArray;
+    Vector<RenderBatch*> sortedBatches;
+    Vector<uint64> sortValues;
     uint32 sortFlags;
-    static bool MaterialCompareFunction(const RenderBatch* a, const RenderBatch* b);
 };
 
 inline void RenderBatchArray::Clear()
@@ -48,6 +56,11 @@ inline void RenderBatchArray::AddRenderBatch(RenderBatch* batch)
     renderBatchArray.push_back(batch);
 }
 
+inline void RenderBatchArray::AddRenderBatches(const Vector<RenderBatch*>& batches)
+{
+    renderBatchArray.insert(renderBatchArray.end(), batches.begin(), batches.end());
+}
+
 inline void RenderBatchArray::SetSortingFlags(uint32 _flags)
 {
     sortFlags = _flags;
@@ -3,12 +3,82 @@
 #include "Render/Highlevel/RenderBatchArray.h"
 #include "Render/Highlevel/Camera.h"
 #include "Render/VisibilityQueryResults.h"
+#include "Render/DynamicBufferAllocator.h"
+#include "Render/Renderer.h"
+#include "Render/Shader.h"
+#include "Render/3D/PolygonGroup.h"
+#include "Render/Material/NMaterial.h"
 #include "Base/Radix/Radix.h"
 #include "Debug/ProfilerGPU.h"
 #include "Debug/ProfilerMarkerNames.h"
 
 namespace DAVA
 {
+namespace RenderLayerDetails
+{
+const uint32 MIN_INSTANCED_BATCH_COUNT = 4;
+const uint32 INSTANCE_DATA_SIZE = 3 * sizeof(Vector4); // three columns of affine world matrix
+const uint32 MAX_VERTEX_ELEMENT_COUNT = 8; // matches rhi::VertexLayout::MaxElemCount
+
+bool IsInstancingCandidate(RenderBatch* batch)
+{
+    return (batch->GetMaterial() != nullptr) && (batch->GetPolygonGroup() != nullptr) &&
+    (batch->GetRenderObject()->GetType() == RenderObject::TYPE_MESH) &&
+    !batch->perfQueryStart.IsValid() && !batch->perfQueryEnd.IsValid();
+}
+
+bool IsSameInstance(RenderBatch* batch1, RenderBatch* batch2)
+{
+    return (batch1->GetPolygonGroup() == batch2->GetPolygonGroup()) &&
+    (batch1->startIndex == batch2->startIndex) && (batch1->indexCount == batch2->indexCount) &&
+    (batch1->GetRenderObject()->GetLight(0) == batch2->GetRenderObject()->GetLight(0));
+}
+
+bool InstanceOrder(RenderBatch* batch1, RenderBatch* batch2)
+{
+    if (batch1->GetPolygonGroup() != batch2->GetPolygonGroup())
+        return batch1->GetPolygonGroup() < batch2->GetPolygonGroup();
+    if (batch1->startIndex != batch2->startIndex)
+        return batch1->startIndex < batch2->startIndex;
+    if (batch1->indexCount != batch2->indexCount)
+        return batch1->indexCount < batch2->indexCount;
+    return batch1->GetRenderObject()->GetLight(0) < batch2->GetRenderObject()->GetLight(0);
+}
+
+/** Return layout of mesh vertex stream followed by per-instance stream of shader, or InvalidUID if they can't be combined. */
+uint32 GetInstancedLayoutUID(uint32 meshLayoutUID, const rhi::VertexLayout& shaderLayout)
+{
+    const rhi::VertexLayout* meshLayout = rhi::VertexLayout::Get(meshLayoutUID);
+    if (meshLayout == nullptr || meshLayout->StreamCount() != 1)
+        return rhi::VertexLayout::InvalidUID;
+
+    uint32 instanceStream = shaderLayout.StreamCount() - 1;
+    if (shaderLayout.Stride(instanceStream) != INSTANCE_DATA_SIZE)
+        return rhi::VertexLayout::InvalidUID;
+
+    rhi::VertexLayout layout = *meshLayout;
+    layout.AddStream(rhi::VDF_PER_INSTANCE);
+    for (uint32 i = 0; i < shaderLayout.ElementCount(); ++i)
+    {
+        if (shaderLayout.ElementStreamIndex(i) != instanceStream)
+            continue;
+
+        for (uint32 m = 0; m < meshLayout->ElementCount(); ++m)
+        {
+            if (meshLayout->ElementSemantics(m) == shaderLayout.ElementSemantics(i) && meshLayout->ElementSemanticsIndex(m) == shaderLayout.ElementSemanticsIndex(i))
+                return rhi::VertexLayout::InvalidUID;
+        }
+
+        if (layout.ElementCount() == MAX_VERTEX_ELEMENT_COUNT)
+            return rhi::VertexLayout::InvalidUID;
+
+        layout.AddElement(shaderLayout.ElementSemantics(i), shaderLayout.ElementSemanticsIndex(i), shaderLayout.ElementDataType(i), shaderLayout.ElementDataCount(i));
+    }
+
+    return rhi::VertexLayout::UniqueId(layout);
+}
+}
+
 const FastName LAYER_NAME_OPAQUE("OpaqueRenderLayer");
 const FastName LAYER_NAME_AFTER_OPAQUE("AfterOpaqueRenderLayer");
 const FastName LAYER_NAME_ALPHA_TEST_LAYER("AlphaTestLayer");
@@ -70,40 +140,187 @@ RenderLayer::eRenderLayerID RenderLayer::GetLayerIDByName(const FastName& name)
     return RENDER_LAYER_INVALID_ID;
 }
 
+bool RenderLayer::IsInstancingEnabled() const
+{
+    return ((sortFlags & RenderBatchArray::SORT_BY_MATERIAL) != 0) &&
+    rhi::DeviceCaps().isInstancingSupported &&
+    Renderer::GetOptions()->IsOptionEnabled(RenderOptions::DYNAMIC_INSTANCING);
+}
+
 void RenderLayer::Draw(Camera* camera, const RenderBatchArray& batchArray, rhi::HPacketList packetList)
 {
     uint32 size = static_cast<uint32>(batchArray.GetRenderBatchCount());
 
+    if (!IsInstancingEnabled())
+    {
+        rhi::Packet packet;
+        for (uint32 k = 0; k < size; ++k)
+        {
+            if (PreparePacket(camera, batchArray.Get(k), packet))
+            {
+                rhi::AddPacket(packetList, packet);
+            }
+        }
+        return;
+    }
+
+    // batches are sorted by material, so batches with the same material form contiguous blocks
+    uint32 blockBegin = 0;
+    while (blockBegin < size)
+    {
+        NMaterial* material = batchArray.Get(blockBegin)->GetMaterial();
+        uint32 blockEnd = blockBegin + 1;
+        while (blockEnd < size && batchArray.Get(blockEnd)->GetMaterial() == material)
+            ++blockEnd;
+
+        DrawMaterialBatches(camera, batchArray, blockBegin, blockEnd, packetList);
+        blockBegin = blockEnd;
+    }
+}
+
+void RenderLayer::DrawMaterialBatches(Camera* camera, const RenderBatchArray& batchArray, uint32 begin, uint32 end, rhi::HPacketList packetList)
+{
+    using namespace RenderLayerDetails;
+
     rhi::Packet packet;
-    for (uint32 k = 0; k < size; ++k)
+    instancingCandidates.clear();
+    if (end - begin >= MIN_INSTANCED_BATCH_COUNT)
     {
-        RenderBatch* batch = batchArray.Get(k);
-        RenderObject* renderObject = batch->GetRenderObject();
-        renderObject->BindDynamicParameters(camera, batch);
-        NMaterial* mat = batch->GetMaterial();
-        if (mat)
+        for (uint32 k = begin; k < end; ++k)
         {
-            batch->BindGeometryData(packet);
-            DVASSERT(packet.primitiveCount);
-            mat->BindParams(packet);
-            packet.debugMarker = mat->GetEffectiveFXName().c_str();
-            packet.perfQueryStart = batch->perfQueryStart;
-            packet.perfQueryEnd = batch->perfQueryEnd;
+            RenderBatch* batch = batchArray.Get(k);
+            if (IsInstancingCandidate(batch))
+                instancingCandidates.push_back(batch);
+            else if (PreparePacket(camera, batch, packet))
+                rhi::AddPacket(packetList, packet);
+        }
+    }
+    else
+    {
+        for (uint32 k = begin; k < end; ++k)
+        {
+            if (PreparePacket(camera, batchArray.Get(k), packet))
+                rhi::AddPacket(packetList, packet);
+        }
+    }
+
+    if (instancingCandidates.empty())
+        return;
+
+    // order of batches with the same material doesn't matter, so gather batches with the same geometry together
+    std::stable_sort(instancingCandidates.begin(), instancingCandidates.end(), &InstanceOrder);
+
+    uint32 candidatesCount = static_cast<uint32>(instancingCandidates.size());
+    uint32 groupBegin = 0;
+    while (groupBegin < candidatesCount)
+    {
+        uint32 groupEnd = groupBegin + 1;
+        while (groupEnd < candidatesCount && IsSameInstance(instancingCandidates[groupBegin], instancingCandidates[groupEnd]))
+            ++groupEnd;
+
+        uint32 groupSize = groupEnd - groupBegin;
+        if (groupSize >= MIN_INSTANCED_BATCH_COUNT && PrepareInstancedPacket(camera, instancingCandidates.data() + groupBegin, groupSize, packet))
+        {
+            rhi::AddPacket(packetList, packet);
+        }
+        else
+        {
+            for (uint32 k = groupBegin; k < groupEnd; ++k)
+            {
+                if (PreparePacket(camera, instancingCandidates[k], packet))
+                    rhi::AddPacket(packetList, packet);
+            }
+        }
+
+        groupBegin = groupEnd;
+    }
+}
+
+bool RenderLayer::PreparePacket(Camera* camera, RenderBatch* batch, rhi::Packet& packet)
+{
+    RenderObject* renderObject = batch->GetRenderObject();
+    renderObject->BindDynamicParameters(camera, batch);
+    NMaterial* mat = batch->GetMaterial();
+    if (mat)
+    {
+        batch->BindGeometryData(packet);
+        DVASSERT(packet.primitiveCount);
+        mat->BindParams(packet);
+        packet.debugMarker = mat->GetEffectiveFXName().c_str();
+        packet.perfQueryStart = batch->perfQueryStart;
+        packet.perfQueryEnd = batch->perfQueryEnd;
 
 #ifdef __DAVAENGINE_RENDERSTATS__
 #ifdef __DAVAENGINE_RENDERSTATS_ALPHABLEND__
-            if (packet.userFlags & NMaterial::USER_FLAG_ALPHABLEND)
-                packet.queryIndex = VisibilityQueryResults::QUERY_INDEX_ALPHABLEND;
-            else if (layerID == RENDER_LAYER_SHADOW_VOLUME_ID)
-                packet.queryIndex = VisibilityQueryResults::QUERY_INDEX_LAYER_SHADOW_VOLUME;
-            else
-                packet.queryIndex = DAVA::InvalidIndex;
+        if (packet.userFlags & NMaterial::USER_FLAG_ALPHABLEND)
+            packet.queryIndex = VisibilityQueryResults::QUERY_INDEX_ALPHABLEND;
+        else if (layerID == RENDER_LAYER_SHADOW_VOLUME_ID)
+            packet.queryIndex = VisibilityQueryResults::QUERY_INDEX_LAYER_SHADOW_VOLUME;
+        else
+            packet.queryIndex = DAVA::InvalidIndex;
 #else
-            packet.queryIndex = layerID;
+        packet.queryIndex = layerID;
 #endif
 #endif
-            rhi::AddPacket(packetList, packet);
+        return true;
+    }
+
+    return false;
+}
+
+bool RenderLayer::PrepareInstancedPacket(Camera* camera, RenderBatch* const* batches, uint32 batchCount, rhi::Packet& packet)
+{
+    using namespace RenderLayerDetails;
+
+    RenderBatch* batch = batches[0];
+    NMaterial* mat = batch->GetMaterial();
+    ShaderDescriptor* shader = mat->PreBuildInstancedVariant();
+    if (shader == nullptr)
+        return false;
+
+    uint32 layoutUID = GetInstancedLayoutUID(batch->GetPolygonGroup()->vertexLayoutId, shader->GetVertexLayout());
+    if (layoutUID == rhi::VertexLayout::InvalidUID)
+        return false;
+
+    DynamicBufferAllocator::AllocResultVB instanceData = DynamicBufferAllocator::AllocateInstanceBuffer(INSTANCE_DATA_SIZE, batchCount);
+    float32* instance = reinterpret_cast<float32*>(instanceData.data);
+    for (uint32 i = 0; i < batchCount; ++i)
+    {
+        const Matrix4& worldMatrix = *batches[i]->GetRenderObject()->GetWorldMatrixPtr();
+        for (uint32 column = 0; column < 3; ++column)
+        {
+            for (uint32 row = 0; row < 4; ++row)
+                *instance++ = worldMatrix._data[row][column];
         }
     }
+
+    // lights and camera are the same for every batch of group, world matrix comes from instance stream
+    batch->GetRenderObject()->BindDynamicParameters(camera, batch);
+    batch->BindGeometryData(packet);
+    DVASSERT(packet.primitiveCount);
+    packet.vertexStreamCount = 2;
+    packet.vertexStream[1] = instanceData.buffer;
+    packet.instanceCount = batchCount;
+    packet.baseInstance = 0;
+    packet.vertexLayoutUID = layoutUID;
+    mat->BindInstancedParams(packet);
+    packet.debugMarker = mat->GetEffectiveFXName().c_str();
+    packet.perfQueryStart = rhi::HPerfQuery();
+    packet.perfQueryEnd = rhi::HPerfQuery();
+
+#ifdef __DAVAENGINE_RENDERSTATS__
+#ifdef __DAVAENGINE_RENDERSTATS_ALPHABLEND__
+    if (packet.userFlags & NMaterial::USER_FLAG_ALPHABLEND)
+        packet.queryIndex = VisibilityQueryResults::QUERY_INDEX_ALPHABLEND;
+    else if (layerID == RENDER_LAYER_SHADOW_VOLUME_ID)
+        packet.queryIndex = VisibilityQueryResults::QUERY_INDEX_LAYER_SHADOW_VOLUME;
+    else
+        packet.queryIndex = DAVA::InvalidIndex;
+#else
+    packet.queryIndex = layerID;
+#endif
+#endif
+
+    return true;
 }
 };
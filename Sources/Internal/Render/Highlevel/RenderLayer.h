@@ -49,8 +49,22 @@ public:
     virtual void Draw(Camera* camera, const RenderBatchArray& batchArray, rhi::HPacketList packetList);
 
 protected:
+    bool PreparePacket(Camera* camera, RenderBatch* batch, rhi::Packet& packet);
+
+    /**
+        Bind several batches sharing material and geometry into single instanced packet,
+        world matrices are passed in per-instance vertex stream. Returns false if material or geometry doesn't support instancing.
+    */
+    bool PrepareInstancedPacket(Camera* camera, RenderBatch* const* batches, uint32 batchCount, rhi::Packet& packet);
+
     eRenderLayerID layerID;
     uint32 sortFlags;
+
+private:
+    void DrawMaterialBatches(Camera* camera, const RenderBatchArray& batchArray, uint32 begin, uint32 end, rhi::HPacketList packetList);
+    bool IsInstancingEnabled() const;
+
+    Vector<RenderBatch*> instancingCandidates;
 };
 
 inline RenderLayer::eRenderLayerID RenderLayer::GetRenderLayerID() const
@@ -4,11 +4,16 @@
 #include "Render/Highlevel/Camera.h"
 #include "Render/Highlevel/RenderPassNames.h"
 #include "Render/Highlevel/ShadowVolumeRenderLayer.h"
+#include "Render/Highlevel/OcclusionRasterizer.h"
+#include "Render/3D/PolygonGroup.h"
 #include "Render/ShaderCache.h"
 
 #include "Debug/ProfilerCPU.h"
 #include "Debug/ProfilerMarkerNames.h"
 #include "Concurrency/Thread.h"
+#include "Engine/Engine.h"
+#include "Engine/EngineContext.h"
+#include "Job/JobManager.h"
 
 #include "Render/Renderer.h"
 #include "Render/Texture.h"
@@ -22,6 +27,21 @@
 
 namespace DAVA
 {
+namespace RenderPassDetails
+{
+// Visibility arrays smaller than this are processed on the calling thread
+const uint32 PARALLEL_PREPARE_MIN_OBJECTS = 1024;
+const uint32 PARALLEL_PREPARE_CHUNK_SIZE = 256;
+const uint32 PARALLEL_SORT_MIN_BATCHES = 1024;
+
+// Software occlusion culling: coarse depth buffer filled by a few big low-poly meshes
+const uint32 OCCLUSION_BUFFER_WIDTH = 256;
+const uint32 OCCLUSION_BUFFER_HEIGHT = 128;
+const float32 OCCLUDER_MIN_SCREEN_SIZE = 0.1f; // bounding sphere radius divided by distance to camera
+const uint32 OCCLUDER_MAX_TRIANGLES = 2048;
+const uint32 OCCLUDERS_TRIANGLES_BUDGET = 16384;
+}
+
 RenderPass::RenderPass(const FastName& _name)
     : passName(_name)
 {
@@ -50,6 +70,7 @@ RenderPass::~RenderPass()
         SafeDelete(layer);
     }
     SafeRelease(multisampledTexture);
+    SafeDelete(occlusionRasterizer);
 }
 
 void RenderPass::AddRenderLayer(RenderLayer* layer, RenderLayer::eRenderLayerID afterLayer)
@@ -123,12 +144,92 @@ void RenderPass::PrepareVisibilityArrays(Camera* camera, RenderSystem* renderSys
     visibilityArray.clear();
     renderSystem->GetRenderHierarchy()->Clip(camera, visibilityArray, currVisibilityCriteria);
 
+    if (occlusionRasterizer != nullptr && Renderer::GetOptions()->IsOptionEnabled(RenderOptions::SOFTWARE_OCCLUSION_CULLING))
+    {
+        CullOccludedObjects(camera);
+    }
+
     ClearLayersArrays();
     PrepareLayersArrays(visibilityArray, camera);
 }
 
+void RenderPass::CullOccludedObjects(Camera* camera)
+{
+    using namespace RenderPassDetails;
+
+    const Vector3 cameraPosition = camera->GetPosition();
+    occluderCandidates.clear();
+    for (RenderObject* renderObject : visibilityArray)
+    {
+        if (renderObject->GetType() != RenderObject::TYPE_MESH)
+            continue;
+
+        const AABBox3& box = renderObject->GetWorldBoundingBox();
+        float32 distance = std::max((box.GetCenter() - cameraPosition).Length(), 1.0f);
+        float32 screenSize = box.GetSize().Length() * 0.5f / distance;
+        if (screenSize < OCCLUDER_MIN_SCREEN_SIZE)
+            continue;
+
+        uint32 trianglesCount = 0;
+        uint32 batchCount = renderObject->GetActiveRenderBatchCount();
+        for (uint32 batchIndex = 0; batchIndex < batchCount && trianglesCount <= OCCLUDER_MAX_TRIANGLES; ++batchIndex)
+        {
+            RenderBatch* batch = renderObject->GetActiveRenderBatch(batchIndex);
+            NMaterial* material = batch->GetMaterial();
+            PolygonGroup* geometry = batch->GetPolygonGroup();
+            if (!material->PreBuildMaterial(passName) || material->GetRenderLayerID() != RenderLayer::RENDER_LAYER_OPAQUE_ID || !OcclusionRasterizer::CanRasterize(geometry))
+            {
+                trianglesCount = 0;
+                break;
+            }
+            trianglesCount += static_cast<uint32>(geometry->indexCount) / 3;
+        }
+
+        if (trianglesCount > 0 && trianglesCount <= OCCLUDER_MAX_TRIANGLES)
+        {
+            occluderCandidates.push_back({ renderObject, screenSize, trianglesCount });
+        }
+    }
+
+    if (occluderCandidates.empty())
+        return;
+
+    std::sort(occluderCandidates.begin(), occluderCandidates.end(), [](const OccluderCandidate& l, const OccluderCandidate& r) {
+        return l.screenSize > r.screenSize;
+    });
+
+    occlusionRasterizer->Begin(camera->GetViewProjMatrix(), rhi::DeviceCaps().isZeroBaseClipRange);
+    uint32 trianglesBudget = OCCLUDERS_TRIANGLES_BUDGET;
+    for (const OccluderCandidate& candidate : occluderCandidates)
+    {
+        if (candidate.trianglesCount > trianglesBudget)
+            continue;
+
+        trianglesBudget -= candidate.trianglesCount;
+        RenderObject* renderObject = candidate.renderObject;
+        for (uint32 batchIndex = 0, batchCount = renderObject->GetActiveRenderBatchCount(); batchIndex < batchCount; ++batchIndex)
+        {
+            occlusionRasterizer->DrawOccluder(renderObject->GetActiveRenderBatch(batchIndex)->GetPolygonGroup(), *renderObject->GetWorldMatrixPtr());
+        }
+    }
+
+    visibilityArray.erase(std::remove_if(visibilityArray.begin(), visibilityArray.end(), [this](RenderObject* renderObject) {
+                              if (renderObject->GetType() == RenderObject::TYPE_LANDSCAPE || renderObject->GetFlags() & RenderObject::ALWAYS_CLIPPING_VISIBLE)
+                                  return false;
+                              return !occlusionRasterizer->IsBoxVisible(renderObject->GetWorldBoundingBox());
+                          }),
+                          visibilityArray.end());
+}
+
 void RenderPass::PrepareLayersArrays(const Vector<RenderObject*> objectsArray, Camera* camera)
 {
+    JobManager* jobManager = GetEngineContext()->jobManager;
+    if (objectsArray.size() >= RenderPassDetails::PARALLEL_PREPARE_MIN_OBJECTS && jobManager != nullptr && jobManager->GetWorkersCount() > 0)
+    {
+        PrepareLayersArraysParallel(objectsArray, camera, jobManager);
+        return;
+    }
+
     size_t size = objectsArray.size();
     for (size_t ro = 0; ro < size; ++ro)
     {
@@ -153,6 +254,117 @@ void RenderPass::PrepareLayersArrays(const Vector<RenderObject*> objectsArray, C
     }
 }
 
+void RenderPass::PrepareLayersArraysParallel(const Vector<RenderObject*>& objectsArray, Camera* camera, JobManager* jobManager)
+{
+    // PrepareToRender isn't thread-safe (e.g. landscape and vegetation update their geometry), so it is called first on main thread
+    for (RenderObject* renderObject : objectsArray)
+    {
+        if (renderObject->GetFlags() & RenderObject::CUSTOM_PREPARE_TO_RENDER)
+        {
+            renderObject->PrepareToRender(camera);
+        }
+    }
+
+    const uint32 chunkSize = RenderPassDetails::PARALLEL_PREPARE_CHUNK_SIZE;
+    uint32 objectsCount = static_cast<uint32>(objectsArray.size());
+    uint32 chunksCount = (objectsCount + chunkSize - 1) / chunkSize;
+    if (preparedChunks.size() < chunksCount)
+    {
+        preparedChunks.resize(chunksCount);
+    }
+
+    jobManager->ParallelFor(0, chunksCount, 1, [&](uint32 begin, uint32 end) {
+        for (uint32 chunk = begin; chunk < end; ++chunk)
+        {
+            PrepareBatches(objectsArray, chunk * chunkSize, Min(objectsCount, (chunk + 1) * chunkSize), preparedChunks[chunk]);
+        }
+    });
+
+    // Merge in chunks order to keep batches order the same as in serial version
+    for (uint32 chunk = 0; chunk < chunksCount; ++chunk)
+    {
+        PreparedBatches& prepared = preparedChunks[chunk];
+        for (uint32 id = 0; id < RenderLayer::RENDER_LAYER_ID_COUNT; ++id)
+        {
+            layersBatchArrays[id].AddRenderBatches(prepared.layersBatches[id]);
+            prepared.layersBatches[id].clear();
+        }
+    }
+
+    // Materials which need rebuild are processed on main thread after all chunks
+    for (uint32 chunk = 0; chunk < chunksCount; ++chunk)
+    {
+        PreparedBatches& prepared = preparedChunks[chunk];
+        for (RenderBatch* batch : prepared.deferredBatches)
+        {
+            NMaterial* material = batch->GetMaterial();
+            if (material->PreBuildMaterial(passName))
+            {
+                layersBatchArrays[material->GetRenderLayerID()].AddRenderBatch(batch);
+            }
+        }
+        prepared.deferredBatches.clear();
+    }
+}
+
+void RenderPass::PrepareBatches(const Vector<RenderObject*>& objectsArray, uint32 begin, uint32 end, PreparedBatches& prepared)
+{
+    for (uint32 ro = begin; ro < end; ++ro)
+    {
+        RenderObject* renderObject = objectsArray[ro];
+        uint32 batchCount = renderObject->GetActiveRenderBatchCount();
+        for (uint32 batchIndex = 0; batchIndex < batchCount; ++batchIndex)
+        {
+            RenderBatch* batch = renderObject->GetActiveRenderBatch(batchIndex);
+
+            NMaterial* material = batch->GetMaterial();
+            DVASSERT(material);
+
+            bool prebuilt = false;
+            uint32 renderLayerID = 0;
+            if (!material->PreBuildMaterialConcurrently(passName, prebuilt, renderLayerID))
+            {
+                prepared.deferredBatches.push_back(batch);
+            }
+            else if (prebuilt)
+            {
+                prepared.layersBatches[renderLayerID].push_back(batch);
+            }
+        }
+    }
+}
+
+void RenderPass::SortLayersArrays(Camera* camera)
+{
+    DAVA_PROFILER_CPU_SCOPE(ProfilerCPUMarkerName::RENDER_PASS_SORT_LAYERS)
+
+    uint32 layersCount = static_cast<uint32>(renderLayers.size());
+    uint32 batchesCount = 0;
+    for (RenderLayer* layer : renderLayers)
+    {
+        batchesCount += layersBatchArrays[layer->GetRenderLayerID()].GetRenderBatchCount();
+    }
+
+    // Every layer has its own batch array, so layers can be sorted concurrently
+    JobManager* jobManager = GetEngineContext()->jobManager;
+    if (layersCount > 1 && batchesCount >= RenderPassDetails::PARALLEL_SORT_MIN_BATCHES && jobManager != nullptr && jobManager->GetWorkersCount() > 0)
+    {
+        jobManager->ParallelFor(0, layersCount, 1, [this, camera](uint32 begin, uint32 end) {
+            for (uint32 k = begin; k < end; ++k)
+            {
+                layersBatchArrays[renderLayers[k]->GetRenderLayerID()].Sort(camera);
+            }
+        });
+    }
+    else
+    {
+        for (RenderLayer* layer : renderLayers)
+        {
+            layersBatchArrays[layer->GetRenderLayerID()].Sort(camera);
+        }
+    }
+}
+
 void RenderPass::DrawLayers(Camera* camera)
 {
     DAVA_PROFILER_CPU_SCOPE(ProfilerCPUMarkerName::RENDER_PASS_DRAW_LAYERS)
@@ -167,13 +379,13 @@ void RenderPass::DrawLayers(Camera* camera)
     Renderer::GetDynamicBindings().SetDynamicParam(DynamicBindings::PARAM_RCP_VIEWPORT_SIZE, &rcpViewportSize, reinterpret_cast<pointer_size>(&rcpViewportSize));
     Renderer::GetDynamicBindings().SetDynamicParam(DynamicBindings::PARAM_VIEWPORT_OFFSET, &viewportOffset, reinterpret_cast<pointer_size>(&viewportOffset));
 
+    SortLayersArrays(camera);
+
     size_t size = renderLayers.size();
     for (size_t k = 0; k < size; ++k)
     {
         RenderLayer* layer = renderLayers[k];
         RenderBatchArray& batchArray = layersBatchArrays[layer->GetRenderLayerID()];
-        batchArray.Sort(camera);
-
         layer->Draw(camera, batchArray, packetList);
     }
 }
@@ -280,6 +492,8 @@ MainForwardRenderPass::MainForwardRenderPass(const FastName& name)
     AddRenderLayer(new RenderLayer(RenderLayer::RENDER_LAYER_DEBUG_DRAW_ID, RenderLayer::LAYER_SORTING_FLAGS_DEBUG_DRAW));
 
     passConfig.priority = PRIORITY_MAIN_3D;
+
+    occlusionRasterizer = new OcclusionRasterizer(RenderPassDetails::OCCLUSION_BUFFER_WIDTH, RenderPassDetails::OCCLUSION_BUFFER_HEIGHT);
 }
 
 void MainForwardRenderPass::InitReflectionRefraction()
@@ -8,6 +8,8 @@
 namespace DAVA
 {
 class Camera;
+class JobManager;
+class OcclusionRasterizer;
 class RenderPass : public InspBase
 {
 public:
@@ -38,8 +40,10 @@ protected:
 
     /*convinience*/
     void PrepareVisibilityArrays(Camera* camera, RenderSystem* renderSystem);
+    void CullOccludedObjects(Camera* camera);
     void PrepareLayersArrays(const Vector<RenderObject*> objectsArray, Camera* camera);
     void ClearLayersArrays();
+    void SortLayersArrays(Camera* camera);
 
     void SetupCameraParams(Camera* mainCamera, Camera* drawCamera, Vector4* externalClipPlane = NULL);
     void DrawLayers(Camera* camera);
@@ -52,8 +56,30 @@ protected:
 
     Vector<RenderLayer*> renderLayers;
     std::array<RenderBatchArray, RenderLayer::RENDER_LAYER_ID_COUNT> layersBatchArrays;
+
+    // Batches collected from one chunk of visibility array by parallel PrepareLayersArrays.
+    // Batches which materials need rebuild are deferred to main thread.
+    struct PreparedBatches
+    {
+        std::array<Vector<RenderBatch*>, RenderLayer::RENDER_LAYER_ID_COUNT> layersBatches;
+        Vector<RenderBatch*> deferredBatches;
+    };
+    void PrepareLayersArraysParallel(const Vector<RenderObject*>& objectsArray, Camera* camera, JobManager* jobManager);
+    void PrepareBatches(const Vector<RenderObject*>& objectsArray, uint32 begin, uint32 end, PreparedBatches& prepared);
+    Vector<PreparedBatches> preparedChunks;
     Vector<RenderObject*> visibilityArray;
 
+    // Objects hidden behind the biggest on-screen meshes are removed from visibility array, see RenderOptions::SOFTWARE_OCCLUSION_CULLING.
+    // Culling is done only by passes which create rasterizer.
+    struct OccluderCandidate
+    {
+        RenderObject* renderObject;
+        float32 screenSize;
+        uint32 trianglesCount;
+    };
+    OcclusionRasterizer* occlusionRasterizer = nullptr;
+    Vector<OccluderCandidate> occluderCandidates;
+
     rhi::HPacketList packetList;
     rhi::HRenderPass renderPass;
 
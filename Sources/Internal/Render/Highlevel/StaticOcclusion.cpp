@@ -1,6 +1,13 @@
 #include "Render/RenderHelper.h"
 #include "Render/Highlevel/StaticOcclusion.h"
 #include "Render/Highlevel/StaticOcclusionRenderPass.h"
+#include "Render/Highlevel/OcclusionRasterizer.h"
+#include "Render/Highlevel/RenderHierarchy.h"
+#include "Render/Highlevel/RenderSystem.h"
+#include "Render/Highlevel/Frustum.h"
+#include "Render/Highlevel/RenderPassNames.h"
+#include "Render/Material/NMaterial.h"
+#include "Render/3D/PolygonGroup.h"
 #include "Render/Highlevel/RenderBatchArray.h"
 #include "Render/Highlevel/Camera.h"
 #include "Render/Image/Image.h"
@@ -12,9 +19,18 @@
 #include "Render/2D/Systems/RenderSystem2D.h"
 #include "Engine/Engine.h"
 #include "Engine/EngineContext.h"
+#include "Job/JobManager.h"
+#include "Base/ScopedPtr.h"
 
 namespace DAVA
 {
+namespace StaticOcclusionDetails
+{
+const uint32 OCCLUSION_RENDER_TARGET_SIZE = 1024; // should match StaticOcclusionRenderPass
+const uint32 SOFTWARE_RASTERIZER_SIZE = 256;
+const uint32 LANDSCAPE_OCCLUDER_RESOLUTION = 64;
+}
+
 StaticOcclusion::StaticOcclusion()
 {
     for (uint32 k = 0; k < 6; ++k)
@@ -33,10 +49,14 @@ StaticOcclusion::~StaticOcclusion()
     SafeDelete(staticOcclusionRenderPass);
 }
 
-void StaticOcclusion::StartBuildOcclusion(StaticOcclusionData* _currentData, RenderSystem* _renderSystem, Landscape* _landscape, uint32 _occlusionPixelThreshold, uint32 _occlusionPixelThresholdForSpeedtree)
+void StaticOcclusion::StartBuildOcclusion(StaticOcclusionData* _currentData, RenderSystem* _renderSystem, Landscape* _landscape, uint32 _occlusionPixelThreshold, uint32 _occlusionPixelThresholdForSpeedtree, bool _softwareRasterization)
 {
     lastInfoMessage = "Preparing to build static occlusion...";
-    staticOcclusionRenderPass = new StaticOcclusionRenderPass(PASS_FORWARD);
+    softwareRasterization = _softwareRasterization;
+    if (!softwareRasterization && staticOcclusionRenderPass == nullptr)
+    {
+        staticOcclusionRenderPass = new StaticOcclusionRenderPass(PASS_FORWARD);
+    }
 
     currentData = _currentData;
     occlusionAreaRect = currentData->bbox;
@@ -59,6 +79,11 @@ void StaticOcclusion::StartBuildOcclusion(StaticOcclusionData* _currentData, Ren
 
     occlusionPixelThreshold = _occlusionPixelThreshold;
     occlusionPixelThresholdForSpeedtree = _occlusionPixelThresholdForSpeedtree;
+
+    if (softwareRasterization)
+    {
+        PrepareSoftwareRasterization();
+    }
 }
 
 AABBox3 StaticOcclusion::GetCellBox(uint32 x, uint32 y, uint32 z)
@@ -97,6 +122,9 @@ void StaticOcclusion::AdvanceToNextBlock()
 
 bool StaticOcclusion::ProcessBlock()
 {
+    if (softwareRasterization)
+        return ProcessSoftwareBlocks();
+
     if (!ProcessRecorderQueries())
     {
         RenderCurrentBlock();
@@ -143,6 +171,14 @@ const String& StaticOcclusion::GetInfoMessage() const
 }
 
 void StaticOcclusion::BuildRenderPassConfigsForCurrentBlock()
+{
+    DVASSERT(occlusionFrameResults.size() == 0); // previous results are processed - at least for now
+
+    BuildRenderPassConfigs(currentFrameX, currentFrameY, currentFrameZ, renderPassConfigs);
+    stats.totalRenderPasses = renderPassConfigs.size();
+}
+
+void StaticOcclusion::BuildRenderPassConfigs(uint32 x, uint32 y, uint32 z, Vector<RenderPassCameraConfig>& configs)
 {
     const uint32 stepCount = 10;
 
@@ -168,13 +204,11 @@ void StaticOcclusion::BuildRenderPassConfigsForCurrentBlock()
       { 5, 5, 5 },
     };
 
-    uint32 blockIndex = currentFrameX + currentFrameY * xBlockCount + currentFrameZ * xBlockCount * yBlockCount;
-    AABBox3 cellBox = GetCellBox(currentFrameX, currentFrameY, currentFrameZ);
+    uint32 blockIndex = x + y * xBlockCount + z * xBlockCount * yBlockCount;
+    AABBox3 cellBox = GetCellBox(x, y, z);
     Vector3 stepSize = cellBox.GetSize();
     stepSize /= float32(stepCount);
 
-    DVASSERT(occlusionFrameResults.size() == 0); // previous results are processed - at least for now
-
     for (uint32 side = 0; side < 6; ++side)
     {
         Vector3 startPosition, directionX, directionY;
@@ -248,13 +282,11 @@ void StaticOcclusion::BuildRenderPassConfigsForCurrentBlock()
                         config.up = Vector3(0.0f, 0.0f, 1.0f);
                         config.left = Vector3(1.0f, 0.0f, 0.0f);
                     }
-                    renderPassConfigs.push_back(config);
+                    configs.push_back(config);
                 }
             }
         }
     }
-
-    stats.totalRenderPasses = renderPassConfigs.size();
 }
 
 bool StaticOcclusion::PerformRender(const RenderPassCameraConfig& rpc)
@@ -371,6 +403,218 @@ bool StaticOcclusion::ProcessRecorderQueries()
     return occlusionFrameResults.empty();
 }
 
+void StaticOcclusion::PrepareSoftwareRasterization()
+{
+    softwareObjects.clear();
+
+    Vector<RenderObject*> renderObjects;
+    RenderHierarchy* renderHierarchy = renderSystem->GetRenderHierarchy();
+    renderHierarchy->GetAllObjectsInBBox(renderHierarchy->GetWorldBoundingBox(), renderObjects);
+
+    // Materials are prebuilt here on main thread, worker threads only read geometry
+    for (RenderObject* renderObject : renderObjects)
+    {
+        RenderObject::eType objectType = renderObject->GetType();
+        if (objectType == RenderObject::TYPE_LANDSCAPE || objectType == RenderObject::TYPE_PARTICLE_EMITTER)
+            continue;
+
+        bool isSwitchObject = false;
+        int32 lodIndex = -1;
+        int32 switchIndex = -1;
+        for (uint32 i = 0, count = renderObject->GetRenderBatchCount(); i < count; ++i)
+        {
+            renderObject->GetRenderBatch(i, lodIndex, switchIndex);
+            isSwitchObject |= (switchIndex > 0);
+        }
+
+        SoftwareOcclusionObject object;
+        object.renderObject = renderObject;
+        object.isOccluder = !isSwitchObject;
+        for (uint32 i = 0, count = renderObject->GetActiveRenderBatchCount(); i < count; ++i)
+        {
+            RenderBatch* batch = renderObject->GetActiveRenderBatch(i);
+            NMaterial* material = batch->GetMaterial();
+            if (material == nullptr || !material->PreBuildMaterial(PASS_FORWARD))
+                continue;
+
+            PolygonGroup* geometry = batch->GetPolygonGroup();
+            if (!OcclusionRasterizer::CanRasterize(geometry))
+                continue;
+
+            uint32 layerID = material->GetRenderLayerID();
+            object.isOccluder &= (layerID == RenderLayer::RENDER_LAYER_OPAQUE_ID || layerID == RenderLayer::RENDER_LAYER_AFTER_OPAQUE_ID);
+            object.geometry.push_back(geometry);
+        }
+
+        // object without geometry in memory can't occlude, but will be tested by its bounding box
+        object.isOccluder &= !object.geometry.empty();
+        softwareObjects.push_back(object);
+    }
+
+    BuildLandscapeOccluder();
+}
+
+void StaticOcclusion::BuildLandscapeOccluder()
+{
+    using namespace StaticOcclusionDetails;
+
+    landscapeVertices.clear();
+    landscapeIndices.clear();
+    landscapeBox.Empty();
+    if (landscape == nullptr)
+        return;
+
+    const uint32 resolution = LANDSCAPE_OCCLUDER_RESOLUTION;
+    const AABBox3& box = landscape->GetWorldBoundingBox();
+    const Vector3 size = box.GetSize();
+
+    landscapeVertices.reserve((resolution + 1) * (resolution + 1));
+    for (uint32 y = 0; y <= resolution; ++y)
+    {
+        for (uint32 x = 0; x <= resolution; ++x)
+        {
+            Vector3 point(box.min.x + size.x * float32(x) / float32(resolution), box.min.y + size.y * float32(y) / float32(resolution), box.max.z);
+            Vector3 pointOnLandscape(point.x, point.y, box.min.z);
+            landscape->PlacePoint(point, pointOnLandscape);
+            landscapeVertices.push_back(pointOnLandscape);
+            landscapeBox.AddPoint(pointOnLandscape);
+        }
+    }
+
+    landscapeIndices.reserve(resolution * resolution * 6);
+    for (uint32 y = 0; y < resolution; ++y)
+    {
+        for (uint32 x = 0; x < resolution; ++x)
+        {
+            uint16 i0 = static_cast<uint16>(y * (resolution + 1) + x);
+            uint16 i1 = static_cast<uint16>(i0 + 1);
+            uint16 i2 = static_cast<uint16>(i0 + resolution + 1);
+            uint16 i3 = static_cast<uint16>(i2 + 1);
+            landscapeIndices.insert(landscapeIndices.end(), { i0, i1, i2, i1, i3, i2 });
+        }
+    }
+}
+
+bool StaticOcclusion::ProcessSoftwareBlocks()
+{
+    using namespace StaticOcclusionDetails;
+
+    JobManager* jobManager = GetEngineContext()->jobManager;
+    const bool useJobs = (jobManager != nullptr && jobManager->GetWorkersCount() > 0);
+    const uint32 batchSize = useJobs ? jobManager->GetWorkersCount() : 1;
+
+    // Blocks write visibility into separate words of StaticOcclusionData, so they are processed concurrently
+    Vector<uint32> blocks;
+    Vector<Vector<RenderPassCameraConfig>> blockConfigs;
+    while (blocks.size() < batchSize)
+    {
+        AdvanceToNextBlock();
+        if (currentFrameZ >= zBlockCount)
+            break;
+
+        blocks.push_back(currentFrameX + currentFrameY * xBlockCount + currentFrameZ * xBlockCount * yBlockCount);
+        blockConfigs.emplace_back();
+        BuildRenderPassConfigs(currentFrameX, currentFrameY, currentFrameZ, blockConfigs.back());
+    }
+
+    auto processBlocks = [&](uint32 begin, uint32 end) {
+        OcclusionRasterizer rasterizer(SOFTWARE_RASTERIZER_SIZE, SOFTWARE_RASTERIZER_SIZE);
+        ScopedPtr<Camera> camera(new Camera());
+        camera->SetupPerspective(95.0f, 1.0f, 1.0f, 2500.0f);
+        for (uint32 i = begin; i < end; ++i)
+        {
+            ProcessSoftwareBlock(blocks[i], blockConfigs[i], rasterizer, camera);
+        }
+    };
+
+    uint32 blocksCount = static_cast<uint32>(blocks.size());
+    if (useJobs && blocksCount > 1)
+    {
+        jobManager->ParallelFor(0, blocksCount, 1, processBlocks);
+    }
+    else if (blocksCount > 0)
+    {
+        processBlocks(0, blocksCount);
+    }
+
+    auto currentTime = SystemTimer::GetNs();
+    stats.buildDuration += static_cast<double>(currentTime - stats.blockProcessingTime) / 1e+9;
+    stats.blockProcessingTime = currentTime;
+
+    UpdateInfoString();
+    return (currentFrameZ >= zBlockCount);
+}
+
+void StaticOcclusion::ProcessSoftwareBlock(uint32 blockIndex, const Vector<RenderPassCameraConfig>& configs, OcclusionRasterizer& rasterizer, Camera* camera)
+{
+    using namespace StaticOcclusionDetails;
+
+    // thresholds are set for pixels of GPU render target
+    const uint32 pixelsScale = (OCCLUSION_RENDER_TARGET_SIZE * OCCLUSION_RENDER_TARGET_SIZE) / (rasterizer.GetWidth() * rasterizer.GetHeight());
+    const uint32 threshold = occlusionPixelThreshold / pixelsScale;
+    const uint32 thresholdForSpeedtree = occlusionPixelThresholdForSpeedtree / pixelsScale;
+    const bool zeroBaseClipRange = rhi::DeviceCaps().isZeroBaseClipRange;
+
+    for (const RenderPassCameraConfig& config : configs)
+    {
+        camera->SetPosition(config.position);
+        camera->SetLeft(config.left);
+        camera->SetUp(config.up);
+        camera->SetDirection(config.direction);
+        rasterizer.Begin(camera->GetViewProjMatrix(), zeroBaseClipRange);
+        Frustum* frustum = camera->GetFrustum();
+
+        if (!landscapeIndices.empty())
+        {
+            rasterizer.DrawOccluder(landscapeVertices.data(), sizeof(Vector3), static_cast<uint32>(landscapeVertices.size()),
+                                    landscapeIndices.data(), static_cast<uint32>(landscapeIndices.size()), Matrix4::IDENTITY, landscapeBox);
+        }
+
+        for (const SoftwareOcclusionObject& object : softwareObjects)
+        {
+            if (object.isOccluder && frustum->IsInside(object.renderObject->GetWorldBoundingBox()))
+            {
+                for (PolygonGroup* geometry : object.geometry)
+                {
+                    rasterizer.DrawOccluder(geometry, *object.renderObject->GetWorldMatrixPtr());
+                }
+            }
+        }
+
+        for (const SoftwareOcclusionObject& object : softwareObjects)
+        {
+            RenderObject* renderObject = object.renderObject;
+            uint16 occlusionIndex = renderObject->GetStaticOcclusionIndex();
+            if (occlusionIndex == INVALID_STATIC_OCCLUSION_INDEX || currentData->IsObjectVisibleFromBlock(blockIndex, occlusionIndex))
+                continue;
+
+            const AABBox3& worldBox = renderObject->GetWorldBoundingBox();
+            if (!frustum->IsInside(worldBox))
+                continue;
+
+            bool isVisible = false;
+            if (object.geometry.empty())
+            {
+                isVisible = rasterizer.IsBoxVisible(worldBox);
+            }
+            else
+            {
+                uint32 visiblePixels = 0;
+                for (PolygonGroup* geometry : object.geometry)
+                {
+                    visiblePixels += rasterizer.CountVisiblePixels(geometry, *renderObject->GetWorldMatrixPtr());
+                }
+                isVisible = visiblePixels > (renderObject->GetType() != RenderObject::TYPE_SPEED_TREE ? threshold : thresholdForSpeedtree);
+            }
+
+            if (isVisible)
+            {
+                currentData->EnableVisibilityForObject(blockIndex, occlusionIndex);
+            }
+        }
+    }
+}
+
 // helper function, see implementation below
 namespace helper
 {
@@ -18,6 +18,8 @@ class RenderSystem;
 class Scene;
 class Sprite;
 class Landscape;
+class OcclusionRasterizer;
+class PolygonGroup;
 
 class StaticOcclusionData
 {
@@ -64,7 +66,8 @@ public:
     StaticOcclusion();
     ~StaticOcclusion();
 
-    void StartBuildOcclusion(StaticOcclusionData* currentData, RenderSystem* renderSystem, Landscape* landscape, uint32 occlusionPixelThreshold, uint32 occlusionPixelThresholdForSpeedtree);
+    // With `softwareRasterization` visibility is computed on CPU by OcclusionRasterizer in worker threads, no GPU queries are used
+    void StartBuildOcclusion(StaticOcclusionData* currentData, RenderSystem* renderSystem, Landscape* landscape, uint32 occlusionPixelThreshold, uint32 occlusionPixelThresholdForSpeedtree, bool softwareRasterization = false);
     bool ProcessBlock(); // returns true if finished building
     void AdvanceToNextBlock();
 
@@ -99,9 +102,22 @@ private:
 
     void UpdateInfoString();
     void BuildRenderPassConfigsForCurrentBlock();
+    void BuildRenderPassConfigs(uint32 x, uint32 y, uint32 z, Vector<RenderPassCameraConfig>& configs);
     bool RenderCurrentBlock(); // returns true, if all passes for block completed
     bool PerformRender(const RenderPassCameraConfig&);
 
+    struct SoftwareOcclusionObject
+    {
+        RenderObject* renderObject = nullptr;
+        Vector<PolygonGroup*> geometry;
+        bool isOccluder = false;
+    };
+
+    void PrepareSoftwareRasterization();
+    void BuildLandscapeOccluder();
+    bool ProcessSoftwareBlocks(); // returns true if finished building
+    void ProcessSoftwareBlock(uint32 blockIndex, const Vector<RenderPassCameraConfig>& configs, OcclusionRasterizer& rasterizer, Camera* camera);
+
 private:
     std::array<Camera*, 6> cameras;
     StaticOcclusionRenderPass* staticOcclusionRenderPass = nullptr;
@@ -121,6 +137,12 @@ private:
     uint32 currentFrameZ = 0;
     uint32 occlusionPixelThreshold = 0;
     uint32 occlusionPixelThresholdForSpeedtree = 0;
+
+    bool softwareRasterization = false;
+    Vector<SoftwareOcclusionObject> softwareObjects;
+    Vector<Vector3> landscapeVertices;
+    Vector<uint16> landscapeIndices;
+    AABBox3 landscapeBox;
 };
 };
 
@@ -4,9 +4,20 @@
 #include "Render/Highlevel/GeometryOctTree.h"
 #include "Render/Highlevel/Landscape.h"
 #include "Render/RenderHelper.h"
+#include "Engine/Engine.h"
+#include "Engine/EngineContext.h"
+#include "Job/JobManager.h"
 
 namespace DAVA
 {
+namespace QuadTreeDetails
+{
+// Trees with less nodes are clipped on the calling thread
+const uint32 PARALLEL_CLIP_MIN_NODES = 256;
+// Subtrees at this depth are clipped on workers, nodes above it are clipped while subtrees are collected
+const uint32 PARALLEL_CLIP_DEPTH = 3;
+}
+
 QuadTree::QuadTreeNode::QuadTreeNode()
 {
     Reset();
@@ -439,7 +450,7 @@ void QuadTree::ObjectUpdated(RenderObject* renderObject)
     } while (sizeUpdeted && (currIndex != INVALID_TREE_NODE_INDEX));
 }
 
-void QuadTree::ProcessNodeClipping(uint16 nodeId, uint8 clippingFlags, Vector<RenderObject*>& visibilityArray)
+bool QuadTree::ClipNode(uint16 nodeId, uint8& clippingFlags)
 {
     QuadTreeNode& currNode = nodes[nodeId];
     int32 objectsSize = static_cast<int32>(currNode.objects.size());
@@ -449,11 +460,17 @@ void QuadTree::ProcessNodeClipping(uint16 nodeId, uint8 clippingFlags, Vector<Re
     {
         uint8 startClipPlane = (currNode.nodeInfo & QuadTreeNode::START_CLIP_PLANE_MASK) >> QuadTreeNode::START_CLIP_PLANE_OFFSET;
         if (currFrustum->Classify(currNode.bbox, clippingFlags, startClipPlane) == Frustum::EFR_OUTSIDE)
-            return; //node box is outside - return
+            return false; //node box is outside
         currNode.nodeInfo &= ~QuadTreeNode::START_CLIP_PLANE_MASK;
         currNode.nodeInfo |= (uint16(startClipPlane)) << QuadTreeNode::START_CLIP_PLANE_OFFSET;
     }
-    //process objects in current node
+    return true;
+}
+
+void QuadTree::ClipNodeObjects(uint16 nodeId, uint8 clippingFlags, Vector<RenderObject*>& visibilityArray)
+{
+    QuadTreeNode& currNode = nodes[nodeId];
+    int32 objectsSize = static_cast<int32>(currNode.objects.size());
     if (!clippingFlags) //node is fully inside frustum - no need to clip anymore
     {
         for (int32 i = 0; i < objectsSize; ++i)
@@ -463,9 +480,6 @@ void QuadTree::ProcessNodeClipping(uint16 nodeId, uint8 clippingFlags, Vector<Re
             if ((flags & currVisibilityCriteria) == currVisibilityCriteria)
             {
                 visibilityArray.push_back(obj);
-#if defined(__DAVAENGINE_RENDERSTATS__)
-                ++Renderer::GetRenderStats().visibleRenderObjects;
-#endif
             }
         }
     }
@@ -481,15 +495,21 @@ void QuadTree::ProcessNodeClipping(uint16 nodeId, uint8 clippingFlags, Vector<Re
                     || currFrustum->IsInside(obj->GetWorldBoundingBox(), clippingFlags, obj->startClippingPlane))
                 {
                     visibilityArray.push_back(obj);
-#if defined(__DAVAENGINE_RENDERSTATS__)
-                    ++Renderer::GetRenderStats().visibleRenderObjects;
-#endif
                 }
             }
         }
     }
+}
+
+void QuadTree::ProcessNodeClipping(uint16 nodeId, uint8 clippingFlags, Vector<RenderObject*>& visibilityArray)
+{
+    if (!ClipNode(nodeId, clippingFlags))
+        return;
+
+    ClipNodeObjects(nodeId, clippingFlags, visibilityArray);
 
     //process children
+    const QuadTreeNode& currNode = nodes[nodeId];
     for (int32 i = 0; i < QuadTreeNode::NODE_NONE; ++i)
     {
         uint16 childNodeId = currNode.children[i];
@@ -500,13 +520,91 @@ void QuadTree::ProcessNodeClipping(uint16 nodeId, uint8 clippingFlags, Vector<Re
     }
 }
 
+void QuadTree::CollectClipTasks(uint16 nodeId, uint8 clippingFlags, uint32 depth)
+{
+    if (depth == QuadTreeDetails::PARALLEL_CLIP_DEPTH)
+    {
+        clipTasks.push_back({ nodeId, clippingFlags, true });
+        return;
+    }
+
+    if (!ClipNode(nodeId, clippingFlags))
+        return;
+
+    clipTasks.push_back({ nodeId, clippingFlags, false });
+
+    const QuadTreeNode& currNode = nodes[nodeId];
+    for (int32 i = 0; i < QuadTreeNode::NODE_NONE; ++i)
+    {
+        uint16 childNodeId = currNode.children[i];
+        if (childNodeId != INVALID_TREE_NODE_INDEX)
+        {
+            CollectClipTasks(childNodeId, clippingFlags, depth + 1);
+        }
+    }
+}
+
+void QuadTree::ClipParallel(Vector<RenderObject*>& visibilityArray, JobManager* jobManager)
+{
+    // Different subtrees have no common nodes and objects, so cached start clip planes are written by one worker only.
+    // Tasks are collected and merged in the order serial clipping visits nodes
+    clipTasks.clear();
+    CollectClipTasks(0, 0x3f, 0);
+
+    uint32 tasksCount = static_cast<uint32>(clipTasks.size());
+    if (clipTaskResults.size() < tasksCount)
+    {
+        clipTaskResults.resize(tasksCount);
+    }
+
+    jobManager->ParallelFor(0, tasksCount, 1, [this](uint32 begin, uint32 end) {
+        for (uint32 i = begin; i < end; ++i)
+        {
+            const ClipTask& task = clipTasks[i];
+            Vector<RenderObject*>& result = clipTaskResults[i];
+            result.clear();
+            if (task.wholeSubtree)
+            {
+                ProcessNodeClipping(task.nodeId, task.clippingFlags, result);
+            }
+            else
+            {
+                ClipNodeObjects(task.nodeId, task.clippingFlags, result);
+            }
+        }
+    });
+
+    for (uint32 i = 0; i < tasksCount; ++i)
+    {
+        visibilityArray.insert(visibilityArray.end(), clipTaskResults[i].begin(), clipTaskResults[i].end());
+    }
+}
+
 void QuadTree::Clip(Camera* camera, Vector<RenderObject*>& visibilityArray, uint32 visibilityCriteria)
 {
     DVASSERT(worldInitialized);
     currCamera = camera;
     currVisibilityCriteria = visibilityCriteria;
     currFrustum = camera->GetFrustum();
-    ProcessNodeClipping(0, 0x3f, visibilityArray);
+
+#if defined(__DAVAENGINE_RENDERSTATS__)
+    size_t visibleBefore = visibilityArray.size();
+#endif
+
+    JobManager* jobManager = GetEngineContext()->jobManager;
+    uint32 nodesCount = static_cast<uint32>(nodes.size() - emptyNodes.size());
+    if (nodesCount >= QuadTreeDetails::PARALLEL_CLIP_MIN_NODES && jobManager != nullptr && jobManager->GetWorkersCount() > 0)
+    {
+        ClipParallel(visibilityArray, jobManager);
+    }
+    else
+    {
+        ProcessNodeClipping(0, 0x3f, visibilityArray);
+    }
+
+#if defined(__DAVAENGINE_RENDERSTATS__)
+    Renderer::GetRenderStats().visibleRenderObjects += static_cast<uint32>(visibilityArray.size() - visibleBefore);
+#endif
 }
 
 void QuadTree::GetObjects(uint16 nodeId, const AABBox3& bbox, Vector<RenderObject*>& visibilityArray)
@@ -10,6 +10,7 @@
 namespace DAVA
 {
 class Frustum;
+class JobManager;
 class RenderObject;
 class QuadTree : public RenderHierarchy
 {
@@ -70,7 +71,11 @@ private:
     void UpdateChildBox(AABBox3& parentBox, QuadTreeNode::eNodeType childType);
     void UpdateParentBox(AABBox3& childBox, QuadTreeNode::eNodeType childType);
 
+    bool ClipNode(uint16 nodeId, uint8& clippingFlags);
+    void ClipNodeObjects(uint16 nodeId, uint8 clippingFlags, Vector<RenderObject*>& visibilityArray);
     void ProcessNodeClipping(uint16 nodeId, uint8 clippingFlags, Vector<RenderObject*>& visibilityArray);
+    void CollectClipTasks(uint16 nodeId, uint8 clippingFlags, uint32 depth);
+    void ClipParallel(Vector<RenderObject*>& visibilityArray, JobManager* jobManager);
     void GetObjects(uint16 nodeId, const AABBox3& bbox, Vector<RenderObject*>& visibilityArray);
     void RecalculateNodeZLimits(uint16 nodeId);
     void MarkNodeDirty(uint16 nodeId);
@@ -92,6 +97,16 @@ private:
     List<RenderObject*> worldInitObjects;
     std::queue<uint16> broadPhaseQueue;
 
+    // Node clipped by parallel Clip: objects of node only or whole subtree
+    struct ClipTask
+    {
+        uint16 nodeId;
+        uint8 clippingFlags;
+        bool wholeSubtree;
+    };
+    Vector<ClipTask> clipTasks;
+    Vector<Vector<RenderObject*>> clipTaskResults;
+
 #if (DAVA_DEBUG_DRAW_OCTREE)
     UniqueHandle debugDrawStateHandle = InvalidUniqueHandle;
 #endif
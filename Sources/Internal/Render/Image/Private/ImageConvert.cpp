@@ -1,8 +1,10 @@
 #include "Render/Image/ImageConvert.h"
 #include "Render/Image/ImageConverter.h"
 #include "Render/Image/Image.h"
+#include "Render/Image/Private/ImageConvertSIMD.h"
 #include "Engine/Engine.h"
 #include "Functional/Function.h"
+#include "Job/JobManager.h"
 #include "Math/HalfFloat.h"
 
 namespace DAVA
@@ -18,41 +20,192 @@ float32 ChannelIntToFloat(uint32 ch)
     return (static_cast<float32>(ch) / std::numeric_limits<uint8>::max());
 }
 
+namespace ImageConvertDetails
+{
+const uint32 PARALLEL_MIN_PIXELS = 256 * 256; // smaller images are converted in calling thread
+const uint32 PARALLEL_STRIPE_PIXELS = 32 * 1024;
+
+void ForEachRowStripe(uint32 width, uint32 height, const Function<void(uint32, uint32)>& fn)
+{
+    JobManager* jobManager = GetEngineContext()->jobManager;
+    if (width * height >= PARALLEL_MIN_PIXELS && jobManager != nullptr && jobManager->GetWorkersCount() > 0)
+    {
+        uint32 stripeHeight = Max(1u, PARALLEL_STRIPE_PIXELS / width);
+        jobManager->ParallelFor(0, height, stripeHeight, fn);
+    }
+    else
+    {
+        fn(0, height);
+    }
+}
+
+// rows are independent, so every stripe of rows is converted as a separate image
+template <class CONVERTER>
+void ConvertRows(const void* inData, uint32 inWidth, uint32 inHeight, uint32 inPitch,
+                 void* outData, uint32 outWidth, uint32 outHeight, uint32 outPitch)
+{
+    ForEachRowStripe(inWidth, inHeight, [&](uint32 begin, uint32 end) {
+        CONVERTER convert;
+        convert(reinterpret_cast<const uint8*>(inData) + begin * inPitch, inWidth, end - begin, inPitch,
+                reinterpret_cast<uint8*>(outData) + begin * outPitch, outWidth, end - begin, outPitch);
+    });
+}
+
+template <class CONVERTER>
+void DownscaleRows(const void* inData, uint32 inWidth, uint32 inHeight, uint32 inPitch,
+                   void* outData, uint32 outWidth, uint32 outHeight, uint32 outPitch)
+{
+    const uint32 inRowsPerOutRow = (inHeight > outHeight) ? 2 : 1;
+    ForEachRowStripe(outWidth, outHeight, [&](uint32 begin, uint32 end) {
+        CONVERTER convert;
+        convert(reinterpret_cast<const uint8*>(inData) + begin * inRowsPerOutRow * inPitch, inWidth, (end - begin) * inRowsPerOutRow, inPitch,
+                reinterpret_cast<uint8*>(outData) + begin * outPitch, outWidth, end - begin, outPitch);
+    });
+}
+
+/** ConvertDirect with vectorized row function, CONVERT_FUNC converts pixels left by CONVERT_ROW_FUNC */
+template <class TYPE_IN, class TYPE_OUT, typename CONVERT_FUNC, typename CONVERT_ROW_FUNC>
+class ConvertDirectSIMD
+{
+public:
+    void operator()(const void* inData, uint32 inWidth, uint32 inHeight, uint32 inPitch,
+                    void* outData, uint32 outWidth, uint32 outHeight, uint32 outPitch)
+    {
+        CONVERT_FUNC func;
+        CONVERT_ROW_FUNC rowFunc;
+        const uint8* readPtr = reinterpret_cast<const uint8*>(inData);
+        uint8* writePtr = reinterpret_cast<uint8*>(outData);
+
+        for (uint32 y = 0; y < inHeight; ++y)
+        {
+            const TYPE_IN* readPtrLine = reinterpret_cast<const TYPE_IN*>(readPtr);
+            TYPE_OUT* writePtrLine = reinterpret_cast<TYPE_OUT*>(writePtr);
+            for (uint32 x = rowFunc(readPtrLine, writePtrLine, inWidth); x < inWidth; ++x)
+            {
+                func(readPtrLine + x, writePtrLine + x);
+            }
+            readPtr += inPitch;
+            writePtr += outPitch;
+        }
+    }
+};
+
+struct SwapRedBlueRow8888
+{
+    uint32 operator()(const BGRA8888* input, RGBA8888* output, uint32 count)
+    {
+        return ImageConvertSIMD::SwapRedBlue8888(reinterpret_cast<const uint32*>(input), reinterpret_cast<uint32*>(output), count);
+    }
+};
+
+struct ConvertRowRGBA4444toRGBA8888
+{
+    uint32 operator()(const uint16* input, uint32* output, uint32 count)
+    {
+        return ImageConvertSIMD::ConvertRGBA4444toRGBA8888(input, output, count);
+    }
+};
+
+struct ConvertRowRGBA5551toRGBA8888
+{
+    uint32 operator()(const uint16* input, uint32* output, uint32 count)
+    {
+        return ImageConvertSIMD::ConvertRGBA5551toRGBA8888(input, output, count);
+    }
+};
+
+struct ConvertRowRGB565toRGBA8888
+{
+    uint32 operator()(const uint16* input, uint32* output, uint32 count)
+    {
+        return ImageConvertSIMD::ConvertRGB565toRGBA8888(input, output, count);
+    }
+};
+
+struct ConvertRowA8toRGBA8888
+{
+    uint32 operator()(const uint8* input, uint32* output, uint32 count)
+    {
+        return ImageConvertSIMD::ConvertA8toRGBA8888(input, output, count);
+    }
+};
+
+/** ConvertDownscaleTwiceBillinear<uint32, uint32, uint32, UnpackRGBA8888, PackRGBA8888> with vectorized rows */
+class ConvertDownscaleTwiceRGBA8888
+{
+public:
+    void operator()(const void* inData, uint32 inWidth, uint32 inHeight, uint32 inPitch,
+                    void* outData, uint32 outWidth, uint32 outHeight, uint32 outPitch)
+    {
+        UnpackRGBA8888 unpackFunc;
+        PackRGBA8888 packFunc;
+        const uint8* readPtr = reinterpret_cast<const uint8*>(inData);
+        uint8* writePtr = reinterpret_cast<uint8*>(outData);
+
+        const uint32 lineStride = (inHeight > outHeight) ? inWidth : 0;
+        const uint32 pixelStride = (inWidth > outWidth) ? 1 : 0;
+
+        for (uint32 y = 0; y < outHeight; ++y)
+        {
+            const uint32* readPtrLine = reinterpret_cast<const uint32*>(readPtr);
+            uint32* writePtrLine = reinterpret_cast<uint32*>(writePtr);
+
+            uint32 x = 0;
+            if (pixelStride != 0 && lineStride != 0)
+            {
+                x = ImageConvertSIMD::DownscaleTwiceRGBA8888(readPtrLine, readPtrLine + lineStride, writePtrLine, outWidth);
+            }
+
+            for (; x < outWidth; ++x)
+            {
+                const uint32* in = readPtrLine + x * 2;
+                uint32 r00, r01, r10, r11, g00, g01, g10, g11, b00, b01, b10, b11, a00, a01, a10, a11;
+                unpackFunc(in, r00, g00, b00, a00);
+                unpackFunc(in + pixelStride, r01, g01, b01, a01);
+                unpackFunc(in + lineStride, r10, g10, b10, a10);
+                unpackFunc(in + lineStride + pixelStride, r11, g11, b11, a11);
+
+                packFunc((r00 + r01 + r10 + r11) / 4, (g00 + g01 + g10 + g11) / 4, (b00 + b01 + b10 + b11) / 4, (a00 + a01 + a10 + a11) / 4, writePtrLine + x);
+            }
+            readPtr += inPitch * 2;
+            writePtr += outPitch;
+        }
+    }
+};
+}
+
 namespace ImageConvert
 {
 bool Normalize(PixelFormat format, const void* inData, uint32 width, uint32 height, uint32 pitch, void* outData)
 {
+    using namespace ImageConvertDetails;
+
     bool processed = true;
     switch (format)
     {
     case FORMAT_RGBA8888:
     {
-        ConvertDirect<uint32, uint32, NormalizeRGBA8888> convert;
-        convert(inData, width, height, pitch, outData, width, height, pitch);
+        ConvertRows<ConvertDirect<uint32, uint32, NormalizeRGBA8888>>(inData, width, height, pitch, outData, width, height, pitch);
         break;
     }
     case FORMAT_RGB16F:
     {
-        ConvertDirect<RGB16F, RGB16F, NormalizeRGB16F> convert;
-        convert(inData, width, height, pitch, outData, width, height, pitch);
+        ConvertRows<ConvertDirect<RGB16F, RGB16F, NormalizeRGB16F>>(inData, width, height, pitch, outData, width, height, pitch);
         break;
     }
     case FORMAT_RGB32F:
     {
-        ConvertDirect<RGB32F, RGB32F, NormalizeRGB32F> convert;
-        convert(inData, width, height, pitch, outData, width, height, pitch);
+        ConvertRows<ConvertDirect<RGB32F, RGB32F, NormalizeRGB32F>>(inData, width, height, pitch, outData, width, height, pitch);
         break;
     }
     case FORMAT_RGBA16F:
     {
-        ConvertDirect<RGBA16F, RGBA16F, NormalizeRGBA16F> convert;
-        convert(inData, width, height, pitch, outData, width, height, pitch);
+        ConvertRows<ConvertDirect<RGBA16F, RGBA16F, NormalizeRGBA16F>>(inData, width, height, pitch, outData, width, height, pitch);
         break;
     }
     case FORMAT_RGBA32F:
     {
-        ConvertDirect<RGBA32F, RGBA32F, NormalizeRGBA32F> convert;
-        convert(inData, width, height, pitch, outData, width, height, pitch);
+        ConvertRows<ConvertDirect<RGBA32F, RGBA32F, NormalizeRGBA32F>>(inData, width, height, pitch, outData, width, height, pitch);
         break;
     }
     default:
@@ -113,100 +266,86 @@ bool ConvertImageDirect(PixelFormat inFormat, PixelFormat outFormat,
                         const void* inData, uint32 inWidth, uint32 inHeight, uint32 inPitch,
                         void* outData, uint32 outWidth, uint32 outHeight, uint32 outPitch)
 {
+    using namespace ImageConvertDetails;
+
     if (inFormat == FORMAT_RGBA5551 && outFormat == FORMAT_RGBA8888)
     {
-        ConvertDirect<uint16, uint32, ConvertRGBA5551toRGBA8888> convert;
-        convert(inData, inWidth, inHeight, inPitch, outData, outWidth, outHeight, outPitch);
+        ConvertRows<ConvertDirectSIMD<uint16, uint32, ConvertRGBA5551toRGBA8888, ConvertRowRGBA5551toRGBA8888>>(inData, inWidth, inHeight, inPitch, outData, outWidth, outHeight, outPitch);
         return true;
     }
     else if (inFormat == FORMAT_RGBA4444 && outFormat == FORMAT_RGBA8888)
     {
-        ConvertDirect<uint16, uint32, ConvertRGBA4444toRGBA8888> convert;
-        convert(inData, inWidth, inHeight, inPitch, outData, outWidth, outHeight, outPitch);
+        ConvertRows<ConvertDirectSIMD<uint16, uint32, ConvertRGBA4444toRGBA8888, ConvertRowRGBA4444toRGBA8888>>(inData, inWidth, inHeight, inPitch, outData, outWidth, outHeight, outPitch);
         return true;
     }
     else if (inFormat == FORMAT_RGB888 && outFormat == FORMAT_RGBA8888)
     {
-        ConvertDirect<RGB888, uint32, ConvertRGB888toRGBA8888> convert;
-        convert(inData, inWidth, inHeight, inPitch, outData, outWidth, outHeight, outPitch);
+        ConvertRows<ConvertDirect<RGB888, uint32, ConvertRGB888toRGBA8888>>(inData, inWidth, inHeight, inPitch, outData, outWidth, outHeight, outPitch);
         return true;
     }
     else if (inFormat == FORMAT_RGB565 && outFormat == FORMAT_RGBA8888)
     {
-        ConvertDirect<uint16, uint32, ConvertRGB565toRGBA8888> convert;
-        convert(inData, inWidth, inHeight, inPitch, outData, outWidth, outHeight, outPitch);
+        ConvertRows<ConvertDirectSIMD<uint16, uint32, ConvertRGB565toRGBA8888, ConvertRowRGB565toRGBA8888>>(inData, inWidth, inHeight, inPitch, outData, outWidth, outHeight, outPitch);
         return true;
     }
     else if (inFormat == FORMAT_A8 && outFormat == FORMAT_RGBA8888)
     {
-        ConvertDirect<uint8, uint32, ConvertA8toRGBA8888> convert;
-        convert(inData, inWidth, inHeight, inPitch, outData, outWidth, outHeight, outPitch);
+        ConvertRows<ConvertDirectSIMD<uint8, uint32, ConvertA8toRGBA8888, ConvertRowA8toRGBA8888>>(inData, inWidth, inHeight, inPitch, outData, outWidth, outHeight, outPitch);
         return true;
     }
     else if (inFormat == FORMAT_A16 && outFormat == FORMAT_RGBA8888)
     {
-        ConvertDirect<uint16, uint32, ConvertA16toRGBA8888> convert;
-        convert(inData, inWidth, inHeight, inPitch, outData, outWidth, outHeight, outPitch);
+        ConvertRows<ConvertDirect<uint16, uint32, ConvertA16toRGBA8888>>(inData, inWidth, inHeight, inPitch, outData, outWidth, outHeight, outPitch);
         return true;
     }
     else if (inFormat == FORMAT_BGR888 && outFormat == FORMAT_RGB888)
     {
-        ConvertDirect<BGR888, RGB888, ConvertBGR888toRGB888> convert;
-        convert(inData, inWidth, inHeight, inPitch, outData, outWidth, outHeight, outPitch);
+        ConvertRows<ConvertDirect<BGR888, RGB888, ConvertBGR888toRGB888>>(inData, inWidth, inHeight, inPitch, outData, outWidth, outHeight, outPitch);
         return true;
     }
     else if (inFormat == FORMAT_BGR888 && outFormat == FORMAT_RGBA8888)
     {
-        ConvertDirect<BGR888, uint32, ConvertBGR888toRGBA8888> convert;
-        convert(inData, inWidth, inHeight, inPitch, outData, outWidth, outHeight, outPitch);
+        ConvertRows<ConvertDirect<BGR888, uint32, ConvertBGR888toRGBA8888>>(inData, inWidth, inHeight, inPitch, outData, outWidth, outHeight, outPitch);
         return true;
     }
     else if (inFormat == FORMAT_BGRA8888 && outFormat == FORMAT_RGBA8888)
     {
-        ConvertDirect<BGRA8888, RGBA8888, ConvertBGRA8888toRGBA8888> convert;
-        convert(inData, inWidth, inHeight, inPitch, outData, outWidth, outHeight, outPitch);
+        ConvertRows<ConvertDirectSIMD<BGRA8888, RGBA8888, ConvertBGRA8888toRGBA8888, SwapRedBlueRow8888>>(inData, inWidth, inHeight, inPitch, outData, outWidth, outHeight, outPitch);
         return true;
     }
     else if (inFormat == FORMAT_RGBA8888 && outFormat == FORMAT_RGB888)
     {
-        ConvertDirect<uint32, RGB888, ConvertRGBA8888toRGB888> convert;
-        convert(inData, inWidth, inHeight, inPitch, outData, outWidth, outHeight, outPitch);
+        ConvertRows<ConvertDirect<uint32, RGB888, ConvertRGBA8888toRGB888>>(inData, inWidth, inHeight, inPitch, outData, outWidth, outHeight, outPitch);
         return true;
     }
     else if (inFormat == FORMAT_RGBA16161616 && outFormat == FORMAT_RGBA8888)
     {
-        ConvertDirect<RGBA16161616, uint32, ConvertRGBA16161616toRGBA8888> convert;
-        convert(inData, inWidth, inHeight, inPitch, outData, outWidth, outHeight, outPitch);
+        ConvertRows<ConvertDirect<RGBA16161616, uint32, ConvertRGBA16161616toRGBA8888>>(inData, inWidth, inHeight, inPitch, outData, outWidth, outHeight, outPitch);
         return true;
     }
     else if (inFormat == FORMAT_RGBA32323232 && outFormat == FORMAT_RGBA8888)
     {
-        ConvertDirect<RGBA32323232, uint32, ConvertRGBA32323232toRGBA8888> convert;
-        convert(inData, inWidth, inHeight, inPitch, outData, outWidth, outHeight, outPitch);
+        ConvertRows<ConvertDirect<RGBA32323232, uint32, ConvertRGBA32323232toRGBA8888>>(inData, inWidth, inHeight, inPitch, outData, outWidth, outHeight, outPitch);
         return true;
     }
     else if (inFormat == FORMAT_RGBA16F && outFormat == FORMAT_RGBA8888)
     {
-        ConvertDirect<RGBA16F, uint32, ConvertRGBA16FtoRGBA8888> convert;
-        convert(inData, inWidth, inHeight, inPitch, outData, outWidth, outHeight, outPitch);
+        ConvertRows<ConvertDirect<RGBA16F, uint32, ConvertRGBA16FtoRGBA8888>>(inData, inWidth, inHeight, inPitch, outData, outWidth, outHeight, outPitch);
         return true;
     }
     else if (inFormat == FORMAT_RGBA32F && outFormat == FORMAT_RGBA8888)
     {
-        ConvertDirect<RGBA32F, uint32, ConvertRGBA32FtoRGBA8888> convert;
-        convert(inData, inWidth, inHeight, inPitch, outData, outWidth, outHeight, outPitch);
+        ConvertRows<ConvertDirect<RGBA32F, uint32, ConvertRGBA32FtoRGBA8888>>(inData, inWidth, inHeight, inPitch, outData, outWidth, outHeight, outPitch);
         return true;
     }
     else if (inFormat == FORMAT_RGBA8888 && outFormat == FORMAT_RGBA16F)
     {
-        ConvertDirect<uint32, RGBA16F, ConvertRGBA8888toRGBA16F> convert;
-        convert(inData, inWidth, inHeight, inPitch, outData, outWidth, outHeight, outPitch);
+        ConvertRows<ConvertDirect<uint32, RGBA16F, ConvertRGBA8888toRGBA16F>>(inData, inWidth, inHeight, inPitch, outData, outWidth, outHeight, outPitch);
         return true;
     }
     else if (inFormat == FORMAT_RGBA8888 && outFormat == FORMAT_RGBA32F)
     {
-        ConvertDirect<uint32, RGBA32F, ConvertRGBA8888toRGBA32F> convert;
-        convert(inData, inWidth, inHeight, inPitch, outData, outWidth, outHeight, outPitch);
+        ConvertRows<ConvertDirect<uint32, RGBA32F, ConvertRGBA8888toRGBA32F>>(inData, inWidth, inHeight, inPitch, outData, outWidth, outHeight, outPitch);
         return true;
     }
     else
@@ -265,6 +404,8 @@ void SwapRedBlueChannels(const Image* srcImage, const Image* dstImage /* = nullp
 
 void SwapRedBlueChannels(PixelFormat format, void* srcData, uint32 width, uint32 height, uint32 pitch, void* dstData /* = nullptr*/)
 {
+    using namespace ImageConvertDetails;
+
     if (!dstData)
         dstData = srcData;
 
@@ -272,38 +413,32 @@ void SwapRedBlueChannels(PixelFormat format, void* srcData, uint32 width, uint32
     {
     case FORMAT_RGB888:
     {
-        ConvertDirect<BGR888, RGB888, ConvertBGR888toRGB888> swap;
-        swap(srcData, width, height, pitch, dstData);
+        ConvertRows<ConvertDirect<BGR888, RGB888, ConvertBGR888toRGB888>>(srcData, width, height, pitch, dstData, width, height, pitch);
         return;
     }
     case FORMAT_RGBA8888:
     {
-        ConvertDirect<BGRA8888, RGBA8888, ConvertBGRA8888toRGBA8888> swap;
-        swap(srcData, width, height, pitch, dstData);
+        ConvertRows<ConvertDirectSIMD<BGRA8888, RGBA8888, ConvertBGRA8888toRGBA8888, SwapRedBlueRow8888>>(srcData, width, height, pitch, dstData, width, height, pitch);
         return;
     }
     case FORMAT_RGBA4444:
     {
-        ConvertDirect<uint16, uint16, ConvertBGRA4444toRGBA4444> swap;
-        swap(srcData, width, height, pitch, dstData);
+        ConvertRows<ConvertDirect<uint16, uint16, ConvertBGRA4444toRGBA4444>>(srcData, width, height, pitch, dstData, width, height, pitch);
         return;
     }
     case FORMAT_RGB565:
     {
-        ConvertDirect<uint16, uint16, ConvertBGR565toRGB565> swap;
-        swap(srcData, width, height, pitch, dstData);
+        ConvertRows<ConvertDirect<uint16, uint16, ConvertBGR565toRGB565>>(srcData, width, height, pitch, dstData, width, height, pitch);
         return;
     }
     case FORMAT_RGBA16161616:
     {
-        ConvertDirect<RGBA16161616, RGBA16161616, ConvertBGRA16161616toRGBA16161616> swap;
-        swap(srcData, width, height, pitch, dstData);
+        ConvertRows<ConvertDirect<RGBA16161616, RGBA16161616, ConvertBGRA16161616toRGBA16161616>>(srcData, width, height, pitch, dstData, width, height, pitch);
         return;
     }
     case FORMAT_RGBA32323232:
     {
-        ConvertDirect<RGBA32323232, RGBA32323232, ConvertBGRA32323232toRGBA32323232> swap;
-        swap(srcData, width, height, pitch, dstData);
+        ConvertRows<ConvertDirect<RGBA32323232, RGBA32323232, ConvertBGRA32323232toRGBA32323232>>(srcData, width, height, pitch, dstData, width, height, pitch);
         return;
     }
     case FORMAT_A8:
@@ -324,63 +459,54 @@ bool DownscaleTwiceBillinear(PixelFormat inFormat, PixelFormat outFormat,
                              const void* inData, uint32 inWidth, uint32 inHeight, uint32 inPitch,
                              void* outData, uint32 outWidth, uint32 outHeight, uint32 outPitch, bool normalize)
 {
+    using namespace ImageConvertDetails;
+
     if ((inFormat == FORMAT_RGBA8888) && (outFormat == FORMAT_RGBA8888))
     {
         if (normalize)
         {
-            ConvertDownscaleTwiceBillinear<uint32, uint32, uint32, UnpackRGBA8888, PackNormalizedRGBA8888> convert;
-            convert(inData, inWidth, inHeight, inPitch, outData, outWidth, outHeight, outPitch);
+            DownscaleRows<ConvertDownscaleTwiceBillinear<uint32, uint32, uint32, UnpackRGBA8888, PackNormalizedRGBA8888>>(inData, inWidth, inHeight, inPitch, outData, outWidth, outHeight, outPitch);
         }
         else
         {
-            ConvertDownscaleTwiceBillinear<uint32, uint32, uint32, UnpackRGBA8888, PackRGBA8888> convert;
-            convert(inData, inWidth, inHeight, inPitch, outData, outWidth, outHeight, outPitch);
+            DownscaleRows<ConvertDownscaleTwiceRGBA8888>(inData, inWidth, inHeight, inPitch, outData, outWidth, outHeight, outPitch);
         }
     }
     else if ((inFormat == FORMAT_RGBA8888) && (outFormat == FORMAT_RGBA4444))
     {
-        ConvertDownscaleTwiceBillinear<uint32, uint16, uint32, UnpackRGBA8888, PackRGBA4444> convert;
-        convert(inData, inWidth, inHeight, inPitch, outData, outWidth, outHeight, outPitch);
+        DownscaleRows<ConvertDownscaleTwiceBillinear<uint32, uint16, uint32, UnpackRGBA8888, PackRGBA4444>>(inData, inWidth, inHeight, inPitch, outData, outWidth, outHeight, outPitch);
     }
     else if ((inFormat == FORMAT_RGBA4444) && (outFormat == FORMAT_RGBA8888))
     {
-        ConvertDownscaleTwiceBillinear<uint16, uint32, uint32, UnpackRGBA4444, PackRGBA8888> convert;
-        convert(inData, inWidth, inHeight, inPitch, outData, outWidth, outHeight, outPitch);
+        DownscaleRows<ConvertDownscaleTwiceBillinear<uint16, uint32, uint32, UnpackRGBA4444, PackRGBA8888>>(inData, inWidth, inHeight, inPitch, outData, outWidth, outHeight, outPitch);
     }
     else if ((inFormat == FORMAT_A8) && (outFormat == FORMAT_A8))
     {
-        ConvertDownscaleTwiceBillinear<uint8, uint8, uint32, UnpackA8, PackA8> convert;
-        convert(inData, inWidth, inHeight, inPitch, outData, outWidth, outHeight, outPitch);
+        DownscaleRows<ConvertDownscaleTwiceBillinear<uint8, uint8, uint32, UnpackA8, PackA8>>(inData, inWidth, inHeight, inPitch, outData, outWidth, outHeight, outPitch);
     }
     else if ((inFormat == FORMAT_RGB888) && (outFormat == FORMAT_RGB888))
     {
-        ConvertDownscaleTwiceBillinear<RGB888, RGB888, uint32, UnpackRGB888, PackRGB888> convert;
-        convert(inData, inWidth, inHeight, inPitch, outData, outWidth, outHeight, outPitch);
+        DownscaleRows<ConvertDownscaleTwiceBillinear<RGB888, RGB888, uint32, UnpackRGB888, PackRGB888>>(inData, inWidth, inHeight, inPitch, outData, outWidth, outHeight, outPitch);
     }
     else if ((inFormat == FORMAT_RGBA5551) && (outFormat == FORMAT_RGBA5551))
     {
-        ConvertDownscaleTwiceBillinear<uint16, uint16, uint32, UnpackRGBA5551, PackRGBA5551> convert;
-        convert(inData, inWidth, inHeight, inPitch, outData, outWidth, outHeight, outPitch);
+        DownscaleRows<ConvertDownscaleTwiceBillinear<uint16, uint16, uint32, UnpackRGBA5551, PackRGBA5551>>(inData, inWidth, inHeight, inPitch, outData, outWidth, outHeight, outPitch);
     }
     else if ((inFormat == FORMAT_RGBA16161616) && (outFormat == FORMAT_RGBA16161616))
     {
-        ConvertDownscaleTwiceBillinear<RGBA16161616, RGBA16161616, uint32, UnpackRGBA16161616, PackRGBA16161616> convert;
-        convert(inData, inWidth, inHeight, inPitch, outData, outWidth, outHeight, outPitch);
+        DownscaleRows<ConvertDownscaleTwiceBillinear<RGBA16161616, RGBA16161616, uint32, UnpackRGBA16161616, PackRGBA16161616>>(inData, inWidth, inHeight, inPitch, outData, outWidth, outHeight, outPitch);
     }
     else if ((inFormat == FORMAT_RGBA32323232) && (outFormat == FORMAT_RGBA32323232))
     {
-        ConvertDownscaleTwiceBillinear<RGBA32323232, RGBA32323232, uint64, UnpackRGBA32323232, PackRGBA32323232> convert;
-        convert(inData, inWidth, inHeight, inPitch, outData, outWidth, outHeight, outPitch);
+        DownscaleRows<ConvertDownscaleTwiceBillinear<RGBA32323232, RGBA32323232, uint64, UnpackRGBA32323232, PackRGBA32323232>>(inData, inWidth, inHeight, inPitch, outData, outWidth, outHeight, outPitch);
     }
     else if ((inFormat == FORMAT_RGBA16F) && (outFormat == FORMAT_RGBA16F))
     {
-        ConvertDownscaleTwiceBillinear<RGBA16F, RGBA16F, float32, UnpackRGBA16F, PackRGBA16F> convert;
-        convert(inData, inWidth, inHeight, inPitch, outData, outWidth, outHeight, outPitch);
+        DownscaleRows<ConvertDownscaleTwiceBillinear<RGBA16F, RGBA16F, float32, UnpackRGBA16F, PackRGBA16F>>(inData, inWidth, inHeight, inPitch, outData, outWidth, outHeight, outPitch);
     }
     else if ((inFormat == FORMAT_RGBA32F) && (outFormat == FORMAT_RGBA32F))
     {
-        ConvertDownscaleTwiceBillinear<RGBA32F, RGBA32F, float32, UnpackRGBA32F, PackRGBA32F> convert;
-        convert(inData, inWidth, inHeight, inPitch, outData, outWidth, outHeight, outPitch);
+        DownscaleRows<ConvertDownscaleTwiceBillinear<RGBA32F, RGBA32F, float32, UnpackRGBA32F, PackRGBA32F>>(inData, inWidth, inHeight, inPitch, outData, outWidth, outHeight, outPitch);
     }
     else
     {
@@ -0,0 +1,321 @@
+#include "Render/Image/Private/ImageConvertSIMD.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define IMAGE_CONVERT_SSE
+#include <emmintrin.h>
+#elif defined(__ARM_NEON__) || defined(__ARM_NEON)
+#define IMAGE_CONVERT_NEON
+#include <arm_neon.h>
+#endif
+
+namespace DAVA
+{
+namespace ImageConvertSIMDDetails
+{
+#if defined(IMAGE_CONVERT_SSE)
+
+using uint4 = __m128i;
+
+inline uint4 Load4(const uint32* p)
+{
+    return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+}
+inline void Store4(uint32* p, uint4 v)
+{
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(p), v);
+}
+inline void Load8(const uint16* p, uint4& lo, uint4& hi)
+{
+    __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+    lo = _mm_unpacklo_epi16(v, _mm_setzero_si128());
+    hi = _mm_unpackhi_epi16(v, _mm_setzero_si128());
+}
+inline void Load16(const uint8* p, uint4* out)
+{
+    __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+    __m128i lo = _mm_unpacklo_epi8(v, _mm_setzero_si128());
+    __m128i hi = _mm_unpackhi_epi8(v, _mm_setzero_si128());
+    out[0] = _mm_unpacklo_epi16(lo, _mm_setzero_si128());
+    out[1] = _mm_unpackhi_epi16(lo, _mm_setzero_si128());
+    out[2] = _mm_unpacklo_epi16(hi, _mm_setzero_si128());
+    out[3] = _mm_unpackhi_epi16(hi, _mm_setzero_si128());
+}
+inline uint4 Splat(uint32 v)
+{
+    return _mm_set1_epi32(static_cast<int32>(v));
+}
+inline uint4 And(uint4 a, uint4 b)
+{
+    return _mm_and_si128(a, b);
+}
+inline uint4 Or(uint4 a, uint4 b)
+{
+    return _mm_or_si128(a, b);
+}
+inline uint4 Sub(uint4 a, uint4 b)
+{
+    return _mm_sub_epi32(a, b);
+}
+template <int N>
+inline uint4 Shl(uint4 v)
+{
+    return _mm_slli_epi32(v, N);
+}
+template <int N>
+inline uint4 Shr(uint4 v)
+{
+    return _mm_srli_epi32(v, N);
+}
+
+#elif defined(IMAGE_CONVERT_NEON)
+
+using uint4 = uint32x4_t;
+
+inline uint4 Load4(const uint32* p)
+{
+    return vld1q_u32(p);
+}
+inline void Store4(uint32* p, uint4 v)
+{
+    vst1q_u32(p, v);
+}
+inline void Load8(const uint16* p, uint4& lo, uint4& hi)
+{
+    uint16x8_t v = vld1q_u16(p);
+    lo = vmovl_u16(vget_low_u16(v));
+    hi = vmovl_u16(vget_high_u16(v));
+}
+inline void Load16(const uint8* p, uint4* out)
+{
+    uint8x16_t v = vld1q_u8(p);
+    uint16x8_t lo = vmovl_u8(vget_low_u8(v));
+    uint16x8_t hi = vmovl_u8(vget_high_u8(v));
+    out[0] = vmovl_u16(vget_low_u16(lo));
+    out[1] = vmovl_u16(vget_high_u16(lo));
+    out[2] = vmovl_u16(vget_low_u16(hi));
+    out[3] = vmovl_u16(vget_high_u16(hi));
+}
+inline uint4 Splat(uint32 v)
+{
+    return vdupq_n_u32(v);
+}
+inline uint4 And(uint4 a, uint4 b)
+{
+    return vandq_u32(a, b);
+}
+inline uint4 Or(uint4 a, uint4 b)
+{
+    return vorrq_u32(a, b);
+}
+inline uint4 Sub(uint4 a, uint4 b)
+{
+    return vsubq_u32(a, b);
+}
+template <int N>
+inline uint4 Shl(uint4 v)
+{
+    return vshlq_n_u32(v, N);
+}
+template <int N>
+inline uint4 Shr(uint4 v)
+{
+    return vshrq_n_u32(v, N);
+}
+
+#endif
+
+#if defined(IMAGE_CONVERT_SSE) || defined(IMAGE_CONVERT_NEON)
+
+template <class EXPAND>
+uint32 Convert16to32(const uint16* in, uint32* out, uint32 count, EXPAND expand)
+{
+    const uint32 processed = count & ~7u;
+    for (uint32 i = 0; i < processed; i += 8)
+    {
+        uint4 lo, hi;
+        Load8(in + i, lo, hi);
+        Store4(out + i, expand(lo));
+        Store4(out + i + 4, expand(hi));
+    }
+    return processed;
+}
+
+#endif
+}
+
+namespace ImageConvertSIMD
+{
+#if defined(IMAGE_CONVERT_SSE) || defined(IMAGE_CONVERT_NEON)
+
+uint32 SwapRedBlue8888(const uint32* in, uint32* out, uint32 count)
+{
+    using namespace ImageConvertSIMDDetails;
+
+    const uint4 gaMask = Splat(0xFF00FF00);
+    const uint4 channelMask = Splat(0x000000FF);
+
+    const uint32 processed = count & ~3u;
+    for (uint32 i = 0; i < processed; i += 4)
+    {
+        uint4 v = Load4(in + i);
+        uint4 ga = And(v, gaMask);
+        uint4 r = And(Shr<16>(v), channelMask);
+        uint4 b = Shl<16>(And(v, channelMask));
+        Store4(out + i, Or(ga, Or(r, b)));
+    }
+    return processed;
+}
+
+uint32 ConvertRGBA4444toRGBA8888(const uint16* in, uint32* out, uint32 count)
+{
+    using namespace ImageConvertSIMDDetails;
+
+    const uint4 rMask = Splat(0x000F);
+    const uint4 gMask = Splat(0x00F0);
+    const uint4 bMask = Splat(0x0F00);
+    const uint4 aMask = Splat(0xF000);
+    return Convert16to32(in, out, count, [&](uint4 p) {
+        uint4 rg = Or(Shl<4>(And(p, rMask)), Shl<8>(And(p, gMask)));
+        uint4 ba = Or(Shl<12>(And(p, bMask)), Shl<16>(And(p, aMask)));
+        return Or(rg, ba);
+    });
+}
+
+uint32 ConvertRGBA5551toRGBA8888(const uint16* in, uint32* out, uint32 count)
+{
+    using namespace ImageConvertSIMDDetails;
+
+    const uint4 rMask = Splat(0x001F);
+    const uint4 gMask = Splat(0x03E0);
+    const uint4 bMask = Splat(0x7C00);
+    const uint4 aMask = Splat(0xFF000000);
+    const uint4 zero = Splat(0);
+    return Convert16to32(in, out, count, [&](uint4 p) {
+        uint4 rg = Or(Shl<3>(And(p, rMask)), Shl<6>(And(p, gMask)));
+        uint4 b = Shl<9>(And(p, bMask));
+        uint4 a = And(Sub(zero, Shr<15>(p)), aMask); // 0 - 1 gives all bits set
+        return Or(rg, Or(b, a));
+    });
+}
+
+uint32 ConvertRGB565toRGBA8888(const uint16* in, uint32* out, uint32 count)
+{
+    using namespace ImageConvertSIMDDetails;
+
+    const uint4 rMask = Splat(0x001F);
+    const uint4 gMask = Splat(0x07E0);
+    const uint4 bMask = Splat(0xF800);
+    const uint4 a = Splat(0xFF000000);
+    return Convert16to32(in, out, count, [&](uint4 p) {
+        uint4 rg = Or(Shl<3>(And(p, rMask)), Shl<5>(And(p, gMask)));
+        uint4 b = Shl<8>(And(p, bMask));
+        return Or(rg, Or(b, a));
+    });
+}
+
+uint32 ConvertA8toRGBA8888(const uint8* in, uint32* out, uint32 count)
+{
+    using namespace ImageConvertSIMDDetails;
+
+    const uint4 a = Splat(0xFF000000);
+    const uint32 processed = count & ~15u;
+    for (uint32 i = 0; i < processed; i += 16)
+    {
+        uint4 p[4];
+        Load16(in + i, p);
+        for (uint32 k = 0; k < 4; ++k)
+        {
+            uint4 rgb = Or(p[k], Or(Shl<8>(p[k]), Shl<16>(p[k])));
+            Store4(out + i + k * 4, Or(rgb, a));
+        }
+    }
+    return processed;
+}
+
+#else
+
+uint32 SwapRedBlue8888(const uint32* in, uint32* out, uint32 count)
+{
+    return 0;
+}
+
+uint32 ConvertRGBA4444toRGBA8888(const uint16* in, uint32* out, uint32 count)
+{
+    return 0;
+}
+
+uint32 ConvertRGBA5551toRGBA8888(const uint16* in, uint32* out, uint32 count)
+{
+    return 0;
+}
+
+uint32 ConvertRGB565toRGBA8888(const uint16* in, uint32* out, uint32 count)
+{
+    return 0;
+}
+
+uint32 ConvertA8toRGBA8888(const uint8* in, uint32* out, uint32 count)
+{
+    return 0;
+}
+
+#endif
+
+#if defined(IMAGE_CONVERT_SSE)
+
+uint32 DownscaleTwiceRGBA8888(const uint32* in0, const uint32* in1, uint32* out, uint32 outCount)
+{
+    // channels are summed in 16-bit lanes: 4 * 255 fits
+    const __m128i zero = _mm_setzero_si128();
+    auto sumQuads = [&zero](__m128i row0, __m128i row1) {
+        __m128i lo = _mm_add_epi16(_mm_unpacklo_epi8(row0, zero), _mm_unpacklo_epi8(row1, zero)); // p0, p1
+        __m128i hi = _mm_add_epi16(_mm_unpackhi_epi8(row0, zero), _mm_unpackhi_epi8(row1, zero)); // p2, p3
+        __m128i sum = _mm_add_epi16(_mm_unpacklo_epi64(lo, hi), _mm_unpackhi_epi64(lo, hi)); // p0 + p1, p2 + p3
+        return _mm_srli_epi16(sum, 2);
+    };
+
+    const uint32 processed = outCount & ~3u;
+    for (uint32 i = 0; i < processed; i += 4)
+    {
+        const __m128i* row0 = reinterpret_cast<const __m128i*>(in0 + i * 2);
+        const __m128i* row1 = reinterpret_cast<const __m128i*>(in1 + i * 2);
+        __m128i q01 = sumQuads(_mm_loadu_si128(row0), _mm_loadu_si128(row1));
+        __m128i q23 = sumQuads(_mm_loadu_si128(row0 + 1), _mm_loadu_si128(row1 + 1));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm_packus_epi16(q01, q23));
+    }
+    return processed;
+}
+
+#elif defined(IMAGE_CONVERT_NEON)
+
+uint32 DownscaleTwiceRGBA8888(const uint32* in0, const uint32* in1, uint32* out, uint32 outCount)
+{
+    const uint32 processed = outCount & ~3u;
+    for (uint32 i = 0; i < processed; i += 4)
+    {
+        // even and odd pixels of both rows
+        uint32x4x2_t row0 = vld2q_u32(in0 + i * 2);
+        uint32x4x2_t row1 = vld2q_u32(in1 + i * 2);
+        uint8x16_t e0 = vreinterpretq_u8_u32(row0.val[0]);
+        uint8x16_t o0 = vreinterpretq_u8_u32(row0.val[1]);
+        uint8x16_t e1 = vreinterpretq_u8_u32(row1.val[0]);
+        uint8x16_t o1 = vreinterpretq_u8_u32(row1.val[1]);
+
+        uint16x8_t lo = vaddq_u16(vaddl_u8(vget_low_u8(e0), vget_low_u8(o0)), vaddl_u8(vget_low_u8(e1), vget_low_u8(o1)));
+        uint16x8_t hi = vaddq_u16(vaddl_u8(vget_high_u8(e0), vget_high_u8(o0)), vaddl_u8(vget_high_u8(e1), vget_high_u8(o1)));
+        uint8x16_t result = vcombine_u8(vshrn_n_u16(lo, 2), vshrn_n_u16(hi, 2));
+        vst1q_u32(out + i, vreinterpretq_u32_u8(result));
+    }
+    return processed;
+}
+
+#else
+
+uint32 DownscaleTwiceRGBA8888(const uint32* in0, const uint32* in1, uint32* out, uint32 outCount)
+{
+    return 0;
+}
+
+#endif
+}
+}
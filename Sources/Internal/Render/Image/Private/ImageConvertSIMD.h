@@ -0,0 +1,26 @@
+#pragma once
+
+#include "Base/BaseTypes.h"
+
+namespace DAVA
+{
+/**
+    Vectorized (SSE2 or NEON) row kernels for the most common ImageConvert conversions.
+    Every kernel processes a multiple of its vector width from the beginning of row and returns
+    count of processed pixels, the rest of row should be processed by scalar functor.
+    Results are bit-exact with scalar functors from 'ImageConvert.h'.
+    On platforms without SIMD kernels return 0.
+*/
+namespace ImageConvertSIMD
+{
+/** BGRA8888 -> RGBA8888 and back, `in` and `out` can be the same */
+uint32 SwapRedBlue8888(const uint32* in, uint32* out, uint32 count);
+uint32 ConvertRGBA4444toRGBA8888(const uint16* in, uint32* out, uint32 count);
+uint32 ConvertRGBA5551toRGBA8888(const uint16* in, uint32* out, uint32 count);
+uint32 ConvertRGB565toRGBA8888(const uint16* in, uint32* out, uint32 count);
+uint32 ConvertA8toRGBA8888(const uint8* in, uint32* out, uint32 count);
+
+/** 2x2 box filter of RGBA8888 rows `in0` and `in1` into `outCount` pixels of `out` */
+uint32 DownscaleTwiceRGBA8888(const uint32* in0, const uint32* in1, uint32* out, uint32 outCount);
+}
+}
@@ -8,9 +8,13 @@
 #include "Utils/Utils.h"
 #include "FileSystem/YamlParser.h"
 #include "FileSystem/YamlNode.h"
+#include "FileSystem/File.h"
+#include "FileSystem/FileSystem.h"
+#include "Base/ScopedPtr.h"
 #include "Scene3D/Systems/QualitySettingsSystem.h"
 #include "Concurrency/Mutex.h"
 #include "Concurrency/LockGuard.h"
+#include "Utils/CRC32.h"
 
 namespace DAVA
 {
@@ -19,14 +23,204 @@ namespace FXCacheDetails
 Map<Vector<size_t>, FXDescriptor> fxDescriptors;
 Map<std::pair<FastName, FastName>, FXDescriptor> oldTemplateMap;
 
+//source files of template, used to detect stale templates in cache file
+struct TemplateSource
+{
+    FastName techniqueName;
+    uint32 hash = 0;
+};
+Map<std::pair<FastName, FastName>, TemplateSource> templateSources;
+
+//keys of descriptors requested by materials during this run - only they are saved
+Set<Vector<size_t>> requestedFX;
+
 FXDescriptor defaultFX;
 bool initialized = false;
 Mutex fxCacheMutex;
+
+const uint32 CACHE_FILE_SIGNATURE = DAVA_MAKEFOURCC('F', 'X', 'C', 'H');
+const uint32 CACHE_FILE_VERSION = 2;
+const uint32 MAX_SAVED_FX_COUNT = 4096;
+
+bool CalculateTemplateHash(const FastName& fxName, const FastName& techniqueName, uint32& hash)
+{
+    CRC32 crc;
+    Vector<uint8> content;
+    if (!FileSystem::Instance()->ReadFileContents(FilePath(fxName.c_str()), content))
+        return false;
+    crc.AddData(content.data(), content.size());
+
+    if (techniqueName.IsValid())
+    {
+        content.clear();
+        if (!FileSystem::Instance()->ReadFileContents(FilePath(techniqueName.c_str()), content))
+            return false;
+        crc.AddData(content.data(), content.size());
+    }
+
+    hash = crc.Done();
+    return true;
+}
+
+UnorderedMap<FastName, int32> BuildPassShaderDefines(const RenderPassDescriptor& pass, const UnorderedMap<FastName, int32>& defines)
+{
+    UnorderedMap<FastName, int32> shaderDefines = defines;
+    for (auto& templateDefine : pass.templateDefines)
+    {
+        if (templateDefine.second == 0)
+            shaderDefines.erase(templateDefine.first);
+        else
+            shaderDefines[templateDefine.first] = templateDefine.second;
+    }
+
+    if (pass.hasBlend)
+    {
+        if (shaderDefines.find(NMaterialFlagName::FLAG_BLENDING) == shaderDefines.end())
+            shaderDefines[NMaterialFlagName::FLAG_BLENDING] = BLENDING_ALPHABLEND;
+    }
+    else
+    {
+        shaderDefines.erase(NMaterialFlagName::FLAG_BLENDING);
+    }
+
+    return shaderDefines;
+}
+
+//modify reflection pass only for editor or if high quality water is enabled - to prevent compiling shaders if not required - performance issue
+void SetupReflectionPassDefines(RenderPassDescriptor& reflectionPass)
+{
+    const static FastName WATER_QUALITY_NAME("Water");
+    const static FastName WATER_QUALITY_REQUIRE_REFLECTION("ULTRA_HIGH");
+
+    reflectionPass.templateDefines.erase(NMaterialFlagName::FLAG_FOG_HALFSPACE);
+    if (QualitySettingsSystem::Instance()->GetRuntimeQualitySwitching() || (QualitySettingsSystem::Instance()->GetCurMaterialQuality(WATER_QUALITY_NAME) == WATER_QUALITY_REQUIRE_REFLECTION))
+        reflectionPass.templateDefines[NMaterialFlagName::FLAG_FOG_HALFSPACE] = 0;
+}
+
+bool WriteName(File* file, const FastName& name)
+{
+    uint32 length = name.IsValid() ? static_cast<uint32>(strlen(name.c_str())) : 0;
+    return (file->Write(&length) == sizeof(length)) && (file->Write(name.c_str(), length) == length);
+}
+
+bool ReadName(File* file, FastName& name)
+{
+    uint32 length = 0;
+    if (file->Read(&length) != sizeof(length) || length > file->GetSize())
+        return false;
+
+    String str(length, '\0');
+    if (file->Read(&str[0], length) != length)
+        return false;
+
+    name = (length > 0) ? FastName(str) : FastName();
+    return true;
+}
+
+bool WriteDefines(File* file, const UnorderedMap<FastName, int32>& defines)
+{
+    uint32 count = static_cast<uint32>(defines.size());
+    if (file->Write(&count) != sizeof(count))
+        return false;
+
+    for (const auto& define : defines)
+    {
+        if (!WriteName(file, define.first) || file->Write(&define.second) != sizeof(define.second))
+            return false;
+    }
+    return true;
+}
+
+bool ReadDefines(File* file, UnorderedMap<FastName, int32>& defines)
+{
+    uint32 count = 0;
+    if (file->Read(&count) != sizeof(count))
+        return false;
+
+    for (uint32 i = 0; i < count; ++i)
+    {
+        FastName name;
+        int32 value = 0;
+        if (!ReadName(file, name) || file->Read(&value) != sizeof(value))
+            return false;
+        defines[name] = value;
+    }
+    return true;
+}
+
+bool WriteTemplate(File* file, const FXDescriptor& fx)
+{
+    uint32 passCount = static_cast<uint32>(fx.renderPassDescriptors.size());
+    if (file->Write(&passCount) != sizeof(passCount))
+        return false;
+
+    for (const RenderPassDescriptor& pass : fx.renderPassDescriptors)
+    {
+        uint8 hasBlend = pass.hasBlend ? 1 : 0;
+        uint8 wireframe = pass.wireframe ? 1 : 0;
+        int32 renderLayer = pass.renderLayer;
+        uint32 cullMode = pass.cullMode;
+
+        bool written = WriteName(file, pass.passName) && WriteName(file, pass.shaderFileName) && WriteDefines(file, pass.templateDefines) &&
+        (file->Write(&hasBlend) == sizeof(hasBlend)) && (file->Write(&wireframe) == sizeof(wireframe)) &&
+        (file->Write(&renderLayer) == sizeof(renderLayer)) && (file->Write(&cullMode) == sizeof(cullMode)) &&
+        (file->Write(&pass.depthStateDescriptor) == sizeof(pass.depthStateDescriptor));
+
+        if (!written)
+            return false;
+    }
+    return true;
+}
+
+bool ReadTemplate(File* file, FXDescriptor& fx)
+{
+    uint32 passCount = 0;
+    if (file->Read(&passCount) != sizeof(passCount))
+        return false;
+
+    fx.renderPassDescriptors.resize(passCount);
+    for (RenderPassDescriptor& pass : fx.renderPassDescriptors)
+    {
+        uint8 hasBlend = 0;
+        uint8 wireframe = 0;
+        int32 renderLayer = 0;
+        uint32 cullMode = 0;
+
+        bool read = ReadName(file, pass.passName) && ReadName(file, pass.shaderFileName) && ReadDefines(file, pass.templateDefines) &&
+        (file->Read(&hasBlend) == sizeof(hasBlend)) && (file->Read(&wireframe) == sizeof(wireframe)) &&
+        (file->Read(&renderLayer) == sizeof(renderLayer)) && (file->Read(&cullMode) == sizeof(cullMode)) &&
+        (file->Read(&pass.depthStateDescriptor) == sizeof(pass.depthStateDescriptor));
+
+        if (!read || renderLayer < RenderLayer::RENDER_LAYER_INVALID_ID || renderLayer >= RenderLayer::RENDER_LAYER_ID_COUNT)
+            return false;
+
+        pass.hasBlend = (hasBlend != 0);
+        pass.wireframe = (wireframe != 0);
+        pass.renderLayer = static_cast<RenderLayer::eRenderLayerID>(renderLayer);
+        pass.cullMode = static_cast<rhi::CullMode>(cullMode);
+
+        //reflection pass depends on current quality settings
+        if (pass.passName == PASS_REFLECTION_REFRACTION)
+            SetupReflectionPassDefines(pass);
+    }
+    return true;
+}
 }
 
 namespace FXCache
 {
 const FXDescriptor& LoadFXFromOldTemplate(const FastName& fxName, UnorderedMap<FastName, int32>& defines, const Vector<size_t>& key, const FastName& quality);
+const FXDescriptor& LoadOldTempalte(const FastName& fxName, const FastName& quality);
+
+Vector<size_t> BuildFXKey(const FastName& fxName, const UnorderedMap<FastName, int32>& defines, const FastName& quality)
+{
+    Vector<size_t> key = ShaderDescriptorCache::BuildFlagsKey(fxName, defines);
+
+    if (quality.IsValid()) //quality made as part of fx key
+        key.push_back(ShaderDescriptorCache::GetUniqueFlagKey(quality));
+
+    return key;
+}
 
 void Initialize()
 {
@@ -71,12 +265,10 @@ const FXDescriptor& GetFXDescriptor(const FastName& fxName, UnorderedMap<FastNam
         return FXCacheDetails::defaultFX;
     }
 
-    Vector<size_t> key = ShaderDescriptorCache::BuildFlagsKey(fxName, defines);
-
-    if (quality.IsValid()) //quality made as part of fx key
-        key.push_back(ShaderDescriptorCache::GetUniqueFlagKey(quality));
+    Vector<size_t> key = BuildFXKey(fxName, defines, quality);
 
     LockGuard<Mutex> guard(FXCacheDetails::fxCacheMutex);
+    requestedFX.insert(key);
     auto it = fxDescriptors.find(key);
     if (it != fxDescriptors.end())
         return it->second;
@@ -110,6 +302,7 @@ const FXDescriptor& LoadOldTempalte(const FastName& fxName, const FastName& qual
 
     const YamlNode* materialTemplateNode = rootNode->Get("MaterialTemplate");
     const YamlNode* renderTechniqueNode = nullptr;
+    TemplateSource source;
     if (materialTemplateNode) //multy-quality material
     {
         const YamlNode* qualityNode = nullptr;
@@ -131,6 +324,7 @@ const FXDescriptor& LoadOldTempalte(const FastName& fxName, const FastName& qual
             }
             qualityNode = materialTemplateNode->Get(materialTemplateNode->GetCount() - 1);
         }
+        source.techniqueName = qualityNode->AsFastName();
         RefPtr<YamlParser> parserTechnique(YamlParser::Create(qualityNode->AsString()));
         if (parserTechnique)
         {
@@ -341,23 +535,22 @@ const FXDescriptor& LoadOldTempalte(const FastName& fxName, const FastName& qual
     }
 
     //copy forward render pass for reflection/refraction - hard coded for now
-    //modify it only for editor or if high quality water is enabled - to prevent compiling shaders if not required - performance issue
     //TODO: rethink how to modify material template without full copy for all passes
-    const static FastName WATER_QUALITY_NAME("Water");
-    const static FastName WATER_QUALITY_REQUIRE_REFLECTION("ULTRA_HIGH");
     for (RenderPassDescriptor& pass : target.renderPassDescriptors)
     {
         if (pass.passName == PASS_FORWARD)
         {
             RenderPassDescriptor reflectionPass = pass;
             reflectionPass.passName = PASS_REFLECTION_REFRACTION;
-            if (QualitySettingsSystem::Instance()->GetRuntimeQualitySwitching() || (QualitySettingsSystem::Instance()->GetCurMaterialQuality(WATER_QUALITY_NAME) == WATER_QUALITY_REQUIRE_REFLECTION))
-                reflectionPass.templateDefines[NMaterialFlagName::FLAG_FOG_HALFSPACE] = 0;
+            SetupReflectionPassDefines(reflectionPass);
             target.renderPassDescriptors.push_back(reflectionPass);
             break;
         }
     }
 
+    if (CalculateTemplateHash(fxName, source.techniqueName, source.hash))
+        templateSources[std::make_pair(fxName, quality)] = source;
+
     return oldTemplateMap[std::make_pair(fxName, quality)] = target;
 }
 
@@ -367,32 +560,172 @@ const FXDescriptor& LoadFXFromOldTemplate(const FastName& fxName, UnorderedMap<F
 
     FXDescriptor target = LoadOldTempalte(fxName, quality); //we copy it to new fxdescr as single template can be compiled to many descriptors
     target.defines = defines; //combine
+    target.quality = quality;
     for (auto& pass : target.renderPassDescriptors)
     {
-        UnorderedMap<FastName, int32> shaderDefines = defines;
-        for (auto& templateDefine : pass.templateDefines)
+        pass.shader = ShaderDescriptorCache::GetShaderDescriptor(pass.shaderFileName, FXCacheDetails::BuildPassShaderDefines(pass, defines));
+        pass.depthStencilState = rhi::AcquireDepthStencilState(pass.depthStateDescriptor);
+    }
+
+    return FXCacheDetails::fxDescriptors[key] = target;
+}
+
+void GetShaderVariants(const FastName& fxName, const UnorderedMap<FastName, int32>& defines, const FastName& quality, Vector<ShaderVariantDescriptor>& shaders)
+{
+    using namespace FXCacheDetails;
+
+    DVASSERT(initialized);
+
+    if (!fxName.IsValid())
+        return;
+
+    LockGuard<Mutex> guard(fxCacheMutex);
+    const FXDescriptor& fxTemplate = LoadOldTempalte(fxName, quality);
+    for (const RenderPassDescriptor& pass : fxTemplate.renderPassDescriptors)
+    {
+        ShaderVariantDescriptor shader;
+        shader.shaderFileName = pass.shaderFileName;
+        shader.defines = BuildPassShaderDefines(pass, defines);
+        shaders.push_back(std::move(shader));
+    }
+}
+
+bool Save(const FilePath& filePath)
+{
+    using namespace FXCacheDetails;
+
+    DVASSERT(initialized);
+
+    FilePath tempFilePath = filePath.GetAbsolutePathname() + ".tmp";
+    ScopedPtr<File> file(File::Create(tempFilePath, File::CREATE | File::WRITE));
+    if (!file)
+    {
+        Logger::Error("[FXCache] Can't create %s", tempFilePath.GetAbsolutePathname().c_str());
+        return false;
+    }
+
+    bool written = false;
+    {
+        LockGuard<Mutex> guard(fxCacheMutex);
+
+        //templates without known sources can't be validated on load, so they are not saved
+        uint32 templateCount = 0;
+        for (const auto& it : oldTemplateMap)
         {
-            if (templateDefine.second == 0)
-                shaderDefines.erase(templateDefine.first);
-            else
-                shaderDefines[templateDefine.first] = templateDefine.second;
+            if (templateSources.count(it.first) > 0)
+                ++templateCount;
         }
 
-        if (pass.hasBlend)
+        //descriptors created from previous cache file but not requested by any material are dropped
+        Vector<const FXDescriptor*> savedFX;
+        for (const Vector<size_t>& key : requestedFX)
         {
-            if (shaderDefines.find(NMaterialFlagName::FLAG_BLENDING) == shaderDefines.end())
-                shaderDefines[NMaterialFlagName::FLAG_BLENDING] = BLENDING_ALPHABLEND;
+            auto it = fxDescriptors.find(key);
+            if (it != fxDescriptors.end() && savedFX.size() < MAX_SAVED_FX_COUNT)
+                savedFX.push_back(&it->second);
         }
-        else
+        uint32 fxCount = static_cast<uint32>(savedFX.size());
+
+        written = (file->Write(&CACHE_FILE_SIGNATURE) == sizeof(uint32)) && (file->Write(&CACHE_FILE_VERSION) == sizeof(uint32)) &&
+        (file->Write(&templateCount) == sizeof(templateCount));
+
+        for (auto it = oldTemplateMap.begin(); written && it != oldTemplateMap.end(); ++it)
         {
-            shaderDefines.erase(NMaterialFlagName::FLAG_BLENDING);
+            auto sourceIt = templateSources.find(it->first);
+            if (sourceIt == templateSources.end())
+                continue;
+
+            const TemplateSource& source = sourceIt->second;
+            written = WriteName(file, it->first.first) && WriteName(file, it->first.second) &&
+            WriteName(file, source.techniqueName) && (file->Write(&source.hash) == sizeof(source.hash)) && WriteTemplate(file, it->second);
         }
 
-        pass.shader = ShaderDescriptorCache::GetShaderDescriptor(pass.shaderFileName, shaderDefines);
-        pass.depthStencilState = rhi::AcquireDepthStencilState(pass.depthStateDescriptor);
+        written = written && (file->Write(&fxCount) == sizeof(fxCount));
+        for (size_t i = 0; written && i < savedFX.size(); ++i)
+        {
+            written = WriteName(file, savedFX[i]->fxName) && WriteName(file, savedFX[i]->quality) && WriteDefines(file, savedFX[i]->defines);
+        }
     }
+    file.reset();
 
-    return FXCacheDetails::fxDescriptors[key] = target;
+    if (!written || !FileSystem::Instance()->MoveFile(tempFilePath, filePath, true))
+    {
+        Logger::Error("[FXCache] Failed to save %s", filePath.GetAbsolutePathname().c_str());
+        FileSystem::Instance()->DeleteFile(tempFilePath);
+        return false;
+    }
+
+    return true;
+}
+
+bool Load(const FilePath& filePath)
+{
+    using namespace FXCacheDetails;
+
+    DVASSERT(initialized);
+
+    ScopedPtr<File> file(File::Create(filePath, File::OPEN | File::READ));
+    if (!file)
+        return false;
+
+    uint32 signature = 0;
+    uint32 version = 0;
+    uint32 templateCount = 0;
+    if (file->Read(&signature) != sizeof(signature) || signature != CACHE_FILE_SIGNATURE ||
+        file->Read(&version) != sizeof(version) || version != CACHE_FILE_VERSION ||
+        file->Read(&templateCount) != sizeof(templateCount))
+    {
+        Logger::Warning("[FXCache] %s has unsupported format, ignoring it", filePath.GetAbsolutePathname().c_str());
+        return false;
+    }
+
+    LockGuard<Mutex> guard(fxCacheMutex);
+
+    for (uint32 i = 0; i < templateCount; ++i)
+    {
+        FastName fxName;
+        FastName quality;
+        TemplateSource source;
+        FXDescriptor fxTemplate;
+        if (!ReadName(file, fxName) || !ReadName(file, quality) || !ReadName(file, source.techniqueName) ||
+            file->Read(&source.hash) != sizeof(source.hash) || !ReadTemplate(file, fxTemplate))
+        {
+            Logger::Warning("[FXCache] %s is corrupted", filePath.GetAbsolutePathname().c_str());
+            return false;
+        }
+
+        //template was modified since cache file was saved - it will be loaded from yaml on demand
+        uint32 actualHash = 0;
+        if (!fxName.IsValid() || !CalculateTemplateHash(fxName, source.techniqueName, actualHash) || actualHash != source.hash)
+            continue;
+
+        fxTemplate.fxName = fxName;
+        std::pair<FastName, FastName> templateKey(fxName, quality);
+        if (oldTemplateMap.emplace(templateKey, std::move(fxTemplate)).second)
+            templateSources[templateKey] = source;
+    }
+
+    uint32 fxCount = 0;
+    if (file->Read(&fxCount) != sizeof(fxCount))
+        return false;
+
+    for (uint32 i = 0; i < fxCount; ++i)
+    {
+        FastName fxName;
+        FastName quality;
+        UnorderedMap<FastName, int32> defines;
+        if (!ReadName(file, fxName) || !ReadName(file, quality) || !ReadDefines(file, defines))
+        {
+            Logger::Warning("[FXCache] %s is corrupted", filePath.GetAbsolutePathname().c_str());
+            return false;
+        }
+
+        Vector<size_t> key = BuildFXKey(fxName, defines, quality);
+        if (fxDescriptors.find(key) == fxDescriptors.end())
+            LoadFXFromOldTemplate(fxName, defines, key, quality);
+    }
+
+    return true;
 }
 }
 }
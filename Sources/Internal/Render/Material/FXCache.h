@@ -3,6 +3,7 @@
 
 #include "Render/Shader.h"
 #include "Render/RHI/rhi_Type.h"
+#include "FileSystem/FilePath.h"
 #include "Render/Highlevel/RenderLayer.h"
 
 namespace DAVA
@@ -27,15 +28,34 @@ struct FXDescriptor
 
     //for storing and further debug simplification
     FastName fxName;
+    FastName quality;
     UnorderedMap<FastName, int32> defines = UnorderedMap<FastName, int32>(16);
 };
 
+struct ShaderVariantDescriptor
+{
+    FastName shaderFileName;
+    UnorderedMap<FastName, int32> defines;
+};
+
 namespace FXCache
 {
 void Initialize();
 void Uninitialize();
 void Clear();
 const FXDescriptor& GetFXDescriptor(const FastName& fxName, UnorderedMap<FastName, int32>& defines, const FastName& quality = NMaterialQualityName::DEFAULT_QUALITY_NAME);
+
+/** Append shaders which passes of FX would be built with to `shaders`, without creating FX descriptor and shaders. */
+void GetShaderVariants(const FastName& fxName, const UnorderedMap<FastName, int32>& defines, const FastName& quality, Vector<ShaderVariantDescriptor>& shaders);
+
+/**
+    Save loaded FX templates and list of FX descriptors requested by materials during this run (at most 4096).
+    `Load` restores templates without parsing yaml files and creates all listed FX descriptors with their shaders,
+    so materials don't build them on first use. Shader sources are taken from rhi::ShaderSourceCache.
+    Templates whose `.material` or technique files were changed since saving are skipped and loaded from yaml on demand.
+*/
+bool Save(const FilePath& filePath);
+bool Load(const FilePath& filePath);
 }
 }
 
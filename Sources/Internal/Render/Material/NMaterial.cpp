@@ -7,6 +7,7 @@
 #include "Render/Highlevel/Landscape.h"
 #include "Render/Material/FXCache.h"
 #include "Render/Shader.h"
+#include "Concurrency/LockGuard.h"
 #include "Render/Texture.h"
 
 #include "Utils/Utils.h"
@@ -150,6 +151,7 @@ NMaterial::~NMaterial()
     }
     for (auto& variant : renderVariants)
         delete variant.second;
+    ClearInstancedVariants();
 }
 
 void NMaterial::BindParams(rhi::Packet& target)
@@ -160,31 +162,75 @@ void NMaterial::BindParams(rhi::Packet& target)
     DVASSERT(activeVariantInstance); //trying to bind material that was not staged to render
     DVASSERT(activeVariantInstance->shader); //should have returned false on PreBuild!
     DVASSERT(activeVariantInstance->shader->IsValid()); //should have returned false on PreBuild!
+    BindVariantParams(activeVariantInstance, target);
+}
+
+void NMaterial::BindInstancedParams(rhi::Packet& target)
+{
+    DAVA_MEMORY_PROFILER_CLASS_ALLOC_SCOPE();
+
+    RenderVariantInstance* variant = NMaterialDetail::GetValuePtr(instancedVariants, activeVariantName);
+    DVASSERT(variant); //PreBuildInstancedVariant should have returned nullptr
+    BindVariantParams(variant, target);
+}
+
+ShaderDescriptor* NMaterial::PreBuildInstancedVariant()
+{
+    DVASSERT(activeVariantInstance); //material should be prebuilt for active pass
+
+    auto it = instancedVariants.find(activeVariantName);
+    if (it == instancedVariants.end())
+    {
+        UnorderedMap<FastName, int32> flags(16);
+        CollectFXFlags(flags);
+        flags[NMaterialFlagName::FLAG_WORLD_INSTANCING] = 1;
+        const FXDescriptor& fxDescr = FXCache::GetFXDescriptor(GetEffectiveFXName(), flags, QualitySettingsSystem::Instance()->GetCurMaterialQuality(GetQualityGroup()));
+
+        //FX which doesn't know about instancing compiles to the same shader without per-instance input, nullptr is stored for it
+        RenderVariantInstance* variant = nullptr;
+        for (auto& variantDescr : fxDescr.renderPassDescriptors)
+        {
+            if (variantDescr.passName == activeVariantName && variantDescr.shader->IsValid() && variantDescr.shader->HasInstanceStream())
+            {
+                variant = CreateRenderVariant(variantDescr);
+                RebuildVariantBindings(variant);
+                RebuildVariantTextureBindings(variant, GetAnisotropyLevel());
+                break;
+            }
+        }
+        it = instancedVariants.emplace(activeVariantName, variant).first;
+    }
+
+    return (it->second != nullptr) ? it->second->shader : nullptr;
+}
+
+void NMaterial::BindVariantParams(RenderVariantInstance* variant, rhi::Packet& target)
+{
     /*set pipeline state*/
-    target.renderPipelineState = activeVariantInstance->shader->GetPiplineState();
-    target.depthStencilState = activeVariantInstance->depthState;
-    target.samplerState = activeVariantInstance->samplerState;
-    target.textureSet = activeVariantInstance->textureSet;
-    target.cullMode = activeVariantInstance->cullMode;
+    target.renderPipelineState = variant->shader->GetPiplineState();
+    target.depthStencilState = variant->depthState;
+    target.samplerState = variant->samplerState;
+    target.textureSet = variant->textureSet;
+    target.cullMode = variant->cullMode;
 
-    if (activeVariantInstance->wireFrame)
+    if (variant->wireFrame)
         target.options |= rhi::Packet::OPT_WIREFRAME;
     else
         target.options &= ~rhi::Packet::OPT_WIREFRAME;
 
-    if (activeVariantInstance->alphablend)
+    if (variant->alphablend)
         target.userFlags |= USER_FLAG_ALPHABLEND;
     else
         target.userFlags &= ~USER_FLAG_ALPHABLEND;
 
-    if (activeVariantInstance->alphatest)
+    if (variant->alphatest)
         target.userFlags |= USER_FLAG_ALPHATEST;
     else
         target.userFlags &= ~USER_FLAG_ALPHATEST;
 
-    activeVariantInstance->shader->UpdateDynamicParams();
+    variant->shader->UpdateDynamicParams();
     /*update values in material const buffers*/
-    for (auto& materialBufferBinding : activeVariantInstance->materialBufferBindings)
+    for (auto& materialBufferBinding : variant->materialBufferBindings)
     {
         if (materialBufferBinding->lastValidPropertySemantic == NMaterialProperty::GetCurrentUpdateSemantic()) //prevent buffer update if nothing changed
             continue;
@@ -215,13 +261,13 @@ void NMaterial::BindParams(rhi::Packet& target)
         materialBufferBinding->lastValidPropertySemantic = NMaterialProperty::GetCurrentUpdateSemantic();
     }
 
-    target.vertexConstCount = static_cast<uint32>(activeVariantInstance->vertexConstBuffers.size());
-    target.fragmentConstCount = static_cast<uint32>(activeVariantInstance->fragmentConstBuffers.size());
+    target.vertexConstCount = static_cast<uint32>(variant->vertexConstBuffers.size());
+    target.fragmentConstCount = static_cast<uint32>(variant->fragmentConstBuffers.size());
     /*bind material const buffers*/
-    for (size_t i = 0, sz = activeVariantInstance->vertexConstBuffers.size(); i < sz; ++i)
-        target.vertexConst[i] = activeVariantInstance->vertexConstBuffers[i];
-    for (size_t i = 0, sz = activeVariantInstance->fragmentConstBuffers.size(); i < sz; ++i)
-        target.fragmentConst[i] = activeVariantInstance->fragmentConstBuffers[i];
+    for (size_t i = 0, sz = variant->vertexConstBuffers.size(); i < sz; ++i)
+        target.vertexConst[i] = variant->vertexConstBuffers[i];
+    for (size_t i = 0, sz = variant->fragmentConstBuffers.size(); i < sz; ++i)
+        target.fragmentConst[i] = variant->fragmentConstBuffers[i];
 }
 
 uint32 NMaterial::GetRequiredVertexFormat()
@@ -740,6 +786,11 @@ void NMaterial::ClearLocalBuffers()
     }
     for (auto& variant : renderVariants)
         variant.second->materialBufferBindings.clear();
+    for (auto& variant : instancedVariants)
+    {
+        if (variant.second != nullptr)
+            variant.second->materialBufferBindings.clear();
+    }
     localConstBuffers.clear();
 }
 
@@ -771,20 +822,14 @@ void NMaterial::InvalidateRenderVariants()
 void NMaterial::PreCacheFX()
 {
     UnorderedMap<FastName, int32> flags(16);
-    CollectMaterialFlags(flags);
-    flags.erase(NMaterialFlagName::FLAG_ILLUMINATION_USED);
-    flags.erase(NMaterialFlagName::FLAG_ILLUMINATION_SHADOW_CASTER);
-    flags.erase(NMaterialFlagName::FLAG_ILLUMINATION_SHADOW_RECEIVER);
+    CollectFXFlags(flags);
     FXCache::GetFXDescriptor(GetEffectiveFXName(), flags, QualitySettingsSystem::Instance()->GetCurMaterialQuality(GetQualityGroup()));
 }
 
 void NMaterial::PreCacheFXWithFlags(const UnorderedMap<FastName, int32>& extraFlags, const FastName& extraFxName)
 {
     UnorderedMap<FastName, int32> flags(16);
-    CollectMaterialFlags(flags);
-    flags.erase(NMaterialFlagName::FLAG_ILLUMINATION_USED);
-    flags.erase(NMaterialFlagName::FLAG_ILLUMINATION_SHADOW_CASTER);
-    flags.erase(NMaterialFlagName::FLAG_ILLUMINATION_SHADOW_RECEIVER);
+    CollectFXFlags(flags);
     for (auto& it : extraFlags)
     {
         if (it.second == 0)
@@ -813,15 +858,20 @@ void NMaterial::PreCacheFXVariations(const Vector<FastName>& fxNames, const Vect
     }
 }
 
-void NMaterial::RebuildRenderVariants()
+void NMaterial::CollectFXFlags(UnorderedMap<FastName, int32>& flags)
 {
-    InvalidateBufferBindings();
-
-    UnorderedMap<FastName, int32> flags(16);
     CollectMaterialFlags(flags);
     flags.erase(NMaterialFlagName::FLAG_ILLUMINATION_USED);
     flags.erase(NMaterialFlagName::FLAG_ILLUMINATION_SHADOW_CASTER);
     flags.erase(NMaterialFlagName::FLAG_ILLUMINATION_SHADOW_RECEIVER);
+}
+
+void NMaterial::RebuildRenderVariants()
+{
+    InvalidateBufferBindings();
+
+    UnorderedMap<FastName, int32> flags(16);
+    CollectFXFlags(flags);
     const FXDescriptor& fxDescr = FXCache::GetFXDescriptor(GetEffectiveFXName(), flags, QualitySettingsSystem::Instance()->GetCurMaterialQuality(GetQualityGroup()));
 
     if (fxDescr.renderPassDescriptors.size() == 0)
@@ -838,18 +888,11 @@ void NMaterial::RebuildRenderVariants()
         delete variant.second;
     }
     renderVariants.clear();
+    ClearInstancedVariants();
 
     for (auto& variantDescr : fxDescr.renderPassDescriptors)
     {
-        RenderVariantInstance* variant = new RenderVariantInstance();
-        variant->renderLayer = variantDescr.renderLayer;
-        variant->depthState = variantDescr.depthStencilState;
-        variant->shader = variantDescr.shader;
-        variant->cullMode = variantDescr.cullMode;
-        variant->wireFrame = variantDescr.wireframe;
-        variant->alphablend = variantDescr.hasBlend;
-        variant->alphatest = (variantDescr.templateDefines.count(FastName("ALPHATEST")) != 0);
-        renderVariants[variantDescr.passName] = variant;
+        renderVariants[variantDescr.passName] = CreateRenderVariant(variantDescr);
     }
 
     activeVariantName = FastName();
@@ -859,6 +902,28 @@ void NMaterial::RebuildRenderVariants()
     needRebuildTextures = true;
 }
 
+RenderVariantInstance* NMaterial::CreateRenderVariant(const RenderPassDescriptor& variantDescr)
+{
+    RenderVariantInstance* variant = new RenderVariantInstance();
+    variant->renderLayer = variantDescr.renderLayer;
+    variant->depthState = variantDescr.depthStencilState;
+    variant->shader = variantDescr.shader;
+    variant->cullMode = variantDescr.cullMode;
+    variant->wireFrame = variantDescr.wireframe;
+    variant->alphablend = variantDescr.hasBlend;
+    variant->alphatest = (variantDescr.templateDefines.count(FastName("ALPHATEST")) != 0);
+    return variant;
+}
+
+void NMaterial::ClearInstancedVariants()
+{
+    for (auto& variant : instancedVariants)
+    {
+        delete variant.second;
+    }
+    instancedVariants.clear();
+}
+
 void NMaterial::CollectMaterialFlags(UnorderedMap<FastName, int32>& target)
 {
     if (parent)
@@ -890,182 +955,204 @@ void NMaterial::RebuildBindings()
 
     for (auto& variant : renderVariants)
     {
-        RenderVariantInstance* currRenderVariant = variant.second;
-        ShaderDescriptor* currShader = currRenderVariant->shader;
-        if (!currShader->IsValid()) //cant build for empty shader
-            continue;
-        currRenderVariant->vertexConstBuffers.resize(currShader->GetVertexConstBuffersCount());
-        currRenderVariant->fragmentConstBuffers.resize(currShader->GetFragmentConstBuffersCount());
+        RebuildVariantBindings(variant.second);
+    }
+    for (auto& variant : instancedVariants)
+    {
+        if (variant.second != nullptr)
+            RebuildVariantBindings(variant.second);
+    }
+
+    needRebuildBindings = false;
+}
+
+void NMaterial::RebuildVariantBindings(RenderVariantInstance* currRenderVariant)
+{
+    ShaderDescriptor* currShader = currRenderVariant->shader;
+    if (!currShader->IsValid()) //cant build for empty shader
+        return;
+
+    currRenderVariant->vertexConstBuffers.resize(currShader->GetVertexConstBuffersCount());
+    currRenderVariant->fragmentConstBuffers.resize(currShader->GetFragmentConstBuffersCount());
 
-        for (auto& bufferDescr : currShader->GetConstBufferDescriptors())
+    for (auto& bufferDescr : currShader->GetConstBufferDescriptors())
+    {
+        rhi::HConstBuffer bufferHandle;
+        MaterialBufferBinding* bufferBinding = nullptr;
+        //for static buffers resolve sharing and bindings
+        if (bufferDescr.updateType == rhi::ShaderProp::SOURCE_MATERIAL)
         {
-            rhi::HConstBuffer bufferHandle;
-            MaterialBufferBinding* bufferBinding = nullptr;
-            //for static buffers resolve sharing and bindings
-            if (bufferDescr.updateType == rhi::ShaderProp::SOURCE_MATERIAL)
+            bufferBinding = GetConstBufferBinding(bufferDescr.propertyLayoutId);
+            //local buffers can contain buffer for corresponding layout if for example several passes us same buffer layout
+            bool needLocalOverride = NeedLocalOverride(bufferDescr.propertyLayoutId) && (NMaterialDetail::GetValuePtr(localConstBuffers, bufferDescr.propertyLayoutId) == nullptr);
+            //Create local buffer and build it's bindings if required;
+            if ((bufferBinding == nullptr) || needLocalOverride)
             {
-                bufferBinding = GetConstBufferBinding(bufferDescr.propertyLayoutId);
-                //local buffers can contain buffer for corresponding layout if for example several passes us same buffer layout
-                bool needLocalOverride = NeedLocalOverride(bufferDescr.propertyLayoutId) && (NMaterialDetail::GetValuePtr(localConstBuffers, bufferDescr.propertyLayoutId) == nullptr);
-                //Create local buffer and build it's bindings if required;
-                if ((bufferBinding == nullptr) || needLocalOverride)
-                {
-                    //create buffer
-                    bufferBinding = new MaterialBufferBinding();
+                //create buffer
+                bufferBinding = new MaterialBufferBinding();
 
-                    //create handles
-                    if (bufferDescr.type == ConstBufferDescriptor::Type::Vertex)
-                        bufferBinding->constBuffer = rhi::CreateVertexConstBuffer(currShader->GetPiplineState(), bufferDescr.targetSlot);
-                    else
-                        bufferBinding->constBuffer = rhi::CreateFragmentConstBuffer(currShader->GetPiplineState(), bufferDescr.targetSlot);
+                //create handles
+                if (bufferDescr.type == ConstBufferDescriptor::Type::Vertex)
+                    bufferBinding->constBuffer = rhi::CreateVertexConstBuffer(currShader->GetPiplineState(), bufferDescr.targetSlot);
+                else
+                    bufferBinding->constBuffer = rhi::CreateFragmentConstBuffer(currShader->GetPiplineState(), bufferDescr.targetSlot);
 
-                    if (bufferBinding->constBuffer != rhi::InvalidHandle)
-                    {
-                        //if const buffer is InvalidHandle this means that whole const buffer was cut by shader compiler/linker
-                        //it should not be updated but still can be shared as other shader variants can use it
+                if (bufferBinding->constBuffer != rhi::InvalidHandle)
+                {
+                    //if const buffer is InvalidHandle this means that whole const buffer was cut by shader compiler/linker
+                    //it should not be updated but still can be shared as other shader variants can use it
 
-                        //create bindings for this buffer
-                        for (auto& propDescr : ShaderDescriptor::GetProps(bufferDescr.propertyLayoutId))
+                    //create bindings for this buffer
+                    for (auto& propDescr : ShaderDescriptor::GetProps(bufferDescr.propertyLayoutId))
+                    {
+                        NMaterialProperty* prop = GetMaterialProperty(propDescr.uid);
+                        if ((prop != nullptr)) //has property of the same type
                         {
-                            NMaterialProperty* prop = GetMaterialProperty(propDescr.uid);
-                            if ((prop != nullptr)) //has property of the same type
-                            {
-                                DVASSERT(prop->type == propDescr.type);
+                            DVASSERT(prop->type == propDescr.type);
 
-                                // create property binding
+                            // create property binding
 
-                                bufferBinding->propBindings.emplace_back(propDescr.type,
-                                                                         propDescr.bufferReg, propDescr.bufferRegCount, 0, prop);
+                            bufferBinding->propBindings.emplace_back(propDescr.type,
+                                                                     propDescr.bufferReg, propDescr.bufferRegCount, 0, prop);
+                        }
+                        else
+                        {
+                            //just set default property to const buffer
+                            if (propDescr.type < rhi::ShaderProp::TYPE_FLOAT4)
+                            {
+                                rhi::UpdateConstBuffer1fv(bufferBinding->constBuffer, propDescr.bufferReg, propDescr.bufferRegCount, propDescr.defaultValue, ShaderDescriptor::CalculateDataSize(propDescr.type, 1));
                             }
                             else
                             {
-                                //just set default property to const buffer
-                                if (propDescr.type < rhi::ShaderProp::TYPE_FLOAT4)
-                                {
-                                    rhi::UpdateConstBuffer1fv(bufferBinding->constBuffer, propDescr.bufferReg, propDescr.bufferRegCount, propDescr.defaultValue, ShaderDescriptor::CalculateDataSize(propDescr.type, 1));
-                                }
-                                else
-                                {
-                                    rhi::UpdateConstBuffer4fv(bufferBinding->constBuffer, propDescr.bufferReg, propDescr.defaultValue, propDescr.bufferRegCount);
-                                }
+                                rhi::UpdateConstBuffer4fv(bufferBinding->constBuffer, propDescr.bufferReg, propDescr.defaultValue, propDescr.bufferRegCount);
                             }
                         }
                     }
-
-                    //store it locally or at parent
-                    if (needLocalOverride || (!parent))
-                    {
-                        //buffer should be handled locally
-                        DVASSERT(NMaterialDetail::GetValuePtr(localConstBuffers, bufferDescr.propertyLayoutId) == nullptr);
-                        localConstBuffers[bufferDescr.propertyLayoutId] = bufferBinding;
-                    }
-                    else
-                    {
-                        //buffer can be propagated upward
-                        parent->InjectChildBuffer(bufferDescr.propertyLayoutId, bufferBinding);
-                    }
                 }
-                currRenderVariant->materialBufferBindings.push_back(bufferBinding);
 
-                bufferHandle = bufferBinding->constBuffer;
+                //store it locally or at parent
+                if (needLocalOverride || (!parent))
+                {
+                    //buffer should be handled locally
+                    DVASSERT(NMaterialDetail::GetValuePtr(localConstBuffers, bufferDescr.propertyLayoutId) == nullptr);
+                    localConstBuffers[bufferDescr.propertyLayoutId] = bufferBinding;
+                }
+                else
+                {
+                    //buffer can be propagated upward
+                    parent->InjectChildBuffer(bufferDescr.propertyLayoutId, bufferBinding);
+                }
             }
+            currRenderVariant->materialBufferBindings.push_back(bufferBinding);
 
-            else //if (bufferDescr.updateType == ConstBufferDescriptor::ConstBufferUpdateType::Static)
-            {
-                //for dynamic buffers just copy it's handle to corresponding slot
-                bufferHandle = currShader->GetDynamicBuffer(bufferDescr.type, bufferDescr.targetSlot);
-            }
+            bufferHandle = bufferBinding->constBuffer;
+        }
 
-            if (bufferHandle.IsValid())
-            {
-                if (bufferDescr.type == ConstBufferDescriptor::Type::Vertex)
-                    currRenderVariant->vertexConstBuffers[bufferDescr.targetSlot] = bufferHandle;
-                else
-                    currRenderVariant->fragmentConstBuffers[bufferDescr.targetSlot] = bufferHandle;
-            }
+        else //if (bufferDescr.updateType == ConstBufferDescriptor::ConstBufferUpdateType::Static)
+        {
+            //for dynamic buffers just copy it's handle to corresponding slot
+            bufferHandle = currShader->GetDynamicBuffer(bufferDescr.type, bufferDescr.targetSlot);
         }
-    }
 
-    needRebuildBindings = false;
+        if (bufferHandle.IsValid())
+        {
+            if (bufferDescr.type == ConstBufferDescriptor::Type::Vertex)
+                currRenderVariant->vertexConstBuffers[bufferDescr.targetSlot] = bufferHandle;
+            else
+                currRenderVariant->fragmentConstBuffers[bufferDescr.targetSlot] = bufferHandle;
+        }
+    }
 }
 
-void NMaterial::RebuildTextureBindings()
+uint32 NMaterial::GetAnisotropyLevel() const
 {
-    InvalidateTextureBindings();
-
     const AnisotropyQuality* anisotropicQuality =
     QualitySettingsSystem::Instance()->GetAnisotropyQuality(QualitySettingsSystem::Instance()->GetCurAnisotropyQuality());
 
-    uint32_t anisotropyLevel = (anisotropicQuality == nullptr) ? 1 : std::min(anisotropicQuality->maxAnisotropy, rhi::DeviceCaps().maxAnisotropy);
+    return (anisotropicQuality == nullptr) ? 1 : std::min(anisotropicQuality->maxAnisotropy, rhi::DeviceCaps().maxAnisotropy);
+}
+
+void NMaterial::RebuildTextureBindings()
+{
+    InvalidateTextureBindings();
 
+    uint32 anisotropyLevel = GetAnisotropyLevel();
     for (auto& variant : renderVariants)
     {
-        RenderVariantInstance* currRenderVariant = variant.second;
+        RebuildVariantTextureBindings(variant.second, anisotropyLevel);
+    }
+    for (auto& variant : instancedVariants)
+    {
+        if (variant.second != nullptr)
+            RebuildVariantTextureBindings(variant.second, anisotropyLevel);
+    }
 
-        //release existing
-        rhi::ReleaseTextureSet(currRenderVariant->textureSet);
-        rhi::ReleaseSamplerState(currRenderVariant->samplerState);
+    needRebuildTextures = false;
+}
 
-        ShaderDescriptor* currShader = currRenderVariant->shader;
-        if (!currShader->IsValid()) //cant build for empty shader
-            continue;
-        rhi::TextureSetDescriptor textureDescr;
-        rhi::SamplerState::Descriptor samplerDescr;
-        const rhi::ShaderSamplerList& fragmentSamplerList = currShader->GetFragmentSamplerList();
-        const rhi::ShaderSamplerList& vertexSamplerList = currShader->GetVertexSamplerList();
-
-        textureDescr.fragmentTextureCount = static_cast<uint32>(fragmentSamplerList.size());
-        samplerDescr.fragmentSamplerCount = static_cast<uint32>(fragmentSamplerList.size());
-        for (size_t i = 0, sz = textureDescr.fragmentTextureCount; i < sz; ++i)
-        {
-            RuntimeTextures::eDynamicTextureSemantic textureSemantic = RuntimeTextures::GetDynamicTextureSemanticByName(currShader->GetFragmentSamplerList()[i].uid);
-            if (textureSemantic == RuntimeTextures::TEXTURE_STATIC)
-            {
-                Texture* tex = GetEffectiveTexture(fragmentSamplerList[i].uid);
-                if (tex)
-                {
-                    textureDescr.fragmentTexture[i] = tex->handle;
-                    samplerDescr.fragmentSampler[i] = tex->samplerState;
-                }
-                else
-                {
-                    textureDescr.fragmentTexture[i] = Renderer::GetRuntimeTextures().GetPinkTexture(fragmentSamplerList[i].type);
-                    samplerDescr.fragmentSampler[i] = Renderer::GetRuntimeTextures().GetPinkTextureSamplerState(fragmentSamplerList[i].type);
+void NMaterial::RebuildVariantTextureBindings(RenderVariantInstance* currRenderVariant, uint32 anisotropyLevel)
+{
+    //release existing
+    rhi::ReleaseTextureSet(currRenderVariant->textureSet);
+    rhi::ReleaseSamplerState(currRenderVariant->samplerState);
 
-                    Logger::FrameworkDebug(" no texture for slot : %s", fragmentSamplerList[i].uid.c_str());
-                }
-            }
-            else
-            {
-                textureDescr.fragmentTexture[i] = Renderer::GetRuntimeTextures().GetDynamicTexture(textureSemantic);
-                samplerDescr.fragmentSampler[i] = Renderer::GetRuntimeTextures().GetDynamicTextureSamplerState(textureSemantic);
-            }
-            samplerDescr.fragmentSampler[i].anisotropyLevel = anisotropyLevel;
-            DVASSERT(textureDescr.fragmentTexture[i].IsValid());
-        }
+    ShaderDescriptor* currShader = currRenderVariant->shader;
+    if (!currShader->IsValid()) //cant build for empty shader
+        return;
+    rhi::TextureSetDescriptor textureDescr;
+    rhi::SamplerState::Descriptor samplerDescr;
+    const rhi::ShaderSamplerList& fragmentSamplerList = currShader->GetFragmentSamplerList();
+    const rhi::ShaderSamplerList& vertexSamplerList = currShader->GetVertexSamplerList();
 
-        textureDescr.vertexTextureCount = static_cast<uint32>(vertexSamplerList.size());
-        samplerDescr.vertexSamplerCount = static_cast<uint32>(vertexSamplerList.size());
-        for (size_t i = 0, sz = textureDescr.vertexTextureCount; i < sz; ++i)
+    textureDescr.fragmentTextureCount = static_cast<uint32>(fragmentSamplerList.size());
+    samplerDescr.fragmentSamplerCount = static_cast<uint32>(fragmentSamplerList.size());
+    for (size_t i = 0, sz = textureDescr.fragmentTextureCount; i < sz; ++i)
+    {
+        RuntimeTextures::eDynamicTextureSemantic textureSemantic = RuntimeTextures::GetDynamicTextureSemanticByName(currShader->GetFragmentSamplerList()[i].uid);
+        if (textureSemantic == RuntimeTextures::TEXTURE_STATIC)
         {
-            Texture* tex = GetEffectiveTexture(vertexSamplerList[i].uid);
+            Texture* tex = GetEffectiveTexture(fragmentSamplerList[i].uid);
             if (tex)
             {
-                textureDescr.vertexTexture[i] = tex->handle;
-                samplerDescr.vertexSampler[i] = tex->samplerState;
+                textureDescr.fragmentTexture[i] = tex->handle;
+                samplerDescr.fragmentSampler[i] = tex->samplerState;
             }
             else
             {
-                textureDescr.vertexTexture[i] = Renderer::GetRuntimeTextures().GetPinkTexture(vertexSamplerList[i].type);
-                samplerDescr.vertexSampler[i] = Renderer::GetRuntimeTextures().GetPinkTextureSamplerState(vertexSamplerList[i].type);
+                textureDescr.fragmentTexture[i] = Renderer::GetRuntimeTextures().GetPinkTexture(fragmentSamplerList[i].type);
+                samplerDescr.fragmentSampler[i] = Renderer::GetRuntimeTextures().GetPinkTextureSamplerState(fragmentSamplerList[i].type);
+
+                Logger::FrameworkDebug(" no texture for slot : %s", fragmentSamplerList[i].uid.c_str());
             }
         }
+        else
+        {
+            textureDescr.fragmentTexture[i] = Renderer::GetRuntimeTextures().GetDynamicTexture(textureSemantic);
+            samplerDescr.fragmentSampler[i] = Renderer::GetRuntimeTextures().GetDynamicTextureSamplerState(textureSemantic);
+        }
+        samplerDescr.fragmentSampler[i].anisotropyLevel = anisotropyLevel;
+        DVASSERT(textureDescr.fragmentTexture[i].IsValid());
+    }
 
-        currRenderVariant->textureSet = rhi::AcquireTextureSet(textureDescr);
-        currRenderVariant->samplerState = rhi::AcquireSamplerState(samplerDescr);
+    textureDescr.vertexTextureCount = static_cast<uint32>(vertexSamplerList.size());
+    samplerDescr.vertexSamplerCount = static_cast<uint32>(vertexSamplerList.size());
+    for (size_t i = 0, sz = textureDescr.vertexTextureCount; i < sz; ++i)
+    {
+        Texture* tex = GetEffectiveTexture(vertexSamplerList[i].uid);
+        if (tex)
+        {
+            textureDescr.vertexTexture[i] = tex->handle;
+            samplerDescr.vertexSampler[i] = tex->samplerState;
+        }
+        else
+        {
+            textureDescr.vertexTexture[i] = Renderer::GetRuntimeTextures().GetPinkTexture(vertexSamplerList[i].type);
+            samplerDescr.vertexSampler[i] = Renderer::GetRuntimeTextures().GetPinkTextureSamplerState(vertexSamplerList[i].type);
+        }
     }
 
-    needRebuildTextures = false;
+    currRenderVariant->textureSet = rhi::AcquireTextureSet(textureDescr);
+    currRenderVariant->samplerState = rhi::AcquireSamplerState(samplerDescr);
 }
 
 bool NMaterial::PreBuildMaterial(const FastName& passName)
@@ -1098,6 +1185,32 @@ bool NMaterial::PreBuildMaterial(const FastName& passName)
     return res;
 }
 
+bool NMaterial::PreBuildMaterialConcurrently(const FastName& passName, bool& prebuilt, uint32& renderLayerID)
+{
+    LockGuard<Spinlock> guard(preBuildLock);
+    if (needRebuildVariants || needRebuildBindings || needRebuildTextures)
+        return false;
+
+    prebuilt = (activeVariantInstance != nullptr) && (activeVariantInstance->shader->IsValid());
+    if (activeVariantName != passName)
+    {
+        auto it = renderVariants.find(passName);
+        if (it != renderVariants.end())
+        {
+            activeVariantName = passName;
+            activeVariantInstance = it->second;
+
+            prebuilt = (activeVariantInstance->shader->IsValid());
+        }
+        else
+        {
+            prebuilt = false;
+        }
+    }
+    renderLayerID = GetRenderLayerID();
+    return true;
+}
+
 NMaterial* NMaterial::Clone()
 {
     DAVA_MEMORY_PROFILER_CLASS_ALLOC_SCOPE();
@@ -7,6 +7,7 @@
 #include "NMaterialStateDynamicPropertiesInsp.h"
 #include "NMaterialStateDynamicTexturesInsp.h"
 #include "Render/Shader.h"
+#include "Concurrency/Spinlock.h"
 #include "Scene3D/DataNode.h"
 
 #include "MemoryManager/MemoryProfiler.h"
@@ -14,6 +15,7 @@
 namespace DAVA
 {
 struct MaterialBufferBinding;
+struct RenderPassDescriptor;
 
 struct NMaterialProperty
 {
@@ -178,16 +180,29 @@ public:
 
     void BindParams(rhi::Packet& target);
 
+    // instanced variant of active pass is compiled with FLAG_WORLD_INSTANCING and takes world matrices from per-instance vertex stream
+    // it is built on first request; returns its shader or nullptr if FX of active pass doesn't support instancing
+    ShaderDescriptor* PreBuildInstancedVariant();
+    void BindInstancedParams(rhi::Packet& target);
+
     // returns true if has variant for this pass, false otherwise
     // if material doesn't support pass active variant will be not changed
     // later add engine flags here
     bool PreBuildMaterial(const FastName& passName);
 
+    // thread-safe version of PreBuildMaterial for materials which don't need to be rebuilt
+    // returns false if material needs rebuild - in this case PreBuildMaterial should be called from main thread
+    // otherwise selects variant for pass, stores PreBuildMaterial result in `prebuilt` and active render layer in `renderLayerID`
+    bool PreBuildMaterialConcurrently(const FastName& passName, bool& prebuilt, uint32& renderLayerID);
+
     // RHI_COMPLETE - it's temporary solution to avoid FX loading and shaders compilation after loading
     void PreCacheFX();
     void PreCacheFXWithFlags(const UnorderedMap<FastName, int32>& extraFlags, const FastName& extraFxName = FastName());
     void PreCacheFXVariations(const Vector<FastName>& fxNames, const Vector<FastName>& flags);
 
+    // collects flags FX of material is built with, runtime-only illumination flags are excluded
+    void CollectFXFlags(UnorderedMap<FastName, int32>& flags);
+
     static const float32 DEFAULT_LIGHTMAP_SIZE;
 
     enum eUserFlag
@@ -205,6 +220,13 @@ private:
     void RebuildTextureBindings();
     void RebuildRenderVariants();
 
+    RenderVariantInstance* CreateRenderVariant(const RenderPassDescriptor& variantDescr);
+    void RebuildVariantBindings(RenderVariantInstance* variant);
+    void RebuildVariantTextureBindings(RenderVariantInstance* variant, uint32 anisotropyLevel);
+    void BindVariantParams(RenderVariantInstance* variant, rhi::Packet& target);
+    void ClearInstancedVariants();
+    uint32 GetAnisotropyLevel() const;
+
     bool NeedLocalOverride(UniquePropertyLayout propertyLayout);
     void ClearLocalBuffers();
     void InjectChildBuffer(UniquePropertyLayout propLayoutId, MaterialBufferBinding* buffer);
@@ -243,7 +265,11 @@ private:
     // this is for render passes - not used right now - only active variant instance
     UnorderedMap<FastName, RenderVariantInstance*> renderVariants;
 
+    // instanced variants of render passes, nullptr is stored for passes which don't support instancing
+    UnorderedMap<FastName, RenderVariantInstance*> instancedVariants;
+
     uint32 sortingKey = 0;
+    Spinlock preBuildLock;
     bool needRebuildBindings = true;
     bool needRebuildTextures = true;
     bool needRebuildVariants = true;
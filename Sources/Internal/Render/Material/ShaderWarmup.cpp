@@ -0,0 +1,158 @@
+#include "Render/Material/ShaderWarmup.h"
+#include "Render/Material/NMaterial.h"
+#include "Render/Material/NMaterialNames.h"
+#include "Render/Material/FXCache.h"
+#include "Render/Highlevel/RenderObject.h"
+#include "Render/Highlevel/RenderBatch.h"
+#include "Render/ShaderCache.h"
+#include "Render/RenderOptions.h"
+#include "Render/Renderer.h"
+#include "Scene3D/Entity.h"
+#include "Scene3D/Components/ComponentHelpers.h"
+#include "Scene3D/Systems/QualitySettingsSystem.h"
+#include "UI/UIControl.h"
+#include "UI/UIControlBackground.h"
+#include "Engine/Engine.h"
+#include "Job/JobManager.h"
+#include "Debug/ProfilerCPU.h"
+#include "Debug/ProfilerMarkerNames.h"
+#include "Logger/Logger.h"
+
+#include <atomic>
+
+namespace DAVA
+{
+void ShaderWarmup::AddMaterial(NMaterial* material)
+{
+    AddMaterialFlags(material, UnorderedMap<FastName, int32>());
+}
+
+void ShaderWarmup::AddMaterialFlags(NMaterial* material, const UnorderedMap<FastName, int32>& extraFlags)
+{
+    if (material == nullptr || !material->GetEffectiveFXName().IsValid())
+        return;
+
+    FXVariant variant;
+    variant.fxName = material->GetEffectiveFXName();
+    material->CollectFXFlags(variant.flags);
+    for (const auto& flag : extraFlags)
+        variant.flags[flag.first] = flag.second;
+
+    QualitySettingsSystem* qualitySystem = QualitySettingsSystem::Instance();
+    const FastName& qualityGroup = material->GetQualityGroup();
+
+    Vector<FastName> qualities;
+    size_t qualityCount = qualityGroup.IsValid() ? qualitySystem->GetMaterialQualityCount(qualityGroup) : 0;
+    for (size_t i = 0; i < qualityCount; ++i)
+        qualities.push_back(qualitySystem->GetMaterialQualityName(qualityGroup, i));
+    if (qualities.empty())
+        qualities.push_back(qualitySystem->GetCurMaterialQuality(qualityGroup));
+
+    for (const FastName& quality : qualities)
+    {
+        Vector<size_t> key = ShaderDescriptorCache::BuildFlagsKey(variant.fxName, variant.flags);
+        if (quality.IsValid())
+            key.push_back(ShaderDescriptorCache::GetUniqueFlagKey(quality));
+
+        variant.quality = quality;
+        variants.emplace(std::move(key), variant);
+    }
+}
+
+void ShaderWarmup::AddEntity(Entity* entity)
+{
+    RenderObject* renderObject = GetRenderObject(entity);
+    if (renderObject != nullptr)
+    {
+        //meshes can be drawn with instanced variant of material, see RenderLayer
+        UnorderedMap<FastName, int32> instancingFlags;
+        instancingFlags[NMaterialFlagName::FLAG_WORLD_INSTANCING] = 1;
+        bool canBeInstanced = (renderObject->GetType() == RenderObject::TYPE_MESH) && Renderer::GetOptions()->IsOptionEnabled(RenderOptions::DYNAMIC_INSTANCING);
+
+        for (uint32 i = 0; i < renderObject->GetRenderBatchCount(); ++i)
+        {
+            NMaterial* material = renderObject->GetRenderBatch(i)->GetMaterial();
+            AddMaterial(material);
+            if (canBeInstanced)
+                AddMaterialFlags(material, instancingFlags);
+        }
+    }
+
+    for (int32 i = 0; i < entity->GetChildrenCount(); ++i)
+    {
+        AddEntity(entity->GetChild(i));
+    }
+}
+
+void ShaderWarmup::AddControl(UIControl* control)
+{
+    for (uint32 i = 0; i < control->GetComponentCount<UIControlBackground>(); ++i)
+    {
+        AddMaterial(control->GetComponent<UIControlBackground>(i)->GetMaterial());
+    }
+
+    for (const RefPtr<UIControl>& child : control->GetChildren())
+    {
+        AddControl(child.Get());
+    }
+}
+
+void ShaderWarmup::Clear()
+{
+    variants.clear();
+}
+
+ShaderWarmup::Stats ShaderWarmup::Build()
+{
+    DAVA_PROFILER_CPU_SCOPE(ProfilerCPUMarkerName::RENDER_SHADER_WARMUP);
+
+    Stats stats;
+    stats.fxCount = static_cast<uint32>(variants.size());
+
+    //collect unique shaders of all passes of all variants
+    Map<Vector<size_t>, ShaderVariantDescriptor> uniqueShaders;
+    Vector<ShaderVariantDescriptor> fxShaders;
+    for (const auto& it : variants)
+    {
+        fxShaders.clear();
+        FXCache::GetShaderVariants(it.second.fxName, it.second.flags, it.second.quality, fxShaders);
+        for (ShaderVariantDescriptor& shader : fxShaders)
+        {
+            Vector<size_t> key = ShaderDescriptorCache::BuildFlagsKey(shader.shaderFileName, shader.defines);
+            uniqueShaders.emplace(std::move(key), std::move(shader));
+        }
+    }
+
+    Vector<const ShaderVariantDescriptor*> shaders;
+    shaders.reserve(uniqueShaders.size());
+    for (const auto& it : uniqueShaders)
+        shaders.push_back(&it.second);
+    stats.shaderCount = static_cast<uint32>(shaders.size());
+
+    //parsing and code generation is the most expensive part, it doesn't touch render api
+    std::atomic<uint32> failedCount(0);
+    auto prebuildSources = [&shaders, &failedCount](uint32 begin, uint32 end) {
+        for (uint32 i = begin; i < end; ++i)
+        {
+            if (!ShaderDescriptorCache::PrebuildShaderSources(shaders[i]->shaderFileName, shaders[i]->defines))
+                ++failedCount;
+        }
+    };
+
+    JobManager* jobManager = GetEngineContext()->jobManager;
+    if (jobManager != nullptr)
+        jobManager->ParallelFor(0, stats.shaderCount, 1, prebuildSources);
+    else
+        prebuildSources(0, stats.shaderCount);
+    stats.failedShaderCount = failedCount;
+
+    //FX descriptors and pipeline states are created on calling thread from already cached sources
+    for (auto& it : variants)
+    {
+        FXCache::GetFXDescriptor(it.second.fxName, it.second.flags, it.second.quality);
+    }
+
+    Logger::Info("[ShaderWarmup] %u fx variants, %u shaders, %u failed", stats.fxCount, stats.shaderCount, stats.failedShaderCount);
+    return stats;
+}
+}
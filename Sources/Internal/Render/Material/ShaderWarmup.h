@@ -0,0 +1,59 @@
+#pragma once
+
+#include "Base/BaseTypes.h"
+#include "Base/FastName.h"
+
+namespace DAVA
+{
+class Entity;
+class NMaterial;
+class UIControl;
+
+/**
+    Collects FX variants (fx name, material flags and quality) which materials of scenes and UI controls can request
+    and builds them ahead of first use.
+
+    `Build` parses shader sources of all collected variants on worker threads into rhi::ShaderSourceCache,
+    then creates FX descriptors and shaders on calling thread. Results can be persisted with
+    rhi::ShaderSourceCache::Save and FXCache::Save and are restored on next launch instead of being built on first use.
+*/
+class ShaderWarmup
+{
+public:
+    struct Stats
+    {
+        uint32 fxCount = 0;
+        uint32 shaderCount = 0;
+        uint32 failedShaderCount = 0;
+    };
+
+    /** Add variants of material for every quality of its quality group. */
+    void AddMaterial(NMaterial* material);
+    /** Add materials of render objects of `entity` and its children. */
+    void AddEntity(Entity* entity);
+    /** Add materials of backgrounds of `control` and its children. */
+    void AddControl(UIControl* control);
+
+    uint32 GetVariantCount() const;
+    void Clear();
+
+    Stats Build();
+
+private:
+    struct FXVariant
+    {
+        FastName fxName;
+        FastName quality;
+        UnorderedMap<FastName, int32> flags;
+    };
+
+    void AddMaterialFlags(NMaterial* material, const UnorderedMap<FastName, int32>& extraFlags);
+
+    Map<Vector<size_t>, FXVariant> variants;
+};
+
+inline uint32 ShaderWarmup::GetVariantCount() const
+{
+    return static_cast<uint32>(variants.size());
+}
+}
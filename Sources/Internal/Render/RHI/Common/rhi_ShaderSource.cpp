@@ -139,6 +139,7 @@ private:
 };
 
 static ShaderFileCallback ShaderSourceFileCallback("~res:/Materials/Shaders");
+static Mutex ShaderSourceFileCallbackMutex; // file callback caches includes and keeps current file, so preprocessing is serialized
 
 //==============================================================================
 
@@ -182,7 +183,13 @@ bool ShaderSource::Construct(ProgType progType, const char* srcText, const std::
         pre_proc.AddDefine(name, value);
     }
 
-    if (pre_proc.Process(srcText, &src))
+    bool preprocessed = false;
+    {
+        LockGuard<Mutex> guard(ShaderSourceFileCallbackMutex);
+        preprocessed = pre_proc.Process(srcText, &src);
+    }
+
+    if (preprocessed)
     {
         #if RHI_DUMP_SHADERSOURCE
         {
@@ -257,7 +264,7 @@ bool ShaderSource::Construct(ProgType progType, const char* srcText, const std::
                 InlineFunctions();
 
             // ugly workaround to save some memory
-            GetSourceCode(HostApi());
+            GetSourceCode(ShaderSourceCache::TargetApi());
             delete ast;
             ast = nullptr;
         }
@@ -1742,10 +1749,12 @@ const DAVA::String& ShaderSource::GetSourceCode(Api targetApi) const
 
     if (code[targetApi].empty() && (ast != nullptr))
     {
-        static sl::Allocator alloc;
-        static sl::HLSLGenerator hlsl_gen(&alloc);
-        static sl::GLESGenerator gles_gen(&alloc);
-        static sl::MSLGenerator mtl_gen(&alloc);
+        // generators keep output state while generating and sources are constructed on several threads
+        // by shader warm-up, so generator is created per call (it's cheap, allocator is stateless)
+        sl::Allocator alloc;
+        sl::HLSLGenerator hlsl_gen(&alloc);
+        sl::GLESGenerator gles_gen(&alloc);
+        sl::MSLGenerator mtl_gen(&alloc);
 
         bool codeGenerated = false;
         const char* main = (type == PROG_VERTEX) ? "vp_main" : "fp_main";
@@ -1898,11 +1907,13 @@ void ShaderSource::Reset()
 
 void ShaderSource::AddIncludeDirectory(const char* dir)
 {
+    LockGuard<Mutex> guard(ShaderSourceFileCallbackMutex);
     ShaderSourceFileCallback.AddIncludeDirectory(dir);
 }
 
 void ShaderSource::PurgeIncludesCache()
 {
+    LockGuard<Mutex> guard(ShaderSourceFileCallbackMutex);
     ShaderSourceFileCallback.ClearCache();
 }
 
@@ -2022,6 +2033,17 @@ const uint32 ShaderSourceCache::FormatVersion = 8;
 
 Mutex shaderSourceEntryMutex;
 std::vector<ShaderSourceCache::entry_t> ShaderSourceCache::Entry;
+uint32 ShaderSourceCache::TargetApiOverride = RHI_API_COUNT;
+
+void ShaderSourceCache::SetTargetApi(Api api)
+{
+    TargetApiOverride = api;
+}
+
+Api ShaderSourceCache::TargetApi()
+{
+    return (TargetApiOverride < RHI_API_COUNT) ? Api(TargetApiOverride) : HostApi();
+}
 
 const ShaderSource* ShaderSourceCache::Get(FastName uid, uint32 srcHash)
 {
@@ -2030,7 +2052,7 @@ const ShaderSource* ShaderSourceCache::Get(FastName uid, uint32 srcHash)
     //    Logger::Info("get-shader-src (host-api = %i)",HostApi());
     //    Logger::Info("  uid= \"%s\"",uid.c_str());
     const ShaderSource* src = nullptr;
-    Api api = HostApi();
+    Api api = TargetApi();
 
     for (std::vector<entry_t>::const_iterator e = Entry.begin(), e_end = Entry.end(); e != e_end; ++e)
     {
@@ -2054,7 +2076,7 @@ const ShaderSource* ShaderSourceCache::Add(const char* filename, FastName uid, P
     {
         LockGuard<Mutex> guard(shaderSourceEntryMutex);
 
-        uint32 api = HostApi();
+        uint32 api = TargetApi();
         uint32 srcHash = DAVA::HashValue_N(srcText, unsigned(strlen(srcText)));
 
         bool doAdd = true;
@@ -127,6 +127,10 @@ public:
     static void Save(const char* fileName);
     static void Load(const char* fileName);
 
+    // offline tools (running on null renderer) can generate and cache code for another api instead of host one
+    static void SetTargetApi(Api api);
+    static Api TargetApi();
+
 private:
     struct
     entry_t
@@ -139,6 +143,7 @@ private:
 
     static std::vector<entry_t> Entry;
     static const uint32 FormatVersion;
+    static uint32 TargetApiOverride;
 };
 
 } // namespace rhi
@@ -45,7 +45,10 @@ FastName optionsNames[RenderOptions::OPTIONS_COUNT] =
   FastName("Draw Nondef Glyph"),
   FastName("Highlight Hard Controls"),
   FastName("Debug Draw Rich Items"),
-  FastName("Debug Draw Particles")
+  FastName("Debug Draw Particles"),
+
+  FastName("Dynamic Instancing"),
+  FastName("Software Occlusion Culling")
 };
 
 RenderOptions::RenderOptions()
@@ -69,6 +72,7 @@ RenderOptions::RenderOptions()
     options[DEBUG_DRAW_RICH_ITEMS] = false;
 
     options[DEBUG_DRAW_PARTICLES] = false;
+    options[SOFTWARE_OCCLUSION_CULLING] = false;
 }
 
 bool RenderOptions::IsOptionEnabled(RenderOption option)
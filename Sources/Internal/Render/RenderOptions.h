@@ -56,6 +56,9 @@ public:
 
         DEBUG_DRAW_PARTICLES,
 
+        DYNAMIC_INSTANCING,
+        SOFTWARE_OCCLUSION_CULLING,
+
         OPTIONS_COUNT
     };
 
@@ -70,6 +70,17 @@ public:
         return requiredVertexFormat;
     }
 
+    const rhi::VertexLayout& GetVertexLayout() const
+    {
+        return vertexLayout;
+    }
+
+    /** Return true if shader reads some vertex input per instance. */
+    bool HasInstanceStream() const
+    {
+        return (vertexLayout.StreamCount() > 1) && (vertexLayout.StreamFrequency(vertexLayout.StreamCount() - 1) == rhi::VDF_PER_INSTANCE);
+    }
+
     const Vector<ConstBufferDescriptor>& GetConstBufferDescriptors() const
     {
         return constBuffers;
@@ -102,6 +113,7 @@ private:
     rhi::HPipelineState piplineState;
 
     uint32 requiredVertexFormat;
+    rhi::VertexLayout vertexLayout;
 
     rhi::ShaderSamplerList fragmentSamplerList;
     rhi::ShaderSamplerList vertexSamplerList;
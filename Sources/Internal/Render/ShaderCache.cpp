@@ -189,20 +189,9 @@ void SetLoadingNotifyEnabled(bool enable)
 #define LOG_TRACE_USAGE(...)
 #endif
 
-ShaderDescriptor* GetShaderDescriptor(const FastName& name, const UnorderedMap<FastName, int32>& defines)
+void BuildProgramDefines(const FastName& name, const UnorderedMap<FastName, int32>& defines, Vector<String>& progDefines, FastName& vProgUid, FastName& fProgUid)
 {
-    DVASSERT(initialized);
-
-    LockGuard<Mutex> guard(shaderCacheMutex);
-
-    Vector<size_t> key = BuildFlagsKey(name, defines);
-
-    auto descriptorIt = shaderDescriptors.find(key);
-    if (descriptorIt != shaderDescriptors.end())
-        return descriptorIt->second;
-
-    //not found - create new shader
-    Vector<String> progDefines;
+    progDefines.clear();
     progDefines.reserve(defines.size() * 2);
     String resName(name.c_str());
     resName += "  defines: ";
@@ -231,14 +220,60 @@ ShaderDescriptor* GetShaderDescriptor(const FastName& name, const UnorderedMap<F
     for (size_t i = 0; i != progDefines.size(); i += 2)
         resName += Format("%s = %s, ", progDefines[i + 0].c_str(), progDefines[i + 1].c_str());
 
-    if (loadingNotifyEnabled)
+    vProgUid = FastName(String("vSource: ") + resName);
+    fProgUid = FastName(String("fSource: ") + resName);
+}
+
+bool PrebuildShaderSources(const FastName& name, const UnorderedMap<FastName, int32>& defines)
+{
+    DVASSERT(initialized);
+
+    Vector<String> progDefines;
+    FastName vProgUid, fProgUid;
+    BuildProgramDefines(name, defines, progDefines, vProgUid, fProgUid);
+
+    ShaderSourceCode sourceCode;
     {
-        Logger::Error("Forbidden call to GetShaderDescriptor %s", resName.c_str());
+        LockGuard<Mutex> guard(shaderCacheMutex);
+        if (shaderDescriptors.find(BuildFlagsKey(name, defines)) != shaderDescriptors.end())
+            return true;
+
+        sourceCode = GetSourceCode(name);
     }
 
+    //sources are parsed without holding cache lock, so several sources can be built concurrently
+    const rhi::ShaderSource* vSource = rhi::ShaderSourceCache::Get(vProgUid, sourceCode.vSrcHash);
+    if (vSource == nullptr)
+        vSource = rhi::ShaderSourceCache::Add(sourceCode.vertexProgSourcePath.GetFrameworkPath().c_str(), vProgUid, rhi::PROG_VERTEX, sourceCode.vertexProgText.data(), progDefines);
+
+    const rhi::ShaderSource* fSource = rhi::ShaderSourceCache::Get(fProgUid, sourceCode.fSrcHash);
+    if (fSource == nullptr)
+        fSource = rhi::ShaderSourceCache::Add(sourceCode.fragmentProgSourcePath.GetFrameworkPath().c_str(), fProgUid, rhi::PROG_FRAGMENT, sourceCode.fragmentProgText.data(), progDefines);
+
+    return (vSource != nullptr) && (fSource != nullptr);
+}
+
+ShaderDescriptor* GetShaderDescriptor(const FastName& name, const UnorderedMap<FastName, int32>& defines)
+{
+    DVASSERT(initialized);
+
+    LockGuard<Mutex> guard(shaderCacheMutex);
+
+    Vector<size_t> key = BuildFlagsKey(name, defines);
+
+    auto descriptorIt = shaderDescriptors.find(key);
+    if (descriptorIt != shaderDescriptors.end())
+        return descriptorIt->second;
+
+    //not found - create new shader
+    Vector<String> progDefines;
     FastName vProgUid, fProgUid;
-    vProgUid = FastName(String("vSource: ") + resName);
-    fProgUid = FastName(String("fSource: ") + resName);
+    BuildProgramDefines(name, defines, progDefines, vProgUid, fProgUid);
+
+    if (loadingNotifyEnabled)
+    {
+        Logger::Error("Forbidden call to GetShaderDescriptor %s", vProgUid.c_str());
+    }
 
     ShaderSourceCode sourceCode = GetSourceCode(name);
     const uint32 vSrcHash = HashValue_N(sourceCode.vertexProgText.data(), static_cast<uint32>(strlen(sourceCode.vertexProgText.data())));
@@ -330,6 +365,7 @@ ShaderDescriptor* GetShaderDescriptor(const FastName& name, const UnorderedMap<F
     {
         res->UpdateConfigFromSource(const_cast<rhi::ShaderSource*>(vSource), const_cast<rhi::ShaderSource*>(fSource));
         res->requiredVertexFormat = GetVertexLayoutRequiredFormat(psDesc.vertexLayout);
+        res->vertexLayout = psDesc.vertexLayout;
     }
     else
     {
@@ -387,10 +423,12 @@ void ReloadShaders()
         {
             shader->UpdateConfigFromSource(&vSource, &fSource);
             shader->requiredVertexFormat = GetVertexLayoutRequiredFormat(psDesc.vertexLayout);
+            shader->vertexLayout = psDesc.vertexLayout;
         }
         else
         {
             shader->requiredVertexFormat = 0;
+            shader->vertexLayout.Clear();
         }
     }
 }
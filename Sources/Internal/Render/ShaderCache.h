@@ -17,6 +17,9 @@ void ReloadShaders();
 
 void SetLoadingNotifyEnabled(bool enable);
 ShaderDescriptor* GetShaderDescriptor(const FastName& name, const UnorderedMap<FastName, int32>& defines);
+
+// parse sources of shader into rhi::ShaderSourceCache without creating pipeline state, can be called from any thread
+bool PrebuildShaderSources(const FastName& name, const UnorderedMap<FastName, int32>& defines);
 Vector<size_t> BuildFlagsKey(const FastName& name, const UnorderedMap<FastName, int32>& defines);
 size_t GetUniqueFlagKey(FastName flagName);
 };
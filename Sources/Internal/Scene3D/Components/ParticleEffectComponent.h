@@ -81,6 +81,8 @@ public:
 
     inline eState GetAnimationState() const;
     inline ParticleRenderObject* GetRenderObject() const;
+    /** Return groups of particles simulated by ParticleEffectSystem. */
+    inline const ParticleEffectData& GetEffectData() const;
 
     void ReloadEmitters();
 
@@ -166,4 +168,9 @@ ParticleRenderObject* ParticleEffectComponent::GetRenderObject() const
 {
     return effectRenderObject;
 }
+
+const ParticleEffectData& ParticleEffectComponent::GetEffectData() const
+{
+    return effectData;
+}
 }
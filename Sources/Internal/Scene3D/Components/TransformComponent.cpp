@@ -1,5 +1,6 @@
 #include "Scene3D/Components/TransformComponent.h"
 
+#include "FileSystem/FlatKeyedArchive.h"
 #include "Math/TransformUtils.h"
 #include "Reflection/ReflectedMeta.h"
 #include "Reflection/ReflectionRegistrator.h"
@@ -9,6 +10,18 @@
 
 namespace DAVA
 {
+namespace TransformComponentDetails
+{
+const FastName LOCAL_MATRIX_KEY("tc.localMatrix");
+const FastName WORLD_MATRIX_KEY("tc.worldMatrix");
+const FastName LOCAL_TRANSLATION_KEY("tc.localTranslation");
+const FastName LOCAL_SCALE_KEY("tc.localScale");
+const FastName LOCAL_ROTATION_KEY("tc.localRotation");
+const FastName WORLD_TRANSLATION_KEY("tc.worldTranslation");
+const FastName WORLD_SCALE_KEY("tc.worldScale");
+const FastName WORLD_ROTATION_KEY("tc.worldRotation");
+}
+
 DAVA_VIRTUAL_REFLECTION_IMPL(TransformComponent)
 {
     ReflectionRegistrator<TransformComponent>::Begin()[M::CantBeCreatedManualyComponent(), M::CantBeDeletedManualyComponent(), M::DeveloperModeOnly()]
@@ -136,6 +149,30 @@ void TransformComponent::Deserialize(KeyedArchive* archive, SerializationContext
     Component::Deserialize(archive, sceneFile);
 }
 
+void TransformComponent::DeserializeFlat(const FlatKeyedArchive* archive, SerializationContext* sceneFile)
+{
+    using namespace TransformComponentDetails;
+
+    if (nullptr != archive)
+    {
+        if (archive->IsKeyExists(LOCAL_MATRIX_KEY))
+        {
+            localTransform = Transform(archive->GetMatrix4(LOCAL_MATRIX_KEY, Matrix4::IDENTITY));
+            worldTransform = Transform(archive->GetMatrix4(WORLD_MATRIX_KEY, Matrix4::IDENTITY));
+        }
+        else
+        {
+            localTransform.SetTranslation(archive->GetVector3(LOCAL_TRANSLATION_KEY, Vector3::Zero));
+            localTransform.SetScale(archive->GetVector3(LOCAL_SCALE_KEY, Vector3(1.f, 1.f, 1.f)));
+            localTransform.SetRotation(archive->GetVector4(LOCAL_ROTATION_KEY, Quaternion::Identity.data).data);
+            worldTransform.SetTranslation(archive->GetVector3(WORLD_TRANSLATION_KEY, Vector3::Zero));
+            worldTransform.SetScale(archive->GetVector3(WORLD_SCALE_KEY, Vector3(1.f, 1.f, 1.f)));
+            worldTransform.SetRotation(archive->GetVector4(WORLD_ROTATION_KEY, Quaternion::Identity.data).data);
+        }
+        worldMatrix = TransformUtils::ToMatrix(worldTransform);
+    }
+}
+
 void TransformComponent::MarkLocalChanged()
 {
     if (entity && entity->GetScene() && entity->GetScene()->transformSingleComponent)
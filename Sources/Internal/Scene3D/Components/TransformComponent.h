@@ -36,6 +36,7 @@ public:
     Component* Clone(Entity* toEntity) override;
     void Serialize(KeyedArchive* archive, SerializationContext* serializationContext) override;
     void Deserialize(KeyedArchive* archive, SerializationContext* serializationContext) override;
+    void DeserializeFlat(const FlatKeyedArchive* archive, SerializationContext* serializationContext) override;
 
 private:
     void MarkLocalChanged();
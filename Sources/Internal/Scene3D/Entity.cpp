@@ -4,6 +4,7 @@
 #include "Base/ObjectFactory.h"
 #include "Render/RenderHelper.h"
 #include "FileSystem/FileSystem.h"
+#include "FileSystem/FlatKeyedArchive.h"
 #include "FileSystem/KeyedArchive.h"
 #include "Utils/Random.h"
 #include "Utils/StringFormat.h"
@@ -558,6 +559,55 @@ void Entity::LoadComponentsV7(KeyedArchive* compsArch, SerializationContext* ser
     }
 }
 
+void Entity::LoadFlat(const FlatKeyedArchive* archive, SerializationContext* serializationContext)
+{
+    static const FastName NAME_KEY("name");
+    static const FastName ID_KEY("id");
+    static const FastName FLAGS_KEY("flags");
+    static const FastName COMPONENTS_KEY("components");
+    static const FastName COUNT_KEY("count");
+    static const FastName TYPENAME_KEY("comp.typename");
+
+    name = FastName(archive->GetString(NAME_KEY, "").c_str());
+    id = archive->GetUInt32(ID_KEY, 0);
+    if (nullptr != serializationContext->GetScene())
+    {
+        sceneId = serializationContext->GetScene()->GetSceneID();
+    }
+
+    flags = archive->GetUInt32(FLAGS_KEY, NODE_VISIBLE);
+    flags &= ~TRANSFORM_DIRTY;
+
+    RefPtr<FlatKeyedArchive> compsArch = archive->GetArchive(COMPONENTS_KEY);
+    if (compsArch)
+    {
+        uint32 componentCount = compsArch->GetUInt32(COUNT_KEY);
+        for (uint32 i = 0; i < componentCount; ++i)
+        {
+            // same key as KeyedArchive::GenKeyFromIndex, which uses shared static buffer
+            char8 indexKey[16];
+            snprintf(indexKey, sizeof(indexKey), "%04u", i);
+
+            RefPtr<FlatKeyedArchive> compArch = compsArch->GetArchive(FastName(indexKey));
+            if (compArch)
+            {
+                String componentType = compArch->GetString(TYPENAME_KEY);
+                Component* comp = ObjectFactory::Instance()->New<Component>(componentType);
+                if (nullptr != comp)
+                {
+                    if (comp->GetType()->Is<TransformComponent>())
+                    {
+                        RemoveComponent(comp->GetType());
+                    }
+
+                    AddComponent(comp);
+                    comp->DeserializeFlat(compArch.Get(), serializationContext);
+                }
+            }
+        }
+    }
+}
+
 void Entity::SetSolid(bool isSolid)
 {
     KeyedArchive* props = GetOrCreateCustomProperties(this)->GetArchive();
@@ -20,6 +20,7 @@ class SceneNodeAnimationKey;
 class SceneFileV2;
 class DataNode;
 class RenderComponent;
+class FlatKeyedArchive;
 
 /**
     \brief Base class of 3D scene hierarchy. All nodes in our scene graph is inherited from this node.
@@ -218,6 +219,11 @@ public:
      */
     virtual void Load(KeyedArchive* archive, SerializationContext* serializationContext);
 
+    /**
+        \brief Load node from archive written by `Save`, components are deserialized with Component::DeserializeFlat.
+     */
+    void LoadFlat(const FlatKeyedArchive* archive, SerializationContext* serializationContext);
+
     /**
         \brief This function should be implemented in each node that have data nodes inside it.
      */
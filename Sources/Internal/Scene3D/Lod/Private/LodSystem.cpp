@@ -1,5 +1,6 @@
 #include "Scene3D/Lod/LodSystem.h"
 #include "Debug/DVAssert.h"
+#include "Entity/ComponentUtils.h"
 #include "Scene3D/Entity.h"
 #include "Scene3D/Components/RenderComponent.h"
 #include "Scene3D/Components/TransformComponent.h"
@@ -21,6 +22,9 @@ LodSystem::LodSystem(Scene* scene)
     scene->GetEventSystem()->RegisterSystemForEvent(this, EventSystem::STOP_PARTICLE_EFFECT);
     scene->GetEventSystem()->RegisterSystemForEvent(this, EventSystem::LOD_DISTANCE_CHANGED);
     scene->GetEventSystem()->RegisterSystemForEvent(this, EventSystem::LOD_RECURSIVE_UPDATE_ENABLED);
+
+    SetComponentsAccess(ComponentUtils::MakeMask<LodComponent, TransformComponent, RenderComponent, ParticleEffectComponent>(),
+                        ComponentUtils::MakeMask<LodComponent, RenderComponent, ParticleEffectComponent>());
 }
 
 void LodSystem::Process(float32 timeElapsed)
@@ -1,7 +1,15 @@
 #include "UnitTests/UnitTests.h"
 #include "Scene3D/Scene.h"
+#include "Engine/Engine.h"
+#include "Engine/EngineContext.h"
+#include "Concurrency/Atomic.h"
 #include "Entity/SceneSystem.h"
 #include "Entity/SingletonComponent.h"
+#include "Entity/SceneSystemScheduler.h"
+#include "Entity/ComponentUtils.h"
+#include "Scene3D/Components/TransformComponent.h"
+#include "Scene3D/Components/WaveComponent.h"
+#include "Scene3D/Components/WindComponent.h"
 
 using namespace DAVA;
 
@@ -18,6 +26,27 @@ public:
     }
 };
 
+class MyAccessSystem : public SceneSystem
+{
+public:
+    MyAccessSystem(Scene* scene, const ComponentMask& read, const ComponentMask& write)
+        : SceneSystem(scene)
+    {
+        SetComponentsAccess(read, write);
+    }
+
+    void PrepareForRemove() override
+    {
+    }
+
+    void Process(float32 timeElapsed) override
+    {
+        processedCount++;
+    }
+
+    Atomic<uint32> processedCount{ 0 };
+};
+
 class MyComponent : public SingletonComponent
 {
 };
@@ -69,4 +98,53 @@ DAVA_TESTCLASS (SceneTest)
         scene->RemoveSingletonComponent(myComponent);
         TEST_VERIFY(scene->GetSingletonComponent<MyComponent>() == nullptr);
     }
-};
\ No newline at end of file
+
+    DAVA_TEST (SystemSchedulerStages)
+    {
+        ComponentMask transformMask = ComponentUtils::MakeMask<TransformComponent>();
+        ComponentMask waveMask = ComponentUtils::MakeMask<WaveComponent>();
+        ComponentMask windMask = ComponentUtils::MakeMask<WindComponent>();
+
+        MyAccessSystem transformWriter(nullptr, transformMask, transformMask);
+        MyAccessSystem waveWriter(nullptr, transformMask, waveMask);
+        MyAccessSystem windWriter(nullptr, transformMask, windMask);
+        MyAccessSystem waveReader(nullptr, waveMask, ComponentMask());
+        Mysystem barrier(nullptr);
+
+        TEST_VERIFY(SceneSystemScheduler::IsConflicting(&transformWriter, &waveWriter));
+        TEST_VERIFY(!SceneSystemScheduler::IsConflicting(&waveWriter, &windWriter));
+        TEST_VERIFY(SceneSystemScheduler::IsConflicting(&waveReader, &waveWriter));
+        TEST_VERIFY(SceneSystemScheduler::IsConflicting(&barrier, &waveReader));
+
+        Vector<SceneSystem*> systems = { &transformWriter, &waveWriter, &windWriter, &waveReader, &barrier, &windWriter };
+
+        SceneSystemScheduler scheduler;
+        const Vector<Vector<SceneSystem*>>& stages = scheduler.GetStages(systems);
+        TEST_VERIFY(stages.size() == 5);
+        TEST_VERIFY(stages[0] == Vector<SceneSystem*>({ &transformWriter }));
+        TEST_VERIFY(stages[1] == Vector<SceneSystem*>({ &waveWriter, &windWriter }));
+        TEST_VERIFY(stages[2] == Vector<SceneSystem*>({ &waveReader }));
+        TEST_VERIFY(stages[3] == Vector<SceneSystem*>({ &barrier }));
+        TEST_VERIFY(stages[4] == Vector<SceneSystem*>({ &windWriter }));
+    }
+
+    DAVA_TEST (SystemSchedulerParallelProcess)
+    {
+        ComponentMask waveMask = ComponentUtils::MakeMask<WaveComponent>();
+        ComponentMask windMask = ComponentUtils::MakeMask<WindComponent>();
+
+        MyAccessSystem waveWriter(nullptr, ComponentMask(), waveMask);
+        MyAccessSystem windWriter(nullptr, ComponentMask(), windMask);
+        Vector<SceneSystem*> systems = { &waveWriter, &windWriter };
+
+        SceneSystemScheduler scheduler;
+        auto processFn = [](SceneSystem* system) { system->Process(0.f); };
+        for (uint32 i = 0; i < 100; ++i)
+        {
+            scheduler.ProcessParallel(systems, processFn, GetEngineContext()->jobManager);
+        }
+
+        TEST_VERIFY(waveWriter.processedCount == 100);
+        TEST_VERIFY(windWriter.processedCount == 100);
+    }
+};
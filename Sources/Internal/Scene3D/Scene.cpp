@@ -3,8 +3,11 @@
 #include "Concurrency/Thread.h"
 #include "Debug/ProfilerCPU.h"
 #include "Debug/ProfilerMarkerNames.h"
+#include "Engine/Engine.h"
+#include "Engine/EngineContext.h"
 #include "Entity/ComponentUtils.h"
 #include "FileSystem/FileSystem.h"
+#include "FileSystem/KeyedArchive.h"
 #include "Render/3D/StaticMesh.h"
 #include "Render/Highlevel/Landscape.h"
 #include "Render/Highlevel/Light.h"
@@ -302,6 +305,11 @@ void Scene::CreateSystems()
         transformSystem = new TransformSystem(this);
         AddSystem(transformSystem, ComponentUtils::MakeMask<TransformComponent>(), SCENE_SYSTEM_REQUIRE_PROCESS);
 
+        // linear update rebuilds its arrays on every hierarchy change, so it can be disabled for scenes with highly dynamic hierarchy
+        Engine* engine = Engine::Instance();
+        bool linearTransformUpdate = (engine == nullptr) || engine->GetOptions()->GetBool("linear_transform_update", true);
+        transformSystem->SetLinearUpdateEnabled(linearTransformUpdate);
+
         transformSingleComponent = new TransformSingleComponent;
     }
 
@@ -690,7 +698,7 @@ void Scene::Update(float32 timeElapsed)
         fixedUpdate.lastTime -= fixedUpdate.constantTime;
     }
 
-    for (SceneSystem* system : systemsToProcess)
+    auto processSystem = [this, timeElapsed](SceneSystem* system)
     {
         if ((systemsMask & SCENE_SYSTEM_UPDATEBLE_FLAG) && system == transformSystem)
         {
@@ -709,6 +717,15 @@ void Scene::Update(float32 timeElapsed)
         {
             system->Process(timeElapsed);
         }
+    };
+
+    if (parallelSystemsProcessing)
+    {
+        systemScheduler.ProcessParallel(systemsToProcess, processSystem, GetEngineContext()->jobManager);
+    }
+    else
+    {
+        systemScheduler.ProcessSerial(systemsToProcess, processSystem);
     }
 
     if (transformSingleComponent)
@@ -726,6 +743,17 @@ void Scene::Update(float32 timeElapsed)
     sceneGlobalTime += timeElapsed;
 }
 
+void Scene::SetParallelSystemsProcessing(bool enabled)
+{
+    parallelSystemsProcessing = enabled;
+    systemScheduler.Invalidate();
+}
+
+bool Scene::IsParallelSystemsProcessing() const
+{
+    return parallelSystemsProcessing;
+}
+
 void Scene::Draw()
 {
     DAVA_PROFILER_CPU_SCOPE(ProfilerCPUMarkerName::SCENE_DRAW)
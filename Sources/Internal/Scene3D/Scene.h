@@ -4,6 +4,7 @@
 #include "Base/BaseTypes.h"
 #include "Base/Observer.h"
 #include "Entity/SceneSystem.h"
+#include "Entity/SceneSystemScheduler.h"
 #include "Entity/SingletonComponent.h"
 #include "Render/Highlevel/Camera.h"
 #include "Render/Highlevel/Light.h"
@@ -206,6 +207,14 @@ public:
 
     virtual void Update(float32 timeElapsed);
     virtual void Draw();
+
+    /**
+        \brief Enable or disable concurrent processing of scene systems with declared components access.
+                Disabled by default, in which case systems are processed one by one on the main thread.
+                See SceneSystem::SetComponentsAccess and SceneSystemScheduler for details.
+     */
+    void SetParallelSystemsProcessing(bool enabled);
+    bool IsParallelSystemsProcessing() const;
     void SceneDidLoaded() override;
 
     Camera* GetCamera(int32 n);
@@ -275,6 +284,9 @@ protected:
     Camera* mainCamera;
     Camera* drawCamera;
 
+    SceneSystemScheduler systemScheduler;
+    bool parallelSystemsProcessing = false;
+
     struct FixedUpdate
     {
         float32 constantTime = 0.016f;
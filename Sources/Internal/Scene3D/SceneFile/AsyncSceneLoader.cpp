@@ -0,0 +1,168 @@
+#include "Scene3D/SceneFile/AsyncSceneLoader.h"
+#include "Scene3D/Scene.h"
+
+#include "Concurrency/Thread.h"
+#include "Debug/DVAssert.h"
+#include "Debug/ProfilerCPU.h"
+#include "Debug/ProfilerMarkerNames.h"
+#include "Logger/Logger.h"
+#include "Time/SystemTimer.h"
+
+#include <limits>
+
+namespace DAVA
+{
+namespace AsyncSceneLoaderDetails
+{
+const uint32 LOADING_THREAD_STACK_SIZE = 1024 * 1024;
+}
+
+AsyncSceneLoader::AsyncSceneLoader(const FilePath& scenePath_)
+    : scenePath(scenePath_)
+{
+}
+
+AsyncSceneLoader::~AsyncSceneLoader()
+{
+    if (loadingThread != nullptr)
+    {
+        // loading can't be interrupted, so wait for it to avoid releasing staging scene while it's being filled
+        loadingThread->Join();
+        SafeRelease(loadingThread);
+    }
+
+    SafeRelease(stagingScene);
+}
+
+void AsyncSceneLoader::Start()
+{
+    DVASSERT(Thread::IsMainThread());
+    DVASSERT(loadingThread == nullptr, "Loading is already started");
+
+    // Scene is created and destroyed on main thread, only its filling is performed on loading thread.
+    // Staging scene has no systems: entities are registered in systems only once, when attached to target scene
+    stagingScene = new Scene(0);
+    stagingScene->SetName(scenePath.GetFilename().c_str());
+
+    loadingThread = Thread::Create([this]() { Load(); });
+    loadingThread->SetName("DAVA::SceneLoader");
+    loadingThread->SetStackSize(AsyncSceneLoaderDetails::LOADING_THREAD_STACK_SIZE);
+    loadingThread->Start();
+}
+
+void AsyncSceneLoader::Load()
+{
+    DAVA_PROFILER_CPU_SCOPE(ProfilerCPUMarkerName::SCENE_ASYNC_LOAD);
+
+    int64 startTime = SystemTimer::GetMs();
+
+    ScopedPtr<SceneFileV2> sceneFile(new SceneFileV2());
+    sceneFile->EnableDebugLog(false);
+    sceneFile->SetLoadingProgressCallback([this](float32 value) { progress = value; });
+
+    error = sceneFile->LoadScene(scenePath, stagingScene);
+    loadingTime = SystemTimer::GetMs() - startTime;
+
+    progress = 1.f;
+    finished = true;
+}
+
+bool AsyncSceneLoader::IsFinished() const
+{
+    return finished;
+}
+
+float32 AsyncSceneLoader::GetProgress() const
+{
+    return progress;
+}
+
+SceneFileV2::eError AsyncSceneLoader::GetError() const
+{
+    DVASSERT(IsFinished());
+    return error;
+}
+
+int64 AsyncSceneLoader::GetLoadingTime() const
+{
+    return loadingTime;
+}
+
+int64 AsyncSceneLoader::GetAttachTime() const
+{
+    return attachTime;
+}
+
+SceneFileV2::eError AsyncSceneLoader::AttachTo(Scene* scene)
+{
+    const int64 noTimeLimit = std::numeric_limits<int64>::max();
+    bool attached = AttachPartTo(scene, noTimeLimit);
+    DVASSERT(attached);
+    return error;
+}
+
+bool AsyncSceneLoader::AttachPartTo(Scene* scene, int64 timeBudgetUs)
+{
+    DAVA_PROFILER_CPU_SCOPE(ProfilerCPUMarkerName::SCENE_ASYNC_LOAD_ATTACH);
+
+    DVASSERT(Thread::IsMainThread());
+    DVASSERT(IsFinished());
+    DVASSERT(scene != nullptr);
+    DVASSERT(attachingScene == nullptr || attachingScene == scene, "Loaded content is already being attached to another scene");
+
+    if (error != SceneFileV2::ERROR_NO_ERROR)
+    {
+        Logger::Error("AsyncSceneLoader::AttachPartTo scene %s was not loaded, error: %d", scenePath.GetStringValue().c_str(), error);
+        return true;
+    }
+
+    if (stagingScene == nullptr)
+    {
+        return true; // already attached
+    }
+
+    int64 startTime = SystemTimer::GetUs();
+
+    if (attachingScene == nullptr)
+    {
+        attachingScene = scene;
+
+        loadingThread->Join();
+        SafeRelease(loadingThread);
+
+        scene->version = stagingScene->version;
+        scene->SetGlobalMaterial(stagingScene->GetGlobalMaterial());
+
+        // AddNode removes entity from staging scene, so iterate over copy of children list
+        entitiesToAttach = stagingScene->children;
+        attachedCount = 0;
+        scene->children.reserve(scene->children.size() + entitiesToAttach.size());
+    }
+
+    // Registration of entity in all systems of scene is the main cost, so time is checked after each top-level entity
+    while (attachedCount < entitiesToAttach.size())
+    {
+        scene->AddNode(entitiesToAttach[attachedCount]);
+        ++attachedCount;
+
+        if (SystemTimer::GetUs() - startTime >= timeBudgetUs)
+        {
+            break;
+        }
+    }
+
+    bool attached = (attachedCount == entitiesToAttach.size());
+    if (attached)
+    {
+        scene->SceneDidLoaded();
+        scene->OnSceneReady(scene);
+
+        entitiesToAttach.clear();
+        attachingScene = nullptr;
+        SafeRelease(stagingScene);
+    }
+
+    attachTime += SystemTimer::GetUs() - startTime;
+    return attached;
+}
+}
@@ -0,0 +1,104 @@
+#pragma once
+
+#include "Base/BaseObject.h"
+#include "FileSystem/FilePath.h"
+#include "Scene3D/SceneFileV2.h"
+
+#include <atomic>
+
+namespace DAVA
+{
+class Entity;
+class Scene;
+class Thread;
+
+/**
+    Loads scene file without blocking main thread.
+
+    Scene file is parsed and all its content (materials, textures, polygon groups, entity hierarchy)
+    is created on separate loading thread inside hidden staging scene, `GetProgress` can be used to display loading progress.
+    Staging scene has no systems, so loaded entities are not registered anywhere until they are attached.
+    When loading is finished, `AttachTo` should be called on main thread: it moves loaded entities and
+    global material into target scene, which only requires registration of entities in target scene systems.
+    For big scenes `AttachPartTo` spreads this registration over several frames.
+
+    Example:
+    \code
+    loader = new AsyncSceneLoader("~res:/3d/Maps/map.sc2");
+    loader->Start();
+    ...
+    // every frame
+    if (loader->IsFinished())
+    {
+        loader->AttachTo(scene);
+        SafeRelease(loader);
+    }
+
+    // or, to limit main thread time spent per frame
+    if (loader->IsFinished() && loader->AttachPartTo(scene, 2000))
+    {
+        SafeRelease(loader);
+    }
+    \endcode
+*/
+class AsyncSceneLoader : public BaseObject
+{
+public:
+    AsyncSceneLoader(const FilePath& scenePath);
+
+    /** Start loading on separate thread. Should be called on main thread. */
+    void Start();
+
+    /** Return true if loading thread has finished its work (successfully or not). */
+    bool IsFinished() const;
+
+    /** Return loading progress in [0, 1] range. */
+    float32 GetProgress() const;
+
+    /** Return result of loading, valid only after loading is finished. */
+    SceneFileV2::eError GetError() const;
+
+    /**
+        Move loaded content into `scene`. Should be called on main thread after loading is finished.
+        Loaded entities are appended to children of `scene`, global material and version of `scene` are replaced with loaded ones.
+    */
+    SceneFileV2::eError AttachTo(Scene* scene);
+
+    /**
+        Move loaded top-level entities into `scene` until `timeBudgetUs` microseconds are spent and return true
+        when all content is attached or loading has failed (see `GetError`). Should be called on main thread after loading
+        is finished with the same `scene` until it returns true. Attached entities are processed by `scene` systems
+        right away, `SceneDidLoaded` is called for `scene` once after the last entity is attached.
+    */
+    bool AttachPartTo(Scene* scene, int64 timeBudgetUs);
+
+    /** Return time in milliseconds spent on loading thread. */
+    int64 GetLoadingTime() const;
+
+    /** Return time in microseconds spent in `AttachTo` or all `AttachPartTo` calls on main thread. */
+    int64 GetAttachTime() const;
+
+protected:
+    ~AsyncSceneLoader();
+
+private:
+    void Load();
+
+    FilePath scenePath;
+    Scene* stagingScene = nullptr;
+    Thread* loadingThread = nullptr;
+
+    Scene* attachingScene = nullptr;
+    Vector<Entity*> entitiesToAttach; // owned by staging scene until attached
+    size_t attachedCount = 0;
+
+    std::atomic<float32> progress{ 0.f };
+    std::atomic<bool> finished{ false };
+
+    // written by loading thread before `finished` is set
+    SceneFileV2::eError error = SceneFileV2::ERROR_NO_ERROR;
+    int64 loadingTime = 0;
+
+    int64 attachTime = 0;
+};
+}
@@ -21,6 +21,7 @@
 #include "Logger/Logger.h"
 #include "Utils/StringFormat.h"
 #include "FileSystem/FileSystem.h"
+#include "FileSystem/FlatKeyedArchive.h"
 #include "Base/ObjectFactory.h"
 #include "Base/TemplateHelpers.h"
 #include "Render/Highlevel/Landscape.h"
@@ -46,6 +47,14 @@
 
 namespace DAVA
 {
+namespace SceneFileV2Details
+{
+// Parts of loading progress reported by LoadScene for each loading stage
+const float32 DATA_NODES_PROGRESS = 0.4f;
+const float32 HIERARCHY_PROGRESS = 0.4f;
+const float32 POLYGON_DATA_PROGRESS = 0.15f;
+}
+
 SceneFileV2::SceneFileV2() //-V730 no need to init descriptor
 {
     isDebugLogEnabled = false;
@@ -65,6 +74,19 @@ void SceneFileV2::EnableSaveForGame(bool _isSaveForGame)
     isSaveForGame = _isSaveForGame;
 }
 
+void SceneFileV2::SetLoadingProgressCallback(const Function<void(float32)>& callback)
+{
+    loadingProgressCallback = callback;
+}
+
+void SceneFileV2::ReportLoadingProgress(float32 progress)
+{
+    if (loadingProgressCallback)
+    {
+        loadingProgressCallback(progress);
+    }
+}
+
 void SceneFileV2::EnableDebugLog(bool _isDebugLogEnabled)
 {
     isDebugLogEnabled = _isDebugLogEnabled;
@@ -127,11 +149,11 @@ SceneFileV2::eError SceneFileV2::SaveScene(const FilePath& filename, Scene* scen
 
     // save version tags
     {
-        ScopedPtr<KeyedArchive> tagsArchive(new KeyedArchive());
+        ScopedPtr<FlatKeyedArchive> tagsArchive(new FlatKeyedArchive());
         const VersionInfo::TagsMap& tags = GetEngineContext()->versionInfo->GetCurrentVersion().tags;
         for (VersionInfo::TagsMap::const_iterator it = tags.begin(); it != tags.end(); ++it)
         {
-            tagsArchive->SetUInt32(it->first, it->second);
+            tagsArchive->SetUInt32(FastName(it->first), it->second);
         }
         if (!tagsArchive->Save(file))
         {
@@ -323,17 +345,15 @@ bool SceneFileV2::ReadVersionTags(VersionInfo::SceneVersion& _version, File* fil
     bool loaded = false;
     if (_version.version >= 14)
     {
-        ScopedPtr<KeyedArchive> tagsArchive(new KeyedArchive());
+        ScopedPtr<FlatKeyedArchive> tagsArchive(new FlatKeyedArchive());
         loaded = tagsArchive->Load(file);
 
         if (loaded)
         {
-            const KeyedArchive::UnderlyingMap& keyedTags = tagsArchive->GetArchieveData();
-            for (KeyedArchive::UnderlyingMap::const_iterator it = keyedTags.begin(); it != keyedTags.end(); it++)
+            for (const FastName& tag : tagsArchive->GetKeys())
             {
-                const String& tag = it->first;
-                const uint32 ver = it->second->AsUInt32();
-                _version.tags.insert(VersionInfo::TagsMap::value_type(tag, ver));
+                const uint32 ver = tagsArchive->GetUInt32(tag);
+                _version.tags.insert(VersionInfo::TagsMap::value_type(String(tag.c_str()), ver));
             }
         }
     }
@@ -472,6 +492,8 @@ SceneFileV2::eError SceneFileV2::LoadScene(const FilePath& filename, Scene* scen
                 SetError(ERROR_FILE_READ_ERROR);
                 return GetError();
             }
+
+            ReportLoadingProgress(SceneFileV2Details::DATA_NODES_PROGRESS * float32(k + 1) / float32(dataNodeCount));
         }
 
         NMaterial* globalMaterial = nullptr;
@@ -530,6 +552,8 @@ SceneFileV2::eError SceneFileV2::LoadScene(const FilePath& filename, Scene* scen
             SetError(ERROR_FILE_READ_ERROR);
             return GetError();
         }
+
+        ReportLoadingProgress(SceneFileV2Details::DATA_NODES_PROGRESS + SceneFileV2Details::HIERARCHY_PROGRESS * float32(ci + 1) / float32(header.nodeCount));
     }
 
     UpdatePolygonGroupRequestedFormatRecursively(scene);
@@ -540,6 +564,8 @@ SceneFileV2::eError SceneFileV2::LoadScene(const FilePath& filename, Scene* scen
         SetError(ERROR_FILE_READ_ERROR);
         return GetError();
     }
+    ReportLoadingProgress(SceneFileV2Details::DATA_NODES_PROGRESS + SceneFileV2Details::HIERARCHY_PROGRESS + SceneFileV2Details::POLYGON_DATA_PROGRESS);
+
     OptimizeScene(scene);
 
     if (serializationContext.GetVersion() < LODSYSTEM2)
@@ -551,6 +577,8 @@ SceneFileV2::eError SceneFileV2::LoadScene(const FilePath& filename, Scene* scen
     {
         scene->SceneDidLoaded();
         scene->OnSceneReady(scene);
+
+        ReportLoadingProgress(1.0f);
     }
 
     return GetError();
@@ -887,31 +915,47 @@ bool SceneFileV2::LoadHierarchy(Scene* scene, Entity* parent, File* file, int32
 {
     bool resultLoad = true;
     bool keepUnusedQualityEntities = QualitySettingsSystem::Instance()->GetKeepUnusedEntities();
-    ScopedPtr<KeyedArchive> archive(new KeyedArchive());
-    resultLoad &= archive->Load(file);
 
-    String name = archive->GetString("##name");
+    static const FastName CLASS_NAME_KEY("##name");
+    static const FastName NAME_KEY("name");
+    static const FastName CHILDREN_COUNT_KEY("#childrenCount");
+
+    // node is indexed in single buffer, KeyedArchive is created only for legacy node types
+    ScopedPtr<FlatKeyedArchive> flatArchive(new FlatKeyedArchive());
+    resultLoad &= flatArchive->Load(file);
+
+    String name = flatArchive->GetString(CLASS_NAME_KEY);
 
     bool removeChildren = false;
     bool skipNode = false;
 
     Entity* node = nullptr;
-    if (name == "LandscapeNode")
+    if (name == "Entity")
+    {
+        node = new Entity();
+        node->SetScene(scene);
+        node->LoadFlat(flatArchive, &serializationContext);
+    }
+    else if (name == "LandscapeNode")
     {
-        node = LoadLandscape(scene, archive);
+        RefPtr<KeyedArchive> archive = flatArchive->CreateKeyedArchive();
+        node = LoadLandscape(scene, archive.Get());
     }
     else if (name == "Camera")
     {
-        node = LoadCamera(scene, archive);
+        RefPtr<KeyedArchive> archive = flatArchive->CreateKeyedArchive();
+        node = LoadCamera(scene, archive.Get());
     }
     else if ((name == "LightNode")) // || (name == "EditorLightNode"))
     {
-        node = LoadLight(scene, archive);
+        RefPtr<KeyedArchive> archive = flatArchive->CreateKeyedArchive();
+        node = LoadLight(scene, archive.Get());
         removeChildren = true;
     }
     else if (name == "SceneNode")
     {
-        node = LoadEntity(scene, archive);
+        RefPtr<KeyedArchive> archive = flatArchive->CreateKeyedArchive();
+        node = LoadEntity(scene, archive.Get());
     }
     else
     {
@@ -919,8 +963,9 @@ bool SceneFileV2::LoadHierarchy(Scene* scene, Entity* parent, File* file, int32
         node = dynamic_cast<Entity*>(obj);
         if (node)
         {
+            RefPtr<KeyedArchive> archive = flatArchive->CreateKeyedArchive();
             node->SetScene(scene);
-            node->Load(archive, &serializationContext);
+            node->Load(archive.Get(), &serializationContext);
         }
         else //in case if editor class is loading in non-editor sprsoject
         {
@@ -934,7 +979,7 @@ bool SceneFileV2::LoadHierarchy(Scene* scene, Entity* parent, File* file, int32
     {
         if (isDebugLogEnabled)
         {
-            String arcName = archive->GetString("name");
+            String arcName = flatArchive->GetString(NAME_KEY);
             Logger::FrameworkDebug("%s %s(%s)", GetIndentString('-', level).c_str(), arcName.c_str(), node->GetClassName().c_str());
         }
 
@@ -943,7 +988,7 @@ bool SceneFileV2::LoadHierarchy(Scene* scene, Entity* parent, File* file, int32
             parent->AddNode(node);
         }
 
-        int32 childrenCount = archive->GetInt32("#childrenCount", 0);
+        int32 childrenCount = flatArchive->GetInt32(CHILDREN_COUNT_KEY, 0);
         node->children.reserve(childrenCount);
         for (int ci = 0; ci < childrenCount; ++ci)
         {
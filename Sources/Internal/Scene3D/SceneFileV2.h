@@ -7,6 +7,7 @@
 #include "Render/3D/PolygonGroup.h"
 #include "Utils/Utils.h"
 #include "FileSystem/File.h"
+#include "Functional/Function.h"
 #include "Scene3D/SceneFile/SerializationContext.h"
 #include "Scene3D/SceneFile/VersionInfo.h"
 
@@ -131,6 +132,12 @@ public:
     bool DebugLogEnabled();
     void EnableSaveForGame(bool _isSaveForGame);
 
+    /**
+        Set function which is called from LoadScene with loading progress in [0, 1] range.
+        Function is called on the thread which loads scene.
+    */
+    void SetLoadingProgressCallback(const Function<void(float32)>& callback);
+
     //Material * GetMaterial(int32 index);
     //StaticMesh * GetStaticMesh(int32 index);
 
@@ -188,6 +195,7 @@ private:
     Entity* LoadLight(Scene* scene, KeyedArchive* archive);
 
     void ApplyFogQuality(DAVA::NMaterial* material);
+    void ReportLoadingProgress(float32 progress);
 
     static bool WriteDescriptor(File* file, const Descriptor& descriptor);
     static bool ReadDescriptor(File* file, /*out*/ Descriptor& descriptor);
@@ -197,6 +205,7 @@ private:
     eError lastError;
 
     SerializationContext serializationContext;
+    Function<void(float32)> loadingProgressCallback;
 };
 
 }; // namespace DAVA
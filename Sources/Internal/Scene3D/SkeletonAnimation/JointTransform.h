@@ -42,6 +42,8 @@ public:
     static JointTransform Override(const JointTransform& t0, const JointTransform& t1);
 
 private:
+    friend class SkeletonPose;
+
     enum eTransformFlag
     {
         FLAG_POSITION = 1 << 0,
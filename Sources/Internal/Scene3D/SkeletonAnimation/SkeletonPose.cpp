@@ -1,63 +1,343 @@
 #include "SkeletonPose.h"
 #include "Math/MathHelpers.h"
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define SKELETON_POSE_SSE
+#include <emmintrin.h>
+#elif defined(__ARM_NEON__) || defined(__ARM_NEON)
+#define SKELETON_POSE_NEON
+#include <arm_neon.h>
+#endif
+
 namespace DAVA
 {
+namespace SkeletonPoseDetails
+{
+const uint32 LANES_COUNT = 4;
+
+#if defined(SKELETON_POSE_SSE) || defined(SKELETON_POSE_NEON)
+
+#if defined(SKELETON_POSE_SSE)
+using float4 = __m128;
+using mask4 = __m128;
+
+inline float4 Load4(const float32* p)
+{
+    return _mm_loadu_ps(p);
+}
+inline void Store4(float32* p, float4 v)
+{
+    _mm_storeu_ps(p, v);
+}
+inline float4 Splat4(float32 v)
+{
+    return _mm_set1_ps(v);
+}
+inline float4 Add4(float4 a, float4 b)
+{
+    return _mm_add_ps(a, b);
+}
+inline float4 Sub4(float4 a, float4 b)
+{
+    return _mm_sub_ps(a, b);
+}
+inline float4 Mul4(float4 a, float4 b)
+{
+    return _mm_mul_ps(a, b);
+}
+inline float4 Neg4(float4 v)
+{
+    return _mm_sub_ps(_mm_setzero_ps(), v);
+}
+inline float4 InvSqrt4(float4 v)
+{
+    return _mm_div_ps(_mm_set1_ps(1.f), _mm_sqrt_ps(v));
+}
+inline mask4 LoadMask4(const uint32* p)
+{
+    return _mm_castsi128_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p)));
+}
+inline mask4 Less4(float4 a, float4 b)
+{
+    return _mm_cmplt_ps(a, b);
+}
+inline float4 Select4(mask4 m, float4 a, float4 b)
+{
+    return _mm_or_ps(_mm_and_ps(m, a), _mm_andnot_ps(m, b));
+}
+#elif defined(SKELETON_POSE_NEON)
+using float4 = float32x4_t;
+using mask4 = uint32x4_t;
+
+inline float4 Load4(const float32* p)
+{
+    return vld1q_f32(p);
+}
+inline void Store4(float32* p, float4 v)
+{
+    vst1q_f32(p, v);
+}
+inline float4 Splat4(float32 v)
+{
+    return vdupq_n_f32(v);
+}
+inline float4 Add4(float4 a, float4 b)
+{
+    return vaddq_f32(a, b);
+}
+inline float4 Sub4(float4 a, float4 b)
+{
+    return vsubq_f32(a, b);
+}
+inline float4 Mul4(float4 a, float4 b)
+{
+    return vmulq_f32(a, b);
+}
+inline float4 Neg4(float4 v)
+{
+    return vnegq_f32(v);
+}
+inline float4 InvSqrt4(float4 v)
+{
+    //estimate refined by two Newton-Raphson steps
+    float4 r = vrsqrteq_f32(v);
+    r = vmulq_f32(r, vrsqrtsq_f32(vmulq_f32(v, r), r));
+    r = vmulq_f32(r, vrsqrtsq_f32(vmulq_f32(v, r), r));
+    return r;
+}
+inline mask4 LoadMask4(const uint32* p)
+{
+    return vld1q_u32(p);
+}
+inline mask4 Less4(float4 a, float4 b)
+{
+    return vcltq_f32(a, b);
+}
+inline float4 Select4(mask4 m, float4 a, float4 b)
+{
+    return vbslq_f32(m, a, b);
+}
+#endif
+
+/**
+    Per-lane masks of transform component presence in both blended poses.
+    Blended value is taken when both poses have component, own or other value when only one of them has it.
+*/
+struct ComponentMasks
+{
+    alignas(16) uint32 has0[LANES_COUNT];
+    alignas(16) uint32 only1[LANES_COUNT];
+    alignas(16) uint32 both[LANES_COUNT];
+
+    void Build(const uint8* flags0, const uint8* flags1, uint8 flag)
+    {
+        for (uint32 i = 0; i < LANES_COUNT; ++i)
+        {
+            bool inFirst = (flags0[i] & flag) != 0;
+            bool inSecond = (flags1[i] & flag) != 0;
+            has0[i] = inFirst ? ~0u : 0u;
+            only1[i] = (!inFirst && inSecond) ? ~0u : 0u;
+            both[i] = (inFirst && inSecond) ? ~0u : 0u;
+        }
+    }
+
+    float4 Choose(float4 blended, float4 v0, float4 v1, float4 defaultValue) const
+    {
+        float4 result = Select4(LoadMask4(has0), v0, defaultValue);
+        result = Select4(LoadMask4(only1), v1, result);
+        return Select4(LoadMask4(both), blended, result);
+    }
+};
+
+inline void LerpComponent(float32* v0, const float32* v1, const ComponentMasks& masks, float4 factor, float4 defaultValue)
+{
+    float4 a = Load4(v0);
+    float4 b = Load4(v1);
+    float4 blended = Add4(a, Mul4(factor, Sub4(b, a)));
+    Store4(v0, masks.Choose(blended, a, b, defaultValue));
+}
+#endif
+
+/** Same weights as Quaternion::Slerp uses. */
+inline void GetSlerpScales(float32 cosom, float32 factor, float32& scale0, float32& scale1)
+{
+    if ((1.0f - cosom) > 0.05f)
+    {
+        float32 omega = std::acos(cosom);
+        float32 sinom = std::sin(omega);
+        scale0 = std::sin((1.0f - factor) * omega) / sinom;
+        scale1 = std::sin(factor * omega) / sinom;
+    }
+    else
+    {
+        scale0 = 1.0f - factor;
+        scale1 = factor;
+    }
+}
+}
+
 SkeletonPose::SkeletonPose(uint32 jointCount)
 {
     SetJointCount(jointCount);
 }
 
+void SkeletonPose::SetJointCount(uint32 jointCount_)
+{
+    jointCount = jointCount_;
+
+    positionX.resize(jointCount, 0.f);
+    positionY.resize(jointCount, 0.f);
+    positionZ.resize(jointCount, 0.f);
+    orientationX.resize(jointCount, 0.f);
+    orientationY.resize(jointCount, 0.f);
+    orientationZ.resize(jointCount, 0.f);
+    orientationW.resize(jointCount, 1.f);
+    scale.resize(jointCount, 1.f);
+    flags.resize(jointCount, 0);
+}
+
+void SkeletonPose::Reset()
+{
+    std::fill(positionX.begin(), positionX.end(), 0.f);
+    std::fill(positionY.begin(), positionY.end(), 0.f);
+    std::fill(positionZ.begin(), positionZ.end(), 0.f);
+    std::fill(orientationX.begin(), orientationX.end(), 0.f);
+    std::fill(orientationY.begin(), orientationY.end(), 0.f);
+    std::fill(orientationZ.begin(), orientationZ.end(), 0.f);
+    std::fill(orientationW.begin(), orientationW.end(), 1.f);
+    std::fill(scale.begin(), scale.end(), 1.f);
+    std::fill(flags.begin(), flags.end(), uint8(0));
+}
+
 void SkeletonPose::Add(const SkeletonPose& other)
 {
-    uint32 jointCount = other.GetJointsCount();
-    SetJointCount(Max(GetJointsCount(), jointCount));
+    uint32 otherJointCount = other.GetJointsCount();
+    SetJointCount(Max(GetJointsCount(), otherJointCount));
 
-    for (uint32 j = 0; j < jointCount; ++j)
+    for (uint32 j = 0; j < otherJointCount; ++j)
     {
-        const JointTransform& transform0 = GetJointTransform(j);
-        const JointTransform& transform1 = other.GetJointTransform(j);
+        JointTransform transform0 = GetJointTransform(j);
+        JointTransform transform1 = other.GetJointTransform(j);
         SetTransform(j, transform0.AppendTransform(transform1));
     }
 }
 
 void SkeletonPose::Diff(const SkeletonPose& other)
 {
-    uint32 jointCount = other.GetJointsCount();
-    SetJointCount(Max(GetJointsCount(), jointCount));
+    uint32 otherJointCount = other.GetJointsCount();
+    SetJointCount(Max(GetJointsCount(), otherJointCount));
 
-    for (uint32 j = 0; j < jointCount; ++j)
+    for (uint32 j = 0; j < otherJointCount; ++j)
     {
-        const JointTransform& transform0 = GetJointTransform(j);
-        const JointTransform& transform1 = other.GetJointTransform(j);
+        JointTransform transform0 = GetJointTransform(j);
+        JointTransform transform1 = other.GetJointTransform(j);
         SetTransform(j, transform0.GetInverse().AppendTransform(transform1));
     }
 }
 
 void SkeletonPose::Override(const SkeletonPose& other)
 {
-    uint32 jointCount = other.GetJointsCount();
-    SetJointCount(Max(GetJointsCount(), jointCount));
+    uint32 otherJointCount = other.GetJointsCount();
+    SetJointCount(Max(GetJointsCount(), otherJointCount));
 
-    for (uint32 j = 0; j < jointCount; ++j)
+    for (uint32 j = 0; j < otherJointCount; ++j)
     {
-        const JointTransform& transform0 = GetJointTransform(j);
-        const JointTransform& transform1 = other.GetJointTransform(j);
+        JointTransform transform0 = GetJointTransform(j);
+        JointTransform transform1 = other.GetJointTransform(j);
         SetTransform(j, JointTransform::Override(transform0, transform1));
     }
 }
 
 void SkeletonPose::Lerp(const SkeletonPose& other, float32 factor)
 {
-    uint32 jointCount = other.GetJointsCount();
-    SetJointCount(Max(GetJointsCount(), jointCount));
+    using namespace SkeletonPoseDetails;
+
+    uint32 otherJointCount = other.GetJointsCount();
+    SetJointCount(Max(GetJointsCount(), otherJointCount));
+
+    uint32 j = 0;
+#if defined(SKELETON_POSE_SSE) || defined(SKELETON_POSE_NEON)
+    const float4 factor4 = Splat4(factor);
+    const float4 zero4 = Splat4(0.f);
+    const float4 one4 = Splat4(1.f);
+
+    ComponentMasks masks;
+    alignas(16) float32 cosom[LANES_COUNT];
+    alignas(16) float32 scale0[LANES_COUNT];
+    alignas(16) float32 scale1[LANES_COUNT];
+
+    for (uint32 simdCount = otherJointCount - otherJointCount % LANES_COUNT; j < simdCount; j += LANES_COUNT)
+    {
+        const uint8* flags0 = flags.data() + j;
+        const uint8* flags1 = other.flags.data() + j;
+
+        masks.Build(flags0, flags1, JointTransform::FLAG_POSITION);
+        LerpComponent(positionX.data() + j, other.positionX.data() + j, masks, factor4, zero4);
+        LerpComponent(positionY.data() + j, other.positionY.data() + j, masks, factor4, zero4);
+        LerpComponent(positionZ.data() + j, other.positionZ.data() + j, masks, factor4, zero4);
+
+        masks.Build(flags0, flags1, JointTransform::FLAG_SCALE);
+        LerpComponent(scale.data() + j, other.scale.data() + j, masks, factor4, one4);
+
+        //slerp, take shortest arc
+        masks.Build(flags0, flags1, JointTransform::FLAG_ORIENTATION);
+        float4 x0 = Load4(orientationX.data() + j);
+        float4 y0 = Load4(orientationY.data() + j);
+        float4 z0 = Load4(orientationZ.data() + j);
+        float4 w0 = Load4(orientationW.data() + j);
+        float4 x1 = Load4(other.orientationX.data() + j);
+        float4 y1 = Load4(other.orientationY.data() + j);
+        float4 z1 = Load4(other.orientationZ.data() + j);
+        float4 w1 = Load4(other.orientationW.data() + j);
+
+        float4 dot = Add4(Add4(Mul4(x0, x1), Mul4(y0, y1)), Add4(Mul4(z0, z1), Mul4(w0, w1)));
+        mask4 negative = Less4(dot, zero4);
+        float4 x1s = Select4(negative, Neg4(x1), x1);
+        float4 y1s = Select4(negative, Neg4(y1), y1);
+        float4 z1s = Select4(negative, Neg4(z1), z1);
+        float4 w1s = Select4(negative, Neg4(w1), w1);
+        Store4(cosom, Select4(negative, Neg4(dot), dot));
+
+        //trigonometry is evaluated per lane, only for joints which are really blended
+        for (uint32 i = 0; i < LANES_COUNT; ++i)
+        {
+            if (masks.both[i] != 0)
+            {
+                GetSlerpScales(cosom[i], factor, scale0[i], scale1[i]);
+            }
+            else
+            {
+                scale0[i] = 1.f;
+                scale1[i] = 0.f;
+            }
+        }
+
+        float4 s0 = Load4(scale0);
+        float4 s1 = Load4(scale1);
+        float4 x = Add4(Mul4(x0, s0), Mul4(x1s, s1));
+        float4 y = Add4(Mul4(y0, s0), Mul4(y1s, s1));
+        float4 z = Add4(Mul4(z0, s0), Mul4(z1s, s1));
+        float4 w = Add4(Mul4(w0, s0), Mul4(w1s, s1));
+
+        float4 invLength = InvSqrt4(Add4(Add4(Mul4(x, x), Mul4(y, y)), Add4(Mul4(z, z), Mul4(w, w))));
+        Store4(orientationX.data() + j, masks.Choose(Mul4(x, invLength), x0, x1, zero4));
+        Store4(orientationY.data() + j, masks.Choose(Mul4(y, invLength), y0, y1, zero4));
+        Store4(orientationZ.data() + j, masks.Choose(Mul4(z, invLength), z0, z1, zero4));
+        Store4(orientationW.data() + j, masks.Choose(Mul4(w, invLength), w0, w1, one4));
+
+        for (uint32 i = 0; i < LANES_COUNT; ++i)
+        {
+            flags[j + i] |= other.flags[j + i];
+        }
+    }
+#endif
 
-    for (uint32 j = 0; j < jointCount; ++j)
+    for (; j < otherJointCount; ++j)
     {
-        const JointTransform& transform0 = GetJointTransform(j);
-        const JointTransform& transform1 = other.GetJointTransform(j);
+        JointTransform transform0 = GetJointTransform(j);
+        JointTransform transform1 = other.GetJointTransform(j);
         SetTransform(j, JointTransform::Lerp(transform0, transform1, factor));
     }
 }
 
-} //ns
\ No newline at end of file
+} //ns
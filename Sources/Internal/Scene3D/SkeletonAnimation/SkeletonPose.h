@@ -5,6 +5,11 @@
 
 namespace DAVA
 {
+/**
+    Local transforms of skeleton joints.
+    Components of transforms are stored in structure-of-arrays layout, so blending kernels
+    process four joints at once with SSE or NEON instructions (scalar code is used on other platforms).
+*/
 class SkeletonPose
 {
 public:
@@ -21,7 +26,7 @@ public:
     void SetOrientation(uint32 jointIndex, const Quaternion& orientation);
     void SetScale(uint32 jointIndex, float32 scale);
 
-    const JointTransform& GetJointTransform(uint32 jointIndex) const;
+    JointTransform GetJointTransform(uint32 jointIndex) const;
 
     void Add(const SkeletonPose& other);
     void Diff(const SkeletonPose& other);
@@ -29,23 +34,22 @@ public:
     void Lerp(const SkeletonPose& other, float32 factor);
 
 private:
-    Vector<JointTransform> jointTransforms;
+    uint32 jointCount = 0;
+
+    Vector<float32> positionX;
+    Vector<float32> positionY;
+    Vector<float32> positionZ;
+    Vector<float32> orientationX;
+    Vector<float32> orientationY;
+    Vector<float32> orientationZ;
+    Vector<float32> orientationW;
+    Vector<float32> scale;
+    Vector<uint8> flags;
 };
 
-inline void SkeletonPose::SetJointCount(uint32 jointCount)
-{
-    jointTransforms.resize(jointCount, JointTransform());
-}
-
 inline uint32 SkeletonPose::GetJointsCount() const
 {
-    return uint32(jointTransforms.size());
-}
-
-inline void SkeletonPose::Reset()
-{
-    for (JointTransform& t : jointTransforms)
-        t.Reset();
+    return jointCount;
 }
 
 inline void SkeletonPose::SetTransform(uint32 jointIndex, const JointTransform& transform)
@@ -53,7 +57,15 @@ inline void SkeletonPose::SetTransform(uint32 jointIndex, const JointTransform&
     if (GetJointsCount() <= jointIndex)
         SetJointCount(jointIndex + 1);
 
-    jointTransforms[jointIndex] = transform;
+    positionX[jointIndex] = transform.position.x;
+    positionY[jointIndex] = transform.position.y;
+    positionZ[jointIndex] = transform.position.z;
+    orientationX[jointIndex] = transform.orientation.x;
+    orientationY[jointIndex] = transform.orientation.y;
+    orientationZ[jointIndex] = transform.orientation.z;
+    orientationW[jointIndex] = transform.orientation.w;
+    scale[jointIndex] = transform.scale;
+    flags[jointIndex] = transform.flags;
 }
 
 inline void SkeletonPose::SetPosition(uint32 jointIndex, const Vector3& position)
@@ -61,7 +73,10 @@ inline void SkeletonPose::SetPosition(uint32 jointIndex, const Vector3& position
     if (GetJointsCount() <= jointIndex)
         SetJointCount(jointIndex + 1);
 
-    jointTransforms[jointIndex].SetPosition(position);
+    positionX[jointIndex] = position.x;
+    positionY[jointIndex] = position.y;
+    positionZ[jointIndex] = position.z;
+    flags[jointIndex] |= JointTransform::FLAG_POSITION;
 }
 
 inline void SkeletonPose::SetOrientation(uint32 jointIndex, const Quaternion& orientation)
@@ -69,25 +84,33 @@ inline void SkeletonPose::SetOrientation(uint32 jointIndex, const Quaternion& or
     if (GetJointsCount() <= jointIndex)
         SetJointCount(jointIndex + 1);
 
-    jointTransforms[jointIndex].SetOrientation(orientation);
+    orientationX[jointIndex] = orientation.x;
+    orientationY[jointIndex] = orientation.y;
+    orientationZ[jointIndex] = orientation.z;
+    orientationW[jointIndex] = orientation.w;
+    flags[jointIndex] |= JointTransform::FLAG_ORIENTATION;
 }
 
-inline void SkeletonPose::SetScale(uint32 jointIndex, float32 scale)
+inline void SkeletonPose::SetScale(uint32 jointIndex, float32 scale_)
 {
     if (GetJointsCount() <= jointIndex)
         SetJointCount(jointIndex + 1);
 
-    jointTransforms[jointIndex].SetScale(scale);
+    scale[jointIndex] = scale_;
+    flags[jointIndex] |= JointTransform::FLAG_SCALE;
 }
 
-inline const JointTransform& SkeletonPose::GetJointTransform(uint32 jointIndex) const
+inline JointTransform SkeletonPose::GetJointTransform(uint32 jointIndex) const
 {
-    static JointTransform emptyTransform;
-
+    JointTransform transform;
     if (jointIndex < GetJointsCount())
-        return jointTransforms[jointIndex];
-    else
-        return emptyTransform;
+    {
+        transform.position = Vector3(positionX[jointIndex], positionY[jointIndex], positionZ[jointIndex]);
+        transform.orientation = Quaternion(orientationX[jointIndex], orientationY[jointIndex], orientationZ[jointIndex], orientationW[jointIndex]);
+        transform.scale = scale[jointIndex];
+        transform.flags = flags[jointIndex];
+    }
+    return transform;
 }
 
-} //ns
\ No newline at end of file
+} //ns
@@ -0,0 +1,72 @@
+#include "UnitTests/UnitTests.h"
+
+#include "Scene3D/SkeletonAnimation/SkeletonPose.h"
+
+DAVA_TESTCLASS (SkeletonPoseTest)
+{
+    DAVA_TEST (LerpMatchesJointTransformLerp)
+    {
+        using namespace DAVA;
+
+        // Count is not multiple of SIMD width to cover both vector and scalar paths,
+        // joints cycle through all combinations of components presence in both poses
+        const uint32 count = 67;
+        const float32 factor = 0.3f;
+        const float32 epsilon = 1e-5f;
+
+        Vector<JointTransform> transforms0(count);
+        Vector<JointTransform> transforms1(count);
+
+        SkeletonPose pose0;
+        SkeletonPose pose1;
+        for (uint32 j = 0; j < count; ++j)
+        {
+            float32 f = static_cast<float32>(j);
+            uint32 mask0 = j % 8;
+            uint32 mask1 = (j / 8) % 8;
+
+            if (mask0 & 1)
+                transforms0[j].SetPosition(Vector3(f, -f, 2.f * f));
+            if (mask0 & 2)
+                transforms0[j].SetOrientation(Quaternion::MakeRotationFastY(0.1f * f));
+            if (mask0 & 4)
+                transforms0[j].SetScale(1.f + 0.1f * f);
+
+            if (mask1 & 1)
+                transforms1[j].SetPosition(Vector3(-f, 3.f, f));
+            if (mask1 & 2)
+            {
+                // every other rotation takes longer arc to cover quaternion sign flip
+                Quaternion q = Quaternion::MakeRotationFastY(0.1f * f + ((j % 2) ? 2.5f : 0.01f));
+                transforms1[j].SetOrientation((j % 3) ? q : Quaternion(-q.x, -q.y, -q.z, -q.w));
+            }
+            if (mask1 & 4)
+                transforms1[j].SetScale(2.f - 0.01f * f);
+
+            pose0.SetTransform(j, transforms0[j]);
+            pose1.SetTransform(j, transforms1[j]);
+        }
+
+        pose0.Lerp(pose1, factor);
+        TEST_VERIFY(pose0.GetJointsCount() == count);
+
+        for (uint32 j = 0; j < count; ++j)
+        {
+            JointTransform expected = JointTransform::Lerp(transforms0[j], transforms1[j], factor);
+            JointTransform actual = pose0.GetJointTransform(j);
+
+            TEST_VERIFY(expected.HasPosition() == actual.HasPosition());
+            TEST_VERIFY(expected.HasOrientation() == actual.HasOrientation());
+            TEST_VERIFY(expected.HasScale() == actual.HasScale());
+
+            TEST_VERIFY(FLOAT_EQUAL_EPS(expected.GetPosition().x, actual.GetPosition().x, epsilon));
+            TEST_VERIFY(FLOAT_EQUAL_EPS(expected.GetPosition().y, actual.GetPosition().y, epsilon));
+            TEST_VERIFY(FLOAT_EQUAL_EPS(expected.GetPosition().z, actual.GetPosition().z, epsilon));
+            TEST_VERIFY(FLOAT_EQUAL_EPS(expected.GetOrientation().x, actual.GetOrientation().x, epsilon));
+            TEST_VERIFY(FLOAT_EQUAL_EPS(expected.GetOrientation().y, actual.GetOrientation().y, epsilon));
+            TEST_VERIFY(FLOAT_EQUAL_EPS(expected.GetOrientation().z, actual.GetOrientation().z, epsilon));
+            TEST_VERIFY(FLOAT_EQUAL_EPS(expected.GetOrientation().w, actual.GetOrientation().w, epsilon));
+            TEST_VERIFY(FLOAT_EQUAL_EPS(expected.GetScale(), actual.GetScale(), epsilon));
+        }
+    }
+};
@@ -2,6 +2,9 @@
 
 #include "Debug/ProfilerCPU.h"
 #include "Debug/ProfilerMarkerNames.h"
+#include "Engine/Engine.h"
+#include "Engine/EngineContext.h"
+#include "Job/JobManager.h"
 #include "Scene3D/Entity.h"
 #include "Scene3D/Scene.h"
 #include "Scene3D/Components/ComponentHelpers.h"
@@ -118,16 +121,39 @@ void MotionSystem::Process(float32 timeElapsed)
 
     motionSingleComponent->Clear();
 
-    for (MotionComponent* component : activeComponents)
+    // Motions of different components touch only their own layers and skeleton, so poses are evaluated in parallel.
+    // Events are gathered into single component on calling thread afterwards
+    uint32 activeCount = static_cast<uint32>(activeComponents.size());
+    motionUpdates.assign(activeCount, MotionUpdate());
+    auto updateMotions = [this, timeElapsed](uint32 begin, uint32 end) {
+        for (uint32 i = begin; i < end; ++i)
+        {
+            motionUpdates[i] = UpdateMotionLayers(activeComponents[i], timeElapsed);
+        }
+    };
+
+    JobManager* jobManager = GetEngineContext()->jobManager;
+    if (activeCount > 1 && jobManager != nullptr && jobManager->GetWorkersCount() > 0)
     {
-        UpdateMotionLayers(component, timeElapsed);
+        jobManager->ParallelFor(0, activeCount, 4, updateMotions);
+    }
+    else
+    {
+        updateMotions(0, activeCount);
+    }
+
+    for (uint32 i = 0; i < activeCount; ++i)
+    {
+        CollectMotionEvents(activeComponents[i], motionUpdates[i]);
     }
 }
 
-void MotionSystem::UpdateMotionLayers(MotionComponent* motionComponent, float32 dTime)
+MotionSystem::MotionUpdate MotionSystem::UpdateMotionLayers(MotionComponent* motionComponent, float32 dTime)
 {
     DVASSERT(motionComponent);
 
+    MotionUpdate update;
+
     SkeletonComponent* skeleton = GetSkeletonComponent(motionComponent->GetEntity());
     if (skeleton != nullptr && (motionComponent->GetMotionLayersCount() != 0 || (motionComponent->simpleMotion != nullptr && motionComponent->simpleMotion->IsPlaying())))
     {
@@ -141,12 +167,6 @@ void MotionSystem::UpdateMotionLayers(MotionComponent* motionComponent, float32
 
             motionLayer->Update(dTime);
 
-            for (const auto& motionEnd : motionLayer->GetEndedMotions())
-                motionSingleComponent->animationEnd.insert(MotionSingleComponent::AnimationInfo(motionComponent, motionLayer->GetName(), motionEnd));
-
-            for (const auto& motionMarker : motionLayer->GetReachedMarkers())
-                motionSingleComponent->animationMarkerReached.insert(MotionSingleComponent::AnimationInfo(motionComponent, motionLayer->GetName(), motionMarker.first, motionMarker.second));
-
             const SkeletonPose& pose = motionLayer->GetCurrentSkeletonPose();
             MotionLayer::eMotionBlend blendMode = motionLayer->GetBlendMode();
             switch (blendMode)
@@ -170,13 +190,36 @@ void MotionSystem::UpdateMotionLayers(MotionComponent* motionComponent, float32
         if (simpleMotion != nullptr && simpleMotion->IsPlaying())
         {
             simpleMotion->Update(dTime);
-            if (!simpleMotion->IsPlaying())
-                motionSingleComponent->simpleMotionFinished.emplace_back(motionComponent);
+            update.simpleMotionFinished = !simpleMotion->IsPlaying();
 
             simpleMotion->EvaluatePose(&resultPose);
         }
 
         skeleton->ApplyPose(resultPose);
+        update.updated = true;
     }
+
+    return update;
+}
+
+void MotionSystem::CollectMotionEvents(MotionComponent* motionComponent, const MotionUpdate& update)
+{
+    if (!update.updated)
+        return;
+
+    uint32 motionLayersCount = motionComponent->GetMotionLayersCount();
+    for (uint32 l = 0; l < motionLayersCount; ++l)
+    {
+        MotionLayer* motionLayer = motionComponent->GetMotionLayer(l);
+
+        for (const auto& motionEnd : motionLayer->GetEndedMotions())
+            motionSingleComponent->animationEnd.insert(MotionSingleComponent::AnimationInfo(motionComponent, motionLayer->GetName(), motionEnd));
+
+        for (const auto& motionMarker : motionLayer->GetReachedMarkers())
+            motionSingleComponent->animationMarkerReached.insert(MotionSingleComponent::AnimationInfo(motionComponent, motionLayer->GetName(), motionMarker.first, motionMarker.second));
+    }
+
+    if (update.simpleMotionFinished)
+        motionSingleComponent->simpleMotionFinished.emplace_back(motionComponent);
 }
 }
\ No newline at end of file
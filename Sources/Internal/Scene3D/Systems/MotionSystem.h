@@ -30,9 +30,17 @@ protected:
     void SetScene(Scene* scene) override;
 
 private:
-    void UpdateMotionLayers(MotionComponent* motionComponent, float32 dTime);
+    struct MotionUpdate
+    {
+        bool updated = false;
+        bool simpleMotionFinished = false;
+    };
+
+    MotionUpdate UpdateMotionLayers(MotionComponent* motionComponent, float32 dTime);
+    void CollectMotionEvents(MotionComponent* motionComponent, const MotionUpdate& update);
 
     Vector<MotionComponent*> activeComponents;
+    Vector<MotionUpdate> motionUpdates;
     MotionSingleComponent* motionSingleComponent = nullptr;
 };
 
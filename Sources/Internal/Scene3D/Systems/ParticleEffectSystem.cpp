@@ -5,6 +5,7 @@
 #include "Math/MathConstants.h"
 #include "Scene3D/Components/ParticleEffectComponent.h"
 #include "Scene3D/Components/TransformComponent.h"
+#include "Particles/ParticleBuffer.h"
 #include "Particles/ParticleEmitter.h"
 #include "Particles/ParticlesRandom.h"
 #include "Particles/ParticleForces.h"
@@ -25,6 +26,7 @@
 #include "Scene3D/Systems/QualitySettingsSystem.h"
 #include "Engine/Engine.h"
 #include "Engine/EngineContext.h"
+#include "Job/JobManager.h"
 
 namespace DAVA
 {
@@ -406,6 +408,7 @@ void ParticleEffectSystem::Process(float32 timeElapsed)
     float32 shortEffectTime = timeElapsed * speedMult;
 
     size_t componentsCount = activeComponents.size();
+    updatedEffects.clear();
     for (size_t i = 0; i < componentsCount; i++)
     {
         ParticleEffectComponent* effect = activeComponents[i];
@@ -418,7 +421,50 @@ void ParticleEffectSystem::Process(float32 timeElapsed)
 
         if (effect->isPaused)
             continue;
-        UpdateEffect(effect, timeElapsed * effect->playbackSpeed, shortEffectTime * effect->playbackSpeed);
+
+        UpdatedEffect updated;
+        updated.effect = effect;
+        updated.deltaTime = timeElapsed * effect->playbackSpeed;
+        BeginEffectUpdate(effect, updated.deltaTime, shortEffectTime * effect->playbackSpeed);
+        SimulateEffectGroups(effect, updated.deltaTime, updated.bbox);
+        updatedEffects.push_back(updated);
+    }
+
+    // Buffered groups touch only their own particles, so they are simulated for all effects in parallel
+    uint32 updatedCount = static_cast<uint32>(updatedEffects.size());
+    if (bufferedForceValues.size() < updatedCount)
+    {
+        bufferedForceValues.resize(updatedCount);
+    }
+    JobManager* jobManager = GetEngineContext()->jobManager;
+    if (updatedCount > 1 && jobManager != nullptr && jobManager->GetWorkersCount() > 0)
+    {
+        jobManager->ParallelFor(0, updatedCount, 4, [this](uint32 begin, uint32 end) {
+            for (uint32 i = begin; i < end; ++i)
+            {
+                SimulateBufferedGroups(updatedEffects[i].effect, updatedEffects[i].deltaTime, updatedEffects[i].bbox, bufferedForceValues[i]);
+            }
+        });
+    }
+    else
+    {
+        for (uint32 i = 0; i < updatedCount; ++i)
+        {
+            SimulateBufferedGroups(updatedEffects[i].effect, updatedEffects[i].deltaTime, updatedEffects[i].bbox, bufferedForceValues[i]);
+        }
+    }
+
+    for (UpdatedEffect& updated : updatedEffects)
+    {
+        FinishEffectUpdate(updated.effect, updated.bbox);
+    }
+    updatedEffects.clear();
+
+    for (size_t i = 0; i < componentsCount; i++)
+    {
+        ParticleEffectComponent* effect = activeComponents[i];
+        if (effect->isPaused)
+            continue;
 
         bool effectEnded = effect->stopWhenEmpty ? effect->effectData.groups.empty() : (effect->time > effect->effectDuration);
         if (effectEnded)
@@ -511,32 +557,56 @@ void ParticleEffectSystem::UpdateActiveLod(ParticleEffectComponent* effect)
 
 void ParticleEffectSystem::UpdateEffect(ParticleEffectComponent* effect, float32 deltaTime, float32 shortEffectTime)
 {
-    effect->time += deltaTime;
-    const Matrix4* worldTransformPtr;
+    AABBox3 bbox;
+    BeginEffectUpdate(effect, deltaTime, shortEffectTime);
+    SimulateEffectGroups(effect, deltaTime, bbox);
+    if (bufferedForceValues.empty())
+    {
+        bufferedForceValues.resize(1);
+    }
+    SimulateBufferedGroups(effect, deltaTime, bbox, bufferedForceValues[0]);
+    FinishEffectUpdate(effect, bbox);
+}
+
+const Matrix4* ParticleEffectSystem::GetEffectWorldMatrix(ParticleEffectComponent* effect)
+{
     if (GetScene())
     {
         TransformComponent* tr = GetTransformComponent(effect->GetEntity());
         DVASSERT(tr);
-        worldTransformPtr = tr->GetWorldMatrixPtr();
+        return tr->GetWorldMatrixPtr();
     }
-    else
-        worldTransformPtr = effect->effectRenderObject->GetWorldMatrixPtr();
+    return effect->effectRenderObject->GetWorldMatrixPtr();
+}
+
+bool ParticleEffectSystem::IsBufferedGroup(const ParticleGroup& group) const
+{
+    if (!bufferedSimulationEnabled)
+        return false;
+
+    ParticleLayer* layer = group.layer;
+    if (layer->type != ParticleLayer::TYPE_PARTICLES && layer->type != ParticleLayer::TYPE_SINGLE_PARTICLE)
+        return false;
 
+    return !layer->applyGlobalForces && layer->GetParticleForces().empty();
+}
+
+void ParticleEffectSystem::BeginEffectUpdate(ParticleEffectComponent* effect, float32 deltaTime, float32 shortEffectTime)
+{
+    effect->time += deltaTime;
+    const Matrix4* worldTransformPtr = GetEffectWorldMatrix(effect);
     effect->effectData.infoSources[0].position = worldTransformPtr->GetTranslationVector();
 
-    AABBox3 bbox;
-    List<ParticleGroup>::iterator it = effect->effectData.groups.begin();
     Random* random = GetEngineContext()->random;
-    bool isInverseCalculated = false;
-    while (it != effect->effectData.groups.end())
+    for (ParticleGroup& group : effect->effectData.groups)
     {
-        ParticleGroup& group = *it;
         group.activeParticleCount = 0;
         float32 dt = group.emitter->shortEffect ? shortEffectTime : deltaTime;
         group.time += dt;
         float32 groupEndTime = group.layer->isLooped ? group.layer->loopEndTime : group.layer->endTime;
         float32 currLoopTime = group.time - group.loopStartTime;
-        float32 currLoopTimeNormalized = currLoopTime / (group.layer->endTime - group.layer->startTime);
+        group.updateDeltaTime = dt;
+        group.updateLoopTimeNormalized = currLoopTime / (group.layer->endTime - group.layer->startTime);
         if (group.time > groupEndTime)
             group.finishingGroup = true;
 
@@ -545,9 +615,46 @@ void ParticleEffectSystem::UpdateEffect(ParticleEffectComponent* effect, float32
             group.loopStartTime = group.time;
             group.loopLayerStartTime = group.layer->deltaTime + group.layer->deltaVariation * static_cast<float32>(random->RandFloat());
             group.loopDuration = group.loopLayerStartTime + (group.layer->endTime - group.layer->startTime) + group.layer->loopVariation * static_cast<float32>(random->RandFloat());
-            currLoopTime = 0;
         }
 
+        // Dead particles are removed before simulation, so simulation never touches particles allocator
+        Particle* current = group.head;
+        Particle* prev = nullptr;
+        while (current)
+        {
+            current->life += dt;
+            if (current->life >= current->lifeTime)
+            {
+                Particle* next = current->next;
+                if (prev == nullptr)
+                    group.head = next;
+                else
+                    prev->next = next;
+                delete current;
+                current = next;
+                continue;
+            }
+            group.activeParticleCount++;
+
+            prev = current;
+            current = current->next;
+        }
+    }
+}
+
+void ParticleEffectSystem::SimulateEffectGroups(ParticleEffectComponent* effect, float32 deltaTime, AABBox3& bbox)
+{
+    const Matrix4* worldTransformPtr = GetEffectWorldMatrix(effect);
+    bool isInverseCalculated = false;
+    for (ParticleGroup& group : effect->effectData.groups)
+    {
+        if (group.head == nullptr || IsBufferedGroup(group))
+            continue;
+
+        float32 dt = group.updateDeltaTime;
+        float32 currLoopTime = group.time - group.loopStartTime;
+        float32 currLoopTimeNormalized = group.updateLoopTimeNormalized;
+
         //prepare forces as they will now actually change in time even for already generated particles
         static Vector<Vector3> currSimplifiedForceValues;
         int32 simplifiedForcesCount;
@@ -558,71 +665,52 @@ void ParticleEffectSystem::UpdateEffect(ParticleEffectComponent* effect, float32
         uint32 effectAlignForcesCount = 0;
 
         static Matrix4 invWorld;
-        if (group.head)
+
+        simplifiedForcesCount = static_cast<int32>(group.layer->GetSimplifiedParticleForces().size());
+        if (simplifiedForcesCount)
         {
-            simplifiedForcesCount = static_cast<int32>(group.layer->GetSimplifiedParticleForces().size());
-            if (simplifiedForcesCount)
+            currSimplifiedForceValues.resize(simplifiedForcesCount);
+            for (int32 i = 0; i < simplifiedForcesCount; ++i)
             {
-                currSimplifiedForceValues.resize(simplifiedForcesCount);
-                for (int32 i = 0; i < simplifiedForcesCount; ++i)
-                {
-                    if (group.layer->GetSimplifiedParticleForces()[i]->force)
-                        currSimplifiedForceValues[i] = group.layer->GetSimplifiedParticleForces()[i]->force->GetValue(currLoopTime);
-                    else
-                        currSimplifiedForceValues[i] = Vector3(0, 0, 0);
-                }
+                if (group.layer->GetSimplifiedParticleForces()[i]->force)
+                    currSimplifiedForceValues[i] = group.layer->GetSimplifiedParticleForces()[i]->force->GetValue(currLoopTime);
+                else
+                    currSimplifiedForceValues[i] = Vector3(0, 0, 0);
             }
+        }
 
-            uint32 allForcesCount = static_cast<uint32>(group.layer->GetParticleForces().size());
-            if (allForcesCount > 0)
+        uint32 allForcesCount = static_cast<uint32>(group.layer->GetParticleForces().size());
+        if (allForcesCount > 0)
+        {
+            effectAlignCurrForces.resize(allForcesCount);
+            worldAlignCurrForces.resize(allForcesCount);
+            for (uint32 i = 0; i < allForcesCount; ++i)
             {
-                effectAlignCurrForces.resize(allForcesCount);
-                worldAlignCurrForces.resize(allForcesCount);
-                for (uint32 i = 0; i < allForcesCount; ++i)
-                {
-                    DAVA::ParticleForce* currForce = group.layer->GetParticleForces()[i];
-                    if (currForce->isGlobal)
-                        continue;
+                DAVA::ParticleForce* currForce = group.layer->GetParticleForces()[i];
+                if (currForce->isGlobal)
+                    continue;
 
-                    if (currForce->worldAlign)
-                    {
-                        currForce->worldPosition = currForce->position + worldTransformPtr->GetTranslationVector(); // Ignore emitter rotation.
-                        worldAlignCurrForces[forcesCountWorldAlign] = currForce;
-                        ++forcesCountWorldAlign;
-                    }
-                    else
+                if (currForce->worldAlign)
+                {
+                    currForce->worldPosition = currForce->position + worldTransformPtr->GetTranslationVector(); // Ignore emitter rotation.
+                    worldAlignCurrForces[forcesCountWorldAlign] = currForce;
+                    ++forcesCountWorldAlign;
+                }
+                else
+                {
+                    effectAlignCurrForces[effectAlignForcesCount] = currForce;
+                    ++effectAlignForcesCount;
+                    if (!isInverseCalculated)
                     {
-                        effectAlignCurrForces[effectAlignForcesCount] = currForce;
-                        ++effectAlignForcesCount;
-                        if (!isInverseCalculated)
-                        {
-                            invWorld = GetInverseWithRemovedScale(*worldTransformPtr);
-                            isInverseCalculated = true;
-                        }
+                        invWorld = GetInverseWithRemovedScale(*worldTransformPtr);
+                        isInverseCalculated = true;
                     }
                 }
             }
         }
 
-        Particle* current = group.head;
-        Particle* prev = nullptr;
-
-        while (current)
+        for (Particle* current = group.head; current != nullptr; current = current->next)
         {
-            current->life += dt;
-            if (current->life >= current->lifeTime)
-            {
-                Particle* next = current->next;
-                if (prev == nullptr)
-                    group.head = next;
-                else
-                    prev->next = next;
-                delete current;
-                current = next;
-                continue;
-            }
-            group.activeParticleCount++;
-
             float32 overLifeTime = current->life / current->lifeTime;
 
             if (group.layer->type != ParticleLayer::TYPE_PARTICLE_STRIPE)
@@ -636,39 +724,85 @@ void ParticleEffectSystem::UpdateEffect(ParticleEffectComponent* effect, float32
                 effect->effectData.infoSources[current->positionTarget].size = current->currSize;
             }
 
-            if (group.layer->enableNoise && group.layer->noise.get() != nullptr)
-            {
-                if (group.layer->noiseScaleOverLife != nullptr)
-                    current->currNoiseScale = current->baseNoiseScale * group.layer->noiseScaleOverLife->GetValue(overLifeTime);
+            UpdateParticleMaterialData(current, group, overLifeTime, deltaTime);
 
-                DAVA::float32 overLifeScale = 1.0f;
-                if (group.layer->noiseUScrollSpeedOverLife != nullptr)
-                {
-                    overLifeScale = group.layer->noiseUScrollSpeedOverLife->GetValue(overLifeTime);
-                }
-                current->currNoiseUOffset += current->baseNoiseUScrollSpeed * overLifeScale * deltaTime;
+            if (group.layer->type == ParticleLayer::TYPE_PARTICLE_STRIPE)
+                UpdateStripe(current, effect->effectData, group, deltaTime, bbox, currSimplifiedForceValues, simplifiedForcesCount, group.layer->IsLodActive(effect->activeLodLevel));
+        }
+    }
+}
 
-                overLifeScale = 1.0f;
-                if (group.layer->noiseVScrollSpeedOverLife != nullptr)
-                {
-                    overLifeScale = group.layer->noiseVScrollSpeedOverLife->GetValue(overLifeTime);
-                }
-                current->currNoiseVOffset += current->baseNoiseVScrollSpeed * overLifeScale * deltaTime;
-            }
+void ParticleEffectSystem::SimulateBufferedGroups(ParticleEffectComponent* effect, float32 deltaTime, AABBox3& bbox, Vector<Vector3>& forceValues)
+{
+    for (ParticleGroup& group : effect->effectData.groups)
+    {
+        if (group.head == nullptr || !IsBufferedGroup(group))
+            continue;
+
+        ParticleLayer* layer = group.layer;
+        float32 dt = group.updateDeltaTime;
+        float32 currLoopTime = group.time - group.loopStartTime;
+
+        const Vector<ParticleForceSimplified*>& forces = layer->GetSimplifiedParticleForces();
+        uint32 forcesCount = static_cast<uint32>(forces.size());
+        forceValues.resize(forcesCount);
+        for (uint32 i = 0; i < forcesCount; ++i)
+        {
+            forceValues[i] = (forces[i]->force) ? forces[i]->force->GetValue(currLoopTime) : Vector3(0.0f, 0.0f, 0.0f);
+        }
+
+        ParticleBuffer& buffer = group.buffer;
+        buffer.Resize(static_cast<uint32>(group.activeParticleCount));
+
+        uint32 index = 0;
+        for (Particle* current = group.head; current != nullptr; current = current->next, ++index)
+        {
+            float32 overLifeTime = current->life / current->lifeTime;
+
+            float32 currVelocityOverLife = 1.0f;
+            if (layer->velocityOverLife)
+                currVelocityOverLife = layer->velocityOverLife->GetValue(overLifeTime);
 
-            if (group.layer->enableAlphaRemap && group.layer->alphaRemapSprite.get() != nullptr && group.layer->alphaRemapOverLife != nullptr)
+            Vector3 acceleration(0.0f, 0.0f, 0.0f);
+            for (uint32 i = 0; i < forcesCount; ++i)
             {
-                float32 lookup = overLifeTime * group.layer->alphaRemapLoopCount;
-                float32 intPart;
-                current->alphaRemap = group.layer->alphaRemapOverLife->GetValue(modff(lookup, &intPart));
+                acceleration += (forces[i]->forceOverLife) ? (forceValues[i] * forces[i]->forceOverLife->GetValue(overLifeTime)) : forceValues[i];
             }
 
-            if (group.layer->type == ParticleLayer::TYPE_PARTICLE_STRIPE)
-                UpdateStripe(current, effect->effectData, group, deltaTime, bbox, currSimplifiedForceValues, simplifiedForcesCount, group.layer->IsLodActive(effect->activeLodLevel));
+            UpdateParticleAppearance(current, group, overLifeTime, dt);
+            UpdateParticleMaterialData(current, group, overLifeTime, deltaTime);
 
-            prev = current;
-            current = current->next;
+            buffer.SetParticle(index, current->position, current->speed, currVelocityOverLife, acceleration, current->currRadius);
         }
+        DVASSERT(index == buffer.GetCount());
+
+        buffer.Integrate(dt);
+
+        Vector3 bboxOffset = layer->GetInheritPosition() ? effect->effectData.infoSources[group.positionSource].position : Vector3(0.0f, 0.0f, 0.0f);
+        buffer.AccumulateBBox(bboxOffset, bbox);
+
+        index = 0;
+        for (Particle* current = group.head; current != nullptr; current = current->next, ++index)
+        {
+            current->position = buffer.GetPosition(index);
+            current->speed = buffer.GetSpeed(index);
+        }
+    }
+}
+
+void ParticleEffectSystem::FinishEffectUpdate(ParticleEffectComponent* effect, AABBox3& bbox)
+{
+    const Matrix4* worldTransformPtr = GetEffectWorldMatrix(effect);
+    Random* random = GetEngineContext()->random;
+
+    List<ParticleGroup>::iterator it = effect->effectData.groups.begin();
+    while (it != effect->effectData.groups.end())
+    {
+        ParticleGroup& group = *it;
+        float32 dt = group.updateDeltaTime;
+        float32 currLoopTime = group.time - group.loopStartTime;
+        Particle* current = nullptr;
+
         bool allowParticleGeneration = !group.finishingGroup;
         allowParticleGeneration &= (currLoopTime > group.loopLayerStartTime);
         allowParticleGeneration &= group.visibleLod;
@@ -727,6 +861,36 @@ void ParticleEffectSystem::UpdateEffect(ParticleEffectComponent* effect, float32
     effect->effectRenderObject->SetAABBox(bbox);
 }
 
+void ParticleEffectSystem::UpdateParticleMaterialData(Particle* particle, const ParticleGroup& group, float32 overLife, float32 deltaTime)
+{
+    if (group.layer->enableNoise && group.layer->noise.get() != nullptr)
+    {
+        if (group.layer->noiseScaleOverLife != nullptr)
+            particle->currNoiseScale = particle->baseNoiseScale * group.layer->noiseScaleOverLife->GetValue(overLife);
+
+        DAVA::float32 overLifeScale = 1.0f;
+        if (group.layer->noiseUScrollSpeedOverLife != nullptr)
+        {
+            overLifeScale = group.layer->noiseUScrollSpeedOverLife->GetValue(overLife);
+        }
+        particle->currNoiseUOffset += particle->baseNoiseUScrollSpeed * overLifeScale * deltaTime;
+
+        overLifeScale = 1.0f;
+        if (group.layer->noiseVScrollSpeedOverLife != nullptr)
+        {
+            overLifeScale = group.layer->noiseVScrollSpeedOverLife->GetValue(overLife);
+        }
+        particle->currNoiseVOffset += particle->baseNoiseVScrollSpeed * overLifeScale * deltaTime;
+    }
+
+    if (group.layer->enableAlphaRemap && group.layer->alphaRemapSprite.get() != nullptr && group.layer->alphaRemapOverLife != nullptr)
+    {
+        float32 lookup = overLife * group.layer->alphaRemapLoopCount;
+        float32 intPart;
+        particle->alphaRemap = group.layer->alphaRemapOverLife->GetValue(modff(lookup, &intPart));
+    }
+}
+
 void ParticleEffectSystem::UpdateStripe(Particle* particle, ParticleEffectData& effectData, ParticleGroup& group, float32 dt, AABBox3& bbox, const Vector<Vector3>& currForceValues, int32 forcesCount, bool isActive)
 {
     ParticleLayer* layer = group.layer;
@@ -968,11 +1132,6 @@ void ParticleEffectSystem::UpdateRegularParticleData(ParticleEffectComponent* ef
     Vector3 prevParticlePosition = particle->position;
     particle->position += particle->speed * (currVelocityOverLife * dt);
 
-    float32 currSpinOverLife = 1.0f;
-    if (group.layer->spinOverLife)
-        currSpinOverLife = group.layer->spinOverLife->GetValue(overLife);
-    particle->angle += particle->spin * currSpinOverLife * dt;
-
     Vector3 acceleration(0.0f, 0.0f, 0.0f);
     for (int32 i = 0; i < simplifiedForcesCount; ++i)
     {
@@ -1005,16 +1164,27 @@ void ParticleEffectSystem::UpdateRegularParticleData(ParticleEffectComponent* ef
 
     particle->speed += acceleration * dt;
 
+    UpdateParticleAppearance(particle, group, overLife, dt);
+
+    if (group.layer->GetInheritPosition())
+        AddParticleToBBox(particle->position + effect->effectData.infoSources[group.positionSource].position, particle->currRadius, bbox);
+    else
+        AddParticleToBBox(particle->position, particle->currRadius, bbox);
+}
+
+void ParticleEffectSystem::UpdateParticleAppearance(Particle* particle, const ParticleGroup& group, float32 overLife, float32 dt)
+{
+    float32 currSpinOverLife = 1.0f;
+    if (group.layer->spinOverLife)
+        currSpinOverLife = group.layer->spinOverLife->GetValue(overLife);
+    particle->angle += particle->spin * currSpinOverLife * dt;
+
     if (group.layer->sizeOverLifeXY)
     {
         particle->currSize = particle->baseSize * group.layer->sizeOverLifeXY->GetValue(overLife);
         Vector2 pivotSize = particle->currSize * group.layer->layerPivotSizeOffsets;
         particle->currRadius = pivotSize.Length();
     }
-    if (group.layer->GetInheritPosition())
-        AddParticleToBBox(particle->position + effect->effectData.infoSources[group.positionSource].position, particle->currRadius, bbox);
-    else
-        AddParticleToBBox(particle->position, particle->currRadius, bbox);
 
     if (group.layer->frameOverLifeEnabled && group.layer->sprite)
     {
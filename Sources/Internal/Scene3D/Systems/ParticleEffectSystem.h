@@ -83,6 +83,10 @@ public:
 
     void PrebuildMaterials(ParticleEffectComponent* component);
 
+    /** Enable simulation of simple particle groups in ParticleBuffer, when disabled all groups are simulated per particle. Enabled by default. */
+    void SetBufferedSimulationEnabled(bool enabled);
+    bool IsBufferedSimulationEnabled() const;
+
 protected:
     void RunEffect(ParticleEffectComponent* effect);
     void AddToActive(ParticleEffectComponent* effect);
@@ -99,6 +103,28 @@ protected:
     void RunEmitter(ParticleEffectComponent* effect, ParticleEmitter* emitter, const Vector3& spawnPosition, int32 positionSource = 0);
 
 private:
+    struct UpdatedEffect
+    {
+        ParticleEffectComponent* effect = nullptr;
+        float32 deltaTime = 0.0f;
+        AABBox3 bbox;
+    };
+
+    /*
+        Effect is updated in three steps. `BeginEffectUpdate` advances groups' time and removes dead particles,
+        `SimulateEffectGroups` and `SimulateBufferedGroups` move remaining particles, `FinishEffectUpdate` emits new particles
+        and removes finished groups. Buffered groups (see `IsBufferedGroup`) are simulated in structure-of-arrays ParticleBuffer
+        and don't touch any shared state, so they are simulated for different effects concurrently.
+    */
+    void BeginEffectUpdate(ParticleEffectComponent* effect, float32 deltaTime, float32 shortEffectTime);
+    void SimulateEffectGroups(ParticleEffectComponent* effect, float32 deltaTime, AABBox3& bbox);
+    void SimulateBufferedGroups(ParticleEffectComponent* effect, float32 deltaTime, AABBox3& bbox, Vector<Vector3>& forceValues);
+    void FinishEffectUpdate(ParticleEffectComponent* effect, AABBox3& bbox);
+    const Matrix4* GetEffectWorldMatrix(ParticleEffectComponent* effect);
+    bool IsBufferedGroup(const ParticleGroup& group) const;
+
+    void UpdateParticleAppearance(Particle* particle, const ParticleGroup& group, float32 overLife, float32 dt);
+    void UpdateParticleMaterialData(Particle* particle, const ParticleGroup& group, float32 overLife, float32 deltaTime);
     void ApplyGlobalForces(Particle* particle, float32 dt, float32 overLife, float32 layerOverLife, Vector3 prevParticlePosition);
     void UpdateStripe(Particle* particle, ParticleEffectData& effectData, ParticleGroup& group, float32 dt, AABBox3& bbox, const Vector<Vector3>& currForceValues, int32 forcesCount, bool isActive);
     void SimulateEffect(ParticleEffectComponent* effect);
@@ -106,6 +132,9 @@ private:
 
     Map<String, float32> globalExternalValues;
     Vector<ParticleEffectComponent*> activeComponents;
+    Vector<UpdatedEffect> updatedEffects;
+    Vector<Vector<Vector3>> bufferedForceValues; // values of simplified forces, one array per concurrently simulated effect
+    bool bufferedSimulationEnabled = true;
 
     struct EffectGlobalForcesData
     {
@@ -139,4 +168,14 @@ inline bool ParticleEffectSystem::GetAllowLodDegrade() const
 {
     return allowLodDegrade;
 }
+
+inline void ParticleEffectSystem::SetBufferedSimulationEnabled(bool enabled)
+{
+    bufferedSimulationEnabled = enabled;
+}
+
+inline bool ParticleEffectSystem::IsBufferedSimulationEnabled() const
+{
+    return bufferedSimulationEnabled;
+}
 };
\ No newline at end of file
@@ -3,9 +3,13 @@
 #include "Animation/AnimationTrack.h"
 #include "Debug/ProfilerCPU.h"
 #include "Debug/ProfilerMarkerNames.h"
+#include "Engine/Engine.h"
+#include "Engine/EngineContext.h"
+#include "Job/JobManager.h"
 #include "Render/Highlevel/SkinnedMesh.h"
 #include "Scene3D/Entity.h"
 #include "Scene3D/Components/ComponentHelpers.h"
+#include "Scene3D/Components/RenderComponent.h"
 #include "Scene3D/Components/SkeletonComponent.h"
 #include "Scene3D/Components/TransformComponent.h"
 #include "Scene3D/SkeletonAnimation/JointTransform.h"
@@ -20,6 +24,9 @@ SkeletonSystem::SkeletonSystem(Scene* scene)
     : SceneSystem(scene)
 {
     scene->GetEventSystem()->RegisterSystemForEvent(this, EventSystem::SKELETON_CONFIG_CHANGED);
+
+    // Components access is not declared: `Process` marks skinned meshes for update in RenderSystem and draws into shared debug drawer,
+    // so system is always processed on the main thread. Skeletons themselves are still updated in parallel inside `Process`.
 }
 
 SkeletonSystem::~SkeletonSystem()
@@ -56,6 +63,7 @@ void SkeletonSystem::RemoveEntity(Entity* entity)
 void SkeletonSystem::PrepareForRemove()
 {
     entities.clear();
+    updatedSkeletons.clear();
 }
 
 void SkeletonSystem::ImmediateEvent(Component* component, uint32 event)
@@ -72,6 +80,7 @@ void SkeletonSystem::Process(float32 timeElapsed)
     UpdateTestSkeletons();
 #endif
 
+    updatedSkeletons.clear();
     for (int32 i = 0, sz = static_cast<int32>(entities.size()); i < sz; ++i)
     {
         SkeletonComponent* component = GetSkeletonComponent(entities[i]);
@@ -85,16 +94,51 @@ void SkeletonSystem::Process(float32 timeElapsed)
 
             if (component->startJoint != SkeletonComponent::INVALID_JOINT_INDEX)
             {
-                UpdateJointTransforms(component);
+                UpdatedSkeleton updated;
+                updated.skeleton = component;
+
                 RenderObject* ro = GetRenderObject(entities[i]);
                 if (ro != nullptr && (RenderObject::TYPE_SKINNED_MESH == ro->GetType()))
                 {
-                    UpdateSkinnedMesh(component, static_cast<SkinnedMesh*>(ro));
+                    updated.skinnedMesh = static_cast<SkinnedMesh*>(ro);
                 }
+                updatedSkeletons.push_back(updated);
+            }
+        }
+    }
+
+    // Skeletons touch only their own joints and skinned mesh, so they are updated in parallel
+    auto updateSkeletons = [this](uint32 begin, uint32 end) {
+        for (uint32 i = begin; i < end; ++i)
+        {
+            UpdateJointTransforms(updatedSkeletons[i].skeleton);
+            if (updatedSkeletons[i].skinnedMesh != nullptr)
+            {
+                UpdateSkinnedMeshJoints(updatedSkeletons[i].skeleton, updatedSkeletons[i].skinnedMesh);
             }
         }
+    };
+
+    uint32 updatedCount = static_cast<uint32>(updatedSkeletons.size());
+    JobManager* jobManager = GetEngineContext()->jobManager;
+    if (updatedCount > 1 && jobManager != nullptr && jobManager->GetWorkersCount() > 0)
+    {
+        jobManager->ParallelFor(0, updatedCount, 4, updateSkeletons);
+    }
+    else
+    {
+        updateSkeletons(0, updatedCount);
     }
 
+    for (const UpdatedSkeleton& updated : updatedSkeletons)
+    {
+        if (updated.skinnedMesh != nullptr)
+        {
+            GetScene()->GetRenderSystem()->MarkForUpdate(updated.skinnedMesh);
+        }
+    }
+    updatedSkeletons.clear();
+
     DrawSkeletons(GetScene()->renderSystem->GetDebugDrawer());
 }
 
@@ -183,6 +227,12 @@ void SkeletonSystem::UpdateJointTransforms(SkeletonComponent* skeleton)
 }
 
 void SkeletonSystem::UpdateSkinnedMesh(SkeletonComponent* skeleton, SkinnedMesh* skinnedMeshObject)
+{
+    UpdateSkinnedMeshJoints(skeleton, skinnedMeshObject);
+    GetScene()->GetRenderSystem()->MarkForUpdate(skinnedMeshObject);
+}
+
+void SkeletonSystem::UpdateSkinnedMeshJoints(SkeletonComponent* skeleton, SkinnedMesh* skinnedMeshObject)
 {
     DVASSERT(!skeleton->configUpdated);
 
@@ -199,8 +249,6 @@ void SkeletonSystem::UpdateSkinnedMesh(SkeletonComponent* skeleton, SkinnedMesh*
 
     skinnedMeshObject->UpdateJointTransforms(skeleton->finalTransforms);
     skinnedMeshObject->SetBoundingBox(resBox); //TODO: *Skinning* decide on bbox calculation
-
-    GetScene()->GetRenderSystem()->MarkForUpdate(skinnedMeshObject);
 }
 
 void SkeletonSystem::RebuildSkeleton(SkeletonComponent* skeleton)
@@ -28,13 +28,21 @@ public:
     void DrawSkeletons(RenderHelper* drawer);
 
 private:
+    struct UpdatedSkeleton
+    {
+        SkeletonComponent* skeleton = nullptr;
+        SkinnedMesh* skinnedMesh = nullptr;
+    };
+
     void UpdateJointTransforms(SkeletonComponent* skeleton);
+    void UpdateSkinnedMeshJoints(SkeletonComponent* skeleton, SkinnedMesh* skinnedMeshObject);
 
     void RebuildSkeleton(SkeletonComponent* skeleton);
 
     void UpdateTestSkeletons(float32 timeElapsed);
 
     Vector<Entity*> entities;
+    Vector<UpdatedSkeleton> updatedSkeletons;
 };
 
 } //ns
@@ -191,7 +191,7 @@ void StaticOcclusionBuildSystem::StartBuildOcclusion()
     if (nullptr == staticOcclusion)
         staticOcclusion = new StaticOcclusion();
 
-    staticOcclusion->StartBuildOcclusion(&data, GetScene()->GetRenderSystem(), landscape, occlusionComponent->GetOcclusionPixelThreshold(), occlusionComponent->GetOcclusionPixelThresholdForSpeedtree());
+    staticOcclusion->StartBuildOcclusion(&data, GetScene()->GetRenderSystem(), landscape, occlusionComponent->GetOcclusionPixelThreshold(), occlusionComponent->GetOcclusionPixelThresholdForSpeedtree(), softwareRasterization);
 }
 
 void StaticOcclusionBuildSystem::FinishBuildOcclusion()
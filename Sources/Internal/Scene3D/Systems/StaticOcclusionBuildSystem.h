@@ -32,6 +32,10 @@ public:
 
     void SetCamera(Camera* camera);
 
+    // Build occlusion with CPU rasterizer in worker threads instead of GPU occlusion queries, works without render device
+    void SetSoftwareRasterization(bool enabled);
+    bool IsSoftwareRasterization() const;
+
     void Build();
     void Cancel();
 
@@ -55,6 +59,7 @@ private:
     StaticOcclusionDataComponent* componentInProgress = nullptr;
     uint32 activeIndex = -1;
     uint32 objectsCount = 0;
+    bool softwareRasterization = false;
 };
 
 inline void StaticOcclusionBuildSystem::SetCamera(Camera* _camera)
@@ -62,6 +67,16 @@ inline void StaticOcclusionBuildSystem::SetCamera(Camera* _camera)
     camera = _camera;
 }
 
+inline void StaticOcclusionBuildSystem::SetSoftwareRasterization(bool enabled)
+{
+    softwareRasterization = enabled;
+}
+
+inline bool StaticOcclusionBuildSystem::IsSoftwareRasterization() const
+{
+    return softwareRasterization;
+}
+
 } // ns
 
 #endif /* __DAVAENGINE_SCENE3D_STATIC_OCCLUSION_SYSTEM_H__ */
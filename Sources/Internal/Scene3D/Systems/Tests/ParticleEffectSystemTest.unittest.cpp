@@ -0,0 +1,131 @@
+#include "UnitTests/UnitTests.h"
+
+#include "Base/RefPtr.h"
+#include "Base/ScopedPtr.h"
+#include "Engine/Engine.h"
+#include "Engine/EngineContext.h"
+#include "Particles/ParticleEmitter.h"
+#include "Particles/ParticleForceSimplified.h"
+#include "Particles/ParticleGroup.h"
+#include "Particles/ParticleLayer.h"
+#include "Scene3D/Components/ParticleEffectComponent.h"
+#include "Scene3D/Entity.h"
+#include "Scene3D/Scene.h"
+#include "Scene3D/Systems/ParticleEffectSystem.h"
+#include "Utils/Random.h"
+
+DAVA_TESTCLASS (ParticleEffectSystemTest)
+{
+    struct ParticleState
+    {
+        DAVA::Vector3 position;
+        DAVA::Vector3 speed;
+        DAVA::float32 angle = 0.f;
+        DAVA::float32 radius = 0.f;
+    };
+    using FrameState = DAVA::Vector<ParticleState>;
+
+    // Effect with single layer which is simulated in ParticleBuffer when buffered simulation is enabled
+    DAVA::ParticleEmitter* CreateEmitter()
+    {
+        using namespace DAVA;
+
+        ScopedPtr<ParticleLayer> layer(new ParticleLayer());
+        layer->type = ParticleLayer::TYPE_PARTICLES;
+        layer->life.Set(new PropertyLineValue<float32>(0.5f));
+        layer->lifeVariation.Set(new PropertyLineValue<float32>(0.5f));
+        layer->number.Set(new PropertyLineValue<float32>(200.f));
+        layer->size.Set(new PropertyLineValue<Vector2>(Vector2(1.f, 1.f)));
+        layer->sizeOverLifeXY.Set(new PropertyLineValue<Vector2>(Vector2(2.f, 0.5f)));
+        layer->velocity.Set(new PropertyLineValue<float32>(3.f));
+        layer->velocityVariation.Set(new PropertyLineValue<float32>(1.f));
+        layer->velocityOverLife.Set(new PropertyLineValue<float32>(0.75f));
+        layer->spin.Set(new PropertyLineValue<float32>(90.f));
+        layer->spinVariation.Set(new PropertyLineValue<float32>(45.f));
+
+        ScopedPtr<ParticleForceSimplified> gravity(new ParticleForceSimplified(RefPtr<PropertyLine<Vector3>>(new PropertyLineValue<Vector3>(Vector3(0.f, 0.f, -9.8f))), RefPtr<PropertyLine<float32>>()));
+        layer->AddSimplifiedForce(gravity);
+        ScopedPtr<ParticleForceSimplified> wind(new ParticleForceSimplified(RefPtr<PropertyLine<Vector3>>(new PropertyLineValue<Vector3>(Vector3(2.f, 1.f, 0.f))), RefPtr<PropertyLine<float32>>(new PropertyLineValue<float32>(0.5f))));
+        layer->AddSimplifiedForce(wind);
+
+        ParticleEmitter* emitter = new ParticleEmitter();
+        emitter->AddLayer(layer);
+        return emitter;
+    }
+
+    DAVA::Vector<FrameState> Simulate(bool bufferedSimulation, DAVA::uint32 framesCount)
+    {
+        using namespace DAVA;
+
+        ScopedPtr<Scene> scene(new Scene());
+        scene->particleEffectSystem->SetBufferedSimulationEnabled(bufferedSimulation);
+
+        ScopedPtr<ParticleEmitter> emitter(CreateEmitter());
+        ScopedPtr<Entity> entity(new Entity());
+        ParticleEffectComponent* effect = new ParticleEffectComponent();
+        effect->AddEmitterInstance(emitter);
+        entity->AddComponent(effect);
+        scene->AddNode(entity);
+        effect->Start();
+
+        Vector<FrameState> frames;
+        for (uint32 frame = 0; frame < framesCount; ++frame)
+        {
+            scene->particleEffectSystem->Process(1.f / 30.f);
+
+            FrameState state;
+            for (const ParticleGroup& group : effect->GetEffectData().groups)
+            {
+                for (Particle* particle = group.head; particle != nullptr; particle = particle->next)
+                {
+                    state.push_back({ particle->position, particle->speed, particle->angle, particle->currRadius });
+                }
+            }
+            frames.push_back(state);
+        }
+        return frames;
+    }
+
+    bool IsEqual(const DAVA::Vector3& v1, const DAVA::Vector3& v2)
+    {
+        const DAVA::float32 epsilon = 0.0001f;
+        return FLOAT_EQUAL_EPS(v1.x, v2.x, epsilon) && FLOAT_EQUAL_EPS(v1.y, v2.y, epsilon) && FLOAT_EQUAL_EPS(v1.z, v2.z, epsilon);
+    }
+
+    DAVA_TEST (BufferedSimulationMatchesPerParticleSimulation)
+    {
+        using namespace DAVA;
+
+        const uint32 framesCount = 30;
+
+        // Both runs generate the same particles from the same random sequence
+        Random* random = GetEngineContext()->random;
+        Vector<uint32> randomState(Random::SAVE);
+        random->Save(randomState.data());
+        Vector<FrameState> bufferedFrames = Simulate(true, framesCount);
+        random->Load(randomState.data());
+        Vector<FrameState> perParticleFrames = Simulate(false, framesCount);
+
+        TEST_VERIFY(bufferedFrames.size() == framesCount);
+        TEST_VERIFY(perParticleFrames.size() == framesCount);
+        TEST_VERIFY(!bufferedFrames.back().empty());
+        for (uint32 frame = 0; frame < framesCount; ++frame)
+        {
+            const FrameState& buffered = bufferedFrames[frame];
+            const FrameState& perParticle = perParticleFrames[frame];
+            TEST_VERIFY(buffered.size() == perParticle.size());
+            if (buffered.size() != perParticle.size())
+                break;
+
+            bool isEqual = true;
+            for (size_t i = 0; i < buffered.size(); ++i)
+            {
+                isEqual &= IsEqual(buffered[i].position, perParticle[i].position);
+                isEqual &= IsEqual(buffered[i].speed, perParticle[i].speed);
+                isEqual &= FLOAT_EQUAL_EPS(buffered[i].angle, perParticle[i].angle, 0.0001f);
+                isEqual &= FLOAT_EQUAL_EPS(buffered[i].radius, perParticle[i].radius, 0.0001f);
+            }
+            TEST_VERIFY(isEqual);
+        }
+    }
+};
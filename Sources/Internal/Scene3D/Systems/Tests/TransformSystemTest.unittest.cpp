@@ -0,0 +1,147 @@
+#include "UnitTests/UnitTests.h"
+
+#include "Base/RefPtr.h"
+#include "Entity/SortedEntityContainer.h"
+#include "Math/TransformUtils.h"
+#include "Scene3D/Components/SingleComponents/TransformSingleComponent.h"
+#include "Scene3D/Components/TransformComponent.h"
+#include "Scene3D/Entity.h"
+#include "Scene3D/Scene.h"
+#include "Scene3D/Systems/TransformSystem.h"
+
+DAVA_TESTCLASS (TransformSystemTest)
+{
+    // Build identical hierarchies in both scenes: `rootsCount` top-level entities, each with chain and fan of children
+    void BuildHierarchy(DAVA::Scene * scene, DAVA::uint32 rootsCount, DAVA::Vector<DAVA::Entity*> & entities)
+    {
+        using namespace DAVA;
+
+        for (uint32 r = 0; r < rootsCount; ++r)
+        {
+            RefPtr<Entity> root(new Entity());
+            root->GetComponent<TransformComponent>()->SetLocalTranslation(Vector3(float32(r), 0.f, 0.f));
+            scene->AddNode(root.Get());
+            entities.push_back(root.Get());
+
+            Entity* parent = root.Get();
+            for (uint32 depth = 0; depth < 4; ++depth)
+            {
+                for (uint32 i = 0; i < 3; ++i)
+                {
+                    RefPtr<Entity> child(new Entity());
+                    TransformComponent* tc = child->GetComponent<TransformComponent>();
+                    tc->SetLocalTranslation(Vector3(1.f, float32(i), float32(depth)));
+                    tc->SetLocalRotation(Quaternion::MakeRotation(Vector3(0.f, 0.f, 1.f), 0.1f * float32(i + depth)));
+                    tc->SetLocalScale(Vector3(1.f + 0.1f * float32(i), 1.f, 1.f));
+                    parent->AddNode(child.Get());
+                    entities.push_back(child.Get());
+                }
+                parent = parent->GetChild(0);
+            }
+        }
+    }
+
+    void UpdateTransforms(DAVA::Scene * scene)
+    {
+        scene->transformSystem->Process(0.f);
+        scene->transformSingleComponent->Clear();
+    }
+
+    bool IsEqual(const DAVA::Transform& t1, const DAVA::Transform& t2)
+    {
+        using namespace DAVA;
+
+        const float32 epsilon = 0.001f;
+        const Quaternion& r1 = t1.GetRotation();
+        const Quaternion& r2 = t2.GetRotation();
+        return FLOAT_EQUAL_EPS(t1.GetTranslation().x, t2.GetTranslation().x, epsilon) && FLOAT_EQUAL_EPS(t1.GetTranslation().y, t2.GetTranslation().y, epsilon) &&
+        FLOAT_EQUAL_EPS(t1.GetTranslation().z, t2.GetTranslation().z, epsilon) && FLOAT_EQUAL_EPS(t1.GetScale().x, t2.GetScale().x, epsilon) &&
+        FLOAT_EQUAL_EPS(t1.GetScale().y, t2.GetScale().y, epsilon) && FLOAT_EQUAL_EPS(t1.GetScale().z, t2.GetScale().z, epsilon) &&
+        FLOAT_EQUAL_EPS(r1.x, r2.x, epsilon) && FLOAT_EQUAL_EPS(r1.y, r2.y, epsilon) && FLOAT_EQUAL_EPS(r1.z, r2.z, epsilon) && FLOAT_EQUAL_EPS(r1.w, r2.w, epsilon);
+    }
+
+    bool IsEqual(const DAVA::Vector<DAVA::Entity*>& entities1, const DAVA::Vector<DAVA::Entity*>& entities2)
+    {
+        using namespace DAVA;
+
+        if (entities1.size() != entities2.size())
+        {
+            return false;
+        }
+
+        for (size_t i = 0; i < entities1.size(); ++i)
+        {
+            const TransformComponent* tc1 = entities1[i]->GetComponent<TransformComponent>();
+            const TransformComponent* tc2 = entities2[i]->GetComponent<TransformComponent>();
+            if (!IsEqual(tc1->GetWorldTransform(), tc2->GetWorldTransform()))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    DAVA_TEST (LinearUpdateMatchesDefault)
+    {
+        using namespace DAVA;
+
+        // Linear update is enabled by scene
+        RefPtr<Scene> defaultScene(new Scene());
+        RefPtr<Scene> linearScene(new Scene());
+        TEST_VERIFY(linearScene->transformSystem->IsLinearUpdateEnabled());
+        defaultScene->transformSystem->SetLinearUpdateEnabled(false);
+        TEST_VERIFY(!defaultScene->transformSystem->IsLinearUpdateEnabled());
+
+        // Enough roots to split linear hierarchy into several batches, count isn't multiple of four
+        // so the last group of lanes at some depth levels is partially filled
+        const uint32 rootsCount = 201;
+        Vector<Entity*> defaultEntities;
+        Vector<Entity*> linearEntities;
+        BuildHierarchy(defaultScene.Get(), rootsCount, defaultEntities);
+        BuildHierarchy(linearScene.Get(), rootsCount, linearEntities);
+
+        UpdateTransforms(defaultScene.Get());
+        UpdateTransforms(linearScene.Get());
+        TEST_VERIFY(IsEqual(defaultEntities, linearEntities));
+
+        // Change local transform in the middle of hierarchy
+        for (Vector<Entity*>* entities : { &defaultEntities, &linearEntities })
+        {
+            for (size_t i = 1; i < entities->size(); i += 7)
+            {
+                (*entities)[i]->GetComponent<TransformComponent>()->SetLocalTranslation(Vector3(2.f, float32(i), 0.f));
+            }
+        }
+
+        UpdateTransforms(defaultScene.Get());
+        linearScene->transformSystem->Process(0.f);
+        TEST_VERIFY(!linearScene->transformSingleComponent->worldTransformChanged.map.empty());
+        linearScene->transformSingleComponent->Clear();
+        TEST_VERIFY(IsEqual(defaultEntities, linearEntities));
+
+        // Reparent subtree to another root
+        for (Vector<Entity*>* entities : { &defaultEntities, &linearEntities })
+        {
+            Entity* subtree = (*entities)[1];
+            subtree->Retain();
+            subtree->GetParent()->RemoveNode(subtree);
+            (*entities)[entities->size() - 1]->AddNode(subtree);
+            subtree->Release();
+        }
+
+        UpdateTransforms(defaultScene.Get());
+        UpdateTransforms(linearScene.Get());
+        TEST_VERIFY(IsEqual(defaultEntities, linearEntities));
+
+        // Switch back to default mode and change transform of top-level entity
+        linearScene->transformSystem->SetLinearUpdateEnabled(false);
+        for (Vector<Entity*>* entities : { &defaultEntities, &linearEntities })
+        {
+            (*entities)[0]->GetComponent<TransformComponent>()->SetLocalScale(Vector3(2.f, 2.f, 2.f));
+        }
+
+        UpdateTransforms(defaultScene.Get());
+        UpdateTransforms(linearScene.Get());
+        TEST_VERIFY(IsEqual(defaultEntities, linearEntities));
+    }
+};
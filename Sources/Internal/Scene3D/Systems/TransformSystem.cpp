@@ -1,17 +1,301 @@
 #include "Debug/DVAssert.h"
 #include "Debug/ProfilerCPU.h"
 #include "Debug/ProfilerMarkerNames.h"
+#include "Engine/Engine.h"
+#include "Engine/EngineContext.h"
+#include "Job/JobManager.h"
 #include "Scene3D/Components/AnimationComponent.h"
 #include "Scene3D/Components/ComponentHelpers.h"
 #include "Math/Transform.h"
+#include "Math/TransformUtils.h"
 #include "Scene3D/Components/SingleComponents/TransformSingleComponent.h"
 #include "Scene3D/Components/TransformComponent.h"
 #include "Scene3D/Entity.h"
 #include "Scene3D/Scene.h"
 #include "Scene3D/Systems/TransformSystem.h"
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define TRANSFORM_SYSTEM_SSE
+#include <emmintrin.h>
+#elif defined(__ARM_NEON__) || defined(__ARM_NEON)
+#define TRANSFORM_SYSTEM_NEON
+#include <arm_neon.h>
+#endif
+
 namespace DAVA
 {
+namespace TransformSystemDetails
+{
+// Minimal number of slots processed by one job in linear mode
+const uint32 LINEAR_BATCH_SIZE = 1024;
+const uint32 LANES_COUNT = 4;
+
+// Indices of component arrays in TransformArrays and TransformLanes
+enum eTransformComponent
+{
+    TRANSLATION_X,
+    TRANSLATION_Y,
+    TRANSLATION_Z,
+    SCALE_X,
+    SCALE_Y,
+    SCALE_Z,
+    ROTATION_X,
+    ROTATION_Y,
+    ROTATION_Z,
+    ROTATION_W,
+    TRANSFORM_COMPONENTS_COUNT
+};
+
+// Rotation-scale part of world matrix, element `i` is Matrix4::_data[i / 3][i % 3]
+const uint32 BASIS_COMPONENTS_COUNT = 9;
+
+// Components of four transforms or matrices, one row per component
+using TransformLanes = float32[TRANSFORM_COMPONENTS_COUNT][LANES_COUNT];
+using BasisLanes = float32[BASIS_COMPONENTS_COUNT][LANES_COUNT];
+
+struct ScalarOps
+{
+    using Value = float32;
+
+    static Value Load(const float32* p)
+    {
+        return *p;
+    }
+    static void Store(float32* p, Value v)
+    {
+        *p = v;
+    }
+    static Value Splat(float32 v)
+    {
+        return v;
+    }
+    static Value Add(Value a, Value b)
+    {
+        return a + b;
+    }
+    static Value Sub(Value a, Value b)
+    {
+        return a - b;
+    }
+    static Value Mul(Value a, Value b)
+    {
+        return a * b;
+    }
+};
+
+#if defined(TRANSFORM_SYSTEM_SSE)
+struct SimdOps
+{
+    using Value = __m128;
+
+    static Value Load(const float32* p)
+    {
+        return _mm_loadu_ps(p);
+    }
+    static void Store(float32* p, Value v)
+    {
+        _mm_storeu_ps(p, v);
+    }
+    static Value Splat(float32 v)
+    {
+        return _mm_set1_ps(v);
+    }
+    static Value Add(Value a, Value b)
+    {
+        return _mm_add_ps(a, b);
+    }
+    static Value Sub(Value a, Value b)
+    {
+        return _mm_sub_ps(a, b);
+    }
+    static Value Mul(Value a, Value b)
+    {
+        return _mm_mul_ps(a, b);
+    }
+};
+#elif defined(TRANSFORM_SYSTEM_NEON)
+struct SimdOps
+{
+    using Value = float32x4_t;
+
+    static Value Load(const float32* p)
+    {
+        return vld1q_f32(p);
+    }
+    static void Store(float32* p, Value v)
+    {
+        vst1q_f32(p, v);
+    }
+    static Value Splat(float32 v)
+    {
+        return vdupq_n_f32(v);
+    }
+    static Value Add(Value a, Value b)
+    {
+        return vaddq_f32(a, b);
+    }
+    static Value Sub(Value a, Value b)
+    {
+        return vsubq_f32(a, b);
+    }
+    static Value Mul(Value a, Value b)
+    {
+        return vmulq_f32(a, b);
+    }
+};
+#endif
+
+/**
+    Compute `world = local * parent` as Transform::operator* does and rotation-scale part of world matrix
+    as TransformUtils::ToMatrix does. Every pointer addresses one component of as many transforms as `Ops::Value` holds.
+*/
+template <typename Ops>
+void MultiplyTransforms(const float32* const* local, const float32* const* parent, float32* const* world, float32* const* basis)
+{
+    using V = typename Ops::Value;
+
+    const V half = Ops::Splat(0.5f);
+    const V one = Ops::Splat(1.f);
+
+    const V px = Ops::Load(parent[ROTATION_X]);
+    const V py = Ops::Load(parent[ROTATION_Y]);
+    const V pz = Ops::Load(parent[ROTATION_Z]);
+    const V pw = Ops::Load(parent[ROTATION_W]);
+    const V lx = Ops::Load(local[ROTATION_X]);
+    const V ly = Ops::Load(local[ROTATION_Y]);
+    const V lz = Ops::Load(local[ROTATION_Z]);
+    const V lw = Ops::Load(local[ROTATION_W]);
+
+    // Rotation is parent rotation multiplied by local one, see Quaternion::Mul
+    const V a = Ops::Mul(Ops::Add(pw, px), Ops::Add(lw, lx));
+    const V b = Ops::Mul(Ops::Sub(pz, py), Ops::Sub(ly, lz));
+    const V c = Ops::Mul(Ops::Sub(px, pw), Ops::Add(ly, lz));
+    const V d = Ops::Mul(Ops::Add(py, pz), Ops::Sub(lx, lw));
+    const V e = Ops::Mul(Ops::Add(px, pz), Ops::Add(lx, ly));
+    const V f = Ops::Mul(Ops::Sub(px, pz), Ops::Sub(lx, ly));
+    const V g = Ops::Mul(Ops::Add(pw, py), Ops::Sub(lw, lz));
+    const V h = Ops::Mul(Ops::Sub(pw, py), Ops::Add(lw, lz));
+
+    const V rw = Ops::Add(b, Ops::Mul(Ops::Sub(Ops::Add(g, h), Ops::Add(e, f)), half));
+    const V rx = Ops::Sub(a, Ops::Mul(Ops::Add(Ops::Add(e, f), Ops::Add(g, h)), half));
+    const V ry = Ops::Sub(Ops::Mul(Ops::Add(Ops::Sub(e, f), Ops::Sub(g, h)), half), c);
+    const V rz = Ops::Sub(Ops::Mul(Ops::Add(Ops::Sub(e, f), Ops::Sub(h, g)), half), d);
+
+    const V psx = Ops::Load(parent[SCALE_X]);
+    const V psy = Ops::Load(parent[SCALE_Y]);
+    const V psz = Ops::Load(parent[SCALE_Z]);
+    const V sx = Ops::Mul(psx, Ops::Load(local[SCALE_X]));
+    const V sy = Ops::Mul(psy, Ops::Load(local[SCALE_Y]));
+    const V sz = Ops::Mul(psz, Ops::Load(local[SCALE_Z]));
+
+    // Local translation is rotated by parent rotation (see Quaternion::ApplyToVectorFast), scaled and moved by parent
+    const V vx = Ops::Load(local[TRANSLATION_X]);
+    const V vy = Ops::Load(local[TRANSLATION_Y]);
+    const V vz = Ops::Load(local[TRANSLATION_Z]);
+    const V two = Ops::Add(one, one);
+    const V tx = Ops::Mul(two, Ops::Sub(Ops::Mul(py, vz), Ops::Mul(pz, vy)));
+    const V ty = Ops::Mul(two, Ops::Sub(Ops::Mul(pz, vx), Ops::Mul(px, vz)));
+    const V tz = Ops::Mul(two, Ops::Sub(Ops::Mul(px, vy), Ops::Mul(py, vx)));
+    const V ox = Ops::Add(Ops::Add(vx, Ops::Mul(pw, tx)), Ops::Sub(Ops::Mul(py, tz), Ops::Mul(pz, ty)));
+    const V oy = Ops::Add(Ops::Add(vy, Ops::Mul(pw, ty)), Ops::Sub(Ops::Mul(pz, tx), Ops::Mul(px, tz)));
+    const V oz = Ops::Add(Ops::Add(vz, Ops::Mul(pw, tz)), Ops::Sub(Ops::Mul(px, ty), Ops::Mul(py, tx)));
+
+    Ops::Store(world[TRANSLATION_X], Ops::Add(Ops::Mul(ox, psx), Ops::Load(parent[TRANSLATION_X])));
+    Ops::Store(world[TRANSLATION_Y], Ops::Add(Ops::Mul(oy, psy), Ops::Load(parent[TRANSLATION_Y])));
+    Ops::Store(world[TRANSLATION_Z], Ops::Add(Ops::Mul(oz, psz), Ops::Load(parent[TRANSLATION_Z])));
+    Ops::Store(world[SCALE_X], sx);
+    Ops::Store(world[SCALE_Y], sy);
+    Ops::Store(world[SCALE_Z], sz);
+    Ops::Store(world[ROTATION_X], rx);
+    Ops::Store(world[ROTATION_Y], ry);
+    Ops::Store(world[ROTATION_Z], rz);
+    Ops::Store(world[ROTATION_W], rw);
+
+    // Rows of rotation matrix scaled by world scale, see Quaternion::GetMatrix
+    const V x2 = Ops::Add(rx, rx);
+    const V y2 = Ops::Add(ry, ry);
+    const V z2 = Ops::Add(rz, rz);
+    const V xx = Ops::Mul(rx, x2);
+    const V xy = Ops::Mul(rx, y2);
+    const V xz = Ops::Mul(rx, z2);
+    const V yy = Ops::Mul(ry, y2);
+    const V yz = Ops::Mul(ry, z2);
+    const V zz = Ops::Mul(rz, z2);
+    const V wx = Ops::Mul(rw, x2);
+    const V wy = Ops::Mul(rw, y2);
+    const V wz = Ops::Mul(rw, z2);
+
+    Ops::Store(basis[0], Ops::Mul(sx, Ops::Sub(one, Ops::Add(yy, zz))));
+    Ops::Store(basis[1], Ops::Mul(sx, Ops::Add(xy, wz)));
+    Ops::Store(basis[2], Ops::Mul(sx, Ops::Sub(xz, wy)));
+    Ops::Store(basis[3], Ops::Mul(sy, Ops::Sub(xy, wz)));
+    Ops::Store(basis[4], Ops::Mul(sy, Ops::Sub(one, Ops::Add(xx, zz))));
+    Ops::Store(basis[5], Ops::Mul(sy, Ops::Add(yz, wx)));
+    Ops::Store(basis[6], Ops::Mul(sz, Ops::Add(xz, wy)));
+    Ops::Store(basis[7], Ops::Mul(sz, Ops::Sub(yz, wx)));
+    Ops::Store(basis[8], Ops::Mul(sz, Ops::Sub(one, Ops::Add(xx, yy))));
+}
+
+void SetLane(TransformLanes& lanes, uint32 lane, const Transform& transform)
+{
+    const Vector3& translation = transform.GetTranslation();
+    const Vector3& scale = transform.GetScale();
+    const Quaternion& rotation = transform.GetRotation();
+    lanes[TRANSLATION_X][lane] = translation.x;
+    lanes[TRANSLATION_Y][lane] = translation.y;
+    lanes[TRANSLATION_Z][lane] = translation.z;
+    lanes[SCALE_X][lane] = scale.x;
+    lanes[SCALE_Y][lane] = scale.y;
+    lanes[SCALE_Z][lane] = scale.z;
+    lanes[ROTATION_X][lane] = rotation.x;
+    lanes[ROTATION_Y][lane] = rotation.y;
+    lanes[ROTATION_Z][lane] = rotation.z;
+    lanes[ROTATION_W][lane] = rotation.w;
+}
+}
+
+const uint32 TransformSystem::INVALID_SLOT;
+const uint32 TransformSystem::TransformArrays::COMPONENTS_COUNT;
+
+void TransformSystem::TransformArrays::Resize(uint32 size)
+{
+    static_assert(COMPONENTS_COUNT == TransformSystemDetails::TRANSFORM_COMPONENTS_COUNT, "Components of TransformArrays and TransformLanes should match");
+
+    // Padding allows to load four values starting from any index
+    for (Vector<float32>& component : components)
+    {
+        component.resize(size + TransformSystemDetails::LANES_COUNT - 1);
+    }
+}
+
+void TransformSystem::TransformArrays::Set(uint32 index, const Transform& transform)
+{
+    using namespace TransformSystemDetails;
+
+    const Vector3& translation = transform.GetTranslation();
+    const Vector3& scale = transform.GetScale();
+    const Quaternion& rotation = transform.GetRotation();
+    components[TRANSLATION_X][index] = translation.x;
+    components[TRANSLATION_Y][index] = translation.y;
+    components[TRANSLATION_Z][index] = translation.z;
+    components[SCALE_X][index] = scale.x;
+    components[SCALE_Y][index] = scale.y;
+    components[SCALE_Z][index] = scale.z;
+    components[ROTATION_X][index] = rotation.x;
+    components[ROTATION_Y][index] = rotation.y;
+    components[ROTATION_Z][index] = rotation.z;
+    components[ROTATION_W][index] = rotation.w;
+}
+
+Transform TransformSystem::TransformArrays::Get(uint32 index) const
+{
+    using namespace TransformSystemDetails;
+
+    return Transform(Vector3(components[TRANSLATION_X][index], components[TRANSLATION_Y][index], components[TRANSLATION_Z][index]),
+                     Vector3(components[SCALE_X][index], components[SCALE_Y][index], components[SCALE_Z][index]),
+                     Quaternion(components[ROTATION_X][index], components[ROTATION_Y][index], components[ROTATION_Z][index], components[ROTATION_W][index]));
+}
+
 TransformSystem::TransformSystem(Scene* scene)
     : SceneSystem(scene)
 {
@@ -21,6 +305,12 @@ void TransformSystem::Process(float32 timeElapsed)
 {
     DAVA_PROFILER_CPU_SCOPE(ProfilerCPUMarkerName::SCENE_TRANSFORM_SYSTEM);
 
+    if (linearUpdateEnabled)
+    {
+        ProcessLinear();
+        return;
+    }
+
     TransformSingleComponent* tsc = GetScene()->transformSingleComponent;
     for (Entity* e : tsc->localTransformChanged)
     {
@@ -153,12 +443,27 @@ void TransformSystem::HierarchicAddToUpdate(Entity* entity)
 
 void TransformSystem::AddEntity(Entity* entity)
 {
+    if (linearUpdateEnabled)
+    {
+        linear.entitySlots.emplace(entity, INVALID_SLOT);
+        linear.addedEntities.push_back(entity);
+        linear.hierarchyChanged = true;
+        return;
+    }
+
     EntityNeedUpdate(entity);
     HierarchicAddToUpdate(entity);
 }
 
 void TransformSystem::RemoveEntity(Entity* entity)
 {
+    if (linearUpdateEnabled)
+    {
+        linear.entitySlots.erase(entity);
+        linear.addedEntities.erase(std::remove(linear.addedEntities.begin(), linear.addedEntities.end(), entity), linear.addedEntities.end());
+        linear.hierarchyChanged = true;
+    }
+
     //TODO: use hashmap
     uint32 size = static_cast<uint32>(updatableEntities.size());
     for (uint32 i = 0; i < size; ++i)
@@ -186,5 +491,392 @@ void TransformSystem::PrepareForRemove()
     }
 
     updatableEntities.clear();
+    linear = LinearHierarchy();
+}
+
+void TransformSystem::SetLinearUpdateEnabled(bool enabled)
+{
+    if (linearUpdateEnabled == enabled)
+    {
+        return;
+    }
+
+    if (enabled)
+    {
+        // Finish updates scheduled in default mode, so entity flags are clean while linear mode is active
+        uint32 size = static_cast<uint32>(updatableEntities.size());
+        for (uint32 i = 0; i < size; ++i)
+        {
+            FindNodeThatRequireUpdate(updatableEntities[i]);
+        }
+        updatableEntities.clear();
+
+        linearUpdateEnabled = true;
+        RegisterLinearEntitiesRecursive(GetScene());
+        linear.hierarchyChanged = true;
+    }
+    else
+    {
+        linearUpdateEnabled = false;
+        for (Entity* entity : linear.addedEntities)
+        {
+            EntityNeedUpdate(entity);
+            HierarchicAddToUpdate(entity);
+        }
+        linear = LinearHierarchy();
+    }
+}
+
+void TransformSystem::RegisterLinearEntitiesRecursive(Entity* entity)
+{
+    uint32 size = entity->GetChildrenCount();
+    for (uint32 i = 0; i < size; ++i)
+    {
+        Entity* child = entity->GetChild(i);
+        if (child->GetComponent<TransformComponent>() != nullptr)
+        {
+            linear.entitySlots.emplace(child, INVALID_SLOT);
+        }
+        RegisterLinearEntitiesRecursive(child);
+    }
+}
+
+void TransformSystem::ProcessLinear()
+{
+    TransformSingleComponent* tsc = GetScene()->transformSingleComponent;
+
+    if (linear.hierarchyChanged || !tsc->transformParentChanged.empty())
+    {
+        RebuildLinearHierarchy();
+        for (Entity* e : linear.addedEntities)
+        {
+            MarkLinearSlotDirty(e);
+        }
+        linear.addedEntities.clear();
+    }
+
+    for (Entity* e : tsc->localTransformChanged)
+    {
+        MarkLinearSlotDirty(e);
+    }
+    for (Entity* e : tsc->transformParentChanged)
+    {
+        MarkLinearSlotDirty(e);
+    }
+    for (Entity* e : tsc->animationTransformChanged)
+    {
+        MarkLinearSlotDirty(e);
+    }
+
+    uint32 batchesCount = linear.batchLevels.empty() ? 0 : static_cast<uint32>(linear.batchLevels.size()) - 1;
+    JobManager* jobManager = GetEngineContext()->jobManager;
+    if (batchesCount > 1 && jobManager != nullptr && jobManager->GetWorkersCount() > 0)
+    {
+        jobManager->ParallelFor(0, batchesCount, 1, [this](uint32 begin, uint32 end) {
+            for (uint32 batch = begin; batch < end; ++batch)
+            {
+                TransformLinearBatch(batch);
+            }
+        });
+    }
+    else
+    {
+        for (uint32 batch = 0; batch < batchesCount; ++batch)
+        {
+            TransformLinearBatch(batch);
+        }
+    }
+
+    passedNodes = 0;
+    multipliedNodes = 0;
+
+    // Write results back on calling thread, as TransformSingleComponent is not thread-safe
+    uint32 slotsCount = static_cast<uint32>(linear.entities.size());
+    for (uint32 slot = 0; slot < slotsCount; ++slot)
+    {
+        if (linear.dirty[slot] != 0)
+        {
+            linear.dirty[slot] = 0;
+
+            TransformComponent* transform = linear.transforms[slot];
+            if (transform->parentTransform != nullptr)
+            {
+                transform->worldTransform = linear.worlds.Get(slot);
+                transform->worldMatrix = linear.worldMatrices[slot];
+                tsc->worldTransformChanged.Push(linear.entities[slot]);
+                multipliedNodes++;
+            }
+        }
+    }
+    passedNodes = static_cast<int32>(slotsCount);
+}
+
+void TransformSystem::RebuildLinearHierarchy()
+{
+    using namespace TransformSystemDetails;
+
+    linear.entities.clear();
+    linear.transforms.clear();
+    linear.parents.clear();
+    linear.levelOffsets.clear();
+    linear.batchLevels.clear();
+
+    Vector<Entity*> roots;
+    for (auto& entry : linear.entitySlots)
+    {
+        entry.second = INVALID_SLOT;
+
+        Entity* parent = entry.first->GetParent();
+        if (parent == nullptr || linear.entitySlots.count(parent) == 0)
+        {
+            roots.push_back(entry.first);
+        }
+    }
+
+    // Count slots of every top-level subtree to group subtrees into batches
+    Vector<uint32> subtreeSizes;
+    subtreeSizes.reserve(roots.size());
+    Vector<Entity*> stack;
+    for (Entity* root : roots)
+    {
+        uint32 subtreeSize = 0;
+        stack.push_back(root);
+        while (!stack.empty())
+        {
+            Entity* entity = stack.back();
+            stack.pop_back();
+            ++subtreeSize;
+
+            uint32 childrenCount = entity->GetChildrenCount();
+            for (uint32 i = 0; i < childrenCount; ++i)
+            {
+                Entity* child = entity->GetChild(i);
+                if (linear.entitySlots.count(child) != 0)
+                {
+                    stack.push_back(child);
+                }
+            }
+        }
+        subtreeSizes.push_back(subtreeSize);
+    }
+
+    uint32 entitiesCount = static_cast<uint32>(linear.entitySlots.size());
+    linear.entities.reserve(entitiesCount);
+    linear.transforms.reserve(entitiesCount);
+    linear.parents.reserve(entitiesCount);
+
+    auto addSlot = [this](Entity* entity, uint32& slotRef, uint32 parentSlot) {
+        slotRef = static_cast<uint32>(linear.entities.size());
+        linear.entities.push_back(entity);
+        linear.transforms.push_back(entity->GetComponent<TransformComponent>());
+        linear.parents.push_back(parentSlot);
+    };
+
+    // Subtrees of every batch are laid out in breadth-first order starting from all their roots at once,
+    // so slots of batch are sorted by depth and every batch can be processed independently
+    linear.levelOffsets.push_back(0);
+    linear.batchLevels.push_back(0);
+    size_t rootIndex = 0;
+    while (rootIndex < roots.size())
+    {
+        uint32 levelBegin = static_cast<uint32>(linear.entities.size());
+        uint32 batchSize = 0;
+        while (rootIndex < roots.size() && batchSize < LINEAR_BATCH_SIZE)
+        {
+            Entity* root = roots[rootIndex];
+            addSlot(root, linear.entitySlots[root], INVALID_SLOT);
+            batchSize += subtreeSizes[rootIndex];
+            ++rootIndex;
+        }
+
+        while (levelBegin < linear.entities.size())
+        {
+            uint32 levelEnd = static_cast<uint32>(linear.entities.size());
+            linear.levelOffsets.push_back(levelEnd);
+
+            for (uint32 slot = levelBegin; slot < levelEnd; ++slot)
+            {
+                Entity* entity = linear.entities[slot];
+                uint32 childrenCount = entity->GetChildrenCount();
+                for (uint32 i = 0; i < childrenCount; ++i)
+                {
+                    auto found = linear.entitySlots.find(entity->GetChild(i));
+                    if (found != linear.entitySlots.end())
+                    {
+                        addSlot(found->first, found->second, slot);
+                    }
+                }
+            }
+            levelBegin = levelEnd;
+        }
+
+        linear.batchLevels.push_back(static_cast<uint32>(linear.levelOffsets.size()) - 1);
+    }
+
+    uint32 slotsCount = static_cast<uint32>(linear.entities.size());
+    linear.locals.Resize(slotsCount);
+    linear.worlds.Resize(slotsCount);
+    linear.worldMatrices.resize(slotsCount);
+    linear.dirty.assign(slotsCount, 0);
+    for (uint32 slot = 0; slot < slotsCount; ++slot)
+    {
+        UpdateLinearSlotLocal(slot);
+        linear.worlds.Set(slot, linear.transforms[slot]->worldTransform);
+    }
+
+    linear.hierarchyChanged = false;
+}
+
+void TransformSystem::MarkLinearSlotDirty(Entity* entity)
+{
+    auto found = linear.entitySlots.find(entity);
+    if (found != linear.entitySlots.end() && found->second != INVALID_SLOT)
+    {
+        UpdateLinearSlotLocal(found->second);
+        linear.dirty[found->second] = 1;
+    }
+}
+
+void TransformSystem::UpdateLinearSlotLocal(uint32 slot)
+{
+    TransformComponent* transform = linear.transforms[slot];
+    AnimationComponent* animComp = GetAnimationComponent(linear.entities[slot]);
+    if (animComp)
+    {
+        linear.locals.Set(slot, Transform(animComp->animationTransform) * transform->localTransform);
+    }
+    else
+    {
+        linear.locals.Set(slot, transform->localTransform);
+    }
+}
+
+void TransformSystem::TransformLinearBatch(uint32 batch)
+{
+    // Parents of slots at one depth level are placed at previous levels, so their dirty flags
+    // and world transforms are final when level is processed
+    for (uint32 level = linear.batchLevels[batch]; level < linear.batchLevels[batch + 1]; ++level)
+    {
+        uint32 end = linear.levelOffsets[level + 1];
+        for (uint32 first = linear.levelOffsets[level]; first < end; first += TransformSystemDetails::LANES_COUNT)
+        {
+            TransformLinearLanes(first, Min(end - first, TransformSystemDetails::LANES_COUNT));
+        }
+    }
+}
+
+void TransformSystem::TransformLinearLanes(uint32 first, uint32 count)
+{
+    using namespace TransformSystemDetails;
+
+    const uint32* parents = linear.parents.data();
+    uint8* dirty = linear.dirty.data();
+
+    // Parent transforms are gathered into lanes, unused lanes are filled with identity
+    alignas(16) TransformLanes parentLanes;
+    bool copyWorld[LANES_COUNT] = {};
+    bool anyDirty = false;
+    for (uint32 lane = 0; lane < LANES_COUNT; ++lane)
+    {
+        uint32 slot = first + lane;
+        if (lane >= count)
+        {
+            SetLane(parentLanes, lane, Transform());
+            continue;
+        }
+
+        uint32 parent = parents[slot];
+        if (parent != INVALID_SLOT)
+        {
+            dirty[slot] |= dirty[parent];
+            for (uint32 c = 0; c < TRANSFORM_COMPONENTS_COUNT; ++c)
+            {
+                parentLanes[c][lane] = linear.worlds.components[c][parent];
+            }
+        }
+        else
+        {
+            // Parent of top-level slot is not handled by system (usually it is scene itself)
+            const TransformComponent* transform = linear.transforms[slot];
+            copyWorld[lane] = (transform->parentTransform == nullptr);
+            SetLane(parentLanes, lane, copyWorld[lane] ? Transform() : *(transform->parentTransform));
+        }
+        anyDirty |= (dirty[slot] != 0);
+    }
+
+    if (!anyDirty)
+    {
+        return;
+    }
+
+    const float32* localPtrs[TRANSFORM_COMPONENTS_COUNT];
+    const float32* parentPtrs[TRANSFORM_COMPONENTS_COUNT];
+    alignas(16) TransformLanes worldLanes;
+    float32* worldPtrs[TRANSFORM_COMPONENTS_COUNT];
+    for (uint32 c = 0; c < TRANSFORM_COMPONENTS_COUNT; ++c)
+    {
+        localPtrs[c] = linear.locals.components[c].data() + first;
+        parentPtrs[c] = parentLanes[c];
+        worldPtrs[c] = worldLanes[c];
+    }
+
+    alignas(16) BasisLanes basisLanes;
+    float32* basisPtrs[BASIS_COMPONENTS_COUNT];
+    for (uint32 i = 0; i < BASIS_COMPONENTS_COUNT; ++i)
+    {
+        basisPtrs[i] = basisLanes[i];
+    }
+
+#if defined(TRANSFORM_SYSTEM_SSE) || defined(TRANSFORM_SYSTEM_NEON)
+    MultiplyTransforms<SimdOps>(localPtrs, parentPtrs, worldPtrs, basisPtrs);
+#else
+    for (uint32 lane = 0; lane < LANES_COUNT; ++lane)
+    {
+        MultiplyTransforms<ScalarOps>(localPtrs, parentPtrs, worldPtrs, basisPtrs);
+        for (uint32 c = 0; c < TRANSFORM_COMPONENTS_COUNT; ++c)
+        {
+            ++localPtrs[c];
+            ++parentPtrs[c];
+            ++worldPtrs[c];
+        }
+        for (uint32 i = 0; i < BASIS_COMPONENTS_COUNT; ++i)
+        {
+            ++basisPtrs[i];
+        }
+    }
+#endif
+
+    for (uint32 lane = 0; lane < count; ++lane)
+    {
+        uint32 slot = first + lane;
+        if (dirty[slot] == 0)
+        {
+            continue;
+        }
+
+        if (copyWorld[lane])
+        {
+            const Transform& worldTransform = linear.transforms[slot]->worldTransform;
+            linear.worlds.Set(slot, worldTransform);
+            linear.worldMatrices[slot] = TransformUtils::ToMatrix(worldTransform);
+            continue;
+        }
+
+        for (uint32 c = 0; c < TRANSFORM_COMPONENTS_COUNT; ++c)
+        {
+            linear.worlds.components[c][slot] = worldLanes[c][lane];
+        }
+
+        Matrix4& worldMatrix = linear.worldMatrices[slot];
+        for (uint32 i = 0; i < BASIS_COMPONENTS_COUNT; ++i)
+        {
+            worldMatrix._data[i / 3][i % 3] = basisLanes[i][lane];
+        }
+        worldMatrix._03 = worldMatrix._13 = worldMatrix._23 = 0.f;
+        worldMatrix._30 = worldLanes[TRANSLATION_X][lane];
+        worldMatrix._31 = worldLanes[TRANSLATION_Y][lane];
+        worldMatrix._32 = worldLanes[TRANSLATION_Z][lane];
+        worldMatrix._33 = 1.f;
+    }
 }
 };
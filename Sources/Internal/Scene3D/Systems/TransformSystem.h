@@ -1,8 +1,10 @@
 #pragma once
 
+#include "Base/Array.h"
 #include "Base/BaseTypes.h"
 #include "Math/MathConstants.h"
 #include "Math/Matrix4.h"
+#include "Math/Transform.h"
 #include "Base/Singleton.h"
 #include "Entity/SceneSystem.h"
 
@@ -24,6 +26,19 @@ public:
     void PrepareForRemove() override;
     void Process(float32 timeElapsed) override;
 
+    /**
+        Enable or disable linear update of world transforms, it is enabled by Scene unless
+        `linear_transform_update` engine option is false.
+        In linear mode transforms of all entities are mirrored into per-component arrays. Top-level subtrees are
+        grouped into batches and slots of every batch are sorted by depth, so parents of slots at one depth level
+        are already computed and four slots are transformed at once with SSE2 or NEON (scalar code otherwise).
+        Batches are processed on JobManager workers. Computed transforms are written back to
+        TransformComponent and reported through TransformSingleComponent as in default mode.
+        Arrays are rebuilt when hierarchy changes, so mode is intended for big scenes with mostly static hierarchy.
+    */
+    void SetLinearUpdateEnabled(bool enabled);
+    bool IsLinearUpdateEnabled() const;
+
 private:
     Vector<Entity*> updatableEntities;
 
@@ -32,7 +47,62 @@ private:
     void FindNodeThatRequireUpdate(Entity* entity);
     void TransformAllChildEntities(Entity* entity);
 
+    void ProcessLinear();
+    void RegisterLinearEntitiesRecursive(Entity* entity);
+    void RebuildLinearHierarchy();
+    void MarkLinearSlotDirty(Entity* entity);
+    void UpdateLinearSlotLocal(uint32 slot);
+    void TransformLinearBatch(uint32 batch);
+    void TransformLinearLanes(uint32 first, uint32 count);
+
     int32 passedNodes;
     int32 multipliedNodes;
+
+    static const uint32 INVALID_SLOT = static_cast<uint32>(-1);
+
+    /**
+        Transforms stored as separate array for every component (translation xyz, scale xyz, rotation xyzw),
+        so neighbour slots are loaded into SIMD registers directly. Arrays are padded to multiple of four elements.
+    */
+    struct TransformArrays
+    {
+        static const uint32 COMPONENTS_COUNT = 10;
+
+        void Resize(uint32 size);
+        void Set(uint32 index, const Transform& transform);
+        Transform Get(uint32 index) const;
+
+        Array<Vector<float32>, COMPONENTS_COUNT> components;
+    };
+
+    struct LinearHierarchy
+    {
+        UnorderedMap<Entity*, uint32> entitySlots;
+        Vector<Entity*> addedEntities;
+
+        // Data below is indexed by slot
+        Vector<Entity*> entities;
+        Vector<TransformComponent*> transforms;
+        Vector<uint32> parents;
+        TransformArrays locals; // local transforms with applied animation transform
+        TransformArrays worlds;
+        Vector<Matrix4> worldMatrices;
+        Vector<uint8> dirty;
+
+        // Depth level `i` contains slots in range [levelOffsets[i], levelOffsets[i + 1]),
+        // batch `i` contains levels in range [batchLevels[i], batchLevels[i + 1])
+        Vector<uint32> levelOffsets;
+        Vector<uint32> batchLevels;
+
+        bool hierarchyChanged = false;
+    };
+
+    LinearHierarchy linear;
+    bool linearUpdateEnabled = false;
 };
+
+inline bool TransformSystem::IsLinearUpdateEnabled() const
+{
+    return linearUpdateEnabled;
+}
 };
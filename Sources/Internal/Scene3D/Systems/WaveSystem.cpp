@@ -1,5 +1,6 @@
 #include "WaveSystem.h"
 #include "Scene3D/Entity.h"
+#include "Entity/ComponentUtils.h"
 #include "Scene3D/Components/ComponentHelpers.h"
 #include "Scene3D/Components/WaveComponent.h"
 #include "Scene3D/Components/TransformComponent.h"
@@ -39,6 +40,9 @@ WaveSystem::WaveSystem(Scene* scene)
     isVegetationAnimationEnabled = QualitySettingsSystem::Instance()->IsOptionEnabled(QualitySettingsSystem::QUALITY_OPTION_VEGETATION_ANIMATION);
 
     scene->GetEventSystem()->RegisterSystemForEvent(this, EventSystem::WAVE_TRIGGERED);
+
+    ComponentMask waveMask = ComponentUtils::MakeMask<WaveComponent>();
+    SetComponentsAccess(waveMask, waveMask);
 }
 
 WaveSystem::~WaveSystem()
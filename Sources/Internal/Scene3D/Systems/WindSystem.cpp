@@ -1,6 +1,7 @@
 #include "Base/BaseMath.h"
 #include "WindSystem.h"
 #include "Scene3D/Entity.h"
+#include "Entity/ComponentUtils.h"
 #include "Scene3D/Components/ComponentHelpers.h"
 #include "Scene3D/Components/WindComponent.h"
 #include "Scene3D/Components/TransformComponent.h"
@@ -41,6 +42,9 @@ WindSystem::WindSystem(Scene* scene)
         float32 t = WIND_PERIOD * i / static_cast<float32>(WIND_TABLE_SIZE);
         windValuesTable[i] = (2.f + std::sin(t) * 0.7f + std::cos(t * 10) * 0.3f);
     }
+
+    ComponentMask windMask = ComponentUtils::MakeMask<WindComponent>();
+    SetComponentsAccess(windMask, windMask);
 }
 
 WindSystem::~WindSystem()
@@ -8,9 +8,9 @@
 #include "UI/DataBinding/Private/UIDataBindingDependenciesManager.h"
 #include "UI/DataBinding/Private/UIDataModel.h"
 
-#include "UI/Formula/Private/FormulaExpression.h"
+#include "UI/Formula/Private/FormulaCompiledExpression.h"
+#include "UI/Formula/Private/FormulaException.h"
 #include "UI/Formula/Private/FormulaParser.h"
-#include "UI/Formula/Private/FormulaExecutor.h"
 #include "UI/Formula/Private/FormulaFormatter.h"
 
 #include "UI/Styles/UIStyleSheetPropertyDataBase.h"
@@ -82,7 +82,7 @@ void UIDataBinding::ProcessReadFromModel(UIDataBindingDependenciesManager* depen
         FormulaParser parser(component->GetBindingExpression());
         try
         {
-            expression = parser.ParseExpression();
+            expression = std::make_unique<FormulaCompiledExpression>(parser.ParseExpression());
         }
         catch (const FormulaException& error)
         {
@@ -92,15 +92,21 @@ void UIDataBinding::ProcessReadFromModel(UIDataBindingDependenciesManager* depen
         }
     }
 
-    if (expression.get() && component->GetUpdateMode() != UIDataBindingComponent::MODE_WRITE && (parent->IsDirty() || expChanged || dependenciesManager->IsDirty(dependencyId)))
+    bool modelChanged = parent->IsDirty() || dependenciesManager->IsDirty(dependencyId);
+    if (modelChanged || expChanged)
     {
-        std::shared_ptr<FormulaContext> context = parent->GetFormulaContext();
+        modelReference = Reflection();
+        modelReferenceContext.reset();
+    }
+
+    if (expression.get() && component->GetUpdateMode() != UIDataBindingComponent::MODE_WRITE && (modelChanged || expChanged))
+    {
+        const std::shared_ptr<FormulaContext>& context = parent->GetFormulaContext();
         hasToResetError = true;
         try
         {
-            FormulaExecutor executor(context);
-            Any val = executor.Calculate(expression.get());
-            const Vector<void*>& dependencies = executor.GetDependencies();
+            Any val = expression->Calculate(context);
+            const Vector<void*>& dependencies = expression->GetDependencies();
 
             if (!dependencies.empty())
             {
@@ -162,23 +168,38 @@ void UIDataBinding::ProcessReadFromModel(UIDataBindingDependenciesManager* depen
 bool UIDataBinding::ProcessWriteToModel(UIDataBindingDependenciesManager* dependenciesManager)
 {
     bool result = false;
-    if (expression.get() && component->GetUpdateMode() != UIDataBindingComponent::MODE_READ && !dependenciesManager->IsDirty(dependencyId))
+    UIDataBindingComponent::UpdateMode mode = component->GetUpdateMode();
+    if (expression.get() && mode != UIDataBindingComponent::MODE_READ && (mode == UIDataBindingComponent::MODE_WRITE || !dependenciesManager->IsDirty(dependencyId)))
     {
-        std::shared_ptr<FormulaContext> context = parent->GetFormulaContext();
+        const std::shared_ptr<FormulaContext>& context = parent->GetFormulaContext();
         Any uiValue = controlReflection.GetValue();
         bool hasToResetError = true;
         try
         {
-            Reflection ref = FormulaExecutor(context).GetDataReference(expression.get());
-            if (ref.GetValue() != uiValue)
+            if (!modelReference.IsValid() || parent->IsDirty() || modelReferenceContext != context || dependenciesManager->IsDirty(dependencyId))
+            {
+                modelReference = expression->GetDataReference(context);
+                modelReferenceContext = context;
+
+                // Bindings which don't read from model need own dependencies to know when reference is changed
+                const Vector<void*>& dependencies = expression->GetDependencies();
+                if (mode == UIDataBindingComponent::MODE_WRITE && !dependencies.empty())
+                {
+                    dependencyId = dependenciesManager->MakeDependency(dependencyId, dependencies);
+                }
+            }
+
+            if (modelReference.GetValue() != uiValue)
             {
-                ref.SetValue(uiValue);
-                dependenciesManager->SetDirty(ref.GetValueObject().GetVoidPtr());
+                modelReference.SetValue(uiValue);
+                dependenciesManager->SetDirty(modelReference.GetValueObject().GetVoidPtr());
                 result = true;
             }
         }
         catch (const FormulaException& error)
         {
+            modelReference = Reflection();
+            modelReferenceContext.reset();
             hasToResetError = false;
             NotifyError(error.GetErrorMessage(), component->GetControlFieldName());
         }
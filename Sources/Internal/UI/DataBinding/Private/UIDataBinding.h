@@ -6,7 +6,8 @@
 namespace DAVA
 {
 class UIDataBindingComponent;
-class FormulaExpression;
+class FormulaCompiledExpression;
+class FormulaContext;
 class UIDataBindingIssueDelegate;
 class UIDataBindingDependenciesManager;
 
@@ -23,8 +24,12 @@ public:
 
 private:
     UIDataBindingComponent* component = nullptr;
-    std::shared_ptr<FormulaExpression> expression;
+    std::unique_ptr<FormulaCompiledExpression> expression;
 
     Reflection controlReflection;
+
+    // Data written from UI, it's resolved again only after model or dependencies are changed
+    Reflection modelReference;
+    std::shared_ptr<FormulaContext> modelReferenceContext;
 };
 }
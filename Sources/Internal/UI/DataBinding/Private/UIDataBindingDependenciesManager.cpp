@@ -24,7 +24,7 @@ int32 UIDataBindingDependenciesManager::MakeDependency(int32 id, const Vector<vo
         ReleaseDepencency(id);
     }
 
-    dirtyBindings[id] = false;
+    dependencies[id] = Dependency();
     AddDependencies(id, data);
     return id;
 }
@@ -32,56 +32,49 @@ int32 UIDataBindingDependenciesManager::MakeDependency(int32 id, const Vector<vo
 void UIDataBindingDependenciesManager::AddDependencies(int32 id, const Vector<void*>& data)
 {
     DVASSERT(id != UNKNOWN_DEPENDENCY);
-    DVASSERT(dirtyBindings.find(id) != dirtyBindings.end());
 
+    auto dependencyIt = dependencies.find(id);
+    DVASSERT(dependencyIt != dependencies.end());
+
+    Vector<void*>& dependencyData = dependencyIt->second.data;
     for (void* d : data)
     {
-        auto it = dirtyMap.find(d);
-        if (it == dirtyMap.end())
-        {
-            dirtyMap[d] = Vector<int>();
-            it = dirtyMap.find(d);
-        }
-
-        bool haveToAddId = std::find(it->second.begin(), it->second.end(), id) == it->second.end();
-        if (haveToAddId)
+        bool haveToAdd = std::find(dependencyData.begin(), dependencyData.end(), d) == dependencyData.end();
+        if (haveToAdd)
         {
-            it->second.push_back(id);
+            dependencyData.push_back(d);
+            dirtyMap[d].push_back(id);
         }
     }
 }
 
 void UIDataBindingDependenciesManager::ReleaseDepencency(int32 index)
 {
-    for (auto mapIt = dirtyMap.begin(); mapIt != dirtyMap.end();)
+    auto dependencyIt = dependencies.find(index);
+    if (dependencyIt == dependencies.end())
+    {
+        return;
+    }
+
+    for (void* d : dependencyIt->second.data)
     {
-        Vector<int>& v = mapIt->second;
+        auto mapIt = dirtyMap.find(d);
+        DVASSERT(mapIt != dirtyMap.end());
+
+        Vector<int32>& v = mapIt->second;
         auto it = std::find(v.begin(), v.end(), index);
-        bool haveToErase = false;
         if (it != v.end())
         {
             v.erase(it);
-            if (v.empty())
-            {
-                haveToErase = true;
-            }
         }
 
-        if (haveToErase)
-        {
-            mapIt = dirtyMap.erase(mapIt);
-        }
-        else
+        if (v.empty())
         {
-            ++mapIt;
+            dirtyMap.erase(mapIt);
         }
     }
 
-    auto it = dirtyBindings.find(index);
-    if (it != dirtyBindings.end())
-    {
-        dirtyBindings.erase(it);
-    }
+    dependencies.erase(dependencyIt);
 }
 
 void UIDataBindingDependenciesManager::SetDirty(void* data)
@@ -91,22 +84,42 @@ void UIDataBindingDependenciesManager::SetDirty(void* data)
     {
         for (int32 id : it->second)
         {
-            dirtyBindings[id] = true;
+            Dependency& dependency = dependencies[id];
+            if (!dependency.dirty)
+            {
+                dependency.dirty = true;
+                dirtyIds.push_back(id);
+            }
         }
     }
 }
 
 bool UIDataBindingDependenciesManager::IsDirty(int32 index) const
 {
-    auto it = dirtyBindings.find(index);
-    return it != dirtyBindings.end() && it->second;
+    if (dirtyIds.empty())
+    {
+        return false;
+    }
+
+    auto it = dependencies.find(index);
+    return it != dependencies.end() && it->second.dirty;
+}
+
+bool UIDataBindingDependenciesManager::HasDirtyDependencies() const
+{
+    return !dirtyIds.empty();
 }
 
 void UIDataBindingDependenciesManager::ResetDirties()
 {
-    for (auto& it : dirtyBindings)
+    for (int32 id : dirtyIds)
     {
-        it.second = false;
+        auto it = dependencies.find(id);
+        if (it != dependencies.end())
+        {
+            it->second.dirty = false;
+        }
     }
+    dirtyIds.clear();
 }
 }
@@ -18,11 +18,19 @@ public:
     void ReleaseDepencency(int32 index);
     void SetDirty(void* data);
     bool IsDirty(int32 index) const;
+    bool HasDirtyDependencies() const;
     void ResetDirties();
 
 private:
-    UnorderedMap<int32, bool> dirtyBindings;
+    struct Dependency
+    {
+        Vector<void*> data;
+        bool dirty = false;
+    };
+
+    UnorderedMap<int32, Dependency> dependencies;
     UnorderedMap<void*, Vector<int32>> dirtyMap;
+    Vector<int32> dirtyIds; // dirty dependencies since last reset, lets idle frames skip all lookups
     int32 nextId = 0;
 };
 }
@@ -125,20 +125,21 @@ void UIDataBindingSystem::Process(float32 elapsedTime)
     while (hasUnprocessedModels)
     {
         hasUnprocessedModels = false;
-        Vector<std::shared_ptr<UIDataModel>> copy = dataModels;
-        for (const std::shared_ptr<UIDataModel>& model : copy)
+
+        // Processing of model can add or remove other models (e.g. list creates cells),
+        // in this case models are walked again from the beginning and processed ones are skipped.
+        for (size_t i = 0; i < dataModels.size() && !hasUnprocessedModels; i++)
         {
-            if (std::find(dataModels.begin(), dataModels.end(), model) != dataModels.end())
+            std::shared_ptr<UIDataModel> model = dataModels[i];
+            if (model->Process(dependenciesManager.get()))
             {
-                if (model->Process(dependenciesManager.get()))
-                {
-                    processedModels.push_back(model);
-                }
-                DVASSERT(model->GetFormulaContext() != nullptr);
+                processedModels.push_back(model);
             }
+            DVASSERT(model->GetFormulaContext() != nullptr);
         }
     }
 
+    // Bindings evaluate formulas only if their component, parent model or dependencies are dirty
     for (const std::shared_ptr<UIDataBinding>& binding : dataBindings)
     {
         binding->ProcessReadFromModel(dependenciesManager.get());
@@ -294,6 +295,7 @@ void UIDataBindingSystem::DeleteDataModel(UIComponent* component)
     {
         std::shared_ptr<UIDataModel> model = *it;
         dataModels.erase(it);
+        hasUnprocessedModels = true;
 
         model->GetParent()->SetDirty();
 
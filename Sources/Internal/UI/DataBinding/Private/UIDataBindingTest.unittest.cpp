@@ -259,4 +259,61 @@ DAVA_TESTCLASS (UIDataBindingTest)
 
         TEST_VERIFY(data.str == "fromControlToModel");
     }
+
+    DAVA_TEST (BindingDirtyDependencyTest)
+    {
+        UIDataBindingComponent* bindComp = text->GetOrCreateComponent<UIDataBindingComponent>();
+        bindComp->SetUpdateMode(UIDataBindingComponent::MODE_READ);
+        bindComp->SetControlFieldName("UITextComponent.text");
+        bindComp->SetBindingExpression("a * 2");
+
+        UIDataBindingSystem* sys = GetEngineContext()->uiControlSystem->GetSystem<UIDataBindingSystem>();
+        UIDataBindingPostProcessingSystem* postSys = GetEngineContext()->uiControlSystem->GetSystem<UIDataBindingPostProcessingSystem>();
+        sys->Process(0.0f);
+        postSys->Process(0.0f);
+        TEST_VERIFY(text->GetUtf8Text() == "246");
+
+        // binding isn't evaluated until its data is marked as dirty
+        int32 a = data.a;
+        data.a = 5;
+        sys->Process(0.0f);
+        postSys->Process(0.0f);
+        TEST_VERIFY(text->GetUtf8Text() == "246");
+
+        sys->SetDataDirty(&data.a);
+        sys->Process(0.0f);
+        postSys->Process(0.0f);
+        TEST_VERIFY(text->GetUtf8Text() == "10");
+
+        data.a = a;
+    }
+
+    DAVA_TEST (BindingWriteAfterDataChangedTest)
+    {
+        UIDataBindingComponent* bindComp = textField->GetOrCreateComponent<UIDataBindingComponent>();
+        bindComp->SetUpdateMode(UIDataBindingComponent::MODE_WRITE);
+        bindComp->SetControlFieldName("text");
+        bindComp->SetBindingExpression("items[1].name");
+
+        UIDataBindingSystem* sys = GetEngineContext()->uiControlSystem->GetSystem<UIDataBindingSystem>();
+        UIDataBindingPostProcessingSystem* postSys = GetEngineContext()->uiControlSystem->GetSystem<UIDataBindingPostProcessingSystem>();
+
+        textField->SetUtf8Text("first");
+        sys->Process(0.0f);
+        postSys->Process(0.0f);
+        TEST_VERIFY(data.items[1].name == "first");
+
+        // reference to written data is resolved again after data is changed
+        Vector<DataItem> items = data.items;
+        data.items = { DataItem("n1"), DataItem("n2") };
+        sys->SetDataDirty(&data.items);
+
+        textField->SetUtf8Text("second");
+        sys->Process(0.0f);
+        postSys->Process(0.0f);
+        TEST_VERIFY(data.items[1].name == "second");
+
+        data.items = items;
+        sys->SetDataDirty(&data.items);
+    }
 };
@@ -0,0 +1,431 @@
+#include "UI/Formula/Private/FormulaCompiledExpression.h"
+
+#include "UI/Formula/Private/FormulaData.h"
+#include "UI/Formula/Private/FormulaException.h"
+#include "UI/Formula/Private/FormulaExecutor.h"
+#include "UI/Formula/Private/FormulaFormatter.h"
+#include "Reflection/ReflectedType.h"
+#include "Reflection/Private/Wrappers/StructureWrapperClass.h"
+#include "Utils/StringFormat.h"
+
+namespace DAVA
+{
+FormulaCompiledExpression::FormulaCompiledExpression(const std::shared_ptr<FormulaExpression>& exp)
+    : expression(exp)
+{
+    DVASSERT(expression.get() != nullptr);
+    Compile(expression.get(), false);
+}
+
+FormulaCompiledExpression::~FormulaCompiledExpression()
+{
+}
+
+FormulaExpression* FormulaCompiledExpression::GetExpression() const
+{
+    return expression.get();
+}
+
+Any FormulaCompiledExpression::Calculate(const std::shared_ptr<FormulaContext>& context)
+{
+    Execute(context);
+    CalculateEntry(stack.back(), context);
+    return stack.back().value;
+}
+
+Reflection FormulaCompiledExpression::GetDataReference(const std::shared_ptr<FormulaContext>& context)
+{
+    Execute(context);
+    return GetEntryReference(stack.back(), context);
+}
+
+const Vector<void*>& FormulaCompiledExpression::GetDependencies() const
+{
+    return dependencies;
+}
+
+void FormulaCompiledExpression::Visit(FormulaValueExpression* exp)
+{
+    Emit(OP_VALUE, exp);
+
+    const Any& value = exp->GetValue();
+    bool isData = value.CanGet<std::shared_ptr<FormulaDataMap>>() || value.CanGet<std::shared_ptr<FormulaDataVector>>();
+    compiledValue = !isData && !value.CanCast<std::shared_ptr<FormulaExpression>>();
+}
+
+void FormulaCompiledExpression::Visit(FormulaNegExpression* exp)
+{
+    Compile(exp->GetExp(), true);
+    Emit(OP_NEG, exp);
+    compiledValue = true;
+}
+
+void FormulaCompiledExpression::Visit(FormulaNotExpression* exp)
+{
+    Compile(exp->GetExp(), true);
+    Emit(OP_NOT, exp);
+    compiledValue = true;
+}
+
+void FormulaCompiledExpression::Visit(FormulaWhenExpression* exp)
+{
+    Vector<int32> jumpsToEnd;
+    for (const auto& branch : exp->GetBranches())
+    {
+        Compile(branch.first.get(), true);
+        int32 jumpToNextBranch = Emit(OP_JUMP_IF_FALSE, branch.first.get());
+
+        // Result of 'when' is value even if branch is reference
+        Compile(branch.second.get(), false);
+        Emit(OP_CALCULATE, exp);
+        jumpsToEnd.push_back(Emit(OP_JUMP, exp));
+
+        code[jumpToNextBranch].arg = static_cast<int32>(code.size());
+    }
+
+    Compile(exp->GetElseBranch(), false);
+    Emit(OP_CALCULATE, exp);
+
+    for (int32 jump : jumpsToEnd)
+    {
+        code[jump].arg = static_cast<int32>(code.size());
+    }
+    compiledValue = true;
+}
+
+void FormulaCompiledExpression::Visit(FormulaBinaryOperatorExpression* exp)
+{
+    Compile(exp->GetLhs(), true);
+    Compile(exp->GetRhs(), true);
+    Emit(OP_BINARY, exp);
+    compiledValue = true;
+}
+
+void FormulaCompiledExpression::Visit(FormulaFunctionExpression* exp)
+{
+    for (const std::shared_ptr<FormulaExpression>& paramExp : exp->GetParms())
+    {
+        Compile(paramExp.get(), true);
+    }
+
+    functions.emplace_back();
+    Emit(OP_CALL, exp, static_cast<int32>(functions.size() - 1));
+    compiledValue = false;
+}
+
+void FormulaCompiledExpression::Visit(FormulaFieldAccessExpression* exp)
+{
+    fields.emplace_back();
+    if (exp->GetExp())
+    {
+        Compile(exp->GetExp(), false);
+        Emit(OP_FIELD, exp, static_cast<int32>(fields.size() - 1));
+    }
+    else
+    {
+        Emit(OP_CONTEXT_FIELD, exp, static_cast<int32>(fields.size() - 1));
+    }
+    compiledValue = false;
+}
+
+void FormulaCompiledExpression::Visit(FormulaIndexExpression* exp)
+{
+    Compile(exp->GetIndexExp(), true);
+    Compile(exp->GetExp(), false);
+    Emit(OP_INDEX, exp);
+    compiledValue = false;
+}
+
+void FormulaCompiledExpression::Compile(FormulaExpression* exp, bool asValue)
+{
+    exp->Accept(this);
+
+    if (asValue && !compiledValue)
+    {
+        Emit(OP_CALCULATE, exp);
+        compiledValue = true;
+    }
+}
+
+int32 FormulaCompiledExpression::Emit(eOpCode op, FormulaExpression* exp, int32 arg)
+{
+    code.push_back(Instruction{ op, arg, exp });
+    return static_cast<int32>(code.size() - 1);
+}
+
+void FormulaCompiledExpression::Execute(const std::shared_ptr<FormulaContext>& context)
+{
+    stack.clear();
+    dependencies.clear();
+
+    size_t ip = 0;
+    while (ip < code.size())
+    {
+        const Instruction& instruction = code[ip];
+        ip++;
+
+        switch (instruction.op)
+        {
+        case OP_VALUE:
+        {
+            stack.emplace_back();
+            StackEntry& entry = stack.back();
+            entry.exp = instruction.exp;
+            entry.value = static_cast<FormulaValueExpression*>(instruction.exp)->GetValue();
+
+            if (entry.value.CanGet<std::shared_ptr<FormulaDataMap>>())
+            {
+                entry.reference = Reflection::Create(ReflectedObject(entry.value.Get<std::shared_ptr<FormulaDataMap>>().get()));
+            }
+            else if (entry.value.CanGet<std::shared_ptr<FormulaDataVector>>())
+            {
+                entry.reference = Reflection::Create(ReflectedObject(entry.value.Get<std::shared_ptr<FormulaDataVector>>().get()));
+            }
+            break;
+        }
+
+        case OP_CONTEXT_FIELD:
+        case OP_FIELD:
+        {
+            FormulaFieldAccessExpression* exp = static_cast<FormulaFieldAccessExpression*>(instruction.exp);
+            if (instruction.op == OP_CONTEXT_FIELD)
+            {
+                stack.emplace_back();
+                stack.back().reference = FindContextField(fields[instruction.arg], context, exp);
+            }
+            else
+            {
+                StackEntry& entry = stack.back();
+                Reflection field = FindField(fields[instruction.arg], GetEntryReference(entry, context), exp);
+                entry.reference = field;
+                entry.value.Clear();
+            }
+
+            StackEntry& entry = stack.back();
+            entry.exp = exp;
+            if (entry.reference.IsValid())
+            {
+                dependencies.push_back(entry.reference.GetValueObject().GetVoidPtr());
+            }
+            else
+            {
+                DAVA_THROW(FormulaException, Format("Can't resolve symbol '%s'", exp->GetFieldName().c_str()), exp);
+            }
+            break;
+        }
+
+        case OP_INDEX:
+        {
+            StackEntry& index = stack[stack.size() - 2];
+            Reflection field = GetEntryReference(stack.back(), context).GetField(index.value);
+            if (field.IsValid())
+            {
+                dependencies.push_back(field.GetValueObject().GetVoidPtr());
+            }
+            else
+            {
+                DAVA_THROW(FormulaException, Format("Can't get data '%s' by index '%s' with type '%s'",
+                                                    FormulaFormatter().Format(instruction.exp).c_str(),
+                                                    FormulaFormatter::AnyToString(index.value).c_str(),
+                                                    FormulaFormatter::AnyTypeToString(index.value).c_str()),
+                           instruction.exp);
+            }
+
+            index.value.Clear();
+            index.reference = field;
+            index.exp = instruction.exp;
+            stack.pop_back();
+            break;
+        }
+
+        case OP_CALCULATE:
+            CalculateEntry(stack.back(), context);
+            stack.back().exp = instruction.exp;
+            break;
+
+        case OP_NEG:
+            stack.back().value = FormulaExecutor::CalculateNeg(stack.back().value, instruction.exp);
+            stack.back().exp = instruction.exp;
+            break;
+
+        case OP_NOT:
+            stack.back().value = FormulaExecutor::CalculateNot(stack.back().value, instruction.exp);
+            stack.back().exp = instruction.exp;
+            break;
+
+        case OP_BINARY:
+        {
+            StackEntry& lhs = stack[stack.size() - 2];
+            lhs.value = FormulaExecutor::CalculateBinaryOperator(lhs.value, stack.back().value, static_cast<FormulaBinaryOperatorExpression*>(instruction.exp));
+            lhs.exp = instruction.exp;
+            stack.pop_back();
+            break;
+        }
+
+        case OP_CALL:
+        {
+            FormulaFunctionExpression* exp = static_cast<FormulaFunctionExpression*>(instruction.exp);
+            size_t argsStart = stack.size() - exp->GetParms().size();
+
+            arguments.clear();
+            for (size_t i = argsStart; i < stack.size(); i++)
+            {
+                arguments.push_back(std::move(stack[i].value));
+            }
+            stack.resize(argsStart);
+
+            const AnyFn& fn = FindFunction(functions[instruction.arg], context, exp);
+            Any result = FormulaExecutor::InvokeFunction(context, fn, arguments, exp);
+
+            stack.emplace_back();
+            stack.back().value = std::move(result);
+            stack.back().exp = exp;
+            break;
+        }
+
+        case OP_JUMP:
+            ip = static_cast<size_t>(instruction.arg);
+            break;
+
+        case OP_JUMP_IF_FALSE:
+        {
+            const StackEntry& selector = stack.back();
+            if (!selector.value.CanGet<bool>())
+            {
+                DAVA_THROW(FormulaException, Format("Invalid argument type '%s' to when selector expression", FormulaFormatter::AnyTypeToString(selector.value).c_str()), selector.exp);
+            }
+
+            bool selected = selector.value.Get<bool>();
+            stack.pop_back();
+            if (!selected)
+            {
+                ip = static_cast<size_t>(instruction.arg);
+            }
+            break;
+        }
+
+        default:
+            DVASSERT(false, "Unknown formula instruction");
+            break;
+        }
+    }
+
+    DVASSERT(stack.size() == 1);
+}
+
+void FormulaCompiledExpression::CalculateEntry(StackEntry& entry, const std::shared_ptr<FormulaContext>& context)
+{
+    if (entry.value.IsEmpty())
+    {
+        if (entry.reference.IsValid())
+        {
+            entry.value = entry.reference.GetValue();
+        }
+        else
+        {
+            DAVA_THROW(FormulaException,
+                       Format("Can't calculate expression '%s'",
+                              FormulaFormatter().Format(entry.exp).c_str()),
+                       entry.exp);
+        }
+    }
+
+    if (entry.value.CanCast<std::shared_ptr<FormulaExpression>>())
+    {
+        // Expressions stored in data are rare, so they are calculated by executor
+        std::shared_ptr<FormulaExpression> internalExpr = entry.value.Cast<std::shared_ptr<FormulaExpression>>();
+        FormulaExecutor executor(context);
+        entry.value = executor.Calculate(internalExpr.get());
+        dependencies.insert(dependencies.end(), executor.GetDependencies().begin(), executor.GetDependencies().end());
+    }
+
+    entry.reference = Reflection();
+}
+
+const Reflection& FormulaCompiledExpression::GetEntryReference(StackEntry& entry, const std::shared_ptr<FormulaContext>& context)
+{
+    if (!entry.reference.IsValid())
+    {
+        DAVA_THROW(FormulaException,
+                   Format("Can't get data reference '%s'",
+                          FormulaFormatter().Format(entry.exp).c_str()),
+                   entry.exp);
+    }
+
+    Any value = entry.reference.GetValue();
+    if (value.CanCast<std::shared_ptr<FormulaExpression>>())
+    {
+        std::shared_ptr<FormulaExpression> internalExpr = value.Cast<std::shared_ptr<FormulaExpression>>();
+        FormulaExecutor executor(context);
+        entry.reference = executor.GetDataReference(internalExpr.get());
+        dependencies.insert(dependencies.end(), executor.GetDependencies().begin(), executor.GetDependencies().end());
+    }
+    return entry.reference;
+}
+
+const AnyFn& FormulaCompiledExpression::FindFunction(FunctionCache& cache, const std::shared_ptr<FormulaContext>& context, FormulaFunctionExpression* exp)
+{
+    bool hasToFind = !cache.fn.IsValid() || cache.types.size() != arguments.size() || cache.context.lock() != context;
+    for (size_t i = 0; i < arguments.size() && !hasToFind; i++)
+    {
+        hasToFind = cache.types[i] != arguments[i].GetType();
+    }
+
+    if (hasToFind)
+    {
+        cache.fn = FormulaExecutor::FindFunction(context, arguments, exp);
+        cache.context = context;
+        cache.types.clear();
+        for (const Any& arg : arguments)
+        {
+            cache.types.push_back(arg.GetType());
+        }
+    }
+    return cache.fn;
+}
+
+Reflection FormulaCompiledExpression::FindContextField(FieldCache& cache, const std::shared_ptr<FormulaContext>& context, FormulaFieldAccessExpression* exp)
+{
+    const FormulaReflectionContext* reflectionContext = dynamic_cast<const FormulaReflectionContext*>(context.get());
+    if (reflectionContext != nullptr)
+    {
+        Reflection field = FindField(cache, reflectionContext->GetReflection(), exp);
+        if (field.IsValid() || context->GetParent() == nullptr)
+        {
+            return field;
+        }
+        return context->GetParent()->FindReflection(exp->GetFieldName());
+    }
+    return context->FindReflection(exp->GetFieldName());
+}
+
+Reflection FormulaCompiledExpression::FindField(FieldCache& cache, const Reflection& object, FormulaFieldAccessExpression* exp)
+{
+    ReflectedObject valueObject = object.GetValueObject();
+    if (cache.field.IsValid() && cache.object == valueObject.GetVoidPtr() && cache.objectType == valueObject.GetReflectedType() &&
+        cache.fieldType == cache.field.GetValueObject().GetReflectedType())
+    {
+        return cache.field;
+    }
+
+    Reflection field = object.GetField(exp->GetFieldName());
+
+    // Field of class depends only on address and type of object, fields of containers depend on their content.
+    // Type of field value is checked too, because it defines fields of next access in chain
+    const ReflectedType* objectType = valueObject.GetReflectedType();
+    bool canCache = field.IsValid() && valueObject.GetVoidPtr() != nullptr && objectType != nullptr &&
+    dynamic_cast<const StructureWrapperClass*>(objectType->GetStrucutreWrapper()) != nullptr;
+    if (canCache)
+    {
+        cache.object = valueObject.GetVoidPtr();
+        cache.objectType = objectType;
+        cache.fieldType = field.GetValueObject().GetReflectedType();
+        cache.field = field;
+    }
+    else
+    {
+        cache = FieldCache();
+    }
+    return field;
+}
+}
@@ -0,0 +1,123 @@
+#pragma once
+
+#include "Base/BaseTypes.h"
+#include "UI/Formula/Private/FormulaExpression.h"
+#include "UI/Formula/FormulaContext.h"
+
+namespace DAVA
+{
+/**
+ \ingroup formula
+
+ Expression compiled once into flat list of instructions of simple stack machine.
+ It gives the same results, errors and dependencies as FormulaExecutor, but it doesn't
+ walk the tree and keeps its stack, resolved functions and fields between calculations.
+ Fields are cached only for objects of classes with registered reflection, because their
+ fields depend on object address and type only. Fields of containers and indexed fields are
+ resolved on each calculation, because they depend on content of containers.
+ It is useful for expressions which are calculated many times, e.g. data bindings.
+ */
+class FormulaCompiledExpression final : private FormulaExpressionVisitor
+{
+public:
+    FormulaCompiledExpression(const std::shared_ptr<FormulaExpression>& exp);
+    ~FormulaCompiledExpression() override;
+
+    FormulaExpression* GetExpression() const;
+
+    /**
+     \ingroup formula
+
+     Method calculates expression in context and returns result.
+     */
+    Any Calculate(const std::shared_ptr<FormulaContext>& context);
+
+    /**
+     \ingroup formula
+
+     Method calculates expression in context and returns reference to data instead of value.
+     */
+    Reflection GetDataReference(const std::shared_ptr<FormulaContext>& context);
+
+    /**
+     \ingroup formula
+
+     Pointers to data used by last calculation (see FormulaExecutor::GetDependencies).
+     */
+    const Vector<void*>& GetDependencies() const;
+
+private:
+    enum eOpCode : uint8
+    {
+        OP_VALUE, //!< Push value of FormulaValueExpression
+        OP_CONTEXT_FIELD, //!< Push reference to field found in context, arg is index of field cache
+        OP_FIELD, //!< Replace top reference by reference to its field, arg is index of field cache
+        OP_INDEX, //!< Replace index value and reference on top by reference to indexed field
+        OP_CALCULATE, //!< Replace top entry by its value
+        OP_NEG,
+        OP_NOT,
+        OP_BINARY,
+        OP_CALL, //!< Replace arguments by result of function, arg is index of function cache
+        OP_JUMP, //!< Jump to instruction arg
+        OP_JUMP_IF_FALSE //!< Pop 'when' selector and jump to instruction arg if it is false
+    };
+
+    struct Instruction
+    {
+        eOpCode op;
+        int32 arg;
+        FormulaExpression* exp;
+    };
+
+    struct StackEntry
+    {
+        Any value;
+        Reflection reference;
+        FormulaExpression* exp = nullptr;
+    };
+
+    struct FunctionCache
+    {
+        std::weak_ptr<FormulaContext> context;
+        Vector<const Type*> types;
+        AnyFn fn;
+    };
+
+    struct FieldCache
+    {
+        const void* object = nullptr;
+        const ReflectedType* objectType = nullptr;
+        const ReflectedType* fieldType = nullptr;
+        Reflection field;
+    };
+
+    void Visit(FormulaValueExpression* exp) override;
+    void Visit(FormulaNegExpression* exp) override;
+    void Visit(FormulaNotExpression* exp) override;
+    void Visit(FormulaWhenExpression* exp) override;
+    void Visit(FormulaBinaryOperatorExpression* exp) override;
+    void Visit(FormulaFunctionExpression* exp) override;
+    void Visit(FormulaFieldAccessExpression* exp) override;
+    void Visit(FormulaIndexExpression* exp) override;
+
+    void Compile(FormulaExpression* exp, bool asValue);
+    int32 Emit(eOpCode op, FormulaExpression* exp, int32 arg = 0);
+
+    void Execute(const std::shared_ptr<FormulaContext>& context);
+    void CalculateEntry(StackEntry& entry, const std::shared_ptr<FormulaContext>& context);
+    const Reflection& GetEntryReference(StackEntry& entry, const std::shared_ptr<FormulaContext>& context);
+    const AnyFn& FindFunction(FunctionCache& cache, const std::shared_ptr<FormulaContext>& context, FormulaFunctionExpression* exp);
+    Reflection FindContextField(FieldCache& cache, const std::shared_ptr<FormulaContext>& context, FormulaFieldAccessExpression* exp);
+    Reflection FindField(FieldCache& cache, const Reflection& object, FormulaFieldAccessExpression* exp);
+
+    std::shared_ptr<FormulaExpression> expression;
+    Vector<Instruction> code;
+    Vector<FunctionCache> functions;
+    Vector<FieldCache> fields;
+    bool compiledValue = false;
+
+    Vector<StackEntry> stack;
+    Vector<Any> arguments;
+    Vector<void*> dependencies;
+};
+}
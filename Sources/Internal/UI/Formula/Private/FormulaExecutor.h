@@ -45,6 +45,18 @@ public:
      */
     const Vector<void*>& GetDependencies() const;
 
+    /**
+     \ingroup formula
+
+     Operations used by executor. They are shared with FormulaCompiledExpression
+     to get the same results and errors in both ways of calculation.
+     */
+    static Any CalculateNeg(const Any& val, FormulaExpression* exp);
+    static Any CalculateNot(const Any& val, FormulaExpression* exp);
+    static Any CalculateBinaryOperator(const Any& l, const Any& r, FormulaBinaryOperatorExpression* exp);
+    static AnyFn FindFunction(const std::shared_ptr<FormulaContext>& context, const Vector<Any>& values, FormulaFunctionExpression* exp);
+    static Any InvokeFunction(const std::shared_ptr<FormulaContext>& context, const AnyFn& fn, Vector<Any>& values, FormulaFunctionExpression* exp);
+
 private:
     void Visit(FormulaValueExpression* exp) override;
     void Visit(FormulaNegExpression* exp) override;
@@ -59,18 +71,18 @@ private:
     const Reflection& GetDataReferenceImpl(FormulaExpression* exp);
 
     template <typename T>
-    Any CalculateNumberAnyValues(FormulaBinaryOperatorExpression::Operator op, Any lVal, Any rVal) const;
+    static Any CalculateNumberAnyValues(FormulaBinaryOperatorExpression::Operator op, Any lVal, Any rVal);
 
     template <typename T>
-    Any CalculateIntAnyValues(FormulaBinaryOperatorExpression::Operator op, Any lVal, Any rVal, FormulaExpression* exp) const;
+    static Any CalculateIntAnyValues(FormulaBinaryOperatorExpression::Operator op, Any lVal, Any rVal, FormulaExpression* exp);
 
     template <typename T>
-    Any CalculateIntValues(FormulaBinaryOperatorExpression::Operator op, T lVal, T rVal, FormulaExpression* exp) const;
+    static Any CalculateIntValues(FormulaBinaryOperatorExpression::Operator op, T lVal, T rVal, FormulaExpression* exp);
 
     template <typename T>
-    Any CalculateNumberValues(FormulaBinaryOperatorExpression::Operator op, T lVal, T rVal) const;
+    static Any CalculateNumberValues(FormulaBinaryOperatorExpression::Operator op, T lVal, T rVal);
 
-    bool CastToInt32(const Any& val, int32* res) const;
+    static bool CastToInt32(const Any& val, int32* res);
 
     std::shared_ptr<FormulaContext> context;
     Any calculationResult;
@@ -0,0 +1,142 @@
+#pragma once
+
+#include "Base/BaseTypes.h"
+
+#include <cstring>
+#include <type_traits>
+
+namespace DAVA
+{
+/**
+    Layout of compiled UI package (*.uib) written by UIPackageCompiler and read by UIBinaryPackageLoader.
+
+    File consists of header, strings table, fields table, components table and stream of builder operations:
+    - header: magic, format version, version of source yaml package, sources hash, count and paths of all
+      (directly and indirectly) imported packages;
+    - strings: all names, paths and string values of package, each stored once;
+    - fields: pairs of (permanent name of reflected type, field name), resolved to reflection fields once per file;
+    - components: permanent names of component types;
+    - operations: calls of AbstractUIPackageBuilder in order they were made by UIPackageLoader, terminated by OP_END.
+
+    Any change of layout or of UIPackageLoader behaviour baked into operations (legacy properties remapping)
+    requires increment of FORMAT_VERSION, compiled packages with other version are ignored.
+
+    Sources hash is CRC32 of contents of yaml package and its imported packages in order of stored paths
+    (see UIBinaryPackageLoader::CalculateSourcesHash). Compiled package is ignored if yaml package exists
+    and hash doesn't match, so it is never older than yaml. Without yaml compiled package is used as is.
+*/
+namespace UIBinaryPackageFormat
+{
+static const uint32 MAGIC = 0x42504955; // 'UIPB'
+static const uint32 FORMAT_VERSION = 2;
+static const uint32 INVALID_INDEX = 0xFFFFFFFF;
+
+enum eOperation : uint8
+{
+    OP_END = 0,
+    OP_IMPORT, // path
+    OP_STYLE_SHEET, // selectors count, selectors, properties count, properties (name, value, transition, function, time)
+    OP_BEGIN_CLASS, // name, class
+    OP_BEGIN_CUSTOM_CLASS, // name, custom class, class
+    OP_BEGIN_PROTOTYPE, // name, package, prototype, custom class or INVALID_INDEX
+    OP_BEGIN_PATH, // path
+    OP_END_CONTROL, // place
+    OP_CONTROL_PROPERTY, // field, value
+    OP_BEGIN_COMPONENT, // component, index
+    OP_COMPONENT_PROPERTY, // field, value
+    OP_END_COMPONENT,
+    OP_DATA_BINDING, // field name, expression, mode
+};
+
+enum eValueType : uint8
+{
+    VALUE_BOOL = 0,
+    VALUE_INT32,
+    VALUE_UINT32,
+    VALUE_INT64,
+    VALUE_UINT64,
+    VALUE_FLOAT32,
+    VALUE_FASTNAME,
+    VALUE_STRING,
+    VALUE_WIDESTRING, // stored as utf8 string
+    VALUE_VECTOR2,
+    VALUE_VECTOR3,
+    VALUE_VECTOR4,
+    VALUE_COLOR,
+    VALUE_RECT,
+    VALUE_FILEPATH,
+    VALUE_ENUM, // int32 reinterpreted to type of field on loading
+};
+
+class Writer
+{
+public:
+    template <typename T>
+    void Write(const T& value)
+    {
+        static_assert(std::is_trivially_copyable<T>::value, "Only trivial types can be written");
+        const uint8* begin = reinterpret_cast<const uint8*>(&value);
+        data.insert(data.end(), begin, begin + sizeof(T));
+    }
+
+    void WriteData(const Vector<uint8>& bytes)
+    {
+        data.insert(data.end(), bytes.begin(), bytes.end());
+    }
+
+    void WriteString(const String& string)
+    {
+        Write(static_cast<uint32>(string.size()));
+        data.insert(data.end(), string.begin(), string.end());
+    }
+
+    const Vector<uint8>& GetData() const
+    {
+        return data;
+    }
+
+private:
+    Vector<uint8> data;
+};
+
+class Reader
+{
+public:
+    Reader(const uint8* data_, size_t size_)
+        : data(data_)
+        , size(size_)
+    {
+    }
+
+    template <typename T>
+    bool Read(T& value)
+    {
+        static_assert(std::is_trivially_copyable<T>::value, "Only trivial types can be read");
+        if (size - offset < sizeof(T))
+        {
+            return false;
+        }
+        std::memcpy(&value, data + offset, sizeof(T));
+        offset += sizeof(T);
+        return true;
+    }
+
+    bool ReadString(String& string)
+    {
+        uint32 length = 0;
+        if (!Read(length) || size - offset < length)
+        {
+            return false;
+        }
+        string.assign(reinterpret_cast<const char8*>(data + offset), length);
+        offset += length;
+        return true;
+    }
+
+private:
+    const uint8* data = nullptr;
+    size_t size = 0;
+    size_t offset = 0;
+};
+}
+}
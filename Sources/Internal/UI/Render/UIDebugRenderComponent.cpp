@@ -2,6 +2,7 @@
 #include "Engine/Engine.h"
 #include "Entity/ComponentManager.h"
 #include "Reflection/ReflectionRegistrator.h"
+#include "UI/UIControl.h"
 #include "Base/GlobalEnum.h"
 
 ENUM_DECLARE(DAVA::UIDebugRenderComponent::ePivotPointDrawMode)
@@ -43,6 +44,10 @@ UIDebugRenderComponent::UIDebugRenderComponent(const UIDebugRenderComponent& src
 void UIDebugRenderComponent::SetEnabled(bool _enabled)
 {
     enabled = _enabled;
+    if (GetControl() != nullptr)
+    {
+        GetControl()->SetRenderDirty();
+    }
 }
 
 bool UIDebugRenderComponent::IsEnabled() const
@@ -53,6 +58,10 @@ bool UIDebugRenderComponent::IsEnabled() const
 void UIDebugRenderComponent::SetDrawColor(const Color& color)
 {
     drawColor = color;
+    if (GetControl() != nullptr)
+    {
+        GetControl()->SetRenderDirty();
+    }
 }
 
 const Color& UIDebugRenderComponent::GetDrawColor() const
@@ -63,6 +72,10 @@ const Color& UIDebugRenderComponent::GetDrawColor() const
 void UIDebugRenderComponent::SetPivotPointDrawMode(ePivotPointDrawMode mode)
 {
     pivotPointDrawMode = mode;
+    if (GetControl() != nullptr)
+    {
+        GetControl()->SetRenderDirty();
+    }
 }
 
 UIDebugRenderComponent::ePivotPointDrawMode UIDebugRenderComponent::GetPivotPointDrawMode() const
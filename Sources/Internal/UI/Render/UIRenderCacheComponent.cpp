@@ -0,0 +1,47 @@
+#include "UI/Render/UIRenderCacheComponent.h"
+#include "Engine/Engine.h"
+#include "Entity/ComponentManager.h"
+#include "Reflection/ReflectionRegistrator.h"
+
+namespace DAVA
+{
+DAVA_VIRTUAL_REFLECTION_IMPL(UIRenderCacheComponent)
+{
+    ReflectionRegistrator<UIRenderCacheComponent>::Begin()[M::DisplayName("Render Cache"), M::Group("Content")]
+    .ConstructorByPointer()
+    .DestructorByPointer([](UIRenderCacheComponent* c) { SafeRelease(c); })
+    .Field("enabled", &UIRenderCacheComponent::IsEnabled, &UIRenderCacheComponent::SetEnabled)[M::DisplayName("Enabled")]
+    .End();
+}
+IMPLEMENT_UI_COMPONENT(UIRenderCacheComponent);
+
+UIRenderCacheComponent::UIRenderCacheComponent()
+{
+}
+
+UIRenderCacheComponent::UIRenderCacheComponent(const UIRenderCacheComponent& src)
+    : UIComponent(src)
+    , enabled(src.enabled)
+{
+}
+
+UIRenderCacheComponent* UIRenderCacheComponent::Clone() const
+{
+    return new UIRenderCacheComponent(*this);
+}
+
+void UIRenderCacheComponent::SetEnabled(bool enabled_)
+{
+    enabled = enabled_;
+    SetDirty();
+}
+
+void UIRenderCacheComponent::SetDirty()
+{
+    if (!dirty)
+    {
+        dirty = true;
+        batchList.Clear();
+    }
+}
+}
@@ -0,0 +1,64 @@
+#pragma once
+
+#include "Base/BaseTypes.h"
+#include "Math/Color.h"
+#include "Reflection/Reflection.h"
+#include "Render/2D/Systems/BatchList2D.h"
+#include "UI/Components/UIComponent.h"
+#include "UI/UIGeometricData.h"
+
+namespace DAVA
+{
+/**
+    Keeps batches generated by control and its children, so unchanged subtree is drawn by copying of recorded
+    vertices without walking controls and generating sprite geometry.
+
+    Cache is dropped by UIControl::SetRenderDirty, which is called when geometry, hierarchy, components, background
+    or text of control or any of its children is changed. Subtree is recorded again if its position, parent color
+    or clip is changed. Content drawn outside of 2D batching (3D views, particles) prevents caching.
+    Controls with custom `Draw` implementation changing picture without property changes should not be cached.
+*/
+class UIRenderCacheComponent : public UIComponent
+{
+    DAVA_VIRTUAL_REFLECTION(UIRenderCacheComponent, UIComponent);
+    DECLARE_UI_COMPONENT(UIRenderCacheComponent);
+
+public:
+    UIRenderCacheComponent();
+    UIRenderCacheComponent(const UIRenderCacheComponent& src);
+
+    UIRenderCacheComponent* Clone() const override;
+
+    void SetEnabled(bool enabled);
+    bool IsEnabled() const;
+
+    /** Drop recorded batches, subtree will be recorded again on next draw */
+    void SetDirty();
+    bool IsDirty() const;
+
+private:
+    friend class UIRenderSystem;
+
+    ~UIRenderCacheComponent() override = default;
+    UIRenderCacheComponent& operator=(const UIRenderCacheComponent&) = delete;
+
+    bool enabled = true;
+    bool dirty = true;
+
+    BatchList2D batchList;
+    UIGeometricData geometricData;
+    Color parentColor;
+    Rect clip;
+    uint32 generation = 0;
+};
+
+inline bool UIRenderCacheComponent::IsEnabled() const
+{
+    return enabled;
+}
+
+inline bool UIRenderCacheComponent::IsDirty() const
+{
+    return dirty;
+}
+}
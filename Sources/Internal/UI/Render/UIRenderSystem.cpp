@@ -1,18 +1,28 @@
 #include "UIRenderSystem.h"
 #include "Debug/ProfilerCPU.h"
 #include "Debug/ProfilerMarkerNames.h"
+#include "Engine/Engine.h"
+#include "Render/2D/FontManager.h"
+#include "Render/2D/FTGlyphAtlas.h"
 #include "Render/2D/Systems/RenderSystem2D.h"
 #include "Render/2D/Systems/VirtualCoordinatesSystem.h"
 #include "Render/2D/TextBlock.h"
+#include "Render/2D/TextBlockAtlasRender.h"
 #include "Render/2D/TextBlockSoftwareRender.h"
 #include "Render/Renderer.h"
 #include "UI/Render/UIClipContentComponent.h"
 #include "UI/Render/UIDebugRenderComponent.h"
+#include "UI/Render/UIRenderCacheComponent.h"
 #include "UI/Scene3D/UISceneComponent.h"
 #include "UI/Text/Private/UITextSystemLink.h"
 #include "UI/Text/UITextComponent.h"
 #include "UI/UIControl.h"
 #include "UI/UIControlSystem.h"
+#include "UI/UIMovieView.h"
+#include "UI/UIParticles.h"
+#include "UI/UIScrollBar.h"
+#include "UI/UITextField.h"
+#include "UI/UIWebView.h"
 #include "UI/UIScreen.h"
 #include "UI/UIScreenTransition.h"
 #include "UI/UIScreenshoter.h"
@@ -23,6 +33,7 @@ namespace DAVA
 namespace RenderTextDetails
 {
 static void PrepareSprite(const UITextSystemLink* link);
+static void DrawGlyphs(TextBlockAtlasRender* atlasRender, const UIGeometricData& textGeomData, int32 align, const Color& color);
 
 #if defined(LOCALIZATION_DEBUG)
 static void DrawDebug(const UITextSystemLink* link, const UIGeometricData& textGeomData);
@@ -87,6 +98,8 @@ void UIRenderSystem::Render()
 {
     DAVA_PROFILER_CPU_SCOPE(ProfilerCPUMarkerName::UI_RENDER_SYSTEM);
 
+    InvalidateRenderCachesIfGlyphAtlasChanged();
+
     if (currentScreen.Valid())
     {
         RenderControlHierarhy(currentScreen.Get(), baseGeometricData, nullptr);
@@ -104,7 +117,11 @@ void UIRenderSystem::ForceRenderControl(UIControl* control)
 {
     DAVA_PROFILER_CPU_SCOPE(ProfilerCPUMarkerName::UI_RENDER_SYSTEM);
 
+    // Control can be drawn to render target with different transform, so recorded vertices are not usable
+    bool prevUseRenderCaches = useRenderCaches;
+    useRenderCaches = false;
     RenderControlHierarhy(control, baseGeometricData, nullptr);
+    useRenderCaches = prevUseRenderCaches;
 }
 
 const UIGeometricData& UIRenderSystem::GetBaseGeometricData() const
@@ -149,6 +166,28 @@ void UIRenderSystem::SetPopupContainer(const RefPtr<UIControl>& _popupContainer)
     popupContainer = _popupContainer;
 }
 
+void UIRenderSystem::InvalidateRenderCaches()
+{
+    ++renderCacheGeneration;
+}
+
+void UIRenderSystem::InvalidateRenderCachesIfGlyphAtlasChanged()
+{
+    // recorded text batches refer to pages of glyph atlas or to textures of text blocks, which are replaced
+    // when atlas is cleared or switched
+    FontManager* fontManager = GetEngineContext()->fontManager;
+    if (fontManager != nullptr)
+    {
+        uint32 generation = fontManager->GetGlyphAtlas()->GetGeneration();
+        if (glyphAtlasGeneration != generation || glyphAtlasEnabled != TextBlock::IsGlyphAtlasEnabled())
+        {
+            glyphAtlasGeneration = generation;
+            glyphAtlasEnabled = TextBlock::IsGlyphAtlasEnabled();
+            InvalidateRenderCaches();
+        }
+    }
+}
+
 void UIRenderSystem::RenderControlHierarhy(UIControl* control, const UIGeometricData& geometricData, const UIControlBackground* parentBackground)
 {
     if (!control->GetVisibilityFlag() || control->IsHiddenForDebug())
@@ -161,6 +200,36 @@ void UIRenderSystem::RenderControlHierarhy(UIControl* control, const UIGeometric
 
     control->SetParentColor(parentColor);
 
+    UIRenderCacheComponent* renderCache = nullptr;
+    Rect renderCacheClip;
+    if (useRenderCaches)
+    {
+        renderCache = control->GetComponent<UIRenderCacheComponent>();
+        if (renderCache != nullptr && renderCache->IsEnabled())
+        {
+            if (IsRenderCacheValid(renderCache, drawData, parentColor))
+            {
+                renderSystem2D->PushBatchList(renderCache->batchList);
+                return;
+            }
+
+            renderCacheClip = renderSystem2D->GetClip();
+            BeginRenderCache(renderCache);
+        }
+        else
+        {
+            renderCache = nullptr;
+        }
+    }
+
+    if (!recordingCaches.empty() && !CanCacheControl(control))
+    {
+        for (UIRenderCacheComponent* recordingCache : recordingCaches)
+        {
+            recordingCache->batchList.complete = false;
+        }
+    }
+
     const Rect& unrotatedRect = drawData.GetUnrotatedRect();
 
     UIClipContentComponent* clipContent = control->GetComponent<UIClipContentComponent>();
@@ -199,6 +268,62 @@ void UIRenderSystem::RenderControlHierarhy(UIControl* control, const UIGeometric
     {
         DebugRender(debugRenderComponent, drawData);
     }
+
+    if (renderCache != nullptr)
+    {
+        EndRenderCache(renderCache, drawData, parentColor, renderCacheClip);
+    }
+}
+
+bool UIRenderSystem::IsRenderCacheValid(const UIRenderCacheComponent* renderCache, const UIGeometricData& geometricData, const Color& parentColor) const
+{
+    const UIGeometricData& cachedData = renderCache->geometricData;
+    return !renderCache->dirty &&
+    renderCache->generation == renderCacheGeneration &&
+    renderCache->clip == renderSystem2D->GetClip() &&
+    renderCache->parentColor == parentColor &&
+    cachedData.position == geometricData.position &&
+    cachedData.size == geometricData.size &&
+    cachedData.pivotPoint == geometricData.pivotPoint &&
+    cachedData.scale == geometricData.scale &&
+    cachedData.angle == geometricData.angle;
+}
+
+void UIRenderSystem::BeginRenderCache(UIRenderCacheComponent* renderCache)
+{
+    renderSystem2D->BeginRecording(&renderCache->batchList);
+    recordingCaches.push_back(renderCache);
+    // SetDirty called while subtree is drawn will drop this recording
+    renderCache->dirty = false;
+}
+
+void UIRenderSystem::EndRenderCache(UIRenderCacheComponent* renderCache, const UIGeometricData& geometricData, const Color& parentColor, const Rect& clip)
+{
+    DVASSERT(!recordingCaches.empty() && recordingCaches.back() == renderCache);
+    recordingCaches.pop_back();
+    renderSystem2D->EndRecording();
+
+    renderCache->geometricData = geometricData;
+    renderCache->parentColor = parentColor;
+    renderCache->clip = clip;
+    renderCache->generation = renderCacheGeneration;
+    if (!renderCache->batchList.complete)
+    {
+        renderCache->dirty = true;
+    }
+}
+
+bool UIRenderSystem::CanCacheControl(const UIControl* control) const
+{
+    // 3D views and particles are drawn bypassing batching, other controls change their picture in Draw
+    // without notification about changes
+    return control->GetComponentCount<UISceneComponent>() == 0 &&
+    dynamic_cast<const UIParticles*>(control) == nullptr &&
+    dynamic_cast<const UITextField*>(control) == nullptr &&
+    dynamic_cast<const UIScrollBar*>(control) == nullptr &&
+    dynamic_cast<const UIMovieView*>(control) == nullptr &&
+    dynamic_cast<const UIWebView*>(control) == nullptr &&
+    dynamic_cast<const UIScreenTransition*>(control) == nullptr;
 }
 
 void UIRenderSystem::DebugRender(const UIDebugRenderComponent* component, const UIGeometricData& geometricData)
@@ -292,6 +417,17 @@ void UIRenderSystem::RenderText(const UIControl* control, const UITextComponent*
 
     RenderTextDetails::PrepareSprite(link);
 
+    TextBlockAtlasRender* atlasRender = dynamic_cast<TextBlockAtlasRender*>(textBlock->GetRenderer());
+
+    // text drawn without sprite will appear later, so it can't be cached yet
+    if (atlasRender == nullptr && !textBlock->IsSpriteReady() && textBlock->GetFont() && textBlock->GetFont()->GetFontType() == Font::TYPE_FT)
+    {
+        for (UIRenderCacheComponent* recordingCache : recordingCaches)
+        {
+            recordingCache->batchList.complete = false;
+        }
+    }
+
     textBg->SetAlign(textBlock->GetVisualAlign());
 
     UIGeometricData textGeomData;
@@ -301,6 +437,24 @@ void UIRenderSystem::RenderText(const UIControl* control, const UITextComponent*
 
     Vector2 shadowOffset = component->GetShadowOffset();
 
+    if (atlasRender != nullptr)
+    {
+        if (!FLOAT_EQUAL(shadowBg->GetDrawColor().a, 0.0f) && (!FLOAT_EQUAL(shadowOffset.dx, 0.0f) || !FLOAT_EQUAL(shadowOffset.dy, 0.0f)))
+        {
+            UIGeometricData shadowGeomData;
+            shadowGeomData.position = shadowOffset;
+            shadowGeomData.size = control->GetSize();
+            shadowGeomData.AddGeometricData(textGeomData);
+            RenderTextDetails::DrawGlyphs(atlasRender, shadowGeomData, textBg->GetAlign(), shadowBg->GetDrawColor());
+        }
+        RenderTextDetails::DrawGlyphs(atlasRender, textGeomData, textBg->GetAlign(), textBg->GetDrawColor());
+
+#if defined(LOCALIZATION_DEBUG)
+        RenderTextDetails::DrawDebug(link, geometricData);
+#endif
+        return;
+    }
+
     if (!FLOAT_EQUAL(shadowBg->GetDrawColor().a, 0.0f) && (!FLOAT_EQUAL(shadowOffset.dx, 0.0f) || !FLOAT_EQUAL(shadowOffset.dy, 0.0f)))
     {
         textBlock->Draw(shadowBg->GetDrawColor(), &shadowOffset);
@@ -355,6 +509,29 @@ static void PrepareSprite(const UITextSystemLink* link)
     }
 }
 
+static void DrawGlyphs(TextBlockAtlasRender* atlasRender, const UIGeometricData& textGeomData, int32 align, const Color& color)
+{
+    // text is placed in control like aligned sprite of software rendered text
+    UIGeometricData glyphsGeomData;
+    glyphsGeomData.position = atlasRender->GetAlignedOffset(textGeomData.size, align);
+    glyphsGeomData.size = atlasRender->GetTextSize();
+    glyphsGeomData.AddGeometricData(textGeomData);
+
+    if (glyphsGeomData.angle == 0.f && glyphsGeomData.scale == Vector2(1.f, 1.f))
+    {
+        // keep glyph pixels on pixels of screen to avoid blurring
+        const VirtualCoordinatesSystem* vcs = GetEngineContext()->uiControlSystem->vcs;
+        Vector2 physicalPosition = vcs->ConvertVirtualToPhysical(glyphsGeomData.position);
+        physicalPosition.x = std::floor(physicalPosition.x + 0.5f);
+        physicalPosition.y = std::floor(physicalPosition.y + 0.5f);
+        glyphsGeomData.position = vcs->ConvertPhysicalToVirtual(physicalPosition);
+    }
+
+    Matrix3 transform;
+    glyphsGeomData.BuildTransformMatrix(transform);
+    atlasRender->Draw(color, Convert2DTransformTo3DTransform(transform));
+}
+
 
 #if defined(LOCALIZATION_DEBUG)
 enum DebugHighliteColor
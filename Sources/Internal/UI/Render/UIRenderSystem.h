@@ -11,6 +11,7 @@ class Color;
 class RenderSystem2D;
 class UIControlBackground;
 class UIDebugRenderComponent;
+class UIRenderCacheComponent;
 class UITextComponent;
 class UIScreen;
 class UIScreenTransition;
@@ -36,6 +37,9 @@ public:
     void SetCurrentScreen(const RefPtr<UIScreen>& screen);
     void SetPopupContainer(const RefPtr<UIControl>& popupContainer);
 
+    /** Drop all recorded UIRenderCacheComponent batches, e.g. after change of virtual to physical transform */
+    void InvalidateRenderCaches();
+
 protected:
     void OnControlVisible(UIControl* control) override;
     void OnControlInvisible(UIControl* control) override;
@@ -51,11 +55,17 @@ private:
 
     void RenderControlHierarhy(UIControl* control, const UIGeometricData& geometricData, const UIControlBackground* parentBackground);
 
+    bool IsRenderCacheValid(const UIRenderCacheComponent* renderCache, const UIGeometricData& geometricData, const Color& parentColor) const;
+    void BeginRenderCache(UIRenderCacheComponent* renderCache);
+    void EndRenderCache(UIRenderCacheComponent* renderCache, const UIGeometricData& geometricData, const Color& parentColor, const Rect& clip);
+    bool CanCacheControl(const UIControl* control) const;
+
     void DebugRender(const UIDebugRenderComponent* component, const UIGeometricData& geometricData);
     void RenderDebugRect(const UIDebugRenderComponent* component, const UIGeometricData& geometricData);
     void RenderPivotPoint(const UIDebugRenderComponent* component, const UIGeometricData& geometricData);
 
     void RenderText(const UIControl* control, const UITextComponent* component, const UIGeometricData& geometricData, const Color& parentColor);
+    void InvalidateRenderCachesIfGlyphAtlasChanged();
 
     RenderSystem2D* renderSystem2D = nullptr;
     UIGeometricData baseGeometricData;
@@ -67,5 +77,11 @@ private:
 
     Set<UIControl*> ui3DViews;
     bool needClearMainPass = true;
+
+    Vector<UIRenderCacheComponent*> recordingCaches;
+    uint32 renderCacheGeneration = 1;
+    bool useRenderCaches = true;
+    uint32 glyphAtlasGeneration = 0;
+    bool glyphAtlasEnabled = false;
 };
 }
@@ -3,6 +3,7 @@
 #include "Engine/Engine.h"
 #include "Entity/ComponentManager.h"
 #include "Reflection/ReflectionRegistrator.h"
+#include "UI/UIControl.h"
 #include "UITextSystemLink.h"
 
 ENUM_DECLARE(DAVA::UITextComponent::eTextMultiline)
@@ -231,6 +232,10 @@ void UITextComponent::SetShadowOffset(const Vector2& value)
     if (shadowOffset != value)
     {
         shadowOffset = value;
+        if (GetControl() != nullptr)
+        {
+            GetControl()->SetRenderDirty();
+        }
     }
 }
 
@@ -314,6 +319,10 @@ void UITextComponent::SetTextOffset(const Vector2& value)
     if (textOffset != value)
     {
         textOffset = value;
+        if (GetControl() != nullptr)
+        {
+            GetControl()->SetRenderDirty();
+        }
     }
 }
 
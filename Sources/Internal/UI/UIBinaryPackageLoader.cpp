@@ -0,0 +1,706 @@
+#include "UI/UIBinaryPackageLoader.h"
+
+#include "FileSystem/FileSystem.h"
+#include "Logger/Logger.h"
+#include "Reflection/ReflectedTypeDB.h"
+#include "UI/Private/UIBinaryPackageFormat.h"
+#include "UI/Styles/UIStyleSheetPropertyDataBase.h"
+#include "UI/UIPackage.h"
+#include "UI/UIPackageLoader.h"
+#include "Utils/CRC32.h"
+#include "Utils/UTF8Utils.h"
+
+namespace DAVA
+{
+namespace UIBinaryPackageLoaderDetails
+{
+using namespace UIBinaryPackageFormat;
+
+struct FieldInfo
+{
+    uint32 owner = 0;
+    const ReflectedStructure::Field* field = nullptr;
+    const Type* type = nullptr;
+};
+
+struct PackageTables
+{
+    Vector<String> strings;
+    Vector<FastName> names;
+    Vector<FieldInfo> fields;
+    Vector<const Type*> components;
+
+    bool GetString(uint32 index, const String*& string) const
+    {
+        if (index >= strings.size())
+        {
+            return false;
+        }
+        string = &strings[index];
+        return true;
+    }
+
+    bool GetName(uint32 index, FastName& name)
+    {
+        if (index == INVALID_INDEX)
+        {
+            name = FastName();
+            return true;
+        }
+        if (index >= strings.size())
+        {
+            return false;
+        }
+        if (!names[index].IsValid())
+        {
+            names[index] = FastName(strings[index]);
+        }
+        name = names[index];
+        return true;
+    }
+};
+
+const ReflectedStructure::Field* FindField(const String& owner, const String& fieldName)
+{
+    const ReflectedType* ownerType = ReflectedTypeDB::GetByPermanentName(owner);
+    const ReflectedStructure* structure = ownerType != nullptr ? ownerType->GetStructure() : nullptr;
+    if (structure != nullptr)
+    {
+        FastName name(fieldName);
+        for (const std::unique_ptr<ReflectedStructure::Field>& field : structure->fields)
+        {
+            if (field->name == name)
+            {
+                return field.get();
+            }
+        }
+    }
+    return nullptr;
+}
+
+bool ReadTables(Reader& reader, PackageTables& tables)
+{
+    uint32 count = 0;
+    if (!reader.Read(count))
+    {
+        return false;
+    }
+    tables.strings.resize(count);
+    tables.names.resize(count);
+    for (String& string : tables.strings)
+    {
+        if (!reader.ReadString(string))
+        {
+            return false;
+        }
+    }
+
+    if (!reader.Read(count))
+    {
+        return false;
+    }
+    tables.fields.resize(count);
+    for (FieldInfo& info : tables.fields)
+    {
+        uint32 name = 0;
+        const String* ownerString = nullptr;
+        const String* nameString = nullptr;
+        if (!reader.Read(info.owner) || !reader.Read(name) || !tables.GetString(info.owner, ownerString) || !tables.GetString(name, nameString))
+        {
+            return false;
+        }
+
+        info.field = FindField(*ownerString, *nameString);
+        if (info.field == nullptr)
+        {
+            Logger::Warning("[UIBinaryPackageLoader] Field %s::%s not found", ownerString->c_str(), nameString->c_str());
+            return false;
+        }
+        info.type = info.field->valueWrapper->GetType(ReflectedObject())->Decay();
+    }
+
+    if (!reader.Read(count))
+    {
+        return false;
+    }
+    tables.components.resize(count);
+    for (const Type*& component : tables.components)
+    {
+        uint32 name = 0;
+        const String* nameString = nullptr;
+        if (!reader.Read(name) || !tables.GetString(name, nameString))
+        {
+            return false;
+        }
+
+        const ReflectedType* componentType = ReflectedTypeDB::GetByPermanentName(*nameString);
+        if (componentType == nullptr)
+        {
+            Logger::Warning("[UIBinaryPackageLoader] Component %s not found", nameString->c_str());
+            return false;
+        }
+        component = componentType->GetType();
+    }
+    return true;
+}
+
+template <size_t N>
+bool ReadFloats(Reader& reader, float32 (&values)[N])
+{
+    for (float32& value : values)
+    {
+        if (!reader.Read(value))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+template <typename T>
+bool ReadPrimitive(Reader& reader, Any& value)
+{
+    T result;
+    if (!reader.Read(result))
+    {
+        return false;
+    }
+    value = result;
+    return true;
+}
+
+bool ReadValue(Reader& reader, PackageTables& tables, const Type* fieldType, Any& value)
+{
+    uint8 valueType = 0;
+    if (!reader.Read(valueType))
+    {
+        return false;
+    }
+
+    switch (valueType)
+    {
+    case VALUE_BOOL:
+    {
+        uint8 result = 0;
+        if (!reader.Read(result))
+        {
+            return false;
+        }
+        value = result != 0;
+        return true;
+    }
+    case VALUE_INT32:
+        return ReadPrimitive<int32>(reader, value);
+    case VALUE_UINT32:
+        return ReadPrimitive<uint32>(reader, value);
+    case VALUE_INT64:
+        return ReadPrimitive<int64>(reader, value);
+    case VALUE_UINT64:
+        return ReadPrimitive<uint64>(reader, value);
+    case VALUE_FLOAT32:
+        return ReadPrimitive<float32>(reader, value);
+    case VALUE_FASTNAME:
+    {
+        uint32 index = 0;
+        FastName name;
+        if (!reader.Read(index) || !tables.GetName(index, name))
+        {
+            return false;
+        }
+        value = name;
+        return true;
+    }
+    case VALUE_STRING:
+    case VALUE_WIDESTRING:
+    case VALUE_FILEPATH:
+    {
+        uint32 index = 0;
+        const String* string = nullptr;
+        if (!reader.Read(index) || !tables.GetString(index, string))
+        {
+            return false;
+        }
+
+        if (valueType == VALUE_STRING)
+        {
+            value = *string;
+        }
+        else if (valueType == VALUE_WIDESTRING)
+        {
+            value = UTF8Utils::EncodeToWideString(*string);
+        }
+        else
+        {
+            value = string->empty() ? FilePath() : FilePath(*string);
+        }
+        return true;
+    }
+    case VALUE_VECTOR2:
+    {
+        float32 v[2];
+        if (!ReadFloats(reader, v))
+        {
+            return false;
+        }
+        value = Vector2(v[0], v[1]);
+        return true;
+    }
+    case VALUE_VECTOR3:
+    {
+        float32 v[3];
+        if (!ReadFloats(reader, v))
+        {
+            return false;
+        }
+        value = Vector3(v[0], v[1], v[2]);
+        return true;
+    }
+    case VALUE_VECTOR4:
+    case VALUE_COLOR:
+    case VALUE_RECT:
+    {
+        float32 v[4];
+        if (!ReadFloats(reader, v))
+        {
+            return false;
+        }
+
+        if (valueType == VALUE_VECTOR4)
+        {
+            value = Vector4(v[0], v[1], v[2], v[3]);
+        }
+        else if (valueType == VALUE_COLOR)
+        {
+            value = Color(v[0], v[1], v[2], v[3]);
+        }
+        else
+        {
+            value = Rect(v[0], v[1], v[2], v[3]);
+        }
+        return true;
+    }
+    case VALUE_ENUM:
+    {
+        int32 result = 0;
+        if (!reader.Read(result))
+        {
+            return false;
+        }
+        value = Any(result);
+        if (fieldType != nullptr && fieldType->GetSize() == sizeof(int32))
+        {
+            value = value.ReinterpretCast(fieldType);
+        }
+        return true;
+    }
+    default:
+        return false;
+    }
+}
+
+bool ReadStyleSheet(Reader& reader, PackageTables& tables, AbstractUIPackageBuilder* builder)
+{
+    const UIStyleSheetPropertyDataBase* propertyDB = UIStyleSheetPropertyDataBase::Instance();
+
+    uint32 count = 0;
+    if (!reader.Read(count))
+    {
+        return false;
+    }
+
+    Vector<UIStyleSheetSelectorChain> selectorChains;
+    selectorChains.reserve(count);
+    for (uint32 i = 0; i < count; ++i)
+    {
+        uint32 index = 0;
+        const String* selector = nullptr;
+        if (!reader.Read(index) || !tables.GetString(index, selector))
+        {
+            return false;
+        }
+        selectorChains.push_back(UIStyleSheetSelectorChain(*selector));
+    }
+
+    if (!reader.Read(count))
+    {
+        return false;
+    }
+
+    Vector<UIStyleSheetProperty> properties;
+    properties.reserve(count);
+    for (uint32 i = 0; i < count; ++i)
+    {
+        uint32 nameIndex = 0;
+        FastName name;
+        if (!reader.Read(nameIndex) || !tables.GetName(nameIndex, name) || !propertyDB->IsValidStyleSheetProperty(name))
+        {
+            return false;
+        }
+
+        uint32 propertyIndex = propertyDB->GetStyleSheetPropertyIndex(name);
+        const UIStyleSheetPropertyDescriptor& descr = propertyDB->GetStyleSheetPropertyByIndex(propertyIndex);
+        const Type* fieldType = descr.field != nullptr ? descr.field->valueWrapper->GetType(ReflectedObject())->Decay() : nullptr;
+
+        Any value;
+        uint8 transition = 0;
+        int32 transitionFunction = 0;
+        float32 transitionTime = 0.f;
+        if (!ReadValue(reader, tables, fieldType, value) || !reader.Read(transition) || !reader.Read(transitionFunction) || !reader.Read(transitionTime))
+        {
+            return false;
+        }
+        properties.push_back(UIStyleSheetProperty(propertyIndex, value, transition != 0, static_cast<Interpolation::FuncType>(transitionFunction), transitionTime));
+    }
+
+    if (builder != nullptr)
+    {
+        builder->ProcessStyleSheet(selectorChains, properties);
+    }
+    return true;
+}
+
+// Only validates operations if `builder` is nullptr
+bool ReadOperations(Reader& reader, PackageTables& tables, AbstractUIPackageLoader* loader, AbstractUIPackageBuilder* builder)
+{
+    // Begin/end operations have to be balanced, builders assert on broken nesting
+    uint32 controlsDepth = 0;
+    bool inComponent = false;
+
+    while (true)
+    {
+        uint8 op = OP_END;
+        if (!reader.Read(op))
+        {
+            return false;
+        }
+
+        switch (op)
+        {
+        case OP_END:
+            return controlsDepth == 0 && !inComponent;
+
+        case OP_IMPORT:
+        {
+            uint32 path = 0;
+            const String* pathString = nullptr;
+            if (!reader.Read(path) || !tables.GetString(path, pathString))
+            {
+                return false;
+            }
+            if (builder != nullptr)
+            {
+                builder->ProcessImportedPackage(*pathString, loader);
+            }
+            break;
+        }
+
+        case OP_STYLE_SHEET:
+            if (!ReadStyleSheet(reader, tables, builder))
+            {
+                return false;
+            }
+            break;
+
+        case OP_BEGIN_CLASS:
+        {
+            uint32 name = 0, className = 0;
+            FastName controlName;
+            const String* classString = nullptr;
+            if (!reader.Read(name) || !reader.Read(className) || !tables.GetName(name, controlName) || !tables.GetString(className, classString))
+            {
+                return false;
+            }
+            if (builder != nullptr)
+            {
+                builder->BeginControlWithClass(controlName, *classString);
+            }
+            ++controlsDepth;
+            break;
+        }
+
+        case OP_BEGIN_CUSTOM_CLASS:
+        {
+            uint32 name = 0, customClassName = 0, className = 0;
+            FastName controlName;
+            const String* customClassString = nullptr;
+            const String* classString = nullptr;
+            if (!reader.Read(name) || !reader.Read(customClassName) || !reader.Read(className) ||
+                !tables.GetName(name, controlName) || !tables.GetString(customClassName, customClassString) || !tables.GetString(className, classString))
+            {
+                return false;
+            }
+            if (builder != nullptr)
+            {
+                builder->BeginControlWithCustomClass(controlName, *customClassString, *classString);
+            }
+            ++controlsDepth;
+            break;
+        }
+
+        case OP_BEGIN_PROTOTYPE:
+        {
+            uint32 name = 0, packageName = 0, prototypeName = 0, customClassName = 0;
+            FastName controlName;
+            FastName prototype;
+            const String* packageString = nullptr;
+            const String* customClassString = nullptr;
+            if (!reader.Read(name) || !reader.Read(packageName) || !reader.Read(prototypeName) || !reader.Read(customClassName) ||
+                !tables.GetName(name, controlName) || !tables.GetString(packageName, packageString) || !tables.GetName(prototypeName, prototype))
+            {
+                return false;
+            }
+            if (customClassName != INVALID_INDEX && !tables.GetString(customClassName, customClassString))
+            {
+                return false;
+            }
+            if (builder != nullptr)
+            {
+                builder->BeginControlWithPrototype(controlName, *packageString, prototype, customClassString, loader);
+            }
+            ++controlsDepth;
+            break;
+        }
+
+        case OP_BEGIN_PATH:
+        {
+            uint32 path = 0;
+            const String* pathString = nullptr;
+            if (!reader.Read(path) || !tables.GetString(path, pathString))
+            {
+                return false;
+            }
+            if (builder != nullptr)
+            {
+                builder->BeginControlWithPath(*pathString);
+            }
+            ++controlsDepth;
+            break;
+        }
+
+        case OP_END_CONTROL:
+        {
+            uint8 place = 0;
+            if (!reader.Read(place) || place > AbstractUIPackageBuilder::TO_PREVIOUS_CONTROL || controlsDepth == 0 || inComponent)
+            {
+                return false;
+            }
+            --controlsDepth;
+            if (builder != nullptr)
+            {
+                builder->EndControl(static_cast<AbstractUIPackageBuilder::eControlPlace>(place));
+            }
+            break;
+        }
+
+        case OP_CONTROL_PROPERTY:
+        case OP_COMPONENT_PROPERTY:
+        {
+            uint32 field = 0;
+            Any value;
+            if (!reader.Read(field) || field >= tables.fields.size())
+            {
+                return false;
+            }
+
+            const FieldInfo& info = tables.fields[field];
+            if (!ReadValue(reader, tables, info.type, value))
+            {
+                return false;
+            }
+
+            if (builder == nullptr)
+            {
+                break;
+            }
+
+            if (op == OP_CONTROL_PROPERTY)
+            {
+                builder->BeginControlPropertiesSection(tables.strings[info.owner]);
+                builder->ProcessProperty(*info.field, value);
+                builder->EndControlPropertiesSection();
+            }
+            else
+            {
+                builder->ProcessProperty(*info.field, value);
+            }
+            break;
+        }
+
+        case OP_BEGIN_COMPONENT:
+        {
+            uint32 component = 0, index = 0;
+            if (!reader.Read(component) || !reader.Read(index) || component >= tables.components.size() || controlsDepth == 0 || inComponent)
+            {
+                return false;
+            }
+            inComponent = true;
+            if (builder != nullptr)
+            {
+                builder->BeginComponentPropertiesSection(tables.components[component], index);
+            }
+            break;
+        }
+
+        case OP_END_COMPONENT:
+            if (!inComponent)
+            {
+                return false;
+            }
+            inComponent = false;
+            if (builder != nullptr)
+            {
+                builder->EndComponentPropertiesSection();
+            }
+            break;
+
+        case OP_DATA_BINDING:
+        {
+            uint32 fieldName = 0, expression = 0;
+            int32 mode = 0;
+            const String* fieldString = nullptr;
+            const String* expressionString = nullptr;
+            if (!reader.Read(fieldName) || !reader.Read(expression) || !reader.Read(mode) ||
+                !tables.GetString(fieldName, fieldString) || !tables.GetString(expression, expressionString))
+            {
+                return false;
+            }
+            if (builder != nullptr)
+            {
+                builder->ProcessDataBinding(*fieldString, *expressionString, mode);
+            }
+            break;
+        }
+
+        default:
+            return false;
+        }
+    }
+}
+}
+
+UIBinaryPackageLoader::UIBinaryPackageLoader() = default;
+
+UIBinaryPackageLoader::~UIBinaryPackageLoader() = default;
+
+bool UIBinaryPackageLoader::LoadPackage(const FilePath& packagePath, AbstractUIPackageBuilder* builder)
+{
+    if (LoadCompiledPackage(packagePath, builder))
+    {
+        return true;
+    }
+
+    UIPackageLoader loader;
+    return loader.LoadPackage(packagePath, builder);
+}
+
+bool UIBinaryPackageLoader::LoadControlByName(const FastName& name, AbstractUIPackageBuilder* builder)
+{
+    return false;
+}
+
+bool UIBinaryPackageLoader::LoadCompiledPackage(const FilePath& packagePath, AbstractUIPackageBuilder* builder)
+{
+    using namespace UIBinaryPackageLoaderDetails;
+
+    FilePath compiledPath = GetCompiledPackagePath(packagePath);
+    if (!FileSystem::Instance()->Exists(compiledPath))
+    {
+        return false;
+    }
+
+    Vector<uint8> data;
+    if (!FileSystem::Instance()->ReadFileContents(compiledPath, data))
+    {
+        return false;
+    }
+
+    Reader reader(data.data(), data.size());
+    uint32 magic = 0;
+    uint32 formatVersion = 0;
+    int32 packageVersion = 0;
+    if (!reader.Read(magic) || !reader.Read(formatVersion) || !reader.Read(packageVersion) ||
+        magic != MAGIC || formatVersion != FORMAT_VERSION ||
+        packageVersion < UIPackageLoader::MIN_SUPPORTED_VERSION || UIPackage::CURRENT_VERSION < packageVersion)
+    {
+        Logger::Warning("[UIBinaryPackageLoader] %s has unsupported format", compiledPath.GetStringValue().c_str());
+        return false;
+    }
+
+    uint32 sourcesHash = 0;
+    uint32 importsCount = 0;
+    if (!reader.Read(sourcesHash) || !reader.Read(importsCount))
+    {
+        Logger::Warning("[UIBinaryPackageLoader] %s is corrupted", compiledPath.GetStringValue().c_str());
+        return false;
+    }
+    Vector<String> importedPackages(importsCount);
+    for (String& importedPackage : importedPackages)
+    {
+        if (!reader.ReadString(importedPackage))
+        {
+            Logger::Warning("[UIBinaryPackageLoader] %s is corrupted", compiledPath.GetStringValue().c_str());
+            return false;
+        }
+    }
+
+    if (FileSystem::Instance()->Exists(packagePath))
+    {
+        uint32 actualHash = 0;
+        if (!CalculateSourcesHash(packagePath, importedPackages, actualHash) || actualHash != sourcesHash)
+        {
+            Logger::Info("[UIBinaryPackageLoader] %s is outdated", compiledPath.GetStringValue().c_str());
+            return false;
+        }
+    }
+
+    PackageTables tables;
+    if (!ReadTables(reader, tables))
+    {
+        Logger::Warning("[UIBinaryPackageLoader] %s doesn't match reflection of application", compiledPath.GetStringValue().c_str());
+        return false;
+    }
+
+    // Builder can't be rolled back, so operations are validated before it gets the first call
+    Reader validationReader = reader;
+    if (!ReadOperations(validationReader, tables, this, nullptr))
+    {
+        Logger::Warning("[UIBinaryPackageLoader] %s is corrupted", compiledPath.GetStringValue().c_str());
+        return false;
+    }
+
+    builder->BeginPackage(packagePath, packageVersion);
+    bool replayed = ReadOperations(reader, tables, this, builder);
+    DVASSERT(replayed);
+    builder->EndPackage();
+
+    return true;
+}
+
+FilePath UIBinaryPackageLoader::GetCompiledPackagePath(const FilePath& packagePath)
+{
+    return FilePath::CreateWithNewExtension(packagePath, ".uib");
+}
+
+bool UIBinaryPackageLoader::CalculateSourcesHash(const FilePath& packagePath, const Vector<String>& importedPackages, uint32& hash)
+{
+    CRC32 crc;
+    Vector<uint8> data;
+    if (!FileSystem::Instance()->ReadFileContents(packagePath, data))
+    {
+        return false;
+    }
+    crc.AddData(data.data(), data.size());
+
+    for (const String& importedPackage : importedPackages)
+    {
+        if (!FileSystem::Instance()->ReadFileContents(FilePath(importedPackage), data))
+        {
+            return false;
+        }
+        crc.AddData(data.data(), data.size());
+    }
+
+    hash = crc.Done();
+    return true;
+}
+}
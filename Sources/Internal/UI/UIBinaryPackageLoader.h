@@ -0,0 +1,39 @@
+#pragma once
+
+#include "Base/BaseTypes.h"
+#include "FileSystem/FilePath.h"
+#include "UI/AbstractUIPackageBuilder.h"
+
+namespace DAVA
+{
+/**
+    Loader of UI packages compiled by UIPackageCompiler.
+    It replays recorded builder calls, so any AbstractUIPackageBuilder gets the same package as from yaml.
+    Compiled package is looked for next to yaml package, imported packages are loaded compiled if possible too.
+*/
+class UIBinaryPackageLoader : public AbstractUIPackageLoader
+{
+public:
+    UIBinaryPackageLoader();
+    ~UIBinaryPackageLoader() override;
+
+    /** Load compiled package if it exists, otherwise load yaml package by UIPackageLoader */
+    bool LoadPackage(const FilePath& packagePath, AbstractUIPackageBuilder* builder) override;
+
+    /** Prototypes are stored before their first usage, so there is nothing to load by name */
+    bool LoadControlByName(const FastName& name, AbstractUIPackageBuilder* builder) override;
+
+    /**
+        Load compiled package of yaml package `packagePath`.
+        Return false without any builder calls if compiled package doesn't exist, has other format version,
+        is older than yaml package or its imports, or is corrupted. Whole package is validated before the first builder call.
+    */
+    bool LoadCompiledPackage(const FilePath& packagePath, AbstractUIPackageBuilder* builder);
+
+    /** Path of compiled package for yaml package `packagePath` */
+    static FilePath GetCompiledPackagePath(const FilePath& packagePath);
+
+    /** Hash of contents of yaml package and `importedPackages` stored in compiled package, return false if any file can't be read */
+    static bool CalculateSourcesHash(const FilePath& packagePath, const Vector<String>& importedPackages, uint32& hash);
+};
+}
@@ -14,6 +14,7 @@
 #include "UI/Focus/FocusHelpers.h"
 #include "UI/Layouts/UILayoutSystem.h"
 #include "UI/Render/UIClipContentComponent.h"
+#include "UI/Render/UIRenderCacheComponent.h"
 #include "UI/Render/UIRenderSystem.h"
 #include "UI/Styles/UIStyleSheetSystem.h"
 #include "UI/UIAnalytics.h"
@@ -433,6 +434,7 @@ void UIControl::SetPivot(const Vector2& newPivot)
 void UIControl::SetAngle(float32 angleInRad)
 {
     angle = angleInRad;
+    SetRenderDirty();
 }
 
 void UIControl::SetAngleInDegrees(float32 angleInDeg)
@@ -480,6 +482,7 @@ void UIControl::SetScaledRect(const Rect& rect, bool rectInAbsoluteCoordinates /
         scale.y = rect.dy / (size.y * gd.scale.y);
         SetAbsolutePosition(Vector2(rect.x + GetPivotPoint().x * scale.x, rect.y + GetPivotPoint().y * scale.y));
     }
+    SetRenderDirty();
 }
 
 float32 UIControl::GetAngleInDegrees() const
@@ -1816,6 +1819,7 @@ bool UIControl::IsHiddenForDebug() const
 void UIControl::SetHiddenForDebug(bool hidden)
 {
     hiddenForDebug = hidden;
+    SetRenderDirty();
 }
 
 void UIControl::SystemOnFocusLost()
@@ -2316,6 +2320,7 @@ void UIControl::ResetStyleSheetDirty()
 void UIControl::SetLayoutDirty()
 {
     layoutDirty = true;
+    SetRenderDirty();
     if (scene)
     {
         scene->GetLayoutSystem()->SetDirty();
@@ -2336,6 +2341,7 @@ void UIControl::ResetLayoutDirty()
 void UIControl::SetLayoutPositionDirty()
 {
     layoutPositionDirty = true;
+    SetRenderDirty();
     if (scene)
     {
         scene->GetLayoutSystem()->SetDirty();
@@ -2354,6 +2360,7 @@ void UIControl::ResetLayoutPositionDirty()
 void UIControl::SetLayoutOrderDirty()
 {
     layoutOrderDirty = true;
+    SetRenderDirty();
 }
 
 void UIControl::ResetLayoutOrderDirty()
@@ -2361,6 +2368,18 @@ void UIControl::ResetLayoutOrderDirty()
     layoutOrderDirty = false;
 }
 
+void UIControl::SetRenderDirty()
+{
+    for (UIControl* control = this; control != nullptr; control = control->parent)
+    {
+        UIRenderCacheComponent* renderCache = control->GetComponent<UIRenderCacheComponent>();
+        if (renderCache != nullptr)
+        {
+            renderCache->SetDirty();
+        }
+    }
+}
+
 void UIControl::SetPackageContext(const RefPtr<UIControlPackageContext>& newPackageContext)
 {
     if (packageContext != newPackageContext)
@@ -1082,6 +1082,9 @@ public:
     void SetLayoutOrderDirty();
     void ResetLayoutOrderDirty();
 
+    /** Drop render caches of this control and its parents, should be called on any change of control picture */
+    void SetRenderDirty();
+
     RefPtr<UIControlPackageContext> GetPackageContext() const;
     const RefPtr<UIControlPackageContext>& GetLocalPackageContext() const;
     void SetPackageContext(const RefPtr<UIControlPackageContext>& packageContext);
@@ -1128,6 +1131,7 @@ inline const Vector2& UIControl::GetScale() const
 inline void UIControl::SetScale(const Vector2& newScale)
 {
     scale = newScale;
+    SetRenderDirty();
 }
 
 inline const Vector2& UIControl::GetSize() const
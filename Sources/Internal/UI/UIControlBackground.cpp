@@ -151,6 +151,7 @@ void UIControlBackground::SetSprite(const FilePath& path)
 void UIControlBackground::SetFrame(int32 drawFrame)
 {
     frame = drawFrame;
+    SetRenderDirty();
 }
 
 void UIControlBackground::SetFrame(const FastName& frameName)
@@ -166,6 +167,7 @@ void UIControlBackground::SetFrame(const FastName& frameName)
 void UIControlBackground::SetAlign(int32 drawAlign)
 {
     align = drawAlign;
+    SetRenderDirty();
 }
 
 void UIControlBackground::SetDrawType(UIControlBackground::eDrawType drawType)
@@ -186,17 +188,20 @@ void UIControlBackground::SetDrawType(UIControlBackground::eDrawType drawType)
 void UIControlBackground::SetModification(int32 modification)
 {
     spriteModification = modification;
+    SetRenderDirty();
 }
 
 void UIControlBackground::SetColorInheritType(UIControlBackground::eColorInheritType inheritType)
 {
     DVASSERT(inheritType >= 0 && inheritType < COLOR_INHERIT_TYPES_COUNT);
     colorInheritType = inheritType;
+    SetRenderDirty();
 }
 
 void UIControlBackground::SetPerPixelAccuracyType(ePerPixelAccuracyType accuracyType)
 {
     perPixelAccuracyType = accuracyType;
+    SetRenderDirty();
 }
 
 UIControlBackground::ePerPixelAccuracyType UIControlBackground::GetPerPixelAccuracyType() const
@@ -559,11 +564,13 @@ void UIControlBackground::ReleaseDrawData()
 void UIControlBackground::SetLeftRightStretchCap(float32 _leftStretchCap)
 {
     leftStretchCap = _leftStretchCap;
+    SetRenderDirty();
 }
 
 void UIControlBackground::SetTopBottomStretchCap(float32 _topStretchCap)
 {
     topStretchCap = _topStretchCap;
+    SetRenderDirty();
 }
 
 float32 UIControlBackground::GetLeftRightStretchCap() const
@@ -579,6 +586,7 @@ float32 UIControlBackground::GetTopBottomStretchCap() const
 void UIControlBackground::SetMaterial(NMaterial* _material)
 {
     material = _material;
+    SetRenderDirty();
 }
 
 inline NMaterial* UIControlBackground::GetMaterial() const
@@ -589,21 +597,25 @@ inline NMaterial* UIControlBackground::GetMaterial() const
 void UIControlBackground::SetRenderBatches(const Vector<BatchDescriptor2D>& batches)
 {
     batchDescriptors = batches;
+    SetRenderDirty();
 }
 
 void UIControlBackground::AppendRenderBatches(const Vector<BatchDescriptor2D>& batches)
 {
     batchDescriptors.insert(batchDescriptors.end(), batches.begin(), batches.end());
+    SetRenderDirty();
 }
 
 void UIControlBackground::AddRenderBatch(const BatchDescriptor2D& batch)
 {
     batchDescriptors.push_back(batch);
+    SetRenderDirty();
 }
 
 void UIControlBackground::ClearBatches()
 {
     batchDescriptors.clear();
+    SetRenderDirty();
 }
 
 const Vector<BatchDescriptor2D>& UIControlBackground::GetRenderBatches() const
@@ -614,6 +626,7 @@ const Vector<BatchDescriptor2D>& UIControlBackground::GetRenderBatches() const
 void UIControlBackground::SetColor(const Color& _color)
 {
     color = _color;
+    SetRenderDirty();
 }
 
 const Color& UIControlBackground::GetColor() const
@@ -644,11 +657,13 @@ void UIControlBackground::SetMaskSpriteFromPath(const FilePath& path)
         mask.Set(Sprite::Create(path));
     else
         mask.Set(nullptr);
+    SetRenderDirty();
 }
 
 void UIControlBackground::SetMaskSprite(Sprite* sprite)
 {
     mask = sprite;
+    SetRenderDirty();
 }
 
 FilePath UIControlBackground::GetDetailSpritePath() const
@@ -664,11 +679,13 @@ void UIControlBackground::SetDetailSpriteFromPath(const FilePath& path)
         detail.Set(Sprite::Create(path));
     else
         detail.Set(nullptr);
+    SetRenderDirty();
 }
 
 void UIControlBackground::SetDetailSprite(Sprite* sprite)
 {
     detail = sprite;
+    SetRenderDirty();
 }
 
 FilePath UIControlBackground::GetGradientSpritePath() const
@@ -684,11 +701,13 @@ void UIControlBackground::SetGradientSpriteFromPath(const FilePath& path)
         gradient.Set(Sprite::Create(path));
     else
         gradient.Set(nullptr);
+    SetRenderDirty();
 }
 
 void UIControlBackground::SetGradientSprite(Sprite* sprite)
 {
     gradient = sprite;
+    SetRenderDirty();
 }
 
 FilePath UIControlBackground::GetContourSpritePath() const
@@ -704,11 +723,13 @@ void UIControlBackground::SetContourSpriteFromPath(const FilePath& path)
         contour.Set(Sprite::Create(path));
     else
         contour.Set(nullptr);
+    SetRenderDirty();
 }
 
 void UIControlBackground::SetContourSprite(Sprite* sprite)
 {
     contour = sprite;
+    SetRenderDirty();
 }
 
 eGradientBlendMode UIControlBackground::GetGradientBlendMode() const
@@ -719,5 +740,14 @@ eGradientBlendMode UIControlBackground::GetGradientBlendMode() const
 void UIControlBackground::SetGradientBlendMode(eGradientBlendMode mode)
 {
     gradientMode = mode;
+    SetRenderDirty();
+}
+
+void UIControlBackground::SetRenderDirty()
+{
+    if (GetControl()) //workaround for standalone backgrounds
+    {
+        GetControl()->SetRenderDirty();
+    }
 }
 };
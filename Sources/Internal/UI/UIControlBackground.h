@@ -278,6 +278,8 @@ protected:
     eGradientBlendMode gradientMode = GRADIENT_MULTIPLY;
 
 private:
+    void SetRenderDirty();
+
     TiledDrawData* tiledData = nullptr;
     StretchDrawData* stretchData = nullptr;
     TiledMultilayerData* tiledMultulayerData = nullptr;
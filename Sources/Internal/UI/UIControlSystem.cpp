@@ -86,6 +86,8 @@ UIControlSystem::UIControlSystem()
     soundSystem = GetSystem<UISoundSystem>();
     updateSystem = GetSystem<UIUpdateSystem>();
     renderSystem = GetSystem<UIRenderSystem>();
+    vcs->virtualSizeChanged.Connect(this, [this](const Size2i&) { renderSystem->InvalidateRenderCaches(); });
+    vcs->physicalSizeChanged.Connect(this, [this](const Size2i&) { renderSystem->InvalidateRenderCaches(); });
     eventsSystem = GetSystem<UIEventsSystem>();
 
     eventsSystem->RegisterCommands();
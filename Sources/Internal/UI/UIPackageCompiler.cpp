@@ -0,0 +1,743 @@
+#include "UI/UIPackageCompiler.h"
+
+#include "Base/RefPtr.h"
+#include "FileSystem/File.h"
+#include "FileSystem/FileSystem.h"
+#include "FileSystem/YamlNode.h"
+#include "FileSystem/YamlParser.h"
+#include "Logger/Logger.h"
+#include "Reflection/ReflectedTypeDB.h"
+#include "UI/AbstractUIPackageBuilder.h"
+#include "UI/Private/UIBinaryPackageFormat.h"
+#include "UI/Styles/UIStyleSheetPropertyDataBase.h"
+#include "UI/UIBinaryPackageLoader.h"
+#include "UI/UIPackage.h"
+#include "UI/UIPackageLoader.h"
+#include "Utils/StringFormat.h"
+#include "Utils/UTF8Utils.h"
+#include "Utils/Utils.h"
+
+namespace DAVA
+{
+struct UIPackageCompiler::ControlNode
+{
+    FastName name;
+    const ReflectedType* type = nullptr;
+    ControlNode* parent = nullptr;
+    Vector<std::unique_ptr<ControlNode>> children;
+};
+
+struct UIPackageCompiler::PackageControls
+{
+    Vector<std::unique_ptr<ControlNode>> prototypes;
+    Set<String> importedPackages; // direct and indirect imports, their changes can change compiled package
+
+    const ControlNode* FindPrototype(const FastName& name) const
+    {
+        for (const std::unique_ptr<ControlNode>& prototype : prototypes)
+        {
+            if (prototype->name == name)
+            {
+                return prototype.get();
+            }
+        }
+        return nullptr;
+    }
+};
+
+namespace UIPackageCompilerDetails
+{
+using ControlNode = UIPackageCompiler::ControlNode;
+
+std::unique_ptr<ControlNode> CloneNode(const ControlNode* node)
+{
+    std::unique_ptr<ControlNode> result = std::make_unique<ControlNode>();
+    result->name = node->name;
+    result->type = node->type;
+    for (const std::unique_ptr<ControlNode>& child : node->children)
+    {
+        std::unique_ptr<ControlNode> childClone = CloneNode(child.get());
+        childClone->parent = result.get();
+        result->children.push_back(std::move(childClone));
+    }
+    return result;
+}
+
+// Same as UIControlHelpers::FindControlByPath for paths without wildcards, packages written by editor use only names
+ControlNode* FindNodeByPath(const String& path, ControlNode* root)
+{
+    Vector<String> names;
+    Split(path, "/", names, false, true);
+
+    ControlNode* node = root;
+    for (const String& name : names)
+    {
+        if (name == "..")
+        {
+            node = node->parent;
+        }
+        else if (name != ".")
+        {
+            FastName childName(name);
+            auto it = std::find_if(node->children.begin(), node->children.end(), [&childName](const std::unique_ptr<ControlNode>& child) {
+                return child->name == childName;
+            });
+            node = it != node->children.end() ? it->get() : nullptr;
+        }
+
+        if (node == nullptr)
+        {
+            return nullptr;
+        }
+    }
+    return node;
+}
+
+const ReflectedType* GetControlType(const String& className, const ReflectedType* defaultType)
+{
+    const ReflectedType* type = ReflectedTypeDB::GetByPermanentName(className);
+    return type != nullptr ? type : defaultType;
+}
+
+bool LoadYamlPackage(const FilePath& packagePath, AbstractUIPackageBuilder* builder)
+{
+    if (!FileSystem::Instance()->Exists(packagePath))
+    {
+        return false;
+    }
+
+    RefPtr<YamlParser> parser(YamlParser::Create(packagePath));
+    if (!parser.Valid())
+    {
+        return false;
+    }
+
+    const YamlNode* rootNode = parser->GetRootNode();
+    if (rootNode == nullptr)
+    {
+        builder->BeginPackage(packagePath, UIPackage::CURRENT_VERSION);
+        builder->EndPackage();
+        return true;
+    }
+
+    // Imported packages are processed by recording builder itself, so loader reads only this yaml
+    UIPackageLoader loader;
+    return loader.LoadPackage(rootNode, packagePath, builder);
+}
+}
+
+/**
+    Builder which records calls of UIPackageLoader into stream of UIBinaryPackageFormat operations.
+    It keeps names and types of created controls to return the same types as DefaultUIPackageBuilder would do.
+*/
+class UIPackageRecordingBuilder : public AbstractUIPackageBuilder
+{
+public:
+    using ControlNode = UIPackageCompiler::ControlNode;
+    using PackageControls = UIPackageCompiler::PackageControls;
+
+    UIPackageRecordingBuilder(UIPackageCompiler* compiler_)
+        : compiler(compiler_)
+        , packageControls(std::make_shared<PackageControls>())
+    {
+    }
+
+    bool IsFailed() const
+    {
+        return failed;
+    }
+
+    const std::shared_ptr<PackageControls>& GetPackageControls() const
+    {
+        return packageControls;
+    }
+
+    bool GetCompiledData(Vector<uint8>& data) const
+    {
+        using namespace UIBinaryPackageFormat;
+
+        Vector<String> importedPackages(packageControls->importedPackages.begin(), packageControls->importedPackages.end());
+        uint32 sourcesHash = 0;
+        if (!UIBinaryPackageLoader::CalculateSourcesHash(packagePath, importedPackages, sourcesHash))
+        {
+            return false;
+        }
+
+        Writer writer;
+        writer.Write(MAGIC);
+        writer.Write(FORMAT_VERSION);
+        writer.Write(packageVersion);
+
+        writer.Write(sourcesHash);
+        writer.Write(static_cast<uint32>(importedPackages.size()));
+        for (const String& importedPackage : importedPackages)
+        {
+            writer.WriteString(importedPackage);
+        }
+
+        writer.Write(static_cast<uint32>(strings.size()));
+        for (const String& string : strings)
+        {
+            writer.WriteString(string);
+        }
+
+        writer.Write(static_cast<uint32>(fields.size()));
+        for (const std::pair<uint32, uint32>& field : fields)
+        {
+            writer.Write(field.first);
+            writer.Write(field.second);
+        }
+
+        writer.Write(static_cast<uint32>(components.size()));
+        for (uint32 component : components)
+        {
+            writer.Write(component);
+        }
+
+        writer.WriteData(ops.GetData());
+        writer.Write(OP_END);
+        data = writer.GetData();
+        return true;
+    }
+
+    void BeginPackage(const FilePath& packagePath_, int32 version) override
+    {
+        packagePath = packagePath_;
+        packageVersion = version;
+    }
+
+    void EndPackage() override
+    {
+        DVASSERT(controlsStack.empty());
+    }
+
+    bool ProcessImportedPackage(const String& importedPackagePath, AbstractUIPackageLoader* loader) override
+    {
+        std::shared_ptr<PackageControls> importedControls = compiler->LoadImportedPackage(importedPackagePath);
+        if (!importedControls)
+        {
+            SetFailed(Format("imported package %s can't be loaded", importedPackagePath.c_str()));
+            return false;
+        }
+
+        importedPackages[FilePath(importedPackagePath).GetBasename()] = importedControls;
+        packageControls->importedPackages.insert(importedPackagePath);
+        packageControls->importedPackages.insert(importedControls->importedPackages.begin(), importedControls->importedPackages.end());
+
+        ops.Write(UIBinaryPackageFormat::OP_IMPORT);
+        ops.Write(InternString(importedPackagePath));
+        return true;
+    }
+
+    void ProcessStyleSheet(const Vector<UIStyleSheetSelectorChain>& selectorChains, const Vector<UIStyleSheetProperty>& properties) override
+    {
+        const UIStyleSheetPropertyDataBase* propertyDB = UIStyleSheetPropertyDataBase::Instance();
+
+        ops.Write(UIBinaryPackageFormat::OP_STYLE_SHEET);
+        ops.Write(static_cast<uint32>(selectorChains.size()));
+        for (const UIStyleSheetSelectorChain& chain : selectorChains)
+        {
+            ops.Write(InternString(chain.ToString()));
+        }
+
+        ops.Write(static_cast<uint32>(properties.size()));
+        for (const UIStyleSheetProperty& property : properties)
+        {
+            const UIStyleSheetPropertyDescriptor& descr = propertyDB->GetStyleSheetPropertyByIndex(property.propertyIndex);
+            ops.Write(InternString(descr.name.c_str()));
+            if (!WriteValue(property.value))
+            {
+                SetFailed(Format("value of style sheet property %s has unsupported type", descr.name.c_str()));
+            }
+            ops.Write(static_cast<uint8>(property.transition));
+            ops.Write(static_cast<int32>(property.transitionFunction));
+            ops.Write(property.transitionTime);
+        }
+    }
+
+    const ReflectedType* BeginControlWithClass(const FastName& controlName, const String& className) override
+    {
+        ops.Write(UIBinaryPackageFormat::OP_BEGIN_CLASS);
+        ops.Write(InternName(controlName));
+        ops.Write(InternString(className));
+
+        return PushNewControl(controlName, UIPackageCompilerDetails::GetControlType(className, nullptr), className);
+    }
+
+    const ReflectedType* BeginControlWithCustomClass(const FastName& controlName, const String& customClassName, const String& className) override
+    {
+        ops.Write(UIBinaryPackageFormat::OP_BEGIN_CUSTOM_CLASS);
+        ops.Write(InternName(controlName));
+        ops.Write(InternString(customClassName));
+        ops.Write(InternString(className));
+
+        const ReflectedType* type = UIPackageCompilerDetails::GetControlType(customClassName, UIPackageCompilerDetails::GetControlType(className, nullptr));
+        return PushNewControl(controlName, type, className);
+    }
+
+    const ReflectedType* BeginControlWithPrototype(const FastName& controlName, const String& packageName, const FastName& prototypeName, const String* customClassName, AbstractUIPackageLoader* loader) override
+    {
+        const ControlNode* prototype = nullptr;
+        if (packageName.empty())
+        {
+            prototype = packageControls->FindPrototype(prototypeName);
+            if (prototype == nullptr && loader->LoadControlByName(prototypeName, this))
+            {
+                // Prototype is recorded before its first instance, so binary loader never loads controls by name
+                prototype = packageControls->FindPrototype(prototypeName);
+            }
+        }
+        else
+        {
+            auto it = importedPackages.find(packageName);
+            if (it != importedPackages.end())
+            {
+                prototype = it->second->FindPrototype(prototypeName);
+            }
+        }
+
+        ops.Write(UIBinaryPackageFormat::OP_BEGIN_PROTOTYPE);
+        ops.Write(InternName(controlName));
+        ops.Write(InternString(packageName));
+        ops.Write(InternName(prototypeName));
+        ops.Write(customClassName != nullptr ? InternString(*customClassName) : UIBinaryPackageFormat::INVALID_INDEX);
+
+        if (prototype == nullptr)
+        {
+            SetFailed(Format("prototype %s/%s not found", packageName.c_str(), prototypeName.c_str()));
+            controlsStack.emplace_back();
+            return nullptr;
+        }
+
+        std::unique_ptr<ControlNode> node;
+        if (customClassName != nullptr)
+        {
+            // DefaultUIPackageBuilder copies only data of prototype to control of custom class
+            node = std::make_unique<ControlNode>();
+            node->name = prototype->name;
+            node->type = UIPackageCompilerDetails::GetControlType(*customClassName, prototype->type);
+        }
+        else
+        {
+            node = UIPackageCompilerDetails::CloneNode(prototype);
+        }
+
+        if (controlName.IsValid())
+        {
+            node->name = controlName;
+        }
+
+        const ReflectedType* type = node->type;
+        controlsStack.emplace_back();
+        controlsStack.back().node = node.get();
+        controlsStack.back().ownedNode = std::move(node);
+        return type;
+    }
+
+    const ReflectedType* BeginControlWithPath(const String& pathName) override
+    {
+        ops.Write(UIBinaryPackageFormat::OP_BEGIN_PATH);
+        ops.Write(InternString(pathName));
+
+        ControlNode* node = nullptr;
+        if (!controlsStack.empty() && controlsStack.back().node != nullptr)
+        {
+            node = UIPackageCompilerDetails::FindNodeByPath(pathName, controlsStack.back().node);
+        }
+
+        if (node == nullptr)
+        {
+            SetFailed(Format("control by path %s not found", pathName.c_str()));
+        }
+
+        controlsStack.emplace_back();
+        controlsStack.back().node = node;
+        return node != nullptr ? node->type : nullptr;
+    }
+
+    const ReflectedType* BeginUnknownControl(const FastName& controlName, const YamlNode* node) override
+    {
+        SetFailed(Format("control %s has neither class nor prototype", controlName.c_str()));
+        controlsStack.emplace_back();
+        return nullptr;
+    }
+
+    void EndControl(eControlPlace controlPlace) override
+    {
+        ops.Write(UIBinaryPackageFormat::OP_END_CONTROL);
+        ops.Write(static_cast<uint8>(controlPlace));
+
+        DVASSERT(!controlsStack.empty());
+        std::unique_ptr<ControlNode> node = std::move(controlsStack.back().ownedNode);
+        controlsStack.pop_back();
+
+        if (node)
+        {
+            switch (controlPlace)
+            {
+            case TO_PROTOTYPES:
+                packageControls->prototypes.push_back(std::move(node));
+                break;
+
+            case TO_CONTROLS:
+                break;
+
+            case TO_PREVIOUS_CONTROL:
+                if (!controlsStack.empty() && controlsStack.back().node != nullptr)
+                {
+                    node->parent = controlsStack.back().node;
+                    controlsStack.back().node->children.push_back(std::move(node));
+                }
+                break;
+
+            default:
+                DVASSERT(false);
+                break;
+            }
+        }
+    }
+
+    void BeginControlPropertiesSection(const String& name) override
+    {
+        currentSection = name;
+    }
+
+    void EndControlPropertiesSection() override
+    {
+        currentSection.clear();
+    }
+
+    const ReflectedType* BeginComponentPropertiesSection(const Type* componentType, uint32 componentIndex) override
+    {
+        currentComponent = ReflectedTypeDB::GetByType(componentType);
+
+        ops.Write(UIBinaryPackageFormat::OP_BEGIN_COMPONENT);
+        if (currentComponent != nullptr && !currentComponent->GetPermanentName().empty())
+        {
+            ops.Write(InternComponent(currentComponent->GetPermanentName()));
+        }
+        else
+        {
+            SetFailed(Format("component %s has no permanent name", componentType->GetName()));
+            ops.Write(UIBinaryPackageFormat::INVALID_INDEX);
+        }
+        ops.Write(componentIndex);
+
+        return currentComponent;
+    }
+
+    void EndComponentPropertiesSection() override
+    {
+        ops.Write(UIBinaryPackageFormat::OP_END_COMPONENT);
+        currentComponent = nullptr;
+    }
+
+    void ProcessProperty(const ReflectedStructure::Field& field, const Any& value) override
+    {
+        // Empty values are skipped by builders, there is no need to store them
+        if (value.IsEmpty())
+        {
+            return;
+        }
+
+        const String& owner = currentComponent != nullptr ? currentComponent->GetPermanentName() : currentSection;
+        if (owner.empty() || ReflectedTypeDB::GetByPermanentName(owner) == nullptr)
+        {
+            SetFailed(Format("owner of property %s has no permanent name", field.name.c_str()));
+            return;
+        }
+
+        ops.Write(currentComponent != nullptr ? UIBinaryPackageFormat::OP_COMPONENT_PROPERTY : UIBinaryPackageFormat::OP_CONTROL_PROPERTY);
+        ops.Write(InternField(owner, field.name.c_str()));
+        if (!WriteValue(value))
+        {
+            SetFailed(Format("value of property %s has unsupported type %s", field.name.c_str(), value.GetType()->GetName()));
+        }
+    }
+
+    void ProcessDataBinding(const String& fieldName, const String& expression, int32 bindingMode) override
+    {
+        ops.Write(UIBinaryPackageFormat::OP_DATA_BINDING);
+        ops.Write(InternString(fieldName));
+        ops.Write(InternString(expression));
+        ops.Write(bindingMode);
+    }
+
+private:
+    struct ControlDescr
+    {
+        ControlNode* node = nullptr;
+        std::unique_ptr<ControlNode> ownedNode;
+    };
+
+    const ReflectedType* PushNewControl(const FastName& controlName, const ReflectedType* type, const String& className)
+    {
+        if (type == nullptr)
+        {
+            SetFailed(Format("class %s not found", className.c_str()));
+        }
+
+        std::unique_ptr<ControlNode> node = std::make_unique<ControlNode>();
+        node->name = controlName;
+        node->type = type;
+
+        controlsStack.emplace_back();
+        controlsStack.back().node = node.get();
+        controlsStack.back().ownedNode = std::move(node);
+        return type;
+    }
+
+    void SetFailed(const String& message)
+    {
+        Logger::Error("[UIPackageCompiler] %s: %s", packagePath.GetStringValue().c_str(), message.c_str());
+        failed = true;
+    }
+
+    uint32 InternString(const String& string)
+    {
+        auto it = stringIndices.find(string);
+        if (it != stringIndices.end())
+        {
+            return it->second;
+        }
+
+        uint32 index = static_cast<uint32>(strings.size());
+        strings.push_back(string);
+        stringIndices.emplace(string, index);
+        return index;
+    }
+
+    uint32 InternName(const FastName& name)
+    {
+        return name.IsValid() ? InternString(name.c_str()) : UIBinaryPackageFormat::INVALID_INDEX;
+    }
+
+    uint32 InternField(const String& owner, const String& fieldName)
+    {
+        std::pair<uint32, uint32> field(InternString(owner), InternString(fieldName));
+        auto it = fieldIndices.find(field);
+        if (it != fieldIndices.end())
+        {
+            return it->second;
+        }
+
+        uint32 index = static_cast<uint32>(fields.size());
+        fields.push_back(field);
+        fieldIndices.emplace(field, index);
+        return index;
+    }
+
+    uint32 InternComponent(const String& componentName)
+    {
+        uint32 nameIndex = InternString(componentName);
+        auto it = std::find(components.begin(), components.end(), nameIndex);
+        if (it != components.end())
+        {
+            return static_cast<uint32>(std::distance(components.begin(), it));
+        }
+
+        components.push_back(nameIndex);
+        return static_cast<uint32>(components.size() - 1);
+    }
+
+    bool WriteValue(const Any& value)
+    {
+        using namespace UIBinaryPackageFormat;
+
+        const Type* type = value.GetType();
+        if (type == Type::Instance<bool>())
+        {
+            ops.Write(VALUE_BOOL);
+            ops.Write(static_cast<uint8>(value.Get<bool>()));
+        }
+        else if (type == Type::Instance<int32>())
+        {
+            ops.Write(VALUE_INT32);
+            ops.Write(value.Get<int32>());
+        }
+        else if (type == Type::Instance<uint32>())
+        {
+            ops.Write(VALUE_UINT32);
+            ops.Write(value.Get<uint32>());
+        }
+        else if (type == Type::Instance<int64>())
+        {
+            ops.Write(VALUE_INT64);
+            ops.Write(value.Get<int64>());
+        }
+        else if (type == Type::Instance<uint64>())
+        {
+            ops.Write(VALUE_UINT64);
+            ops.Write(value.Get<uint64>());
+        }
+        else if (type == Type::Instance<float32>())
+        {
+            ops.Write(VALUE_FLOAT32);
+            ops.Write(value.Get<float32>());
+        }
+        else if (type == Type::Instance<FastName>())
+        {
+            ops.Write(VALUE_FASTNAME);
+            ops.Write(InternName(value.Get<FastName>()));
+        }
+        else if (type == Type::Instance<String>())
+        {
+            ops.Write(VALUE_STRING);
+            ops.Write(InternString(value.Get<String>()));
+        }
+        else if (type == Type::Instance<WideString>())
+        {
+            ops.Write(VALUE_WIDESTRING);
+            ops.Write(InternString(UTF8Utils::EncodeToUTF8(value.Get<WideString>())));
+        }
+        else if (type == Type::Instance<Vector2>())
+        {
+            const Vector2& v = value.Get<Vector2>();
+            ops.Write(VALUE_VECTOR2);
+            ops.Write(v.x);
+            ops.Write(v.y);
+        }
+        else if (type == Type::Instance<Vector3>())
+        {
+            const Vector3& v = value.Get<Vector3>();
+            ops.Write(VALUE_VECTOR3);
+            ops.Write(v.x);
+            ops.Write(v.y);
+            ops.Write(v.z);
+        }
+        else if (type == Type::Instance<Vector4>())
+        {
+            const Vector4& v = value.Get<Vector4>();
+            ops.Write(VALUE_VECTOR4);
+            ops.Write(v.x);
+            ops.Write(v.y);
+            ops.Write(v.z);
+            ops.Write(v.w);
+        }
+        else if (type == Type::Instance<Color>())
+        {
+            const Color& c = value.Get<Color>();
+            ops.Write(VALUE_COLOR);
+            ops.Write(c.r);
+            ops.Write(c.g);
+            ops.Write(c.b);
+            ops.Write(c.a);
+        }
+        else if (type == Type::Instance<Rect>())
+        {
+            const Rect& r = value.Get<Rect>();
+            ops.Write(VALUE_RECT);
+            ops.Write(r.x);
+            ops.Write(r.y);
+            ops.Write(r.dx);
+            ops.Write(r.dy);
+        }
+        else if (type == Type::Instance<FilePath>())
+        {
+            const FilePath& path = value.Get<FilePath>();
+            ops.Write(VALUE_FILEPATH);
+            ops.Write(InternString(path.IsEmpty() ? String() : path.GetFrameworkPath()));
+        }
+        else if (type->IsEnum() && type->GetSize() == sizeof(int32))
+        {
+            ops.Write(VALUE_ENUM);
+            ops.Write(value.ReinterpretCast(Type::Instance<int32>()).Get<int32>());
+        }
+        else
+        {
+            return false;
+        }
+        return true;
+    }
+
+    UIPackageCompiler* compiler = nullptr;
+    std::shared_ptr<PackageControls> packageControls;
+    Map<String, std::shared_ptr<PackageControls>> importedPackages;
+    Vector<ControlDescr> controlsStack;
+    String currentSection;
+    const ReflectedType* currentComponent = nullptr;
+
+    Vector<String> strings;
+    Map<String, uint32> stringIndices;
+    Vector<std::pair<uint32, uint32>> fields;
+    Map<std::pair<uint32, uint32>, uint32> fieldIndices;
+    Vector<uint32> components;
+    UIBinaryPackageFormat::Writer ops;
+
+    FilePath packagePath;
+    int32 packageVersion = 0;
+    bool failed = false;
+};
+
+UIPackageCompiler::UIPackageCompiler() = default;
+
+UIPackageCompiler::~UIPackageCompiler() = default;
+
+bool UIPackageCompiler::CompilePackage(const FilePath& packagePath, const FilePath& compiledPath)
+{
+    UIPackageRecordingBuilder builder(this);
+    if (!UIPackageCompilerDetails::LoadYamlPackage(packagePath, &builder))
+    {
+        Logger::Error("[UIPackageCompiler] %s isn't UI package", packagePath.GetStringValue().c_str());
+        return false;
+    }
+
+    if (builder.IsFailed())
+    {
+        return false;
+    }
+
+    Vector<uint8> data;
+    if (!builder.GetCompiledData(data))
+    {
+        Logger::Error("[UIPackageCompiler] Can't read sources of %s", packagePath.GetStringValue().c_str());
+        return false;
+    }
+
+    ScopedPtr<File> file(File::Create(compiledPath, File::CREATE | File::WRITE));
+    if (!file || file->Write(data.data(), static_cast<uint32>(data.size())) != data.size())
+    {
+        Logger::Error("[UIPackageCompiler] Can't write %s", compiledPath.GetStringValue().c_str());
+        return false;
+    }
+    return true;
+}
+
+bool UIPackageCompiler::CompilePackage(const FilePath& packagePath)
+{
+    return CompilePackage(packagePath, UIBinaryPackageLoader::GetCompiledPackagePath(packagePath));
+}
+
+uint32 UIPackageCompiler::CompileFolder(const FilePath& folder)
+{
+    uint32 failedCount = 0;
+    Vector<FilePath> files = FileSystem::Instance()->EnumerateFilesInDirectory(folder);
+    for (const FilePath& file : files)
+    {
+        if (file.IsEqualToExtension(".yaml") && !CompilePackage(file))
+        {
+            ++failedCount;
+        }
+    }
+    return failedCount;
+}
+
+std::shared_ptr<UIPackageCompiler::PackageControls> UIPackageCompiler::LoadImportedPackage(const String& packagePath)
+{
+    auto it = importedPackages.find(packagePath);
+    if (it != importedPackages.end())
+    {
+        return it->second;
+    }
+
+    std::shared_ptr<PackageControls> result;
+    UIPackageRecordingBuilder builder(this);
+    if (UIPackageCompilerDetails::LoadYamlPackage(packagePath, &builder) && !builder.IsFailed())
+    {
+        result = builder.GetPackageControls();
+    }
+
+    importedPackages[packagePath] = result;
+    return result;
+}
+}
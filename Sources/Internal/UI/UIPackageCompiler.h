@@ -0,0 +1,46 @@
+#pragma once
+
+#include "Base/BaseTypes.h"
+#include "FileSystem/FilePath.h"
+
+#include <memory>
+
+namespace DAVA
+{
+/**
+    Offline compiler of yaml UI packages into binary format loaded by UIBinaryPackageLoader.
+
+    Package is read by UIPackageLoader, so compiled package contains exactly the builder calls yaml loading makes,
+    including remapping of legacy properties. Reflection fields are stored by names of their types and are resolved
+    once per file on loading, values are stored in binary form, so loading needs neither yaml parsing nor lookup
+    of every property by name.
+
+    Controls aren't created during compilation, their types are taken from reflection by class names.
+    Custom classes unknown to the compiling application are compiled with properties of their base class.
+*/
+class UIPackageCompiler
+{
+public:
+    UIPackageCompiler();
+    ~UIPackageCompiler();
+
+    /** Compile yaml package to `compiledPath`, return false and write nothing if package can't be compiled */
+    bool CompilePackage(const FilePath& packagePath, const FilePath& compiledPath);
+
+    /** Compile yaml package to default path where UIBinaryPackageLoader looks for it */
+    bool CompilePackage(const FilePath& packagePath);
+
+    /** Compile all yaml packages in `folder` and its subfolders, return count of failed packages */
+    uint32 CompileFolder(const FilePath& folder);
+
+    struct ControlNode;
+    struct PackageControls;
+
+private:
+    friend class UIPackageRecordingBuilder;
+
+    std::shared_ptr<PackageControls> LoadImportedPackage(const String& packagePath);
+
+    Map<String, std::shared_ptr<PackageControls>> importedPackages;
+};
+}
@@ -13,6 +13,7 @@
 #include "UI/Styles/UIStyleSheet.h"
 #include "UI/UIStaticText.h"
 #include "UI/Text/UITextComponent.h"
+#include "UI/UIBinaryPackageLoader.h"
 #include "UI/UIControlHelpers.h"
 #include "UI/UIPackage.h"
 #include "UI/Components/UIComponent.h"
@@ -28,6 +29,8 @@
 
 namespace DAVA
 {
+bool UIPackageLoader::compiledPackagesEnabled = false;
+
 UIPackageLoader::UIPackageLoader()
     : UIPackageLoader(Map<String, Set<FastName>>())
 {
@@ -77,6 +80,16 @@ UIPackageLoader::~UIPackageLoader()
 {
 }
 
+void UIPackageLoader::SetCompiledPackagesEnabled(bool enabled)
+{
+    compiledPackagesEnabled = enabled;
+}
+
+bool UIPackageLoader::IsCompiledPackagesEnabled()
+{
+    return compiledPackagesEnabled;
+}
+
 bool UIPackageLoader::LoadPackage(const FilePath& packagePath, AbstractUIPackageBuilder* builder)
 {
     if (!loadingQueue.empty())
@@ -85,6 +98,15 @@ bool UIPackageLoader::LoadPackage(const FilePath& packagePath, AbstractUIPackage
         loadingQueue.clear();
     }
 
+    if (compiledPackagesEnabled)
+    {
+        UIBinaryPackageLoader binaryLoader;
+        if (binaryLoader.LoadCompiledPackage(packagePath, builder))
+        {
+            return true;
+        }
+    }
+
     if (!FileSystem::Instance()->Exists(packagePath))
         return false;
 
@@ -33,6 +33,13 @@ public:
     UIPackageLoader(const DAVA::Map<DAVA::String, DAVA::Set<DAVA::FastName>>& legacyPrototypes);
     virtual ~UIPackageLoader();
 
+    /**
+        Load packages compiled by UIPackageCompiler instead of yaml if compiled package exists.
+        Disabled by default, editors should load yaml which is edited by them.
+    */
+    static void SetCompiledPackagesEnabled(bool enabled);
+    static bool IsCompiledPackagesEnabled();
+
 public:
     virtual bool LoadPackage(const FilePath& packagePath, AbstractUIPackageBuilder* builder) override;
     virtual bool LoadPackage(const YamlNode* rootNode, const FilePath& packagePath, AbstractUIPackageBuilder* builder);
@@ -78,6 +85,8 @@ private:
         int32 status;
     };
 
+    static bool compiledPackagesEnabled;
+
     Vector<QueueItem> loadingQueue;
     DAVA::int32 version = 0;
 